@@ -11,6 +11,7 @@
 #include <rte_per_lcore.h>
 #include <rte_lcore.h>
 #include <rte_ip.h>
+#include <rte_random.h>
 
 #define	PRINT_USAGE_START	"%s [EAL options] --\n"
 
@@ -41,6 +42,8 @@
 #define	OPT_ITER_NUM		"iter"
 #define	OPT_VERBOSE		"verbose"
 #define	OPT_IPV6		"ipv6"
+#define	OPT_UPDATE_NUM		"updatenum"
+#define	OPT_RULE_GEN		"rulegen"
 
 #define	TRACE_DEFAULT_NUM	0x10000
 #define	TRACE_STEP_MAX		0x1000
@@ -48,6 +51,9 @@
 
 #define	RULE_NUM		0x10000
 
+#define	GEN_SEED		0x5eed
+#define	GEN_NET_NUM		0x40
+
 #define COMMENT_LEAD_CHAR	'#'
 
 enum {
@@ -113,9 +119,15 @@ static struct {
 	uint32_t            iter_num;
 	uint32_t            verbose;
 	uint32_t            ipv6;
+	uint32_t            nb_updates;
+	uint32_t            nb_gen_rules;
 	struct acl_alg      alg;
 	uint32_t            used_traces;
 	void               *traces;
+	uint32_t            used_updates;
+	void               *updates;
+	FILE               *gen_rules;
+	FILE               *gen_traces;
 	struct rte_acl_ctx *acx;
 } config = {
 	.bld_categories = 3,
@@ -535,6 +547,7 @@ static void
 tracef_init(void)
 {
 	static const char name[] = APP_NAME;
+	const char *fname;
 	FILE *f;
 	size_t sz;
 	uint32_t i, k, n;
@@ -549,10 +562,15 @@ tracef_init(void)
 			"requested %u number of trace records\n",
 			sz, config.nb_traces);
 
-	f = fopen(config.trace_file, "r");
+	if (config.trace_file == NULL) {
+		fname = OPT_RULE_GEN;
+		f = config.gen_traces;
+	} else {
+		fname = config.trace_file;
+		f = fopen(fname, "r");
+	}
 	if (f == NULL)
-		rte_exit(-EINVAL, "failed to open file: %s\n",
-			config.trace_file);
+		rte_exit(-EINVAL, "failed to open file: %s\n", fname);
 
 	v = config.traces;
 	w = config.traces;
@@ -575,13 +593,13 @@ tracef_init(void)
 				rte_exit(EXIT_FAILURE,
 					"%s: failed to parse ipv6 trace "
 					"record at line %u\n",
-					config.trace_file, i + 1);
+					fname, i + 1);
 		} else {
 			if (parse_cb_ipv4_trace(line, v + n) != 0)
 				rte_exit(EXIT_FAILURE,
 					"%s: failed to parse ipv4 trace "
 					"record at line %u\n",
-					config.trace_file, i + 1);
+					fname, i + 1);
 		}
 	}
 
@@ -902,13 +920,230 @@ parse_cb_ipv4_rule(char *str, struct acl_rule *v)
 	return 0;
 }
 
+/*
+ * ClassBench-like generator of IPv4 5-tuple rules and traces.
+ * Shares of the protocols, prefix lengths and port range classes
+ * roughly follow ACL seed files: most rules are for TCP and UDP,
+ * destinations are more specific than sources,
+ * and destination ports are mostly exact well-known ports.
+ * Each trace is generated to match a random rule.
+ */
+struct gen_rule {
+	uint32_t addr[2];
+	uint8_t  mask_len[2];
+	uint16_t port[2][2];
+	uint8_t  proto;
+	uint8_t  proto_mask;
+};
+
+struct gen_dist {
+	uint32_t pct; /* share in percents */
+	uint32_t lo;
+	uint32_t hi;
+};
+
+static const struct gen_dist gen_proto[] = {
+	{ .pct = 50, .lo = IPPROTO_TCP, .hi = IPPROTO_TCP, },
+	{ .pct = 30, .lo = IPPROTO_UDP, .hi = IPPROTO_UDP, },
+	{ .pct = 5, .lo = IPPROTO_ICMP, .hi = IPPROTO_ICMP, },
+	/* any protocol */
+	{ .pct = 15, .lo = 0, .hi = 0, },
+};
+
+static const struct gen_dist gen_mask_len[2][6] = {
+	/* source prefixes */
+	{
+		{ .pct = 15, .lo = 0, .hi = 0, },
+		{ .pct = 5, .lo = 8, .hi = 15, },
+		{ .pct = 15, .lo = 16, .hi = 23, },
+		{ .pct = 25, .lo = 24, .hi = 24, },
+		{ .pct = 10, .lo = 25, .hi = 31, },
+		{ .pct = 30, .lo = 32, .hi = 32, },
+	},
+	/* destination prefixes */
+	{
+		{ .pct = 5, .lo = 0, .hi = 0, },
+		{ .pct = 0, .lo = 8, .hi = 15, },
+		{ .pct = 10, .lo = 16, .hi = 23, },
+		{ .pct = 25, .lo = 24, .hi = 24, },
+		{ .pct = 15, .lo = 25, .hi = 31, },
+		{ .pct = 45, .lo = 32, .hi = 32, },
+	},
+};
+
+/* port range classes: wildcard, high, low, exact and arbitrary range */
+static const struct gen_dist gen_port_range[2][5] = {
+	/* source ports */
+	{
+		{ .pct = 80, .lo = 0, .hi = UINT16_MAX, },
+		{ .pct = 15, .lo = 1024, .hi = UINT16_MAX, },
+		{ .pct = 0, .lo = 0, .hi = 1023, },
+		{ .pct = 5, .lo = 0, .hi = 0, },
+		{ .pct = 0, .lo = 0, .hi = 0, },
+	},
+	/* destination ports */
+	{
+		{ .pct = 20, .lo = 0, .hi = UINT16_MAX, },
+		{ .pct = 10, .lo = 1024, .hi = UINT16_MAX, },
+		{ .pct = 5, .lo = 0, .hi = 1023, },
+		{ .pct = 50, .lo = 0, .hi = 0, },
+		{ .pct = 15, .lo = 0, .hi = 0, },
+	},
+};
+
+enum {
+	GEN_PORT_WC,
+	GEN_PORT_HI,
+	GEN_PORT_LO,
+	GEN_PORT_EM,
+	GEN_PORT_AR,
+};
+
+static const uint16_t gen_well_known_port[] = {
+	20, 21, 22, 23, 25, 53, 80, 110, 123, 137, 143, 161, 179, 389,
+	443, 445, 514, 993, 995, 1433, 1521, 3306, 3389, 5060, 8080, 8443,
+};
+
+static uint32_t
+gen_pick(const struct gen_dist *dist, uint32_t num)
+{
+	uint32_t i, v;
+
+	v = rte_rand_max(100);
+	for (i = 0; i != num - 1 && v >= dist[i].pct; i++)
+		v -= dist[i].pct;
+
+	return i;
+}
+
+static uint32_t
+gen_mask(uint32_t mask_len)
+{
+	return (mask_len == 0) ? 0 : UINT32_MAX << (32 - mask_len);
+}
+
+static void
+gen_one_rule(struct gen_rule *r, const uint32_t net[GEN_NET_NUM])
+{
+	uint32_t i, k, lo;
+	const struct gen_dist *d;
+
+	d = gen_proto + gen_pick(gen_proto, RTE_DIM(gen_proto));
+	r->proto = d->lo;
+	r->proto_mask = (d->lo == 0) ? 0 : UINT8_MAX;
+
+	for (i = 0; i != RTE_DIM(r->addr); i++) {
+
+		d = gen_mask_len[i] + gen_pick(gen_mask_len[i],
+			RTE_DIM(gen_mask_len[i]));
+		r->mask_len[i] = d->lo + rte_rand_max(d->hi - d->lo + 1);
+		r->addr[i] = net[rte_rand_max(GEN_NET_NUM)] |
+			(rte_rand() & UINT16_MAX);
+		r->addr[i] &= gen_mask(r->mask_len[i]);
+
+		/* ports are specified for TCP and UDP rules only */
+		if (r->proto != IPPROTO_TCP && r->proto != IPPROTO_UDP)
+			k = GEN_PORT_WC;
+		else
+			k = gen_pick(gen_port_range[i],
+				RTE_DIM(gen_port_range[i]));
+
+		d = gen_port_range[i] + k;
+		if (k == GEN_PORT_EM) {
+			lo = gen_well_known_port[rte_rand_max(
+				RTE_DIM(gen_well_known_port))];
+			r->port[i][0] = lo;
+			r->port[i][1] = lo;
+		} else if (k == GEN_PORT_AR) {
+			lo = rte_rand_max(UINT16_MAX - 1024);
+			r->port[i][0] = lo;
+			r->port[i][1] = lo + rte_rand_max(1024);
+		} else {
+			r->port[i][0] = d->lo;
+			r->port[i][1] = d->hi;
+		}
+	}
+}
+
+static void
+gen_one_trace(FILE *f, const struct gen_rule *r)
+{
+	uint32_t i, addr[2], msk, port[2], proto;
+
+	for (i = 0; i != RTE_DIM(addr); i++) {
+		msk = gen_mask(r->mask_len[i]);
+		addr[i] = (r->addr[i] & msk) | (rte_rand() & ~msk);
+		port[i] = r->port[i][0] +
+			rte_rand_max(r->port[i][1] - r->port[i][0] + 1);
+	}
+
+	proto = r->proto;
+	if (r->proto_mask == 0)
+		proto = gen_proto[rte_rand_max(RTE_DIM(gen_proto) - 1)].lo;
+
+	fprintf(f, "%u %u %u %u %u\n",
+		addr[0], addr[1], port[0], port[1], proto);
+}
+
+static void
+gen_rules_traces(void)
+{
+	uint32_t i, net[GEN_NET_NUM];
+	struct gen_rule *rule, *r;
+
+	rule = calloc(config.nb_gen_rules, sizeof(rule[0]));
+	config.gen_rules = tmpfile();
+	if (config.trace_file == NULL)
+		config.gen_traces = tmpfile();
+	if (rule == NULL || config.gen_rules == NULL ||
+			(config.trace_file == NULL &&
+			config.gen_traces == NULL))
+		rte_exit(-ENOMEM, "failed to generate %u rules\n",
+			config.nb_gen_rules);
+
+	/* make generated rules and traces the same for every run */
+	rte_srand(GEN_SEED);
+
+	/* addresses are clustered around a few /16 networks */
+	for (i = 0; i != RTE_DIM(net); i++)
+		net[i] = rte_rand() & ~(uint32_t)UINT16_MAX;
+
+	for (i = 0; i != config.nb_gen_rules; i++) {
+		r = rule + i;
+		gen_one_rule(r, net);
+		fprintf(config.gen_rules,
+			"@%u.%u.%u.%u/%u %u.%u.%u.%u/%u "
+			"%u : %u %u : %u %u/0x%x\n",
+			r->addr[0] >> 24, (r->addr[0] >> 16) & UINT8_MAX,
+			(r->addr[0] >> 8) & UINT8_MAX, r->addr[0] & UINT8_MAX,
+			r->mask_len[0],
+			r->addr[1] >> 24, (r->addr[1] >> 16) & UINT8_MAX,
+			(r->addr[1] >> 8) & UINT8_MAX, r->addr[1] & UINT8_MAX,
+			r->mask_len[1],
+			r->port[0][0], r->port[0][1],
+			r->port[1][0], r->port[1][1],
+			r->proto, r->proto_mask);
+	}
+
+	rewind(config.gen_rules);
+
+	if (config.gen_traces != NULL) {
+		for (i = 0; i != config.nb_traces; i++)
+			gen_one_trace(config.gen_traces,
+				rule + rte_rand_max(config.nb_gen_rules));
+		rewind(config.gen_traces);
+	}
+
+	free(rule);
+}
+
 typedef int (*parse_5tuple)(char *text, struct acl_rule *rule);
 
 static int
 add_cb_rules(FILE *f, struct rte_acl_ctx *ctx)
 {
 	int rc;
-	uint32_t i, k, n;
+	uint32_t i, j, k, n;
 	struct acl_rule v;
 	parse_5tuple parser;
 
@@ -950,6 +1185,16 @@ add_cb_rules(FILE *f, struct rte_acl_ctx *ctx)
 				i, rc, strerror(-rc));
 			return rc;
 		}
+
+		/* pick random rules for the incremental updates */
+		if (config.nb_updates != 0) {
+			j = (n <= config.nb_updates) ? n - 1 : rte_rand_max(n);
+			if (j < config.nb_updates)
+				memcpy((uint8_t *)config.updates +
+					(size_t)prm.rule_size * j,
+					&v, prm.rule_size);
+			config.used_updates = RTE_MIN(n, config.nb_updates);
+		}
 	}
 
 	return 0;
@@ -960,6 +1205,7 @@ acx_init(void)
 {
 	int ret;
 	FILE *f;
+	uint64_t tm;
 	struct rte_acl_config cfg;
 
 	memset(&cfg, 0, sizeof(cfg));
@@ -980,12 +1226,23 @@ acx_init(void)
 
 	/* setup ACL creation parameters. */
 	prm.rule_size = RTE_ACL_RULE_SZ(cfg.num_fields);
-	prm.max_rule_num = config.nb_rules;
+	prm.max_rule_num = RTE_MAX(config.nb_rules, config.nb_gen_rules);
+	/* room for the rules added back before the next build */
+	prm.max_rule_num += config.nb_updates;
 
 	config.acx = rte_acl_create(&prm);
 	if (config.acx == NULL)
 		rte_exit(rte_errno, "failed to create ACL context\n");
 
+	if (config.nb_updates != 0) {
+		config.updates = rte_zmalloc_socket(NULL,
+			(size_t)prm.rule_size * config.nb_updates,
+			RTE_CACHE_LINE_SIZE, SOCKET_ID_ANY);
+		if (config.updates == NULL)
+			rte_exit(-ENOMEM, "failed to allocate %u rules "
+				"for incremental updates\n", config.nb_updates);
+	}
+
 	/* set default classify method for this context. */
 	if (config.alg.alg != RTE_ACL_CLASSIFY_DEFAULT) {
 		ret = rte_acl_set_ctx_classify(config.acx, config.alg.alg);
@@ -995,7 +1252,11 @@ acx_init(void)
 	}
 
 	/* add ACL rules. */
-	f = fopen(config.rule_file, "r");
+	if (config.rule_file == NULL) {
+		gen_rules_traces();
+		f = config.gen_rules;
+	} else
+		f = fopen(config.rule_file, "r");
 	if (f == NULL)
 		rte_exit(-EINVAL, "failed to open file %s\n",
 			config.rule_file);
@@ -1007,11 +1268,14 @@ acx_init(void)
 	fclose(f);
 
 	/* perform build. */
+	tm = rte_rdtsc_precise();
 	ret = rte_acl_build(config.acx, &cfg);
+	tm = rte_rdtsc_precise() - tm;
 
 	dump_verbose(DUMP_NONE, stdout,
-		"rte_acl_build(%u) finished with %d\n",
-		config.bld_categories, ret);
+		"rte_acl_build(%u) finished with %d in %.2Lf ms\n",
+		config.bld_categories, ret,
+		(long double)tm * MS_PER_S / rte_get_timer_hz());
 
 	rte_acl_dump(config.acx);
 
@@ -1019,6 +1283,111 @@ acx_init(void)
 		rte_exit(ret, "failed to build search context\n");
 }
 
+/*
+ * Delete the picked rules one by one, then add them back,
+ * so that the classification results are the same as before,
+ * but classification runs with the incremental updates pending.
+ */
+static void
+acx_update(void)
+{
+	int ret;
+	uint32_t i, op, ud;
+	uint64_t start, tm, tm_max, tm_sum;
+	const struct rte_acl_rule *rule;
+
+	static const char * const op_name[] = {
+		"rte_acl_incr_del_rules",
+		"rte_acl_incr_add_rules",
+	};
+
+	for (op = 0; op != RTE_DIM(op_name); op++) {
+
+		tm_max = 0;
+		tm_sum = 0;
+
+		for (i = 0; i != config.used_updates; i++) {
+
+			rule = (const struct rte_acl_rule *)
+				((uintptr_t)config.updates +
+				(size_t)prm.rule_size * i);
+			ud = rule->data.userdata;
+
+			start = rte_rdtsc_precise();
+			if (op == 0)
+				ret = rte_acl_incr_del_rules(config.acx,
+					&ud, 1);
+			else
+				ret = rte_acl_incr_add_rules(config.acx,
+					rule, 1);
+			tm = rte_rdtsc_precise() - start;
+
+			if (ret != 0)
+				rte_exit(ret, "%s(%u) failed with %d\n",
+					op_name[op], ud, ret);
+
+			tm_sum += tm;
+			tm_max = RTE_MAX(tm_max, tm);
+		}
+
+		dump_verbose(DUMP_NONE, stdout,
+			"%s: %u updates, %.2Lf us/update avg, "
+			"%.2Lf us/update max\n",
+			op_name[op], config.used_updates,
+			(long double)tm_sum * US_PER_S /
+			rte_get_timer_hz() / config.used_updates,
+			(long double)tm_max * US_PER_S / rte_get_timer_hz());
+	}
+}
+
+/*
+ * Report how many traces have to walk each of the tries.
+ */
+static void
+acx_trie_stats(void)
+{
+	int ret;
+	uint32_t i, n;
+	uint64_t walks;
+	const uint8_t **data;
+
+	ret = rte_acl_trie_stats(config.acx, NULL, 0, NULL, 0);
+	if (ret <= 0)
+		return;
+
+	struct rte_acl_trie_stats stats[ret];
+
+	data = malloc(config.used_traces * sizeof(data[0]));
+	if (data == NULL)
+		rte_exit(-ENOMEM, "failed to allocate %u trace pointers\n",
+			config.used_traces);
+
+	for (i = 0; i != config.used_traces; i++)
+		data[i] = (const uint8_t *)config.traces +
+			(size_t)config.trace_sz * i;
+
+	n = rte_acl_trie_stats(config.acx, data, config.used_traces,
+		stats, RTE_DIM(stats));
+
+	walks = 0;
+	for (i = 0; i != n; i++) {
+		walks += stats[i].num_walks;
+		dump_verbose(DUMP_NONE, stdout,
+			"trie %u: %u rules, walked by %u traces (%.2Lf%%)\n",
+			i, stats[i].num_rules, stats[i].num_walks,
+			(config.used_traces == 0) ? 0 :
+			(long double)stats[i].num_walks * 100 /
+			config.used_traces);
+	}
+
+	dump_verbose(DUMP_NONE, stdout,
+		"%u tries, %.2Lf tries walked per trace on average\n", n,
+		(config.used_traces == 0) ? 0 :
+		(long double)walks / config.used_traces);
+
+	free(data);
+}
+
 static uint32_t
 search_ip5tuples_once(uint32_t categories, uint32_t step, const char *alg)
 {
@@ -1174,7 +1543,9 @@ print_usage(const char *prgname)
 
 	fprintf(stdout,
 		PRINT_USAGE_START
-		"--" OPT_RULE_FILE "=<rules set file>\n"
+		"--" OPT_RULE_FILE "=<rules set file> | "
+		"--" OPT_RULE_GEN
+			"=<number of IPv4 rules to generate>\n"
 		"[--" OPT_TRACE_FILE "=<input traces file>]\n"
 		"[--" OPT_RULE_NUM
 			"=<maximum number of rules for ACL context>]\n"
@@ -1194,7 +1565,10 @@ print_usage(const char *prgname)
 		"[--" OPT_ITER_NUM "=<number of iterations to perform>]\n"
 		"[--" OPT_VERBOSE "=<verbose level>]\n"
 		"[--" OPT_SEARCH_ALG "=%s]\n"
-		"[--" OPT_IPV6 "(=4B | 8B) <IPv6 rules and trace files>]\n",
+		"[--" OPT_IPV6 "(=4B | 8B) <IPv6 rules and trace files>]\n"
+		"[--" OPT_UPDATE_NUM
+			"=<number of rules to delete and add back "
+			"incrementally before classification>]\n",
 		prgname, RTE_ACL_RESULTS_MULTIPLIER,
 		(uint32_t)RTE_ACL_MAX_CATEGORIES,
 		buf);
@@ -1217,15 +1591,22 @@ dump_config(FILE *f)
 	fprintf(f, "%s:%u(%s)\n", OPT_SEARCH_ALG, config.alg.alg,
 		config.alg.name);
 	fprintf(f, "%s:%u\n", OPT_IPV6, config.ipv6);
+	fprintf(f, "%s:%u\n", OPT_UPDATE_NUM, config.nb_updates);
+	fprintf(f, "%s:%u\n", OPT_RULE_GEN, config.nb_gen_rules);
 }
 
 static void
 check_config(void)
 {
-	if (config.rule_file == NULL) {
+	if ((config.rule_file == NULL) == (config.nb_gen_rules == 0)) {
+		print_usage(config.prgname);
+		rte_exit(-EINVAL, "exactly one of options %s and %s "
+			"has to be specified\n", OPT_RULE_FILE, OPT_RULE_GEN);
+	}
+	if (config.nb_gen_rules != 0 && config.ipv6 != IPV6_FRMT_NONE) {
 		print_usage(config.prgname);
-		rte_exit(-EINVAL, "mandatory option %s is not specified\n",
-			OPT_RULE_FILE);
+		rte_exit(-EINVAL, "option %s supports IPv4 rules only\n",
+			OPT_RULE_GEN);
 	}
 }
 
@@ -1246,6 +1627,8 @@ get_input_opts(int argc, char **argv)
 		{OPT_VERBOSE, 1, 0, 0},
 		{OPT_SEARCH_ALG, 1, 0, 0},
 		{OPT_IPV6, 2, 0, 0},
+		{OPT_UPDATE_NUM, 1, 0, 0},
+		{OPT_RULE_GEN, 1, 0, 0},
 		{NULL, 0, 0, 0}
 	};
 
@@ -1297,6 +1680,12 @@ get_input_opts(int argc, char **argv)
 			config.ipv6 = IPV6_FRMT_U32;
 			if (optarg != NULL)
 				get_ipv6_opt(optarg, lgopts[opt_idx].name);
+		} else if (strcmp(lgopts[opt_idx].name, OPT_UPDATE_NUM) == 0) {
+			config.nb_updates = get_ulong_opt(optarg,
+				lgopts[opt_idx].name, 0, RULE_NUM);
+		} else if (strcmp(lgopts[opt_idx].name, OPT_RULE_GEN) == 0) {
+			config.nb_gen_rules = get_ulong_opt(optarg,
+				lgopts[opt_idx].name, 1, RTE_ACL_MAX_INDEX + 1);
 		}
 	}
 	config.trace_sz = config.ipv6 ? sizeof(struct ipv6_5tuple) :
@@ -1325,8 +1714,13 @@ main(int argc, char **argv)
 
 	acx_init();
 
-	if (config.trace_file != NULL)
+	if (config.used_updates != 0)
+		acx_update();
+
+	if (config.trace_file != NULL || config.gen_traces != NULL) {
 		tracef_init();
+		acx_trie_stats();
+	}
 
 	RTE_LCORE_FOREACH_WORKER(lcore)
 		 rte_eal_remote_launch(search_ip5tuples, NULL, lcore);
@@ -1336,5 +1730,6 @@ main(int argc, char **argv)
 	rte_eal_mp_wait_lcore();
 
 	rte_acl_free(config.acx);
+	rte_free(config.updates);
 	return 0;
 }
@@ -39,6 +39,8 @@
 #define	DEF_LOOKUP_IPS_NUM	0x100000
 #define BURST_SZ		64
 #define DEFAULT_LPM_TBL8	100000U
+/* number of poptrie leaves per node */
+#define POPTRIE_LEAVES_RATIO	2
 
 #define CMP_FLAG		(1 << 0)
 #define CMP_ALL_FLAG		(1 << 1)
@@ -46,9 +48,12 @@
 #define FIB_RIB_TYPE		(1 << 3)
 #define FIB_V4_DIR_TYPE		(1 << 4)
 #define FIB_V6_TRIE_TYPE	(1 << 4)
-#define FIB_TYPE_MASK		(FIB_RIB_TYPE|FIB_V4_DIR_TYPE|FIB_V6_TRIE_TYPE)
+#define FIB_V6_POPTRIE_TYPE	(1 << 5)
+#define FIB_TYPE_MASK		(FIB_RIB_TYPE|FIB_V4_DIR_TYPE|FIB_V6_TRIE_TYPE|\
+				FIB_V6_POPTRIE_TYPE)
 #define SHUFFLE_FLAG		(1 << 7)
 #define DRY_RUN_FLAG		(1 << 8)
+#define BULK_ADD_FLAG		(1 << 9)
 
 static char *distrib_string;
 static char line[LINE_MAX];
@@ -101,6 +106,29 @@ static struct {
 	.lookup_fn = 0
 };
 
+#define LOOKUP_FN_ALL		UINT8_MAX
+
+/* Lookup functions selected with -v, lookup_fn is the index + 1 */
+static const struct {
+	const char	*name;
+	int		v4_type;	/* -1 if not available for ipv4 */
+	int		v6_type;	/* -1 if not available for ipv6 */
+	int		poptrie_type;	/* -1 if not available for poptrie */
+} lookup_fns[] = {
+	{ "s1", RTE_FIB_LOOKUP_DIR24_8_SCALAR_MACRO,
+		RTE_FIB6_LOOKUP_TRIE_SCALAR, RTE_FIB6_LOOKUP_POPTRIE_SCALAR },
+	{ "v", RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512,
+		RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512,
+		RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX512 },
+	{ "s2", RTE_FIB_LOOKUP_DIR24_8_SCALAR_INLINE, -1, -1 },
+	{ "s3", RTE_FIB_LOOKUP_DIR24_8_SCALAR_UNI, -1, -1 },
+	{ "neon", RTE_FIB_LOOKUP_DIR24_8_VECTOR_NEON,
+		RTE_FIB6_LOOKUP_TRIE_VECTOR_NEON, -1 },
+	{ "sve", RTE_FIB_LOOKUP_DIR24_8_VECTOR_SVE,
+		RTE_FIB6_LOOKUP_TRIE_VECTOR_SVE, -1 },
+	{ "avx2", -1, -1, RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX2 },
+};
+
 struct rt_rule_4 {
 	uint32_t	addr;
 	uint8_t		depth;
@@ -142,6 +170,8 @@ get_fib_type(void)
 	if (config.flags & IPV6_FLAG) {
 		if ((config.flags & FIB_TYPE_MASK) == FIB_V6_TRIE_TYPE)
 			return RTE_FIB6_TRIE;
+		else if ((config.flags & FIB_TYPE_MASK) == FIB_V6_POPTRIE_TYPE)
+			return RTE_FIB6_POPTRIE;
 		else
 			return RTE_FIB6_DUMMY;
 	} else {
@@ -612,6 +642,7 @@ print_usage(void)
 		"[-c <do comparison with LPM library>]\n"
 		"[-6 <do tests with ipv6 (default ipv4)>]\n"
 		"[-s <shuffle randomly generated routes>]\n"
+		"[-k <add ipv4 routes with rte_fib_add_bulk>]\n"
 		"[-a <check nexthops for all ipv4 address space"
 		"(only valid with -c)>]\n"
 		"[-b <fib algorithm>]\n\tavailable options for ipv4\n"
@@ -620,16 +651,20 @@ print_usage(void)
 		"\tavailable options for ipv6:\n"
 		"\t\trib - RIB based FIB\n"
 		"\t\ttrie - TRIE based FIB\n"
+		"\t\tpoptrie - popcount compressed multibit trie\n"
 		"defaults are: dir for ipv4 and trie for ipv6\n"
-		"[-e <entry size (valid only for dir and trie fib types): "
-		"1/2/4/8 (default 4)>]\n"
-		"[-g <number of tbl8's for dir24_8 or trie FIBs>]\n"
+		"[-e <entry size (valid only for dir, trie and poptrie fib "
+		"types): 1/2/4/8 (default 4)>]\n"
+		"[-g <number of tbl8's for dir24_8 or trie FIBs, "
+		"number of nodes for poptrie FIB>]\n"
 		"[-w <path to the file to dump routing table>]\n"
 		"[-u <path to the file to dump ip's for lookup>]\n"
 		"[-v <type of lookup function:"
-		"\ts1, s2, s3 (3 types of scalar), v (vector) -"
+		"\ts1, s2, s3 (3 types of scalar), v (AVX512), neon, sve -"
 		" for DIR24_8 based FIB\n"
-		"\ts, v - for TRIE based ipv6 FIB>]\n",
+		"\ts, v (AVX512), neon, sve - for TRIE based ipv6 FIB\n"
+		"\ts, avx2, v (AVX512) - for POPTRIE based ipv6 FIB\n"
+		"\tall - measure lookup with each available function>]\n",
 		config.prgname);
 }
 
@@ -663,16 +698,22 @@ check_config(void)
 		printf("-e 1 is valid only for ipv4\n");
 		return -1;
 	}
+
+	if ((config.flags & BULK_ADD_FLAG) && (config.flags & IPV6_FLAG)) {
+		printf("-k flag is only valid for ipv4\n");
+		return -1;
+	}
 	return 0;
 }
 
 static void
 parse_opts(int argc, char **argv)
 {
+	unsigned int i;
 	int opt;
 	char *endptr;
 
-	while ((opt = getopt(argc, argv, "f:t:n:d:l:r:c6ab:e:g:w:u:sv:")) !=
+	while ((opt = getopt(argc, argv, "f:t:n:d:l:r:c6ab:e:g:w:u:skv:")) !=
 			-1) {
 		switch (opt) {
 		case 'f':
@@ -726,6 +767,9 @@ parse_opts(int argc, char **argv)
 		case 's':
 			config.flags |= SHUFFLE_FLAG;
 			break;
+		case 'k':
+			config.flags |= BULK_ADD_FLAG;
+			break;
 		case 'c':
 			config.flags |= CMP_FLAG;
 			break;
@@ -745,6 +789,9 @@ parse_opts(int argc, char **argv)
 			} else if (strcmp(optarg, "trie") == 0) {
 				config.flags &= ~FIB_TYPE_MASK;
 				config.flags |= FIB_V6_TRIE_TYPE;
+			} else if (strcmp(optarg, "poptrie") == 0) {
+				config.flags &= ~FIB_TYPE_MASK;
+				config.flags |= FIB_V6_POPTRIE_TYPE;
 			} else
 				rte_exit(-EINVAL, "Invalid option -b\n");
 			break;
@@ -765,18 +812,19 @@ parse_opts(int argc, char **argv)
 			}
 			break;
 		case 'v':
-			if ((strcmp(optarg, "s1") == 0) ||
-					(strcmp(optarg, "s") == 0)) {
+			if (strcmp(optarg, "s") == 0) {
 				config.lookup_fn = 1;
 				break;
-			} else if (strcmp(optarg, "v") == 0) {
-				config.lookup_fn = 2;
-				break;
-			} else if (strcmp(optarg, "s2") == 0) {
-				config.lookup_fn = 3;
+			} else if (strcmp(optarg, "all") == 0) {
+				config.lookup_fn = LOOKUP_FN_ALL;
 				break;
-			} else if (strcmp(optarg, "s3") == 0) {
-				config.lookup_fn = 4;
+			}
+			for (i = 0; i < RTE_DIM(lookup_fns); i++) {
+				if (strcmp(optarg, lookup_fns[i].name) == 0)
+					break;
+			}
+			if (i < RTE_DIM(lookup_fns)) {
+				config.lookup_fn = i + 1;
 				break;
 			}
 			print_usage();
@@ -815,6 +863,84 @@ print_depth_err(void)
 		"-d 0:0 option or remove /0 prefix from routes file\n");
 }
 
+static void
+print_add_rate(const char *name, uint64_t cycles)
+{
+	printf("%s %u routes in %.3f s, %.0f routes/s\n", name,
+		config.nb_routes, (double)cycles / rte_get_tsc_hz(),
+		(double)config.nb_routes * rte_get_tsc_hz() / cycles);
+}
+
+static int
+add_bulk_v4(struct rte_fib *fib, struct rt_rule_4 *rt)
+{
+	struct rte_fib_route *routes;
+	uint64_t start, prep;
+	uint32_t i;
+	int ret;
+
+	routes = rte_malloc(NULL, sizeof(*routes) * config.nb_routes, 0);
+	if (routes == NULL) {
+		printf("Can not alloc routes for bulk add\n");
+		return -ENOMEM;
+	}
+	for (i = 0; i < config.nb_routes; i++) {
+		routes[i].ip = rt[i].addr;
+		routes[i].depth = rt[i].depth;
+		routes[i].next_hop = rt[i].nh;
+	}
+
+	start = rte_rdtsc_precise();
+	ret = rte_fib_bulk_prepare(routes, config.nb_routes);
+	prep = rte_rdtsc_precise() - start;
+	if (ret >= 0)
+		ret = rte_fib_add_bulk(fib, routes, ret);
+	if (ret != 0) {
+		printf("Can not add routes to FIB in bulk, err %d\n", ret);
+		rte_free(routes);
+		return ret;
+	}
+	printf("FIB bulk prepare %.3f s\n", (double)prep / rte_get_tsc_hz());
+	print_add_rate("FIB bulk add", rte_rdtsc_precise() - start);
+
+	rte_free(routes);
+	return 0;
+}
+
+static int
+select_lookup_v4(struct rte_fib *fib, unsigned int fn)
+{
+	if (lookup_fns[fn].v4_type < 0)
+		return -EINVAL;
+	return rte_fib_select_lookup(fib, lookup_fns[fn].v4_type);
+}
+
+/* Measure the average lookup cycles of the selected lookup function */
+static int
+lookup_v4(struct rte_fib *fib, uint32_t *tbl4, const char *name)
+{
+	uint64_t fib_nh[BURST_SZ];
+	uint64_t start, acc = 0;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
+		start = rte_rdtsc_precise();
+		ret = rte_fib_lookup_bulk(fib, tbl4 + i, fib_nh, BURST_SZ);
+		acc += rte_rdtsc_precise() - start;
+		if (ret != 0) {
+			printf("FIB lookup fails, err %d\n", ret);
+			return ret;
+		}
+	}
+	if (name != NULL)
+		printf("AVG FIB lookup %s %.1f\n", name,
+			(double)acc / (double)i);
+	else
+		printf("AVG FIB lookup %.1f\n", (double)acc / (double)i);
+	return 0;
+}
+
 static int
 run_v4(void)
 {
@@ -859,41 +985,37 @@ run_v4(void)
 		return -rte_errno;
 	}
 
-	if (config.lookup_fn != 0) {
-		if (config.lookup_fn == 1)
-			ret = rte_fib_select_lookup(fib,
-				RTE_FIB_LOOKUP_DIR24_8_SCALAR_MACRO);
-		else if (config.lookup_fn == 2)
-			ret = rte_fib_select_lookup(fib,
-				RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512);
-		else if (config.lookup_fn == 3)
-			ret = rte_fib_select_lookup(fib,
-				RTE_FIB_LOOKUP_DIR24_8_SCALAR_INLINE);
-		else if (config.lookup_fn == 4)
-			ret = rte_fib_select_lookup(fib,
-				RTE_FIB_LOOKUP_DIR24_8_SCALAR_UNI);
-		else
-			ret = -EINVAL;
+	if ((config.lookup_fn != 0) && (config.lookup_fn != LOOKUP_FN_ALL)) {
+		ret = select_lookup_v4(fib, config.lookup_fn - 1);
 		if (ret != 0) {
 			printf("Can not init lookup function\n");
 			return ret;
 		}
 	}
 
-	for (k = config.print_fract, i = 0; k > 0; k--) {
-		start = rte_rdtsc_precise();
-		for (j = 0; j < (config.nb_routes - i) / k; j++) {
-			ret = rte_fib_add(fib, rt[i + j].addr, rt[i + j].depth,
-				rt[i + j].nh);
-			if (unlikely(ret != 0)) {
-				printf("Can not add a route to FIB, err %d\n",
-					ret);
-				return -ret;
+	if (config.flags & BULK_ADD_FLAG) {
+		ret = add_bulk_v4(fib, rt);
+		if (ret != 0)
+			return -ret;
+	} else {
+		acc = 0;
+		for (k = config.print_fract, i = 0; k > 0; k--) {
+			start = rte_rdtsc_precise();
+			for (j = 0; j < (config.nb_routes - i) / k; j++) {
+				ret = rte_fib_add(fib, rt[i + j].addr,
+					rt[i + j].depth, rt[i + j].nh);
+				if (unlikely(ret != 0)) {
+					printf("Can not add a route to FIB, "
+						"err %d\n", ret);
+					return -ret;
+				}
 			}
+			start = rte_rdtsc_precise() - start;
+			acc += start;
+			printf("AVG FIB add %"PRIu64"\n", start / j);
+			i += j;
 		}
-		printf("AVG FIB add %"PRIu64"\n",
-			(rte_rdtsc_precise() - start) / j);
-		i += j;
+		print_add_rate("FIB add", acc);
 	}
 
 	if (config.flags & CMP_FLAG) {
@@ -925,17 +1047,23 @@ run_v4(void)
 		}
 	}
 
-	acc = 0;
-	for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
-		start = rte_rdtsc_precise();
-		ret = rte_fib_lookup_bulk(fib, tbl4 + i, fib_nh, BURST_SZ);
-		acc += rte_rdtsc_precise() - start;
-		if (ret != 0) {
-			printf("FIB lookup fails, err %d\n", ret);
-			return -ret;
+	ret = lookup_v4(fib, tbl4, NULL);
+	if (ret != 0)
+		return -ret;
+
+	if (config.lookup_fn == LOOKUP_FN_ALL) {
+		for (k = 0; k < RTE_DIM(lookup_fns); k++) {
+			if (select_lookup_v4(fib, k) != 0) {
+				printf("FIB lookup %s is not available\n",
+					lookup_fns[k].name);
+				continue;
+			}
+			ret = lookup_v4(fib, tbl4, lookup_fns[k].name);
+			if (ret != 0)
+				return -ret;
 		}
+		rte_fib_select_lookup(fib, RTE_FIB_LOOKUP_DEFAULT);
 	}
-	printf("AVG FIB lookup %.1f\n", (double)acc / (double)i);
 
 	if (config.flags & CMP_FLAG) {
 		acc = 0;
@@ -1015,10 +1143,67 @@ dump_rt_6(struct rt_rule_6 *rt)
 	return 0;
 }
 
+/* Amount of memory allocated from the DPDK heaps */
+static size_t
+get_heap_used(void)
+{
+	struct rte_malloc_socket_stats stats;
+	unsigned int i;
+	size_t used = 0;
+
+	for (i = 0; i < rte_socket_count(); i++) {
+		if (rte_malloc_get_socket_stats(rte_socket_id_by_idx(i),
+				&stats) == 0)
+			used += stats.heap_allocsz_bytes;
+	}
+	return used;
+}
+
+static int
+select_lookup_v6(struct rte_fib6 *fib, unsigned int fn)
+{
+	int type;
+
+	if (get_fib_type() == RTE_FIB6_POPTRIE)
+		type = lookup_fns[fn].poptrie_type;
+	else
+		type = lookup_fns[fn].v6_type;
+	if (type < 0)
+		return -EINVAL;
+	return rte_fib6_select_lookup(fib, type);
+}
+
+/* Measure the average lookup cycles of the selected lookup function */
+static int
+lookup_v6(struct rte_fib6 *fib, struct rte_ipv6_addr *tbl6, const char *name)
+{
+	uint64_t fib_nh[BURST_SZ];
+	uint64_t start, acc = 0;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
+		start = rte_rdtsc_precise();
+		ret = rte_fib6_lookup_bulk(fib, &tbl6[i], fib_nh, BURST_SZ);
+		acc += rte_rdtsc_precise() - start;
+		if (ret != 0) {
+			printf("FIB lookup fails, err %d\n", ret);
+			return ret;
+		}
+	}
+	if (name != NULL)
+		printf("AVG FIB lookup %s %.1f\n", name,
+			(double)acc / (double)i);
+	else
+		printf("AVG FIB lookup %.1f\n", (double)acc / (double)i);
+	return 0;
+}
+
 static int
 run_v6(void)
 {
 	uint64_t start, acc;
+	size_t mem;
 	uint64_t def_nh = 0;
 	struct rte_fib6 *fib;
 	struct rte_fib6_conf conf = {0};
@@ -1052,23 +1237,23 @@ run_v6(void)
 		conf.trie.nh_sz = rte_ctz32(config.ent_sz);
 		conf.trie.num_tbl8 = RTE_MIN(config.tbl8,
 			get_max_nh(conf.trie.nh_sz));
+	} else if (conf.type == RTE_FIB6_POPTRIE) {
+		conf.poptrie.nh_sz = rte_ctz32(config.ent_sz);
+		conf.poptrie.num_nodes = config.tbl8;
+		conf.poptrie.num_leaves = RTE_MIN(config.tbl8,
+			UINT32_MAX / POPTRIE_LEAVES_RATIO) *
+			POPTRIE_LEAVES_RATIO;
 	}
 
+	mem = get_heap_used();
 	fib = rte_fib6_create("test", -1, &conf);
 	if (fib == NULL) {
 		printf("Can not alloc FIB, err %d\n", rte_errno);
 		return -rte_errno;
 	}
 
-	if (config.lookup_fn != 0) {
-		if (config.lookup_fn == 1)
-			ret = rte_fib6_select_lookup(fib,
-				RTE_FIB6_LOOKUP_TRIE_SCALAR);
-		else if (config.lookup_fn == 2)
-			ret = rte_fib6_select_lookup(fib,
-				RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512);
-		else
-			ret = -EINVAL;
+	if ((config.lookup_fn != 0) && (config.lookup_fn != LOOKUP_FN_ALL)) {
+		ret = select_lookup_v6(fib, config.lookup_fn - 1);
 		if (ret != 0) {
 			printf("Can not init lookup function\n");
 			return ret;
@@ -1090,12 +1275,14 @@ run_v6(void)
 			(rte_rdtsc_precise() - start) / j);
 		i += j;
 	}
+	printf("FIB memory %zu KB\n", (get_heap_used() - mem) >> 10);
 
 	if (config.flags & CMP_FLAG) {
 		lpm_conf.max_rules = config.nb_routes * 2;
 		lpm_conf.number_tbl8s = RTE_MAX(conf.trie.num_tbl8,
 			config.tbl8);
 
+		mem = get_heap_used();
 		lpm = rte_lpm6_create("test_lpm", -1, &lpm_conf);
 		if (lpm == NULL) {
 			printf("Can not alloc LPM, err %d\n", rte_errno);
@@ -1118,20 +1305,26 @@ run_v6(void)
 				(rte_rdtsc_precise() - start) / j);
 			i += j;
 		}
+		printf("LPM memory %zu KB\n", (get_heap_used() - mem) >> 10);
 	}
 
-	acc = 0;
-	for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
-		start = rte_rdtsc_precise();
-		ret = rte_fib6_lookup_bulk(fib, &tbl6[i],
-			fib_nh, BURST_SZ);
-		acc += rte_rdtsc_precise() - start;
-		if (ret != 0) {
-			printf("FIB lookup fails, err %d\n", ret);
-			return -ret;
+	ret = lookup_v6(fib, tbl6, NULL);
+	if (ret != 0)
+		return -ret;
+
+	if (config.lookup_fn == LOOKUP_FN_ALL) {
+		for (k = 0; k < RTE_DIM(lookup_fns); k++) {
+			if (select_lookup_v6(fib, k) != 0) {
+				printf("FIB lookup %s is not available\n",
+					lookup_fns[k].name);
+				continue;
+			}
+			ret = lookup_v6(fib, tbl6, lookup_fns[k].name);
+			if (ret != 0)
+				return -ret;
 		}
+		rte_fib6_select_lookup(fib, RTE_FIB6_LOOKUP_DEFAULT);
 	}
-	printf("AVG FIB lookup %.1f\n", (double)acc / (double)i);
 
 	if (config.flags & CMP_FLAG) {
 		acc = 0;
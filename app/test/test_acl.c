@@ -23,6 +23,7 @@ test_acl(void)
 #else
 #include <rte_acl.h>
 #include <rte_common.h>
+#include <rte_random.h>
 
 #include "test_acl.h"
 
@@ -1721,6 +1722,612 @@ test_u32_range(void)
 	return rc;
 }
 
+#define INCR_NB_RULES	512
+#define INCR_NB_ROUNDS	16
+#define INCR_NB_UPDATES	8
+#define INCR_NB_BULK	1100
+#define INCR_NB_PKTS	1024
+#define INCR_CATEGORIES	((uint32_t)RTE_ACL_RESULTS_MULTIPLIER)
+#define INCR_MAX_RULES	(INCR_NB_RULES + INCR_NB_ROUNDS * INCR_NB_UPDATES + \
+	INCR_NB_BULK)
+
+struct incr_test {
+	struct rte_acl_ctx *acx;
+	struct rte_acl_ctx *ref;
+	struct rte_acl_config cfg;
+	struct rte_acl_ipv4vlan_rule rules[INCR_MAX_RULES];
+	uint32_t num_rules;
+	uint32_t next_userdata;
+	struct ipv4_7tuple pkts[INCR_NB_PKTS];
+	uint32_t res[INCR_NB_PKTS * INCR_CATEGORIES];
+	uint32_t ref_res[INCR_NB_PKTS * INCR_CATEGORIES];
+};
+
+static uint32_t
+incr_rand_addr(uint32_t *mask_len)
+{
+	static const uint32_t len[] = {8, 16, 20, 24, 28, 32};
+	uint32_t addr;
+
+	*mask_len = len[rte_rand_max(RTE_DIM(len))];
+	addr = RTE_IPV4(10, 0, 0, 0) | rte_rand_max(UINT16_MAX + 1);
+	return addr & RTE_ACL_MASKLEN_TO_BITMASK(*mask_len, sizeof(addr));
+}
+
+static void
+incr_rand_ports(uint16_t *lo, uint16_t *hi)
+{
+	if (rte_rand_max(4) == 0) {
+		*lo = 0;
+		*hi = UINT16_MAX;
+	} else {
+		*lo = rte_rand_max(1024);
+		*hi = *lo + rte_rand_max(1024);
+	}
+}
+
+/*
+ * Random rules in a small address and port space,
+ * so that a lot of them overlap.
+ */
+static void
+incr_rand_rule(struct incr_test *t, struct rte_acl_ipv4vlan_rule *r)
+{
+	uint32_t ud;
+
+	memset(r, 0, sizeof(*r));
+
+	ud = ++t->next_userdata;
+	r->data.userdata = ud;
+	/* unique priorities, so the results do not depend on ties */
+	r->data.priority = (ud * 7919) % 100003 + 1;
+	r->data.category_mask = 1 + rte_rand_max(
+		RTE_LEN2MASK(INCR_CATEGORIES, uint32_t));
+
+	if (rte_rand_max(2) != 0) {
+		r->proto = rte_rand_max(2) ? IPPROTO_TCP : IPPROTO_UDP;
+		r->proto_mask = UINT8_MAX;
+	}
+	r->src_addr = incr_rand_addr(&r->src_mask_len);
+	r->dst_addr = incr_rand_addr(&r->dst_mask_len);
+	incr_rand_ports(&r->src_port_low, &r->src_port_high);
+	incr_rand_ports(&r->dst_port_low, &r->dst_port_high);
+}
+
+static int
+incr_add_rules(struct rte_acl_ctx *acx,
+	const struct rte_acl_ipv4vlan_rule *rules, uint32_t num, int incr)
+{
+	struct acl_ipv4vlan_rule *r;
+	uint32_t i;
+	int32_t rc;
+
+	r = malloc(num * sizeof(r[0]));
+	if (r == NULL)
+		return -ENOMEM;
+
+	for (i = 0; i != num; i++)
+		convert_rule(rules + i, r + i);
+
+	if (incr != 0)
+		rc = rte_acl_incr_add_rules(acx,
+			(const struct rte_acl_rule *)r, num);
+	else
+		rc = rte_acl_add_rules(acx, (const struct rte_acl_rule *)r,
+			num);
+
+	free(r);
+	return rc;
+}
+
+/*
+ * Compare the results of the incrementally updated context with
+ * a context built from scratch with the same rules.
+ */
+static int
+incr_check(struct incr_test *t, const char *step)
+{
+	static const enum rte_acl_classify_alg alg[] = {
+		RTE_ACL_CLASSIFY_SCALAR,
+		RTE_ACL_CLASSIFY_DEFAULT,
+	};
+	const uint8_t *data[INCR_NB_PKTS];
+	uint32_t i, k;
+	int32_t rc;
+
+	rte_acl_reset_rules(t->ref);
+	rc = incr_add_rules(t->ref, t->rules, t->num_rules, 0);
+	if (rc == 0)
+		rc = rte_acl_build(t->ref, &t->cfg);
+	if (rc != 0) {
+		printf("%s#%i: %s: reference build failed: %d\n",
+			__func__, __LINE__, step, rc);
+		return -1;
+	}
+
+	for (i = 0; i != INCR_NB_PKTS; i++) {
+		t->pkts[i].proto = rte_rand_max(2) ? IPPROTO_TCP : IPPROTO_UDP;
+		t->pkts[i].ip_src = RTE_IPV4(10, 0, 0, 0) |
+			rte_rand_max(UINT16_MAX + 1);
+		t->pkts[i].ip_dst = RTE_IPV4(10, 0, 0, 0) |
+			rte_rand_max(UINT16_MAX + 1);
+		t->pkts[i].port_src = rte_rand_max(2048);
+		t->pkts[i].port_dst = rte_rand_max(2048);
+		data[i] = (const uint8_t *)&t->pkts[i];
+	}
+	bswap_test_data(t->pkts, INCR_NB_PKTS, 1);
+
+	for (k = 0; k != RTE_DIM(alg); k++) {
+		rc = rte_acl_set_ctx_classify(t->acx, alg[k]);
+		rc |= rte_acl_set_ctx_classify(t->ref, alg[k]);
+		rc |= rte_acl_classify(t->acx, data, t->res, INCR_NB_PKTS,
+			INCR_CATEGORIES);
+		rc |= rte_acl_classify(t->ref, data, t->ref_res, INCR_NB_PKTS,
+			INCR_CATEGORIES);
+		if (rc != 0) {
+			printf("%s#%i: %s: classify failed\n",
+				__func__, __LINE__, step);
+			return -1;
+		}
+
+		for (i = 0; i != RTE_DIM(t->res); i++) {
+			if (t->res[i] != t->ref_res[i]) {
+				printf("%s#%i: %s: alg %d, packet %u, "
+					"category %u: result %u, expected %u\n",
+					__func__, __LINE__, step, alg[k],
+					i / INCR_CATEGORIES,
+					i % INCR_CATEGORIES,
+					t->res[i], t->ref_res[i]);
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int
+incr_del_rules(struct incr_test *t, uint32_t num)
+{
+	uint32_t i, k, ud[num];
+
+	for (i = 0; i != num; i++) {
+		k = rte_rand_max(t->num_rules);
+		ud[i] = t->rules[k].data.userdata;
+		t->rules[k] = t->rules[--t->num_rules];
+	}
+
+	return rte_acl_incr_del_rules(t->acx, ud, num);
+}
+
+/*
+ * Test incremental updates against full rebuilds.
+ */
+static int
+test_incr_update(void)
+{
+	struct rte_acl_param prm;
+	struct incr_test *t;
+	uint32_t i, ud;
+	int32_t rc;
+
+	t = calloc(1, sizeof(*t));
+	if (t == NULL)
+		return -1;
+
+	ipv4vlan_config(&t->cfg, ipv4_7tuple_layout, INCR_CATEGORIES);
+
+	prm = acl_param;
+	prm.max_rule_num = INCR_MAX_RULES;
+	t->acx = rte_acl_create(&prm);
+	prm.name = "acl_incr_ref";
+	t->ref = rte_acl_create(&prm);
+	if (t->acx == NULL || t->ref == NULL) {
+		printf("%s#%i: Error creating ACL context!\n",
+			__func__, __LINE__);
+		rc = -1;
+		goto out;
+	}
+
+	for (i = 0; i != INCR_NB_RULES; i++)
+		incr_rand_rule(t, &t->rules[i]);
+	t->num_rules = INCR_NB_RULES;
+
+	/* nothing to update before the context is built */
+	rc = incr_add_rules(t->acx, t->rules, t->num_rules, 1);
+	if (rc != -EINVAL) {
+		printf("%s#%i: incremental add before build: %d\n",
+			__func__, __LINE__, rc);
+		rc = -1;
+		goto out;
+	}
+
+	rc = incr_add_rules(t->acx, t->rules, t->num_rules, 0);
+	if (rc == 0)
+		rc = rte_acl_build(t->acx, &t->cfg);
+	if (rc != 0) {
+		printf("%s#%i: build failed: %d\n", __func__, __LINE__, rc);
+		goto out;
+	}
+
+	/* unknown userdata, nothing should be deleted */
+	ud = t->next_userdata + 1;
+	rc = rte_acl_incr_del_rules(t->acx, &ud, 1);
+	if (rc != -ENOENT) {
+		printf("%s#%i: delete of unknown rule: %d\n",
+			__func__, __LINE__, rc);
+		rc = -1;
+		goto out;
+	}
+
+	for (i = 0; i != INCR_NB_ROUNDS; i++) {
+
+		incr_rand_rule(t, &t->rules[t->num_rules]);
+		rc = incr_add_rules(t->acx, &t->rules[t->num_rules], 1, 1);
+		if (rc != 0) {
+			printf("%s#%i: incremental add failed: %d\n",
+				__func__, __LINE__, rc);
+			goto out;
+		}
+		t->num_rules++;
+
+		rc = incr_check(t, "add");
+		if (rc != 0)
+			goto out;
+
+		rc = incr_del_rules(t, INCR_NB_UPDATES);
+		if (rc != 0) {
+			printf("%s#%i: incremental delete failed: %d\n",
+				__func__, __LINE__, rc);
+			goto out;
+		}
+
+		rc = incr_check(t, "delete");
+		if (rc != 0)
+			goto out;
+
+		for (ud = 0; ud != INCR_NB_UPDATES - 1; ud++)
+			incr_rand_rule(t, &t->rules[t->num_rules + ud]);
+		rc = incr_add_rules(t->acx, &t->rules[t->num_rules],
+			INCR_NB_UPDATES - 1, 1);
+		if (rc != 0) {
+			printf("%s#%i: incremental add failed: %d\n",
+				__func__, __LINE__, rc);
+			goto out;
+		}
+		t->num_rules += INCR_NB_UPDATES - 1;
+
+		rc = incr_check(t, "bulk add");
+		if (rc != 0)
+			goto out;
+	}
+
+	/* too many rules for the delta, full rebuild */
+	for (i = 0; i != INCR_NB_BULK; i++)
+		incr_rand_rule(t, &t->rules[t->num_rules + i]);
+	rc = incr_add_rules(t->acx, &t->rules[t->num_rules], INCR_NB_BULK, 1);
+	if (rc != 0) {
+		printf("%s#%i: incremental add failed: %d\n",
+			__func__, __LINE__, rc);
+		goto out;
+	}
+	t->num_rules += INCR_NB_BULK;
+
+	rc = incr_check(t, "rebuild");
+	if (rc != 0)
+		goto out;
+
+	/* fold the updates into the main tries */
+	rc = incr_del_rules(t, INCR_NB_UPDATES);
+	if (rc == 0)
+		rc = rte_acl_build(t->acx, &t->cfg);
+	if (rc != 0) {
+		printf("%s#%i: build after updates failed: %d\n",
+			__func__, __LINE__, rc);
+		goto out;
+	}
+
+	rc = incr_check(t, "build");
+
+out:
+	rte_acl_free(t->ref);
+	rte_acl_free(t->acx);
+	free(t);
+	return rc;
+}
+
+/* rules for each protocol, with wildcard addresses and port ranges */
+#define PART_PROTO_RULES	256
+/* rules for any protocol, with an exact destination or source address */
+#define PART_DST_RULES	1280
+#define PART_SRC_RULES	128
+#define PART_NB_PROTO	3
+#define PART_NB_RULES	(PART_NB_PROTO * PART_PROTO_RULES + \
+	PART_DST_RULES + PART_SRC_RULES)
+#define PART_NB_PKTS	INCR_NB_PKTS
+#define PART_MAX_TRIES	8
+
+/*
+ * Reference classification: the highest priority rule
+ * matching the packet in each category.
+ */
+static void
+part_classify_ref(const struct rte_acl_ipv4vlan_rule *rules, uint32_t num,
+	const struct ipv4_7tuple *pkt, uint32_t res[])
+{
+	const struct rte_acl_ipv4vlan_rule *r;
+	uint32_t c, i, pri[INCR_CATEGORIES];
+
+	memset(pri, 0, sizeof(pri));
+	memset(res, 0, INCR_CATEGORIES * sizeof(res[0]));
+
+	for (i = 0; i != num; i++) {
+		r = rules + i;
+		if ((pkt->proto & r->proto_mask) != r->proto ||
+				(pkt->ip_src & RTE_ACL_MASKLEN_TO_BITMASK(
+				r->src_mask_len, sizeof(uint32_t))) !=
+				r->src_addr ||
+				(pkt->ip_dst & RTE_ACL_MASKLEN_TO_BITMASK(
+				r->dst_mask_len, sizeof(uint32_t))) !=
+				r->dst_addr ||
+				pkt->port_src < r->src_port_low ||
+				pkt->port_src > r->src_port_high ||
+				pkt->port_dst < r->dst_port_low ||
+				pkt->port_dst > r->dst_port_high)
+			continue;
+
+		for (c = 0; c != INCR_CATEGORIES; c++) {
+			if ((r->data.category_mask & (1 << c)) != 0 &&
+					(uint32_t)r->data.priority > pri[c]) {
+				pri[c] = r->data.priority;
+				res[c] = r->data.userdata;
+			}
+		}
+	}
+}
+
+/*
+ * Rule i of the set, the same for every run.
+ * Merging the rules for any protocol into the ones for the given
+ * protocols makes the plain build split them into 3 tries, while each
+ * partition by protocol only gets the branch of its own protocol and
+ * holds in 2 tries, so that the packets of a protocol skip the tries
+ * of the other ones.
+ */
+static void
+part_rule(struct incr_test *t, struct rte_acl_ipv4vlan_rule *r, uint32_t i,
+	const uint8_t proto[])
+{
+	uint32_t j, ud;
+
+	memset(r, 0, sizeof(*r));
+
+	ud = ++t->next_userdata;
+	r->data.userdata = ud;
+	/* unique priorities, so the results do not depend on ties */
+	r->data.priority = (ud * 7919) % 100003 + 1;
+	r->data.category_mask = 1 + i % RTE_LEN2MASK(INCR_CATEGORIES, uint32_t);
+
+	r->src_port_high = UINT16_MAX;
+	r->dst_port_high = UINT16_MAX;
+
+	/* disjoint port ranges for each protocol */
+	if (i < PART_NB_PROTO * PART_PROTO_RULES) {
+		j = i / PART_NB_PROTO;
+		r->proto = proto[i % PART_NB_PROTO];
+		r->proto_mask = UINT8_MAX;
+		r->src_port_low = j * 17 + 1;
+		r->src_port_high = r->src_port_low + 4;
+		r->dst_port_low = j * 13 + 1;
+		r->dst_port_high = r->dst_port_low + 4;
+		return;
+	}
+
+	i -= PART_NB_PROTO * PART_PROTO_RULES;
+	if (i < PART_DST_RULES) {
+		r->dst_mask_len = 32;
+		r->dst_addr = RTE_IPV4(10, i >> 8, i & 0xff, i * 7 & 0xff);
+		return;
+	}
+
+	i -= PART_DST_RULES;
+	r->src_mask_len = 32;
+	r->src_addr = RTE_IPV4(10, i >> 8, i & 0xff, i * 11 & 0xff);
+}
+
+/*
+ * Packet matching the given rule.
+ */
+static void
+part_rule_pkt(const struct rte_acl_ipv4vlan_rule *r, struct ipv4_7tuple *pkt)
+{
+	memset(pkt, 0, sizeof(*pkt));
+	pkt->proto = (r->proto_mask != 0) ? r->proto :
+		rte_rand_max(UINT8_MAX + 1);
+	pkt->ip_src = r->src_addr | (rte_rand() &
+		~RTE_ACL_MASKLEN_TO_BITMASK(r->src_mask_len, sizeof(uint32_t)));
+	pkt->ip_dst = r->dst_addr | (rte_rand() &
+		~RTE_ACL_MASKLEN_TO_BITMASK(r->dst_mask_len, sizeof(uint32_t)));
+	pkt->port_src = r->src_port_low +
+		rte_rand_max(r->src_port_high - r->src_port_low + 1);
+	pkt->port_dst = r->dst_port_low +
+		rte_rand_max(r->dst_port_high - r->dst_port_low + 1);
+}
+
+/*
+ * Test classification of rules that mostly match one protocol,
+ * so that the build tries to partition them by the first field,
+ * against the reference results.
+ * Also check that the per trie statistics are consistent.
+ */
+static int
+test_trie_parts(void)
+{
+	static const uint8_t proto[PART_NB_PROTO] = {
+		IPPROTO_TCP, IPPROTO_UDP, IPPROTO_ICMP,
+	};
+	static const enum rte_acl_classify_alg alg[] = {
+		RTE_ACL_CLASSIFY_SCALAR,
+		RTE_ACL_CLASSIFY_SSE,
+		RTE_ACL_CLASSIFY_AVX2,
+		RTE_ACL_CLASSIFY_NEON,
+		RTE_ACL_CLASSIFY_ALTIVEC,
+		RTE_ACL_CLASSIFY_AVX512X16,
+		RTE_ACL_CLASSIFY_AVX512X32,
+	};
+	struct rte_acl_trie_stats stats[PART_MAX_TRIES];
+	struct rte_acl_ipv4vlan_rule *r;
+	struct rte_acl_param prm;
+	struct incr_test *t;
+	struct rte_acl_ctx *acx;
+	const uint8_t *data[PART_NB_PKTS];
+	uint32_t *ref_res;
+	uint32_t i, j, k, n;
+	int32_t rc;
+
+	t = calloc(1, sizeof(*t));
+	ref_res = malloc(sizeof(t->res));
+	r = calloc(PART_NB_RULES, sizeof(r[0]));
+	if (t == NULL || ref_res == NULL || r == NULL) {
+		rc = -1;
+		goto out;
+	}
+
+	ipv4vlan_config(&t->cfg, ipv4_7tuple_layout, INCR_CATEGORIES);
+
+	for (i = 0; i != PART_NB_RULES; i++)
+		part_rule(t, r + i, i, proto);
+
+	prm = acl_param;
+	prm.name = "acl_part";
+	prm.max_rule_num = PART_NB_RULES;
+	acx = rte_acl_create(&prm);
+	if (acx == NULL) {
+		printf("%s#%i: Error creating ACL context!\n",
+			__func__, __LINE__);
+		rc = -1;
+		goto out;
+	}
+	t->acx = acx;
+
+	rc = incr_add_rules(acx, r, PART_NB_RULES, 0);
+	if (rc == 0)
+		rc = rte_acl_build(acx, &t->cfg);
+	if (rc != 0) {
+		printf("%s#%i: build failed: %d\n", __func__, __LINE__, rc);
+		goto out;
+	}
+
+	for (i = 0; i != PART_NB_PKTS; i++) {
+		/* most of the packets hit some rule, others are random */
+		if (rte_rand_max(8) != 0)
+			part_rule_pkt(r + rte_rand_max(PART_NB_RULES),
+				t->pkts + i);
+		else {
+			t->pkts[i].proto = rte_rand_max(UINT8_MAX + 1);
+			t->pkts[i].ip_src = rte_rand();
+			t->pkts[i].ip_dst = rte_rand();
+			t->pkts[i].port_src = rte_rand();
+			t->pkts[i].port_dst = rte_rand();
+		}
+	}
+
+	/* reference results for the packets in host byte order */
+	for (i = 0; i != PART_NB_PKTS; i++)
+		part_classify_ref(r, PART_NB_RULES, &t->pkts[i],
+			ref_res + i * INCR_CATEGORIES);
+
+	bswap_test_data(t->pkts, PART_NB_PKTS, 1);
+	for (i = 0; i != PART_NB_PKTS; i++)
+		data[i] = (const uint8_t *)&t->pkts[i];
+
+	rc = rte_acl_trie_stats(NULL, data, PART_NB_PKTS, stats,
+		RTE_DIM(stats));
+	if (rc != -EINVAL) {
+		printf("%s#%i: trie stats with invalid context: %d\n",
+			__func__, __LINE__, rc);
+		rc = -1;
+		goto out;
+	}
+
+	rc = rte_acl_trie_stats(acx, data, PART_NB_PKTS, stats,
+		RTE_DIM(stats));
+	if (rc <= 0 || rc > PART_MAX_TRIES) {
+		printf("%s#%i: trie stats failed: %d\n",
+			__func__, __LINE__, rc);
+		rc = -1;
+		goto out;
+	}
+
+	/* each rule is in at least one trie, each packet walks at most all */
+	n = rc;
+	for (i = 0, j = 0, k = 0; i != n; i++) {
+		j += stats[i].num_rules;
+		k += stats[i].num_walks;
+		if (stats[i].num_walks > PART_NB_PKTS) {
+			printf("%s#%i: trie %u walked %u times "
+				"for %u packets\n", __func__, __LINE__,
+				i, stats[i].num_walks, PART_NB_PKTS);
+			rc = -1;
+			goto out;
+		}
+	}
+	if (j < PART_NB_RULES || k > n * PART_NB_PKTS) {
+		printf("%s#%i: inconsistent trie stats: "
+			"%u tries, %u rules, %u walks\n",
+			__func__, __LINE__, n, j, k);
+		rc = -1;
+		goto out;
+	}
+
+	/* the rules are partitioned, some packets skip some tries */
+	if (n < 2 || k >= n * PART_NB_PKTS) {
+		printf("%s#%i: no trie skipped: "
+			"%u tries, %u walks for %u packets\n",
+			__func__, __LINE__, n, k, PART_NB_PKTS);
+		rc = -1;
+		goto out;
+	}
+
+	for (i = 0; i != RTE_DIM(alg); i++) {
+
+		/* skip methods not supported on this platform */
+		if (rte_acl_set_ctx_classify(acx, alg[i]) != 0)
+			continue;
+
+		rc = rte_acl_classify(acx, data, t->res, PART_NB_PKTS,
+			INCR_CATEGORIES);
+		if (rc != 0) {
+			printf("%s#%i: alg %d: classify failed: %d\n",
+				__func__, __LINE__, alg[i], rc);
+			goto out;
+		}
+
+		for (k = 0; k != PART_NB_PKTS * INCR_CATEGORIES; k++) {
+			if (t->res[k] != ref_res[k]) {
+				j = k / INCR_CATEGORIES;
+				printf("%s#%i: alg %d, packet %u (proto %u), "
+					"category %u: result %u, "
+					"expected %u\n", __func__, __LINE__,
+					alg[i], j, t->pkts[j].proto,
+					k % INCR_CATEGORIES, t->res[k],
+					ref_res[k]);
+				rc = -1;
+				goto out;
+			}
+		}
+	}
+
+	rc = 0;
+out:
+	if (t != NULL)
+		rte_acl_free(t->acx);
+	free(r);
+	free(ref_res);
+	free(t);
+	return rc;
+}
+
 static int
 test_acl(void)
 {
@@ -1742,6 +2349,10 @@ test_acl(void)
 		return -1;
 	if (test_u32_range() < 0)
 		return -1;
+	if (test_incr_update() < 0)
+		return -1;
+	if (test_trie_parts() < 0)
+		return -1;
 
 	return 0;
 }
@@ -390,6 +390,194 @@ static int test_average_table_utilization(void)
 	return 0;
 }
 
+#define BULK_TEST_NUM_KEYS (1 << 15)
+#define RESIZE_TEST_NUM_KEYS (1 << 12)
+
+static uint64_t bulk_keys[BULK_TEST_NUM_KEYS + 1];
+static const void *bulk_key_ptrs[BULK_TEST_NUM_KEYS + 1];
+static efd_value_t bulk_values[BULK_TEST_NUM_KEYS + 1];
+static int bulk_status[BULK_TEST_NUM_KEYS + 1];
+
+/* Unique random keys, the low 32 bits hold the key index */
+static void
+bulk_keys_init(uint32_t num_keys)
+{
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		bulk_keys[i] = (rte_rand() << 32) | i;
+		bulk_key_ptrs[i] = &bulk_keys[i];
+		bulk_values[i] = rte_rand() & VALUE_BITMASK;
+	}
+}
+
+static int
+bulk_keys_check(const struct rte_efd_table *handle, uint32_t num_keys)
+{
+	efd_value_t result[RTE_EFD_BURST_MAX];
+	uint32_t i, j, n;
+
+	for (i = 0; i < num_keys; i += n) {
+		n = RTE_MIN(num_keys - i, (uint32_t)RTE_EFD_BURST_MAX);
+		rte_efd_lookup_bulk(handle, test_socket_id, n,
+				bulk_key_ptrs + i, result);
+		for (j = 0; j < n; j++)
+			TEST_ASSERT_EQUAL(result[j], bulk_values[i + j],
+					"key %u: expected %u, got %u", i + j,
+					bulk_values[i + j], result[j]);
+	}
+
+	return 0;
+}
+
+/*
+ * Sequence of operations for bulk updates
+ *      - add keys in bulk, with a duplicated key
+ *      - lookup keys: hit
+ *      - update same values: no change
+ *      - update all values in bulk
+ *      - lookup keys: hit (updated data)
+ *      - delete half of the keys and add them back in bulk
+ */
+static int test_update_bulk(void)
+{
+	struct rte_efd_table *handle;
+	efd_value_t prev_value;
+	uint32_t i;
+
+	printf("Entering %s\n", __func__);
+
+	handle = rte_efd_create("test_update_bulk", 2 * BULK_TEST_NUM_KEYS,
+			sizeof(bulk_keys[0]), efd_get_all_sockets_bitmask(),
+			test_socket_id);
+	TEST_ASSERT_NOT_NULL(handle, "Error creating the efd table\n");
+
+	TEST_ASSERT_EQUAL(rte_efd_update_bulk(NULL, test_socket_id, 1,
+			bulk_key_ptrs, bulk_values, NULL), -EINVAL,
+			"bulk update of NULL table should fail");
+	TEST_ASSERT_EQUAL(rte_efd_update_bulk(handle, test_socket_id, 0,
+			NULL, NULL, NULL), 0,
+			"empty bulk update should succeed");
+
+	bulk_keys_init(BULK_TEST_NUM_KEYS);
+
+	/* The last occurrence of a key wins */
+	bulk_key_ptrs[BULK_TEST_NUM_KEYS] = bulk_key_ptrs[0];
+	bulk_values[BULK_TEST_NUM_KEYS] = bulk_values[0];
+	bulk_values[0] = (bulk_values[0] + 1) & VALUE_BITMASK;
+
+	TEST_ASSERT_SUCCESS(rte_efd_update_bulk(handle, test_socket_id,
+			BULK_TEST_NUM_KEYS + 1, bulk_key_ptrs, bulk_values,
+			bulk_status), "Error inserting the keys");
+	for (i = 0; i <= BULK_TEST_NUM_KEYS; i++)
+		TEST_ASSERT(bulk_status[i] == 0 ||
+				bulk_status[i] == RTE_EFD_UPDATE_WARN_GROUP_FULL,
+				"unexpected status %d for key %u",
+				bulk_status[i], i);
+
+	bulk_values[0] = bulk_values[BULK_TEST_NUM_KEYS];
+	if (bulk_keys_check(handle, BULK_TEST_NUM_KEYS) < 0)
+		goto error;
+
+	TEST_ASSERT_SUCCESS(rte_efd_update_bulk(handle, test_socket_id,
+			BULK_TEST_NUM_KEYS, bulk_key_ptrs, bulk_values,
+			bulk_status), "Error updating the keys");
+	for (i = 0; i < BULK_TEST_NUM_KEYS; i++)
+		TEST_ASSERT_EQUAL(bulk_status[i], RTE_EFD_UPDATE_NO_CHANGE,
+				"key %u should not have changed", i);
+
+	for (i = 0; i < BULK_TEST_NUM_KEYS; i++)
+		bulk_values[i] = (bulk_values[i] + 1) & VALUE_BITMASK;
+	TEST_ASSERT_SUCCESS(rte_efd_update_bulk(handle, test_socket_id,
+			BULK_TEST_NUM_KEYS, bulk_key_ptrs, bulk_values, NULL),
+			"Error updating the keys");
+	if (bulk_keys_check(handle, BULK_TEST_NUM_KEYS) < 0)
+		goto error;
+
+	for (i = 0; i < BULK_TEST_NUM_KEYS; i += 2) {
+		TEST_ASSERT_SUCCESS(rte_efd_delete(handle, test_socket_id,
+				bulk_key_ptrs[i], &prev_value),
+				"failed to delete key");
+		TEST_ASSERT_EQUAL(prev_value, bulk_values[i],
+				"failed to delete the expected value, got %u, "
+				"expected %u", prev_value, bulk_values[i]);
+	}
+	TEST_ASSERT_SUCCESS(rte_efd_update_bulk(handle, test_socket_id,
+			BULK_TEST_NUM_KEYS, bulk_key_ptrs, bulk_values, NULL),
+			"Error inserting the keys back");
+	if (bulk_keys_check(handle, BULK_TEST_NUM_KEYS) < 0)
+		goto error;
+
+	rte_efd_free(handle);
+	return 0;
+
+error:
+	rte_efd_free(handle);
+	return -1;
+}
+
+/*
+ * Sequence of operations for table growth
+ *      - fill a small table
+ *      - resize to a smaller or the same size: fail
+ *      - resize to a larger size
+ *      - lookup keys: hit
+ *      - add more keys in bulk
+ *      - lookup keys: hit
+ */
+static int test_resize(void)
+{
+	struct rte_efd_table *handle;
+	uint32_t i;
+
+	printf("Entering %s\n", __func__);
+
+	handle = rte_efd_create("test_resize", RESIZE_TEST_NUM_KEYS,
+			sizeof(bulk_keys[0]), efd_get_all_sockets_bitmask(),
+			test_socket_id);
+	TEST_ASSERT_NOT_NULL(handle, "Error creating the efd table\n");
+
+	bulk_keys_init(4 * RESIZE_TEST_NUM_KEYS);
+	for (i = 0; i < RESIZE_TEST_NUM_KEYS; i++) {
+		if (rte_efd_update(handle, test_socket_id, bulk_key_ptrs[i],
+				bulk_values[i]) == RTE_EFD_UPDATE_FAILED) {
+			printf("Error inserting key %u\n", i);
+			goto error;
+		}
+	}
+
+	TEST_ASSERT_EQUAL(rte_efd_resize(handle, RESIZE_TEST_NUM_KEYS / 2),
+			-EINVAL, "shrinking the table should fail");
+	TEST_ASSERT_EQUAL(rte_efd_resize(handle, RESIZE_TEST_NUM_KEYS),
+			-EINVAL, "resizing to the same size should fail");
+
+	TEST_ASSERT_SUCCESS(rte_efd_resize(handle, 4 * RESIZE_TEST_NUM_KEYS),
+			"Error resizing the table");
+	if (bulk_keys_check(handle, RESIZE_TEST_NUM_KEYS) < 0)
+		goto error;
+
+	TEST_ASSERT_SUCCESS(rte_efd_update_bulk(handle, test_socket_id,
+			3 * RESIZE_TEST_NUM_KEYS,
+			bulk_key_ptrs + RESIZE_TEST_NUM_KEYS,
+			bulk_values + RESIZE_TEST_NUM_KEYS, NULL),
+			"Error inserting the keys after resize");
+	if (bulk_keys_check(handle, 4 * RESIZE_TEST_NUM_KEYS) < 0)
+		goto error;
+
+	/* Grow once more, the free slots ring is created again */
+	TEST_ASSERT_SUCCESS(rte_efd_resize(handle, 16 * RESIZE_TEST_NUM_KEYS),
+			"Error resizing the table");
+	if (bulk_keys_check(handle, 4 * RESIZE_TEST_NUM_KEYS) < 0)
+		goto error;
+
+	rte_efd_free(handle);
+	return 0;
+
+error:
+	rte_efd_free(handle);
+	return -1;
+}
+
 /*
  * Do tests for EFD creation with bad parameters.
  */
@@ -463,6 +651,10 @@ test_efd(void)
 		return -1;
 	if (test_five_keys() < 0)
 		return -1;
+	if (test_update_bulk() < 0)
+		return -1;
+	if (test_resize() < 0)
+		return -1;
 	if (test_efd_creation_with_bad_parameters() < 0)
 		return -1;
 	if (test_average_table_utilization() < 0)
@@ -24,6 +24,8 @@ test_efd_perf(void)
 #include <rte_efd.h>
 #include <rte_memcpy.h>
 #include <rte_thash.h>
+#include <rte_rcu_qsbr.h>
+#include <rte_stdatomic.h>
 
 #define NUM_KEYSIZES 10
 #define NUM_SHUFFLES 10
@@ -31,6 +33,8 @@ test_efd_perf(void)
 #define MAX_ENTRIES (1 << 19)
 #define KEYS_TO_ADD (MAX_ENTRIES * 3 / 4) /* 75% table utilization */
 #define NUM_LOOKUPS (KEYS_TO_ADD * 5) /* Loop among keys added, several times */
+#define LARGE_NUM_KEYS (1 << 22)
+#define LARGE_BULK_SIZE (1 << 16)
 
 #if RTE_EFD_VALUE_NUM_BITS == 32
 #define VALUE_BITMASK 0xffffffff
@@ -381,6 +385,245 @@ run_all_tbl_perf_tests(void)
 	return 0;
 }
 
+/* Keys and values of the large table tests */
+struct efd_large_params {
+	struct rte_efd_table *efd_table;
+	uint64_t *keys;
+	const void **key_ptrs;
+	efd_value_t *values;
+	struct rte_rcu_qsbr *v;
+	uint32_t num_lookup_keys;
+	RTE_ATOMIC(uint32_t) stop;
+	RTE_ATOMIC(uint64_t) lookups;
+	RTE_ATOMIC(uint64_t) mismatches;
+};
+
+static int
+large_bulk_update(struct efd_large_params *p, uint32_t first, uint32_t num)
+{
+	uint32_t i, n;
+	int ret;
+
+	for (i = 0; i < num; i += n) {
+		n = RTE_MIN(num - i, (uint32_t)LARGE_BULK_SIZE);
+		ret = rte_efd_update_bulk(p->efd_table, test_socket_id, n,
+				p->key_ptrs + first + i, p->values + first + i,
+				NULL);
+		if (ret != 0) {
+			printf("Error %d in rte_efd_update_bulk\n", ret);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int
+large_check(struct efd_large_params *p, uint32_t num)
+{
+	efd_value_t result[RTE_EFD_BURST_MAX];
+	uint32_t i, j, n;
+
+	for (i = 0; i < num; i += n) {
+		n = RTE_MIN(num - i, (uint32_t)RTE_EFD_BURST_MAX);
+		rte_efd_lookup_bulk(p->efd_table, test_socket_id, n,
+				p->key_ptrs + i, result);
+		for (j = 0; j < n; j++) {
+			if (result[j] != p->values[i + j]) {
+				printf("Value mismatch for key #%u: "
+						"expected %u, got %u\n", i + j,
+						p->values[i + j], result[j]);
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* Bulk lookups on another lcore while the table grows */
+static int
+large_lookup_worker(void *arg)
+{
+	struct efd_large_params *p = arg;
+	efd_value_t result[RTE_EFD_BURST_MAX];
+	unsigned int lcore_id = rte_lcore_id();
+	uint64_t lookups = 0, mismatches = 0;
+	uint32_t i, j;
+
+	rte_rcu_qsbr_thread_register(p->v, lcore_id);
+	rte_rcu_qsbr_thread_online(p->v, lcore_id);
+
+	i = 0;
+	while (rte_atomic_load_explicit(&p->stop,
+			rte_memory_order_relaxed) == 0) {
+		rte_efd_lookup_bulk(p->efd_table, test_socket_id,
+				RTE_EFD_BURST_MAX, p->key_ptrs + i, result);
+		for (j = 0; j < RTE_EFD_BURST_MAX; j++)
+			mismatches += (result[j] != p->values[i + j]);
+		lookups += RTE_EFD_BURST_MAX;
+		rte_rcu_qsbr_quiescent(p->v, lcore_id);
+
+		i += RTE_EFD_BURST_MAX;
+		if (i + RTE_EFD_BURST_MAX > p->num_lookup_keys)
+			i = 0;
+	}
+
+	rte_rcu_qsbr_thread_offline(p->v, lcore_id);
+	rte_rcu_qsbr_thread_unregister(p->v, lcore_id);
+
+	rte_atomic_store_explicit(&p->lookups, lookups,
+			rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&p->mismatches, mismatches,
+			rte_memory_order_relaxed);
+	return 0;
+}
+
+/*
+ * Fill a table with millions of keys:
+ * single key vs bulk updates, growth of the table
+ * with concurrent lookups, and migration of all the values.
+ */
+static int
+run_large_tbl_perf_tests(void)
+{
+	struct efd_large_params p = { 0 };
+	unsigned int worker_id = RTE_MAX_LCORE;
+	uint64_t start_tsc, update_cycles, bulk_cycles, resize_cycles;
+	uint64_t migrate_cycles, mismatches;
+	const uint32_t quarter = LARGE_NUM_KEYS / 4;
+	uint32_t i, j;
+	int ret = -1;
+
+	printf("\nMeasuring performance with %u keys, please wait\n",
+			LARGE_NUM_KEYS);
+	fflush(stdout);
+
+	p.keys = rte_malloc(NULL, LARGE_NUM_KEYS * sizeof(p.keys[0]), 0);
+	p.key_ptrs = rte_malloc(NULL, LARGE_NUM_KEYS * sizeof(p.key_ptrs[0]),
+			0);
+	p.values = rte_malloc(NULL, LARGE_NUM_KEYS * sizeof(p.values[0]), 0);
+	p.v = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE),
+			RTE_CACHE_LINE_SIZE);
+	if (p.keys == NULL || p.key_ptrs == NULL || p.values == NULL ||
+			p.v == NULL) {
+		printf("Could not allocate keys/data\n");
+		goto exit;
+	}
+	rte_rcu_qsbr_init(p.v, RTE_MAX_LCORE);
+
+	/* Unique keys, the low 32 bits hold the key index */
+	for (i = 0; i < LARGE_NUM_KEYS; i++) {
+		p.keys[i] = (rte_rand() << 32) | i;
+		p.key_ptrs[i] = &p.keys[i];
+		p.values[i] = rte_rand() & VALUE_BITMASK;
+	}
+
+	p.efd_table = rte_efd_create("test_efd_perf_large",
+			LARGE_NUM_KEYS / 2, sizeof(p.keys[0]),
+			efd_get_all_sockets_bitmask(), test_socket_id);
+	if (p.efd_table == NULL) {
+		printf("Error creating the efd table\n");
+		goto exit;
+	}
+	rte_efd_rcu_qsbr_add(p.efd_table, p.v);
+
+	/*
+	 * Alternate single key and bulk updates,
+	 * so that both see the same table occupancy
+	 */
+	update_cycles = 0;
+	bulk_cycles = 0;
+	for (i = 0; i < 2 * quarter; i += 2 * LARGE_BULK_SIZE) {
+		start_tsc = rte_rdtsc();
+		for (j = i; j < i + LARGE_BULK_SIZE; j++) {
+			if (rte_efd_update(p.efd_table, test_socket_id,
+					p.key_ptrs[j], p.values[j]) ==
+					RTE_EFD_UPDATE_FAILED) {
+				printf("Error in rte_efd_update for key #%u\n",
+						j);
+				goto exit;
+			}
+		}
+		update_cycles += rte_rdtsc() - start_tsc;
+
+		start_tsc = rte_rdtsc();
+		if (large_bulk_update(&p, i + LARGE_BULK_SIZE,
+				LARGE_BULK_SIZE) < 0)
+			goto exit;
+		bulk_cycles += rte_rdtsc() - start_tsc;
+	}
+	update_cycles /= quarter;
+	bulk_cycles /= quarter;
+
+	if (large_check(&p, 2 * quarter) < 0)
+		goto exit;
+
+	/* Grow the table while another lcore looks up the keys added */
+	p.num_lookup_keys = 2 * quarter;
+	if (rte_lcore_count() > 1) {
+		worker_id = rte_get_next_lcore(-1, 1, 0);
+		rte_eal_remote_launch(large_lookup_worker, &p, worker_id);
+	}
+
+	start_tsc = rte_rdtsc();
+	ret = rte_efd_resize(p.efd_table, LARGE_NUM_KEYS);
+	resize_cycles = rte_rdtsc() - start_tsc;
+
+	if (worker_id != RTE_MAX_LCORE) {
+		rte_atomic_store_explicit(&p.stop, 1,
+				rte_memory_order_relaxed);
+		rte_eal_wait_lcore(worker_id);
+	}
+	if (ret != 0) {
+		printf("Error %d in rte_efd_resize\n", ret);
+		goto exit;
+	}
+	ret = -1;
+
+	mismatches = rte_atomic_load_explicit(&p.mismatches,
+			rte_memory_order_relaxed);
+	if (mismatches != 0) {
+		printf("%"PRIu64" lookup mismatches during resize\n",
+				mismatches);
+		goto exit;
+	}
+
+	if (large_bulk_update(&p, 2 * quarter, 2 * quarter) < 0)
+		goto exit;
+
+	/* Migrate all the keys to new values */
+	for (i = 0; i < LARGE_NUM_KEYS; i++)
+		p.values[i] = (p.values[i] + 1) & VALUE_BITMASK;
+
+	start_tsc = rte_rdtsc();
+	if (large_bulk_update(&p, 0, LARGE_NUM_KEYS) < 0)
+		goto exit;
+	migrate_cycles = (rte_rdtsc() - start_tsc) / LARGE_NUM_KEYS;
+
+	if (large_check(&p, LARGE_NUM_KEYS) < 0)
+		goto exit;
+
+	printf("\nResults (in CPU cycles/key, resize in CPU cycles)\n");
+	printf("-----------------------------------\n");
+	printf("\n%-18s%-18s%-18s%-18s%-18s\n",
+			"Add", "Add_bulk", "Migrate_bulk", "Resize",
+			"Resize_lookups");
+	printf("%-18"PRIu64"%-18"PRIu64"%-18"PRIu64"%-18"PRIu64"%-18"PRIu64
+			"\n", update_cycles, bulk_cycles, migrate_cycles,
+			resize_cycles, rte_atomic_load_explicit(&p.lookups,
+			rte_memory_order_relaxed));
+	ret = 0;
+
+exit:
+	rte_efd_free(p.efd_table);
+	rte_free(p.v);
+	rte_free(p.values);
+	rte_free(p.key_ptrs);
+	rte_free(p.keys);
+	return ret;
+}
+
 static int
 test_efd_perf(void)
 {
@@ -388,6 +631,9 @@ test_efd_perf(void)
 	if (run_all_tbl_perf_tests() < 0)
 		return -1;
 
+	if (run_large_tbl_perf_tests() < 0)
+		return -1;
+
 	return 0;
 }
 
@@ -8,6 +8,7 @@
 #include <stdlib.h>
 
 #include <rte_ip.h>
+#include <rte_random.h>
 #include <rte_log.h>
 #include <rte_fib.h>
 #include <rte_malloc.h>
@@ -24,6 +25,7 @@ static int32_t test_get_invalid(void);
 static int32_t test_lookup(void);
 static int32_t test_invalid_rcu(void);
 static int32_t test_fib_rcu_sync_rw(void);
+static int32_t test_add_bulk(void);
 
 #define MAX_ROUTES	(1 << 16)
 #define MAX_TBL8	(1 << 15)
@@ -588,6 +590,112 @@ test_fib_rcu_sync_rw(void)
 	return status == 0 ? TEST_SUCCESS : TEST_FAILED;
 }
 
+#define BULK_ROUTES	4096
+#define BULK_LOOKUPS	(BULK_ROUTES * 4)
+
+/*
+ * Check rte_fib_bulk_prepare() and rte_fib_add_bulk():
+ *  - a prefix given several times keeps its last next hop
+ *  - the whole batch is rejected if there are not enough tbl8 groups
+ *  - the DIR24_8 FIB filled with rte_fib_add_bulk() returns the same
+ *    next hops as the DUMMY FIB filled with rte_fib_add()
+ */
+int32_t
+test_add_bulk(void)
+{
+	struct rte_fib *fib, *ref;
+	struct rte_fib_conf config = { 0 };
+	struct rte_fib_route *routes;
+	struct rte_fib_route dup[3];
+	uint32_t ips[BULK_LOOKUPS];
+	uint64_t nh[BULK_LOOKUPS], ref_nh[BULK_LOOKUPS];
+	uint64_t def_nh = 100;
+	uint32_t i;
+	int ret;
+
+	ret = rte_fib_bulk_prepare(NULL, 1);
+	RTE_TEST_ASSERT(ret == -EINVAL, "Call succeeded with invalid params\n");
+	ret = rte_fib_add_bulk(NULL, dup, 1);
+	RTE_TEST_ASSERT(ret == -EINVAL, "Call succeeded with invalid params\n");
+
+	dup[0] = (struct rte_fib_route){ RTE_IPV4(10, 0, 0, 1), 24, 1 };
+	dup[1] = (struct rte_fib_route){ RTE_IPV4(10, 0, 0, 0), 8, 2 };
+	dup[2] = (struct rte_fib_route){ RTE_IPV4(10, 0, 0, 2), 24, 3 };
+	ret = rte_fib_bulk_prepare(dup, RTE_DIM(dup));
+	RTE_TEST_ASSERT(ret == 2, "Duplicate prefixes are not coalesced\n");
+	RTE_TEST_ASSERT((dup[0].depth == 8) && (dup[0].next_hop == 2) &&
+		(dup[1].ip == RTE_IPV4(10, 0, 0, 0)) && (dup[1].next_hop == 3),
+		"Wrong order of prepared routes\n");
+
+	routes = rte_malloc(NULL, sizeof(*routes) * BULK_ROUTES, 0);
+	RTE_TEST_ASSERT(routes != NULL, "Failed to allocate routes\n");
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = def_nh;
+	config.type = RTE_FIB_DIR24_8;
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_4B;
+	config.dir24_8.num_tbl8 = 64;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+	for (i = 0; i < 65; i++) {
+		routes[i].ip = RTE_IPV4(10, 0, i, 1);
+		routes[i].depth = 32;
+		routes[i].next_hop = i;
+	}
+	ret = rte_fib_add_bulk(fib, routes, 65);
+	RTE_TEST_ASSERT(ret == -ENOSPC, "Batch exceeding tbl8 succeeded\n");
+	ret = rte_fib_lookup_bulk(fib, &routes[0].ip, nh, 1);
+	RTE_TEST_ASSERT((ret == 0) && (nh[0] == def_nh),
+		"Rejected batch modified the FIB\n");
+	rte_fib_free(fib);
+
+	/* random routes with repeated prefixes and nested /24 groups */
+	for (i = 0; i < BULK_ROUTES; i++) {
+		if ((i != 0) && ((rte_rand() & 7) == 0))
+			routes[i].ip = routes[rte_rand_max(i)].ip;
+		else
+			routes[i].ip = (uint32_t)rte_rand() & 0xff00ffff;
+		routes[i].depth = rte_rand_max(RTE_FIB_MAXDEPTH) + 1;
+		routes[i].next_hop = rte_rand_max(1 << 16);
+	}
+
+	config.dir24_8.num_tbl8 = MAX_TBL8;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	config.type = RTE_FIB_DUMMY;
+	ref = rte_fib_create("test_add_bulk_ref", SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(ref != NULL, "Failed to create FIB\n");
+
+	for (i = 0; i < BULK_ROUTES; i++) {
+		ret = rte_fib_add(ref, routes[i].ip, routes[i].depth,
+			routes[i].next_hop);
+		RTE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+	}
+	for (i = 0; i < BULK_LOOKUPS; i++) {
+		ips[i] = routes[i % BULK_ROUTES].ip;
+		if (i >= BULK_ROUTES)
+			ips[i] += rte_rand_max(1 << 10);
+	}
+
+	ret = rte_fib_add_bulk(fib, routes, BULK_ROUTES);
+	RTE_TEST_ASSERT(ret == 0, "Failed to add routes in bulk\n");
+
+	ret = rte_fib_lookup_bulk(fib, ips, nh, BULK_LOOKUPS);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+	ret = rte_fib_lookup_bulk(ref, ips, ref_nh, BULK_LOOKUPS);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+	for (i = 0; i < BULK_LOOKUPS; i++)
+		RTE_TEST_ASSERT(nh[i] == ref_nh[i],
+			"Wrong nexthop for %u after bulk add\n", ips[i]);
+
+	rte_fib_free(ref);
+	rte_fib_free(fib);
+	rte_free(routes);
+
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite fib_fast_tests = {
 	.suite_name = "fib autotest",
 	.setup = NULL,
@@ -600,6 +708,7 @@ static struct unit_test_suite fib_fast_tests = {
 	TEST_CASE(test_lookup),
 	TEST_CASE(test_invalid_rcu),
 	TEST_CASE(test_fib_rcu_sync_rw),
+	TEST_CASE(test_add_bulk),
 	TEST_CASES_END()
 	}
 };
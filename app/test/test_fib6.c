@@ -12,6 +12,7 @@
 #include <rte_rib6.h>
 #include <rte_fib6.h>
 #include <rte_malloc.h>
+#include <rte_random.h>
 
 #include "test.h"
 
@@ -25,10 +26,15 @@ static int32_t test_get_invalid(void);
 static int32_t test_lookup(void);
 static int32_t test_invalid_rcu(void);
 static int32_t test_fib_rcu_sync_rw(void);
+static int32_t test_poptrie_random(void);
+static int32_t test_poptrie_churn(void);
 
 #define MAX_ROUTES	(1 << 16)
 /** Maximum number of tbl8 for 2-byte entries */
 #define MAX_TBL8	(1 << 15)
+/** Number of poptrie nodes and leaves */
+#define POPTRIE_NODES	(1 << 16)
+#define POPTRIE_LEAVES	(1 << 18)
 
 /*
  * Check that rte_fib6_create fails gracefully for incorrect user input
@@ -67,7 +73,7 @@ test_create_invalid(void)
 		"Call succeeded with invalid parameters\n");
 	config.max_routes = MAX_ROUTES;
 
-	config.type = RTE_FIB6_TRIE + 1;
+	config.type = RTE_FIB6_POPTRIE + 1;
 	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
 	RTE_TEST_ASSERT(fib == NULL,
 		"Call succeeded with invalid parameters\n");
@@ -86,6 +92,33 @@ test_create_invalid(void)
 	RTE_TEST_ASSERT(fib == NULL,
 		"Call succeeded with invalid parameters\n");
 
+	config.type = RTE_FIB6_POPTRIE;
+	config.poptrie.nh_sz = RTE_FIB6_TRIE_8B + 1;
+	config.poptrie.num_nodes = POPTRIE_NODES;
+	config.poptrie.num_leaves = POPTRIE_LEAVES;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+	config.poptrie.nh_sz = RTE_FIB6_TRIE_2B;
+
+	config.poptrie.num_nodes = 0;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+	config.poptrie.num_nodes = POPTRIE_NODES;
+
+	config.poptrie.num_leaves = 0;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+	config.poptrie.num_leaves = POPTRIE_LEAVES;
+
+	/* default next hop does not fit into 2 bytes */
+	config.default_nh = UINT16_MAX + 1;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
 	return TEST_SUCCESS;
 }
 
@@ -338,12 +371,23 @@ check_fib(struct rte_fib6 *fib)
 	return TEST_SUCCESS;
 }
 
+static const enum rte_fib_trie_nh_sz poptrie_nh_sz[] = {
+	RTE_FIB6_TRIE_2B, RTE_FIB6_TRIE_4B, RTE_FIB6_TRIE_8B,
+};
+
+static const enum rte_fib6_lookup_type poptrie_lookups[] = {
+	RTE_FIB6_LOOKUP_POPTRIE_SCALAR,
+	RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX2,
+	RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX512,
+};
+
 int32_t
 test_lookup(void)
 {
 	struct rte_fib6 *fib = NULL;
 	struct rte_fib6_conf config;
 	uint64_t def_nh = 100;
+	unsigned int i, j;
 	int ret;
 
 	config.max_routes = MAX_ROUTES;
@@ -387,6 +431,191 @@ test_lookup(void)
 		"Check_fib fails for TRIE_8B type\n");
 	rte_fib6_free(fib);
 
+	config.type = RTE_FIB6_POPTRIE;
+	config.poptrie.num_nodes = POPTRIE_NODES;
+	config.poptrie.num_leaves = POPTRIE_LEAVES;
+	for (i = 0; i < RTE_DIM(poptrie_nh_sz); i++) {
+		config.poptrie.nh_sz = poptrie_nh_sz[i];
+		for (j = 0; j < RTE_DIM(poptrie_lookups); j++) {
+			fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+			RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+			/* skip the implementations the CPU does not support */
+			if (rte_fib6_select_lookup(fib,
+					poptrie_lookups[j]) == 0) {
+				ret = check_fib(fib);
+				RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+					"Check_fib fails for POPTRIE type, nh_sz %d, lookup %d\n",
+					poptrie_nh_sz[i], poptrie_lookups[j]);
+			}
+			rte_fib6_free(fib);
+		}
+	}
+
+	return TEST_SUCCESS;
+}
+
+#define POPTRIE_RND_ROUTES	4096
+#define POPTRIE_RND_LOOKUPS	1024
+
+static void
+gen_random_ip(struct rte_ipv6_addr *ip)
+{
+	unsigned int i;
+
+	/* keep a few leading bits so that the routes overlap */
+	for (i = 0; i < RTE_IPV6_ADDR_SIZE; i++)
+		ip->a[i] = rte_rand();
+	ip->a[0] = 0x20;
+	ip->a[1] &= 0x03;
+}
+
+/*
+ * Add and delete random overlapping routes into the POPTRIE FIB and
+ * check every lookup implementation against the RIB based FIB.
+ */
+int32_t
+test_poptrie_random(void)
+{
+	struct rte_fib6 *fib, *ref;
+	struct rte_fib6_conf config = { 0 };
+	struct rte_ipv6_addr *routes, *ips;
+	uint64_t *nh, *nh_ref;
+	uint8_t *depths;
+	unsigned int i, j, round;
+	int ret;
+
+	routes = rte_malloc(NULL, sizeof(*routes) * POPTRIE_RND_ROUTES, 0);
+	depths = rte_malloc(NULL, POPTRIE_RND_ROUTES, 0);
+	ips = rte_malloc(NULL, sizeof(*ips) * POPTRIE_RND_LOOKUPS, 0);
+	nh = rte_malloc(NULL, sizeof(*nh) * POPTRIE_RND_LOOKUPS, 0);
+	nh_ref = rte_malloc(NULL, sizeof(*nh_ref) * POPTRIE_RND_LOOKUPS, 0);
+	RTE_TEST_ASSERT(routes != NULL && depths != NULL && ips != NULL &&
+		nh != NULL && nh_ref != NULL, "Failed to allocate memory\n");
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 100;
+	config.type = RTE_FIB6_DUMMY;
+	ref = rte_fib6_create("ref", SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(ref != NULL, "Failed to create FIB\n");
+
+	config.type = RTE_FIB6_POPTRIE;
+	config.poptrie.nh_sz = RTE_FIB6_TRIE_4B;
+	config.poptrie.num_nodes = POPTRIE_NODES;
+	config.poptrie.num_leaves = POPTRIE_LEAVES;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+	for (i = 0; i < POPTRIE_RND_ROUTES; i++) {
+		gen_random_ip(&routes[i]);
+		depths[i] = 8 + rte_rand_max(RTE_IPV6_MAX_DEPTH - 7);
+	}
+	for (i = 0; i < POPTRIE_RND_LOOKUPS; i++) {
+		/* half of the addresses hit the routes */
+		if (i & 1)
+			gen_random_ip(&ips[i]);
+		else
+			ips[i] = routes[rte_rand_max(POPTRIE_RND_ROUTES)];
+	}
+
+	/* add all the routes, then delete half of them, then add them back */
+	for (round = 0; round < 3; round++) {
+		for (i = 0; i < POPTRIE_RND_ROUTES; i++) {
+			if (round == 1 && (i & 1))
+				continue;
+			if (round == 1) {
+				ret = rte_fib6_delete(fib, &routes[i], depths[i]);
+				rte_fib6_delete(ref, &routes[i], depths[i]);
+			} else {
+				ret = rte_fib6_add(fib, &routes[i], depths[i],
+					i + round);
+				rte_fib6_add(ref, &routes[i], depths[i],
+					i + round);
+			}
+			/* duplicate random routes may be already deleted */
+			RTE_TEST_ASSERT(ret == 0 || ret == -ENOENT,
+				"Failed to modify a route\n");
+		}
+
+		ret = rte_fib6_lookup_bulk(ref, ips, nh_ref,
+			POPTRIE_RND_LOOKUPS);
+		RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+		for (j = 0; j < RTE_DIM(poptrie_lookups); j++) {
+			if (rte_fib6_select_lookup(fib, poptrie_lookups[j]) != 0)
+				continue;
+			ret = rte_fib6_lookup_bulk(fib, ips, nh,
+				POPTRIE_RND_LOOKUPS);
+			RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+			for (i = 0; i < POPTRIE_RND_LOOKUPS; i++)
+				RTE_TEST_ASSERT(nh[i] == nh_ref[i],
+					"Wrong nexthop for lookup %d, round %u\n",
+					poptrie_lookups[j], round);
+		}
+	}
+
+	rte_fib6_free(fib);
+	rte_fib6_free(ref);
+	rte_free(nh_ref);
+	rte_free(nh);
+	rte_free(ips);
+	rte_free(depths);
+	rte_free(routes);
+
+	return TEST_SUCCESS;
+}
+
+#define POPTRIE_CHURN_NODES	256
+#define POPTRIE_CHURN_ROUTES	16
+#define POPTRIE_CHURN_ROUNDS	1000
+
+/*
+ * Add and delete random routes into a POPTRIE FIB with few nodes and
+ * leaves. The nodes of the deleted routes must be released, so that
+ * the FIB never runs out of them.
+ */
+int32_t
+test_poptrie_churn(void)
+{
+	struct rte_fib6 *fib;
+	struct rte_fib6_conf config = { 0 };
+	struct rte_ipv6_addr routes[POPTRIE_CHURN_ROUTES];
+	uint8_t depths[POPTRIE_CHURN_ROUTES];
+	uint64_t nh;
+	unsigned int i, round;
+	int ret;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 100;
+	config.type = RTE_FIB6_POPTRIE;
+	config.poptrie.nh_sz = RTE_FIB6_TRIE_4B;
+	config.poptrie.num_nodes = POPTRIE_CHURN_NODES;
+	config.poptrie.num_leaves = POPTRIE_CHURN_NODES * 4;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+	for (round = 0; round < POPTRIE_CHURN_ROUNDS; round++) {
+		for (i = 0; i < POPTRIE_CHURN_ROUTES; i++) {
+			gen_random_ip(&routes[i]);
+			depths[i] = 24 + rte_rand_max(RTE_IPV6_MAX_DEPTH - 23);
+			rte_ipv6_addr_mask(&routes[i], depths[i]);
+			ret = rte_fib6_add(fib, &routes[i], depths[i], i);
+			RTE_TEST_ASSERT(ret == 0,
+				"Failed to add a route in round %u: %d\n",
+				round, ret);
+		}
+		for (i = 0; i < POPTRIE_CHURN_ROUTES; i++) {
+			ret = rte_fib6_delete(fib, &routes[i], depths[i]);
+			/* duplicate random routes may be already deleted */
+			RTE_TEST_ASSERT(ret == 0 || ret == -ENOENT,
+				"Failed to delete a route\n");
+		}
+		/* everything is back to the default next hop */
+		ret = rte_fib6_lookup_bulk(fib, routes, &nh, 1);
+		RTE_TEST_ASSERT(ret == 0 && nh == config.default_nh,
+			"Wrong nexthop after deleting the routes\n");
+	}
+
+	rte_fib6_free(fib);
+
 	return TEST_SUCCESS;
 }
 
@@ -611,6 +840,8 @@ static struct unit_test_suite fib6_fast_tests = {
 	TEST_CASE(test_lookup),
 	TEST_CASE(test_invalid_rcu),
 	TEST_CASE(test_fib_rcu_sync_rw),
+	TEST_CASE(test_poptrie_random),
+	TEST_CASE(test_poptrie_churn),
 	TEST_CASES_END()
 	}
 };
@@ -0,0 +1,291 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_ether.h>
+#include <rte_gro.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+
+#include "test.h"
+
+/* internal header, to build the flow keys hashed by the TCP/IPv4 table */
+#include "gro_tcp4.h"
+
+#define GRO_TEST_SEG_PAYLOAD 256
+#define GRO_TEST_SEGS 4
+#define GRO_TEST_BURST 32U
+#define GRO_TEST_MAX_FLOWS 1024
+#define GRO_TEST_NB_MBUFS (2 * GRO_TEST_MAX_FLOWS * GRO_TEST_SEGS)
+#define GRO_TEST_BUF_SIZE (RTE_PKTMBUF_HEADROOM + GRO_TEST_SEG_PAYLOAD + 128)
+#define GRO_TEST_HDR_LEN (sizeof(struct rte_ether_hdr) + \
+	sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_tcp_hdr))
+
+#define GRO_TEST_SRC_IP RTE_IPV4(198, 18, 0, 1)
+#define GRO_TEST_DST_IP RTE_IPV4(198, 18, 1, 1)
+#define GRO_TEST_DST_PORT 9
+
+/*
+ * Number of flows whose keys hash into the same pair of buckets, which
+ * is more than the pair holds.
+ */
+#define GRO_TEST_OVERFLOW_FLOWS 24
+
+/* Numbers of concurrent TCP/IPv4 flows swept with a GRO context */
+static const uint16_t gro_test_flows[] = { 1, 7, 64, 333, GRO_TEST_MAX_FLOWS };
+
+static struct rte_mempool *pkt_pool;
+static struct rte_mbuf *pkts[GRO_TEST_MAX_FLOWS * GRO_TEST_SEGS];
+static uint16_t flow_ports[GRO_TEST_MAX_FLOWS];
+
+/* Build one segment of the TCP/IPv4 flow of source port src_port. */
+static void
+gro_test_build_pkt(struct rte_mbuf *m, uint16_t src_port, uint16_t seg)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_tcp_hdr *tcp;
+
+	eth = rte_pktmbuf_mtod(m, struct rte_ether_hdr *);
+	memset(eth, 0, sizeof(*eth));
+	eth->dst_addr.addr_bytes[0] = 0x02;
+	eth->src_addr.addr_bytes[0] = 0x02;
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+
+	ip4 = (struct rte_ipv4_hdr *)(eth + 1);
+	memset(ip4, 0, sizeof(*ip4));
+	ip4->version_ihl = RTE_IPV4_VHL_DEF;
+	ip4->total_length = rte_cpu_to_be_16(sizeof(*ip4) + sizeof(*tcp) +
+			GRO_TEST_SEG_PAYLOAD);
+	ip4->fragment_offset = rte_cpu_to_be_16(RTE_IPV4_HDR_DF_FLAG);
+	ip4->time_to_live = 64;
+	ip4->next_proto_id = IPPROTO_TCP;
+	ip4->src_addr = rte_cpu_to_be_32(GRO_TEST_SRC_IP);
+	ip4->dst_addr = rte_cpu_to_be_32(GRO_TEST_DST_IP);
+
+	tcp = (struct rte_tcp_hdr *)(ip4 + 1);
+	memset(tcp, 0, sizeof(*tcp));
+	tcp->src_port = rte_cpu_to_be_16(src_port);
+	tcp->dst_port = rte_cpu_to_be_16(GRO_TEST_DST_PORT);
+	tcp->sent_seq = rte_cpu_to_be_32(1 + seg * GRO_TEST_SEG_PAYLOAD);
+	tcp->data_off = (sizeof(*tcp) / 4) << 4;
+	tcp->tcp_flags = RTE_TCP_ACK_FLAG;
+
+	m->l2_len = sizeof(*eth);
+	m->l3_len = sizeof(*ip4);
+	m->l4_len = sizeof(*tcp);
+	m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4 |
+		RTE_PTYPE_L4_TCP;
+	m->data_len = GRO_TEST_HDR_LEN + GRO_TEST_SEG_PAYLOAD;
+	m->pkt_len = m->data_len;
+}
+
+/* Hash of the flow key the TCP/IPv4 table builds for a flow. */
+static uint32_t
+gro_test_flow_hash(uint16_t src_port)
+{
+	struct tcp4_flow_key key;
+
+	memset(&key, 0, sizeof(key));
+	key.cmn_key.eth_saddr.addr_bytes[0] = 0x02;
+	key.cmn_key.eth_daddr.addr_bytes[0] = 0x02;
+	key.cmn_key.src_port = rte_cpu_to_be_16(src_port);
+	key.cmn_key.dst_port = rte_cpu_to_be_16(GRO_TEST_DST_PORT);
+	key.ip_src_addr = rte_cpu_to_be_32(GRO_TEST_SRC_IP);
+	key.ip_dst_addr = rte_cpu_to_be_32(GRO_TEST_DST_IP);
+
+	return gro_flow_hash(&key, sizeof(key));
+}
+
+/*
+ * Feed GRO_TEST_SEGS interleaved segments of nb_flows flows to a GRO
+ * context able to hold max_flow_num flows, in small bursts, then flush
+ * them and check that every flow is merged into one packet.
+ */
+static int
+gro_test_run_flows(uint16_t nb_flows, uint16_t max_flow_num)
+{
+	struct rte_gro_param param;
+	uint32_t i, nb_in, off, exp_len;
+	uint16_t n, nb_out, seen, port;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_tcp_hdr *tcp;
+	void *ctx;
+	int ret = -1;
+
+	memset(&param, 0, sizeof(param));
+	param.gro_types = RTE_GRO_TCP_IPV4;
+	param.max_flow_num = max_flow_num;
+	param.max_item_per_flow = GRO_TEST_SEGS;
+	param.socket_id = SOCKET_ID_ANY;
+	ctx = rte_gro_ctx_create(&param);
+	if (ctx == NULL) {
+		printf("Failed to create GRO context\n");
+		return -1;
+	}
+
+	nb_in = nb_flows * GRO_TEST_SEGS;
+	if (rte_pktmbuf_alloc_bulk(pkt_pool, pkts, nb_in) != 0) {
+		printf("Failed to allocate packets\n");
+		goto exit;
+	}
+	for (i = 0; i < nb_in; i++)
+		gro_test_build_pkt(pkts[i], flow_ports[i % nb_flows],
+				i / nb_flows);
+
+	for (off = 0; off < nb_in; off += n) {
+		n = RTE_MIN(nb_in - off, GRO_TEST_BURST);
+		if (rte_gro_reassemble(&pkts[off], n, ctx) != 0) {
+			printf("%u flows: packets not stored in context\n",
+				nb_flows);
+			rte_pktmbuf_free_bulk(&pkts[off], nb_in - off);
+			rte_gro_timeout_flush(ctx, 0, RTE_GRO_TCP_IPV4,
+					pkts, off);
+			rte_pktmbuf_free_bulk(pkts, off);
+			goto exit;
+		}
+	}
+
+	if (rte_gro_get_pkt_count(ctx) != nb_flows) {
+		printf("%u flows: %"PRIu64" packets in context\n", nb_flows,
+			rte_gro_get_pkt_count(ctx));
+		nb_out = rte_gro_timeout_flush(ctx, 0, RTE_GRO_TCP_IPV4,
+				pkts, nb_in);
+		rte_pktmbuf_free_bulk(pkts, nb_out);
+		goto exit;
+	}
+
+	nb_out = rte_gro_timeout_flush(ctx, 0, RTE_GRO_TCP_IPV4, pkts, nb_in);
+	if (nb_out != nb_flows) {
+		printf("%u flows: %u packets flushed\n", nb_flows, nb_out);
+		rte_pktmbuf_free_bulk(pkts, nb_out);
+		goto exit;
+	}
+
+	exp_len = GRO_TEST_HDR_LEN + GRO_TEST_SEGS * GRO_TEST_SEG_PAYLOAD;
+	for (i = 0; i < nb_out; i++) {
+		ip4 = rte_pktmbuf_mtod_offset(pkts[i], struct rte_ipv4_hdr *,
+				sizeof(struct rte_ether_hdr));
+		tcp = (struct rte_tcp_hdr *)(ip4 + 1);
+		if (pkts[i]->pkt_len != exp_len ||
+		    rte_be_to_cpu_16(ip4->total_length) !=
+				exp_len - sizeof(struct rte_ether_hdr) ||
+		    rte_be_to_cpu_32(tcp->sent_seq) != 1) {
+			printf("%u flows: packet %u not fully merged\n",
+				nb_flows, i);
+			break;
+		}
+
+		/* each flow must come out once */
+		port = rte_be_to_cpu_16(tcp->src_port);
+		for (seen = 0; seen < nb_flows; seen++)
+			if (flow_ports[seen] == port)
+				break;
+		if (seen == nb_flows) {
+			printf("%u flows: unknown flow %u\n", nb_flows, port);
+			break;
+		}
+		flow_ports[seen] = 0;
+	}
+	rte_pktmbuf_free_bulk(pkts, nb_out);
+	if (i == nb_out)
+		ret = 0;
+
+exit:
+	rte_gro_ctx_destroy(ctx);
+	return ret;
+}
+
+/* Check the TCP/IPv4 reassembly with numbers of flows up to the table size */
+static int
+test_gro_flow_sweep(void)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < RTE_DIM(gro_test_flows); i++) {
+		for (j = 0; j < gro_test_flows[i]; j++)
+			flow_ports[j] = 1024 + j;
+		if (gro_test_run_flows(gro_test_flows[i],
+				gro_test_flows[i]) != 0)
+			return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Check the TCP/IPv4 reassembly of more flows than their two buckets of
+ * the flow index can hold. The flows which don't fit into their buckets
+ * must be found by scanning the flow array.
+ */
+static int
+test_gro_flow_overflow(void)
+{
+	/* the table holds max_flow_num * GRO_TEST_SEGS flows */
+	const uint16_t max_flow_num = 16;
+	uint32_t bkt_mask, port, round;
+	unsigned int n = 0;
+
+	bkt_mask = rte_align32pow2(max_flow_num * GRO_TEST_SEGS) / 2 - 1;
+
+	/* the second round checks that flushing emptied the index */
+	for (round = 0; round < 2; round++) {
+		/* look for flows whose primary bucket is 0 or 1 */
+		for (n = 0, port = 1024; port <= UINT16_MAX &&
+				n < GRO_TEST_OVERFLOW_FLOWS; port++)
+			if ((gro_test_flow_hash(port) & bkt_mask & ~1U) == 0)
+				flow_ports[n++] = port;
+		TEST_ASSERT_EQUAL(n, GRO_TEST_OVERFLOW_FLOWS,
+			"Only %u colliding flows found", n);
+
+		if (gro_test_run_flows(GRO_TEST_OVERFLOW_FLOWS,
+				max_flow_num) != 0)
+			return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_gro_setup(void)
+{
+	pkt_pool = rte_pktmbuf_pool_create("gro_test_pkt", GRO_TEST_NB_MBUFS,
+			0, 0, GRO_TEST_BUF_SIZE, SOCKET_ID_ANY);
+	if (pkt_pool == NULL) {
+		printf("Failed to create mbuf pool\n");
+		return TEST_FAILED;
+	}
+	return TEST_SUCCESS;
+}
+
+static void
+test_gro_teardown(void)
+{
+	rte_mempool_free(pkt_pool);
+	pkt_pool = NULL;
+}
+
+static struct unit_test_suite gro_test_suite = {
+	.suite_name = "GRO flow index tests",
+	.setup = test_gro_setup,
+	.teardown = test_gro_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_gro_flow_sweep),
+		TEST_CASE(test_gro_flow_overflow),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_gro(void)
+{
+	return unit_test_suite_runner(&gro_test_suite);
+}
+
+REGISTER_FAST_TEST(gro_autotest, NOHUGE_OK, ASAN_OK, test_gro);
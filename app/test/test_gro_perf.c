@@ -0,0 +1,534 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ether.h>
+#include <rte_geneve.h>
+#include <rte_gro.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+#include <rte_vxlan.h>
+
+#include "test.h"
+
+#define GRO_PERF_ITERATIONS 10000
+#define GRO_PERF_SEG_PAYLOAD 1400 /* multiple of 8 for IP fragments */
+#define GRO_PERF_NB_MBUFS 8192
+#define GRO_PERF_BUF_SIZE (RTE_PKTMBUF_HEADROOM + GRO_PERF_SEG_PAYLOAD + 256)
+
+/* Kinds of packets which are fed to GRO */
+enum gro_perf_kind {
+	KIND_TCP4,
+	KIND_TCP6,
+	KIND_UDP4,
+	KIND_UDP6,
+	KIND_VXLAN4_TCP4,
+	KIND_VXLAN6_TCP4,
+	KIND_GENEVE6_TCP4,
+	KIND_NUM
+};
+
+static const char * const gro_perf_kind_names[KIND_NUM] = {
+	"TCP/IPv4",
+	"TCP/IPv6",
+	"UDP/IPv4 frag",
+	"UDP/IPv6 frag",
+	"VXLAN IPv4 TCP/IPv4",
+	"VXLAN IPv6 TCP/IPv4",
+	"GENEVE IPv6 TCP/IPv4",
+};
+
+static const uint64_t gro_perf_kind_types[KIND_NUM] = {
+	RTE_GRO_TCP_IPV4,
+	RTE_GRO_TCP_IPV6,
+	RTE_GRO_UDP_IPV4,
+	RTE_GRO_UDP_IPV6,
+	RTE_GRO_IPV4_VXLAN_TCP_IPV4,
+	RTE_GRO_IPV6_VXLAN_TCP_IPV4,
+	RTE_GRO_IPV6_GENEVE_TCP_IPV4,
+};
+
+struct gro_perf_case {
+	const char *name;
+	uint32_t kinds; /* bitmask of enum gro_perf_kind */
+	uint16_t nb_flows; /* per kind */
+	uint16_t nb_segs; /* per flow */
+};
+
+#define KIND(k) (1U << (k))
+
+static const struct gro_perf_case gro_perf_cases[] = {
+	{ NULL, KIND(KIND_TCP4), 4, 16 },
+	{ NULL, KIND(KIND_TCP6), 4, 16 },
+	{ NULL, KIND(KIND_UDP4), 4, 16 },
+	{ NULL, KIND(KIND_UDP6), 4, 16 },
+	{ NULL, KIND(KIND_VXLAN4_TCP4), 4, 16 },
+	{ NULL, KIND(KIND_VXLAN6_TCP4), 4, 16 },
+	{ NULL, KIND(KIND_GENEVE6_TCP4), 4, 16 },
+	{ "Mixed IPv4/IPv6", RTE_LEN2MASK(KIND_NUM, uint32_t), 4, 4 },
+};
+
+/*
+ * Numbers of concurrent TCP/IPv4 flows swept with the burst API, which
+ * share the burst so that no flow exceeds the merge limits.
+ */
+static const uint16_t gro_perf_burst_flows[] = { 8, 16, 32, 64, 128 };
+
+/* Numbers of concurrent TCP/IPv4 flows swept with a GRO context */
+#define GRO_PERF_CTX_ITERATIONS 100
+#define GRO_PERF_CTX_SEGS 4
+#define GRO_PERF_CTX_BURST 32U
+static const uint16_t gro_perf_ctx_flows[] = { 16, 64, 256, 1024 };
+
+static struct rte_mempool *pkt_pool;
+static struct rte_mbuf *ctx_pkts[1024 * GRO_PERF_CTX_SEGS];
+
+static uint16_t
+fill_eth_hdr(uint8_t *p, uint8_t ipv6, uint16_t flow)
+{
+	struct rte_ether_hdr *eth = (struct rte_ether_hdr *)p;
+
+	memset(eth, 0, sizeof(*eth));
+	eth->dst_addr.addr_bytes[0] = 0x02;
+	eth->src_addr.addr_bytes[0] = 0x02;
+	eth->src_addr.addr_bytes[5] = (uint8_t)flow;
+	eth->ether_type = rte_cpu_to_be_16(ipv6 ? RTE_ETHER_TYPE_IPV6 :
+			RTE_ETHER_TYPE_IPV4);
+	return sizeof(*eth);
+}
+
+static uint16_t
+fill_ipv4_hdr(uint8_t *p, uint8_t proto, uint16_t flow, uint16_t len,
+		uint16_t frag_off)
+{
+	struct rte_ipv4_hdr *ip4 = (struct rte_ipv4_hdr *)p;
+
+	memset(ip4, 0, sizeof(*ip4));
+	ip4->version_ihl = RTE_IPV4_VHL_DEF;
+	ip4->total_length = rte_cpu_to_be_16(len + sizeof(*ip4));
+	ip4->packet_id = rte_cpu_to_be_16(flow);
+	ip4->fragment_offset = rte_cpu_to_be_16(frag_off);
+	ip4->time_to_live = 64;
+	ip4->next_proto_id = proto;
+	ip4->src_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 1));
+	ip4->dst_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 1, flow));
+	return sizeof(*ip4);
+}
+
+static uint16_t
+fill_ipv6_hdr(uint8_t *p, uint8_t proto, uint16_t flow, uint16_t len)
+{
+	struct rte_ipv6_hdr *ip6 = (struct rte_ipv6_hdr *)p;
+
+	memset(ip6, 0, sizeof(*ip6));
+	ip6->vtc_flow = rte_cpu_to_be_32(6 << 28);
+	ip6->payload_len = rte_cpu_to_be_16(len);
+	ip6->proto = proto;
+	ip6->hop_limits = 64;
+	ip6->src_addr = (struct rte_ipv6_addr)
+		RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 1);
+	ip6->dst_addr = (struct rte_ipv6_addr)
+		RTE_IPV6(0x2001, 0x0200, 0, 1, 0, 0, 0, flow);
+	return sizeof(*ip6);
+}
+
+static uint16_t
+fill_tcp_hdr(uint8_t *p, uint16_t seg)
+{
+	struct rte_tcp_hdr *tcp = (struct rte_tcp_hdr *)p;
+
+	memset(tcp, 0, sizeof(*tcp));
+	tcp->src_port = rte_cpu_to_be_16(9);
+	tcp->dst_port = rte_cpu_to_be_16(9);
+	tcp->sent_seq = rte_cpu_to_be_32(1 + seg * GRO_PERF_SEG_PAYLOAD);
+	tcp->data_off = (sizeof(*tcp) / 4) << 4;
+	tcp->tcp_flags = RTE_TCP_ACK_FLAG;
+	return sizeof(*tcp);
+}
+
+/*
+ * Build one segment of a flow. UDP packets are IP fragments of a single
+ * datagram, whose UDP header is carried by the first fragment.
+ */
+static void
+gro_perf_build_pkt(struct rte_mbuf *m, enum gro_perf_kind kind,
+		uint16_t flow, uint16_t seg, uint16_t nb_segs)
+{
+	uint8_t *p = rte_pktmbuf_mtod(m, uint8_t *);
+	uint16_t mf, off = 0, tnl_len;
+	uint8_t outer_ipv6;
+
+	mf = seg + 1 < nb_segs;
+	m->outer_l2_len = 0;
+	m->outer_l3_len = 0;
+
+	switch (kind) {
+	case KIND_TCP4:
+	case KIND_TCP6:
+		m->l2_len = fill_eth_hdr(p, kind == KIND_TCP6, flow);
+		off = m->l2_len;
+		if (kind == KIND_TCP4) {
+			m->l3_len = fill_ipv4_hdr(p + off, IPPROTO_TCP, flow,
+					sizeof(struct rte_tcp_hdr) +
+					GRO_PERF_SEG_PAYLOAD,
+					RTE_IPV4_HDR_DF_FLAG);
+			m->packet_type = RTE_PTYPE_L3_IPV4;
+		} else {
+			m->l3_len = fill_ipv6_hdr(p + off, IPPROTO_TCP, flow,
+					sizeof(struct rte_tcp_hdr) +
+					GRO_PERF_SEG_PAYLOAD);
+			m->packet_type = RTE_PTYPE_L3_IPV6;
+		}
+		off += m->l3_len;
+		m->l4_len = fill_tcp_hdr(p + off, seg);
+		off += m->l4_len;
+		m->packet_type |= RTE_PTYPE_L2_ETHER | RTE_PTYPE_L4_TCP;
+		break;
+	case KIND_UDP4:
+		m->l2_len = fill_eth_hdr(p, 0, flow);
+		off = m->l2_len;
+		m->l3_len = fill_ipv4_hdr(p + off, IPPROTO_UDP, flow,
+				GRO_PERF_SEG_PAYLOAD,
+				(seg * GRO_PERF_SEG_PAYLOAD) >> 3 |
+				(mf ? RTE_IPV4_HDR_MF_FLAG : 0));
+		off += m->l3_len;
+		m->l4_len = 0;
+		m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4 |
+			RTE_PTYPE_L4_FRAG;
+		break;
+	case KIND_UDP6: {
+		struct rte_ipv6_fragment_ext *frag;
+
+		m->l2_len = fill_eth_hdr(p, 1, flow);
+		off = m->l2_len;
+		off += fill_ipv6_hdr(p + off, IPPROTO_FRAGMENT, flow,
+				sizeof(*frag) + GRO_PERF_SEG_PAYLOAD);
+		frag = (struct rte_ipv6_fragment_ext *)(p + off);
+		frag->next_header = IPPROTO_UDP;
+		frag->reserved = 0;
+		frag->frag_data = rte_cpu_to_be_16(RTE_IPV6_SET_FRAG_DATA(
+				seg * GRO_PERF_SEG_PAYLOAD, mf));
+		frag->id = rte_cpu_to_be_32(flow);
+		off += sizeof(*frag);
+		m->l3_len = off - m->l2_len;
+		m->l4_len = 0;
+		m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV6_EXT |
+			RTE_PTYPE_L4_FRAG;
+		break;
+	}
+	default: {
+		struct rte_udp_hdr *udp;
+		uint16_t inner_len;
+
+		outer_ipv6 = kind != KIND_VXLAN4_TCP4;
+		tnl_len = sizeof(struct rte_udp_hdr) +
+			sizeof(struct rte_vxlan_hdr) +
+			sizeof(struct rte_ether_hdr);
+		inner_len = sizeof(struct rte_ipv4_hdr) +
+			sizeof(struct rte_tcp_hdr) + GRO_PERF_SEG_PAYLOAD;
+
+		m->outer_l2_len = fill_eth_hdr(p, outer_ipv6, 0);
+		off = m->outer_l2_len;
+		if (outer_ipv6)
+			m->outer_l3_len = fill_ipv6_hdr(p + off, IPPROTO_UDP,
+					0, tnl_len + inner_len);
+		else
+			m->outer_l3_len = fill_ipv4_hdr(p + off, IPPROTO_UDP,
+					0, tnl_len + inner_len,
+					RTE_IPV4_HDR_DF_FLAG);
+		off += m->outer_l3_len;
+
+		udp = (struct rte_udp_hdr *)(p + off);
+		memset(udp, 0, sizeof(*udp));
+		udp->src_port = rte_cpu_to_be_16(49152 + flow);
+		udp->dgram_len = rte_cpu_to_be_16(tnl_len + inner_len);
+		if (kind == KIND_GENEVE6_TCP4) {
+			struct rte_geneve_hdr *geneve =
+				(struct rte_geneve_hdr *)(udp + 1);
+
+			udp->dst_port = rte_cpu_to_be_16(RTE_GENEVE_DEFAULT_PORT);
+			memset(geneve, 0, sizeof(*geneve));
+			geneve->proto = rte_cpu_to_be_16(RTE_GENEVE_TYPE_ETH);
+			geneve->vni[2] = (uint8_t)flow;
+			m->packet_type = RTE_PTYPE_TUNNEL_GENEVE;
+		} else {
+			struct rte_vxlan_hdr *vxlan =
+				(struct rte_vxlan_hdr *)(udp + 1);
+
+			udp->dst_port = rte_cpu_to_be_16(RTE_VXLAN_DEFAULT_PORT);
+			memset(vxlan, 0, sizeof(*vxlan));
+			vxlan->vx_flags = rte_cpu_to_be_32(0x08000000);
+			vxlan->vx_vni = rte_cpu_to_be_32(flow << 8);
+			m->packet_type = RTE_PTYPE_TUNNEL_VXLAN;
+		}
+		fill_eth_hdr(p + off + tnl_len - sizeof(struct rte_ether_hdr),
+				0, flow);
+		m->l2_len = tnl_len;
+		off += m->l2_len;
+
+		m->l3_len = fill_ipv4_hdr(p + off, IPPROTO_TCP, flow,
+				sizeof(struct rte_tcp_hdr) +
+				GRO_PERF_SEG_PAYLOAD, RTE_IPV4_HDR_DF_FLAG);
+		off += m->l3_len;
+		m->l4_len = fill_tcp_hdr(p + off, seg);
+		off += m->l4_len;
+		m->packet_type |= RTE_PTYPE_L2_ETHER | RTE_PTYPE_L4_UDP |
+			(outer_ipv6 ? RTE_PTYPE_L3_IPV6 : RTE_PTYPE_L3_IPV4) |
+			RTE_PTYPE_INNER_L2_ETHER | RTE_PTYPE_INNER_L3_IPV4 |
+			RTE_PTYPE_INNER_L4_TCP;
+		break;
+	}
+	}
+
+	m->data_len = off + GRO_PERF_SEG_PAYLOAD;
+	m->pkt_len = m->data_len;
+}
+
+/* Interleave the segments of all flows, as they arrive on the wire. */
+static uint16_t
+gro_perf_build_burst(const struct gro_perf_case *tc, struct rte_mbuf **pkts)
+{
+	uint16_t flow, seg, n = 0;
+	unsigned int kind;
+
+	for (seg = 0; seg < tc->nb_segs; seg++)
+		for (kind = 0; kind < KIND_NUM; kind++) {
+			if ((tc->kinds & KIND(kind)) == 0)
+				continue;
+			for (flow = 0; flow < tc->nb_flows; flow++)
+				gro_perf_build_pkt(pkts[n++], kind, flow + 1,
+						seg, tc->nb_segs);
+		}
+
+	return n;
+}
+
+/* Check that the merged packets carry the whole flows. */
+static int
+gro_perf_check_pkts(const struct gro_perf_case *tc, struct rte_mbuf **pkts,
+		uint16_t nb_pkts)
+{
+	uint32_t exp_len;
+	uint16_t i, l2_len, len;
+	uint8_t *l3;
+
+	if (nb_pkts != rte_popcount32(tc->kinds) * tc->nb_flows) {
+		printf("%s: %u packets after GRO, expected %u\n", tc->name,
+			nb_pkts, rte_popcount32(tc->kinds) * tc->nb_flows);
+		return -1;
+	}
+
+	for (i = 0; i < nb_pkts; i++) {
+		exp_len = pkts[i]->outer_l2_len + pkts[i]->outer_l3_len +
+			pkts[i]->l2_len + pkts[i]->l3_len + pkts[i]->l4_len +
+			tc->nb_segs * GRO_PERF_SEG_PAYLOAD;
+		if (pkts[i]->pkt_len != exp_len) {
+			printf("%s: packet %u length %u, expected %u\n",
+				tc->name, i, pkts[i]->pkt_len, exp_len);
+			return -1;
+		}
+
+		/* The outermost IP header must cover the merged payload. */
+		l2_len = pkts[i]->outer_l2_len ? pkts[i]->outer_l2_len :
+			pkts[i]->l2_len;
+		l3 = rte_pktmbuf_mtod_offset(pkts[i], uint8_t *, l2_len);
+		if ((l3[0] >> 4) == 4)
+			len = rte_be_to_cpu_16(((struct rte_ipv4_hdr *)l3)->total_length);
+		else
+			len = rte_be_to_cpu_16(((struct rte_ipv6_hdr *)l3)->payload_len) +
+				sizeof(struct rte_ipv6_hdr);
+		if (len != pkts[i]->pkt_len - l2_len) {
+			printf("%s: packet %u IP length %u, expected %u\n",
+				tc->name, i, len, pkts[i]->pkt_len - l2_len);
+			return -1;
+		}
+	}
+	return 0;
+}
+
+static int
+gro_perf_run_case(const struct gro_perf_case *tc)
+{
+	struct rte_mbuf *pkts[RTE_GRO_MAX_BURST_ITEM_NUM];
+	struct rte_gro_param param;
+	uint64_t tsc, cycles = 0, hz;
+	uint16_t nb_in, nb_out = 0;
+	unsigned int kind;
+	uint32_t i;
+
+	memset(&param, 0, sizeof(param));
+	for (kind = 0; kind < KIND_NUM; kind++)
+		if (tc->kinds & KIND(kind))
+			param.gro_types |= gro_perf_kind_types[kind];
+	param.max_flow_num = RTE_GRO_MAX_BURST_ITEM_NUM;
+	param.max_item_per_flow = RTE_GRO_MAX_BURST_ITEM_NUM;
+
+	nb_in = rte_popcount32(tc->kinds) * tc->nb_flows * tc->nb_segs;
+	RTE_VERIFY(nb_in <= RTE_DIM(pkts));
+
+	for (i = 0; i < GRO_PERF_ITERATIONS; i++) {
+		if (rte_pktmbuf_alloc_bulk(pkt_pool, pkts, nb_in) != 0) {
+			printf("%s: failed to allocate packets\n", tc->name);
+			return -1;
+		}
+		gro_perf_build_burst(tc, pkts);
+
+		tsc = rte_rdtsc_precise();
+		nb_out = rte_gro_reassemble_burst(pkts, nb_in, &param);
+		cycles += rte_rdtsc_precise() - tsc;
+
+		if (i == 0 && gro_perf_check_pkts(tc, pkts, nb_out) != 0) {
+			rte_pktmbuf_free_bulk(pkts, nb_out);
+			return -1;
+		}
+		rte_pktmbuf_free_bulk(pkts, nb_out);
+	}
+
+	/* Rates at which packets enter GRO and leave it for the stack */
+	hz = rte_get_tsc_hz();
+	printf("%-22s %8u %8u %12.1f %10.2f %10.2f\n", tc->name, nb_in, nb_out,
+		(double)cycles / ((uint64_t)nb_in * GRO_PERF_ITERATIONS),
+		(double)nb_in * GRO_PERF_ITERATIONS * hz / cycles / 1e6,
+		(double)nb_out * GRO_PERF_ITERATIONS * hz / cycles / 1e6);
+
+	return 0;
+}
+
+/*
+ * Feed all the segments of nb_flows flows to a GRO context in small
+ * bursts, then flush them, to check that the reassembly cost per packet
+ * doesn't depend on the number of flows in the table.
+ */
+static int
+gro_perf_run_ctx(uint16_t nb_flows)
+{
+	struct gro_perf_case tc = {
+		"TCP/IPv4", KIND(KIND_TCP4), nb_flows, GRO_PERF_CTX_SEGS
+	};
+	struct rte_gro_param param;
+	uint64_t tsc, cycles = 0;
+	uint32_t i, off, nb_in;
+	uint16_t n, nb_out = 0;
+	void *ctx;
+	int ret = 0;
+
+	memset(&param, 0, sizeof(param));
+	param.gro_types = RTE_GRO_TCP_IPV4;
+	param.max_flow_num = nb_flows;
+	param.max_item_per_flow = GRO_PERF_CTX_SEGS;
+	param.socket_id = SOCKET_ID_ANY;
+	ctx = rte_gro_ctx_create(&param);
+	if (ctx == NULL) {
+		printf("Failed to create GRO context\n");
+		return -1;
+	}
+
+	nb_in = nb_flows * GRO_PERF_CTX_SEGS;
+	RTE_VERIFY(nb_in <= RTE_DIM(ctx_pkts));
+
+	for (i = 0; i < GRO_PERF_CTX_ITERATIONS; i++) {
+		if (rte_pktmbuf_alloc_bulk(pkt_pool, ctx_pkts, nb_in) != 0) {
+			printf("Failed to allocate packets\n");
+			ret = -1;
+			break;
+		}
+		gro_perf_build_burst(&tc, ctx_pkts);
+
+		tsc = rte_rdtsc_precise();
+		for (off = 0; off < nb_in; off += n) {
+			n = RTE_MIN(nb_in - off, GRO_PERF_CTX_BURST);
+			if (rte_gro_reassemble(&ctx_pkts[off], n, ctx) != 0) {
+				printf("%u flows: packets not stored in context\n",
+					nb_flows);
+				ret = -1;
+			}
+		}
+		nb_out = rte_gro_timeout_flush(ctx, 0, RTE_GRO_TCP_IPV4,
+				ctx_pkts, nb_in);
+		cycles += rte_rdtsc_precise() - tsc;
+
+		if (ret == 0 && i == 0)
+			ret = gro_perf_check_pkts(&tc, ctx_pkts, nb_out);
+		rte_pktmbuf_free_bulk(ctx_pkts, nb_out);
+		if (ret != 0)
+			break;
+	}
+
+	if (ret == 0)
+		printf("%-8u %8u %8u %12.1f\n", nb_flows, nb_in, nb_out,
+			(double)cycles / ((uint64_t)nb_in * GRO_PERF_CTX_ITERATIONS));
+
+	rte_gro_ctx_destroy(ctx);
+	return ret;
+}
+
+static int
+test_gro_perf(void)
+{
+	struct gro_perf_case tc;
+	char name[16];
+	unsigned int i;
+	int ret = TEST_SUCCESS;
+
+	pkt_pool = rte_pktmbuf_pool_create("gro_perf_pkt", GRO_PERF_NB_MBUFS,
+			0, 0, GRO_PERF_BUF_SIZE, SOCKET_ID_ANY);
+	if (pkt_pool == NULL) {
+		printf("Failed to create mbuf pool\n");
+		return TEST_FAILED;
+	}
+
+	printf("### rte_gro_reassemble_burst() performance, %u byte segments ###\n",
+		GRO_PERF_SEG_PAYLOAD);
+	printf("%-22s %8s %8s %12s %10s %10s\n", "Packet type", "Pkts in",
+		"Pkts out", "Cycles/pkt", "Mpps in", "Mpps out");
+
+	for (i = 0; i < RTE_DIM(gro_perf_cases); i++) {
+		tc = gro_perf_cases[i];
+		if (tc.name == NULL)
+			tc.name = gro_perf_kind_names[rte_ctz32(tc.kinds)];
+		if (gro_perf_run_case(&tc) != 0) {
+			ret = TEST_FAILED;
+			goto exit;
+		}
+	}
+
+	printf("\n### rte_gro_reassemble_burst() TCP/IPv4 flow sweep, %u packets ###\n",
+		RTE_GRO_MAX_BURST_ITEM_NUM);
+	printf("%-22s %8s %8s %12s %10s %10s\n", "Flows", "Pkts in",
+		"Pkts out", "Cycles/pkt", "Mpps in", "Mpps out");
+	for (i = 0; i < RTE_DIM(gro_perf_burst_flows); i++) {
+		tc.kinds = KIND(KIND_TCP4);
+		tc.nb_flows = gro_perf_burst_flows[i];
+		tc.nb_segs = RTE_GRO_MAX_BURST_ITEM_NUM / tc.nb_flows;
+		snprintf(name, sizeof(name), "%u", tc.nb_flows);
+		tc.name = name;
+		if (gro_perf_run_case(&tc) != 0) {
+			ret = TEST_FAILED;
+			goto exit;
+		}
+	}
+
+	printf("\n### rte_gro_reassemble() TCP/IPv4 flow sweep, %u segments per flow ###\n",
+		GRO_PERF_CTX_SEGS);
+	printf("%-8s %8s %8s %12s\n", "Flows", "Pkts in", "Pkts out",
+		"Cycles/pkt");
+	for (i = 0; i < RTE_DIM(gro_perf_ctx_flows); i++) {
+		if (gro_perf_run_ctx(gro_perf_ctx_flows[i]) != 0) {
+			ret = TEST_FAILED;
+			goto exit;
+		}
+	}
+
+exit:
+	rte_mempool_free(pkt_pool);
+	return ret;
+}
+
+REGISTER_PERF_TEST(gro_perf_autotest, test_gro_perf);
@@ -0,0 +1,507 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ether.h>
+#include <rte_ethdev.h>
+#include <rte_gre.h>
+#include <rte_gso.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+#include <rte_vxlan.h>
+
+#include "test.h"
+
+#define GSO_PERF_ITERATIONS 20000
+#define GSO_PERF_PAYLOAD_LEN 16000
+#define GSO_PERF_SEG_SIZE 1500
+#define GSO_PERF_MAX_SEGS 64
+#define GSO_PERF_NB_MBUFS 4096
+#define GSO_PERF_BUF_SIZE (RTE_PKTMBUF_HEADROOM + GSO_PERF_PAYLOAD_LEN + 256)
+
+#define TNL_NONE 0
+#define TNL_VXLAN 1
+#define TNL_GRE 2
+
+struct gso_perf_case {
+	const char *name;
+	uint8_t outer_ipv6; /* only meaningful for tunnel packets */
+	uint8_t tunnel;
+	uint8_t ipv6;
+	uint8_t l4_proto;
+};
+
+static const struct gso_perf_case gso_perf_cases[] = {
+	{ "TCP/IPv4", 0, TNL_NONE, 0, IPPROTO_TCP },
+	{ "TCP/IPv6", 0, TNL_NONE, 1, IPPROTO_TCP },
+	{ "UDP/IPv4", 0, TNL_NONE, 0, IPPROTO_UDP },
+	{ "UDP/IPv6", 0, TNL_NONE, 1, IPPROTO_UDP },
+	{ "VXLAN IPv4 TCP/IPv4", 0, TNL_VXLAN, 0, IPPROTO_TCP },
+	{ "VXLAN IPv6 TCP/IPv4", 1, TNL_VXLAN, 0, IPPROTO_TCP },
+	{ "VXLAN IPv4 TCP/IPv6", 0, TNL_VXLAN, 1, IPPROTO_TCP },
+	{ "VXLAN IPv6 TCP/IPv6", 1, TNL_VXLAN, 1, IPPROTO_TCP },
+	{ "VXLAN IPv4 UDP/IPv4", 0, TNL_VXLAN, 0, IPPROTO_UDP },
+	{ "VXLAN IPv6 UDP/IPv4", 1, TNL_VXLAN, 0, IPPROTO_UDP },
+	{ "GRE IPv4 TCP/IPv4", 0, TNL_GRE, 0, IPPROTO_TCP },
+	{ "GRE IPv6 TCP/IPv4", 1, TNL_GRE, 0, IPPROTO_TCP },
+	{ "GRE IPv6 TCP/IPv6", 1, TNL_GRE, 1, IPPROTO_TCP },
+};
+
+static struct rte_mempool *pkt_pool;
+static struct rte_mempool *direct_pool;
+static struct rte_mempool *indirect_pool;
+
+static uint16_t
+fill_l3_hdr(uint8_t *p, uint8_t ipv6, uint8_t proto, uint16_t l3_payload_len)
+{
+	if (ipv6) {
+		struct rte_ipv6_hdr *ip6 = (struct rte_ipv6_hdr *)p;
+
+		memset(ip6, 0, sizeof(*ip6));
+		ip6->vtc_flow = rte_cpu_to_be_32(6 << 28);
+		ip6->payload_len = rte_cpu_to_be_16(l3_payload_len);
+		ip6->proto = proto;
+		ip6->hop_limits = 64;
+		ip6->src_addr = (struct rte_ipv6_addr)
+			RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 1);
+		ip6->dst_addr = (struct rte_ipv6_addr)
+			RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 2);
+		return sizeof(*ip6);
+	} else {
+		struct rte_ipv4_hdr *ip4 = (struct rte_ipv4_hdr *)p;
+
+		memset(ip4, 0, sizeof(*ip4));
+		ip4->version_ihl = RTE_IPV4_VHL_DEF;
+		ip4->total_length = rte_cpu_to_be_16(l3_payload_len +
+				sizeof(*ip4));
+		ip4->packet_id = rte_cpu_to_be_16(1);
+		ip4->time_to_live = 64;
+		ip4->next_proto_id = proto;
+		ip4->src_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 1));
+		ip4->dst_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 2));
+		return sizeof(*ip4);
+	}
+}
+
+static uint16_t
+fill_eth_hdr(uint8_t *p, uint8_t ipv6)
+{
+	struct rte_ether_hdr *eth = (struct rte_ether_hdr *)p;
+
+	memset(eth, 0, sizeof(*eth));
+	eth->dst_addr.addr_bytes[0] = 0x02;
+	eth->src_addr.addr_bytes[0] = 0x02;
+	eth->src_addr.addr_bytes[5] = 0x01;
+	eth->ether_type = rte_cpu_to_be_16(ipv6 ? RTE_ETHER_TYPE_IPV6 :
+			RTE_ETHER_TYPE_IPV4);
+	return sizeof(*eth);
+}
+
+/* Build the packet to segment, returns its header length. */
+static uint16_t
+gso_perf_build_pkt(struct rte_mbuf *m, const struct gso_perf_case *tc)
+{
+	uint8_t *p = rte_pktmbuf_mtod(m, uint8_t *);
+	uint16_t l3_len, l4_len, hdr_len, inner_len, off = 0;
+
+	l3_len = tc->ipv6 ? sizeof(struct rte_ipv6_hdr) :
+		sizeof(struct rte_ipv4_hdr);
+	l4_len = tc->l4_proto == IPPROTO_TCP ? sizeof(struct rte_tcp_hdr) :
+		sizeof(struct rte_udp_hdr);
+	inner_len = l3_len + l4_len + GSO_PERF_PAYLOAD_LEN;
+
+	m->ol_flags = tc->ipv6 ? RTE_MBUF_F_TX_IPV6 : RTE_MBUF_F_TX_IPV4;
+	m->ol_flags |= tc->l4_proto == IPPROTO_TCP ? RTE_MBUF_F_TX_TCP_SEG :
+		RTE_MBUF_F_TX_UDP_SEG;
+
+	if (tc->tunnel != TNL_NONE) {
+		uint16_t tnl_len, outer_l3_len;
+
+		m->outer_l2_len = fill_eth_hdr(p, tc->outer_ipv6);
+		off = m->outer_l2_len;
+		if (tc->tunnel == TNL_VXLAN) {
+			tnl_len = sizeof(struct rte_udp_hdr) +
+				sizeof(struct rte_vxlan_hdr) +
+				sizeof(struct rte_ether_hdr);
+			outer_l3_len = fill_l3_hdr(p + off, tc->outer_ipv6,
+					IPPROTO_UDP, tnl_len + inner_len);
+			m->ol_flags |= RTE_MBUF_F_TX_TUNNEL_VXLAN;
+		} else {
+			tnl_len = sizeof(struct rte_gre_hdr);
+			outer_l3_len = fill_l3_hdr(p + off, tc->outer_ipv6,
+					IPPROTO_GRE, tnl_len + inner_len);
+			m->ol_flags |= RTE_MBUF_F_TX_TUNNEL_GRE;
+		}
+		m->outer_l3_len = outer_l3_len;
+		off += outer_l3_len;
+
+		if (tc->tunnel == TNL_VXLAN) {
+			struct rte_udp_hdr *udp = (struct rte_udp_hdr *)(p + off);
+			struct rte_vxlan_hdr *vxlan =
+				(struct rte_vxlan_hdr *)(udp + 1);
+
+			memset(udp, 0, sizeof(*udp));
+			udp->src_port = rte_cpu_to_be_16(49152);
+			udp->dst_port = rte_cpu_to_be_16(RTE_VXLAN_DEFAULT_PORT);
+			udp->dgram_len = rte_cpu_to_be_16(tnl_len + inner_len);
+			memset(vxlan, 0, sizeof(*vxlan));
+			vxlan->vx_flags = rte_cpu_to_be_32(0x08000000);
+			fill_eth_hdr((uint8_t *)(vxlan + 1), tc->ipv6);
+		} else {
+			struct rte_gre_hdr *gre = (struct rte_gre_hdr *)(p + off);
+
+			memset(gre, 0, sizeof(*gre));
+			gre->proto = rte_cpu_to_be_16(tc->ipv6 ?
+				RTE_ETHER_TYPE_IPV6 : RTE_ETHER_TYPE_IPV4);
+		}
+		m->l2_len = tnl_len;
+		m->ol_flags |= tc->outer_ipv6 ? RTE_MBUF_F_TX_OUTER_IPV6 :
+			RTE_MBUF_F_TX_OUTER_IPV4;
+	} else {
+		m->outer_l2_len = 0;
+		m->outer_l3_len = 0;
+		m->l2_len = fill_eth_hdr(p, tc->ipv6);
+	}
+	off += m->l2_len;
+
+	m->l3_len = fill_l3_hdr(p + off, tc->ipv6, tc->l4_proto,
+			inner_len - l3_len);
+	off += m->l3_len;
+
+	if (tc->l4_proto == IPPROTO_TCP) {
+		struct rte_tcp_hdr *tcp = (struct rte_tcp_hdr *)(p + off);
+
+		memset(tcp, 0, sizeof(*tcp));
+		tcp->src_port = rte_cpu_to_be_16(9);
+		tcp->dst_port = rte_cpu_to_be_16(9);
+		tcp->sent_seq = rte_cpu_to_be_32(1);
+		tcp->data_off = (sizeof(*tcp) / 4) << 4;
+		tcp->tcp_flags = RTE_TCP_ACK_FLAG | RTE_TCP_PSH_FLAG;
+	} else {
+		struct rte_udp_hdr *udp = (struct rte_udp_hdr *)(p + off);
+
+		memset(udp, 0, sizeof(*udp));
+		udp->src_port = rte_cpu_to_be_16(9);
+		udp->dst_port = rte_cpu_to_be_16(9);
+		udp->dgram_len = rte_cpu_to_be_16(l4_len + GSO_PERF_PAYLOAD_LEN);
+	}
+	m->l4_len = l4_len;
+	off += l4_len;
+
+	hdr_len = off;
+	m->data_len = hdr_len + GSO_PERF_PAYLOAD_LEN;
+	m->pkt_len = m->data_len;
+
+	return hdr_len;
+}
+
+/*
+ * Check that the output segments carry all of the input payload, in
+ * segments as large as allowed, and that their headers were updated:
+ * IP lengths, TCP sequence numbers and flags, and IP fragment fields
+ * for UDP.
+ */
+static int
+gso_check_segs(const struct gso_perf_case *tc, const struct rte_mbuf *pkt,
+		struct rte_mbuf **segs, int nb_segs, uint16_t hdr_len)
+{
+	const struct rte_ipv6_fragment_ext *frag_hdr;
+	const struct rte_ipv6_hdr *ip6;
+	const struct rte_ipv4_hdr *ip4;
+	const struct rte_tcp_hdr *tcp;
+	const struct rte_udp_hdr *udp;
+	uint32_t pyld_len = 0, exp_len = GSO_PERF_PAYLOAD_LEN;
+	uint32_t seg_len, seg_pyld_len, unit_len, frag_id = 0;
+	uint16_t seg_hdr_len = hdr_len, l3_off, frag_data;
+	uint8_t tail, tcp_flags;
+	int i;
+
+	/* UDP GSO fragments the datagram, the UDP header is payload. */
+	if (tc->l4_proto == IPPROTO_UDP) {
+		seg_hdr_len -= sizeof(struct rte_udp_hdr);
+		exp_len += sizeof(struct rte_udp_hdr);
+		if (tc->ipv6 && tc->tunnel == TNL_NONE)
+			seg_hdr_len += sizeof(struct rte_ipv6_fragment_ext);
+		/* fragment offsets are in units of 8 bytes */
+		unit_len = (GSO_PERF_SEG_SIZE - seg_hdr_len) & ~7U;
+	} else {
+		unit_len = GSO_PERF_SEG_SIZE - seg_hdr_len;
+	}
+	l3_off = pkt->outer_l2_len + pkt->outer_l3_len + pkt->l2_len;
+
+	for (i = 0; i < nb_segs; i++) {
+		seg_len = segs[i]->pkt_len;
+		seg_pyld_len = seg_len - seg_hdr_len;
+		tail = i == nb_segs - 1;
+
+		if (seg_len > GSO_PERF_SEG_SIZE || seg_pyld_len > unit_len ||
+				(!tail && seg_pyld_len != unit_len)) {
+			printf("%s: segment %d payload length %u, expected %u\n",
+				tc->name, i, seg_pyld_len, unit_len);
+			return -1;
+		}
+
+		if (tc->tunnel != TNL_NONE) {
+			if (tc->outer_ipv6) {
+				ip6 = rte_pktmbuf_mtod_offset(segs[i],
+					const struct rte_ipv6_hdr *,
+					pkt->outer_l2_len);
+				if (rte_be_to_cpu_16(ip6->payload_len) !=
+						seg_len - pkt->outer_l2_len -
+						sizeof(*ip6))
+					goto bad_outer_len;
+			} else {
+				ip4 = rte_pktmbuf_mtod_offset(segs[i],
+					const struct rte_ipv4_hdr *,
+					pkt->outer_l2_len);
+				if (rte_be_to_cpu_16(ip4->total_length) !=
+						seg_len - pkt->outer_l2_len)
+					goto bad_outer_len;
+			}
+			if (tc->tunnel == TNL_VXLAN) {
+				udp = rte_pktmbuf_mtod_offset(segs[i],
+					const struct rte_udp_hdr *,
+					pkt->outer_l2_len + pkt->outer_l3_len);
+				if (rte_be_to_cpu_16(udp->dgram_len) !=
+						seg_len - pkt->outer_l2_len -
+						pkt->outer_l3_len)
+					goto bad_outer_len;
+			}
+		}
+
+		if (tc->ipv6) {
+			ip6 = rte_pktmbuf_mtod_offset(segs[i],
+				const struct rte_ipv6_hdr *, l3_off);
+			if (rte_be_to_cpu_16(ip6->payload_len) !=
+					seg_len - l3_off - sizeof(*ip6)) {
+				printf("%s: segment %d IPv6 payload length %u\n",
+					tc->name, i,
+					rte_be_to_cpu_16(ip6->payload_len));
+				return -1;
+			}
+		} else {
+			ip4 = rte_pktmbuf_mtod_offset(segs[i],
+				const struct rte_ipv4_hdr *, l3_off);
+			if (rte_be_to_cpu_16(ip4->total_length) !=
+					seg_len - l3_off) {
+				printf("%s: segment %d IPv4 total length %u\n",
+					tc->name, i,
+					rte_be_to_cpu_16(ip4->total_length));
+				return -1;
+			}
+		}
+
+		if (tc->l4_proto == IPPROTO_TCP) {
+			/* PSH is only kept in the last segment */
+			tcp = rte_pktmbuf_mtod_offset(segs[i],
+				const struct rte_tcp_hdr *, l3_off + pkt->l3_len);
+			tcp_flags = RTE_TCP_ACK_FLAG |
+				(tail ? RTE_TCP_PSH_FLAG : 0);
+			if (rte_be_to_cpu_32(tcp->sent_seq) != 1 + pyld_len ||
+					tcp->tcp_flags != tcp_flags) {
+				printf("%s: segment %d TCP seq %u flags 0x%x\n",
+					tc->name, i,
+					rte_be_to_cpu_32(tcp->sent_seq),
+					tcp->tcp_flags);
+				return -1;
+			}
+		} else if (tc->ipv6) {
+			frag_hdr = rte_pktmbuf_mtod_offset(segs[i],
+				const struct rte_ipv6_fragment_ext *,
+				l3_off + sizeof(*ip6));
+			frag_data = rte_be_to_cpu_16(frag_hdr->frag_data);
+			if (i == 0)
+				frag_id = frag_hdr->id;
+			if (ip6->proto != IPPROTO_FRAGMENT ||
+					frag_hdr->next_header != IPPROTO_UDP ||
+					frag_hdr->id != frag_id ||
+					(frag_data & RTE_IPV6_EHDR_FO_MASK) !=
+						pyld_len ||
+					RTE_IPV6_GET_MF(frag_data) != !tail) {
+				printf("%s: segment %d fragment header 0x%x\n",
+					tc->name, i, frag_data);
+				return -1;
+			}
+		} else {
+			frag_data = rte_be_to_cpu_16(ip4->fragment_offset);
+			if ((frag_data & RTE_IPV4_HDR_OFFSET_MASK) !=
+					pyld_len / 8 ||
+					((frag_data & RTE_IPV4_HDR_MF_FLAG) ==
+						0) != tail) {
+				printf("%s: segment %d fragment offset 0x%x\n",
+					tc->name, i, frag_data);
+				return -1;
+			}
+		}
+
+		pyld_len += seg_pyld_len;
+	}
+
+	if (pyld_len != exp_len) {
+		printf("%s: payload length mismatch: %u != %u\n", tc->name,
+			pyld_len, exp_len);
+		return -1;
+	}
+	return 0;
+
+bad_outer_len:
+	printf("%s: segment %d outer header lengths not updated\n",
+		tc->name, i);
+	return -1;
+}
+
+/*
+ * Segment a packet of type tc the given number of times, checking the
+ * output of the first run, and print the cycles spent if requested.
+ */
+static int
+gso_perf_run_case(const struct gso_perf_case *tc, uint32_t iterations,
+		bool print)
+{
+	struct rte_mbuf *segs[GSO_PERF_MAX_SEGS];
+	struct rte_gso_ctx ctx;
+	struct rte_mbuf *pkt;
+	uint64_t ol_flags, tsc, cycles = 0, nb_out = 0;
+	uint16_t hdr_len;
+	uint32_t i;
+	int ret, j;
+
+	pkt = rte_pktmbuf_alloc(pkt_pool);
+	if (pkt == NULL) {
+		printf("%s: failed to allocate packet\n", tc->name);
+		return -1;
+	}
+	hdr_len = gso_perf_build_pkt(pkt, tc);
+	ol_flags = pkt->ol_flags;
+
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.direct_pool = direct_pool;
+	ctx.indirect_pool = indirect_pool;
+	ctx.gso_size = GSO_PERF_SEG_SIZE;
+	ctx.gso_types = RTE_ETH_TX_OFFLOAD_TCP_TSO | RTE_ETH_TX_OFFLOAD_UDP_TSO |
+		RTE_ETH_TX_OFFLOAD_VXLAN_TNL_TSO | RTE_ETH_TX_OFFLOAD_GRE_TNL_TSO;
+
+	for (i = 0; i < iterations; i++) {
+		pkt->ol_flags = ol_flags;
+
+		tsc = rte_rdtsc_precise();
+		ret = rte_gso_segment(pkt, &ctx, segs, RTE_DIM(segs));
+		cycles += rte_rdtsc_precise() - tsc;
+
+		if (ret <= 1) {
+			printf("%s: segmentation failed: %d\n", tc->name, ret);
+			rte_pktmbuf_free(pkt);
+			return -1;
+		}
+		if (i == 0 && gso_check_segs(tc, pkt, segs, ret, hdr_len) != 0) {
+			rte_pktmbuf_free_bulk(segs, ret);
+			rte_pktmbuf_free(pkt);
+			return -1;
+		}
+		nb_out += ret;
+
+		for (j = 0; j < ret; j++)
+			rte_pktmbuf_free(segs[j]);
+	}
+
+	if (print)
+		printf("%-22s %10u %12"PRIu64" %14"PRIu64"\n", tc->name,
+			(unsigned int)(nb_out / iterations),
+			cycles / iterations, cycles / nb_out);
+
+	rte_pktmbuf_free(pkt);
+	return 0;
+}
+
+static int
+gso_test_setup(void)
+{
+	pkt_pool = rte_pktmbuf_pool_create("gso_perf_pkt", 64, 0, 0,
+			GSO_PERF_BUF_SIZE, SOCKET_ID_ANY);
+	direct_pool = rte_pktmbuf_pool_create("gso_perf_direct",
+			GSO_PERF_NB_MBUFS, 0, 0, RTE_MBUF_DEFAULT_BUF_SIZE,
+			SOCKET_ID_ANY);
+	indirect_pool = rte_pktmbuf_pool_create("gso_perf_indirect",
+			GSO_PERF_NB_MBUFS, 0, 0, 0, SOCKET_ID_ANY);
+	if (pkt_pool == NULL || direct_pool == NULL || indirect_pool == NULL) {
+		printf("Failed to create mbuf pools\n");
+		return -1;
+	}
+	return 0;
+}
+
+static void
+gso_test_teardown(void)
+{
+	rte_mempool_free(indirect_pool);
+	rte_mempool_free(direct_pool);
+	rte_mempool_free(pkt_pool);
+	indirect_pool = NULL;
+	direct_pool = NULL;
+	pkt_pool = NULL;
+}
+
+static int
+test_gso_perf(void)
+{
+	unsigned int i;
+	int ret = TEST_SUCCESS;
+
+	if (gso_test_setup() != 0) {
+		ret = TEST_FAILED;
+		goto exit;
+	}
+
+	printf("### rte_gso_segment() performance, %u byte payload, "
+		"%u byte segments ###\n", GSO_PERF_PAYLOAD_LEN,
+		GSO_PERF_SEG_SIZE);
+	printf("%-22s %10s %12s %14s\n", "Packet type", "Segments",
+		"Cycles/pkt", "Cycles/segment");
+
+	for (i = 0; i < RTE_DIM(gso_perf_cases); i++) {
+		if (gso_perf_run_case(&gso_perf_cases[i], GSO_PERF_ITERATIONS,
+				true) != 0) {
+			ret = TEST_FAILED;
+			break;
+		}
+	}
+
+exit:
+	gso_test_teardown();
+	return ret;
+}
+
+/* Segment one packet of each type and check the output segments. */
+static int
+test_gso(void)
+{
+	unsigned int i;
+	int ret = TEST_SUCCESS;
+
+	if (gso_test_setup() != 0) {
+		ret = TEST_FAILED;
+		goto exit;
+	}
+
+	for (i = 0; i < RTE_DIM(gso_perf_cases); i++) {
+		if (gso_perf_run_case(&gso_perf_cases[i], 1, false) != 0) {
+			ret = TEST_FAILED;
+			break;
+		}
+	}
+
+exit:
+	gso_test_teardown();
+	return ret;
+}
+
+REGISTER_FAST_TEST(gso_autotest, NOHUGE_OK, ASAN_OK, test_gso);
+REGISTER_PERF_TEST(gso_perf_autotest, test_gso_perf);
@@ -2342,6 +2342,408 @@ test_hash_rcu_qsbr_dq_reclaim(void)
 	return 0;
 }
 
+#define RESIZE_TEST_KEYS 4096
+#define RESIZE_TEST_INIT_ENTRIES 64
+
+/*
+ * Check that all the added keys of the table, whose data is their
+ * value, are found by single and bulk lookups, and only them.
+ */
+static int
+check_added_keys(struct rte_hash *handle, const uint32_t *keys,
+		const uint8_t *added, unsigned int nb_keys)
+{
+	const void *key_ptrs[RTE_HASH_LOOKUP_BULK_MAX];
+	hash_sig_t sigs[RTE_HASH_LOOKUP_BULK_MAX];
+	void *data[RTE_HASH_LOOKUP_BULK_MAX];
+	uint64_t hit_mask, expected_mask;
+	unsigned int i, j, n;
+	void *d;
+	int ret;
+
+	for (i = 0; i < nb_keys; i++) {
+		ret = rte_hash_lookup_data(handle, &keys[i], &d);
+		if (added[i] && (ret < 0 || (uintptr_t)d != keys[i])) {
+			printf("key %u not found (%d)\n", keys[i], ret);
+			return -1;
+		}
+		if (!added[i] && ret != -ENOENT) {
+			printf("deleted key %u found (%d)\n", keys[i], ret);
+			return -1;
+		}
+	}
+
+	for (i = 0; i < nb_keys; i += n) {
+		n = RTE_MIN(nb_keys - i, (unsigned int)RTE_HASH_LOOKUP_BULK_MAX);
+		expected_mask = 0;
+		for (j = 0; j < n; j++) {
+			key_ptrs[j] = &keys[i + j];
+			sigs[j] = rte_hash_hash(handle, &keys[i + j]);
+			if (added[i + j])
+				expected_mask |= 1ULL << j;
+		}
+
+		hit_mask = 0;
+		rte_hash_lookup_bulk_data(handle, key_ptrs, n, &hit_mask, data);
+		if (hit_mask != expected_mask) {
+			printf("bulk lookup of keys %u-%u failed\n", i, i + n - 1);
+			return -1;
+		}
+		hit_mask = 0;
+		rte_hash_lookup_with_hash_bulk_data(handle, key_ptrs, sigs, n,
+				&hit_mask, data);
+		if (hit_mask != expected_mask) {
+			printf("bulk lookup with hash of keys %u-%u failed\n",
+				i, i + n - 1);
+			return -1;
+		}
+		for (j = 0; j < n; j++) {
+			if (added[i + j] && (uintptr_t)data[j] != keys[i + j]) {
+				printf("bad data for key %u\n", keys[i + j]);
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Test a resizable table, which grows as keys are added, and whose keys
+ * remain found while they are moved to the new buckets.
+ */
+static int
+test_resizable(uint8_t lf)
+{
+	struct rte_hash_parameters params = {
+		.name = "test_resizable",
+		.entries = RESIZE_TEST_INIT_ENTRIES,
+		.key_len = sizeof(uint32_t),
+		.hash_func = rte_jhash,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RESIZABLE,
+	};
+	static uint32_t keys[RESIZE_TEST_KEYS];
+	static uint8_t added[RESIZE_TEST_KEYS];
+	struct rte_hash *handle = NULL;
+	const void *next_key;
+	void *next_data;
+	uint32_t iter;
+	int32_t max_key_id, pos;
+	unsigned int i, count;
+
+	printf("\n# Running resizable table functional test%s\n",
+		lf ? " with lock free readers" : "");
+
+	/* Resizable table with an unsupported flag */
+	params.extra_flag |= RTE_HASH_EXTRA_FLAGS_EXT_TABLE;
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle != NULL,
+		"resizable table with ext table should have failed");
+	params.extra_flag = RTE_HASH_EXTRA_FLAGS_RESIZABLE;
+	if (lf)
+		params.extra_flag |= RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF;
+
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	for (i = 0; i < RESIZE_TEST_KEYS; i++) {
+		keys[i] = rte_rand();
+		added[i] = 0;
+	}
+
+	/* Add keys until the table has grown several times, checking all
+	 * the keys while their buckets are being migrated.
+	 */
+	max_key_id = rte_hash_max_key_id(handle);
+	for (i = 0; i < RESIZE_TEST_KEYS; i++) {
+		pos = rte_hash_add_key_data(handle, &keys[i],
+				(void *)(uintptr_t)keys[i]);
+		RETURN_IF_ERROR(pos < 0, "failed to add key %u (%d)", i, pos);
+		added[i] = 1;
+		if (rte_hash_max_key_id(handle) != max_key_id || i % 512 == 0) {
+			max_key_id = rte_hash_max_key_id(handle);
+			RETURN_IF_ERROR(check_added_keys(handle, keys,
+				added, RESIZE_TEST_KEYS) != 0,
+				"lookup failed after adding %u keys", i + 1);
+		}
+	}
+	RETURN_IF_ERROR(rte_hash_count(handle) != RESIZE_TEST_KEYS,
+		"bad key count %d", rte_hash_count(handle));
+	RETURN_IF_ERROR(max_key_id < RESIZE_TEST_KEYS,
+		"table did not grow (max key id %d)", max_key_id);
+
+	/* Grow the table explicitly, deleting half of the keys while it is
+	 * being resized.
+	 */
+	RETURN_IF_ERROR(rte_hash_resize(handle, 4 * RESIZE_TEST_KEYS) != 0,
+		"failed to resize the table");
+	for (i = 0; i < RESIZE_TEST_KEYS; i += 2) {
+		pos = rte_hash_del_key(handle, &keys[i]);
+		RETURN_IF_ERROR(pos < 0, "failed to delete key %u (%d)", i, pos);
+		if (lf)
+			rte_hash_free_key_with_position(handle, pos);
+		added[i] = 0;
+		if (i % 256 == 0)
+			RETURN_IF_ERROR(check_added_keys(handle, keys,
+				added, RESIZE_TEST_KEYS) != 0,
+				"lookup failed after deleting key %u", i);
+	}
+
+	/* Iterate the keys, some of them being still in the old buckets */
+	count = 0;
+	iter = 0;
+	while (rte_hash_iterate(handle, &next_key, &next_data, &iter) >= 0) {
+		RETURN_IF_ERROR((uintptr_t)next_data !=
+			*(const uint32_t *)next_key, "bad iterated data");
+		count++;
+	}
+	RETURN_IF_ERROR(count != RESIZE_TEST_KEYS / 2,
+		"iterated %u keys instead of %u", count, RESIZE_TEST_KEYS / 2);
+
+	/* Complete the resize */
+	while ((pos = rte_hash_resize_step(handle, 16)) > 0)
+		;
+	RETURN_IF_ERROR(pos != 0, "failed to complete the resize (%d)", pos);
+	RETURN_IF_ERROR(check_added_keys(handle, keys, added,
+		RESIZE_TEST_KEYS) != 0, "lookup failed after resize");
+	RETURN_IF_ERROR(rte_hash_max_key_id(handle) < 4 * RESIZE_TEST_KEYS,
+		"bad max key id after resize");
+
+	/* Reset the table, which keeps its size */
+	rte_hash_reset(handle);
+	memset(added, 0, sizeof(added));
+	RETURN_IF_ERROR(rte_hash_count(handle) != 0, "table not empty");
+	for (i = 0; i < RESIZE_TEST_KEYS; i++) {
+		pos = rte_hash_add_key_data(handle, &keys[i],
+				(void *)(uintptr_t)keys[i]);
+		RETURN_IF_ERROR(pos < 0, "failed to add key %u (%d)", i, pos);
+		added[i] = 1;
+	}
+	RETURN_IF_ERROR(check_added_keys(handle, keys, added,
+		RESIZE_TEST_KEYS) != 0, "lookup failed after reset");
+
+	rte_hash_free(handle);
+
+	/* Tables which are not resizable cannot be resized */
+	params.extra_flag = 0;
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+	RETURN_IF_ERROR(rte_hash_resize(handle, 2 * RESIZE_TEST_INIT_ENTRIES) !=
+		-EINVAL, "resize of a fixed size table should have failed");
+	rte_hash_free(handle);
+
+	return 0;
+}
+
+#define KEY_INLINE_TEST_ENTRIES 4096
+#define KEY_INLINE_TEST_KEYS (KEY_INLINE_TEST_ENTRIES / 4 * 3)
+
+/*
+ * Test a key inline table, whose keys and data are stored in the buckets.
+ */
+static int
+test_key_inline(uint8_t extra_flag)
+{
+	struct rte_hash_parameters params = {
+		.name = "test_key_inline",
+		.entries = KEY_INLINE_TEST_ENTRIES,
+		.key_len = RTE_HASH_KEY_INLINE_LEN_MAX + 1,
+		.hash_func = rte_jhash,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_KEY_INLINE,
+	};
+	static uint32_t keys[KEY_INLINE_TEST_KEYS];
+	static uint8_t added[KEY_INLINE_TEST_KEYS];
+	struct rte_hash *handle = NULL;
+	const void *next_key;
+	void *next_data, *key;
+	uint32_t iter;
+	int32_t pos;
+	unsigned int i, count;
+
+	printf("\n# Running key inline table functional test%s\n",
+		extra_flag ? " with locks" : "");
+
+	/* Key inline table with a too long key or an unsupported flag */
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle != NULL,
+		"key inline table with a long key should have failed");
+	params.key_len = sizeof(uint32_t);
+	params.extra_flag |= RTE_HASH_EXTRA_FLAGS_EXT_TABLE;
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle != NULL,
+		"key inline table with ext table should have failed");
+
+	params.extra_flag = RTE_HASH_EXTRA_FLAGS_KEY_INLINE | extra_flag;
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+	RETURN_IF_ERROR(rte_hash_max_key_id(handle) != KEY_INLINE_TEST_ENTRIES,
+		"bad max key id %d", rte_hash_max_key_id(handle));
+
+	/* Distinct keys, multiplying by an odd number */
+	for (i = 0; i < KEY_INLINE_TEST_KEYS; i++) {
+		keys[i] = (i + 1) * 2654435761u;
+		added[i] = 0;
+	}
+
+	for (i = 0; i < KEY_INLINE_TEST_KEYS; i++) {
+		pos = rte_hash_add_key_data(handle, &keys[i],
+				(void *)(uintptr_t)keys[i]);
+		RETURN_IF_ERROR(pos != 0, "failed to add key %u (%d)", i, pos);
+		added[i] = 1;
+	}
+	RETURN_IF_ERROR(check_added_keys(handle, keys, added,
+		KEY_INLINE_TEST_KEYS) != 0, "lookup failed after add");
+	RETURN_IF_ERROR(rte_hash_count(handle) != KEY_INLINE_TEST_KEYS,
+		"bad key count %d", rte_hash_count(handle));
+
+	/* Update the data of a key, and get it from its position */
+	RETURN_IF_ERROR(rte_hash_add_key_data(handle, &keys[0], NULL) != 0,
+		"failed to update key data");
+	pos = rte_hash_lookup_data(handle, &keys[0], &next_data);
+	RETURN_IF_ERROR(pos < 0 || next_data != NULL, "key data not updated");
+	RETURN_IF_ERROR(rte_hash_get_key_with_position(handle, pos, &key) != 0 ||
+		*(uint32_t *)key != keys[0], "bad key at position %d", pos);
+	rte_hash_add_key_data(handle, &keys[0], (void *)(uintptr_t)keys[0]);
+	RETURN_IF_ERROR(rte_hash_count(handle) != KEY_INLINE_TEST_KEYS,
+		"bad key count %d after update", rte_hash_count(handle));
+
+	/* Delete half of the keys, which are freed on delete */
+	for (i = 0; i < KEY_INLINE_TEST_KEYS; i += 2) {
+		pos = rte_hash_del_key(handle, &keys[i]);
+		RETURN_IF_ERROR(pos < 0, "failed to delete key %u (%d)", i, pos);
+		RETURN_IF_ERROR(rte_hash_free_key_with_position(handle, pos) !=
+			-EINVAL, "free of a key inline position should fail");
+		RETURN_IF_ERROR(rte_hash_get_key_with_position(handle, pos,
+			&key) != -ENOENT, "deleted key found at %d", pos);
+		added[i] = 0;
+	}
+	RETURN_IF_ERROR(check_added_keys(handle, keys, added,
+		KEY_INLINE_TEST_KEYS) != 0, "lookup failed after delete");
+
+	count = 0;
+	iter = 0;
+	while (rte_hash_iterate(handle, &next_key, &next_data, &iter) >= 0) {
+		RETURN_IF_ERROR((uintptr_t)next_data !=
+			*(const uint32_t *)next_key, "bad iterated data");
+		count++;
+	}
+	RETURN_IF_ERROR(count != KEY_INLINE_TEST_KEYS / 2,
+		"iterated %u keys instead of %u", count,
+		KEY_INLINE_TEST_KEYS / 2);
+
+	rte_hash_reset(handle);
+	memset(added, 0, sizeof(added));
+	RETURN_IF_ERROR(rte_hash_count(handle) != 0, "table not empty");
+	RETURN_IF_ERROR(check_added_keys(handle, keys, added,
+		KEY_INLINE_TEST_KEYS) != 0, "lookup failed after reset");
+
+	rte_hash_free(handle);
+
+	return 0;
+}
+
+#define AGE_TEST_ENTRIES 1024
+#define AGE_TEST_KEYS 512
+#define AGE_TEST_TIMEOUT_MS 100
+
+/*
+ * Test the aging of a table: the keys which are not looked up during the
+ * timeout are deleted a slice of buckets at a time.
+ */
+static int
+test_hash_age(uint8_t lf)
+{
+	struct rte_hash_parameters params = {
+		.name = "test_hash_age",
+		.entries = AGE_TEST_ENTRIES,
+		.key_len = sizeof(uint32_t),
+		.hash_func = rte_jhash,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_EXT_TABLE,
+	};
+	static uint32_t keys[AGE_TEST_KEYS];
+	static uint8_t added[AGE_TEST_KEYS];
+	const void *key_ptrs[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t positions[RTE_HASH_LOOKUP_BULK_MAX];
+	void *data[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_hash *handle = NULL;
+	unsigned int i, j, nb_expired, nb_calls;
+	int32_t ret;
+
+	printf("\n# Running hash aging functional test%s\n",
+		lf ? " with lock free readers" : "");
+
+	if (lf)
+		params.extra_flag |= RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF;
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+	RETURN_IF_ERROR(rte_hash_age_expire(handle, 1, 1, positions, data) !=
+		-EINVAL, "expire without aging should have failed");
+	RETURN_IF_ERROR(rte_hash_age_enable(handle,
+		rte_get_tsc_hz() * AGE_TEST_TIMEOUT_MS / 1000) != 0,
+		"failed to enable aging");
+
+	for (i = 0; i < AGE_TEST_KEYS; i++) {
+		keys[i] = (i + 1) * 2654435761u;
+		ret = rte_hash_add_key_data(handle, &keys[i],
+				(void *)(uintptr_t)keys[i]);
+		RETURN_IF_ERROR(ret != 0, "failed to add key %u (%d)", i, ret);
+		added[i] = 1;
+	}
+
+	/* No key expires before the timeout */
+	ret = rte_hash_age_expire(handle, AGE_TEST_ENTRIES, AGE_TEST_KEYS,
+			positions, data);
+	RETURN_IF_ERROR(ret != 0, "%d keys expired before the timeout", ret);
+
+	/* Look up half of the keys after the timeout, with single and bulk
+	 * lookups, so that only the other half expires.
+	 */
+	rte_delay_ms(2 * AGE_TEST_TIMEOUT_MS);
+	for (i = 1; i < AGE_TEST_KEYS / 2; i += 2)
+		rte_hash_lookup(handle, &keys[i]);
+	for (i = AGE_TEST_KEYS / 2 + 1, j = 0; i < AGE_TEST_KEYS; i += 2) {
+		key_ptrs[j++] = &keys[i];
+		if (j == RTE_HASH_LOOKUP_BULK_MAX || i + 2 >= AGE_TEST_KEYS) {
+			rte_hash_lookup_bulk(handle, key_ptrs, j, positions);
+			j = 0;
+		}
+	}
+
+	/* Expire a few keys of a few buckets per call */
+	nb_expired = 0;
+	for (nb_calls = 0; nb_calls < AGE_TEST_ENTRIES; nb_calls++) {
+		ret = rte_hash_age_expire(handle, 4, 8, positions, data);
+		RETURN_IF_ERROR(ret < 0 || ret > 8,
+			"bad number of expired keys %d", ret);
+		for (j = 0; j < (unsigned int)ret; j++) {
+			for (i = 0; i < AGE_TEST_KEYS; i++)
+				if ((uintptr_t)data[j] == keys[i])
+					break;
+			RETURN_IF_ERROR(i == AGE_TEST_KEYS || i % 2 != 0 ||
+				!added[i], "bad expired key data %p", data[j]);
+			added[i] = 0;
+			if (lf)
+				rte_hash_free_key_with_position(handle,
+					positions[j]);
+		}
+		nb_expired += ret;
+	}
+	RETURN_IF_ERROR(nb_expired != AGE_TEST_KEYS / 2,
+		"%u keys expired instead of %u", nb_expired, AGE_TEST_KEYS / 2);
+	RETURN_IF_ERROR(check_added_keys(handle, keys, added,
+		AGE_TEST_KEYS) != 0, "lookup failed after aging");
+
+	rte_hash_free(handle);
+
+	return 0;
+}
+
 /*
  * Do all unit and performance tests.
  */
@@ -2423,6 +2825,25 @@ test_hash(void)
 	if (test_hash_rcu_qsbr_dq_reclaim() < 0)
 		return -1;
 
+	if (test_resizable(0) < 0)
+		return -1;
+
+	if (test_resizable(1) < 0)
+		return -1;
+
+	if (test_hash_age(0) < 0)
+		return -1;
+
+	if (test_hash_age(1) < 0)
+		return -1;
+
+	if (test_key_inline(0) < 0)
+		return -1;
+
+	if (test_key_inline(RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY |
+			RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD) < 0)
+		return -1;
+
 	return 0;
 }
 
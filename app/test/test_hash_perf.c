@@ -14,6 +14,7 @@
 #include <rte_fbk_hash.h>
 #include <rte_random.h>
 #include <rte_string_fns.h>
+#include <rte_vect.h>
 
 #include "test.h"
 
@@ -640,6 +641,227 @@ run_all_tbl_perf_tests(unsigned int with_pushes, unsigned int with_locks,
 	return 0;
 }
 
+/* Control operation of performance testing of bulk lookup burst sizes. */
+#define BULK_KEY_LEN 16
+#define BULK_KEYS_TO_ADD (MAX_ENTRIES / 4 * 3) /* 75% table utilization */
+#define BULK_NUM_LOOKUPS (BULK_KEYS_TO_ADD * 5)
+
+static int
+bulk_lookup_burst_run(uint16_t simd_bitwidth, unsigned int nb_keys)
+{
+	static const unsigned int burst_sizes[] = {
+		16, 32, RTE_HASH_LOOKUP_BULK_MAX
+	};
+	struct rte_hash_parameters params = {
+		.name = "test_hash_bulk",
+		.entries = MAX_ENTRIES,
+		.key_len = BULK_KEY_LEN,
+		.hash_func = rte_jhash,
+		.hash_func_init_val = 0,
+		.socket_id = rte_socket_id(),
+	};
+	const void *keys_burst[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t positions_burst[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_hash *handle;
+	unsigned int burst, i, j, k;
+	uint64_t begin, end;
+	int ret = 0;
+
+	if (rte_vect_set_max_simd_bitwidth(simd_bitwidth) != 0) {
+		printf("Cannot set max SIMD bitwidth to %u, skipping\n",
+			simd_bitwidth);
+		return 0;
+	}
+
+	/* The signature compare function is selected when creating the table */
+	handle = rte_hash_create(&params);
+	if (handle == NULL) {
+		printf("Error creating table\n");
+		return -1;
+	}
+
+	for (i = 0; i < nb_keys; i++) {
+		if (rte_hash_add_key(handle, keys[i]) < 0) {
+			printf("Error adding key %u\n", i);
+			ret = -1;
+			goto exit;
+		}
+	}
+
+	for (i = 0; i < RTE_DIM(burst_sizes); i++) {
+		burst = burst_sizes[i];
+		begin = rte_rdtsc();
+		for (j = 0; j + burst <= BULK_NUM_LOOKUPS; j += burst) {
+			for (k = 0; k < burst; k++)
+				keys_burst[k] = keys[(j + k) % nb_keys];
+			if (rte_hash_lookup_bulk(handle, keys_burst, burst,
+					positions_burst) != 0) {
+				printf("Bulk lookup failed\n");
+				ret = -1;
+				goto exit;
+			}
+			for (k = 0; k < burst; k++) {
+				if (positions_burst[k] < 0) {
+					printf("Key %u not found\n",
+						(j + k) % nb_keys);
+					ret = -1;
+					goto exit;
+				}
+			}
+		}
+		end = rte_rdtsc();
+
+		printf("%-18u%-18u%-18"PRIu64"\n", simd_bitwidth, burst,
+			(end - begin) / j);
+	}
+
+exit:
+	rte_hash_free(handle);
+	return ret;
+}
+
+/*
+ * Compare bulk lookups at several burst sizes, with the signature
+ * compare function selected for the default and the 512-bit max SIMD
+ * bitwidths (i.e. AVX-512 when the CPU supports it).
+ */
+static int
+bulk_lookup_burst_perf_test(void)
+{
+	static const uint16_t simd_bitwidths[] = {
+		RTE_VECT_SIMD_256, RTE_VECT_SIMD_512
+	};
+	uint16_t orig_bitwidth = rte_vect_get_max_simd_bitwidth();
+	unsigned int nb_keys = BULK_KEYS_TO_ADD;
+	unsigned int i, j;
+	int ret = 0;
+
+	/* The keys are random, so the lookups hit random buckets */
+	for (i = 0; i < nb_keys; i++)
+		for (j = 0; j < BULK_KEY_LEN; j++)
+			keys[i][j] = (uint8_t)rte_rand();
+
+	printf("\n *** Bulk lookup burst size performance test results ***\n");
+	printf("\n%-18s%-18s%-18s\n", "Max SIMD bits", "Burst size",
+		"Cycles/lookup");
+	for (i = 0; i < RTE_DIM(simd_bitwidths); i++) {
+		ret = bulk_lookup_burst_run(simd_bitwidths[i], nb_keys);
+		if (ret < 0)
+			break;
+	}
+
+	rte_vect_set_max_simd_bitwidth(orig_bitwidth);
+	return ret;
+}
+
+/* Control operation of performance testing of key inline tables. */
+#define KEY_INLINE_ENTRIES (1 << 24)
+#define KEY_INLINE_KEYS (10 * 1000 * 1000)
+#define KEY_INLINE_KEY_LEN 16
+
+static int
+key_inline_perf_run(const uint8_t (*inline_keys)[KEY_INLINE_KEY_LEN],
+		uint8_t extra_flag)
+{
+	struct rte_hash_parameters params = {
+		.name = "test_hash_key_inline",
+		.entries = KEY_INLINE_ENTRIES,
+		.key_len = KEY_INLINE_KEY_LEN,
+		.hash_func = rte_hash_crc,
+		.hash_func_init_val = 0,
+		.socket_id = rte_socket_id(),
+		.extra_flag = extra_flag,
+	};
+	const void *keys_burst[BURST_SIZE];
+	void *data_burst[BURST_SIZE];
+	uint64_t add_cycles, lookup_cycles, hit_mask;
+	struct rte_hash *handle;
+	uint64_t begin;
+	unsigned int i, j;
+	int ret = 0;
+
+	handle = rte_hash_create(&params);
+	if (handle == NULL) {
+		printf("Error creating table\n");
+		return -1;
+	}
+
+	begin = rte_rdtsc();
+	for (i = 0; i < KEY_INLINE_KEYS; i++) {
+		if (rte_hash_add_key_data(handle, inline_keys[i],
+				(void *)(uintptr_t)i) != 0) {
+			printf("Error adding key %u\n", i);
+			ret = -1;
+			goto exit;
+		}
+	}
+	add_cycles = rte_rdtsc() - begin;
+
+	begin = rte_rdtsc();
+	for (i = 0; i + BURST_SIZE <= KEY_INLINE_KEYS; i += BURST_SIZE) {
+		for (j = 0; j < BURST_SIZE; j++)
+			keys_burst[j] = inline_keys[i + j];
+		rte_hash_lookup_bulk_data(handle, keys_burst, BURST_SIZE,
+				&hit_mask, data_burst);
+		if (hit_mask != RTE_LEN2MASK(BURST_SIZE, uint64_t)) {
+			printf("Keys of burst %u not found\n", i);
+			ret = -1;
+			goto exit;
+		}
+		for (j = 0; j < BURST_SIZE; j++) {
+			if ((uintptr_t)data_burst[j] != i + j) {
+				printf("Bad data for key %u\n", i + j);
+				ret = -1;
+				goto exit;
+			}
+		}
+	}
+	lookup_cycles = rte_rdtsc() - begin;
+
+	printf("%-18s%-18"PRIu64"%-18"PRIu64"\n",
+		extra_flag ? "Key inline" : "Key store",
+		add_cycles / KEY_INLINE_KEYS, lookup_cycles / i);
+
+exit:
+	rte_hash_free(handle);
+	return ret;
+}
+
+/*
+ * Compare the tables storing the keys in a key store, the default, and in
+ * the buckets, with 16-byte keys and data.
+ */
+static int
+key_inline_perf_test(void)
+{
+	uint8_t (*inline_keys)[KEY_INLINE_KEY_LEN];
+	unsigned int i, j;
+	int ret;
+
+	inline_keys = rte_malloc(NULL, KEY_INLINE_KEYS * KEY_INLINE_KEY_LEN, 0);
+	if (inline_keys == NULL) {
+		printf("Key allocation failed\n");
+		return -1;
+	}
+
+	/* The keys are random, so that they are all different */
+	for (i = 0; i < KEY_INLINE_KEYS; i++)
+		for (j = 0; j < KEY_INLINE_KEY_LEN; j += sizeof(uint64_t))
+			*(uint64_t *)&inline_keys[i][j] = rte_rand();
+
+	printf("\n *** Key inline table performance test results ***\n");
+	printf("%u keys in a table of %u entries\n", KEY_INLINE_KEYS,
+		KEY_INLINE_ENTRIES);
+	printf("\n%-18s%-18s%-18s\n", "Layout", "Add", "Lookup_bulk_data");
+	ret = key_inline_perf_run(inline_keys, 0);
+	if (ret == 0)
+		ret = key_inline_perf_run(inline_keys,
+				RTE_HASH_EXTRA_FLAGS_KEY_INLINE);
+
+	rte_free(inline_keys);
+	return ret;
+}
+
 /* Control operation of performance testing of fbk hash. */
 #define LOAD_FACTOR 0.667	/* How full to make the hash table. */
 #define TEST_SIZE 1000000	/* How many operations to time. */
@@ -751,6 +973,12 @@ test_hash_perf(void)
 	if (run_all_tbl_perf_tests(1, 0, 1) < 0)
 		return -1;
 
+	if (bulk_lookup_burst_perf_test() < 0)
+		return -1;
+
+	if (key_inline_perf_test() < 0)
+		return -1;
+
 	if (fbk_hash_perf_test() < 0)
 		return -1;
 
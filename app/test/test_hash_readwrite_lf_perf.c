@@ -51,6 +51,10 @@
 
 #define QSBR_REPORTING_INTERVAL 1024
 
+/* Keys added while a resizable table grows from 1M to 16M entries */
+#define RESIZE_INIT_ENTRY (1024*1024)
+#define RESIZE_TOTAL_INSERT (15*1024*1024)
+
 static unsigned int rwc_core_cnt[NUM_TEST] = {1, 2, 4};
 
 struct rwc_perf {
@@ -1389,6 +1393,202 @@ test_hash_rcu_qsbr_writer_perf(struct rwc_perf *rwc_perf_results, int rwc_lf,
 	return -1;
 }
 
+static uint32_t *resize_keys;
+static RTE_ATOMIC(uint32_t) resize_read_fail;
+
+/*
+ * Reader thread looking up the keys present before a resizable table
+ * grows, which must be found while they are moved to the new buckets.
+ */
+static int
+test_hash_resize_reader(void *arg)
+{
+	const void *key_ptrs[BULK_LOOKUP_SIZE];
+	int32_t pos[BULK_LOOKUP_SIZE];
+	uint8_t bulk = (uint8_t)((uintptr_t)arg);
+	uint32_t lcore_id = rte_lcore_id();
+	uint64_t begin, cycles, reads = 0;
+	uint32_t i, j, k;
+
+	(void)rte_rcu_qsbr_thread_register(rv, lcore_id);
+	rte_rcu_qsbr_thread_online(rv, lcore_id);
+	begin = rte_rdtsc_precise();
+	do {
+		for (i = 0; i < RESIZE_INIT_ENTRY; i += QSBR_REPORTING_INTERVAL) {
+			for (j = i; j < i + QSBR_REPORTING_INTERVAL;
+					j += BULK_LOOKUP_SIZE) {
+				for (k = 0; k < BULK_LOOKUP_SIZE; k++)
+					key_ptrs[k] = resize_keys + j + k;
+				if (bulk)
+					rte_hash_lookup_bulk(tbl_rwc_test_param.h,
+						key_ptrs, BULK_LOOKUP_SIZE, pos);
+				else
+					for (k = 0; k < BULK_LOOKUP_SIZE; k++)
+						pos[k] = rte_hash_lookup(
+							tbl_rwc_test_param.h,
+							key_ptrs[k]);
+				for (k = 0; k < BULK_LOOKUP_SIZE; k++)
+					if (pos[k] < 0)
+						rte_atomic_fetch_add_explicit(
+							&resize_read_fail, 1,
+							rte_memory_order_relaxed);
+			}
+			reads += QSBR_REPORTING_INTERVAL;
+			/* Update quiescent state counter */
+			rte_rcu_qsbr_quiescent(rv, lcore_id);
+		}
+	} while (!writer_done);
+	cycles = rte_rdtsc_precise() - begin;
+	rte_rcu_qsbr_thread_offline(rv, lcore_id);
+	(void)rte_rcu_qsbr_thread_unregister(rv, lcore_id);
+
+	rte_atomic_fetch_add_explicit(&gread_cycles, cycles,
+			rte_memory_order_relaxed);
+	rte_atomic_fetch_add_explicit(&greads, reads, rte_memory_order_relaxed);
+	return 0;
+}
+
+/*
+ * Resizable table perf test with RCU QSBR in DQ mode:
+ * The writer adds keys to a table created for RESIZE_INIT_ENTRY keys,
+ * until it holds RESIZE_TOTAL_INSERT keys. Readers look up the keys
+ * present before the table grows, and check they are all found.
+ */
+static int
+test_hash_resize_lookup_perf(void)
+{
+	struct rte_hash_parameters hash_params = {
+		.name = "tests",
+		.entries = RESIZE_INIT_ENTRY,
+		.key_len = sizeof(uint32_t),
+		.hash_func = rte_hash_crc,
+		.hash_func_init_val = 0,
+		.socket_id = rte_socket_id(),
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF |
+			RTE_HASH_EXTRA_FLAGS_RESIZABLE,
+	};
+	struct rte_hash_rcu_config rcu_config = {0};
+	unsigned int i, nb_readers;
+	uint64_t begin, add_cycles, resize_cycles;
+	uint32_t sz;
+	int ret;
+
+	printf("\nTest: Lookup while growing a resizable table from %u to %u keys\n",
+		RESIZE_INIT_ENTRY, RESIZE_TOTAL_INSERT);
+
+	tbl_rwc_test_param.h = NULL;
+	rv = NULL;
+	resize_keys = rte_malloc(NULL, sizeof(uint32_t) * RESIZE_TOTAL_INSERT,
+			0);
+	if (resize_keys == NULL) {
+		printf("allocation failed\n");
+		goto err;
+	}
+	/* Multiplying by an odd constant gives distinct keys */
+	for (i = 0; i < RESIZE_TOTAL_INSERT; i++)
+		resize_keys[i] = i * 0x9e3779b1;
+
+	tbl_rwc_test_param.h = rte_hash_create(&hash_params);
+	if (tbl_rwc_test_param.h == NULL) {
+		printf("hash creation failed\n");
+		goto err;
+	}
+
+	sz = rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE);
+	rv = (struct rte_rcu_qsbr *)rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	if (rv == NULL) {
+		printf("allocation failed\n");
+		goto err;
+	}
+	rte_rcu_qsbr_init(rv, RTE_MAX_LCORE);
+	rcu_config.v = rv;
+	if (rte_hash_rcu_qsbr_add(tbl_rwc_test_param.h, &rcu_config) != 0) {
+		printf("RCU init in hash failed\n");
+		goto err;
+	}
+
+	for (i = 0; i < RESIZE_INIT_ENTRY; i++) {
+		ret = rte_hash_add_key(tbl_rwc_test_param.h, resize_keys + i);
+		if (ret < 0) {
+			printf("failed to add key %u (%d)\n", i, ret);
+			goto err;
+		}
+	}
+
+	rte_atomic_store_explicit(&gread_cycles, 0, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&greads, 0, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&resize_read_fail, 0,
+			rte_memory_order_relaxed);
+	writer_done = 0;
+
+	/* Launch readers, alternating single and bulk lookups */
+	nb_readers = RTE_MIN(rte_lcore_count() - 1, 4U);
+	for (i = 1; i <= nb_readers; i++)
+		rte_eal_remote_launch(test_hash_resize_reader,
+				(void *)(uintptr_t)(i % 2),
+				enabled_core_ids[i]);
+
+	begin = rte_rdtsc_precise();
+	for (i = RESIZE_INIT_ENTRY; i < RESIZE_TOTAL_INSERT; i++) {
+		ret = rte_hash_add_key(tbl_rwc_test_param.h, resize_keys + i);
+		if (ret < 0) {
+			printf("failed to add key %u (%d)\n", i, ret);
+			goto err;
+		}
+	}
+	add_cycles = rte_rdtsc_precise() - begin;
+
+	/* Complete the last resize */
+	begin = rte_rdtsc_precise();
+	while ((ret = rte_hash_resize_step(tbl_rwc_test_param.h, 64)) > 0)
+		;
+	resize_cycles = rte_rdtsc_precise() - begin;
+
+	writer_done = 1;
+	rte_eal_mp_wait_lcore();
+
+	if (ret != 0) {
+		printf("failed to complete the resize (%d)\n", ret);
+		goto err;
+	}
+	if (rte_atomic_load_explicit(&resize_read_fail,
+			rte_memory_order_relaxed) != 0) {
+		printf("%u lookups failed while resizing\n",
+			rte_atomic_load_explicit(&resize_read_fail,
+				rte_memory_order_relaxed));
+		goto err;
+	}
+	if (rte_hash_count(tbl_rwc_test_param.h) != RESIZE_TOTAL_INSERT) {
+		printf("bad key count %d\n",
+			rte_hash_count(tbl_rwc_test_param.h));
+		goto err;
+	}
+
+	printf("Cycles per add (growing the table): %"PRIu64"\n",
+		add_cycles / (RESIZE_TOTAL_INSERT - RESIZE_INIT_ENTRY));
+	printf("Cycles to complete the last resize: %"PRIu64"\n",
+		resize_cycles);
+	if (rte_atomic_load_explicit(&greads, rte_memory_order_relaxed) != 0)
+		printf("Cycles per lookup while resizing: %"PRIu64"\n",
+			rte_atomic_load_explicit(&gread_cycles,
+				rte_memory_order_relaxed) /
+			rte_atomic_load_explicit(&greads,
+				rte_memory_order_relaxed));
+
+	rte_hash_free(tbl_rwc_test_param.h);
+	rte_free(rv);
+	rte_free(resize_keys);
+	return 0;
+
+err:
+	writer_done = 1;
+	rte_eal_mp_wait_lcore();
+	rte_hash_free(tbl_rwc_test_param.h);
+	rte_free(rv);
+	rte_free(resize_keys);
+	return -1;
+}
+
 static int
 test_hash_readwrite_lf_perf_main(void)
 {
@@ -1451,6 +1651,8 @@ test_hash_readwrite_lf_perf_main(void)
 		if (test_hash_rcu_qsbr_writer_perf(&rwc_lf_results, rwc_lf,
 						   htm, ext_bkt) < 0)
 			return -1;
+		if (test_hash_resize_lookup_perf() < 0)
+			return -1;
 	}
 	printf("\nTest lookup with read-write concurrency lock free support"
 	       " disabled\n");
@@ -401,7 +401,7 @@ test_ip_frag(void)
 					      pktid);
 		}
 
-		if (tests[i].ipv == 4)
+		if (tests[i].ipv == 4) {
 			if (i % 2)
 				len = rte_ipv4_fragment_packet(b, pkts_out, BURST,
 						       tests[i].mtu_size,
@@ -413,11 +413,26 @@ test_ip_frag(void)
 						       BURST,
 						       tests[i].mtu_size,
 						       direct_pool);
-		else if (tests[i].ipv == 6)
-			len = rte_ipv6_fragment_packet(b, pkts_out, BURST,
+		} else if (tests[i].ipv == 6) {
+			if (i % 3 == 0)
+				len = rte_ipv6_fragment_packet(b, pkts_out, BURST,
 						       tests[i].mtu_size,
 						       direct_pool,
 						       indirect_pool);
+			else if (i % 3 == 1)
+				len = rte_ipv6_fragment_copy_nonseg_packet(b,
+						       pkts_out,
+						       BURST,
+						       tests[i].mtu_size,
+						       direct_pool);
+			else
+				len = rte_ipv6_fragment_extbuf_packet(b,
+						       pkts_out,
+						       BURST,
+						       tests[i].mtu_size,
+						       direct_pool,
+						       indirect_pool);
+		}
 
 		rte_pktmbuf_free(b);
 
@@ -483,6 +498,160 @@ test_ip_frag(void)
 	return result;
 }
 
+/*
+ * Build an IPv6 packet with a payload of len bytes, in segments of at most
+ * seg_len bytes of data.
+ */
+static struct rte_mbuf *
+v6_build_multiseg_packet(uint32_t len, uint16_t seg_len)
+{
+	struct rte_mbuf *m, *seg, *prev;
+	struct rte_ipv6_hdr *hdr;
+	uint32_t ofs, n;
+	uint8_t *data;
+
+	m = rte_pktmbuf_alloc(pkt_pool);
+	if (m == NULL)
+		return NULL;
+
+	hdr = (struct rte_ipv6_hdr *)rte_pktmbuf_append(m, sizeof(*hdr));
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->vtc_flow = rte_cpu_to_be_32(0x60 << 24);
+	hdr->payload_len = rte_cpu_to_be_16(len);
+	hdr->proto = IPPROTO_UDP;
+	hdr->hop_limits = 64;
+	memset(&hdr->src_addr, 0x08, sizeof(hdr->src_addr));
+	memset(&hdr->dst_addr, 0x04, sizeof(hdr->dst_addr));
+
+	seg = m;
+	prev = NULL;
+	for (ofs = 0; ofs < len; ofs += n) {
+		if (seg == NULL) {
+			seg = rte_pktmbuf_alloc(pkt_pool);
+			if (seg == NULL) {
+				rte_pktmbuf_free(m);
+				return NULL;
+			}
+			prev->next = seg;
+			m->nb_segs++;
+		}
+		n = RTE_MIN(len - ofs, (uint32_t)(seg_len - seg->data_len));
+		data = rte_pktmbuf_mtod_offset(seg, uint8_t *, seg->data_len);
+		for (uint32_t i = 0; i < n; i++)
+			data[i] = (uint8_t)(ofs + i);
+		seg->data_len += n;
+		m->pkt_len += n;
+		prev = seg;
+		seg = NULL;
+	}
+
+	return m;
+}
+
+/*
+ * Check the headers and the payload of the fragments produced by all the
+ * IPv6 fragmentation functions from a segmented packet.
+ */
+static int
+test_ipv6_frag_modes(void)
+{
+	static const uint32_t payload_lens[] = {1400, 9000};
+	static const uint16_t mtu_size = 1500;
+	/* payload of a fragment, i.e. MTU minus the headers, 8-byte aligned */
+	static const uint16_t frag_size = 1448;
+	uint8_t frag_hdrs[sizeof(struct rte_ipv6_hdr) +
+		sizeof(struct rte_ipv6_fragment_ext)];
+	uint8_t payload[1500];
+	const uint8_t *data;
+	struct rte_mbuf *pkts_out[BURST];
+	struct rte_ipv6_fragment_ext *fh;
+	struct rte_ipv6_hdr *hdr;
+	struct rte_mbuf *b;
+	uint32_t i, j, k, ofs, len, mode;
+	int32_t nb_frags;
+
+	for (i = 0; i < RTE_DIM(payload_lens); i++) {
+		for (mode = 0; mode < 3; mode++) {
+			b = v6_build_multiseg_packet(payload_lens[i], 1000);
+			RTE_TEST_ASSERT_NOT_EQUAL(b, NULL,
+				"Failed to allocate pkt.");
+
+			if (mode == 0)
+				nb_frags = rte_ipv6_fragment_packet(b, pkts_out,
+					BURST, mtu_size, direct_pool,
+					indirect_pool);
+			else if (mode == 1)
+				nb_frags = rte_ipv6_fragment_copy_nonseg_packet(b,
+					pkts_out, BURST, mtu_size, direct_pool);
+			else
+				nb_frags = rte_ipv6_fragment_extbuf_packet(b,
+					pkts_out, BURST, mtu_size, direct_pool,
+					indirect_pool);
+			rte_pktmbuf_free(b);
+
+			RTE_TEST_ASSERT_EQUAL(nb_frags,
+				(int32_t)((payload_lens[i] + frag_size - 1) /
+					frag_size),
+				"Wrong number of fragments, len %u mode %u",
+				payload_lens[i], mode);
+
+			ofs = 0;
+			for (j = 0; j < (uint32_t)nb_frags; j++) {
+				len = pkts_out[j]->pkt_len - sizeof(frag_hdrs);
+				hdr = (struct rte_ipv6_hdr *)(uintptr_t)
+					rte_pktmbuf_read(pkts_out[j], 0,
+						sizeof(frag_hdrs), frag_hdrs);
+				fh = (struct rte_ipv6_fragment_ext *)(hdr + 1);
+
+				RTE_TEST_ASSERT_EQUAL(
+					rte_be_to_cpu_16(hdr->payload_len),
+					len + sizeof(*fh),
+					"Wrong payload length, fragment %u", j);
+				RTE_TEST_ASSERT_EQUAL(hdr->proto,
+					IPPROTO_FRAGMENT,
+					"Wrong protocol, fragment %u", j);
+				RTE_TEST_ASSERT_EQUAL(fh->next_header,
+					IPPROTO_UDP,
+					"Wrong next header, fragment %u", j);
+				RTE_TEST_ASSERT_EQUAL(
+					rte_be_to_cpu_16(fh->frag_data),
+					RTE_IPV6_SET_FRAG_DATA(ofs,
+						ofs + len < payload_lens[i]),
+					"Wrong fragment data, fragment %u", j);
+				if (mode == 2)
+					RTE_TEST_ASSERT(
+						RTE_MBUF_HAS_EXTBUF(pkts_out[j]),
+						"No external buffer, fragment %u",
+						j);
+
+				data = rte_pktmbuf_read(pkts_out[j],
+					sizeof(frag_hdrs), len, payload);
+				for (k = 0; k < len; k++)
+					RTE_TEST_ASSERT_EQUAL(data[k],
+						(uint8_t)(ofs + k),
+						"Wrong payload, fragment %u", j);
+				ofs += len;
+			}
+			RTE_TEST_ASSERT_EQUAL(ofs, payload_lens[i],
+				"Wrong total payload length, mode %u", mode);
+
+			test_free_fragments(pkts_out, nb_frags);
+
+			/* All the buffers, e.g. the header one, are freed. */
+			RTE_TEST_ASSERT_EQUAL(rte_mempool_avail_count(direct_pool),
+				NUM_MBUFS, "Leaked direct mbufs, mode %u", mode);
+			RTE_TEST_ASSERT_EQUAL(
+				rte_mempool_avail_count(indirect_pool),
+				NUM_MBUFS, "Leaked indirect mbufs, mode %u",
+				mode);
+			RTE_TEST_ASSERT_EQUAL(rte_mempool_avail_count(pkt_pool),
+				NUM_MBUFS, "Leaked packet mbufs, mode %u", mode);
+		}
+	}
+
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite ipfrag_testsuite  = {
 	.suite_name = "IP Frag Unit Test Suite",
 	.setup = testsuite_setup,
@@ -490,6 +659,8 @@ static struct unit_test_suite ipfrag_testsuite  = {
 	.unit_test_cases = {
 		TEST_CASE_ST(ut_setup, ut_teardown,
 			     test_ip_frag),
+		TEST_CASE_ST(ut_setup, ut_teardown,
+			     test_ipv6_frag_modes),
 
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
@@ -0,0 +1,222 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ip.h>
+#include <rte_ip_frag.h>
+#include <rte_mbuf.h>
+
+#include "test.h"
+
+#define IPFRAG_PERF_ITERATIONS 20000
+#define IPFRAG_PERF_PKT_SIZE 9000 /* IP packet, headers included */
+#define IPFRAG_PERF_MTU 1500
+#define IPFRAG_PERF_SEG_SIZE 2048 /* data per segment of segmented packets */
+#define IPFRAG_PERF_NB_MBUFS 8192
+#define IPFRAG_PERF_CACHE_SIZE 256
+#define IPFRAG_PERF_MAX_FRAGS 16
+#define IPFRAG_PERF_IN_BUF_SIZE (RTE_PKTMBUF_HEADROOM + IPFRAG_PERF_PKT_SIZE)
+
+static struct rte_mempool *in_pool, *direct_pool, *indirect_pool;
+
+typedef int32_t (*ipfrag_perf_fn)(struct rte_mbuf *pkt_in,
+		struct rte_mbuf **pkts_out, uint16_t nb_pkts_out,
+		uint16_t mtu_size, struct rte_mempool *pool_direct,
+		struct rte_mempool *pool_indirect);
+
+static int32_t
+ipv4_copy_fragment(struct rte_mbuf *pkt_in, struct rte_mbuf **pkts_out,
+		uint16_t nb_pkts_out, uint16_t mtu_size,
+		struct rte_mempool *pool_direct,
+		struct rte_mempool *pool_indirect __rte_unused)
+{
+	return rte_ipv4_fragment_copy_nonseg_packet(pkt_in, pkts_out,
+			nb_pkts_out, mtu_size, pool_direct);
+}
+
+static int32_t
+ipv6_copy_fragment(struct rte_mbuf *pkt_in, struct rte_mbuf **pkts_out,
+		uint16_t nb_pkts_out, uint16_t mtu_size,
+		struct rte_mempool *pool_direct,
+		struct rte_mempool *pool_indirect __rte_unused)
+{
+	return rte_ipv6_fragment_copy_nonseg_packet(pkt_in, pkts_out,
+			nb_pkts_out, mtu_size, pool_direct);
+}
+
+struct ipfrag_perf_case {
+	const char *name;
+	int ipv6;
+	ipfrag_perf_fn fn;
+};
+
+static const struct ipfrag_perf_case ipfrag_perf_cases[] = {
+	{ "IPv4 indirect", 0, rte_ipv4_fragment_packet },
+	{ "IPv4 copy", 0, ipv4_copy_fragment },
+	{ "IPv6 indirect", 1, rte_ipv6_fragment_packet },
+	{ "IPv6 copy", 1, ipv6_copy_fragment },
+	{ "IPv6 extbuf", 1, rte_ipv6_fragment_extbuf_packet },
+};
+
+/*
+ * Build an IP packet of IPFRAG_PERF_PKT_SIZE bytes, in segments of at most
+ * seg_size bytes.
+ */
+static struct rte_mbuf *
+ipfrag_perf_build_pkt(int ipv6, uint16_t seg_size)
+{
+	struct rte_mbuf *m, *seg, *prev;
+	uint32_t len, n;
+
+	m = rte_pktmbuf_alloc(in_pool);
+	if (m == NULL)
+		return NULL;
+
+	prev = NULL;
+	seg = m;
+	for (len = 0; len < IPFRAG_PERF_PKT_SIZE; len += n) {
+		if (seg == NULL) {
+			seg = rte_pktmbuf_alloc(in_pool);
+			if (seg == NULL) {
+				rte_pktmbuf_free(m);
+				return NULL;
+			}
+			prev->next = seg;
+			m->nb_segs++;
+		}
+		n = RTE_MIN(IPFRAG_PERF_PKT_SIZE - len, (uint32_t)seg_size);
+		memset(rte_pktmbuf_mtod(seg, void *), (int)len, n);
+		seg->data_len = n;
+		m->pkt_len += n;
+		prev = seg;
+		seg = NULL;
+	}
+
+	if (ipv6) {
+		struct rte_ipv6_hdr *hdr;
+
+		hdr = rte_pktmbuf_mtod(m, struct rte_ipv6_hdr *);
+		memset(hdr, 0, sizeof(*hdr));
+		hdr->vtc_flow = rte_cpu_to_be_32(0x60 << 24);
+		hdr->payload_len = rte_cpu_to_be_16(IPFRAG_PERF_PKT_SIZE -
+				sizeof(*hdr));
+		hdr->proto = IPPROTO_UDP;
+		hdr->hop_limits = 64;
+		memset(&hdr->src_addr, 0x08, sizeof(hdr->src_addr));
+		memset(&hdr->dst_addr, 0x04, sizeof(hdr->dst_addr));
+	} else {
+		struct rte_ipv4_hdr *hdr;
+
+		hdr = rte_pktmbuf_mtod(m, struct rte_ipv4_hdr *);
+		memset(hdr, 0, sizeof(*hdr));
+		hdr->version_ihl = RTE_IPV4_VHL_DEF;
+		hdr->total_length = rte_cpu_to_be_16(IPFRAG_PERF_PKT_SIZE);
+		hdr->packet_id = rte_cpu_to_be_16(1);
+		hdr->time_to_live = 64;
+		hdr->next_proto_id = IPPROTO_UDP;
+		hdr->src_addr = rte_cpu_to_be_32(RTE_IPV4(10, 0, 0, 1));
+		hdr->dst_addr = rte_cpu_to_be_32(RTE_IPV4(10, 0, 0, 2));
+	}
+
+	return m;
+}
+
+static int
+ipfrag_perf_run(const struct ipfrag_perf_case *tc, uint16_t seg_size)
+{
+	struct rte_mbuf *frags[IPFRAG_PERF_MAX_FRAGS];
+	struct rte_mbuf *pkt;
+	uint64_t tsc, frag_cycles, free_cycles, nb_frags;
+	double cycles_per_frag;
+	int32_t n;
+	uint32_t i;
+
+	pkt = ipfrag_perf_build_pkt(tc->ipv6, seg_size);
+	if (pkt == NULL) {
+		printf("Failed to build packet\n");
+		return -1;
+	}
+
+	nb_frags = 0;
+	frag_cycles = 0;
+	free_cycles = 0;
+	for (i = 0; i < IPFRAG_PERF_ITERATIONS; i++) {
+		tsc = rte_rdtsc_precise();
+		n = tc->fn(pkt, frags, RTE_DIM(frags), IPFRAG_PERF_MTU,
+				direct_pool, indirect_pool);
+		frag_cycles += rte_rdtsc_precise() - tsc;
+		if (n <= 0) {
+			printf("%s: fragmentation failed (%d)\n", tc->name, n);
+			rte_pktmbuf_free(pkt);
+			return -1;
+		}
+		nb_frags += n;
+
+		/* the fragments are freed, as a transmit would do */
+		tsc = rte_rdtsc_precise();
+		rte_pktmbuf_free_bulk(frags, n);
+		free_cycles += rte_rdtsc_precise() - tsc;
+	}
+	rte_pktmbuf_free(pkt);
+
+	cycles_per_frag = (double)(frag_cycles + free_cycles) / nb_frags;
+	printf("%-16s %8u %10" PRIu64 " %12.1f %12.1f %10.2f\n", tc->name,
+		RTE_ALIGN_CEIL(IPFRAG_PERF_PKT_SIZE, seg_size) / seg_size,
+		nb_frags / IPFRAG_PERF_ITERATIONS,
+		(double)frag_cycles / nb_frags,
+		(double)free_cycles / nb_frags,
+		rte_get_tsc_hz() / cycles_per_frag / 1E6);
+
+	return 0;
+}
+
+static int
+test_ipfrag_perf(void)
+{
+	static const uint16_t seg_sizes[] = {
+		IPFRAG_PERF_PKT_SIZE, IPFRAG_PERF_SEG_SIZE,
+	};
+	unsigned int i, j;
+	int ret = TEST_SUCCESS;
+
+	in_pool = rte_pktmbuf_pool_create("ipfrag_perf_in", 64, 0, 0,
+			IPFRAG_PERF_IN_BUF_SIZE, SOCKET_ID_ANY);
+	direct_pool = rte_pktmbuf_pool_create("ipfrag_perf_direct",
+			IPFRAG_PERF_NB_MBUFS, IPFRAG_PERF_CACHE_SIZE, 0,
+			RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	indirect_pool = rte_pktmbuf_pool_create("ipfrag_perf_indirect",
+			IPFRAG_PERF_NB_MBUFS, IPFRAG_PERF_CACHE_SIZE, 0, 0,
+			SOCKET_ID_ANY);
+	if (in_pool == NULL || direct_pool == NULL || indirect_pool == NULL) {
+		printf("Failed to create mbuf pools\n");
+		ret = TEST_FAILED;
+		goto exit;
+	}
+
+	printf("### Fragmentation of %u byte packets, MTU %u ###\n",
+		IPFRAG_PERF_PKT_SIZE, IPFRAG_PERF_MTU);
+	printf("%-16s %8s %10s %12s %12s %10s\n", "Function", "In segs",
+		"Frags/pkt", "Cycles/frag", "Free cycles", "Mfrags/s");
+	for (j = 0; j < RTE_DIM(seg_sizes); j++) {
+		for (i = 0; i < RTE_DIM(ipfrag_perf_cases); i++) {
+			if (ipfrag_perf_run(&ipfrag_perf_cases[i],
+					seg_sizes[j]) != 0) {
+				ret = TEST_FAILED;
+				goto exit;
+			}
+		}
+	}
+
+exit:
+	rte_mempool_free(in_pool);
+	rte_mempool_free(direct_pool);
+	rte_mempool_free(indirect_pool);
+	return ret;
+}
+
+REGISTER_PERF_TEST(ipfrag_perf_autotest, test_ipfrag_perf);
@@ -25,6 +25,7 @@ test_member(void)
 #include <rte_random.h>
 #include <rte_debug.h>
 #include <rte_ip.h>
+#include <rte_vect.h>
 
 struct rte_member_setsum *setsum_ht;
 struct rte_member_setsum *setsum_cache;
@@ -951,6 +952,260 @@ test_member_sketch(void)
 	return 0;
 }
 
+/* Number of keys the single set filters (CF and BBF) are sized for */
+#define FILTER_KEYS (MAX_ENTRIES / 2)
+#define FILTER_FPR 0.01
+/* Lookup burst size, not a multiple of 2 to check the last key of SIMD lookups */
+#define FILTER_BURST 63
+
+/* Count the keys of generated_keys[first, first + num) found by bulk lookups */
+static uint32_t
+filter_lookup_bulk(const struct rte_member_setsum *setsum, uint32_t first,
+		uint32_t num, member_set_t *set_ids)
+{
+	const void *key_array[FILTER_BURST];
+	member_set_t burst_ids[FILTER_BURST];
+	uint32_t i, j, n, found = 0;
+
+	for (i = 0; i < num; i += n) {
+		n = RTE_MIN(num - i, (uint32_t)FILTER_BURST);
+		for (j = 0; j < n; j++)
+			key_array[j] = &generated_keys[first + i + j];
+		found += rte_member_lookup_bulk(setsum, key_array, n,
+				set_ids != NULL ? &set_ids[i] : burst_ids);
+	}
+	return found;
+}
+
+/*
+ * Sequence of operations for cuckoo filter
+ *
+ *  - create and add keys, which must all be found
+ *  - measure the false positive rate with keys not added
+ *  - delete keys, the other keys must still be found
+ *  - add keys until full, no key must be lost on failure
+ */
+static int
+test_member_cf(void)
+{
+	struct rte_member_setsum *setsum_cf;
+	member_set_t set_id;
+	uint32_t i, found, added;
+	double fpr;
+	int ret;
+
+	setup_keys_and_data();
+
+	params.name = "test_member_cf";
+	params.type = RTE_MEMBER_TYPE_CF;
+	params.key_len = KEY_SIZE;
+	params.num_keys = FILTER_KEYS;
+	params.false_positive_rate = FILTER_FPR;
+	params.prim_hash_seed = 1;
+	params.sec_hash_seed = 11;
+	setsum_cf = rte_member_create(&params);
+	params.num_keys = MAX_ENTRIES;
+	params.false_positive_rate = 0.03;
+	TEST_ASSERT_NOT_NULL(setsum_cf, "Creation of cuckoo filter fail");
+
+	if (rte_member_add(setsum_cf, &generated_keys[0], 2) != -EINVAL) {
+		printf("Cuckoo filter accepts set id other than 1\n");
+		goto error;
+	}
+
+	for (i = 0; i < FILTER_KEYS * 9 / 10; i++) {
+		if (rte_member_add(setsum_cf, &generated_keys[i], 1) < 0) {
+			printf("Add key %u into cuckoo filter fail\n", i);
+			goto error;
+		}
+	}
+	for (i = 0; i < FILTER_KEYS * 9 / 10; i++) {
+		if (rte_member_lookup(setsum_cf, &generated_keys[i],
+				&set_id) != 1 || set_id != 1) {
+			printf("Cuckoo filter lookup of key %u fail\n", i);
+			goto error;
+		}
+	}
+	found = filter_lookup_bulk(setsum_cf, 0, FILTER_KEYS * 9 / 10, NULL);
+	if (found != FILTER_KEYS * 9 / 10) {
+		printf("Cuckoo filter bulk lookup misses keys\n");
+		goto error;
+	}
+
+	found = filter_lookup_bulk(setsum_cf, FILTER_KEYS, FILTER_KEYS, NULL);
+	fpr = (double)found / FILTER_KEYS;
+	printf("Cuckoo filter false positive rate %.4f (target %.4f)\n",
+			fpr, FILTER_FPR);
+	if (fpr > 2 * FILTER_FPR) {
+		printf("Cuckoo filter false positive rate is too high\n");
+		goto error;
+	}
+
+	/* Delete half of the keys, the others must still be found */
+	for (i = 0; i < FILTER_KEYS * 9 / 10; i += 2) {
+		if (rte_member_delete(setsum_cf, &generated_keys[i], 1) != 0) {
+			printf("Cuckoo filter delete of key %u fail\n", i);
+			goto error;
+		}
+	}
+	for (i = 1; i < FILTER_KEYS * 9 / 10; i += 2) {
+		if (rte_member_lookup(setsum_cf, &generated_keys[i],
+				&set_id) != 1) {
+			printf("Cuckoo filter lost key %u after delete\n", i);
+			goto error;
+		}
+	}
+	found = 0;
+	for (i = 0; i < FILTER_KEYS * 9 / 10; i += 2)
+		found += rte_member_lookup(setsum_cf, &generated_keys[i],
+				&set_id);
+	if (found > FILTER_KEYS * 9 / 20 * 2 * FILTER_FPR) {
+		printf("Cuckoo filter still finds deleted keys\n");
+		goto error;
+	}
+
+	/* Fill the filter */
+	rte_member_reset(setsum_cf);
+	if (rte_member_lookup(setsum_cf, &generated_keys[1], &set_id) != 0) {
+		printf("Cuckoo filter not empty after reset\n");
+		goto error;
+	}
+	ret = 0;
+	for (added = 0; added < MAX_ENTRIES; added++) {
+		ret = rte_member_add(setsum_cf, &generated_keys[added], 1);
+		if (ret < 0)
+			break;
+	}
+	printf("Keys inserted when cuckoo filter is full = %.2f%% (%u/%u)\n",
+			(double)added / FILTER_KEYS * 100, added, FILTER_KEYS);
+	if (ret != -ENOSPC || added < FILTER_KEYS * 9 / 10) {
+		printf("Unexpected error when filling cuckoo filter\n");
+		goto error;
+	}
+	found = filter_lookup_bulk(setsum_cf, 0, added, NULL);
+	if (found != added) {
+		printf("Cuckoo filter lost keys when full\n");
+		goto error;
+	}
+
+	rte_member_free(setsum_cf);
+	printf("cuckoo filter test success\n");
+	return 0;
+error:
+	rte_member_free(setsum_cf);
+	return -1;
+}
+
+/*
+ * Sequence of operations for blocked bloom filter
+ *
+ *  - create and add keys, which must all be found
+ *  - measure the false positive rate with keys not added
+ *  - check the SIMD lookups against the scalar one
+ *  - delete is not supported, reset empties the filter
+ */
+static int
+test_member_bbf(void)
+{
+	static member_set_t simd_ids[FILTER_KEYS], scalar_ids[FILTER_KEYS];
+	struct rte_member_setsum *setsum_bbf, *setsum_scalar = NULL;
+	uint16_t simd_bitwidth;
+	member_set_t set_id;
+	uint32_t i, found;
+	double fpr;
+
+	params.name = "test_member_bbf";
+	params.type = RTE_MEMBER_TYPE_BBF;
+	params.key_len = KEY_SIZE;
+	params.num_keys = FILTER_KEYS;
+	params.false_positive_rate = FILTER_FPR;
+	params.prim_hash_seed = 1;
+	params.sec_hash_seed = 11;
+	setsum_bbf = rte_member_create(&params);
+	TEST_ASSERT_NOT_NULL(setsum_bbf, "Creation of bloom filter fail");
+
+	/* Same filter, created with the scalar lookup */
+	simd_bitwidth = rte_vect_get_max_simd_bitwidth();
+	params.name = "test_member_bbf_scalar";
+	if (rte_vect_set_max_simd_bitwidth(RTE_VECT_SIMD_DISABLED) == 0) {
+		setsum_scalar = rte_member_create(&params);
+		rte_vect_set_max_simd_bitwidth(simd_bitwidth);
+		if (setsum_scalar == NULL) {
+			printf("Creation of scalar bloom filter fail\n");
+			goto error;
+		}
+	}
+	params.num_keys = MAX_ENTRIES;
+	params.false_positive_rate = 0.03;
+
+	if (rte_member_add(setsum_bbf, &generated_keys[0], 2) != -EINVAL) {
+		printf("Bloom filter accepts set id other than 1\n");
+		goto error;
+	}
+
+	for (i = 0; i < FILTER_KEYS; i++) {
+		if (rte_member_add(setsum_bbf, &generated_keys[i], 1) != 0 ||
+				(setsum_scalar != NULL &&
+				rte_member_add(setsum_scalar,
+					&generated_keys[i], 1) != 0)) {
+			printf("Add key %u into bloom filter fail\n", i);
+			goto error;
+		}
+	}
+	for (i = 0; i < FILTER_KEYS; i++) {
+		if (rte_member_lookup(setsum_bbf, &generated_keys[i],
+				&set_id) != 1 || set_id != 1) {
+			printf("Bloom filter lookup of key %u fail\n", i);
+			goto error;
+		}
+	}
+	found = filter_lookup_bulk(setsum_bbf, 0, FILTER_KEYS, simd_ids);
+	if (found != FILTER_KEYS) {
+		printf("Bloom filter bulk lookup misses keys\n");
+		goto error;
+	}
+
+	found = filter_lookup_bulk(setsum_bbf, FILTER_KEYS, FILTER_KEYS,
+			simd_ids);
+	fpr = (double)found / FILTER_KEYS;
+	printf("Bloom filter false positive rate %.4f (target %.4f)\n",
+			fpr, FILTER_FPR);
+	if (fpr > 2 * FILTER_FPR) {
+		printf("Bloom filter false positive rate is too high\n");
+		goto error;
+	}
+
+	if (setsum_scalar != NULL) {
+		if (filter_lookup_bulk(setsum_scalar, FILTER_KEYS, FILTER_KEYS,
+				scalar_ids) != found ||
+				memcmp(simd_ids, scalar_ids,
+					sizeof(simd_ids)) != 0) {
+			printf("Bloom filter SIMD and scalar lookups differ\n");
+			goto error;
+		}
+	}
+
+	if (rte_member_delete(setsum_bbf, &generated_keys[0], 1) != -EINVAL) {
+		printf("Bloom filter delete does not fail\n");
+		goto error;
+	}
+
+	rte_member_reset(setsum_bbf);
+	if (filter_lookup_bulk(setsum_bbf, 0, FILTER_KEYS, NULL) != 0) {
+		printf("Bloom filter not empty after reset\n");
+		goto error;
+	}
+
+	rte_member_free(setsum_scalar);
+	rte_member_free(setsum_bbf);
+	printf("blocked bloom filter test success\n");
+	return 0;
+error:
+	rte_member_free(setsum_scalar);
+	rte_member_free(setsum_bbf);
+	return -1;
+}
+
 static int
 test_member(void)
 {
@@ -990,6 +1245,14 @@ test_member(void)
 		perform_free();
 		return -1;
 	}
+	if (test_member_cf() < 0) {
+		perform_free();
+		return -1;
+	}
+	if (test_member_bbf() < 0) {
+		perform_free();
+		return -1;
+	}
 	perform_free();
 	return 0;
 }
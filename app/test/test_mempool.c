@@ -225,6 +225,182 @@ static int test_mempool_creation_with_invalid_flags(void)
 	return 0;
 }
 
+#define ADAPTIVE_POOL_SIZE 16384
+#define ADAPTIVE_CACHE_SIZE 32
+#define ADAPTIVE_MIN_SIZE 16
+#define ADAPTIVE_MAX_SIZE 256
+
+/*
+ * Free objects on one lcore only, then allocate them only,
+ * and check that the cache adapts to each direction.
+ */
+static int
+test_mempool_cache_adaptive(void)
+{
+	struct rte_mempool_cache *cache;
+	struct rte_mempool *mp;
+	void **objs;
+	unsigned int i, n = ADAPTIVE_POOL_SIZE / 2;
+	int ret = -1;
+
+	objs = rte_malloc(NULL, n * sizeof(void *), 0);
+	if (objs == NULL)
+		RET_ERR();
+
+	mp = rte_mempool_create("test_cache_adaptive", ADAPTIVE_POOL_SIZE,
+		64, ADAPTIVE_CACHE_SIZE, 0, NULL, NULL, NULL, NULL,
+		SOCKET_ID_ANY, 0);
+	if (mp == NULL)
+		GOTO_ERR(ret, exit);
+	cache = rte_mempool_default_cache(mp, rte_lcore_id());
+	if (cache == NULL)
+		GOTO_ERR(ret, exit);
+
+	/* invalid bounds */
+	if (rte_mempool_cache_adaptive_set(mp, 0, ADAPTIVE_MAX_SIZE) !=
+			-EINVAL ||
+			rte_mempool_cache_adaptive_set(mp, ADAPTIVE_MAX_SIZE,
+				ADAPTIVE_MIN_SIZE) != -EINVAL ||
+			rte_mempool_cache_adaptive_set(mp, ADAPTIVE_MIN_SIZE,
+				RTE_MEMPOOL_CACHE_MAX_SIZE + 1) != -EINVAL)
+		GOTO_ERR(ret, exit);
+
+	if (rte_mempool_cache_adaptive_set(mp, ADAPTIVE_MIN_SIZE,
+			ADAPTIVE_MAX_SIZE) != 0)
+		GOTO_ERR(ret, exit);
+
+	/* free only: flush threshold grows, size shrinks */
+	if (rte_mempool_generic_get(mp, objs, n, NULL) < 0)
+		GOTO_ERR(ret, exit);
+	for (i = 0; i < n; i++)
+		rte_mempool_put(mp, objs[i]);
+	printf("cache after frees: size=%u flushthresh=%u flush_bulk=%"PRIu64"\n",
+		cache->size, cache->flushthresh, cache->flush_bulk);
+	if (cache->size != ADAPTIVE_MIN_SIZE ||
+			cache->flushthresh <= ADAPTIVE_CACHE_SIZE * 3 / 2 ||
+			cache->flush_bulk < RTE_MEMPOOL_CACHE_ADAPT_PERIOD)
+		GOTO_ERR(ret, exit);
+
+	/* allocate only: size and flush threshold grow */
+	for (i = 0; i < n; i++) {
+		if (rte_mempool_get(mp, &objs[i]) < 0)
+			GOTO_ERR(ret, exit);
+	}
+	printf("cache after allocations: size=%u flushthresh=%u refill_bulk=%"PRIu64"\n",
+		cache->size, cache->flushthresh, cache->refill_bulk);
+	if (cache->size != ADAPTIVE_MAX_SIZE ||
+			cache->flushthresh != ADAPTIVE_MAX_SIZE * 3 / 2 ||
+			cache->refill_bulk < RTE_MEMPOOL_CACHE_ADAPT_PERIOD)
+		GOTO_ERR(ret, exit);
+
+	rte_mempool_put_bulk(mp, objs, n);
+	rte_mempool_dump(stdout, mp);
+
+	/* disable, the size is restored and no object is lost */
+	if (rte_mempool_cache_adaptive_set(mp, 0, 0) != 0)
+		GOTO_ERR(ret, exit);
+	if (cache->size != ADAPTIVE_CACHE_SIZE ||
+			cache->len > cache->flushthresh ||
+			rte_mempool_avail_count(mp) != ADAPTIVE_POOL_SIZE)
+		GOTO_ERR(ret, exit);
+
+	ret = 0;
+exit:
+	rte_mempool_free(mp);
+	rte_free(objs);
+	return ret;
+}
+
+#define RETURN_POOL_SIZE 4096
+#define RETURN_CACHE_SIZE 32
+#define RETURN_CHANNEL_SIZE 512
+
+/*
+ * Free objects with the cache of another lcore, sending them to this lcore
+ * through a return channel, then allocate them with the cache of this lcore.
+ * The caches are used from this lcore only, one after the other.
+ */
+static int
+test_mempool_return_channel(void)
+{
+	struct rte_mempool_cache *cache, *other_cache;
+	struct rte_mempool *mp;
+	unsigned int i, n = RETURN_POOL_SIZE / 4;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int other_id = (lcore_id + 1) % RTE_MAX_LCORE;
+	void **objs;
+	int ret = -1;
+
+	objs = rte_malloc(NULL, n * sizeof(void *), 0);
+	if (objs == NULL)
+		RET_ERR();
+
+	mp = rte_mempool_create("test_return_channel", RETURN_POOL_SIZE,
+		64, RETURN_CACHE_SIZE, 0, NULL, NULL, NULL, NULL,
+		SOCKET_ID_ANY, 0);
+	if (mp == NULL)
+		GOTO_ERR(ret, exit);
+	cache = rte_mempool_default_cache(mp, lcore_id);
+	other_cache = rte_mempool_default_cache(mp, other_id);
+	if (cache == NULL || other_cache == NULL)
+		GOTO_ERR(ret, exit);
+
+	/* invalid channels */
+	if (rte_mempool_return_channel_add(mp, lcore_id, lcore_id,
+				RETURN_CHANNEL_SIZE) != -EINVAL ||
+			rte_mempool_return_channel_add(mp, other_id, lcore_id,
+				0) != -EINVAL ||
+			rte_mempool_return_channel_add(mp, RTE_MAX_LCORE,
+				lcore_id, RETURN_CHANNEL_SIZE) != -EINVAL)
+		GOTO_ERR(ret, exit);
+
+	if (rte_mempool_return_channel_add(mp, other_id, lcore_id,
+				RETURN_CHANNEL_SIZE) != 0 ||
+			rte_mempool_return_channel_add(mp, lcore_id, other_id,
+				RETURN_CHANNEL_SIZE) != 0)
+		GOTO_ERR(ret, exit);
+	if (rte_mempool_return_channel_add(mp, other_id, lcore_id,
+				RETURN_CHANNEL_SIZE) != -EEXIST)
+		GOTO_ERR(ret, exit);
+
+	/* the other lcore frees, filling the channel, then the backend */
+	if (rte_mempool_generic_get(mp, objs, n, NULL) < 0)
+		GOTO_ERR(ret, exit);
+	for (i = 0; i < n; i++)
+		rte_mempool_generic_put(mp, &objs[i], 1, other_cache);
+	printf("other lcore after frees: sent_objs=%"PRIu64" flush_objs=%"PRIu64"\n",
+		other_cache->returns->sent_objs, other_cache->flush_objs);
+	if (other_cache->returns->sent_objs != RETURN_CHANNEL_SIZE ||
+			other_cache->flush_bulk == 0 ||
+			rte_mempool_avail_count(mp) != RETURN_POOL_SIZE)
+		GOTO_ERR(ret, exit);
+
+	/* this lcore allocates, from the channel first */
+	for (i = 0; i < n; i++) {
+		if (rte_mempool_get(mp, &objs[i]) < 0)
+			GOTO_ERR(ret, exit);
+	}
+	printf("lcore after allocations: recv_objs=%"PRIu64" refill_objs=%"PRIu64"\n",
+		cache->returns->recv_objs, cache->refill_objs);
+	if (cache->returns->recv_objs != RETURN_CHANNEL_SIZE ||
+			rte_mempool_avail_count(mp) != RETURN_POOL_SIZE - n)
+		GOTO_ERR(ret, exit);
+
+	/* this lcore frees to the other one, no object is lost */
+	for (i = 0; i < n; i++)
+		rte_mempool_put(mp, objs[i]);
+	rte_mempool_dump(stdout, mp);
+	if (cache->returns->sent_objs == 0 ||
+			rte_mempool_avail_count(mp) != RETURN_POOL_SIZE)
+		GOTO_ERR(ret, exit);
+
+	ret = 0;
+exit:
+	rte_mempool_free(mp);
+	rte_free(objs);
+	return ret;
+}
+
 static struct rte_mempool *mp_spsc;
 static rte_spinlock_t scsp_spinlock;
 static void *scsp_obj_table[MAX_KEEP];
@@ -1078,6 +1254,12 @@ test_mempool(void)
 	if (test_mempool_creation_with_invalid_flags() < 0)
 		GOTO_ERR(ret, err);
 
+	if (test_mempool_cache_adaptive() < 0)
+		GOTO_ERR(ret, err);
+
+	if (test_mempool_return_channel() < 0)
+		GOTO_ERR(ret, err);
+
 	if (test_mempool_same_name_twice_creation() < 0)
 		GOTO_ERR(ret, err);
 
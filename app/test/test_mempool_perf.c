@@ -6,6 +6,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <inttypes.h>
 #include <stdarg.h>
@@ -23,6 +24,7 @@
 #include <rte_lcore.h>
 #include <rte_branch_prediction.h>
 #include <rte_mempool.h>
+#include <rte_ring.h>
 #include <rte_spinlock.h>
 #include <rte_malloc.h>
 #include <rte_mbuf_pool_ops.h>
@@ -559,6 +561,240 @@ do_all_mempool_perf_tests(unsigned int cores)
 	return ret;
 }
 
+/*
+ * Pipeline performance
+ * =======
+ *
+ *    Allocating cores get objects per bulk of PIPELINE_BULK, and pass them
+ *    in turn to each freeing core through a ring per pair of cores.
+ *    Freeing cores put the objects back in the pool per bulk.
+ *
+ *    This sequence is done during TIME_S seconds, on the topologies:
+ *
+ *      - 1:N, the main core allocates and the workers free
+ *      - N:1, the workers allocate and the main core frees
+ *
+ *    both without and with return channels from each freeing core
+ *    to each allocating core.
+ */
+
+#define PIPELINE_BULK 32
+#define PIPELINE_RING_SIZE 1024
+#define PIPELINE_RETURN_SIZE 1024
+#define PIPELINE_POOL_SIZE ((rte_lcore_count() * (PIPELINE_RING_SIZE + \
+		PIPELINE_RETURN_SIZE + RTE_MEMPOOL_CACHE_MAX_SIZE * 3)) - 1)
+
+/* rings to the freeing cores, or from the allocating cores */
+struct pipeline_lcore {
+	struct rte_ring *rings[RTE_MAX_LCORE];
+	unsigned int nb_rings;
+};
+
+static struct pipeline_lcore pipeline[RTE_MAX_LCORE];
+static unsigned int pipeline_nb_alloc;
+static RTE_ATOMIC(uint32_t) pipeline_alloc_done;
+
+static int
+pipeline_alloc_lcore(void *arg)
+{
+	struct rte_mempool *mp = arg;
+	unsigned int lcore_id = rte_lcore_id();
+	struct pipeline_lcore *pl = &pipeline[lcore_id];
+	void *obj_table[PIPELINE_BULK];
+	uint64_t start_cycles, time_diff = 0, hz = rte_get_timer_hz();
+	uint64_t count = 0;
+	unsigned int i = 0, n;
+
+	/* wait synchro for workers */
+	if (lcore_id != rte_get_main_lcore())
+		rte_wait_until_equal_32((uint32_t *)(uintptr_t)&synchro, 1,
+				rte_memory_order_relaxed);
+
+	start_cycles = rte_get_timer_cycles();
+
+	while (time_diff / hz < TIME_S) {
+		/* the pool may be empty for a while, with objects in flight */
+		if (rte_mempool_get_bulk(mp, obj_table, PIPELINE_BULK) == 0) {
+			n = rte_ring_sp_enqueue_burst(pl->rings[i], obj_table,
+					PIPELINE_BULK, NULL);
+			if (n < PIPELINE_BULK)
+				rte_mempool_put_bulk(mp, &obj_table[n],
+						PIPELINE_BULK - n);
+			count += n;
+			if (++i == pl->nb_rings)
+				i = 0;
+		}
+		time_diff = rte_get_timer_cycles() - start_cycles;
+	}
+
+	stats[lcore_id].enq_count = count;
+	stats[lcore_id].duration_cycles = time_diff;
+	rte_atomic_fetch_add_explicit(&pipeline_alloc_done, 1,
+			rte_memory_order_release);
+
+	return 0;
+}
+
+static int
+pipeline_free_lcore(void *arg)
+{
+	struct rte_mempool *mp = arg;
+	unsigned int lcore_id = rte_lcore_id();
+	struct pipeline_lcore *pl = &pipeline[lcore_id];
+	void *obj_table[PIPELINE_BULK];
+	unsigned int i, n;
+	bool done, empty;
+
+	/* wait synchro for workers */
+	if (lcore_id != rte_get_main_lcore())
+		rte_wait_until_equal_32((uint32_t *)(uintptr_t)&synchro, 1,
+				rte_memory_order_relaxed);
+
+	/* drain the rings until the allocating cores are done */
+	do {
+		done = rte_atomic_load_explicit(&pipeline_alloc_done,
+				rte_memory_order_acquire) == pipeline_nb_alloc;
+		empty = true;
+		for (i = 0; i < pl->nb_rings; i++) {
+			n = rte_ring_sc_dequeue_burst(pl->rings[i], obj_table,
+					PIPELINE_BULK, NULL);
+			if (n == 0)
+				continue;
+			rte_mempool_put_bulk(mp, obj_table, n);
+			empty = false;
+		}
+	} while (!done || !empty);
+
+	return 0;
+}
+
+/* launch one pipeline test on all the cores, and display the result */
+static int
+launch_pipeline(bool one_to_n, bool use_return)
+{
+	unsigned int main_lcore = rte_get_main_lcore();
+	unsigned int alloc_lcores[RTE_MAX_LCORE], free_lcores[RTE_MAX_LCORE];
+	unsigned int nb_alloc = 0, nb_free = 0;
+	unsigned int lcore_id, a, f;
+	struct rte_mempool *mp;
+	char name[RTE_RING_NAMESIZE];
+	struct rte_ring *r;
+	double hz = rte_get_timer_hz();
+	uint64_t rate;
+	int ret = -1;
+
+	if (one_to_n)
+		alloc_lcores[nb_alloc++] = main_lcore;
+	else
+		free_lcores[nb_free++] = main_lcore;
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (one_to_n)
+			free_lcores[nb_free++] = lcore_id;
+		else
+			alloc_lcores[nb_alloc++] = lcore_id;
+	}
+
+	memset(stats, 0, sizeof(stats));
+	memset(pipeline, 0, sizeof(pipeline));
+	pipeline_nb_alloc = nb_alloc;
+	rte_atomic_store_explicit(&pipeline_alloc_done, 0,
+			rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&synchro, 0, rte_memory_order_relaxed);
+
+	/* the return channels cannot be removed, use a new pool */
+	mp = rte_mempool_create("perf_test_pipeline", PIPELINE_POOL_SIZE,
+			MEMPOOL_ELT_SIZE, RTE_MEMPOOL_CACHE_MAX_SIZE, 0,
+			NULL, NULL, my_obj_init, NULL, SOCKET_ID_ANY, 0);
+	if (mp == NULL) {
+		printf("cannot allocate mempool (pipeline)\n");
+		return -1;
+	}
+
+	for (a = 0; a < nb_alloc; a++) {
+		for (f = 0; f < nb_free; f++) {
+			snprintf(name, sizeof(name), "perf_pipe_%u_%u",
+				alloc_lcores[a], free_lcores[f]);
+			r = rte_ring_create(name, PIPELINE_RING_SIZE,
+					SOCKET_ID_ANY,
+					RING_F_SP_ENQ | RING_F_SC_DEQ);
+			if (r == NULL)
+				GOTO_ERR(ret, out);
+			pipeline[alloc_lcores[a]].rings[f] = r;
+			pipeline[free_lcores[f]].rings[a] = r;
+
+			if (use_return && rte_mempool_return_channel_add(mp,
+					free_lcores[f], alloc_lcores[a],
+					PIPELINE_RETURN_SIZE) < 0)
+				GOTO_ERR(ret, out);
+		}
+	}
+	for (a = 0; a < nb_alloc; a++)
+		pipeline[alloc_lcores[a]].nb_rings = nb_free;
+	for (f = 0; f < nb_free; f++)
+		pipeline[free_lcores[f]].nb_rings = nb_alloc;
+
+	printf("mempool_autotest cache=%u alloc_cores=%u free_cores=%u "
+	       "n_bulk=%u return_channels=%d ",
+	       mp->cache_size, nb_alloc, nb_free, PIPELINE_BULK, use_return);
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id)
+		rte_eal_remote_launch(one_to_n ? pipeline_free_lcore :
+				pipeline_alloc_lcore, mp, lcore_id);
+
+	/* start synchro and launch test on main */
+	rte_atomic_store_explicit(&synchro, 1, rte_memory_order_relaxed);
+
+	ret = one_to_n ? pipeline_alloc_lcore(mp) : pipeline_free_lcore(mp);
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (rte_eal_wait_lcore(lcore_id) < 0)
+			ret = -1;
+	}
+	if (ret < 0)
+		GOTO_ERR(ret, out);
+
+	rate = 0;
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+		if (stats[lcore_id].duration_cycles != 0)
+			rate += (double)stats[lcore_id].enq_count * hz /
+					(double)stats[lcore_id].duration_cycles;
+
+	printf("rate_persec=%10" PRIu64 "\n", rate);
+
+	if (rte_mempool_avail_count(mp) != PIPELINE_POOL_SIZE) {
+		printf("mempool is not full\n");
+		GOTO_ERR(ret, out);
+	}
+
+out:
+	for (a = 0; a < nb_alloc; a++)
+		for (f = 0; f < nb_free; f++)
+			rte_ring_free(pipeline[alloc_lcores[a]].rings[f]);
+	rte_mempool_free(mp);
+	return ret;
+}
+
+static int
+do_all_mempool_pipeline_tests(bool one_to_n)
+{
+	if (rte_lcore_count() < 2) {
+		printf("not enough lcores\n");
+		return -1;
+	}
+
+	printf("start pipeline performance test (%s, without return channels)\n",
+	       one_to_n ? "1:N" : "N:1");
+	if (launch_pipeline(one_to_n, false) < 0)
+		return -1;
+
+	printf("start pipeline performance test (%s, with return channels)\n",
+	       one_to_n ? "1:N" : "N:1");
+	if (launch_pipeline(one_to_n, true) < 0)
+		return -1;
+
+	return 0;
+}
+
 static int
 test_mempool_perf_1core(void)
 {
@@ -581,6 +817,18 @@ test_mempool_perf_allcores(void)
 	return do_all_mempool_perf_tests(rte_lcore_count());
 }
 
+static int
+test_mempool_perf_1_to_n(void)
+{
+	return do_all_mempool_pipeline_tests(true);
+}
+
+static int
+test_mempool_perf_n_to_1(void)
+{
+	return do_all_mempool_pipeline_tests(false);
+}
+
 static int
 test_mempool_perf(void)
 {
@@ -594,6 +842,10 @@ test_mempool_perf(void)
 
 	if (do_all_mempool_perf_tests(2) < 0)
 		goto err;
+	if (do_all_mempool_pipeline_tests(true) < 0)
+		goto err;
+	if (do_all_mempool_pipeline_tests(false) < 0)
+		goto err;
 	if (rte_lcore_count() == 2)
 		goto done;
 
@@ -611,3 +863,5 @@ REGISTER_PERF_TEST(mempool_perf_autotest, test_mempool_perf);
 REGISTER_PERF_TEST(mempool_perf_autotest_1core, test_mempool_perf_1core);
 REGISTER_PERF_TEST(mempool_perf_autotest_2cores, test_mempool_perf_2cores);
 REGISTER_PERF_TEST(mempool_perf_autotest_allcores, test_mempool_perf_allcores);
+REGISTER_PERF_TEST(mempool_perf_autotest_1_to_n, test_mempool_perf_1_to_n);
+REGISTER_PERF_TEST(mempool_perf_autotest_n_to_1, test_mempool_perf_n_to_1);
@@ -9,6 +9,8 @@
 #include <rte_hexdump.h>
 #include <rte_ip.h>
 #include <rte_ip_frag.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
 #include <rte_mbuf.h>
 #include <rte_mbuf_pool_ops.h>
 #include <rte_os_shim.h>
@@ -842,6 +844,298 @@ ipv6_reassembly_interleaved_flows_perf(int8_t nb_frags)
 	return TEST_SUCCESS;
 }
 
+/*
+ * Bulk test, where the fragments of all the flows are outstanding: the
+ * first fragment of each flow is added, then the second one...
+ */
+#define BULK_BURST 32
+
+static struct rte_mbuf *bulk_frags[MAX_PKTS];
+
+static uint16_t
+bulk_reassemble_burst(struct rte_ip_frag_death_row *dr, struct rte_mbuf **buf,
+		      uint16_t nb_buf, uint64_t tstamp, uint8_t ipv6,
+		      uint8_t bulk)
+{
+	struct rte_mbuf *buf_out;
+	uint16_t i, nb_out = 0;
+
+	if (bulk && ipv6)
+		return rte_ipv6_frag_reassemble_bulk(frag_tbl, dr, buf, nb_buf,
+						     tstamp, buf);
+	if (bulk)
+		return rte_ipv4_frag_reassemble_bulk(frag_tbl, dr, buf, nb_buf,
+						     tstamp, buf);
+
+	for (i = 0; i < nb_buf; i++) {
+		if (ipv6) {
+			struct rte_ipv6_hdr *ip_hdr = rte_pktmbuf_mtod_offset(
+				buf[i], struct rte_ipv6_hdr *, buf[i]->l2_len);
+
+			buf_out = rte_ipv6_frag_reassemble_packet(
+				frag_tbl, dr, buf[i], tstamp, ip_hdr,
+				(struct ipv6_extension_fragment *)(ip_hdr + 1));
+		} else {
+			struct rte_ipv4_hdr *ip_hdr = rte_pktmbuf_mtod_offset(
+				buf[i], struct rte_ipv4_hdr *, buf[i]->l2_len);
+
+			buf_out = rte_ipv4_frag_reassemble_packet(
+				frag_tbl, dr, buf[i], tstamp, ip_hdr);
+		}
+		if (buf_out != NULL)
+			buf[nb_out++] = buf_out;
+	}
+
+	return nb_out;
+}
+
+static int
+bulk_reassembly_perf(int8_t nb_frags, uint8_t ipv6, uint8_t bulk)
+{
+	struct rte_ip_frag_death_row death_row;
+	uint64_t tstamp, cycles = 0;
+	uint32_t i, j, n, nb_out = 0;
+	uint16_t k, out;
+	int rc;
+
+	if (ipv6)
+		rc = ipv6_frag_pkt_setup(FILL_MODE_LINEAR, nb_frags);
+	else
+		rc = ipv4_frag_pkt_setup(FILL_MODE_LINEAR, nb_frags);
+	if (rc)
+		return rc;
+
+	n = 0;
+	for (j = 0; j < (uint32_t)nb_frags; j++)
+		for (i = 0; i < flow_cnt; i++)
+			bulk_frags[n++] = mbufs[i][j];
+	memset(mbufs, 0, sizeof(mbufs));
+
+	death_row.cnt = 0;
+	tstamp = rte_rdtsc_precise();
+	for (i = 0; i < n; i += k) {
+		k = RTE_MIN(n - i, (uint32_t)BULK_BURST);
+		cycles -= rte_rdtsc_precise();
+		out = bulk_reassemble_burst(&death_row, &bulk_frags[i], k,
+					    tstamp, ipv6, bulk);
+		cycles += rte_rdtsc_precise();
+		rte_pktmbuf_free_bulk(&bulk_frags[i], out);
+		nb_out += out;
+		if (death_row.cnt != 0)
+			return TEST_FAILED;
+	}
+
+	if (nb_out != flow_cnt)
+		return TEST_FAILED;
+
+	printf("| %-14s | %-14d | %-11s | %-22" PRIu64 " |\n",
+	       ipv6 ? "IPV6" : "IPV4", nb_frags, bulk ? "BULK" : "SINGLE",
+	       cycles / n);
+
+	return TEST_SUCCESS;
+}
+
+static int
+bulk_reassembly_test(void)
+{
+	int8_t nb_fragments[] = {2, 3, MAX_FRAGMENTS};
+	uint8_t ipv6, bulk;
+	uint32_t i;
+	int rc;
+
+	printf("+================+================+=============+"
+	       "========================+\n");
+	printf("%-17s%-17s%-14s%-25s\n", "| Outstanding", "| Fragments/Flow",
+	       "| API", "| Cycles/Fragment insert |");
+	printf("+================+================+=============+"
+	       "========================+\n");
+
+	for (ipv6 = 0; ipv6 <= 1; ipv6++) {
+		for (i = 0; i < RTE_DIM(nb_fragments); i++) {
+			for (bulk = 0; bulk <= 1; bulk++) {
+				rc = bulk_reassembly_perf(nb_fragments[i], ipv6,
+							  bulk);
+				if (rc)
+					return rc;
+			}
+		}
+	}
+
+	return TEST_SUCCESS;
+}
+
+/* Shared table test, where the fragments of each flow are spread over lcores. */
+#define SHARED_BKTS (MAX_FLOWS / 8)
+
+struct shared_reassembly_arg {
+	uint32_t idx;
+	uint32_t nb_lcores;
+	uint8_t ipv6;
+	uint32_t nb_out;
+	uint64_t nb_frags;
+	uint64_t cycles;
+	uint32_t dr_cnt;
+};
+
+static struct rte_ip_frag_shared_tbl *shared_tbl;
+static struct rte_mbuf *shared_out[MAX_FLOWS];
+static struct shared_reassembly_arg shared_args[RTE_MAX_LCORE];
+static RTE_ATOMIC(uint32_t) shared_start;
+
+static int
+shared_reassembly_worker(void *p)
+{
+	struct shared_reassembly_arg *arg = p;
+	struct rte_ip_frag_death_row death_row;
+	struct rte_mbuf *buf, *buf_out;
+	uint64_t tstamp;
+	uint32_t i, j;
+
+	death_row.cnt = 0;
+	while (rte_atomic_load_explicit(&shared_start,
+			rte_memory_order_acquire) == 0)
+		rte_pause();
+
+	tstamp = rte_rdtsc_precise();
+	for (i = 0; i < flow_cnt; i++) {
+		for (j = 0; j < frag_per_flow[i]; j++) {
+			if ((i + j) % arg->nb_lcores != arg->idx)
+				continue;
+
+			buf = mbufs[i][j];
+			if (arg->ipv6) {
+				struct rte_ipv6_hdr *ip_hdr =
+					rte_pktmbuf_mtod_offset(buf,
+						struct rte_ipv6_hdr *,
+						buf->l2_len);
+
+				buf_out = rte_ipv6_frag_shared_reassemble_packet(
+					shared_tbl, &death_row, buf, tstamp,
+					ip_hdr, (struct ipv6_extension_fragment *)
+					(ip_hdr + 1));
+			} else {
+				struct rte_ipv4_hdr *ip_hdr =
+					rte_pktmbuf_mtod_offset(buf,
+						struct rte_ipv4_hdr *,
+						buf->l2_len);
+
+				buf_out = rte_ipv4_frag_shared_reassemble_packet(
+					shared_tbl, &death_row, buf, tstamp,
+					ip_hdr);
+			}
+
+			arg->nb_frags++;
+			if (buf_out != NULL) {
+				shared_out[i] = buf_out;
+				arg->nb_out++;
+			}
+		}
+	}
+	arg->cycles = rte_rdtsc_precise() - tstamp;
+	arg->dr_cnt = death_row.cnt;
+
+	return 0;
+}
+
+static int
+shared_reassembly_run(int8_t nb_frags, uint8_t ipv6, uint32_t nb_lcores)
+{
+	uint64_t nb_frags_total = 0, cycles = 0, max_cycles = 0;
+	uint32_t i, n, lcore_id, nb_out = 0;
+	int rc;
+
+	if (ipv6)
+		rc = ipv6_frag_pkt_setup(FILL_MODE_LINEAR, nb_frags);
+	else
+		rc = ipv4_frag_pkt_setup(FILL_MODE_LINEAR, nb_frags);
+	if (rc)
+		return rc;
+
+	memset(shared_args, 0, sizeof(shared_args));
+	for (i = 0; i < nb_lcores; i++) {
+		shared_args[i].idx = i;
+		shared_args[i].nb_lcores = nb_lcores;
+		shared_args[i].ipv6 = ipv6;
+	}
+
+	rte_atomic_store_explicit(&shared_start, 0, rte_memory_order_relaxed);
+	n = 1;
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (n == nb_lcores)
+			break;
+		rte_eal_remote_launch(shared_reassembly_worker,
+				      &shared_args[n++], lcore_id);
+	}
+	rte_atomic_store_explicit(&shared_start, 1, rte_memory_order_release);
+	shared_reassembly_worker(&shared_args[0]);
+	rte_eal_mp_wait_lcore();
+
+	for (i = 0; i < nb_lcores; i++) {
+		if (shared_args[i].dr_cnt != 0)
+			return TEST_FAILED;
+		nb_out += shared_args[i].nb_out;
+		nb_frags_total += shared_args[i].nb_frags;
+		cycles += shared_args[i].cycles;
+		max_cycles = RTE_MAX(max_cycles, shared_args[i].cycles);
+	}
+
+	if (nb_out != flow_cnt)
+		return TEST_FAILED;
+	for (i = 0; i < flow_cnt; i++) {
+		if (shared_out[i]->nb_segs != frag_per_flow[i])
+			return TEST_FAILED;
+		memset(mbufs[i], 0, sizeof(struct rte_mbuf *) * MAX_FRAGMENTS);
+		mbufs[i][0] = shared_out[i];
+	}
+	frag_pkt_teardown();
+
+	printf("| %-14s | %-14d | %-11u | %-22" PRIu64 " | %-17.2f |\n",
+	       ipv6 ? "IPV6" : "IPV4", nb_frags, nb_lcores,
+	       cycles / nb_frags_total,
+	       (double)nb_frags_total * rte_get_tsc_hz() / max_cycles / 1E6);
+
+	return TEST_SUCCESS;
+}
+
+static int
+shared_reassembly_perf(void)
+{
+	int8_t nb_fragments[] = {2, 3, MAX_FRAGMENTS};
+	uint64_t max_ttl_cyc = (MAX_TTL_MS * rte_get_timer_hz()) / 1E3;
+	uint32_t i, nb_lcores;
+	uint8_t ipv6;
+	int rc = TEST_SUCCESS;
+
+	shared_tbl = rte_ip_frag_shared_table_create(SHARED_BKTS,
+		MAX_ENTRIES_PER_BKT, SHARED_BKTS * MAX_ENTRIES_PER_BKT,
+		max_ttl_cyc, rte_socket_id());
+	if (shared_tbl == NULL)
+		return TEST_FAILED;
+
+	printf("+================+================+=============+"
+	       "========================+===================+\n");
+	printf("%-17s%-17s%-14s%-25s%-20s\n", "| Shared Table",
+	       "| Fragments/Flow", "| Lcores", "| Cycles/Fragment insert",
+	       "| Mfragments/s      |");
+	printf("+================+================+=============+"
+	       "========================+===================+\n");
+
+	for (ipv6 = 0; ipv6 <= 1 && rc == TEST_SUCCESS; ipv6++) {
+		for (i = 0; i < RTE_DIM(nb_fragments) && rc == TEST_SUCCESS;
+		     i++) {
+			for (nb_lcores = 1; nb_lcores <= rte_lcore_count() &&
+			     rc == TEST_SUCCESS; nb_lcores *= 2)
+				rc = shared_reassembly_run(nb_fragments[i],
+							   ipv6, nb_lcores);
+		}
+	}
+
+	rte_ip_frag_shared_table_destroy(shared_tbl);
+	shared_tbl = NULL;
+
+	return rc;
+}
+
 static int
 ipv4_reassembly_test(int8_t nb_frags, uint8_t fill_order, uint32_t outstanding)
 {
@@ -969,6 +1263,17 @@ test_reassembly_perf(void)
 		if (rc)
 			return rc;
 	}
+
+	printf("\n");
+	rc = bulk_reassembly_test();
+	if (rc)
+		return rc;
+
+	printf("\n");
+	rc = shared_reassembly_perf();
+	if (rc)
+		return rc;
+
 	reassembly_test_teardown();
 
 	return TEST_SUCCESS;
@@ -214,6 +214,62 @@ test_reorder_insert(void)
 	return ret;
 }
 
+static int
+test_reorder_insert_burst(void)
+{
+	/* 9 moves the window, and 100 is out of range */
+	static const rte_reorder_seqn_t seqn[] = { 3, 1, 0, 2, 9, 5, 4, 100, 6 };
+	struct rte_reorder_buffer *b = NULL;
+	struct rte_mempool *p = test_params->p;
+	const unsigned int size = 8;
+	struct rte_mbuf *bufs[RTE_DIM(seqn)];
+	struct rte_mbuf *robufs[RTE_DIM(seqn)];
+	unsigned int i, n;
+	int ret = -1;
+
+	b = rte_reorder_create("test_insert_burst", rte_socket_id(), size);
+	TEST_ASSERT_NOT_NULL(b, "Failed to create reorder buffer");
+	rte_reorder_min_seqn_set(b, 0);
+
+	for (i = 0; i < RTE_DIM(seqn); i++) {
+		bufs[i] = rte_pktmbuf_alloc(p);
+		if (bufs[i] == NULL) {
+			printf("Packet allocation failed\n");
+			rte_pktmbuf_free_bulk(bufs, i);
+			goto exit;
+		}
+		*rte_reorder_seqn(bufs[i]) = seqn[i];
+	}
+
+	/* the rejected packets are written in place */
+	n = rte_reorder_insert_burst(b, bufs, RTE_DIM(seqn), bufs);
+	if (n != RTE_DIM(seqn) - 1 || rte_errno != ERANGE ||
+			*rte_reorder_seqn(bufs[0]) != 100) {
+		printf("%s:%d: Error in burst insertion\n", __func__, __LINE__);
+		goto exit;
+	}
+	rte_pktmbuf_free(bufs[0]);
+
+	/* 7 and 8 are missing */
+	n = rte_reorder_drain(b, robufs, RTE_DIM(robufs));
+	for (i = 0; i < n; i++) {
+		if (*rte_reorder_seqn(robufs[i]) != i)
+			break;
+	}
+	rte_pktmbuf_free_bulk(robufs, n);
+	if (n != 7 || i != n) {
+		printf("%s:%d: Error draining packets\n", __func__, __LINE__);
+		goto exit;
+	}
+
+	ret = 0;
+exit:
+	/* the buffer frees the packet 9 */
+	rte_reorder_free(b);
+
+	return ret;
+}
+
 static int
 test_reorder_drain(void)
 {
@@ -489,6 +545,236 @@ test_reorder_set_seqn(void)
 	return ret;
 }
 
+static int
+test_reorder_multi_create(void)
+{
+	struct rte_reorder_multi_params params = {
+		.socket_id = rte_socket_id(),
+		.nb_streams = 1024,
+		.window = 32,
+		.nb_blocks = 64,
+	};
+	struct rte_reorder_multi *m;
+
+	m = rte_reorder_multi_create(NULL);
+	TEST_ASSERT((m == NULL) && (rte_errno == EINVAL),
+			"No error on multi create with NULL params");
+
+	params.window = 24;
+	m = rte_reorder_multi_create(&params);
+	TEST_ASSERT((m == NULL) && (rte_errno == EINVAL),
+			"No error on multi create with invalid window");
+
+	params.window = 2 * RTE_REORDER_MULTI_MAX_WINDOW;
+	m = rte_reorder_multi_create(&params);
+	TEST_ASSERT((m == NULL) && (rte_errno == EINVAL),
+			"No error on multi create with too large window");
+
+	params.window = 32;
+	params.nb_streams = 0;
+	m = rte_reorder_multi_create(&params);
+	TEST_ASSERT((m == NULL) && (rte_errno == EINVAL),
+			"No error on multi create without stream");
+
+	params.nb_streams = 1024;
+	m = rte_reorder_multi_create(&params);
+	TEST_ASSERT_NOT_NULL(m, "Failed to create multi-stream reorder buffer");
+	rte_reorder_multi_free(m);
+
+	/* free of NULL should be a no-op */
+	rte_reorder_multi_free(NULL);
+
+	return 0;
+}
+
+static struct rte_mbuf *
+test_reorder_multi_pkt(rte_reorder_seqn_t seqn)
+{
+	struct rte_mbuf *mbuf = rte_pktmbuf_alloc(test_params->p);
+
+	if (mbuf != NULL)
+		*rte_reorder_seqn(mbuf) = seqn;
+	return mbuf;
+}
+
+/* Check the sequence numbers of n packets, and free them. */
+static int
+test_reorder_multi_check(struct rte_mbuf **mbufs, unsigned int n,
+		const rte_reorder_seqn_t *seqn, unsigned int nb_seqn)
+{
+	unsigned int i;
+	int ret = 0;
+
+	if (n != nb_seqn) {
+		printf("%s: %u packets instead of %u\n", __func__, n, nb_seqn);
+		ret = -1;
+	}
+	for (i = 0; i < n; i++) {
+		if (ret == 0 && *rte_reorder_seqn(mbufs[i]) != seqn[i]) {
+			printf("%s: packet %u has seqn %u instead of %u\n",
+				__func__, i, *rte_reorder_seqn(mbufs[i]), seqn[i]);
+			ret = -1;
+		}
+		rte_pktmbuf_free(mbufs[i]);
+	}
+
+	return ret;
+}
+
+static int
+test_reorder_multi_insert_drain(void)
+{
+	static const uint32_t burst_ids[] = { 0, 0, 1, 0, 1, 2, 0, 0 };
+	static const rte_reorder_seqn_t burst_seqn[] = {
+		10, 12, 100, 11, 101, 5, 12, 18
+	};
+	static const rte_reorder_seqn_t wrap_seqn[] = {
+		UINT32_MAX - 1, UINT32_MAX, 0, 1
+	};
+	const struct rte_reorder_multi_params params = {
+		.socket_id = rte_socket_id(),
+		.nb_streams = 4,
+		.window = 8,
+		.nb_blocks = 2,
+	};
+	struct rte_mempool *p = test_params->p;
+	struct rte_mbuf *mbufs[RTE_DIM(burst_seqn)];
+	struct rte_mbuf *out[RTE_DIM(burst_seqn)];
+	uint32_t ids[RTE_DIM(burst_seqn)];
+	struct rte_reorder_multi *m;
+	unsigned int avail, i, n;
+	int ret = -1;
+
+	avail = rte_mempool_avail_count(p);
+	m = rte_reorder_multi_create(&params);
+	TEST_ASSERT_NOT_NULL(m, "Failed to create multi-stream reorder buffer");
+
+	for (i = 0; i < RTE_DIM(burst_seqn); i++) {
+		mbufs[i] = test_reorder_multi_pkt(burst_seqn[i]);
+		if (mbufs[i] == NULL) {
+			printf("Packet allocation failed\n");
+			rte_pktmbuf_free_bulk(mbufs, i);
+			goto exit;
+		}
+	}
+
+	/*
+	 * Streams 0 and 1 take the two blocks, so that the packet of stream 2
+	 * is rejected, as well as the duplicate 12 and the out of window 18.
+	 */
+	n = rte_reorder_multi_insert_burst(m, burst_ids, mbufs,
+			RTE_DIM(burst_seqn), out);
+	if (n != RTE_DIM(burst_seqn) - 3 ||
+			test_reorder_multi_check(out, 3,
+				(const rte_reorder_seqn_t[]){ 5, 12, 18 }, 3) < 0) {
+		printf("%s:%d: Error in burst insertion\n", __func__, __LINE__);
+		goto exit;
+	}
+
+	n = rte_reorder_multi_drain(m, 1, out, RTE_DIM(out));
+	if (test_reorder_multi_check(out, n,
+			(const rte_reorder_seqn_t[]){ 100, 101 }, 2) < 0)
+		goto exit;
+	n = rte_reorder_multi_drain(m, 0, out, 2);
+	if (test_reorder_multi_check(out, n,
+			(const rte_reorder_seqn_t[]){ 10, 11 }, 2) < 0)
+		goto exit;
+	n = rte_reorder_multi_drain(m, 0, out, RTE_DIM(out));
+	if (test_reorder_multi_check(out, n,
+			(const rte_reorder_seqn_t[]){ 12 }, 1) < 0)
+		goto exit;
+
+	/* 13 is missing: nothing to drain until the stream is flushed */
+	ids[0] = ids[1] = 0;
+	mbufs[0] = test_reorder_multi_pkt(15);
+	mbufs[1] = test_reorder_multi_pkt(14);
+	if (mbufs[0] == NULL || mbufs[1] == NULL ||
+			rte_reorder_multi_insert_burst(m, ids, mbufs, 2, out) != 2) {
+		printf("%s:%d: Error inserting packets\n", __func__, __LINE__);
+		rte_pktmbuf_free(mbufs[0]);
+		rte_pktmbuf_free(mbufs[1]);
+		goto exit;
+	}
+	if (rte_reorder_multi_drain(m, 0, out, RTE_DIM(out)) != 0) {
+		printf("%s:%d: Drained packet after a gap\n", __func__, __LINE__);
+		goto exit;
+	}
+	n = rte_reorder_multi_flush(m, 0, out, RTE_DIM(out));
+	if (test_reorder_multi_check(out, n,
+			(const rte_reorder_seqn_t[]){ 14, 15 }, 2) < 0)
+		goto exit;
+
+	/* late 13 is rejected, far ahead 1000 moves the empty stream window */
+	mbufs[0] = test_reorder_multi_pkt(13);
+	mbufs[1] = test_reorder_multi_pkt(1000);
+	if (mbufs[0] == NULL || mbufs[1] == NULL ||
+			rte_reorder_multi_insert_burst(m, ids, mbufs, 2,
+				mbufs) != 1 ||
+			*rte_reorder_seqn(mbufs[0]) != 13) {
+		printf("%s:%d: Error inserting packets\n", __func__, __LINE__);
+		rte_pktmbuf_free(mbufs[0]);
+		rte_pktmbuf_free(mbufs[1]);
+		goto exit;
+	}
+	rte_pktmbuf_free(mbufs[0]);
+	n = rte_reorder_multi_drain(m, 0, out, RTE_DIM(out));
+	if (test_reorder_multi_check(out, n,
+			(const rte_reorder_seqn_t[]){ 1000 }, 1) < 0)
+		goto exit;
+
+	/* sequence number wrapping, starting the window of stream 3 before */
+	ids[0] = 3;
+	mbufs[0] = test_reorder_multi_pkt(UINT32_MAX - 2);
+	if (mbufs[0] == NULL ||
+			rte_reorder_multi_insert_burst(m, ids, mbufs, 1, out) != 1) {
+		printf("%s:%d: Error inserting packets\n", __func__, __LINE__);
+		rte_pktmbuf_free(mbufs[0]);
+		goto exit;
+	}
+	n = rte_reorder_multi_drain(m, 3, out, RTE_DIM(out));
+	if (test_reorder_multi_check(out, n,
+			(const rte_reorder_seqn_t[]){ UINT32_MAX - 2 }, 1) < 0)
+		goto exit;
+	for (i = 0; i < RTE_DIM(wrap_seqn); i++) {
+		ids[i] = 3;
+		mbufs[i] = test_reorder_multi_pkt(
+				wrap_seqn[RTE_DIM(wrap_seqn) - 1 - i]);
+		if (mbufs[i] == NULL) {
+			printf("Packet allocation failed\n");
+			rte_pktmbuf_free_bulk(mbufs, i);
+			goto exit;
+		}
+	}
+	if (rte_reorder_multi_insert_burst(m, ids, mbufs, RTE_DIM(wrap_seqn),
+			out) != RTE_DIM(wrap_seqn)) {
+		printf("%s:%d: Error inserting packets\n", __func__, __LINE__);
+		goto exit;
+	}
+	n = rte_reorder_multi_drain(m, 3, out, RTE_DIM(out));
+	if (test_reorder_multi_check(out, n, wrap_seqn, RTE_DIM(wrap_seqn)) < 0)
+		goto exit;
+
+	/* packets left in the buffer are freed with it */
+	mbufs[0] = test_reorder_multi_pkt(5);
+	ids[0] = 2;
+	if (mbufs[0] == NULL ||
+			rte_reorder_multi_insert_burst(m, ids, mbufs, 1, out) != 1) {
+		printf("%s:%d: Error inserting packets\n", __func__, __LINE__);
+		rte_pktmbuf_free(mbufs[0]);
+		goto exit;
+	}
+
+	ret = 0;
+exit:
+	rte_reorder_multi_free(m);
+	if (ret == 0 && rte_mempool_avail_count(p) != avail) {
+		printf("%s: %u packets leaked\n", __func__,
+			avail - rte_mempool_avail_count(p));
+		ret = -1;
+	}
+	return ret;
+}
+
 static int
 test_setup(void)
 {
@@ -538,9 +824,12 @@ static struct unit_test_suite reorder_test_suite  = {
 		TEST_CASE(test_reorder_find_existing),
 		TEST_CASE(test_reorder_free),
 		TEST_CASE(test_reorder_insert),
+		TEST_CASE(test_reorder_insert_burst),
 		TEST_CASE(test_reorder_drain),
 		TEST_CASE(test_reorder_drain_up_to_seqn),
 		TEST_CASE(test_reorder_set_seqn),
+		TEST_CASE(test_reorder_multi_create),
+		TEST_CASE(test_reorder_multi_insert_drain),
 		TEST_CASES_END()
 	}
 };
@@ -0,0 +1,130 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdio.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_reorder.h>
+
+#include "test.h"
+
+#define REORDER_PERF_BURST 32
+#define REORDER_PERF_SIZE 1024
+#define REORDER_PERF_ITERATIONS 100000
+
+static struct rte_mempool *pool;
+static struct rte_mbuf *pkts[REORDER_PERF_BURST];
+
+/*
+ * Sequence number offsets of the packets of a burst, as they come out
+ * of a parallel stage: pairs are swapped, and some packets are late.
+ */
+static uint32_t burst_order[REORDER_PERF_BURST];
+
+static void
+reorder_perf_init_order(void)
+{
+	uint32_t i, tmp;
+
+	for (i = 0; i < REORDER_PERF_BURST; i++)
+		burst_order[i] = i ^ 1;
+	for (i = 0; i + 8 < REORDER_PERF_BURST; i += 8) {
+		tmp = burst_order[i];
+		burst_order[i] = burst_order[i + 8];
+		burst_order[i + 8] = tmp;
+	}
+}
+
+static int
+reorder_perf_run(const char *mode, int burst)
+{
+	struct rte_mbuf *out[REORDER_PERF_BURST];
+	struct rte_reorder_buffer *b;
+	uint64_t tsc, insert_cycles = 0, drain_cycles = 0;
+	uint32_t i, j, n, seqn = 0;
+	int ret = -1;
+
+	b = rte_reorder_create("reorder_perf", rte_socket_id(),
+			REORDER_PERF_SIZE);
+	if (b == NULL) {
+		printf("Failed to create reorder buffer\n");
+		return -1;
+	}
+	rte_reorder_min_seqn_set(b, seqn);
+
+	for (i = 0; i < REORDER_PERF_ITERATIONS; i++) {
+		for (j = 0; j < REORDER_PERF_BURST; j++)
+			*rte_reorder_seqn(pkts[j]) = seqn + burst_order[j];
+		seqn += REORDER_PERF_BURST;
+
+		tsc = rte_rdtsc_precise();
+		if (burst) {
+			n = rte_reorder_insert_burst(b, pkts,
+					REORDER_PERF_BURST, out);
+		} else {
+			for (j = 0, n = 0; j < REORDER_PERF_BURST; j++)
+				n += rte_reorder_insert(b, pkts[j]) == 0;
+		}
+		insert_cycles += rte_rdtsc_precise() - tsc;
+		if (n != REORDER_PERF_BURST) {
+			printf("%s: %u packets inserted\n", mode, n);
+			goto exit;
+		}
+
+		tsc = rte_rdtsc_precise();
+		n = rte_reorder_drain(b, out, REORDER_PERF_BURST);
+		drain_cycles += rte_rdtsc_precise() - tsc;
+		if (n != REORDER_PERF_BURST ||
+				*rte_reorder_seqn(out[0]) != seqn - REORDER_PERF_BURST ||
+				*rte_reorder_seqn(out[n - 1]) != seqn - 1) {
+			printf("%s: %u packets drained out of order\n", mode, n);
+			goto exit;
+		}
+	}
+
+	printf("%-8s %14.1f %14.1f\n", mode,
+		(double)insert_cycles / (REORDER_PERF_ITERATIONS * REORDER_PERF_BURST),
+		(double)drain_cycles / (REORDER_PERF_ITERATIONS * REORDER_PERF_BURST));
+	ret = 0;
+exit:
+	/* on error, the buffer may free some packets */
+	rte_reorder_free(b);
+	return ret;
+}
+
+static int
+test_reorder_perf(void)
+{
+	int ret = TEST_FAILED;
+
+	pool = rte_pktmbuf_pool_create("reorder_perf", 2 * REORDER_PERF_BURST,
+			0, 0, RTE_MBUF_DEFAULT_BUF_SIZE, rte_socket_id());
+	if (pool == NULL) {
+		printf("Failed to create mbuf pool\n");
+		return TEST_FAILED;
+	}
+	if (rte_pktmbuf_alloc_bulk(pool, pkts, REORDER_PERF_BURST) != 0) {
+		printf("Failed to allocate packets\n");
+		goto exit;
+	}
+	reorder_perf_init_order();
+
+	printf("### Reorder of %u packet bursts, buffer of %u ###\n",
+		REORDER_PERF_BURST, REORDER_PERF_SIZE);
+	printf("%-8s %14s %14s\n", "Insert", "Insert cycles", "Drain cycles");
+	if (reorder_perf_run("single", 0) == 0 &&
+			reorder_perf_run("burst", 1) == 0) {
+		rte_pktmbuf_free_bulk(pkts, REORDER_PERF_BURST);
+		ret = TEST_SUCCESS;
+	}
+
+exit:
+	rte_mempool_free(pool);
+	return ret;
+}
+
+REGISTER_PERF_TEST(reorder_perf_autotest, test_reorder_perf);
@@ -9,7 +9,13 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include <rte_errno.h>
 #include <rte_ip.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_random.h>
+#include <rte_rcu_qsbr.h>
 #include <rte_rib.h>
 
 typedef int32_t (*rte_rib_test)(void);
@@ -21,6 +27,10 @@ static int32_t test_insert_invalid(void);
 static int32_t test_get_fn(void);
 static int32_t test_basic(void);
 static int32_t test_tree_traversal(void);
+static int32_t test_insert_bulk(void);
+static int32_t test_rcu_qsbr_add(void);
+static int32_t test_rcu_qsbr_reclaim(void);
+static int32_t test_rcu_qsbr_walk(void);
 
 #define MAX_DEPTH 32
 #define MAX_RULES (1 << 22)
@@ -323,6 +333,431 @@ test_tree_traversal(void)
 	return TEST_SUCCESS;
 }
 
+/* number of routes in the RIB, found by a full walk */
+static uint32_t
+count_routes(struct rte_rib *rib)
+{
+	struct rte_rib_node *node = NULL;
+	uint32_t n = 0;
+
+	while ((node = rte_rib_get_nxt(rib, 0, 0, node,
+			RTE_RIB_GET_NXT_ALL)) != NULL)
+		n++;
+	return n;
+}
+
+#define BULK_ROUTES	1000
+
+/*
+ * Check that rte_rib_insert_bulk gives the same RIB as inserting
+ * the routes one by one, and that a failed bulk insert
+ * leaves the RIB untouched.
+ */
+int32_t
+test_insert_bulk(void)
+{
+	struct rte_rib *rib, *ref;
+	struct rte_rib_node *node, *ref_node;
+	struct rte_rib_conf config;
+	static uint32_t ips[BULK_ROUTES];
+	static uint8_t depths[BULK_ROUTES];
+	static uint64_t nhs[BULK_ROUTES];
+	uint32_t ip, ref_ip, routes;
+	uint64_t nh, ref_nh;
+	uint8_t depth, ref_depth;
+	unsigned int i, n;
+	int ret;
+
+	config.max_nodes = 4 * BULK_ROUTES;
+	config.ext_sz = 0;
+
+	rib = rte_rib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(rib != NULL, "Failed to create RIB\n");
+	ref = rte_rib_create("ref", SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(ref != NULL, "Failed to create RIB\n");
+
+	ret = rte_rib_insert_bulk(NULL, ips, depths, nhs, 1);
+	RTE_TEST_ASSERT(ret < 0, "Call succeeded with invalid parameters\n");
+	depths[0] = MAX_DEPTH + 1;
+	ret = rte_rib_insert_bulk(rib, ips, depths, nhs, 1);
+	RTE_TEST_ASSERT(ret < 0, "Call succeeded with invalid parameters\n");
+
+	/* half of the routes are added one by one, half in bulk */
+	for (i = 0, n = 0; i < BULK_ROUTES; i++) {
+		ip = rte_rand();
+		depth = rte_rand_max(MAX_DEPTH) + 1;
+		ref_node = rte_rib_insert(ref, ip, depth);
+		if (ref_node == NULL)
+			continue;
+		rte_rib_set_nh(ref_node, i);
+		if (i % 2 == 0) {
+			node = rte_rib_insert(rib, ip, depth);
+			RTE_TEST_ASSERT(node != NULL, "Failed to insert rule\n");
+			rte_rib_set_nh(node, i);
+		} else {
+			ips[n] = ip;
+			depths[n] = depth;
+			nhs[n] = i;
+			n++;
+		}
+	}
+
+	/* the last route is already in the RIB */
+	node = rte_rib_get_nxt(rib, 0, 0, NULL, RTE_RIB_GET_NXT_ALL);
+	RTE_TEST_ASSERT(node != NULL, "Failed to get rib_node\n");
+	rte_rib_get_ip(node, &ips[n]);
+	rte_rib_get_depth(node, &depths[n]);
+	routes = count_routes(rib);
+	ret = rte_rib_insert_bulk(rib, ips, depths, nhs, n + 1);
+	RTE_TEST_ASSERT(ret < 0 && rte_errno == EEXIST,
+		"Bulk insert of an existing route succeeded\n");
+	RTE_TEST_ASSERT(count_routes(rib) == routes,
+		"Failed bulk insert changed the RIB\n");
+
+	/* the last route is in the bulk twice */
+	ips[n] = ips[0];
+	depths[n] = depths[0];
+	ret = rte_rib_insert_bulk(rib, ips, depths, nhs, n + 1);
+	RTE_TEST_ASSERT(ret < 0 && rte_errno == EEXIST,
+		"Bulk insert of a duplicated route succeeded\n");
+	RTE_TEST_ASSERT(count_routes(rib) == routes,
+		"Failed bulk insert changed the RIB\n");
+
+	ret = rte_rib_insert_bulk(rib, ips, depths, nhs, n);
+	RTE_TEST_ASSERT(ret == 0, "Failed to insert rules in bulk\n");
+
+	/* both RIBs hold the same routes in the same order */
+	node = NULL;
+	ref_node = NULL;
+	do {
+		node = rte_rib_get_nxt(rib, 0, 0, node, RTE_RIB_GET_NXT_ALL);
+		ref_node = rte_rib_get_nxt(ref, 0, 0, ref_node,
+			RTE_RIB_GET_NXT_ALL);
+		RTE_TEST_ASSERT((node == NULL) == (ref_node == NULL),
+			"Wrong number of routes\n");
+		if (node == NULL)
+			break;
+		rte_rib_get_ip(node, &ip);
+		rte_rib_get_ip(ref_node, &ref_ip);
+		rte_rib_get_depth(node, &depth);
+		rte_rib_get_depth(ref_node, &ref_depth);
+		rte_rib_get_nh(node, &nh);
+		rte_rib_get_nh(ref_node, &ref_nh);
+		RTE_TEST_ASSERT(ip == ref_ip && depth == ref_depth &&
+			nh == ref_nh, "Route mismatch\n");
+	} while (1);
+
+	for (i = 0; i < BULK_ROUTES; i++) {
+		ip = rte_rand();
+		node = rte_rib_lookup(rib, ip);
+		ref_node = rte_rib_lookup(ref, ip);
+		RTE_TEST_ASSERT((node == NULL) == (ref_node == NULL),
+			"Lookup mismatch\n");
+		if (node == NULL)
+			continue;
+		rte_rib_get_nh(node, &nh);
+		rte_rib_get_nh(ref_node, &ref_nh);
+		RTE_TEST_ASSERT(nh == ref_nh, "Lookup mismatch\n");
+	}
+
+	rte_rib_free(rib);
+	rte_rib_free(ref);
+
+	/* not enough nodes for the bulk */
+	config.max_nodes = 4;
+	rib = rte_rib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(rib != NULL, "Failed to create RIB\n");
+	ips[0] = RTE_IPV4(10, 0, 0, 1);
+	ips[1] = RTE_IPV4(10, 0, 0, 2);
+	ips[2] = RTE_IPV4(10, 0, 0, 4);
+	depths[0] = depths[1] = depths[2] = MAX_DEPTH;
+	ret = rte_rib_insert_bulk(rib, ips, depths, nhs, 3);
+	RTE_TEST_ASSERT(ret < 0 && rte_errno == ENOMEM,
+		"Bulk insert succeeded without enough nodes\n");
+	RTE_TEST_ASSERT(count_routes(rib) == 0,
+		"Failed bulk insert changed the RIB\n");
+	ret = rte_rib_insert_bulk(rib, ips, depths, nhs, 2);
+	RTE_TEST_ASSERT(ret == 0, "Failed to insert rules in bulk\n");
+	rte_rib_free(rib);
+
+	return TEST_SUCCESS;
+}
+
+static struct rte_rcu_qsbr *
+create_qsv(uint32_t max_threads)
+{
+	struct rte_rcu_qsbr *qsv;
+	size_t sz;
+
+	sz = rte_rcu_qsbr_get_memsize(max_threads);
+	qsv = rte_zmalloc_socket(NULL, sz, RTE_CACHE_LINE_SIZE,
+		SOCKET_ID_ANY);
+	if (qsv != NULL && rte_rcu_qsbr_init(qsv, max_threads) != 0) {
+		rte_free(qsv);
+		qsv = NULL;
+	}
+	return qsv;
+}
+
+/*
+ * rte_rib_rcu_qsbr_add positive and negative tests.
+ */
+int32_t
+test_rcu_qsbr_add(void)
+{
+	struct rte_rib *rib;
+	struct rte_rib_conf config;
+	struct rte_rib_rcu_config rcu_cfg = {0};
+	struct rte_rcu_qsbr *qsv;
+	int ret;
+
+	config.max_nodes = MAX_RULES;
+	config.ext_sz = 0;
+
+	rib = rte_rib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(rib != NULL, "Failed to create RIB\n");
+	qsv = create_qsv(RTE_MAX_LCORE);
+	RTE_TEST_ASSERT(qsv != NULL, "Failed to create QSBR variable\n");
+
+	ret = rte_rib_rcu_qsbr_add(NULL, &rcu_cfg);
+	RTE_TEST_ASSERT(ret < 0, "Call succeeded with invalid parameters\n");
+	ret = rte_rib_rcu_qsbr_add(rib, NULL);
+	RTE_TEST_ASSERT(ret < 0, "Call succeeded with invalid parameters\n");
+	ret = rte_rib_rcu_qsbr_add(rib, &rcu_cfg);
+	RTE_TEST_ASSERT(ret < 0, "Call succeeded with invalid parameters\n");
+
+	rcu_cfg.v = qsv;
+	rcu_cfg.mode = RTE_RIB_QSBR_MODE_SYNC + 1;
+	ret = rte_rib_rcu_qsbr_add(rib, &rcu_cfg);
+	RTE_TEST_ASSERT(ret < 0, "Call succeeded with invalid parameters\n");
+
+	rcu_cfg.mode = RTE_RIB_QSBR_MODE_DQ;
+	ret = rte_rib_rcu_qsbr_add(rib, &rcu_cfg);
+	RTE_TEST_ASSERT(ret == 0, "Failed to add QSBR variable\n");
+
+	rcu_cfg.mode = RTE_RIB_QSBR_MODE_SYNC;
+	ret = rte_rib_rcu_qsbr_add(rib, &rcu_cfg);
+	RTE_TEST_ASSERT(ret < 0 && rte_errno == EEXIST,
+		"QSBR variable added twice\n");
+
+	rte_rib_free(rib);
+	rte_free(qsv);
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * rte_rib_rcu_qsbr_add DQ mode functional test.
+ * Reader and writer are in the same thread in this test.
+ *  - Fill up a RIB with 4 routes using all the nodes
+ *  - Reader starts a walk
+ *  - Writer removes the route the reader stands on and another one
+ *  - Reader continues the walk and gets the remaining routes
+ *  - Writer re-adds the routes (removed nodes are not reclaimed yet)
+ *  - Reader reports quiescent state
+ *  - Writer re-adds the routes
+ */
+int32_t
+test_rcu_qsbr_reclaim(void)
+{
+	struct rte_rib *rib;
+	struct rte_rib_node *node;
+	struct rte_rib_conf config;
+	struct rte_rib_rcu_config rcu_cfg = {0};
+	struct rte_rcu_qsbr *qsv;
+	uint32_t ip;
+	unsigned int i;
+	int ret;
+
+	/* 4 routes with 3 intermediate nodes */
+	config.max_nodes = 7;
+	config.ext_sz = 0;
+
+	rib = rte_rib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(rib != NULL, "Failed to create RIB\n");
+	qsv = create_qsv(1);
+	RTE_TEST_ASSERT(qsv != NULL, "Failed to create QSBR variable\n");
+
+	rcu_cfg.v = qsv;
+	rcu_cfg.mode = RTE_RIB_QSBR_MODE_DQ;
+	ret = rte_rib_rcu_qsbr_add(rib, &rcu_cfg);
+	RTE_TEST_ASSERT(ret == 0, "Failed to add QSBR variable\n");
+
+	for (i = 0; i < 4; i++) {
+		node = rte_rib_insert(rib, RTE_IPV4(10, 0, 0, 1 << i),
+			MAX_DEPTH);
+		RTE_TEST_ASSERT(node != NULL, "Failed to insert rule\n");
+	}
+
+	/* Register pseudo reader */
+	ret = rte_rcu_qsbr_thread_register(qsv, 0);
+	RTE_TEST_ASSERT(ret == 0, "Failed to register reader\n");
+	rte_rcu_qsbr_thread_online(qsv, 0);
+
+	node = rte_rib_get_nxt(rib, 0, 0, NULL, RTE_RIB_GET_NXT_ALL);
+	RTE_TEST_ASSERT(node != NULL, "Failed to get rib_node\n");
+	rte_rib_get_ip(node, &ip);
+	RTE_TEST_ASSERT(ip == RTE_IPV4(10, 0, 0, 1), "Wrong route\n");
+
+	/* Writer update */
+	rte_rib_remove(rib, RTE_IPV4(10, 0, 0, 1), MAX_DEPTH);
+	rte_rib_remove(rib, RTE_IPV4(10, 0, 0, 4), MAX_DEPTH);
+
+	node = rte_rib_get_nxt(rib, 0, 0, node, RTE_RIB_GET_NXT_ALL);
+	RTE_TEST_ASSERT(node != NULL, "Walk stopped after removal\n");
+	rte_rib_get_ip(node, &ip);
+	RTE_TEST_ASSERT(ip == RTE_IPV4(10, 0, 0, 2), "Wrong route\n");
+	node = rte_rib_get_nxt(rib, 0, 0, node, RTE_RIB_GET_NXT_ALL);
+	RTE_TEST_ASSERT(node != NULL, "Walk stopped after removal\n");
+	rte_rib_get_ip(node, &ip);
+	RTE_TEST_ASSERT(ip == RTE_IPV4(10, 0, 0, 8), "Wrong route\n");
+	node = rte_rib_get_nxt(rib, 0, 0, node, RTE_RIB_GET_NXT_ALL);
+	RTE_TEST_ASSERT(node == NULL, "Walk returned a removed route\n");
+
+	node = rte_rib_insert(rib, RTE_IPV4(10, 0, 0, 1), MAX_DEPTH);
+	RTE_TEST_ASSERT(node == NULL && rte_errno == ENOMEM,
+		"Removed nodes reused while the reader is active\n");
+
+	/* Reader quiescent */
+	rte_rcu_qsbr_quiescent(qsv, 0);
+
+	node = rte_rib_insert(rib, RTE_IPV4(10, 0, 0, 1), MAX_DEPTH);
+	RTE_TEST_ASSERT(node != NULL, "Failed to insert rule\n");
+	node = rte_rib_insert(rib, RTE_IPV4(10, 0, 0, 4), MAX_DEPTH);
+	RTE_TEST_ASSERT(node != NULL, "Failed to insert rule\n");
+
+	rte_rcu_qsbr_thread_offline(qsv, 0);
+	ret = rte_rcu_qsbr_thread_unregister(qsv, 0);
+	RTE_TEST_ASSERT(ret == 0, "Failed to unregister reader\n");
+
+	rte_rib_free(rib);
+	rte_free(qsv);
+
+	return TEST_SUCCESS;
+}
+
+static struct rte_rib *g_rib;
+static struct rte_rcu_qsbr *g_v;
+static RTE_ATOMIC(bool) writer_done;
+static RTE_ATOMIC(uint32_t) reader_errors;
+
+#define WALK_PREFIX	RTE_IPV4(10, 0, 0, 0)
+#define WALK_DEPTH	16
+#define WRITER_ITERATIONS	20000
+
+/*
+ * Reader walking the RIB with RCU, it is quiescent between walks.
+ */
+static int
+test_rcu_qsbr_walker(void *arg)
+{
+	struct rte_rib_node *node;
+	uint32_t ip;
+	uint8_t depth;
+
+	RTE_SET_USED(arg);
+	rte_rcu_qsbr_thread_register(g_v, 0);
+	rte_rcu_qsbr_thread_online(g_v, 0);
+
+	do {
+		node = NULL;
+		while ((node = rte_rib_get_nxt(g_rib, WALK_PREFIX, WALK_DEPTH,
+				node, RTE_RIB_GET_NXT_ALL)) != NULL) {
+			rte_rib_get_ip(node, &ip);
+			rte_rib_get_depth(node, &depth);
+			if (depth <= WALK_DEPTH || depth > MAX_DEPTH ||
+					(ip & rte_rib_depth_to_mask(WALK_DEPTH)) !=
+					WALK_PREFIX)
+				rte_atomic_fetch_add_explicit(&reader_errors,
+					1, rte_memory_order_relaxed);
+		}
+		rte_rcu_qsbr_quiescent(g_v, 0);
+	} while (!rte_atomic_load_explicit(&writer_done,
+			rte_memory_order_relaxed));
+
+	rte_rcu_qsbr_thread_offline(g_v, 0);
+	rte_rcu_qsbr_thread_unregister(g_v, 0);
+
+	return 0;
+}
+
+/*
+ * 1 reader walking the RIB and 1 writer inserting and removing
+ * routes, one by one and in bulk, without locks.
+ */
+int32_t
+test_rcu_qsbr_walk(void)
+{
+	struct rte_rib_conf config;
+	struct rte_rib_rcu_config rcu_cfg = {0};
+	uint32_t ips[8];
+	uint8_t depths[8];
+	uint64_t nhs[8] = {0};
+	unsigned int i, j;
+	int ret = 0;
+
+	if (rte_lcore_count() < 2) {
+		printf("Not enough cores for %s, expecting at least 2\n",
+			__func__);
+		return TEST_SKIPPED;
+	}
+
+	config.max_nodes = 1 << 12;
+	config.ext_sz = 0;
+
+	g_rib = rte_rib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(g_rib != NULL, "Failed to create RIB\n");
+	g_v = create_qsv(1);
+	RTE_TEST_ASSERT(g_v != NULL, "Failed to create QSBR variable\n");
+
+	rcu_cfg.v = g_v;
+	rcu_cfg.mode = RTE_RIB_QSBR_MODE_DQ;
+	ret = rte_rib_rcu_qsbr_add(g_rib, &rcu_cfg);
+	RTE_TEST_ASSERT(ret == 0, "Failed to add QSBR variable\n");
+
+	rte_atomic_store_explicit(&writer_done, false,
+		rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&reader_errors, 0,
+		rte_memory_order_relaxed);
+	rte_eal_remote_launch(test_rcu_qsbr_walker, NULL,
+		rte_get_next_lcore(-1, 1, 0));
+
+	for (i = 0; i < WRITER_ITERATIONS; i++) {
+		/* keep the RIB in the 10.0.0.0/16 range */
+		for (j = 0; j < RTE_DIM(ips); j++) {
+			depths[j] = WALK_DEPTH + 1 +
+				rte_rand_max(MAX_DEPTH - WALK_DEPTH);
+			ips[j] = WALK_PREFIX | (rte_rand() &
+				~rte_rib_depth_to_mask(WALK_DEPTH));
+			ips[j] &= rte_rib_depth_to_mask(depths[j]);
+		}
+		if (i % 2 == 0) {
+			if (rte_rib_insert_bulk(g_rib, ips, depths, nhs,
+					RTE_DIM(ips)) != 0)
+				continue;
+		} else {
+			for (j = 0; j < RTE_DIM(ips); j++)
+				rte_rib_insert(g_rib, ips[j], depths[j]);
+		}
+		for (j = 0; j < RTE_DIM(ips); j++)
+			rte_rib_remove(g_rib, ips[j], depths[j]);
+	}
+
+	rte_atomic_store_explicit(&writer_done, true,
+		rte_memory_order_relaxed);
+	rte_eal_mp_wait_lcore();
+
+	RTE_TEST_ASSERT(rte_atomic_load_explicit(&reader_errors,
+		rte_memory_order_relaxed) == 0,
+		"Reader got inconsistent routes\n");
+	RTE_TEST_ASSERT(count_routes(g_rib) == 0, "Failed to remove rules\n");
+
+	rte_rib_free(g_rib);
+	rte_free(g_v);
+
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite rib_tests = {
 	.suite_name = "rib autotest",
 	.setup = NULL,
@@ -334,6 +769,10 @@ static struct unit_test_suite rib_tests = {
 		TEST_CASE(test_get_fn),
 		TEST_CASE(test_basic),
 		TEST_CASE(test_tree_traversal),
+		TEST_CASE(test_insert_bulk),
+		TEST_CASE(test_rcu_qsbr_add),
+		TEST_CASE(test_rcu_qsbr_reclaim),
+		TEST_CASE(test_rcu_qsbr_walk),
 		TEST_CASES_END()
 	}
 };
@@ -83,6 +83,18 @@
  *      - At initialization, timer3 is loaded by the main core, on
  *        another core in "periodical" mode (time = 1 second).
  *      - It is stopped at t=25s by timer2.
+ *
+ * #. Bulk test.
+ *
+ *    This test checks the bulk functions on the main core.
+ *
+ *    - A set of timers is loaded with rte_timer_reset_bulk() far in the
+ *      future, then half of them are stopped with rte_timer_stop_bulk().
+ *    - All the timers are loaded again to expire soon, and
+ *      rte_timer_manage_bulk() is called until they expire. The callback
+ *      reloads every other timer the first time it expires.
+ *    - We check that every timer callback has been called once, or twice
+ *      for the reloaded ones, with its own argument.
  */
 
 #include <stdio.h>
@@ -497,6 +509,108 @@ timer_basic_main_loop(__rte_unused void *arg)
 	return 0;
 }
 
+#define NB_BULK_TIMER 1000
+
+struct bulk_timerinfo {
+	struct rte_timer tim;
+	unsigned int count;
+};
+
+static struct bulk_timerinfo bulk_timers[NB_BULK_TIMER];
+static unsigned int bulk_expired;
+
+/* timer callback for bulk tests */
+static void
+timer_bulk_cb(struct rte_timer **tims, unsigned int nb_timers,
+	      __rte_unused void *arg)
+{
+	uint64_t hz = rte_get_timer_hz();
+	struct bulk_timerinfo *info;
+	unsigned int i;
+
+	if (nb_timers == 0 || nb_timers > RTE_TIMER_MANAGE_BULK_SIZE)
+		test_failed = 1;
+
+	for (i = 0; i < nb_timers; i++) {
+		info = tims[i]->arg;
+		if (&info->tim != tims[i]) {
+			test_failed = 1;
+			continue;
+		}
+		info->count++;
+		bulk_expired++;
+
+		/* reload every other timer the first time */
+		if (info->count == 1 && (info - bulk_timers) % 2 == 0 &&
+		    rte_timer_reset(tims[i], hz / 100, SINGLE, rte_lcore_id(),
+				    NULL, info) != 0)
+			test_failed = 1;
+	}
+}
+
+static int
+timer_bulk_test(void)
+{
+	struct rte_timer *tims[NB_BULK_TIMER];
+	void *args[NB_BULK_TIMER];
+	uint64_t hz = rte_get_timer_hz();
+	unsigned int lcore_id = rte_lcore_id();
+	uint64_t end;
+	unsigned int i;
+
+	for (i = 0; i < NB_BULK_TIMER; i++) {
+		rte_timer_init(&bulk_timers[i].tim);
+		bulk_timers[i].count = 0;
+		tims[i] = &bulk_timers[i].tim;
+		args[i] = &bulk_timers[i];
+	}
+
+	if (rte_timer_reset_bulk(tims, NB_BULK_TIMER, hz * 10, SINGLE,
+				 lcore_id, NULL, args) != NB_BULK_TIMER) {
+		printf("Cannot reset timers in bulk\n");
+		return -1;
+	}
+	if (rte_timer_stop_bulk(tims, NB_BULK_TIMER / 2) != NB_BULK_TIMER / 2) {
+		printf("Cannot stop timers in bulk\n");
+		return -1;
+	}
+	for (i = 0; i < NB_BULK_TIMER; i++) {
+		if (rte_timer_pending(tims[i]) != (i >= NB_BULK_TIMER / 2)) {
+			printf("Wrong state of timer %u\n", i);
+			return -1;
+		}
+	}
+
+	/* move the pending timers, and load the stopped ones */
+	if (rte_timer_reset_bulk(tims, NB_BULK_TIMER, hz / 100, SINGLE,
+				 lcore_id, NULL, args) != NB_BULK_TIMER) {
+		printf("Cannot reset timers in bulk\n");
+		return -1;
+	}
+
+	test_failed = 0;
+	bulk_expired = 0;
+	end = rte_get_timer_cycles() + hz;
+	while (bulk_expired < NB_BULK_TIMER + NB_BULK_TIMER / 2 &&
+	       rte_get_timer_cycles() < end)
+		rte_timer_manage_bulk(timer_bulk_cb, NULL);
+
+	if (test_failed) {
+		printf("Wrong timers passed to bulk callback\n");
+		return -1;
+	}
+	for (i = 0; i < NB_BULK_TIMER; i++) {
+		if (bulk_timers[i].count != (i % 2 == 0 ? 2U : 1U) ||
+		    rte_timer_pending(tims[i])) {
+			printf("Timer %u expired %u times\n", i,
+			       bulk_timers[i].count);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
 static int
 timer_sanity_check(void)
 {
@@ -552,6 +666,12 @@ test_timer(void)
 		return TEST_FAILED;
 	}
 
+	printf("Start timer bulk tests\n");
+	if (timer_bulk_test() < 0) {
+		printf("Timer bulk tests failed\n");
+		return TEST_FAILED;
+	}
+
 	/* init timer */
 	for (i=0; i<NB_TIMER; i++) {
 		memset(&mytiminfo[i], 0, sizeof(struct mytimerinfo));
@@ -132,3 +132,187 @@ test_timer_perf(void)
 }
 
 REGISTER_PERF_TEST(timer_perf_autotest, test_timer_perf);
+
+#define LIST_PERF_NB_TIMERS 1000000
+#define LIST_PERF_EXPIRY_MS 100
+#define LIST_PERF_BULK_SIZE 64
+
+static uint32_t list_perf_expired;
+static uint32_t list_perf_early;
+
+static void
+list_perf_expiry_cb(struct rte_timer *tim)
+{
+	if (rte_get_timer_cycles() < tim->expire)
+		list_perf_early++;
+	list_perf_expired++;
+}
+
+static void
+list_perf_bulk_expiry_cb(struct rte_timer **tims, unsigned int nb_timers,
+		void *arg __rte_unused)
+{
+	unsigned int i;
+
+	for (i = 0; i < nb_timers; i++)
+		list_perf_expiry_cb(tims[i]);
+}
+
+/* Reset all the timers to expire in [ticks, ticks + range) */
+static void
+list_perf_reset(uint32_t data_id, struct rte_timer **tms, int bulk,
+		uint64_t ticks, uint64_t range)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int i;
+
+	if (!bulk) {
+		for (i = 0; i < LIST_PERF_NB_TIMERS; i++)
+			rte_timer_alt_reset(data_id, tms[i],
+					ticks + rte_rand() % range, SINGLE,
+					lcore_id, NULL, NULL);
+		return;
+	}
+
+	/* the timers of a bulk expire at the same time */
+	for (i = 0; i < LIST_PERF_NB_TIMERS; i += LIST_PERF_BULK_SIZE)
+		rte_timer_alt_reset_bulk(data_id, &tms[i],
+				RTE_MIN(LIST_PERF_NB_TIMERS - i,
+					(unsigned int)LIST_PERF_BULK_SIZE),
+				ticks + rte_rand() % range, SINGLE, lcore_id,
+				NULL, NULL);
+}
+
+static void
+list_perf_stop(uint32_t data_id, struct rte_timer **tms, int bulk)
+{
+	unsigned int i;
+
+	if (!bulk) {
+		for (i = 0; i < LIST_PERF_NB_TIMERS; i++)
+			rte_timer_alt_stop(data_id, tms[i]);
+		return;
+	}
+
+	for (i = 0; i < LIST_PERF_NB_TIMERS; i += LIST_PERF_BULK_SIZE)
+		rte_timer_alt_stop_bulk(data_id, &tms[i],
+				RTE_MIN(LIST_PERF_NB_TIMERS - i,
+					(unsigned int)LIST_PERF_BULK_SIZE));
+}
+
+/*
+ * Measure the cost of resetting, stopping and expiring
+ * LIST_PERF_NB_TIMERS timers with a type of pending lists, one by one
+ * or in bulk.
+ */
+static int
+timer_list_perf_run(struct rte_timer **tms, const char *name,
+		const struct rte_timer_data_conf *conf, int bulk)
+{
+	const uint64_t hz = rte_get_timer_hz();
+	const uint64_t expiry = hz * LIST_PERF_EXPIRY_MS / 1000;
+	uint64_t start_tsc, delay_start;
+	uint64_t cycles[4];
+	uint32_t data_id;
+	unsigned int i;
+	int ret = -1;
+
+	if (rte_timer_data_alloc_conf(&data_id, conf) != 0) {
+		printf("Cannot allocate timer data\n");
+		return -1;
+	}
+
+	/* arm the timers in [1s, 2s) */
+	start_tsc = rte_rdtsc();
+	list_perf_reset(data_id, tms, bulk, hz, hz);
+	cycles[0] = rte_rdtsc() - start_tsc;
+
+	/* move the pending timers */
+	start_tsc = rte_rdtsc();
+	list_perf_reset(data_id, tms, bulk, hz, hz);
+	cycles[1] = rte_rdtsc() - start_tsc;
+
+	start_tsc = rte_rdtsc();
+	list_perf_stop(data_id, tms, bulk);
+	cycles[2] = rte_rdtsc() - start_tsc;
+
+	/* expire all the timers, which must not run early */
+	list_perf_reset(data_id, tms, bulk, 0, expiry);
+	delay_start = rte_get_timer_cycles();
+	while (rte_get_timer_cycles() < delay_start + expiry)
+		do_delay();
+
+	list_perf_expired = 0;
+	list_perf_early = 0;
+	start_tsc = rte_rdtsc();
+	while (list_perf_expired != LIST_PERF_NB_TIMERS &&
+			rte_get_timer_cycles() < delay_start + 100 * expiry) {
+		if (bulk)
+			rte_timer_alt_manage_bulk(data_id, NULL, 0,
+					list_perf_bulk_expiry_cb, NULL);
+		else
+			rte_timer_alt_manage(data_id, NULL, 0,
+					list_perf_expiry_cb);
+	}
+	cycles[3] = rte_rdtsc() - start_tsc;
+
+	printf("%-14s %-8s", name, bulk ? "bulk" : "single");
+	for (i = 0; i < RTE_DIM(cycles); i++)
+		printf(" %8.1f", (double)cycles[i] / LIST_PERF_NB_TIMERS);
+	printf("\n");
+
+	if (list_perf_expired != LIST_PERF_NB_TIMERS) {
+		printf("Error: %u timers expired out of %u\n",
+			list_perf_expired, LIST_PERF_NB_TIMERS);
+		goto exit;
+	}
+	if (list_perf_early != 0) {
+		printf("Error: %u timers expired early\n", list_perf_early);
+		goto exit;
+	}
+	ret = 0;
+
+exit:
+	list_perf_stop(data_id, tms, 0);
+	rte_timer_data_dealloc(data_id);
+	return ret;
+}
+
+static int
+test_timer_list_perf(void)
+{
+	static const struct rte_timer_data_conf skiplist_conf = {
+		.list_type = RTE_TIMER_LIST_SKIPLIST,
+	};
+	static const struct rte_timer_data_conf wheel_conf = {
+		.list_type = RTE_TIMER_LIST_WHEEL,
+	};
+	struct rte_timer **tms;
+	unsigned int i;
+	int ret;
+
+	tms = rte_malloc(NULL, (sizeof(*tms) + sizeof(**tms)) *
+			LIST_PERF_NB_TIMERS, 0);
+	if (tms == NULL)
+		return TEST_FAILED;
+	for (i = 0; i < LIST_PERF_NB_TIMERS; i++) {
+		tms[i] = (struct rte_timer *)&tms[LIST_PERF_NB_TIMERS] + i;
+		rte_timer_init(tms[i]);
+	}
+
+	printf("### %u timers, cycles per timer ###\n", LIST_PERF_NB_TIMERS);
+	printf("%-14s %-8s %8s %8s %8s %8s\n", "Lists", "Mode",
+		"arm", "reset", "stop", "expire");
+	ret = timer_list_perf_run(tms, "Skiplist", &skiplist_conf, 0);
+	if (ret == 0)
+		ret = timer_list_perf_run(tms, "Skiplist", &skiplist_conf, 1);
+	if (ret == 0)
+		ret = timer_list_perf_run(tms, "Timing wheel", &wheel_conf, 0);
+	if (ret == 0)
+		ret = timer_list_perf_run(tms, "Timing wheel", &wheel_conf, 1);
+
+	rte_free(tms);
+	return ret == 0 ? TEST_SUCCESS : TEST_FAILED;
+}
+
+REGISTER_PERF_TEST(timer_list_perf_autotest, test_timer_list_perf);
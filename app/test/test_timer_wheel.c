@@ -0,0 +1,343 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include "test.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <rte_bitops.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_stdatomic.h>
+#include <rte_timer.h>
+
+/*
+ * Functional checks of the timing wheel pending lists, run with the
+ * default timer data instance switched to timing wheels of a tiny tick,
+ * so that the timers of all the wheel levels expire within milliseconds.
+ */
+
+/* shortest delay in ticks of a timer stored in the upper wheel level */
+#define WHEEL_TEST_UPPER_TICKS (UINT64_C(1) << 24)
+#define WHEEL_TEST_NB_TIMERS 64
+/* duration of the test timers of the upper level */
+#define WHEEL_TEST_MAX_MS 20
+/* time allowed to the timers to run after their expiry */
+#define WHEEL_TEST_LATE_MS 1000
+
+struct wheel_test_timer {
+	struct rte_timer tim;
+	uint64_t run_cycles;
+	unsigned int run_lcore;
+	uint32_t run_seq;
+	uint32_t nb_runs;
+};
+
+static struct wheel_test_timer wheel_test_timers[WHEEL_TEST_NB_TIMERS];
+static RTE_ATOMIC(uint32_t) wheel_test_nb_runs;
+static RTE_ATOMIC(uint32_t) wheel_test_quit;
+/* duration of a wheel tick in timer cycles */
+static uint64_t wheel_test_tick;
+
+/*
+ * Delays of the cascade test in ticks, around the boundaries of the
+ * four levels, in increasing order.
+ */
+static const uint64_t wheel_test_delays[] = {
+	0, 1, 2, 255, 256, 257, 1000,
+	65535, 65536, 65537, 100000,
+	WHEEL_TEST_UPPER_TICKS - 1, WHEEL_TEST_UPPER_TICKS,
+	WHEEL_TEST_UPPER_TICKS + 1,
+};
+
+static void
+wheel_test_cb(struct rte_timer *tim, void *arg __rte_unused)
+{
+	struct wheel_test_timer *wt =
+		container_of(tim, struct wheel_test_timer, tim);
+
+	wt->run_cycles = rte_get_timer_cycles();
+	wt->run_lcore = rte_lcore_id();
+	wt->nb_runs++;
+	wt->run_seq = rte_atomic_fetch_add_explicit(&wheel_test_nb_runs, 1,
+			rte_memory_order_release);
+}
+
+static void
+wheel_test_init_timers(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < RTE_DIM(wheel_test_timers); i++) {
+		rte_timer_init(&wheel_test_timers[i].tim);
+		wheel_test_timers[i].nb_runs = 0;
+	}
+	rte_atomic_store_explicit(&wheel_test_nb_runs, 0,
+			rte_memory_order_relaxed);
+}
+
+/* Manage the timers of the lcore until nb_runs timers ran, or the deadline */
+static void
+wheel_test_manage(uint32_t nb_runs, uint64_t deadline)
+{
+	while (rte_atomic_load_explicit(&wheel_test_nb_runs,
+				rte_memory_order_acquire) < nb_runs &&
+			rte_get_timer_cycles() < deadline)
+		rte_timer_manage();
+}
+
+/*
+ * Check that timers expiring in each level of the wheel are cascaded
+ * down to level 0 and run once, in expiry order and never early.
+ */
+static int
+test_timer_wheel_cascade(void)
+{
+	const unsigned int lcore_id = rte_lcore_id();
+	const unsigned int nb_timers = RTE_DIM(wheel_test_delays);
+	struct wheel_test_timer *wt;
+	uint64_t deadline;
+	unsigned int i;
+
+	wheel_test_init_timers();
+	for (i = 0; i < nb_timers; i++)
+		TEST_ASSERT_SUCCESS(rte_timer_reset(&wheel_test_timers[i].tim,
+				wheel_test_delays[i] * wheel_test_tick, SINGLE,
+				lcore_id, wheel_test_cb, NULL),
+			"Cannot arm timer %u", i);
+
+	deadline = wheel_test_timers[nb_timers - 1].tim.expire +
+		rte_get_timer_hz() * WHEEL_TEST_LATE_MS / 1000;
+	wheel_test_manage(nb_timers, deadline);
+
+	for (i = 0; i < nb_timers; i++) {
+		wt = &wheel_test_timers[i];
+		printf("%u exp %lu tick %lu seq %u shift %lu\n", i, wt->tim.expire, wt->tim.expire / wheel_test_tick, wt->run_seq, wheel_test_tick);
+	}
+	for (i = 0; i < nb_timers; i++) {
+		wt = &wheel_test_timers[i];
+		TEST_ASSERT_EQUAL(wt->nb_runs, 1,
+			"Timer of %"PRIu64" ticks ran %u times",
+			wheel_test_delays[i], wt->nb_runs);
+		TEST_ASSERT(wt->run_cycles >= wt->tim.expire,
+			"Timer of %"PRIu64" ticks ran %"PRIu64" cycles early",
+			wheel_test_delays[i], wt->tim.expire - wt->run_cycles);
+		TEST_ASSERT_EQUAL(wt->run_seq, i,
+			"Timer of %"PRIu64" ticks ran in position %u",
+			wheel_test_delays[i], wt->run_seq);
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+wheel_test_worker(void *arg __rte_unused)
+{
+	while (rte_atomic_load_explicit(&wheel_test_quit,
+			rte_memory_order_relaxed) == 0)
+		rte_timer_manage();
+	return 0;
+}
+
+/*
+ * Stop and reset, from the main lcore, timers pending in the wheel of a
+ * worker lcore which manages them at the same time:
+ * - timers 4k + 1 and 4k + 3 are stopped and must not run,
+ * - timers 4k are moved into the wheel of the main lcore,
+ * - timers 4k + 2 are reset to expire earlier on the worker lcore.
+ */
+static int
+test_timer_wheel_cross_lcore(void)
+{
+	const unsigned int main_lcore = rte_lcore_id();
+	const uint64_t ms = rte_get_timer_hz() / 1000;
+	unsigned int worker_lcore, exp_lcore, i;
+	struct wheel_test_timer *wt;
+	uint64_t deadline;
+	int ret;
+
+	if (rte_lcore_count() < 2) {
+		printf("Not enough lcores, expecting 2 at least\n");
+		return TEST_SKIPPED;
+	}
+	worker_lcore = rte_get_next_lcore(-1, 1, 0);
+
+	wheel_test_init_timers();
+	rte_atomic_store_explicit(&wheel_test_quit, 0,
+			rte_memory_order_relaxed);
+	TEST_ASSERT_SUCCESS(rte_eal_remote_launch(wheel_test_worker, NULL,
+			worker_lcore), "Cannot launch worker lcore");
+
+	/* arm all the timers late enough to be stopped before they expire */
+	for (i = 0; i < WHEEL_TEST_NB_TIMERS; i++) {
+		ret = rte_timer_reset(&wheel_test_timers[i].tim,
+				WHEEL_TEST_MAX_MS * ms + i * wheel_test_tick,
+				SINGLE, worker_lcore, wheel_test_cb, NULL);
+		if (ret != 0)
+			break;
+	}
+
+	for (i = 0; ret == 0 && i < WHEEL_TEST_NB_TIMERS; i++) {
+		wt = &wheel_test_timers[i];
+		if (i % 2 == 1)
+			ret = rte_timer_stop(&wt->tim);
+		else
+			ret = rte_timer_reset(&wt->tim, ms + i * wheel_test_tick,
+					SINGLE, i % 4 == 0 ? main_lcore :
+					worker_lcore, wheel_test_cb, NULL);
+		if (ret != 0)
+			break;
+	}
+
+	deadline = rte_get_timer_cycles() +
+		(WHEEL_TEST_MAX_MS + WHEEL_TEST_LATE_MS) * ms;
+	if (ret == 0)
+		wheel_test_manage(WHEEL_TEST_NB_TIMERS / 2, deadline);
+
+	/* let the stopped timers expire, if they were still pending */
+	deadline = rte_get_timer_cycles() + 2 * WHEEL_TEST_MAX_MS * ms;
+	while (rte_get_timer_cycles() < deadline)
+		rte_timer_manage();
+
+	rte_atomic_store_explicit(&wheel_test_quit, 1,
+			rte_memory_order_relaxed);
+	rte_eal_wait_lcore(worker_lcore);
+	TEST_ASSERT_SUCCESS(ret, "Cannot stop or reset timer %u", i);
+
+	for (i = 0; i < WHEEL_TEST_NB_TIMERS; i++) {
+		wt = &wheel_test_timers[i];
+		TEST_ASSERT(!rte_timer_pending(&wt->tim),
+			"Timer %u still pending", i);
+		if (i % 2 == 1) {
+			TEST_ASSERT_EQUAL(wt->nb_runs, 0,
+				"Stopped timer %u ran", i);
+			continue;
+		}
+		exp_lcore = i % 4 == 0 ? main_lcore : worker_lcore;
+		TEST_ASSERT_EQUAL(wt->nb_runs, 1, "Timer %u ran %u times",
+			i, wt->nb_runs);
+		TEST_ASSERT_EQUAL(wt->run_lcore, exp_lcore,
+			"Timer %u ran on lcore %u instead of %u", i,
+			wt->run_lcore, exp_lcore);
+		TEST_ASSERT(wt->run_cycles >= wt->tim.expire,
+			"Timer %u ran early", i);
+	}
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Check that rte_timer_next_ticks() returns a lower bound of the time
+ * left before the next timer of the lcore expires, 0 once it is expired,
+ * and -ENOENT when no timer is pending.
+ */
+static int
+test_timer_wheel_next_ticks(void)
+{
+	const unsigned int lcore_id = rte_lcore_id();
+	struct rte_timer *tim = &wheel_test_timers[0].tim;
+	uint64_t before, delay;
+	unsigned int i;
+	int64_t left;
+
+	wheel_test_init_timers();
+	TEST_ASSERT_EQUAL(rte_timer_next_ticks(), -ENOENT,
+		"Timer pending in an empty wheel");
+
+	/* timers of level 0, 1 and 2 */
+	for (i = 0; i < 3; i++) {
+		delay = (UINT64_C(100) << (i * 8)) * wheel_test_tick;
+		TEST_ASSERT_SUCCESS(rte_timer_reset(tim, delay, SINGLE,
+				lcore_id, wheel_test_cb, NULL),
+			"Cannot arm timer");
+
+		while (rte_timer_pending(tim)) {
+			before = rte_get_timer_cycles();
+			left = rte_timer_next_ticks();
+			TEST_ASSERT(left >= 0, "No timer found: %"PRId64, left);
+			/* the timer expires at the end of its tick */
+			if (before >= tim->expire + wheel_test_tick)
+				TEST_ASSERT_EQUAL(left, 0,
+					"Expired timer %"PRId64" ticks away",
+					left);
+			else
+				TEST_ASSERT((uint64_t)left <= tim->expire +
+					wheel_test_tick - before,
+					"%"PRId64" ticks left, expiring in "
+					"%"PRIu64, left, tim->expire - before);
+			rte_timer_manage();
+		}
+
+		TEST_ASSERT_EQUAL(rte_timer_next_ticks(), -ENOENT,
+			"Timer pending after expiry");
+	}
+
+	/* stopping the only timer empties the wheel */
+	TEST_ASSERT_SUCCESS(rte_timer_reset(tim, 1000 * wheel_test_tick,
+			SINGLE, lcore_id, wheel_test_cb, NULL),
+		"Cannot arm timer");
+	TEST_ASSERT(rte_timer_next_ticks() >= 0, "Armed timer not found");
+	TEST_ASSERT_SUCCESS(rte_timer_stop(tim), "Cannot stop timer");
+	TEST_ASSERT_EQUAL(rte_timer_next_ticks(), -ENOENT,
+		"Timer pending after stop");
+
+	return TEST_SUCCESS;
+}
+
+/* Switch the default timer data instance to timing wheels. */
+static int
+test_timer_wheel_setup(void)
+{
+	struct rte_timer_data_conf conf = {
+		.list_type = RTE_TIMER_LIST_WHEEL,
+	};
+
+	/*
+	 * The tick is chosen so that the timers of the upper level of
+	 * the wheels expire in about WHEEL_TEST_MAX_MS.
+	 */
+	conf.wheel_tick = rte_get_timer_hz() * WHEEL_TEST_MAX_MS / 1000 /
+		WHEEL_TEST_UPPER_TICKS;
+	conf.wheel_tick = rte_align64pow2(RTE_MAX(conf.wheel_tick, UINT64_C(1)));
+	wheel_test_tick = conf.wheel_tick;
+
+	rte_timer_subsystem_finalize();
+	if (rte_timer_subsystem_init_conf(&conf) != 0) {
+		printf("Cannot initialize timing wheels\n");
+		rte_timer_subsystem_init();
+		return TEST_FAILED;
+	}
+	return TEST_SUCCESS;
+}
+
+static void
+test_timer_wheel_teardown(void)
+{
+	rte_timer_subsystem_finalize();
+	rte_timer_subsystem_init();
+}
+
+static struct unit_test_suite timer_wheel_test_suite = {
+	.suite_name = "timing wheel tests",
+	.setup = test_timer_wheel_setup,
+	.teardown = test_timer_wheel_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_timer_wheel_cascade),
+		TEST_CASE(test_timer_wheel_cross_lcore),
+		TEST_CASE(test_timer_wheel_next_ticks),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_timer_wheel(void)
+{
+	return unit_test_suite_runner(&timer_wheel_test_suite);
+}
+
+REGISTER_FAST_TEST(timer_wheel_autotest, NOHUGE_OK, ASAN_OK, test_timer_wheel);
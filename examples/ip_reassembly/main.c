@@ -305,20 +305,15 @@ send_single_packet(struct rte_mbuf *m, uint16_t port)
 	return 0;
 }
 
+/* find the destination port of a packet, and send it */
 static inline void
-reassemble(struct rte_mbuf *m, uint16_t portid, uint32_t queue,
-	struct lcore_queue_conf *qconf, uint64_t tms)
+forward(struct rte_mbuf *m, uint16_t portid, struct rx_queue *rxq)
 {
 	struct rte_ether_hdr *eth_hdr;
-	struct rte_ip_frag_tbl *tbl;
-	struct rte_ip_frag_death_row *dr;
-	struct rx_queue *rxq;
 	void *d_addr_bytes;
 	uint32_t next_hop;
 	uint16_t dst_port;
 
-	rxq = &qconf->rx_queue_list[queue];
-
 	eth_hdr = rte_pktmbuf_mtod(m, struct rte_ether_hdr *);
 
 	dst_port = portid;
@@ -329,35 +324,6 @@ reassemble(struct rte_mbuf *m, uint16_t portid, uint32_t queue,
 		uint32_t ip_dst;
 
 		ip_hdr = (struct rte_ipv4_hdr *)(eth_hdr + 1);
-
-		 /* if it is a fragmented packet, then try to reassemble. */
-		if (rte_ipv4_frag_pkt_is_fragmented(ip_hdr)) {
-			struct rte_mbuf *mo;
-
-			tbl = rxq->frag_tbl;
-			dr = &qconf->death_row;
-
-			/* prepare mbuf: setup l2_len/l3_len. */
-			m->l2_len = sizeof(*eth_hdr);
-			m->l3_len = sizeof(*ip_hdr);
-
-			/* process this fragment. */
-			mo = rte_ipv4_frag_reassemble_packet(tbl, dr, m, tms, ip_hdr);
-			if (mo == NULL)
-				/* no packet to send out. */
-				return;
-
-			/* we have our packet reassembled. */
-			if (mo != m) {
-				m = mo;
-				eth_hdr = rte_pktmbuf_mtod(m,
-					struct rte_ether_hdr *);
-				ip_hdr = (struct rte_ipv4_hdr *)(eth_hdr + 1);
-			}
-
-			/* update offloading flags */
-			m->ol_flags |= (RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IP_CKSUM);
-		}
 		ip_dst = rte_be_to_cpu_32(ip_hdr->dst_addr);
 
 		/* Find destination port */
@@ -369,35 +335,10 @@ reassemble(struct rte_mbuf *m, uint16_t portid, uint32_t queue,
 		eth_hdr->ether_type = rte_be_to_cpu_16(RTE_ETHER_TYPE_IPV4);
 	} else if (RTE_ETH_IS_IPV6_HDR(m->packet_type)) {
 		/* if packet is IPv6 */
-		struct rte_ipv6_fragment_ext *frag_hdr;
 		struct rte_ipv6_hdr *ip_hdr;
 
 		ip_hdr = (struct rte_ipv6_hdr *)(eth_hdr + 1);
 
-		frag_hdr = rte_ipv6_frag_get_ipv6_fragment_header(ip_hdr);
-
-		if (frag_hdr != NULL) {
-			struct rte_mbuf *mo;
-
-			tbl = rxq->frag_tbl;
-			dr  = &qconf->death_row;
-
-			/* prepare mbuf: setup l2_len/l3_len. */
-			m->l2_len = sizeof(*eth_hdr);
-			m->l3_len = sizeof(*ip_hdr) + sizeof(*frag_hdr);
-
-			mo = rte_ipv6_frag_reassemble_packet(tbl, dr, m, tms, ip_hdr, frag_hdr);
-			if (mo == NULL)
-				return;
-
-			if (mo != m) {
-				m = mo;
-				eth_hdr = rte_pktmbuf_mtod(m,
-							struct rte_ether_hdr *);
-				ip_hdr = (struct rte_ipv6_hdr *)(eth_hdr + 1);
-			}
-		}
-
 		/* Find destination port */
 		if (rte_lpm6_lookup(rxq->lpm6, &ip_hdr->dst_addr,
 						&next_hop) == 0 &&
@@ -419,6 +360,86 @@ reassemble(struct rte_mbuf *m, uint16_t portid, uint32_t queue,
 	send_single_packet(m, dst_port);
 }
 
+/*
+ * Forward the packets which are not fragments, and reassemble the
+ * fragments of the burst together.
+ */
+static inline void
+reassemble(struct rte_mbuf **pkts, uint16_t nb_pkts, uint16_t portid,
+	uint32_t queue, struct lcore_queue_conf *qconf, uint64_t tms)
+{
+	struct rte_mbuf *frags4[MAX_PKT_BURST];
+	struct rte_mbuf *frags6[MAX_PKT_BURST];
+	struct rte_ether_hdr *eth_hdr;
+	struct rte_ip_frag_tbl *tbl;
+	struct rte_ip_frag_death_row *dr;
+	struct rx_queue *rxq;
+	struct rte_mbuf *m;
+	uint16_t i, nb_frags4, nb_frags6;
+
+	rxq = &qconf->rx_queue_list[queue];
+	tbl = rxq->frag_tbl;
+	dr = &qconf->death_row;
+	nb_frags4 = 0;
+	nb_frags6 = 0;
+
+	/* Prefetch first packets */
+	for (i = 0; i < PREFETCH_OFFSET && i < nb_pkts; i++)
+		rte_prefetch0(rte_pktmbuf_mtod(pkts[i], void *));
+
+	for (i = 0; i < nb_pkts; i++) {
+		if (i + PREFETCH_OFFSET < nb_pkts)
+			rte_prefetch0(rte_pktmbuf_mtod(pkts[i + PREFETCH_OFFSET],
+				void *));
+
+		m = pkts[i];
+		eth_hdr = rte_pktmbuf_mtod(m, struct rte_ether_hdr *);
+
+		/* if it is a fragmented packet, then try to reassemble. */
+		if (RTE_ETH_IS_IPV4_HDR(m->packet_type)) {
+			struct rte_ipv4_hdr *ip_hdr;
+
+			ip_hdr = (struct rte_ipv4_hdr *)(eth_hdr + 1);
+			if (rte_ipv4_frag_pkt_is_fragmented(ip_hdr)) {
+				/* prepare mbuf: setup l2_len/l3_len. */
+				m->l2_len = sizeof(*eth_hdr);
+				m->l3_len = sizeof(*ip_hdr);
+				frags4[nb_frags4++] = m;
+				continue;
+			}
+		} else if (RTE_ETH_IS_IPV6_HDR(m->packet_type)) {
+			struct rte_ipv6_fragment_ext *frag_hdr;
+			struct rte_ipv6_hdr *ip_hdr;
+
+			ip_hdr = (struct rte_ipv6_hdr *)(eth_hdr + 1);
+			frag_hdr = rte_ipv6_frag_get_ipv6_fragment_header(ip_hdr);
+			if (frag_hdr != NULL) {
+				/* prepare mbuf: setup l2_len/l3_len. */
+				m->l2_len = sizeof(*eth_hdr);
+				m->l3_len = sizeof(*ip_hdr) + sizeof(*frag_hdr);
+				frags6[nb_frags6++] = m;
+				continue;
+			}
+		}
+
+		forward(m, portid, rxq);
+	}
+
+	/* process the fragments, and send the reassembled packets. */
+	nb_frags4 = rte_ipv4_frag_reassemble_bulk(tbl, dr, frags4, nb_frags4,
+		tms, frags4);
+	for (i = 0; i < nb_frags4; i++) {
+		/* update offloading flags */
+		frags4[i]->ol_flags |= (RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IP_CKSUM);
+		forward(frags4[i], portid, rxq);
+	}
+
+	nb_frags6 = rte_ipv6_frag_reassemble_bulk(tbl, dr, frags6, nb_frags6,
+		tms, frags6);
+	for (i = 0; i < nb_frags6; i++)
+		forward(frags6[i], portid, rxq);
+}
+
 /* main processing loop */
 static int
 main_loop(__rte_unused void *dummy)
@@ -426,7 +447,7 @@ main_loop(__rte_unused void *dummy)
 	struct rte_mbuf *pkts_burst[MAX_PKT_BURST];
 	unsigned lcore_id;
 	uint64_t diff_tsc, cur_tsc, prev_tsc;
-	int i, j, nb_rx;
+	int i, nb_rx;
 	uint16_t portid;
 	struct lcore_queue_conf *qconf;
 	const uint64_t drain_tsc = (rte_get_tsc_hz() + US_PER_S - 1) / US_PER_S * BURST_TX_DRAIN_US;
@@ -482,25 +503,7 @@ main_loop(__rte_unused void *dummy)
 			nb_rx = rte_eth_rx_burst(portid, 0, pkts_burst,
 				MAX_PKT_BURST);
 
-			/* Prefetch first packets */
-			for (j = 0; j < PREFETCH_OFFSET && j < nb_rx; j++) {
-				rte_prefetch0(rte_pktmbuf_mtod(
-						pkts_burst[j], void *));
-			}
-
-			/* Prefetch and forward already prefetched packets */
-			for (j = 0; j < (nb_rx - PREFETCH_OFFSET); j++) {
-				rte_prefetch0(rte_pktmbuf_mtod(pkts_burst[
-					j + PREFETCH_OFFSET], void *));
-				reassemble(pkts_burst[j], portid,
-					i, qconf, cur_tsc);
-			}
-
-			/* Forward remaining prefetched packets */
-			for (; j < nb_rx; j++) {
-				reassemble(pkts_burst[j], portid,
-					i, qconf, cur_tsc);
-			}
+			reassemble(pkts_burst, nb_rx, portid, i, qconf, cur_tsc);
 
 			rte_ip_frag_free_death_row(&qconf->death_row,
 				PREFETCH_OFFSET);
@@ -163,6 +163,8 @@ struct rte_acl_bld_trie {
 	struct rte_acl_node *trie;
 };
 
+struct acl_incr;
+
 struct rte_acl_ctx {
 	char                name[RTE_ACL_NAMESIZE];
 	/** Name of the ACL context. */
@@ -182,9 +184,14 @@ struct rte_acl_ctx {
 	uint64_t           *trans_table;
 	uint32_t           *data_indexes;
 	struct rte_acl_trie trie[RTE_ACL_MAX_TRIES];
+	uint32_t            first_ofs; /* offset of the first field. */
+	uint8_t             trie_mask[UINT8_MAX + 1];
+	/* tries to walk for each value of the first field. */
 	void               *mem;
 	size_t              mem_sz;
 	struct rte_acl_config config; /* copy of build config. */
+	uint32_t            num_built; /* number of rules in the RT. */
+	struct acl_incr    *incr; /* incremental updates since last build. */
 };
 
 int rte_acl_gen(struct rte_acl_ctx *ctx, struct rte_acl_trie *trie,
@@ -194,6 +201,20 @@ int rte_acl_gen(struct rte_acl_ctx *ctx, struct rte_acl_trie *trie,
 typedef int (*rte_acl_classify_t)
 (const struct rte_acl_ctx *, const uint8_t **, uint32_t *, uint32_t, uint32_t);
 
+/*
+ * Incremental updates support.
+ */
+void
+acl_incr_fold(struct rte_acl_ctx *ctx);
+
+void
+acl_incr_free(struct rte_acl_ctx *ctx);
+
+int
+acl_incr_classify(const struct rte_acl_ctx *ctx, rte_acl_classify_t fn,
+	const uint8_t **data, uint32_t *results, uint32_t num,
+	uint32_t categories);
+
 /*
  * Different implementations of ACL classify.
  */
@@ -4,6 +4,7 @@
 
 #include <eal_export.h>
 #include <rte_acl.h>
+#include <rte_bitops.h>
 #include <rte_log.h>
 
 #include "tb_mem.h"
@@ -23,6 +24,11 @@
 #define NODE_MAX	0x4000
 #define NODE_MIN	0x800
 
+/* macros for partitioning rule sets by the first field heuristics */
+#define ACL_PART_MIN_TRIES	3
+#define ACL_PART_MIN_RULES	0x100
+#define ACL_PART_MAX		4
+
 /* TALLY are statistics per field */
 enum {
 	TALLY_0 = 0,        /* number of rules that are 0% or more wild. */
@@ -69,6 +75,17 @@ struct rte_acl_build_rule {
 	uint32_t                    *wildness;
 };
 
+/* Set of the first field values, one bit per value. */
+struct acl_byte_set {
+	uint64_t bits[(UINT8_MAX + 1) / (sizeof(uint64_t) * CHAR_BIT)];
+};
+
+/* Subset of rules and the first field values they can match. */
+struct acl_build_part {
+	struct rte_acl_build_rule *head;
+	struct acl_byte_set        set;
+};
+
 /* Context for build phase */
 struct acl_build_context {
 	const struct rte_acl_ctx *acx;
@@ -84,10 +101,12 @@ struct acl_build_context {
 	uint32_t                  src_mask;
 	uint32_t                  num_build_rules;
 	uint32_t                  num_tries;
+	uint32_t                  part;
 	struct tb_mem_pool        pool;
 	struct rte_acl_trie       tries[RTE_ACL_MAX_TRIES];
 	struct rte_acl_bld_trie   bld_tries[RTE_ACL_MAX_TRIES];
 	uint32_t            data_indexes[RTE_ACL_MAX_TRIES][ACL_MAX_INDEXES];
+	uint8_t                   trie_mask[UINT8_MAX + 1];
 
 	/* memory free lists for nodes and blocks used for node ptrs */
 	struct acl_mem_block      blocks[MEM_BLOCK_NUM];
@@ -1345,17 +1364,196 @@ build_one_trie(struct acl_build_context *context,
 	return last;
 }
 
+/*
+ * Get set of the first field values that given rule can match.
+ * Returns number of values in the set.
+ */
+static uint32_t
+acl_rule_first_set(const struct rte_acl_build_rule *rule,
+	struct acl_byte_set *set)
+{
+	uint32_t i, lo, hi, msk, num, val;
+	const struct rte_acl_field *fld;
+	const struct rte_acl_field_def *def;
+
+	def = rule->config->defs;
+	fld = rule->f->field + def->field_index;
+
+	/* first field is expected to be one byte long */
+	if (def->size != sizeof(uint8_t)) {
+		memset(set, UINT8_MAX, sizeof(*set));
+		return UINT8_MAX + 1;
+	}
+
+	if (def->type == RTE_ACL_FIELD_TYPE_RANGE) {
+		lo = fld->value.u8;
+		hi = fld->mask_range.u8;
+		msk = 0;
+	} else {
+		lo = 0;
+		hi = UINT8_MAX;
+		msk = (def->type == RTE_ACL_FIELD_TYPE_MASK) ?
+			(uint8_t)RTE_ACL_MASKLEN_TO_BITMASK(
+				fld->mask_range.u32, sizeof(uint8_t)) :
+			fld->mask_range.u8;
+	}
+
+	memset(set, 0, sizeof(*set));
+	val = fld->value.u8 & msk;
+
+	for (i = lo, num = 0; i <= hi; i++) {
+		if ((i & msk) == val) {
+			set->bits[i / 64] |= 1ULL << (i % 64);
+			num++;
+		}
+	}
+
+	return num;
+}
+
+/*
+ * Split rules into partitions by the values of the first field
+ * (usually protocol) they can match.
+ * Each value that is the only match for a big enough number of rules
+ * gets its own partition with all the rules that can match that value.
+ * All other values go into the last partition.
+ * Rules that can match values from several partitions (i.e. wildcards)
+ * are copied into each of them.
+ * At run-time only the tries built for the partition that contains
+ * the first field value of the input have to be walked.
+ */
+static uint32_t
+acl_build_parts(struct acl_build_context *context,
+	struct rte_acl_build_rule *head, struct acl_build_part part[])
+{
+	uint32_t i, k, n, num;
+	uint64_t val;
+	uint32_t cnt[UINT8_MAX + 1];
+	uint32_t pval[ACL_PART_MAX];
+	struct acl_byte_set all, rest, set;
+	struct rte_acl_config *config;
+	struct rte_acl_build_rule *next, *rule, *r;
+	struct rte_acl_build_rule **tail[ACL_PART_MAX];
+
+	memset(cnt, 0, sizeof(cnt));
+
+	/* count rules that match only one value of the first field */
+	if (context->part != 0) {
+		for (rule = head; rule != NULL; rule = rule->next) {
+			if (acl_rule_first_set(rule, &set) == 1) {
+				for (i = 0; set.bits[i] == 0; i++)
+					;
+				cnt[i * 64 + rte_ctz64(set.bits[i])]++;
+			}
+		}
+	}
+
+	/* select most popular values with big enough number of rules */
+	memset(&rest, UINT8_MAX, sizeof(rest));
+	for (num = 0; num != ACL_PART_MAX - 1; num++) {
+		for (i = 0, k = 0; i != RTE_DIM(cnt); i++) {
+			if (cnt[i] > cnt[k])
+				k = i;
+		}
+		if (cnt[k] < ACL_PART_MIN_RULES)
+			break;
+		cnt[k] = 0;
+		pval[num] = k;
+		rest.bits[k / 64] &= ~(1ULL << (k % 64));
+	}
+
+	memset(part, 0, (num + 1) * sizeof(part[0]));
+	for (n = 0; n != num; n++) {
+		val = pval[n];
+		part[n].set.bits[val / 64] = 1ULL << (val % 64);
+		tail[n] = &part[n].head;
+	}
+	part[n].set = rest;
+	tail[n] = &part[n].head;
+
+	memset(&all, 0, sizeof(all));
+
+	for (rule = head; rule != NULL; rule = next) {
+
+		next = rule->next;
+		acl_rule_first_set(rule, &set);
+
+		for (i = 0; i != RTE_DIM(set.bits); i++)
+			all.bits[i] |= set.bits[i];
+
+		/* put rule into each partition that has its values */
+		for (n = 0, r = rule; n != num + 1; n++) {
+
+			for (i = 0, k = 0; i != RTE_DIM(set.bits); i++) {
+				val = set.bits[i] & part[n].set.bits[i];
+				k |= (val != 0);
+			}
+
+			if (k == 0)
+				continue;
+
+			if (r == NULL) {
+				r = acl_build_alloc(context, 1, sizeof(*r));
+				*r = *rule;
+			}
+
+			*tail[n] = r;
+			tail[n] = &r->next;
+			r->next = NULL;
+			r = NULL;
+		}
+	}
+
+	/* last partition is for the values that rules can match only */
+	for (i = 0; i != RTE_DIM(all.bits); i++)
+		part[num].set.bits[i] &= all.bits[i];
+
+	/* drop empty partitions, each one needs its own copy of config */
+	for (i = 0, n = 0; i != num + 1; i++) {
+		if (part[i].head == NULL)
+			continue;
+		part[n] = part[i];
+		if (n != 0) {
+			config = acl_build_alloc(context, 1, sizeof(*config));
+			memcpy(config, &context->cfg, sizeof(*config));
+			for (r = part[n].head; r != NULL; r = r->next)
+				r->config = config;
+		}
+		n++;
+	}
+
+	return n;
+}
+
+/*
+ * Mark tries [start, end) to be walked for all values from the given set.
+ */
+static void
+acl_build_trie_mask(struct acl_build_context *context,
+	const struct acl_byte_set *set, uint32_t start, uint32_t end)
+{
+	uint32_t i, msk;
+
+	msk = (1U << end) - (1U << start);
+
+	for (i = 0; i != RTE_DIM(context->trie_mask); i++) {
+		if ((set->bits[i / 64] & 1ULL << (i % 64)) != 0)
+			context->trie_mask[i] |= msk;
+	}
+}
+
 static int
 acl_build_tries(struct acl_build_context *context,
 	struct rte_acl_build_rule *head)
 {
-	uint32_t n, num_tries;
+	uint32_t i, n, num_parts, num_tries, start;
 	struct rte_acl_config *config;
 	struct rte_acl_build_rule *last;
 	struct rte_acl_build_rule *rule_sets[RTE_ACL_MAX_TRIES];
+	struct acl_build_part part[ACL_PART_MAX];
 
-	config = head->config;
-	rule_sets[0] = head;
+	/* trie masks have to fit into one byte */
+	RTE_BUILD_BUG_ON(RTE_ACL_MAX_TRIES > CHAR_BIT);
 
 	/* initialize tries */
 	for (n = 0; n < RTE_DIM(context->tries); n++) {
@@ -1367,57 +1565,85 @@ acl_build_tries(struct acl_build_context *context,
 	context->tries[0].type = RTE_ACL_FULL_TRIE;
 
 	/* calc wildness of each field of each rule */
-	acl_calc_wildness(head, config);
+	acl_calc_wildness(head, head->config);
 
-	for (n = 0;; n = num_tries) {
+	/* partition rules by the first field values */
+	num_parts = acl_build_parts(context, head, part);
+	num_tries = 0;
 
-		num_tries = n + 1;
+	if (context->part != 0 && num_parts < 2) {
+		ACL_LOG(DEBUG, "No partitions for the rules");
+		return -ENOTSUP;
+	}
 
-		last = build_one_trie(context, rule_sets, n, context->node_max);
-		if (context->bld_tries[n].trie == NULL) {
-			ACL_LOG(ERR, "Build of %u-th trie failed", n);
-			return -ENOMEM;
-		}
+	for (i = 0, n = 0; i != num_parts; i++, n = num_tries) {
 
-		/* Build of the last trie completed. */
-		if (last == NULL)
-			break;
+		if (n == RTE_DIM(context->tries))
+			goto too_many_tries;
 
-		if (num_tries == RTE_DIM(context->tries)) {
-			ACL_LOG(ERR,
-				"Exceeded max number of tries: %u",
-				num_tries);
-			return -ENOMEM;
-		}
+		start = n;
+		rule_sets[n] = part[i].head;
 
-		/* Trie is getting too big, split remaining rule set. */
-		rule_sets[num_tries] = last->next;
-		last->next = NULL;
-		acl_free_node(context, context->bld_tries[n].trie);
+		for (;; n = num_tries) {
 
-		/* Create a new copy of config for remaining rules. */
-		config = acl_build_alloc(context, 1, sizeof(*config));
-		memcpy(config, rule_sets[n]->config, sizeof(*config));
+			num_tries = n + 1;
 
-		/* Make remaining rules use new config. */
-		for (head = rule_sets[num_tries]; head != NULL;
-				head = head->next)
-			head->config = config;
+			last = build_one_trie(context, rule_sets, n,
+				context->node_max);
+			if (context->bld_tries[n].trie == NULL) {
+				ACL_LOG(ERR, "Build of %u-th trie failed", n);
+				return -ENOMEM;
+			}
 
-		/*
-		 * Rebuild the trie for the reduced rule-set.
-		 * Don't try to split it any further.
-		 */
-		last = build_one_trie(context, rule_sets, n, INT32_MAX);
-		if (context->bld_tries[n].trie == NULL || last != NULL) {
-			ACL_LOG(ERR, "Build of %u-th trie failed", n);
-			return -ENOMEM;
+			/* Build of the last trie completed. */
+			if (last == NULL)
+				break;
+
+			if (num_tries == RTE_DIM(context->tries))
+				goto too_many_tries;
+
+			/* Trie is getting too big, split remaining rule set. */
+			rule_sets[num_tries] = last->next;
+			last->next = NULL;
+			acl_free_node(context, context->bld_tries[n].trie);
+
+			/* Create a new copy of config for remaining rules. */
+			config = acl_build_alloc(context, 1, sizeof(*config));
+			memcpy(config, rule_sets[n]->config, sizeof(*config));
+
+			/* Make remaining rules use new config. */
+			for (head = rule_sets[num_tries]; head != NULL;
+					head = head->next)
+				head->config = config;
+
+			/*
+			 * Rebuild the trie for the reduced rule-set.
+			 * Don't try to split it any further.
+			 */
+			last = build_one_trie(context, rule_sets, n, INT32_MAX);
+			if (context->bld_tries[n].trie == NULL ||
+					last != NULL) {
+				ACL_LOG(ERR, "Build of %u-th trie failed", n);
+				return -ENOMEM;
+			}
 		}
 
+		acl_build_trie_mask(context, &part[i].set, start, num_tries);
 	}
 
 	context->num_tries = num_tries;
 	return 0;
+
+too_many_tries:
+	/* not an error for the partitioned build, caller can do without it */
+	if (context->part != 0) {
+		ACL_LOG(DEBUG, "Exceeded max number of tries for %u partitions",
+			num_parts);
+		return -E2BIG;
+	}
+
+	ACL_LOG(ERR, "Exceeded max number of tries: %u", num_tries);
+	return -ENOMEM;
 }
 
 static void
@@ -1509,7 +1735,7 @@ acl_set_data_indexes(struct rte_acl_ctx *ctx)
  */
 static int
 acl_bld(struct acl_build_context *bcx, struct rte_acl_ctx *ctx,
-	const struct rte_acl_config *cfg, uint32_t node_max)
+	const struct rte_acl_config *cfg, uint32_t node_max, uint32_t part)
 {
 	int32_t rc;
 
@@ -1522,6 +1748,7 @@ acl_bld(struct acl_build_context *bcx, struct rte_acl_ctx *ctx,
 	bcx->category_mask = RTE_LEN2MASK(bcx->cfg.num_categories,
 		typeof(bcx->category_mask));
 	bcx->node_max = node_max;
+	bcx->part = part;
 
 	rc = sigsetjmp(bcx->pool.fail, 0);
 
@@ -1622,6 +1849,46 @@ get_first_load_size(const struct rte_acl_config *cfg)
 	return (ofs < max_ofs) ? sizeof(uint32_t) : sizeof(uint8_t);
 }
 
+/*
+ * Max number of tries that one input has to walk.
+ */
+static uint32_t
+acl_build_max_walks(const struct acl_build_context *bcx)
+{
+	uint32_t i, n;
+
+	n = 0;
+	for (i = 0; i != RTE_DIM(bcx->trie_mask); i++)
+		n = RTE_MAX(n, (uint32_t)rte_popcount32(bcx->trie_mask[i]));
+
+	return n;
+}
+
+/*
+ * If rules were split into too many tries, try to build them
+ * partitioned by the first field values.
+ * Choose the partitioned build if the inputs have to walk less tries.
+ * Returns the build context to proceed with, the other one is freed.
+ */
+static struct acl_build_context *
+acl_bld_part(struct acl_build_context bcx[2], struct rte_acl_ctx *ctx,
+	const struct rte_acl_config *cfg, uint32_t node_max)
+{
+	int32_t rc;
+
+	if (bcx[0].num_tries < ACL_PART_MIN_TRIES)
+		return bcx;
+
+	rc = acl_bld(bcx + 1, ctx, cfg, node_max, 1);
+	if (rc == 0 && acl_build_max_walks(bcx + 1) < bcx[0].num_tries) {
+		tb_free_pool(&bcx[0].pool);
+		return bcx + 1;
+	}
+
+	tb_free_pool(&bcx[1].pool);
+	return bcx;
+}
+
 RTE_EXPORT_SYMBOL(rte_acl_build)
 int
 rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
@@ -1629,12 +1896,15 @@ rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
 	int32_t rc;
 	uint32_t n;
 	size_t max_size;
-	struct acl_build_context bcx;
+	struct acl_build_context bcx[2], *b;
 
 	rc = acl_check_bld_param(ctx, cfg);
 	if (rc != 0)
 		return rc;
 
+	/* merge incremental updates into the rules. */
+	acl_incr_fold(ctx);
+
 	acl_build_reset(ctx);
 
 	if (cfg->max_size == 0) {
@@ -1648,13 +1918,17 @@ rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
 	for (rc = -ERANGE; n >= NODE_MIN && rc == -ERANGE; n /= 2) {
 
 		/* perform build phase. */
-		rc = acl_bld(&bcx, ctx, cfg, n);
+		b = bcx;
+		rc = acl_bld(b, ctx, cfg, n, 0);
 
 		if (rc == 0) {
+			/* try to reduce number of tries to walk per input. */
+			b = acl_bld_part(bcx, ctx, cfg, n);
+
 			/* allocate and fill run-time  structures. */
-			rc = rte_acl_gen(ctx, bcx.tries, bcx.bld_tries,
-				bcx.num_tries, bcx.cfg.num_categories,
-				ACL_MAX_INDEXES * RTE_DIM(bcx.tries) *
+			rc = rte_acl_gen(ctx, b->tries, b->bld_tries,
+				b->num_tries, b->cfg.num_categories,
+				ACL_MAX_INDEXES * RTE_DIM(b->tries) *
 				sizeof(ctx->data_indexes[0]), max_size);
 			if (rc == 0) {
 				/* set data indexes. */
@@ -1663,15 +1937,22 @@ rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
 				/* determine can we always do 4B load */
 				ctx->first_load_sz = get_first_load_size(cfg);
 
+				/* set tries to walk for the first field. */
+				ctx->first_ofs = cfg->defs[0].offset;
+				memcpy(ctx->trie_mask, b->trie_mask,
+					sizeof(ctx->trie_mask));
+
 				/* copy in build config. */
 				ctx->config = *cfg;
+
+				ctx->num_built = ctx->num_rules;
 			}
 		}
 
-		acl_build_log(&bcx);
+		acl_build_log(b);
 
 		/* cleanup after build. */
-		tb_free_pool(&bcx.pool);
+		tb_free_pool(&b->pool);
 	}
 
 	return rc;
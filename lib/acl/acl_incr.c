@@ -0,0 +1,668 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <eal_export.h>
+#include <rte_acl.h>
+#include <rte_string_fns.h>
+
+#include "acl.h"
+#include "acl_log.h"
+
+/*
+ * Incremental updates of a built ACL context.
+ *
+ * Rules added or deleted after rte_acl_build() are not merged into
+ * the main tries. Instead, a small delta context is built from:
+ *  - the added rules,
+ *  - copies of the main rules overlapping an added or a deleted rule,
+ * and is classified alongside the main context. For each result:
+ *  - if the main tries return a deleted rule, the delta result is used:
+ *    any other main rule matching the same input overlaps the deleted one,
+ *    so it has a copy in the delta context;
+ *  - if the delta context returns an added rule, it is used:
+ *    it won against the copies of all the main rules it overlaps;
+ *  - otherwise the main result is used.
+ * The next rte_acl_build() merges everything into the main tries.
+ */
+
+/* min limit of the number of rules in the delta context */
+#define ACL_INCR_DELTA_MIN	1024
+/* delta context can hold up to 1/ACL_INCR_DELTA_RATIO of the main rules */
+#define ACL_INCR_DELTA_RATIO	16
+
+#define ACL_INCR_CLASSIFY_BURST	64
+
+#define ACL_INCR_BMP_WORDS(n)	(((n) + 63) / 64)
+
+/* original rule behind a delta context rule */
+struct acl_incr_res {
+	uint32_t userdata; /* userdata of the rule */
+	uint32_t added;    /* rule is not in the main tries */
+};
+
+struct acl_incr {
+	uint64_t *deleted;   /* deleted main rules */
+	uint64_t *copied;    /* main rules copied into the delta context */
+	uint32_t num_scanned; /* added rules with their overlaps copied */
+	uint32_t num_del;    /* userdata of the deleted main rules */
+	uint32_t max_del;
+	uint32_t *del;
+	uint32_t del_mask;   /* open addressing hash of del[] */
+	uint32_t *del_hash;
+	struct rte_acl_ctx *delta;
+	struct acl_incr_res *res;
+};
+
+static inline const struct rte_acl_rule *
+acl_incr_rule(const struct rte_acl_ctx *ctx, uint32_t idx)
+{
+	return (const struct rte_acl_rule *)
+		((uintptr_t)ctx->rules + (size_t)idx * ctx->rule_sz);
+}
+
+static inline int
+bmp_test(const uint64_t *bmp, uint32_t idx)
+{
+	return (bmp[idx / 64] >> (idx % 64)) & 1;
+}
+
+static inline void
+bmp_set(uint64_t *bmp, uint32_t idx)
+{
+	bmp[idx / 64] |= UINT64_C(1) << (idx % 64);
+}
+
+static inline uint32_t
+acl_incr_hash(uint32_t userdata)
+{
+	return userdata * UINT32_C(0x9e3779b1);
+}
+
+static inline int
+acl_incr_deleted(const struct acl_incr *incr, uint32_t userdata)
+{
+	uint32_t i, v;
+
+	if (incr->num_del == 0)
+		return 0;
+
+	for (i = acl_incr_hash(userdata);; i++) {
+		v = incr->del_hash[i & incr->del_mask];
+		if (v == userdata)
+			return 1;
+		if (v == 0)
+			return 0;
+	}
+}
+
+static uint64_t
+acl_field_get(const union rte_acl_field_types *v, uint32_t size)
+{
+	switch (size) {
+	case sizeof(uint8_t):
+		return v->u8;
+	case sizeof(uint16_t):
+		return v->u16;
+	case sizeof(uint32_t):
+		return v->u32;
+	default:
+		return v->u64;
+	}
+}
+
+/*
+ * Check whether some input could match both rules.
+ */
+static int
+acl_rule_overlap(const struct rte_acl_config *cfg,
+	const struct rte_acl_rule *r1, const struct rte_acl_rule *r2)
+{
+	uint32_t i, sz;
+	uint64_t m1, m2, v1, v2;
+	const struct rte_acl_field *f1, *f2;
+
+	if ((r1->data.category_mask & r2->data.category_mask) == 0)
+		return 0;
+
+	for (i = 0; i != cfg->num_fields; i++) {
+
+		sz = cfg->defs[i].size;
+		f1 = r1->field + cfg->defs[i].field_index;
+		f2 = r2->field + cfg->defs[i].field_index;
+		v1 = acl_field_get(&f1->value, sz);
+		v2 = acl_field_get(&f2->value, sz);
+
+		switch (cfg->defs[i].type) {
+		case RTE_ACL_FIELD_TYPE_MASK:
+			m1 = RTE_ACL_MASKLEN_TO_BITMASK(
+				(uint64_t)f1->mask_range.u32, sz);
+			m2 = RTE_ACL_MASKLEN_TO_BITMASK(
+				(uint64_t)f2->mask_range.u32, sz);
+			break;
+		case RTE_ACL_FIELD_TYPE_BITMASK:
+			m1 = acl_field_get(&f1->mask_range, sz);
+			m2 = acl_field_get(&f2->mask_range, sz);
+			break;
+		default:
+			/* ranges [v1, m1] and [v2, m2] */
+			m1 = acl_field_get(&f1->mask_range, sz);
+			m2 = acl_field_get(&f2->mask_range, sz);
+			if (v1 > m2 || v2 > m1)
+				return 0;
+			continue;
+		}
+
+		if (((v1 ^ v2) & m1 & m2) != 0)
+			return 0;
+	}
+
+	return 1;
+}
+
+/*
+ * Mark the live main rules overlapping the given rule to be copied
+ * into the delta context. Only the rules which can take over
+ * the given one matter:
+ *  - for an added rule, the ones with higher priority;
+ *  - for a deleted rule, the ones with lower priority.
+ */
+static void
+acl_incr_copy(const struct rte_acl_ctx *ctx, struct acl_incr *incr,
+	const struct rte_acl_rule *rule, int added)
+{
+	uint32_t i;
+	uint64_t skip;
+	const struct rte_acl_rule *r;
+
+	for (i = 0; i < ctx->num_built; i++) {
+		skip = incr->deleted[i / 64] | incr->copied[i / 64];
+		if (skip == UINT64_MAX) {
+			i |= 63;
+			continue;
+		}
+		if (((skip >> (i % 64)) & 1) != 0)
+			continue;
+
+		r = acl_incr_rule(ctx, i);
+		if (added != 0 ? r->data.priority < rule->data.priority :
+				r->data.priority > rule->data.priority)
+			continue;
+		if (acl_rule_overlap(&ctx->config, rule, r))
+			bmp_set(incr->copied, i);
+	}
+}
+
+static void
+acl_incr_delta_free(struct rte_acl_ctx *delta)
+{
+	if (delta != NULL) {
+		rte_free(delta->mem);
+		rte_free(delta);
+	}
+}
+
+void
+acl_incr_free(struct rte_acl_ctx *ctx)
+{
+	struct acl_incr *incr;
+
+	incr = ctx->incr;
+	if (incr == NULL)
+		return;
+
+	acl_incr_delta_free(incr->delta);
+	rte_free(incr->res);
+	rte_free(incr->del_hash);
+	rte_free(incr->del);
+	rte_free(incr->deleted);
+	rte_free(incr);
+	ctx->incr = NULL;
+}
+
+/*
+ * Drop the deleted rules and the incremental updates state,
+ * so that the next build covers all the live rules.
+ */
+void
+acl_incr_fold(struct rte_acl_ctx *ctx)
+{
+	uint32_t i, n;
+
+	if (ctx->incr == NULL)
+		return;
+
+	/* rules were reset since the last build */
+	if (ctx->num_built != 0) {
+		n = 0;
+		for (i = 0; i != ctx->num_rules; i++) {
+			if (i < ctx->num_built &&
+					bmp_test(ctx->incr->deleted, i) != 0)
+				continue;
+			if (n != i)
+				memcpy((void *)(uintptr_t)acl_incr_rule(ctx, n),
+					acl_incr_rule(ctx, i), ctx->rule_sz);
+			n++;
+		}
+		ctx->num_rules = n;
+	}
+
+	acl_incr_free(ctx);
+}
+
+static int
+acl_incr_init(struct rte_acl_ctx *ctx)
+{
+	struct acl_incr *incr;
+	size_t sz;
+
+	if (ctx->incr != NULL)
+		return 0;
+
+	incr = rte_zmalloc_socket(ctx->name, sizeof(*incr), 0,
+		ctx->socket_id);
+	if (incr == NULL)
+		return -ENOMEM;
+
+	/* deleted and copied bitmaps share the same allocation */
+	sz = ACL_INCR_BMP_WORDS(ctx->num_built) * sizeof(uint64_t);
+	incr->deleted = rte_zmalloc_socket(ctx->name, 2 * sz,
+		RTE_CACHE_LINE_SIZE, ctx->socket_id);
+	if (incr->deleted == NULL) {
+		rte_free(incr);
+		return -ENOMEM;
+	}
+	incr->copied = incr->deleted + sz / sizeof(uint64_t);
+
+	ctx->incr = incr;
+	return 0;
+}
+
+static void
+acl_incr_del_insert(struct acl_incr *incr, uint32_t userdata)
+{
+	uint32_t i;
+
+	for (i = acl_incr_hash(userdata);
+			incr->del_hash[i & incr->del_mask] != 0; i++)
+		;
+	incr->del_hash[i & incr->del_mask] = userdata;
+}
+
+/*
+ * Make sure the tombstones can take num more userdata values.
+ */
+static int
+acl_incr_del_reserve(struct rte_acl_ctx *ctx, uint32_t num)
+{
+	struct acl_incr *incr;
+	uint32_t i, n, *p;
+
+	incr = ctx->incr;
+	n = incr->num_del + num;
+
+	if (n > incr->max_del) {
+		p = rte_realloc_socket(incr->del, n * sizeof(p[0]), 0,
+			ctx->socket_id);
+		if (p == NULL)
+			return -ENOMEM;
+		incr->del = p;
+		incr->max_del = n;
+	}
+
+	/* keep the hash at most half full */
+	n = rte_align32pow2(2 * n);
+	if (incr->del_hash == NULL || n > incr->del_mask + 1) {
+		p = rte_zmalloc_socket(ctx->name, n * sizeof(p[0]),
+			RTE_CACHE_LINE_SIZE, ctx->socket_id);
+		if (p == NULL)
+			return -ENOMEM;
+		rte_free(incr->del_hash);
+		incr->del_hash = p;
+		incr->del_mask = n - 1;
+		for (i = 0; i != incr->num_del; i++)
+			acl_incr_del_insert(incr, incr->del[i]);
+	}
+
+	return 0;
+}
+
+static struct rte_acl_ctx *
+acl_incr_delta_alloc(const struct rte_acl_ctx *ctx, uint32_t num)
+{
+	struct rte_acl_ctx *delta;
+	size_t sz;
+
+	sz = sizeof(*delta) + (size_t)num * ctx->rule_sz;
+	delta = rte_zmalloc_socket(ctx->name, sz, RTE_CACHE_LINE_SIZE,
+		ctx->socket_id);
+	if (delta == NULL)
+		return NULL;
+
+	delta->rules = delta + 1;
+	delta->max_rules = num;
+	delta->rule_sz = ctx->rule_sz;
+	delta->socket_id = ctx->socket_id;
+	delta->alg = ctx->alg;
+	strlcpy(delta->name, ctx->name, sizeof(delta->name));
+	return delta;
+}
+
+static void
+acl_incr_delta_add(struct rte_acl_ctx *delta, struct acl_incr_res *res,
+	const struct rte_acl_rule *rule, uint32_t added)
+{
+	struct rte_acl_rule *r;
+
+	r = (struct rte_acl_rule *)((uintptr_t)delta->rules +
+		(size_t)delta->num_rules * delta->rule_sz);
+	memcpy(r, rule, delta->rule_sz);
+
+	res[delta->num_rules].userdata = rule->data.userdata;
+	res[delta->num_rules].added = added;
+
+	/* delta context results are indexes of the original rules */
+	r->data.userdata = ++delta->num_rules;
+}
+
+/*
+ * Rebuild the delta context from the added rules (except the ones
+ * marked in the skip bitmap) and the copies of the main rules.
+ * Returns -E2BIG if the delta context would be too big to be worth it.
+ */
+static int
+acl_incr_delta_build(struct rte_acl_ctx *ctx, const uint64_t *skip)
+{
+	struct acl_incr *incr;
+	struct acl_incr_res *res;
+	struct rte_acl_ctx *delta;
+	const struct rte_acl_rule *rule;
+	uint32_t cat_mask, i, n;
+	int32_t rc;
+
+	incr = ctx->incr;
+	cat_mask = RTE_LEN2MASK(ctx->config.num_categories, uint32_t);
+
+	/* copies of live main rules */
+	n = 0;
+	for (i = 0; i != ctx->num_built; i++)
+		n += bmp_test(incr->copied, i) & ~bmp_test(incr->deleted, i);
+
+	/* added rules */
+	for (i = ctx->num_built; i != ctx->num_rules; i++)
+		n += (skip == NULL ||
+			bmp_test(skip, i - ctx->num_built) == 0);
+
+	if (n > RTE_MAX((uint32_t)ACL_INCR_DELTA_MIN,
+			ctx->num_built / ACL_INCR_DELTA_RATIO))
+		return -E2BIG;
+
+	delta = NULL;
+	res = NULL;
+
+	if (n != 0) {
+		delta = acl_incr_delta_alloc(ctx, n);
+		res = rte_malloc_socket(ctx->name, n * sizeof(res[0]), 0,
+			ctx->socket_id);
+		if (delta == NULL || res == NULL) {
+			rc = -ENOMEM;
+			goto err;
+		}
+
+		for (i = 0; i != ctx->num_rules; i++) {
+			rule = acl_incr_rule(ctx, i);
+			if ((rule->data.category_mask & cat_mask) == 0)
+				continue;
+			if (i < ctx->num_built) {
+				if (bmp_test(incr->copied, i) != 0 &&
+						bmp_test(incr->deleted, i) == 0)
+					acl_incr_delta_add(delta, res, rule, 0);
+			} else if (skip == NULL ||
+					bmp_test(skip, i - ctx->num_built) == 0)
+				acl_incr_delta_add(delta, res, rule, 1);
+		}
+	}
+
+	/* none of the rules can match */
+	if (delta != NULL && delta->num_rules == 0) {
+		acl_incr_delta_free(delta);
+		rte_free(res);
+		delta = NULL;
+		res = NULL;
+	}
+
+	if (delta != NULL) {
+		rc = rte_acl_build(delta, &ctx->config);
+		if (rc != 0)
+			goto err;
+	}
+
+	acl_incr_delta_free(incr->delta);
+	rte_free(incr->res);
+	incr->delta = delta;
+	incr->res = res;
+	return 0;
+
+err:
+	acl_incr_delta_free(delta);
+	rte_free(res);
+	return rc;
+}
+
+/*
+ * Delta context would be too big, rebuild the main tries instead.
+ */
+static int
+acl_incr_rebuild(struct rte_acl_ctx *ctx)
+{
+	struct rte_acl_config cfg;
+
+	cfg = ctx->config;
+	return rte_acl_build(ctx, &cfg);
+}
+
+/*
+ * Apply the rules added since the last update.
+ */
+static int
+acl_incr_update(struct rte_acl_ctx *ctx)
+{
+	struct acl_incr *incr;
+	uint32_t i;
+	int32_t rc;
+
+	incr = ctx->incr;
+
+	for (i = ctx->num_built + incr->num_scanned; i < ctx->num_rules; i++)
+		acl_incr_copy(ctx, incr, acl_incr_rule(ctx, i), 1);
+
+	rc = acl_incr_delta_build(ctx, NULL);
+	if (rc == -E2BIG)
+		return acl_incr_rebuild(ctx);
+	if (rc == 0)
+		incr->num_scanned = ctx->num_rules - ctx->num_built;
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_incr_add_rules, 26.03)
+int
+rte_acl_incr_add_rules(struct rte_acl_ctx *ctx,
+	const struct rte_acl_rule *rules, uint32_t num)
+{
+	int32_t rc;
+
+	if (ctx == NULL || rules == NULL || ctx->num_built == 0)
+		return -EINVAL;
+
+	rc = rte_acl_add_rules(ctx, rules, num);
+	if (rc != 0)
+		return rc;
+
+	rc = acl_incr_init(ctx);
+	if (rc == 0)
+		rc = acl_incr_update(ctx);
+
+	/*
+	 * Drop the new rules on failure. They are the last ones,
+	 * even if a failed rebuild already dropped the deleted rules.
+	 */
+	if (rc != 0)
+		ctx->num_rules -= num;
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_incr_del_rules, 26.03)
+int
+rte_acl_incr_del_rules(struct rte_acl_ctx *ctx, const uint32_t *userdata,
+	uint32_t num)
+{
+	struct acl_incr *incr;
+	const struct rte_acl_rule *rule;
+	uint64_t *newdel, *skip;
+	uint32_t *newud;
+	uint32_t i, j, k, na, nd, found;
+	size_t nw;
+	int32_t rc;
+
+	if (ctx == NULL || userdata == NULL || ctx->num_built == 0)
+		return -EINVAL;
+
+	for (j = 0; j != num; j++) {
+		if (userdata[j] == 0)
+			return -EINVAL;
+	}
+
+	rc = acl_incr_init(ctx);
+	if (rc != 0)
+		return rc;
+	incr = ctx->incr;
+
+	rc = acl_incr_del_reserve(ctx, num);
+	if (rc != 0)
+		return rc;
+
+	/* newly deleted main rules, removed added rules, new tombstones */
+	na = ctx->num_rules - ctx->num_built;
+	nw = ACL_INCR_BMP_WORDS(ctx->num_built) + ACL_INCR_BMP_WORDS(na);
+	newdel = rte_zmalloc(NULL, nw * sizeof(newdel[0]) +
+		num * sizeof(newud[0]), 0);
+	if (newdel == NULL)
+		return -ENOMEM;
+	skip = newdel + ACL_INCR_BMP_WORDS(ctx->num_built);
+	newud = (uint32_t *)(newdel + nw);
+
+	nd = 0;
+	for (j = 0; j != num; j++) {
+
+		found = 0;
+		for (i = 0; i != ctx->num_built; i++) {
+			rule = acl_incr_rule(ctx, i);
+			if (rule->data.userdata == userdata[j] &&
+					bmp_test(incr->deleted, i) == 0) {
+				bmp_set(newdel, i);
+				found = 1;
+			}
+		}
+		if (found != 0)
+			newud[nd++] = userdata[j];
+
+		for (i = 0; i != na; i++) {
+			rule = acl_incr_rule(ctx, ctx->num_built + i);
+			if (rule->data.userdata == userdata[j]) {
+				bmp_set(skip, i);
+				found = 1;
+			}
+		}
+
+		if (found == 0) {
+			rte_free(newdel);
+			return -ENOENT;
+		}
+	}
+
+	/* copy the main rules the deleted ones were hiding */
+	for (i = 0; i != ACL_INCR_BMP_WORDS(ctx->num_built); i++)
+		incr->deleted[i] |= newdel[i];
+	for (i = 0; i != ctx->num_built; i++) {
+		if (bmp_test(newdel, i) != 0)
+			acl_incr_copy(ctx, incr, acl_incr_rule(ctx, i), 0);
+	}
+
+	rc = acl_incr_delta_build(ctx, skip);
+	if (rc != 0 && rc != -E2BIG) {
+		for (i = 0; i != ACL_INCR_BMP_WORDS(ctx->num_built); i++)
+			incr->deleted[i] &= ~newdel[i];
+		rte_free(newdel);
+		return rc;
+	}
+
+	/* remove the deleted added rules */
+	for (i = 0, j = 0, k = 0; i != na; i++) {
+		if (bmp_test(skip, i) != 0) {
+			if (i < incr->num_scanned)
+				k++;
+			continue;
+		}
+		if (j != i)
+			memcpy((void *)(uintptr_t)
+				acl_incr_rule(ctx, ctx->num_built + j),
+				acl_incr_rule(ctx, ctx->num_built + i),
+				ctx->rule_sz);
+		j++;
+	}
+	ctx->num_rules = ctx->num_built + j;
+	incr->num_scanned -= k;
+
+	for (j = 0; j != nd; j++) {
+		incr->del[incr->num_del++] = newud[j];
+		acl_incr_del_insert(incr, newud[j]);
+	}
+
+	rte_free(newdel);
+
+	if (rc == -E2BIG)
+		rc = acl_incr_rebuild(ctx);
+	return rc;
+}
+
+int
+acl_incr_classify(const struct rte_acl_ctx *ctx, rte_acl_classify_t fn,
+	const uint8_t **data, uint32_t *results, uint32_t num,
+	uint32_t categories)
+{
+	const struct acl_incr *incr;
+	uint32_t i, k, n, d, m;
+	uint32_t dres[ACL_INCR_CLASSIFY_BURST * RTE_ACL_MAX_CATEGORIES];
+	int32_t rc;
+
+	incr = ctx->incr;
+
+	rc = fn(ctx, data, results, num, categories);
+	if (rc != 0)
+		return rc;
+
+	for (i = 0; i < num; i += n) {
+
+		n = RTE_MIN(num - i, (uint32_t)ACL_INCR_CLASSIFY_BURST);
+
+		if (incr->delta != NULL) {
+			rc = fn(incr->delta, data + i, dres, n, categories);
+			if (rc != 0)
+				return rc;
+		} else
+			memset(dres, 0, n * categories * sizeof(dres[0]));
+
+		for (k = 0; k != n * categories; k++) {
+			m = results[i * categories + k];
+			d = dres[k];
+			if (m != 0 && acl_incr_deleted(incr, m) != 0)
+				results[i * categories + k] = (d == 0) ? 0 :
+					incr->res[d - 1].userdata;
+			else if (d != 0 && incr->res[d - 1].added != 0)
+				results[i * categories + k] =
+					incr->res[d - 1].userdata;
+		}
+	}
+
+	return 0;
+}
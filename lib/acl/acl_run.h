@@ -6,6 +6,7 @@
 #define	_ACL_RUN_H_
 
 #include <rte_acl.h>
+#include <rte_bitops.h>
 #include "acl.h"
 
 #define MAX_SEARCHES_AVX16	16
@@ -37,8 +38,8 @@ struct acl_flow_data {
 	/* number of packets processed */
 	uint32_t            started;
 	/* number of trie traversals in progress */
-	uint32_t            trie;
-	/* current trie index (0 to N-1) */
+	uint32_t            tries;
+	/* mask of tries left to walk for the current packet */
 	uint32_t            cmplt_size;
 	/* maximum number of packets to process */
 	uint32_t            total_packets;
@@ -58,6 +59,7 @@ struct acl_flow_data {
 struct __rte_aligned(XMM_SIZE) completion {
 	uint32_t *results;                          /* running results. */
 	int32_t   priority[RTE_ACL_MAX_CATEGORIES]; /* running priorities. */
+	uint32_t  tries;                            /* num of tries for packet */
 	uint32_t  count;                            /* num of remaining tries */
 	/* true for allocated struct */
 };
@@ -94,6 +96,7 @@ alloc_completion(struct completion *p, uint32_t size, uint32_t tries,
 
 			/* mark as allocated and set number of tries. */
 			p[n].count = tries;
+			p[n].tries = tries;
 			p[n].results = results;
 			return &(p[n]);
 		}
@@ -108,10 +111,10 @@ alloc_completion(struct completion *p, uint32_t size, uint32_t tries,
  */
 static inline void
 resolve_single_priority(uint64_t transition, int n,
-	const struct rte_acl_ctx *ctx, struct parms *parms,
+	__rte_unused const struct rte_acl_ctx *ctx, struct parms *parms,
 	const struct rte_acl_match_results *p)
 {
-	if (parms[n].cmplt->count == ctx->num_tries ||
+	if (parms[n].cmplt->count == parms[n].cmplt->tries ||
 			parms[n].cmplt->priority[0] <=
 			p[transition].priority[0]) {
 
@@ -120,6 +123,37 @@ resolve_single_priority(uint64_t transition, int n,
 	}
 }
 
+/*
+ * Find the next packet that has some tries to walk,
+ * based on the value of its first field.
+ * Packets that no trie can match get their results set to no match.
+ */
+static inline void
+acl_next_packet(struct acl_flow_data *flows, const struct rte_acl_ctx *ctx)
+{
+	uint32_t tries, *results;
+	const uint8_t *data;
+
+	for (; flows->num_packets < flows->total_packets;
+			flows->num_packets++) {
+
+		data = flows->data[flows->num_packets];
+		results = flows->results +
+			flows->num_packets * flows->categories;
+		tries = ctx->trie_mask[data[ctx->first_ofs]];
+
+		if (tries != 0) {
+			flows->tries = tries;
+			flows->last_cmplt = alloc_completion(flows->cmplt_array,
+				flows->cmplt_size, rte_popcount32(tries),
+				results);
+			return;
+		}
+
+		memset(results, 0, flows->categories * sizeof(results[0]));
+	}
+}
+
 /*
  * Routine to fill a slot in the parallel trie traversal array (parms) from
  * the list of packets (flows).
@@ -128,36 +162,33 @@ static inline uint64_t
 acl_start_next_trie(struct acl_flow_data *flows, struct parms *parms, int n,
 	const struct rte_acl_ctx *ctx)
 {
+	uint32_t trie;
 	uint64_t transition;
 
+	/* if this is the first trie for the next packet */
+	if (flows->tries == 0)
+		acl_next_packet(flows, ctx);
+
 	/* if there are any more packets to process */
 	if (flows->num_packets < flows->total_packets) {
-		parms[n].data = flows->data[flows->num_packets];
-		parms[n].data_index = ctx->trie[flows->trie].data_index;
+		trie = rte_ctz32(flows->tries);
+		flows->tries &= flows->tries - 1;
 
-		/* if this is the first trie for this packet */
-		if (flows->trie == 0) {
-			flows->last_cmplt = alloc_completion(flows->cmplt_array,
-				flows->cmplt_size, ctx->num_tries,
-				flows->results +
-				flows->num_packets * flows->categories);
-		}
+		parms[n].data = flows->data[flows->num_packets];
+		parms[n].data_index = ctx->trie[trie].data_index;
 
 		/* set completion parameters and starting index for this slot */
 		parms[n].cmplt = flows->last_cmplt;
 		transition =
 			flows->trans[parms[n].data[*parms[n].data_index++] +
-			ctx->trie[flows->trie].root_index];
+			ctx->trie[trie].root_index];
 
 		/*
 		 * if this is the last trie for this packet,
 		 * then setup next packet.
 		 */
-		flows->trie++;
-		if (flows->trie >= ctx->num_tries) {
-			flows->trie = 0;
+		if (flows->tries == 0)
 			flows->num_packets++;
-		}
 
 		/* keep track of number of active trie traversals */
 		flows->started++;
@@ -180,7 +211,7 @@ acl_set_flow(struct acl_flow_data *flows, struct completion *cmplt,
 
 	flows->num_packets = 0;
 	flows->started = 0;
-	flows->trie = 0;
+	flows->tries = 0;
 	flows->last_cmplt = NULL;
 	flows->cmplt_array = cmplt;
 	flows->total_packets = data_num;
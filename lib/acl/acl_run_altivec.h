@@ -37,7 +37,7 @@ alignas(RTE_CACHE_LINE_SIZE) struct _altivec_acl_const {
  */
 static inline void
 resolve_priority_altivec(uint64_t transition, int n,
-	const struct rte_acl_ctx *ctx, struct parms *parms,
+	__rte_unused const struct rte_acl_ctx *ctx, struct parms *parms,
 	const struct rte_acl_match_results *p, uint32_t categories)
 {
 	uint32_t x;
@@ -56,7 +56,7 @@ resolve_priority_altivec(uint64_t transition, int n,
 		priority = *(const xmm_t *)&p[transition].priority[x];
 
 		/* if this is not the first completed trie */
-		if (parms[n].cmplt->count != ctx->num_tries) {
+		if (parms[n].cmplt->count != parms[n].cmplt->tries) {
 
 			/* get running best results and their priorities */
 			results1 = *saved_results;
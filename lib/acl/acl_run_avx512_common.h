@@ -386,6 +386,62 @@ _F_(search_trie)(struct acl_flow_avx512 *flow)
 	}
 }
 
+/*
+ * Walk all tries for given inputs.
+ * Trie is walked only by the inputs with the first field value
+ * that it can match, all other inputs get no match for it.
+ */
+static inline void
+_F_(search_tries)(const struct rte_acl_ctx *ctx, const uint8_t *data[],
+	uint32_t match[], uint32_t total_packets)
+{
+	uint32_t i, j, k, m, n, *pm;
+	struct acl_flow_avx512 flow;
+	uint8_t msk[total_packets];
+	uint32_t idx[total_packets];
+	uint32_t pmatch[RTE_MAX(total_packets, _SIMD_FLOW_NUM_)];
+	const uint8_t *pdata[RTE_MAX(total_packets, _SIMD_FLOW_NUM_)];
+
+	/* tries that all inputs have to walk */
+	m = UINT8_MAX;
+	for (k = 0; k != total_packets; k++) {
+		msk[k] = ctx->trie_mask[data[k][ctx->first_ofs]];
+		m &= msk[k];
+	}
+
+	for (i = 0, pm = match; i != ctx->num_tries; i++, pm += total_packets) {
+
+		if ((m & 1 << i) != 0) {
+			acl_set_flow_avx512(&flow, ctx, i, data, pm,
+				total_packets);
+			_F_(search_trie)(&flow);
+			continue;
+		}
+
+		/* collect inputs for that trie, others get no match */
+		for (k = 0, n = 0; k != total_packets; k++) {
+			pm[k] = 0;
+			pdata[n] = data[k];
+			idx[n] = k;
+			n += (msk[k] >> i) & 1;
+		}
+
+		if (n == 0)
+			continue;
+
+		/* search_trie() always starts with _SIMD_FLOW_NUM_ flows */
+		for (j = n; j < _SIMD_FLOW_NUM_; j++)
+			pdata[j] = pdata[0];
+
+		acl_set_flow_avx512(&flow, ctx, i, pdata, pmatch,
+			RTE_MAX(n, _SIMD_FLOW_NUM_));
+		_F_(search_trie)(&flow);
+
+		for (j = 0; j != n; j++)
+			pm[idx[j]] = pmatch[j];
+	}
+}
+
 /*
  * resolve match index to actual result/priority offset.
  */
@@ -208,19 +208,11 @@ static inline int
 search_avx512x8x2(const struct rte_acl_ctx *ctx, const uint8_t **data,
 	uint32_t *results, uint32_t total_packets, uint32_t categories)
 {
-	uint32_t i, *pm;
 	const struct rte_acl_match_results *pr;
-	struct acl_flow_avx512 flow;
 	uint32_t match[ctx->num_tries * total_packets];
 
-	for (i = 0, pm = match; i != ctx->num_tries; i++, pm += total_packets) {
-
-		/* setup for next trie */
-		acl_set_flow_avx512(&flow, ctx, i, data, pm, total_packets);
-
-		/* process the trie */
-		_F_(search_trie)(&flow);
-	}
+	/* process the tries */
+	_F_(search_tries)(ctx, data, match, total_packets);
 
 	/* resolve matches */
 	pr = (const struct rte_acl_match_results *)
@@ -32,7 +32,8 @@ alignas(RTE_CACHE_LINE_SIZE) struct _neon_acl_const {
  * its priority for each category.
  */
 static inline void
-resolve_priority_neon(uint64_t transition, int n, const struct rte_acl_ctx *ctx,
+resolve_priority_neon(uint64_t transition, int n,
+		      __rte_unused const struct rte_acl_ctx *ctx,
 		      struct parms *parms,
 		      const struct rte_acl_match_results *p,
 		      uint32_t categories)
@@ -53,7 +54,7 @@ resolve_priority_neon(uint64_t transition, int n, const struct rte_acl_ctx *ctx,
 			(const int32_t *)&p[transition].priority[x]);
 
 		/* if this is not the first completed trie */
-		if (parms[n].cmplt->count != ctx->num_tries) {
+		if (parms[n].cmplt->count != parms[n].cmplt->tries) {
 			/* get running best results and their priorities */
 			results1 = vld1q_s32(saved_results);
 			priority1 = vld1q_s32(saved_priority);
@@ -15,7 +15,7 @@
  */
 static inline void
 resolve_priority_scalar(uint64_t transition, int n,
-	const struct rte_acl_ctx *ctx, struct parms *parms,
+	__rte_unused const struct rte_acl_ctx *ctx, struct parms *parms,
 	const struct rte_acl_match_results *p, uint32_t categories)
 {
 	uint32_t i;
@@ -32,7 +32,7 @@ resolve_priority_scalar(uint64_t transition, int n,
 	priority = p[transition].priority;
 
 	/* if this is not the first completed trie */
-	if (parms[n].cmplt->count != ctx->num_tries) {
+	if (parms[n].cmplt->count != parms[n].cmplt->tries) {
 		for (i = 0; i < categories; i += RTE_ACL_RESULTS_MULTIPLIER) {
 
 			if (saved_priority[i] <= priority[i]) {
@@ -52,9 +52,9 @@ static const rte_xmm_t xmm_range_base = {
  * its priority for each category.
  */
 static inline void
-resolve_priority_sse(uint64_t transition, int n, const struct rte_acl_ctx *ctx,
-	struct parms *parms, const struct rte_acl_match_results *p,
-	uint32_t categories)
+resolve_priority_sse(uint64_t transition, int n,
+	__rte_unused const struct rte_acl_ctx *ctx, struct parms *parms,
+	const struct rte_acl_match_results *p, uint32_t categories)
 {
 	uint32_t x;
 	xmm_t results, priority, results1, priority1, selector;
@@ -73,7 +73,7 @@ resolve_priority_sse(uint64_t transition, int n, const struct rte_acl_ctx *ctx,
 			(const xmm_t *)&p[transition].priority[x]);
 
 		/* if this is not the first completed trie */
-		if (parms[n].cmplt->count != ctx->num_tries) {
+		if (parms[n].cmplt->count != parms[n].cmplt->tries) {
 
 			/* get running best results and their priorities */
 			results1 = _mm_loadu_si128(saved_results);
@@ -297,6 +297,11 @@ rte_acl_classify_alg(const struct rte_acl_ctx *ctx, const uint8_t **data,
 			((RTE_ACL_RESULTS_MULTIPLIER - 1) & categories) != 0)
 		return -EINVAL;
 
+	/* rules added or deleted since the last build */
+	if (ctx->incr != NULL)
+		return acl_incr_classify(ctx, classify_fns[alg], data, results,
+			num, categories);
+
 	return classify_fns[alg](ctx, data, results, num, categories);
 }
 
@@ -362,6 +367,7 @@ rte_acl_free(struct rte_acl_ctx *ctx)
 
 	rte_mcfg_tailq_write_unlock();
 
+	acl_incr_free(ctx);
 	rte_free(ctx->mem);
 	rte_free(ctx);
 	rte_free(te);
@@ -492,14 +498,17 @@ rte_acl_add_rules(struct rte_acl_ctx *ctx, const struct rte_acl_rule *rules,
 
 /*
  * Reset all rules.
- * Note that RT structures are not affected.
+ * Note that RT structures are not affected,
+ * but incremental updates are not possible until next build.
  */
 RTE_EXPORT_SYMBOL(rte_acl_reset_rules)
 void
 rte_acl_reset_rules(struct rte_acl_ctx *ctx)
 {
-	if (ctx != NULL)
+	if (ctx != NULL) {
 		ctx->num_rules = 0;
+		ctx->num_built = 0;
+	}
 }
 
 /*
@@ -535,6 +544,33 @@ rte_acl_dump(const struct rte_acl_ctx *ctx)
 	printf("  num_tries=%"PRIu32"\n", ctx->num_tries);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_trie_stats, 26.03)
+int
+rte_acl_trie_stats(const struct rte_acl_ctx *ctx, const uint8_t **data,
+	uint32_t num, struct rte_acl_trie_stats *stats, uint32_t num_stats)
+{
+	uint32_t i, k, m, n;
+
+	if (ctx == NULL || (data == NULL && num != 0) ||
+			(stats == NULL && num_stats != 0))
+		return -EINVAL;
+
+	n = RTE_MIN(num_stats, ctx->num_tries);
+
+	for (i = 0; i != n; i++) {
+		stats[i].num_rules = ctx->trie[i].count;
+		stats[i].num_walks = 0;
+	}
+
+	for (k = 0; k != num; k++) {
+		m = ctx->trie_mask[data[k][ctx->first_ofs]];
+		for (i = 0; i != n; i++)
+			stats[i].num_walks += (m >> i) & 1;
+	}
+
+	return ctx->num_tries;
+}
+
 /*
  * Dump all ACL contexts to the stdout.
  */
@@ -200,7 +200,8 @@ rte_acl_add_rules(struct rte_acl_ctx *ctx, const struct rte_acl_rule *rules,
 /**
  * Delete all rules from the ACL context.
  * This function is not multi-thread safe.
- * Note that internal run-time structures are not affected.
+ * Note that internal run-time structures are not affected,
+ * but no incremental update is possible until the next build.
  *
  * @param ctx
  *   ACL context to delete rules from.
@@ -236,6 +237,77 @@ rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg);
 void
 rte_acl_reset(struct rte_acl_ctx *ctx);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Add rules to an already built ACL context and make them effective
+ * without rebuilding the whole run-time structures.
+ * The new rules, along with the existing rules they overlap,
+ * are put into a small internal delta context classified
+ * together with the main one, so the cost of the update depends
+ * on the number of rules affected rather than on the total number of rules.
+ * When the delta context grows too big, the ACL context is rebuilt
+ * with the same configuration as the last rte_acl_build().
+ * Rules added with rte_acl_add_rules() since the last build
+ * become effective as well.
+ * The next rte_acl_build() merges all the updates into the main tries.
+ * On failure the new rules are not added. If the failure happened
+ * while rebuilding, the ACL context has no run-time structures
+ * until the next successful rte_acl_build(), as after a failed build.
+ * This function is not multi-thread safe, it must not be called
+ * while the ACL context is used for classification.
+ *
+ * @param ctx
+ *   ACL context to add rules to.
+ * @param rules
+ *   Array of rules to add to the ACL context, in the same format
+ *   as for rte_acl_add_rules().
+ * @param num
+ *   Number of elements in the input array of rules.
+ * @return
+ *   - -ENOMEM if there is no space in the ACL context for these rules,
+ *     or the update could not allocate enough memory.
+ *   - -EINVAL if the parameters are invalid,
+ *     or the ACL context was not built.
+ *   - Negative error code if the update failed.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_incr_add_rules(struct rte_acl_ctx *ctx,
+	const struct rte_acl_rule *rules, uint32_t num);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Delete rules from an already built ACL context without rebuilding
+ * the whole run-time structures, see rte_acl_incr_add_rules().
+ * All the rules with the given userdata are deleted.
+ * This function is not multi-thread safe, it must not be called
+ * while the ACL context is used for classification.
+ *
+ * @param ctx
+ *   ACL context to delete rules from.
+ * @param userdata
+ *   Array of userdata of the rules to delete, zero is not allowed.
+ * @param num
+ *   Number of elements in the input array of userdata.
+ * @return
+ *   - -ENOENT if no rule has one of the userdata,
+ *     nothing is deleted in that case.
+ *   - -ENOMEM if the update could not allocate enough memory.
+ *   - -EINVAL if the parameters are invalid,
+ *     or the ACL context was not built.
+ *   - Negative error code if the update failed.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_incr_del_rules(struct rte_acl_ctx *ctx, const uint32_t *userdata,
+	uint32_t num);
+
 /**
  *  Available implementations of ACL classify.
  */
@@ -359,6 +431,46 @@ rte_acl_dump(const struct rte_acl_ctx *ctx);
 void
 rte_acl_list_dump(void);
 
+/**
+ * Per trie statistics of the ACL context.
+ */
+struct rte_acl_trie_stats {
+	uint32_t num_rules; /**< Number of rules the trie was built from. */
+	uint32_t num_walks; /**< Number of input buffers that walk the trie. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get statistics for the tries of the built ACL context.
+ * At build time rules are partitioned by the values of the first field
+ * they can match, and each input buffer walks only the tries that
+ * can match the value of its first field.
+ * For each trie reports the number of rules it was built from
+ * and how many of the given input buffers have to walk it.
+ * Rules added by rte_acl_incr_add_rules() are not taken into account.
+ *
+ * @param ctx
+ *   ACL context to get statistics for.
+ * @param data
+ *   Array of pointers to input data buffers, as for rte_acl_classify().
+ * @param num
+ *   Number of elements in the input data buffers array.
+ * @param stats
+ *   Array to put per trie statistics into.
+ * @param num_stats
+ *   Number of elements in the *stats* array,
+ *   statistics for up to *num_stats* tries are filled.
+ * @return
+ *   - Number of tries in the ACL context.
+ *   - -EINVAL if the parameters are invalid.
+ */
+__rte_experimental
+int
+rte_acl_trie_stats(const struct rte_acl_ctx *ctx, const uint8_t **data,
+	uint32_t num, struct rte_acl_trie_stats *stats, uint32_t num_stats);
+
 #ifdef __cplusplus
 }
 #endif
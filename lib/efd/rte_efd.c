@@ -17,11 +17,14 @@
 #include <rte_errno.h>
 #include <rte_malloc.h>
 #include <rte_prefetch.h>
+#include <rte_bitops.h>
 #include <rte_branch_prediction.h>
 #include <rte_memcpy.h>
 #include <rte_ring.h>
 #include <rte_jhash.h>
 #include <rte_hash_crc.h>
+#include <rte_rcu_qsbr.h>
+#include <rte_stdatomic.h>
 #include <rte_tailq.h>
 
 #include "rte_efd.h"
@@ -232,6 +235,23 @@ struct efd_online_chunk {
 	/**< Array of all the groups in the chunk. */
 };
 
+/**
+ * Online table for one socket.
+ * Lookups take the number of chunks from the same copy of the table
+ * they read the chunks from, so the whole table can be replaced
+ * with a bigger one while they run.
+ */
+struct efd_online_table {
+	uint32_t num_chunks;
+	/**< Number of chunks in the table. */
+
+	uint32_t num_chunks_shift;
+	/**< Bits to shift to get bin id, instead of dividing by num_chunk. */
+
+	alignas(RTE_CACHE_LINE_SIZE) struct efd_online_chunk chunks[];
+	/**< Array of num_chunks chunk records. */
+};
+
 /**
  * EFD table structure
  */
@@ -255,8 +275,8 @@ struct rte_efd_table {
 	enum efd_lookup_internal_function lookup_fn;
 	/**< Indicates which lookup function to use. */
 
-	struct efd_online_chunk *chunks[RTE_MAX_NUMA_NODES];
-	/**< Dynamic array of size num_chunks of chunk records. */
+	RTE_ATOMIC(struct efd_online_table *) online[RTE_MAX_NUMA_NODES];
+	/**< Per socket online tables, replaced when the table grows. */
 
 	struct efd_offline_chunk_rules *offline_chunks;
 	/**< Dynamic array of size num_chunks of key-value pairs. */
@@ -265,8 +285,31 @@ struct rte_efd_table {
 	/**< Ring that stores all indexes of the free slots in the key table */
 
 	uint8_t *keys; /**< Dynamic array of size max_num_rules of keys */
+
+	uint8_t offline_cpu_socket;
+	/**< Socket of the offline table, used when the table grows. */
+
+	uint32_t num_resizes;
+	/**< Number of times the table grew, to name the free slots ring. */
+
+	struct rte_rcu_qsbr *v;
+	/**< RCU QSBR variable of the lookup threads, NULL if not attached. */
 };
 
+/**
+ * Get the online chunks of a socket, for the writer.
+ */
+static inline struct efd_online_chunk *
+efd_online_chunks(const struct rte_efd_table * const table,
+		const unsigned int socket_id)
+{
+	struct efd_online_table *online;
+
+	online = rte_atomic_load_explicit(&table->online[socket_id],
+			rte_memory_order_relaxed);
+	return online == NULL ? NULL : online->chunks;
+}
+
 /**
  * Computes the chunk ID for a given key hash
  *
@@ -318,18 +361,15 @@ efd_get_bin_id(const struct rte_efd_table * const table,
  *   Currently active permutation choice in the online table
  */
 static inline uint8_t
-efd_get_choice(const struct rte_efd_table * const table,
-		const unsigned int socket_id, const uint32_t chunk_id,
+efd_choice_from_list(const uint8_t * const bin_choice_list,
 		const uint32_t bin_id)
 {
-	struct efd_online_chunk *chunk = &table->chunks[socket_id][chunk_id];
-
 	/*
 	 * Grab the chunk (byte) that contains the choices
 	 * for four neighboring bins.
 	 */
 	uint8_t choice_chunk =
-			chunk->bin_choice_list[bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS];
+			bin_choice_list[bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS];
 
 	/*
 	 * Compute the offset into the chunk that contains
@@ -341,6 +381,39 @@ efd_get_choice(const struct rte_efd_table * const table,
 	return (uint8_t) ((choice_chunk >> offset) & 0x3);
 }
 
+/**
+ * Sets the permutation choice for a bin in a list of choices
+ *
+ * @param bin_choice_list
+ *   Packed list of choices of a chunk
+ * @param bin_id
+ *   Bin ID to set the choice for
+ * @param choice
+ *   New permutation choice - only lower 2 bits
+ */
+static inline void
+efd_set_choice_in_list(uint8_t * const bin_choice_list, const uint32_t bin_id,
+		const uint8_t choice)
+{
+	uint8_t *choice_chunk =
+			&bin_choice_list[bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS];
+	int offset = (bin_id & 0x3) * 2;
+
+	*choice_chunk = (*choice_chunk & (~(0x03 << offset)))
+			| ((choice & 0x03) << offset);
+}
+
+static inline uint8_t
+efd_get_choice(const struct rte_efd_table * const table,
+		const unsigned int socket_id, const uint32_t chunk_id,
+		const uint32_t bin_id)
+{
+	const struct efd_online_chunk *chunk =
+			&efd_online_chunks(table, socket_id)[chunk_id];
+
+	return efd_choice_from_list(chunk->bin_choice_list, bin_id);
+}
+
 /**
  * Compute the chunk_id and bin_id for a given key
  *
@@ -370,6 +443,32 @@ efd_compute_ids(const struct rte_efd_table * const table,
 	*bin_id = efd_get_bin_id(table, h);
 }
 
+/**
+ * Compute the chunk_id and bin_id for a given key in an online table,
+ * which may be a bigger one than the table the writer uses
+ *
+ * @param table
+ *   EFD table to reference
+ * @param online
+ *   Online table the lookup reads the chunks from
+ * @param key
+ *   Key to hash and find location of
+ * @param chunk_id
+ *   Computed chunk ID
+ * @param bin_id
+ *   Computed bin ID
+ */
+static inline void
+efd_compute_online_ids(const struct rte_efd_table * const table,
+		const struct efd_online_table * const online,
+		const void *key, uint32_t * const chunk_id, uint32_t * const bin_id)
+{
+	uint32_t h = EFD_HASH(key, table);
+
+	*chunk_id = h & (online->num_chunks - 1);
+	*bin_id = (h >> online->num_chunks_shift) & (EFD_CHUNK_NUM_BINS - 1);
+}
+
 /**
  * Search for a hash function for a group that satisfies all group results
  */
@@ -498,6 +597,53 @@ efd_search_hash(struct rte_efd_table * const table,
 	return 0;
 }
 
+/**
+ * Computes the minimum number of chunks (smallest power of 2)
+ * that can hold the given number of rules
+ */
+static uint32_t
+efd_num_chunks(uint32_t max_num_rules)
+{
+	if (max_num_rules % EFD_TARGET_CHUNK_NUM_RULES == 0)
+		return rte_align32pow2(max_num_rules /
+			EFD_TARGET_CHUNK_NUM_RULES);
+	else
+		return rte_align32pow2((max_num_rules /
+			EFD_TARGET_CHUNK_NUM_RULES) + 1);
+}
+
+/**
+ * Allocates an online table with all of its chunks
+ * as a continuous block
+ */
+static struct efd_online_table *
+efd_online_table_alloc(uint32_t num_chunks, unsigned int socket_id)
+{
+	struct efd_online_table *online;
+	uint64_t online_table_size = sizeof(*online) +
+			num_chunks * sizeof(struct efd_online_chunk) +
+			EFD_NUM_CHUNK_PADDING_BYTES;
+
+	online = rte_zmalloc_socket(NULL, online_table_size,
+			RTE_CACHE_LINE_SIZE, socket_id);
+	if (online == NULL) {
+		EFD_LOG(ERR, "Allocating EFD online table on socket %u failed",
+				socket_id);
+		return NULL;
+	}
+
+	online->num_chunks = num_chunks;
+	online->num_chunks_shift = rte_bsf32(num_chunks);
+
+	EFD_LOG(DEBUG,
+			"Allocated EFD online table of size "
+			"%"PRIu64" bytes (%.2f MB) on socket %u",
+			online_table_size,
+			(float) online_table_size / (1024.0F * 1024.0F),
+			socket_id);
+	return online;
+}
+
 RTE_EXPORT_SYMBOL(rte_efd_create)
 struct rte_efd_table *
 rte_efd_create(const char *name, uint32_t max_num_rules, uint32_t key_len,
@@ -538,12 +684,7 @@ rte_efd_create(const char *name, uint32_t max_num_rules, uint32_t key_len,
 	 * Compute the minimum number of chunks (smallest power of 2)
 	 * that can hold all of the rules
 	 */
-	if (max_num_rules % EFD_TARGET_CHUNK_NUM_RULES == 0)
-		num_chunks = rte_align32pow2(max_num_rules /
-			EFD_TARGET_CHUNK_NUM_RULES);
-	else
-		num_chunks = rte_align32pow2((max_num_rules /
-			EFD_TARGET_CHUNK_NUM_RULES) + 1);
+	num_chunks = efd_num_chunks(max_num_rules);
 
 	num_chunks_shift = rte_bsf32(num_chunks);
 
@@ -594,6 +735,7 @@ rte_efd_create(const char *name, uint32_t max_num_rules, uint32_t key_len,
 	table->num_chunks = num_chunks;
 	table->num_chunks_shift = num_chunks_shift;
 	table->key_len = key_len;
+	table->offline_cpu_socket = offline_cpu_socket;
 
 	/* key_array */
 	key_array = rte_zmalloc_socket(NULL,
@@ -615,42 +757,19 @@ rte_efd_create(const char *name, uint32_t max_num_rules, uint32_t key_len,
 
 	/* Make sure all the allocatable table pointers are NULL initially */
 	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++)
-		table->chunks[socket_id] = NULL;
+		table->online[socket_id] = NULL;
 	table->offline_chunks = NULL;
 
 	/*
 	 * Allocate one online table per socket specified
 	 * in the user-supplied bitmask
 	 */
-	uint64_t online_table_size = num_chunks * sizeof(struct efd_online_chunk) +
-			EFD_NUM_CHUNK_PADDING_BYTES;
-
 	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
 		if ((online_cpu_socket_bitmask >> socket_id) & 0x01) {
-			/*
-			 * Allocate all of the EFD table chunks (the online portion)
-			 * as a continuous block
-			 */
-			table->chunks[socket_id] =
-				rte_zmalloc_socket(
-				NULL,
-				online_table_size,
-				RTE_CACHE_LINE_SIZE,
-				socket_id);
-			if (table->chunks[socket_id] == NULL) {
-				EFD_LOG(ERR,
-						"Allocating EFD online table on "
-						"socket %u failed",
-						socket_id);
+			table->online[socket_id] =
+				efd_online_table_alloc(num_chunks, socket_id);
+			if (table->online[socket_id] == NULL)
 				goto error_unlock_exit;
-			}
-			EFD_LOG(DEBUG,
-					"Allocated EFD online table of size "
-					"%"PRIu64" bytes (%.2f MB) on socket %u",
-					online_table_size,
-					(float) online_table_size /
-						(1024.0F * 1024.0F),
-					socket_id);
 		}
 	}
 
@@ -772,7 +891,7 @@ rte_efd_free(struct rte_efd_table *table)
 		return;
 
 	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++)
-		rte_free(table->chunks[socket_id]);
+		rte_free(table->online[socket_id]);
 
 	efd_list = RTE_TAILQ_CAST(rte_efd_tailq.head, rte_efd_list);
 	rte_mcfg_tailq_write_lock();
@@ -820,7 +939,9 @@ efd_apply_update(struct rte_efd_table * const table, const unsigned int socket_i
 		const struct efd_online_group_entry * const new_group_entry)
 {
 	int i;
-	struct efd_online_chunk *chunk = &table->chunks[socket_id][chunk_id];
+	struct efd_online_chunk *chunk =
+			&efd_online_chunks(table, socket_id)[chunk_id];
+	struct efd_online_chunk *chunks;
 	uint8_t bin_index = bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS;
 
 	/*
@@ -840,11 +961,12 @@ efd_apply_update(struct rte_efd_table * const table, const unsigned int socket_i
 
 	/* Update the online table with the new data across all sockets */
 	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
-		if (table->chunks[i] != NULL) {
-			memcpy(&(table->chunks[i][chunk_id].groups[group_id]),
+		chunks = efd_online_chunks(table, i);
+		if (chunks != NULL) {
+			memcpy(&(chunks[chunk_id].groups[group_id]),
 					new_group_entry,
 					sizeof(struct efd_online_group_entry));
-			table->chunks[i][chunk_id].bin_choice_list[bin_index] =
+			chunks[chunk_id].bin_choice_list[bin_index] =
 					choice_chunk;
 		}
 	}
@@ -1177,9 +1299,12 @@ efd_compute_update(struct rte_efd_table * const table,
 	return RTE_EFD_UPDATE_FAILED;
 }
 
-RTE_EXPORT_SYMBOL(rte_efd_update)
-int
-rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
+/*
+ * Computes and applies the update of a single key,
+ * returns RTE_EFD_UPDATE_NO_CHANGE as is
+ */
+static int
+efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
 		const void *key, const efd_value_t value)
 {
 	uint32_t chunk_id = 0, group_id = 0, bin_id = 0;
@@ -1190,10 +1315,8 @@ rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
 			&chunk_id, &group_id, &bin_id,
 			&new_bin_choice, &entry);
 
-	if (status == RTE_EFD_UPDATE_NO_CHANGE)
-		return EXIT_SUCCESS;
-
-	if (status == RTE_EFD_UPDATE_FAILED)
+	if (status == RTE_EFD_UPDATE_NO_CHANGE ||
+			status == RTE_EFD_UPDATE_FAILED)
 		return status;
 
 	efd_apply_update(table, socket_id, chunk_id, group_id, bin_id,
@@ -1201,6 +1324,19 @@ rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
 	return status;
 }
 
+RTE_EXPORT_SYMBOL(rte_efd_update)
+int
+rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
+		const void *key, const efd_value_t value)
+{
+	int status = efd_update(table, socket_id, key, value);
+
+	if (status == RTE_EFD_UPDATE_NO_CHANGE)
+		return EXIT_SUCCESS;
+
+	return status;
+}
+
 RTE_EXPORT_SYMBOL(rte_efd_delete)
 int
 rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
@@ -1259,6 +1395,604 @@ rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
 	return not_found;
 }
 
+/** Key of a bulk update, keys are processed sorted by chunk */
+struct efd_bulk_key {
+	uint32_t chunk_id; /**< Chunk ID of the key */
+	uint32_t bin_id;   /**< Bin ID of the key */
+	uint32_t idx;      /**< Index of the key in the key list */
+	int status;        /**< Update status of the key */
+};
+
+/** Working copy of a chunk being updated in bulk */
+struct efd_bulk_chunk {
+	struct efd_offline_chunk_rules saved;
+	/**< Offline chunk before the update, to roll it back. */
+
+	struct efd_online_chunk online;
+	/**< Online chunk with the new hash functions and bin choices. */
+
+	uint64_t dirty;
+	/**< Bitmask of the groups with new keys or values. */
+
+	uint32_t num_slots;
+	/**< Number of key slots taken by the new keys. */
+
+	uint32_t slots[];
+	/**< Key slots taken by the new keys. */
+};
+
+static int
+efd_bulk_key_cmp(const void *a, const void *b)
+{
+	const struct efd_bulk_key *ka = a;
+	const struct efd_bulk_key *kb = b;
+
+	/* keep the order of the keys within a chunk */
+	if (ka->chunk_id != kb->chunk_id)
+		return ka->chunk_id < kb->chunk_id ? -1 : 1;
+	return ka->idx < kb->idx ? -1 : (ka->idx > kb->idx);
+}
+
+/*
+ * Number of keys of a bin in a group
+ */
+static inline uint32_t
+efd_bin_size(const struct efd_offline_group_rules * const group,
+		const uint32_t bin_id)
+{
+	uint32_t i, n;
+
+	for (i = 0, n = 0; i < group->num_rules; i++)
+		n += (group->bin_id[i] == bin_id);
+	return n;
+}
+
+/*
+ * Choose the group for a bin that gets num_new more keys.
+ * As in efd_compute_update(), the bin stays in its group
+ * until the group is loaded enough to be rebalanced,
+ * then it goes to the smallest of the groups it can map to.
+ * Returns the new choice for the bin or -1 if no group has room for it.
+ */
+static int
+efd_bin_choose(const struct efd_offline_chunk_rules * const chunk,
+		const uint32_t bin_id, const uint8_t current_choice,
+		const uint32_t bin_size, const uint32_t num_new)
+{
+	const struct efd_offline_group_rules *group;
+	uint32_t choice, num_rules, smallest_size;
+	int smallest_choice;
+
+	group = &chunk->group_rules[efd_bin_to_group[current_choice][bin_id]];
+	smallest_choice = current_choice;
+	smallest_size = group->num_rules - bin_size;
+
+	if (group->num_rules + num_new <= EFD_MIN_BALANCED_NUM_RULES)
+		return smallest_choice;
+
+	for (choice = 0; choice < EFD_CHUNK_NUM_BIN_TO_GROUP_SETS; choice++) {
+		num_rules = chunk->group_rules[
+				efd_bin_to_group[choice][bin_id]].num_rules;
+		if (num_rules < smallest_size) {
+			smallest_choice = choice;
+			smallest_size = num_rules;
+		}
+	}
+
+	if (smallest_size + bin_size + num_new > EFD_MAX_GROUP_NUM_RULES)
+		return -1;
+	return smallest_choice;
+}
+
+/*
+ * Move a bin to the group of the new choice
+ */
+static inline void
+efd_bin_move(struct efd_offline_chunk_rules * const chunk,
+		uint8_t * const bin_choice_list, const uint32_t bin_id,
+		const uint8_t current_choice, const uint8_t new_choice,
+		const uint32_t bin_size)
+{
+	move_groups(bin_id, bin_size,
+			&chunk->group_rules[efd_bin_to_group[new_choice][bin_id]],
+			&chunk->group_rules[efd_bin_to_group[current_choice][bin_id]]);
+	efd_set_choice_in_list(bin_choice_list, bin_id, new_choice);
+}
+
+static inline void
+efd_group_add(struct efd_offline_group_rules * const group,
+		const uint32_t key_idx, const efd_value_t value,
+		const uint32_t bin_id)
+{
+	group->key_idx[group->num_rules] = key_idx;
+	group->value[group->num_rules] = value;
+	group->bin_id[group->num_rules] = bin_id;
+	group->num_rules++;
+}
+
+/*
+ * Add or update a key in the offline chunk of a bulk update,
+ * without searching for the perfect hash of its group yet.
+ * Returns the update status of the key.
+ */
+static int
+efd_bulk_add_key(struct rte_efd_table * const table,
+		struct efd_offline_chunk_rules * const chunk,
+		struct efd_bulk_chunk * const bc, const uint32_t bin_id,
+		const void *key, const efd_value_t value)
+{
+	struct efd_offline_group_rules *group;
+	uint32_t i, bin_size, group_id, key_idx;
+	uint8_t choice;
+	void *slot_id;
+	int new_choice;
+
+	choice = efd_choice_from_list(bc->online.bin_choice_list, bin_id);
+	group_id = efd_bin_to_group[choice][bin_id];
+	group = &chunk->group_rules[group_id];
+
+	/* Scan the current group and see if the key is already present */
+	for (i = 0, bin_size = 0; i < group->num_rules; i++) {
+		if (group->bin_id[i] != bin_id)
+			continue;
+		bin_size++;
+		if (memcmp(EFD_KEY(group->key_idx[i], table), key,
+				table->key_len) != 0)
+			continue;
+
+		if (group->value[i] == value)
+			return RTE_EFD_UPDATE_NO_CHANGE;
+
+		group->value[i] = value;
+		bc->dirty |= RTE_BIT64(group_id);
+		return 0;
+	}
+
+	new_choice = efd_bin_choose(chunk, bin_id, choice, bin_size, 1);
+	if (new_choice < 0) {
+		EFD_LOG(DEBUG, "No room remaining for insert into "
+				"group %u bin %u", group_id, bin_id);
+		return RTE_EFD_UPDATE_FAILED;
+	}
+
+	if (rte_ring_sc_dequeue(table->free_slots, &slot_id) != 0)
+		return RTE_EFD_UPDATE_FAILED;
+
+	if (new_choice != choice) {
+		efd_bin_move(chunk, bc->online.bin_choice_list, bin_id, choice,
+				new_choice, bin_size);
+		group_id = efd_bin_to_group[new_choice][bin_id];
+		group = &chunk->group_rules[group_id];
+	}
+
+	key_idx = (uint32_t)((uintptr_t)slot_id);
+	rte_memcpy(EFD_KEY(key_idx, table), key, table->key_len);
+	efd_group_add(group, key_idx, value, bin_id);
+	bc->slots[bc->num_slots++] = key_idx;
+	bc->dirty |= RTE_BIT64(group_id);
+	table->num_rules++;
+
+	return group->num_rules == EFD_MAX_GROUP_NUM_RULES ?
+			RTE_EFD_UPDATE_WARN_GROUP_FULL : 0;
+}
+
+/*
+ * Find a perfect hash for a group that has none by moving one of its bins
+ * to another group the bin can map to, that gets a new hash as well.
+ * Returns the ID of the other group or -1 if no move fixes the group.
+ */
+static int
+efd_fix_group(struct rte_efd_table * const table,
+		struct efd_offline_chunk_rules * const chunk,
+		struct efd_online_chunk * const on_chunk, const uint32_t group_id)
+{
+	struct efd_offline_group_rules * const group =
+			&chunk->group_rules[group_id];
+	struct efd_offline_group_rules *new_group;
+	struct efd_online_group_entry entry;
+	uint32_t i, bin_id, bin_size, new_group_id;
+	uint8_t choice;
+
+	for (i = 0; i < group->num_rules; i++) {
+		bin_id = group->bin_id[i];
+		bin_size = efd_bin_size(group, bin_id);
+
+		for (choice = 0; choice < EFD_CHUNK_NUM_BIN_TO_GROUP_SETS;
+				choice++) {
+			new_group_id = efd_bin_to_group[choice][bin_id];
+			new_group = &chunk->group_rules[new_group_id];
+			if (new_group == group || new_group->num_rules +
+					bin_size > EFD_MAX_GROUP_NUM_RULES)
+				continue;
+
+			move_groups(bin_id, bin_size, new_group, group);
+			entry = on_chunk->groups[new_group_id];
+			if (efd_search_hash(table, new_group, &entry) == 0 &&
+					efd_search_hash(table, group,
+					&on_chunk->groups[group_id]) == 0) {
+				on_chunk->groups[new_group_id] = entry;
+				efd_set_choice_in_list(on_chunk->bin_choice_list,
+						bin_id, choice);
+				return new_group_id;
+			}
+			revert_groups(group, new_group, bin_size);
+		}
+	}
+
+	return -1;
+}
+
+/*
+ * Apply the new groups and bin choices of a chunk
+ * to all socket-local copies of the online table.
+ */
+static void
+efd_apply_bulk_update(struct rte_efd_table * const table,
+		const uint32_t chunk_id, const struct efd_bulk_chunk * const bc)
+{
+	struct efd_online_chunk *chunks;
+	uint64_t dirty;
+	uint32_t n;
+	int i;
+
+	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
+		chunks = efd_online_chunks(table, i);
+		if (chunks == NULL)
+			continue;
+		for (dirty = bc->dirty; dirty != 0; dirty &= dirty - 1) {
+			n = rte_ctz64(dirty);
+			memcpy(&chunks[chunk_id].groups[n],
+					&bc->online.groups[n],
+					sizeof(struct efd_online_group_entry));
+		}
+	}
+
+	/* Moved bins switch to groups that already know their keys */
+	rte_atomic_thread_fence(rte_memory_order_release);
+
+	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
+		chunks = efd_online_chunks(table, i);
+		if (chunks != NULL)
+			memcpy(chunks[chunk_id].bin_choice_list,
+					bc->online.bin_choice_list,
+					sizeof(bc->online.bin_choice_list));
+	}
+}
+
+/*
+ * Update all the keys of one chunk:
+ * add them to the offline groups first, then search for the perfect hash
+ * of each modified group once.
+ * If that fails for a group even after moving one of its bins,
+ * roll the chunk back and update the keys one by one,
+ * which tries all the groups each bin can map to.
+ */
+static void
+efd_bulk_update_chunk(struct rte_efd_table * const table,
+		const unsigned int socket_id, struct efd_bulk_key * const bk,
+		const uint32_t num, const void **key_list,
+		const efd_value_t *value_list, struct efd_bulk_chunk * const bc)
+{
+	const uint32_t chunk_id = bk[0].chunk_id;
+	struct efd_offline_chunk_rules * const chunk =
+			&table->offline_chunks[chunk_id];
+	const struct efd_online_chunk * const online =
+			&efd_online_chunks(table, socket_id)[chunk_id];
+	uint64_t dirty;
+	uint32_t i, n;
+	int ret;
+
+	memcpy(&bc->saved, chunk, sizeof(bc->saved));
+	memcpy(&bc->online, online, sizeof(bc->online));
+	bc->dirty = 0;
+	bc->num_slots = 0;
+
+	for (i = 0; i < num; i++)
+		bk[i].status = efd_bulk_add_key(table, chunk, bc, bk[i].bin_id,
+				key_list[bk[i].idx], value_list[bk[i].idx]);
+
+	for (dirty = bc->dirty; dirty != 0; dirty &= dirty - 1) {
+		n = rte_ctz64(dirty);
+		if (efd_search_hash(table, &chunk->group_rules[n],
+				&bc->online.groups[n]) == 0)
+			continue;
+		ret = efd_fix_group(table, chunk, &bc->online, n);
+		if (ret < 0)
+			break;
+		bc->dirty |= RTE_BIT64(ret);
+	}
+
+	if (dirty == 0) {
+		efd_apply_bulk_update(table, chunk_id, bc);
+		return;
+	}
+
+	EFD_LOG(DEBUG, "Failed to find perfect hash for group %u "
+			"of chunk %u, updating %u keys one by one",
+			rte_ctz64(dirty), chunk_id, num);
+
+	memcpy(chunk, &bc->saved, sizeof(*chunk));
+	for (i = 0; i < bc->num_slots; i++)
+		rte_ring_sp_enqueue(table->free_slots,
+				(void *)((uintptr_t)bc->slots[i]));
+	table->num_rules -= bc->num_slots;
+
+	for (i = 0; i < num; i++)
+		bk[i].status = efd_update(table, socket_id,
+				key_list[bk[i].idx], value_list[bk[i].idx]);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_efd_update_bulk, 26.03)
+int
+rte_efd_update_bulk(struct rte_efd_table * const table,
+		const unsigned int socket_id, const uint32_t num_keys,
+		const void **key_list, const efd_value_t *value_list,
+		int *status_list)
+{
+	struct efd_bulk_key *bk;
+	struct efd_bulk_chunk *bc;
+	uint32_t i, n;
+	int num_failed;
+
+	if (table == NULL || socket_id >= RTE_MAX_NUMA_NODES ||
+			efd_online_chunks(table, socket_id) == NULL ||
+			(num_keys != 0 && (key_list == NULL ||
+			value_list == NULL)))
+		return -EINVAL;
+
+	if (num_keys == 0)
+		return 0;
+
+	bk = rte_malloc_socket(NULL, num_keys * sizeof(*bk), 0,
+			table->offline_cpu_socket);
+	bc = rte_malloc_socket(NULL,
+			sizeof(*bc) + num_keys * sizeof(bc->slots[0]),
+			RTE_CACHE_LINE_SIZE, table->offline_cpu_socket);
+	if (bk == NULL || bc == NULL) {
+		rte_free(bk);
+		rte_free(bc);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		efd_compute_ids(table, key_list[i], &bk[i].chunk_id,
+				&bk[i].bin_id);
+		bk[i].idx = i;
+	}
+
+	/* Group the keys by chunk */
+	qsort(bk, num_keys, sizeof(*bk), efd_bulk_key_cmp);
+
+	for (i = 0; i < num_keys; i += n) {
+		for (n = 1; i + n < num_keys &&
+				bk[i + n].chunk_id == bk[i].chunk_id; n++)
+			;
+		efd_bulk_update_chunk(table, socket_id, bk + i, n, key_list,
+				value_list, bc);
+	}
+
+	num_failed = 0;
+	for (i = 0; i < num_keys; i++) {
+		num_failed += (bk[i].status == RTE_EFD_UPDATE_FAILED);
+		if (status_list != NULL)
+			status_list[bk[i].idx] = bk[i].status;
+	}
+
+	rte_free(bc);
+	rte_free(bk);
+	return num_failed;
+}
+
+/*
+ * Insert all the keys of the table into new offline chunks and
+ * a new online table, with a different number of chunks.
+ */
+static int
+efd_rebuild(struct rte_efd_table * const table,
+		struct efd_offline_chunk_rules * const offline,
+		struct efd_online_table * const online)
+{
+	const struct efd_offline_group_rules *old_group;
+	struct efd_offline_chunk_rules *chunk;
+	struct efd_online_chunk *on_chunk;
+	uint32_t c, g, i, chunk_id, bin_id, bin_size, key_idx;
+	uint8_t current_choice;
+	int choice;
+
+	for (c = 0; c < table->num_chunks; c++) {
+		for (g = 0; g < EFD_CHUNK_NUM_GROUPS; g++) {
+			old_group = &table->offline_chunks[c].group_rules[g];
+			for (i = 0; i < old_group->num_rules; i++) {
+				key_idx = old_group->key_idx[i];
+				efd_compute_online_ids(table, online,
+						EFD_KEY(key_idx, table),
+						&chunk_id, &bin_id);
+				chunk = &offline[chunk_id];
+				on_chunk = &online->chunks[chunk_id];
+
+				current_choice = efd_choice_from_list(
+						on_chunk->bin_choice_list,
+						bin_id);
+				bin_size = efd_bin_size(&chunk->group_rules[
+						efd_bin_to_group[current_choice]
+						[bin_id]], bin_id);
+				choice = efd_bin_choose(chunk, bin_id,
+						current_choice, bin_size, 1);
+				if (choice < 0)
+					return -ENOSPC;
+				if (choice != current_choice)
+					efd_bin_move(chunk,
+						on_chunk->bin_choice_list,
+						bin_id, current_choice, choice,
+						bin_size);
+
+				efd_group_add(&chunk->group_rules[
+						efd_bin_to_group[choice][bin_id]],
+						key_idx, old_group->value[i],
+						bin_id);
+			}
+		}
+	}
+
+	for (c = 0; c < online->num_chunks; c++) {
+		for (g = 0; g < EFD_CHUNK_NUM_GROUPS; g++) {
+			if (offline[c].group_rules[g].num_rules == 0 ||
+					efd_search_hash(table,
+					&offline[c].group_rules[g],
+					&online->chunks[c].groups[g]) == 0)
+				continue;
+			if (efd_fix_group(table, &offline[c],
+					&online->chunks[c], g) < 0) {
+				EFD_LOG(ERR, "Failed to find perfect hash "
+						"for group %u of chunk %u",
+						g, c);
+				return -ENOSPC;
+			}
+		}
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_efd_resize, 26.03)
+int
+rte_efd_resize(struct rte_efd_table * const table,
+		const uint32_t max_num_rules)
+{
+	struct efd_online_table *online[RTE_MAX_NUMA_NODES] = { NULL };
+	struct efd_online_table *first = NULL, *old;
+	struct efd_offline_chunk_rules *offline = NULL;
+	uint8_t *keys = NULL;
+	struct rte_ring *r = NULL;
+	char ring_name[RTE_RING_NAMESIZE];
+	uint32_t i, n, num_chunks, new_max_num_rules;
+	void *objs[RTE_EFD_BURST_MAX];
+	int ret = -ENOMEM;
+
+	if (table == NULL || max_num_rules == 0 ||
+			max_num_rules > UINT32_MAX / 2)
+		return -EINVAL;
+
+	num_chunks = efd_num_chunks(max_num_rules);
+	if (num_chunks > UINT32_MAX / EFD_TARGET_CHUNK_MAX_NUM_RULES)
+		return -EINVAL;
+
+	/* Only growth is supported */
+	if (num_chunks <= table->num_chunks)
+		return -EINVAL;
+
+	new_max_num_rules = num_chunks * EFD_TARGET_CHUNK_MAX_NUM_RULES;
+
+	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
+		if (efd_online_chunks(table, i) == NULL)
+			continue;
+		online[i] = efd_online_table_alloc(num_chunks, i);
+		if (online[i] == NULL)
+			goto error;
+		if (first == NULL)
+			first = online[i];
+	}
+
+	offline = rte_zmalloc_socket(NULL, num_chunks * sizeof(*offline),
+			RTE_CACHE_LINE_SIZE, table->offline_cpu_socket);
+	keys = rte_zmalloc_socket(NULL,
+			(size_t)new_max_num_rules * table->key_len,
+			RTE_CACHE_LINE_SIZE, table->offline_cpu_socket);
+	if (offline == NULL || keys == NULL) {
+		EFD_LOG(ERR, "Allocating EFD offline table on socket %u "
+				"failed", table->offline_cpu_socket);
+		goto error;
+	}
+
+	/* Ring names of two subsequent sizes have to differ */
+	if (snprintf(ring_name, sizeof(ring_name), "%s_%s",
+			(table->num_resizes & 1) ? "HT" : "HR", table->name)
+			>= (int)sizeof(ring_name))
+		EFD_LOG(NOTICE, "EFD ring name truncated to '%s'", ring_name);
+	r = rte_ring_create(ring_name, rte_align32pow2(new_max_num_rules),
+			table->offline_cpu_socket, 0);
+	if (r == NULL) {
+		EFD_LOG(ERR, "ring creation failed: %s",
+				rte_strerror(rte_errno));
+		goto error;
+	}
+
+	/* Lookups keep on running on the current online tables */
+	ret = efd_rebuild(table, offline, first);
+	if (ret != 0)
+		goto error;
+
+	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
+		if (online[i] != NULL && online[i] != first)
+			memcpy(online[i]->chunks, first->chunks,
+				num_chunks * sizeof(struct efd_online_chunk));
+	}
+
+	/* Move free slots to the new ring and add the new ones */
+	while ((n = rte_ring_sc_dequeue_burst(table->free_slots, objs,
+			RTE_DIM(objs), NULL)) != 0)
+		rte_ring_sp_enqueue_burst(r, objs, n, NULL);
+	for (i = table->max_num_rules; i < new_max_num_rules; i++)
+		rte_ring_sp_enqueue(r, (void *)((uintptr_t)i));
+
+	memcpy(keys, table->keys,
+			(size_t)table->max_num_rules * table->key_len);
+
+	/* Switch the lookups to the new online tables */
+	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
+		old = online[i];
+		online[i] = rte_atomic_exchange_explicit(&table->online[i],
+				old, rte_memory_order_release);
+	}
+
+	rte_free(table->offline_chunks);
+	rte_free(table->keys);
+	rte_ring_free(table->free_slots);
+
+	table->offline_chunks = offline;
+	table->keys = keys;
+	table->free_slots = r;
+	table->num_chunks = num_chunks;
+	table->num_chunks_shift = rte_bsf32(num_chunks);
+	table->max_num_rules = new_max_num_rules;
+	table->num_resizes++;
+
+	EFD_LOG(DEBUG, "Resized EFD table %s to %u chunks, "
+			"which potentially supports %u entries",
+			table->name, num_chunks, new_max_num_rules);
+
+	/* Wait for the lookups that may still use the old online tables */
+	if (table->v != NULL)
+		rte_rcu_qsbr_synchronize(table->v, RTE_QSBR_THRID_INVALID);
+
+	for (i = 0; i < RTE_MAX_NUMA_NODES; i++)
+		rte_free(online[i]);
+
+	return 0;
+
+error:
+	rte_ring_free(r);
+	rte_free(keys);
+	rte_free(offline);
+	for (i = 0; i < RTE_MAX_NUMA_NODES; i++)
+		rte_free(online[i]);
+	return ret;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_efd_rcu_qsbr_add, 26.03)
+int
+rte_efd_rcu_qsbr_add(struct rte_efd_table *table, struct rte_rcu_qsbr *v)
+{
+	if (table == NULL || v == NULL)
+		return -EINVAL;
+
+	if (table->v != NULL)
+		return -EEXIST;
+
+	table->v = v;
+	return 0;
+}
+
 static inline efd_value_t
 efd_lookup_internal_scalar(const efd_hashfunc_t *group_hash_idx,
 		const efd_lookuptbl_t *group_lookup_table,
@@ -1326,11 +2060,15 @@ rte_efd_lookup(const struct rte_efd_table * const table,
 	uint32_t chunk_id, group_id, bin_id;
 	uint8_t bin_choice;
 	const struct efd_online_group_entry *group;
-	const struct efd_online_chunk * const chunks = table->chunks[socket_id];
+	const struct efd_online_table * const online =
+			rte_atomic_load_explicit(&table->online[socket_id],
+					rte_memory_order_acquire);
+	const struct efd_online_chunk * const chunks = online->chunks;
 
 	/* Determine the chunk and group location for the given key */
-	efd_compute_ids(table, key, &chunk_id, &bin_id);
-	bin_choice = efd_get_choice(table, socket_id, chunk_id, bin_id);
+	efd_compute_online_ids(table, online, key, &chunk_id, &bin_id);
+	bin_choice = efd_choice_from_list(chunks[chunk_id].bin_choice_list,
+			bin_id);
 	group_id = efd_bin_to_group[bin_choice][bin_id];
 	group = &chunks[chunk_id].groups[group_id];
 
@@ -1350,19 +2088,23 @@ void rte_efd_lookup_bulk(const struct rte_efd_table * const table,
 	uint32_t bin_id_list[RTE_EFD_BURST_MAX];
 	uint8_t bin_choice_list[RTE_EFD_BURST_MAX];
 	uint32_t group_id_list[RTE_EFD_BURST_MAX];
-	struct efd_online_group_entry *group;
+	const struct efd_online_group_entry *group;
 
-	struct efd_online_chunk *chunks = table->chunks[socket_id];
+	const struct efd_online_table * const online =
+			rte_atomic_load_explicit(&table->online[socket_id],
+					rte_memory_order_acquire);
+	const struct efd_online_chunk * const chunks = online->chunks;
 
 	for (i = 0; i < num_keys; i++) {
-		efd_compute_ids(table, key_list[i], &chunk_id_list[i],
-				&bin_id_list[i]);
+		efd_compute_online_ids(table, online, key_list[i],
+				&chunk_id_list[i], &bin_id_list[i]);
 		rte_prefetch0(&chunks[chunk_id_list[i]].bin_choice_list);
 	}
 
 	for (i = 0; i < num_keys; i++) {
-		bin_choice_list[i] = efd_get_choice(table, socket_id,
-				chunk_id_list[i], bin_id_list[i]);
+		bin_choice_list[i] = efd_choice_from_list(
+				chunks[chunk_id_list[i]].bin_choice_list,
+				bin_id_list[i]);
 		group_id_list[i] =
 				efd_bin_to_group[bin_choice_list[i]][bin_id_list[i]];
 		group = &chunks[chunk_id_list[i]].groups[group_id_list[i]];
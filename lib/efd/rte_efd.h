@@ -13,6 +13,9 @@
 
 #include <stdint.h>
 
+#include <rte_compat.h>
+#include <rte_rcu_qsbr.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -201,6 +204,96 @@ int
 rte_efd_update(struct rte_efd_table *table, unsigned int socket_id,
 	const void *key, efd_value_t value);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Computes an updated table entry for several keys and updates the value
+ * of each key in the table.
+ * Keys are grouped by chunk, and the perfect hash of each modified group
+ * is searched once for all the keys of the batch, instead of once per key.
+ * If no perfect hash is found for a chunk, its keys are updated one by one,
+ * as with rte_efd_update().
+ * If the same key appears several times, the last value wins.
+ * This operation is not multi-thread safe
+ * and should only be called from one thread.
+ *
+ * @param table
+ *   EFD table to reference
+ * @param socket_id
+ *   Socket ID to use to lookup existing values (ideally caller's socket id)
+ * @param num_keys
+ *   Number of keys in the key_list array
+ * @param key_list
+ *   Array of num_keys pointers which point to keys to modify
+ * @param value_list
+ *   Array of num_keys values to associate with the keys
+ * @param status_list
+ *   If not NULL, array of num_keys where the status of each key update
+ *   is stored, with the same meaning as the return value of rte_efd_update()
+ *
+ * @return
+ *   Number of keys that failed with RTE_EFD_UPDATE_FAILED,
+ *   -EINVAL if the parameters are invalid,
+ *   -ENOMEM if the temporary memory could not be allocated
+ */
+__rte_experimental
+int
+rte_efd_update_bulk(struct rte_efd_table *table, unsigned int socket_id,
+	uint32_t num_keys, const void **key_list, const efd_value_t *value_list,
+	int *status_list);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Grows the table so that it can hold max_num_rules entries.
+ * All the keys are rehashed into new online and offline tables,
+ * which replace the current ones atomically once they are complete.
+ * Lookups can keep on running on other lcores during the resize;
+ * in that case the reader threads must report their quiescent states
+ * on the RCU QSBR variable attached with rte_efd_rcu_qsbr_add(),
+ * so that the old online tables are freed only once no lookup uses them.
+ * This operation is not multi-thread safe with the other table updates.
+ *
+ * @param table
+ *   EFD table to resize
+ * @param max_num_rules
+ *   New minimum number of rules the table must hold,
+ *   the number of chunks must grow for this to succeed
+ *
+ * @return
+ *   0 on success, the table is unchanged on failure:
+ *   -EINVAL if the parameters are invalid or the table would not grow,
+ *   -ENOMEM if the new tables could not be allocated,
+ *   -ENOSPC if no perfect hash could be found for the new tables
+ */
+__rte_experimental
+int
+rte_efd_resize(struct rte_efd_table *table, uint32_t max_num_rules);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Associate RCU QSBR variable with an EFD table.
+ * rte_efd_resize() waits for a grace period on this variable
+ * before freeing the online tables it replaced.
+ *
+ * @param table
+ *   EFD table
+ * @param v
+ *   RCU QSBR variable
+ *
+ * @return
+ *   0 on success,
+ *   -EINVAL if the parameters are invalid,
+ *   -EEXIST if a variable is already associated
+ */
+__rte_experimental
+int
+rte_efd_rcu_qsbr_add(struct rte_efd_table *table, struct rte_rcu_qsbr *v);
+
 /**
  * Removes any value currently associated with the specified key from the table
  * This operation is not multi-thread safe
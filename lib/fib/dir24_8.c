@@ -25,6 +25,13 @@
 
 #include "dir24_8_rvv.h"
 
+#elif defined(RTE_ARCH_ARM64)
+
+#include "dir24_8_neon.h"
+#ifdef RTE_HAS_SVE_ACLE
+#include "dir24_8_sve.h"
+#endif
+
 #endif /* CC_AVX512_SUPPORT */
 
 #define DIR24_8_NAMESIZE	64
@@ -116,6 +123,67 @@ get_vector_fn(enum rte_fib_dir24_8_nh_sz nh_sz, bool be_addr)
 	return NULL;
 }
 
+static inline rte_fib_lookup_fn_t
+get_neon_fn(enum rte_fib_dir24_8_nh_sz nh_sz, bool be_addr)
+{
+#ifdef RTE_ARCH_ARM64
+	if (rte_vect_get_max_simd_bitwidth() < RTE_VECT_SIMD_128)
+		return NULL;
+
+	switch (nh_sz) {
+	case RTE_FIB_DIR24_8_1B:
+		return be_addr ? rte_dir24_8_neon_lookup_bulk_1b_be :
+			rte_dir24_8_neon_lookup_bulk_1b;
+	case RTE_FIB_DIR24_8_2B:
+		return be_addr ? rte_dir24_8_neon_lookup_bulk_2b_be :
+			rte_dir24_8_neon_lookup_bulk_2b;
+	case RTE_FIB_DIR24_8_4B:
+		return be_addr ? rte_dir24_8_neon_lookup_bulk_4b_be :
+			rte_dir24_8_neon_lookup_bulk_4b;
+	case RTE_FIB_DIR24_8_8B:
+		return be_addr ? rte_dir24_8_neon_lookup_bulk_8b_be :
+			rte_dir24_8_neon_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+#else
+	RTE_SET_USED(nh_sz);
+	RTE_SET_USED(be_addr);
+#endif
+	return NULL;
+}
+
+static inline rte_fib_lookup_fn_t
+get_sve_fn(enum rte_fib_dir24_8_nh_sz nh_sz, bool be_addr)
+{
+#ifdef RTE_HAS_SVE_ACLE
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_SVE) <= 0 ||
+			rte_vect_get_max_simd_bitwidth() < RTE_VECT_SIMD_128)
+		return NULL;
+
+	switch (nh_sz) {
+	case RTE_FIB_DIR24_8_1B:
+		return be_addr ? rte_dir24_8_sve_lookup_bulk_1b_be :
+			rte_dir24_8_sve_lookup_bulk_1b;
+	case RTE_FIB_DIR24_8_2B:
+		return be_addr ? rte_dir24_8_sve_lookup_bulk_2b_be :
+			rte_dir24_8_sve_lookup_bulk_2b;
+	case RTE_FIB_DIR24_8_4B:
+		return be_addr ? rte_dir24_8_sve_lookup_bulk_4b_be :
+			rte_dir24_8_sve_lookup_bulk_4b;
+	case RTE_FIB_DIR24_8_8B:
+		return be_addr ? rte_dir24_8_sve_lookup_bulk_8b_be :
+			rte_dir24_8_sve_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+#else
+	RTE_SET_USED(nh_sz);
+	RTE_SET_USED(be_addr);
+#endif
+	return NULL;
+}
+
 rte_fib_lookup_fn_t
 dir24_8_get_lookup_fn(void *p, enum rte_fib_lookup_type type, bool be_addr)
 {
@@ -137,8 +205,16 @@ dir24_8_get_lookup_fn(void *p, enum rte_fib_lookup_type type, bool be_addr)
 		return be_addr ? dir24_8_lookup_bulk_uni_be : dir24_8_lookup_bulk_uni;
 	case RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512:
 		return get_vector_fn(nh_sz, be_addr);
+	case RTE_FIB_LOOKUP_DIR24_8_VECTOR_NEON:
+		return get_neon_fn(nh_sz, be_addr);
+	case RTE_FIB_LOOKUP_DIR24_8_VECTOR_SVE:
+		return get_sve_fn(nh_sz, be_addr);
 	case RTE_FIB_LOOKUP_DEFAULT:
 		ret_fn = get_vector_fn(nh_sz, be_addr);
+		if (ret_fn == NULL)
+			ret_fn = get_sve_fn(nh_sz, be_addr);
+		if (ret_fn == NULL)
+			ret_fn = get_neon_fn(nh_sz, be_addr);
 		return ret_fn != NULL ? ret_fn : get_scalar_fn(nh_sz, be_addr);
 	default:
 		return NULL;
@@ -313,9 +389,24 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 	}
 }
 
+/*
+ * Collapse the tbl8 group of the /24 containing ip back into tbl24,
+ * if its entries were all set to the same value.
+ * Used to finish the recycle postponed by install_to_fib().
+ */
+static void
+tbl8_recycle_deferred(struct dir24_8_tbl *dp, uint32_t ip)
+{
+	uint64_t tbl24_tmp;
+
+	tbl24_tmp = get_tbl24(dp, ip, dp->nh_sz);
+	if (is_entry_extended(tbl24_tmp))
+		tbl8_recycle(dp, ip, tbl24_tmp >> 1);
+}
+
 static int
 install_to_fib(struct dir24_8_tbl *dp, uint32_t ledge, uint32_t redge,
-	uint64_t next_hop)
+	uint64_t next_hop, bool defer_recycle)
 {
 	uint64_t	tbl24_tmp;
 	int	tbl8_idx;
@@ -409,14 +500,15 @@ install_to_fib(struct dir24_8_tbl *dp, uint32_t ledge, uint32_t redge,
 		write_to_fib((void *)tbl8_ptr, (next_hop << 1)|
 			DIR24_8_EXT_ENT,
 			dp->nh_sz, redge - ledge);
-		tbl8_recycle(dp, ledge, tbl8_idx);
+		if (!defer_recycle)
+			tbl8_recycle(dp, ledge, tbl8_idx);
 	}
 	return 0;
 }
 
 static int
 modify_fib(struct dir24_8_tbl *dp, struct rte_rib *rib, uint32_t ip,
-	uint8_t depth, uint64_t next_hop)
+	uint8_t depth, uint64_t next_hop, bool defer_recycle)
 {
 	struct rte_rib_node *tmp = NULL;
 	uint32_t ledge, redge, tmp_ip;
@@ -439,7 +531,7 @@ modify_fib(struct dir24_8_tbl *dp, struct rte_rib *rib, uint32_t ip,
 				continue;
 			}
 			ret = install_to_fib(dp, ledge, redge,
-				next_hop);
+				next_hop, defer_recycle);
 			if (ret != 0)
 				return ret;
 			ledge = redge +
@@ -455,7 +547,7 @@ modify_fib(struct dir24_8_tbl *dp, struct rte_rib *rib, uint32_t ip,
 			if (ledge == redge && ledge != 0)
 				break;
 			ret = install_to_fib(dp, ledge, redge,
-				next_hop);
+				next_hop, defer_recycle);
 			if (ret != 0)
 				return ret;
 		}
@@ -464,6 +556,53 @@ modify_fib(struct dir24_8_tbl *dp, struct rte_rib *rib, uint32_t ip,
 	return 0;
 }
 
+static int
+dir24_8_add(struct dir24_8_tbl *dp, struct rte_rib *rib,
+	struct rte_rib_node *node, uint32_t ip, uint8_t depth,
+	uint64_t next_hop, bool defer_recycle)
+{
+	struct rte_rib_node *tmp = NULL;
+	struct rte_rib_node *parent;
+	uint64_t par_nh, node_nh;
+	int ret;
+
+	if (node != NULL) {
+		rte_rib_get_nh(node, &node_nh);
+		if (node_nh == next_hop)
+			return 0;
+		ret = modify_fib(dp, rib, ip, depth, next_hop, defer_recycle);
+		if (ret == 0)
+			rte_rib_set_nh(node, next_hop);
+		return 0;
+	}
+	if (depth > 24) {
+		tmp = rte_rib_get_nxt(rib, ip, 24, NULL,
+			RTE_RIB_GET_NXT_COVER);
+		if ((tmp == NULL) &&
+			(dp->rsvd_tbl8s >= dp->number_tbl8s))
+			return -ENOSPC;
+
+	}
+	node = rte_rib_insert(rib, ip, depth);
+	if (node == NULL)
+		return -rte_errno;
+	rte_rib_set_nh(node, next_hop);
+	parent = rte_rib_lookup_parent(node);
+	if (parent != NULL) {
+		rte_rib_get_nh(parent, &par_nh);
+		if (par_nh == next_hop)
+			return 0;
+	}
+	ret = modify_fib(dp, rib, ip, depth, next_hop, defer_recycle);
+	if (ret != 0) {
+		rte_rib_remove(rib, ip, depth);
+		return ret;
+	}
+	if ((depth > 24) && (tmp == NULL))
+		dp->rsvd_tbl8s++;
+	return 0;
+}
+
 int
 dir24_8_modify(struct rte_fib *fib, uint32_t ip, uint8_t depth,
 	uint64_t next_hop, int op)
@@ -491,41 +630,7 @@ dir24_8_modify(struct rte_fib *fib, uint32_t ip, uint8_t depth,
 	node = rte_rib_lookup_exact(rib, ip, depth);
 	switch (op) {
 	case RTE_FIB_ADD:
-		if (node != NULL) {
-			rte_rib_get_nh(node, &node_nh);
-			if (node_nh == next_hop)
-				return 0;
-			ret = modify_fib(dp, rib, ip, depth, next_hop);
-			if (ret == 0)
-				rte_rib_set_nh(node, next_hop);
-			return 0;
-		}
-		if (depth > 24) {
-			tmp = rte_rib_get_nxt(rib, ip, 24, NULL,
-				RTE_RIB_GET_NXT_COVER);
-			if ((tmp == NULL) &&
-				(dp->rsvd_tbl8s >= dp->number_tbl8s))
-				return -ENOSPC;
-
-		}
-		node = rte_rib_insert(rib, ip, depth);
-		if (node == NULL)
-			return -rte_errno;
-		rte_rib_set_nh(node, next_hop);
-		parent = rte_rib_lookup_parent(node);
-		if (parent != NULL) {
-			rte_rib_get_nh(parent, &par_nh);
-			if (par_nh == next_hop)
-				return 0;
-		}
-		ret = modify_fib(dp, rib, ip, depth, next_hop);
-		if (ret != 0) {
-			rte_rib_remove(rib, ip, depth);
-			return ret;
-		}
-		if ((depth > 24) && (tmp == NULL))
-			dp->rsvd_tbl8s++;
-		return 0;
+		return dir24_8_add(dp, rib, node, ip, depth, next_hop, false);
 	case RTE_FIB_DEL:
 		if (node == NULL)
 			return -ENOENT;
@@ -535,9 +640,11 @@ dir24_8_modify(struct rte_fib *fib, uint32_t ip, uint8_t depth,
 			rte_rib_get_nh(parent, &par_nh);
 			rte_rib_get_nh(node, &node_nh);
 			if (par_nh != node_nh)
-				ret = modify_fib(dp, rib, ip, depth, par_nh);
+				ret = modify_fib(dp, rib, ip, depth, par_nh,
+					false);
 		} else
-			ret = modify_fib(dp, rib, ip, depth, dp->def_nh);
+			ret = modify_fib(dp, rib, ip, depth, dp->def_nh,
+				false);
 		if (ret == 0) {
 			rte_rib_remove(rib, ip, depth);
 			if (depth > 24) {
@@ -554,6 +661,79 @@ dir24_8_modify(struct rte_fib *fib, uint32_t ip, uint8_t depth,
 	return -EINVAL;
 }
 
+int
+dir24_8_add_bulk(struct rte_fib *fib, const struct rte_fib_route *routes,
+	unsigned int n)
+{
+	struct dir24_8_tbl *dp;
+	struct rte_rib *rib;
+	struct rte_rib_node *node;
+	uint32_t i, ip, new_tbl8s;
+	uint32_t prev_ip = 0;
+	bool pending = false;
+	int ret = 0;
+
+	if ((fib == NULL) || ((routes == NULL) && (n != 0)))
+		return -EINVAL;
+
+	dp = rte_fib_get_dp(fib);
+	rib = rte_fib_get_rib(fib);
+	RTE_ASSERT((dp != NULL) && (rib != NULL));
+
+	/*
+	 * Routes are sorted by rte_fib_bulk_prepare(), so the prefixes
+	 * longer than /24 come last, grouped by their /24.
+	 * Count the tbl8 groups the batch needs and fail before
+	 * touching the tables if there are not enough of them left.
+	 */
+	new_tbl8s = 0;
+	for (i = 0; i < n; i++) {
+		if ((routes[i].depth > RTE_FIB_MAXDEPTH) ||
+				(routes[i].next_hop > get_max_nh(dp->nh_sz)))
+			return -EINVAL;
+		if (routes[i].depth <= 24)
+			continue;
+		ip = routes[i].ip & DIR24_8_TBL24_MASK;
+		if (pending && (ip == prev_ip))
+			continue;
+		pending = true;
+		prev_ip = ip;
+		if (rte_rib_get_nxt(rib, ip, 24, NULL,
+				RTE_RIB_GET_NXT_COVER) == NULL)
+			new_tbl8s++;
+	}
+	if (dp->rsvd_tbl8s + new_tbl8s > dp->number_tbl8s)
+		return -ENOSPC;
+
+	/*
+	 * Routes falling into the same tbl8 group are installed one after
+	 * another, so check whether the group can be collapsed back into
+	 * tbl24 only once the last of them is written.
+	 */
+	pending = false;
+	for (i = 0; i < n; i++) {
+		ip = routes[i].ip & rte_rib_depth_to_mask(routes[i].depth);
+		if (pending && ((routes[i].depth <= 24) ||
+				((ip & DIR24_8_TBL24_MASK) != prev_ip))) {
+			tbl8_recycle_deferred(dp, prev_ip);
+			pending = false;
+		}
+		node = rte_rib_lookup_exact(rib, ip, routes[i].depth);
+		ret = dir24_8_add(dp, rib, node, ip, routes[i].depth,
+			routes[i].next_hop, routes[i].depth > 24);
+		if (ret != 0)
+			break;
+		if (routes[i].depth > 24) {
+			pending = true;
+			prev_ip = ip & DIR24_8_TBL24_MASK;
+		}
+	}
+	if (pending)
+		tbl8_recycle_deferred(dp, prev_ip);
+
+	return ret;
+}
+
 void *
 dir24_8_create(const char *name, int socket_id, struct rte_fib_conf *fib_conf)
 {
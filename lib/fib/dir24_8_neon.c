@@ -0,0 +1,157 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+#include <rte_fib.h>
+
+#include "dir24_8.h"
+#include "dir24_8_neon.h"
+
+/*
+ * NEON has no gather instruction, so the table entries of the 4 lanes
+ * are loaded one by one, while the index computations, the extended
+ * entry checks and the next hop conversions are done on vectors.
+ */
+
+static __rte_always_inline uint32x4_t
+load_ips_x4(const uint32_t *ips, bool be_addr)
+{
+	uint32x4_t ip = vld1q_u32(ips);
+
+	if (be_addr)
+		ip = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(ip)));
+	return ip;
+}
+
+static __rte_always_inline uint32_t
+get_ent(const uint64_t *tbl, uint32_t idx, int size)
+{
+	if (size == sizeof(uint8_t))
+		return ((const uint8_t *)tbl)[idx];
+	else if (size == sizeof(uint16_t))
+		return ((const uint16_t *)tbl)[idx];
+	return ((const uint32_t *)tbl)[idx];
+}
+
+static __rte_always_inline void
+dir24_8_neon_lookup_x4(const struct dir24_8_tbl *dp, const uint32_t *ips,
+	uint64_t *next_hops, int size, bool be_addr)
+{
+	const uint32x4_t ext = vdupq_n_u32(DIR24_8_EXT_ENT);
+	uint32x4_t ip, idx, res;
+	uint32_t idxes[4], ents[4];
+	unsigned int i;
+
+	ip = load_ips_x4(ips, be_addr);
+
+	/* lookup in tbl24 */
+	idx = vshrq_n_u32(ip, 8);
+	vst1q_u32(idxes, idx);
+	for (i = 0; i < RTE_DIM(ents); i++)
+		ents[i] = get_ent(dp->tbl24, idxes[i], size);
+	res = vld1q_u32(ents);
+
+	/* lookup in tbl8 for the extended entries */
+	if (vmaxvq_u32(vandq_u32(res, ext)) != 0) {
+		idx = vaddq_u32(vshlq_n_u32(vshrq_n_u32(res, 1), 8),
+			vandq_u32(ip, vdupq_n_u32(UINT8_MAX)));
+		vst1q_u32(idxes, idx);
+		for (i = 0; i < RTE_DIM(ents); i++) {
+			if (ents[i] & DIR24_8_EXT_ENT)
+				ents[i] = get_ent(dp->tbl8, idxes[i], size);
+		}
+		res = vld1q_u32(ents);
+	}
+
+	res = vshrq_n_u32(res, 1);
+	vst1q_u64(next_hops, vmovl_u32(vget_low_u32(res)));
+	vst1q_u64(next_hops + 2, vmovl_high_u32(res));
+}
+
+static __rte_always_inline void
+dir24_8_neon_lookup_x4_8b(const struct dir24_8_tbl *dp, const uint32_t *ips,
+	uint64_t *next_hops, bool be_addr)
+{
+	const uint64x2_t ext = vdupq_n_u64(DIR24_8_EXT_ENT);
+	uint32x4_t ip;
+	uint64x2_t res_lo, res_hi;
+	uint32_t ip_arr[4];
+	uint64_t ents[4];
+	unsigned int i;
+
+	ip = load_ips_x4(ips, be_addr);
+	vst1q_u32(ip_arr, ip);
+
+	/* lookup in tbl24 */
+	for (i = 0; i < RTE_DIM(ents); i++)
+		ents[i] = dp->tbl24[ip_arr[i] >> 8];
+	res_lo = vld1q_u64(ents);
+	res_hi = vld1q_u64(ents + 2);
+
+	/* lookup in tbl8 for the extended entries */
+	if (vmaxvq_u32(vreinterpretq_u32_u64(vorrq_u64(vandq_u64(res_lo, ext),
+			vandq_u64(res_hi, ext)))) != 0) {
+		for (i = 0; i < RTE_DIM(ents); i++) {
+			if (ents[i] & DIR24_8_EXT_ENT)
+				ents[i] = dp->tbl8[(ents[i] >> 1) *
+					DIR24_8_TBL8_GRP_NUM_ENT +
+					(uint8_t)ip_arr[i]];
+		}
+		res_lo = vld1q_u64(ents);
+		res_hi = vld1q_u64(ents + 2);
+	}
+
+	vst1q_u64(next_hops, vshrq_n_u64(res_lo, 1));
+	vst1q_u64(next_hops + 2, vshrq_n_u64(res_hi, 1));
+}
+
+static __rte_always_inline void
+dir24_8_neon_lookup_bulk(void *p, const uint32_t *ips, uint64_t *next_hops,
+	const unsigned int n, int size, bool be_addr)
+{
+	struct dir24_8_tbl *dp = (struct dir24_8_tbl *)p;
+	uint8_t nh_sz = dp->nh_sz;
+	uint32_t i, j, ip;
+	uint64_t tmp;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		/* prefetch tbl24 entries of the IPs two iterations ahead */
+		for (j = i + 8; (j < i + 12) && (j < n); j++) {
+			ip = be_addr ? rte_be_to_cpu_32(ips[j]) : ips[j];
+			rte_prefetch0(get_tbl24_p(dp, ip, nh_sz));
+		}
+		if (size == sizeof(uint64_t))
+			dir24_8_neon_lookup_x4_8b(dp, ips + i, next_hops + i,
+				be_addr);
+		else
+			dir24_8_neon_lookup_x4(dp, ips + i, next_hops + i,
+				size, be_addr);
+	}
+
+	/* lookup remaining IPs */
+	for (; i < n; i++) {
+		ip = be_addr ? rte_be_to_cpu_32(ips[i]) : ips[i];
+		tmp = get_tbl24(dp, ip, nh_sz);
+		if (unlikely(is_entry_extended(tmp)))
+			tmp = get_tbl8(dp, tmp, ip, nh_sz);
+		next_hops[i] = tmp >> 1;
+	}
+}
+
+#define DECLARE_NEON_FN(suffix, size, be_addr) \
+void \
+rte_dir24_8_neon_lookup_bulk_##suffix(void *p, const uint32_t *ips, \
+	uint64_t *next_hops, const unsigned int n) \
+{ \
+	dir24_8_neon_lookup_bulk(p, ips, next_hops, n, size, be_addr); \
+}
+
+DECLARE_NEON_FN(1b, sizeof(uint8_t), false)
+DECLARE_NEON_FN(2b, sizeof(uint16_t), false)
+DECLARE_NEON_FN(4b, sizeof(uint32_t), false)
+DECLARE_NEON_FN(8b, sizeof(uint64_t), false)
+DECLARE_NEON_FN(1b_be, sizeof(uint8_t), true)
+DECLARE_NEON_FN(2b_be, sizeof(uint16_t), true)
+DECLARE_NEON_FN(4b_be, sizeof(uint32_t), true)
+DECLARE_NEON_FN(8b_be, sizeof(uint64_t), true)
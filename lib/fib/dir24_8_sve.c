@@ -0,0 +1,113 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+#include <rte_fib.h>
+
+#include "dir24_8.h"
+#include "dir24_8_sve.h"
+
+static __rte_always_inline svuint32_t
+gather_x32(svbool_t pg, const uint64_t *tbl, svuint32_t idx, int size)
+{
+	if (size == sizeof(uint8_t))
+		return svld1ub_gather_u32offset_u32(pg, (const uint8_t *)tbl,
+			idx);
+	else if (size == sizeof(uint16_t))
+		return svld1uh_gather_u32index_u32(pg, (const uint16_t *)tbl,
+			idx);
+	return svld1_gather_u32index_u32(pg, (const uint32_t *)tbl, idx);
+}
+
+/* lookup with 32 bit lanes, for next hops up to 4 bytes */
+static __rte_always_inline void
+dir24_8_sve_lookup_bulk_x32(struct dir24_8_tbl *dp, const uint32_t *ips,
+	uint64_t *next_hops, const unsigned int n, int size, bool be_addr)
+{
+	svuint32_t ip, idx, res;
+	svbool_t pg, pe;
+	uint32_t i;
+
+	for (i = 0; i < n; i += svcntw()) {
+		pg = svwhilelt_b32_u32(i, n);
+		ip = svld1_u32(pg, &ips[i]);
+		if (be_addr)
+			ip = svrevb_u32_x(pg, ip);
+
+		/* lookup in tbl24 */
+		res = gather_x32(pg, dp->tbl24, svlsr_n_u32_x(pg, ip, 8), size);
+
+		/* lookup in tbl8 for the extended entries */
+		pe = svcmpne_n_u32(pg, svand_n_u32_x(pg, res, DIR24_8_EXT_ENT), 0);
+		if (svptest_any(pg, pe)) {
+			idx = svadd_u32_x(pe,
+				svlsl_n_u32_x(pe, svlsr_n_u32_x(pe, res, 1), 8),
+				svand_n_u32_x(pe, ip, UINT8_MAX));
+			res = svsel_u32(pe, gather_x32(pe, dp->tbl8, idx, size),
+				res);
+		}
+
+		res = svlsr_n_u32_x(pg, res, 1);
+		svst1_u64(svwhilelt_b64_u32(i, n), &next_hops[i],
+			svunpklo_u64(res));
+		svst1_u64(svwhilelt_b64_u32(i + svcntd(), n),
+			&next_hops[i + svcntd()], svunpkhi_u64(res));
+	}
+}
+
+/* lookup with 64 bit lanes, for 8 bytes next hops */
+static __rte_always_inline void
+dir24_8_sve_lookup_bulk_x64(struct dir24_8_tbl *dp, const uint32_t *ips,
+	uint64_t *next_hops, const unsigned int n, bool be_addr)
+{
+	svuint64_t ip, idx, res;
+	svbool_t pg, pe;
+	uint32_t i;
+
+	for (i = 0; i < n; i += svcntd()) {
+		pg = svwhilelt_b64_u32(i, n);
+		ip = svld1uw_u64(pg, &ips[i]);
+		if (be_addr)
+			ip = svlsr_n_u64_x(pg, svrevb_u64_x(pg, ip), 32);
+
+		/* lookup in tbl24 */
+		res = svld1_gather_u64index_u64(pg, dp->tbl24,
+			svlsr_n_u64_x(pg, ip, 8));
+
+		/* lookup in tbl8 for the extended entries */
+		pe = svcmpne_n_u64(pg, svand_n_u64_x(pg, res, DIR24_8_EXT_ENT), 0);
+		if (svptest_any(pg, pe)) {
+			idx = svadd_u64_x(pe,
+				svlsl_n_u64_x(pe, svlsr_n_u64_x(pe, res, 1), 8),
+				svand_n_u64_x(pe, ip, UINT8_MAX));
+			res = svsel_u64(pe,
+				svld1_gather_u64index_u64(pe, dp->tbl8, idx), res);
+		}
+
+		svst1_u64(pg, &next_hops[i], svlsr_n_u64_x(pg, res, 1));
+	}
+}
+
+#define DECLARE_SVE_FN(suffix, size, be_addr) \
+void \
+rte_dir24_8_sve_lookup_bulk_##suffix(void *p, const uint32_t *ips, \
+	uint64_t *next_hops, const unsigned int n) \
+{ \
+	struct dir24_8_tbl *dp = (struct dir24_8_tbl *)p; \
+ \
+	if (size == sizeof(uint64_t)) \
+		dir24_8_sve_lookup_bulk_x64(dp, ips, next_hops, n, be_addr); \
+	else \
+		dir24_8_sve_lookup_bulk_x32(dp, ips, next_hops, n, size, \
+			be_addr); \
+}
+
+DECLARE_SVE_FN(1b, sizeof(uint8_t), false)
+DECLARE_SVE_FN(2b, sizeof(uint16_t), false)
+DECLARE_SVE_FN(4b, sizeof(uint32_t), false)
+DECLARE_SVE_FN(8b, sizeof(uint64_t), false)
+DECLARE_SVE_FN(1b_be, sizeof(uint8_t), true)
+DECLARE_SVE_FN(2b_be, sizeof(uint16_t), true)
+DECLARE_SVE_FN(4b_be, sizeof(uint32_t), true)
+DECLARE_SVE_FN(8b_be, sizeof(uint64_t), true)
@@ -0,0 +1,995 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_debug.h>
+#include <rte_malloc.h>
+#include <rte_cpuflags.h>
+#include <rte_errno.h>
+#include <rte_vect.h>
+
+#include <rte_rib6.h>
+#include <rte_fib6.h>
+#include "fib_log.h"
+#include "poptrie.h"
+
+#ifdef RTE_ARCH_X86_64
+#include "poptrie_avx2.h"
+#endif
+
+#ifdef CC_AVX512_SUPPORT
+#include "poptrie_avx512.h"
+#endif
+
+#define POPTRIE_NAMESIZE	64
+/* end of a free list */
+#define POPTRIE_NIL		UINT32_MAX
+/* maximum number of nodes or leaves */
+#define POPTRIE_MAX_ENT		(1U << 31)
+
+/* pool of a block pushed to the RCU defer queue */
+enum {
+	POPTRIE_NODE_POOL,
+	POPTRIE_LEAF_POOL
+};
+
+static inline uint64_t
+get_max_nh(uint8_t nh_sz)
+{
+	return (1ULL << ((8 << nh_sz) - 1)) - 1;
+}
+
+static inline rte_fib6_lookup_fn_t
+get_scalar_fn(enum rte_fib_trie_nh_sz nh_sz)
+{
+	switch (nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return rte_poptrie_lookup_bulk_2b;
+	case RTE_FIB6_TRIE_4B:
+		return rte_poptrie_lookup_bulk_4b;
+	case RTE_FIB6_TRIE_8B:
+		return rte_poptrie_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+}
+
+static inline rte_fib6_lookup_fn_t
+get_avx2_fn(enum rte_fib_trie_nh_sz nh_sz)
+{
+#ifdef RTE_ARCH_X86_64
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) <= 0 ||
+			rte_vect_get_max_simd_bitwidth() < RTE_VECT_SIMD_256)
+		return NULL;
+	switch (nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return rte_poptrie_avx2_lookup_bulk_2b;
+	case RTE_FIB6_TRIE_4B:
+		return rte_poptrie_avx2_lookup_bulk_4b;
+	case RTE_FIB6_TRIE_8B:
+		return rte_poptrie_avx2_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+#else
+	RTE_SET_USED(nh_sz);
+#endif
+	return NULL;
+}
+
+static inline rte_fib6_lookup_fn_t
+get_vector_fn(enum rte_fib_trie_nh_sz nh_sz)
+{
+#ifdef CC_AVX512_SUPPORT
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) <= 0 ||
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW) <= 0 ||
+			rte_vect_get_max_simd_bitwidth() < RTE_VECT_SIMD_512)
+		return NULL;
+	switch (nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return rte_poptrie_vec_lookup_bulk_2b;
+	case RTE_FIB6_TRIE_4B:
+		return rte_poptrie_vec_lookup_bulk_4b;
+	case RTE_FIB6_TRIE_8B:
+		return rte_poptrie_vec_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+#else
+	RTE_SET_USED(nh_sz);
+#endif
+	return NULL;
+}
+
+rte_fib6_lookup_fn_t
+poptrie_get_lookup_fn(void *p, enum rte_fib6_lookup_type type)
+{
+	enum rte_fib_trie_nh_sz nh_sz;
+	rte_fib6_lookup_fn_t ret_fn;
+	struct rte_poptrie_tbl *dp = p;
+
+	if (dp == NULL)
+		return NULL;
+
+	nh_sz = dp->nh_sz;
+
+	switch (type) {
+	case RTE_FIB6_LOOKUP_POPTRIE_SCALAR:
+		return get_scalar_fn(nh_sz);
+	case RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX2:
+		return get_avx2_fn(nh_sz);
+	case RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX512:
+		return get_vector_fn(nh_sz);
+	case RTE_FIB6_LOOKUP_DEFAULT:
+		ret_fn = get_vector_fn(nh_sz);
+		if (ret_fn == NULL)
+			ret_fn = get_avx2_fn(nh_sz);
+		return (ret_fn != NULL) ? ret_fn : get_scalar_fn(nh_sz);
+	default:
+		return NULL;
+	}
+	return NULL;
+}
+
+static void
+pool_push(struct poptrie_pool *pool, uint32_t idx, uint32_t order)
+{
+	uint32_t head = pool->head[order];
+
+	pool->next[idx] = head;
+	pool->prev[idx] = POPTRIE_NIL;
+	if (head != POPTRIE_NIL)
+		pool->prev[head] = idx;
+	pool->head[order] = idx;
+	pool->order[idx] = order + 1;
+}
+
+static void
+pool_unlink(struct poptrie_pool *pool, uint32_t idx, uint32_t order)
+{
+	if (pool->prev[idx] != POPTRIE_NIL)
+		pool->next[pool->prev[idx]] = pool->next[idx];
+	else
+		pool->head[order] = pool->next[idx];
+	if (pool->next[idx] != POPTRIE_NIL)
+		pool->prev[pool->next[idx]] = pool->prev[idx];
+	pool->order[idx] = 0;
+}
+
+/*
+ * Get a block of 2^order entries from the pool,
+ * splitting a larger block if there is no free block of this order
+ */
+static int64_t
+pool_get(struct poptrie_pool *pool, uint32_t order)
+{
+	uint32_t idx, k;
+
+	for (k = order; k <= POPTRIE_MAX_ORDER; k++) {
+		if (pool->head[k] != POPTRIE_NIL)
+			break;
+	}
+	if (k > POPTRIE_MAX_ORDER)
+		return -ENOSPC;
+
+	idx = pool->head[k];
+	pool_unlink(pool, idx, k);
+	while (k > order) {
+		k--;
+		pool_push(pool, idx + (1 << k), k);
+	}
+	pool->used += 1 << order;
+	return idx;
+}
+
+/*
+ * Put a block back to the pool, merging it with its free buddies
+ */
+static void
+pool_put(struct poptrie_pool *pool, uint32_t idx, uint32_t order)
+{
+	uint32_t buddy;
+
+	pool->used -= 1 << order;
+	for (; order < POPTRIE_MAX_ORDER; order++) {
+		buddy = idx ^ (1 << order);
+		if (pool->order[buddy] != order + 1)
+			break;
+		pool_unlink(pool, buddy, order);
+		idx &= ~(1 << order);
+	}
+	pool_push(pool, idx, order);
+}
+
+static int
+pool_init(struct poptrie_pool *pool, uint32_t size, const char *name,
+	int socket_id)
+{
+	char mem_name[POPTRIE_NAMESIZE];
+	uint32_t i;
+
+	pool->size = size;
+	pool->used = 0;
+	snprintf(mem_name, sizeof(mem_name), "%s_next", name);
+	pool->next = rte_malloc_socket(mem_name, sizeof(uint32_t) * size,
+		RTE_CACHE_LINE_SIZE, socket_id);
+	snprintf(mem_name, sizeof(mem_name), "%s_prev", name);
+	pool->prev = rte_malloc_socket(mem_name, sizeof(uint32_t) * size,
+		RTE_CACHE_LINE_SIZE, socket_id);
+	snprintf(mem_name, sizeof(mem_name), "%s_order", name);
+	pool->order = rte_zmalloc_socket(mem_name, size,
+		RTE_CACHE_LINE_SIZE, socket_id);
+	if (pool->next == NULL || pool->prev == NULL || pool->order == NULL)
+		return -ENOMEM;
+
+	for (i = 0; i <= POPTRIE_MAX_ORDER; i++)
+		pool->head[i] = POPTRIE_NIL;
+	/* put the blocks so that the lowest indexes are used first */
+	for (i = size; i > 0; i -= POPTRIE_NODE_NUM_ENT)
+		pool_push(pool, i - POPTRIE_NODE_NUM_ENT, POPTRIE_MAX_ORDER);
+	return 0;
+}
+
+static void
+pool_free(struct poptrie_pool *pool)
+{
+	rte_free(pool->order);
+	rte_free(pool->prev);
+	rte_free(pool->next);
+}
+
+static inline struct poptrie_pool *
+get_pool(struct rte_poptrie_tbl *dp, int pool_id)
+{
+	return (pool_id == POPTRIE_NODE_POOL) ? &dp->node_pool :
+		&dp->leaf_pool;
+}
+
+/*
+ * Allocate n contiguous nodes or leaves
+ */
+static int64_t
+blk_alloc(struct rte_poptrie_tbl *dp, int pool_id, uint32_t n)
+{
+	struct poptrie_pool *pool = get_pool(dp, pool_id);
+	uint32_t order = rte_log2_u32(n);
+	int64_t idx;
+
+	idx = pool_get(pool, order);
+
+	/* If the pool is exhausted try to reclaim some blocks. */
+	if (unlikely(idx == -ENOSPC && dp->dq &&
+			!rte_rcu_qsbr_dq_reclaim(dp->dq, UINT32_MAX,
+				NULL, NULL, NULL)))
+		idx = pool_get(pool, order);
+
+	return idx;
+}
+
+/*
+ * Free n contiguous nodes or leaves. Blocks that may still be accessed
+ * by the readers are deferred if a defer queue is configured,
+ * the caller waits for the readers in blocking mode.
+ */
+static void
+blk_free(struct rte_poptrie_tbl *dp, int pool_id, uint32_t idx, uint32_t n,
+	bool defer)
+{
+	uint64_t ent;
+
+	if (n == 0)
+		return;
+
+	if (defer && dp->dq != NULL) {
+		ent = idx | (uint64_t)rte_log2_u32(n) << 32 |
+			(uint64_t)pool_id << 40;
+		if (rte_rcu_qsbr_dq_enqueue(dp->dq, &ent) == 0)
+			return;
+		/* defer queue is full, wait for the readers */
+		rte_rcu_qsbr_synchronize(dp->v, RTE_QSBR_THRID_INVALID);
+	}
+	pool_put(get_pool(dp, pool_id), idx, rte_log2_u32(n));
+}
+
+static void
+__rcu_qsbr_free_resource(void *p, void *data, unsigned int n __rte_unused)
+{
+	struct rte_poptrie_tbl *dp = p;
+	uint64_t ent = *(uint64_t *)data;
+
+	pool_put(get_pool(dp, ent >> 40), (uint32_t)ent,
+		(ent >> 32) & UINT8_MAX);
+}
+
+static void
+wait_readers(struct rte_poptrie_tbl *dp)
+{
+	if (dp->v != NULL && dp->rcu_mode == RTE_FIB6_QSBR_MODE_SYNC)
+		rte_rcu_qsbr_synchronize(dp->v, RTE_QSBR_THRID_INVALID);
+}
+
+static inline uint64_t
+get_leaf(struct rte_poptrie_tbl *dp, uint32_t idx)
+{
+	switch (dp->nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return ((uint16_t *)dp->leaves)[idx];
+	case RTE_FIB6_TRIE_4B:
+		return ((uint32_t *)dp->leaves)[idx];
+	default:
+		return ((uint64_t *)dp->leaves)[idx];
+	}
+}
+
+static inline void
+set_leaf(struct rte_poptrie_tbl *dp, uint32_t idx, uint64_t val)
+{
+	switch (dp->nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		((uint16_t *)dp->leaves)[idx] = val;
+		break;
+	case RTE_FIB6_TRIE_4B:
+		((uint32_t *)dp->leaves)[idx] = val;
+		break;
+	default:
+		((uint64_t *)dp->leaves)[idx] = val;
+		break;
+	}
+}
+
+/*
+ * Free the leaves and the child nodes of a node,
+ * with the subtrees of the child nodes in slots first to last
+ */
+static void
+free_node(struct rte_poptrie_tbl *dp, const struct poptrie_node *node,
+	uint32_t first, uint32_t last, bool defer)
+{
+	uint32_t i, k = 0;
+
+	for (i = 0; i < POPTRIE_NODE_NUM_ENT; i++) {
+		if ((node->vector & (1ULL << i)) == 0)
+			continue;
+		if (i >= first && i <= last)
+			free_node(dp, &dp->nodes[node->base1 + k], 0,
+				POPTRIE_NODE_NUM_ENT - 1, defer);
+		k++;
+	}
+	blk_free(dp, POPTRIE_NODE_POOL, node->base1, k, defer);
+	blk_free(dp, POPTRIE_LEAF_POOL, node->base0,
+		rte_popcount64(node->leafvec), defer);
+}
+
+static uint32_t
+get_slot(const struct rte_ipv6_addr *ip, uint8_t off)
+{
+	uint32_t i, bit, slot = 0;
+
+	for (i = 0; i < POPTRIE_STRIDE; i++) {
+		bit = off + i;
+		slot <<= 1;
+		if (bit < RTE_IPV6_MAX_DEPTH)
+			slot |= (ip->a[bit / CHAR_BIT] >>
+				(CHAR_BIT - 1 - bit % CHAR_BIT)) & 1;
+	}
+	return slot;
+}
+
+static void
+set_slot(struct rte_ipv6_addr *ip, uint8_t off, uint32_t slot)
+{
+	uint32_t i, bit;
+	uint8_t msk;
+
+	for (i = 0; i < POPTRIE_STRIDE; i++) {
+		bit = off + i;
+		if (bit >= RTE_IPV6_MAX_DEPTH)
+			break;
+		msk = 1 << (CHAR_BIT - 1 - bit % CHAR_BIT);
+		if (slot & (1 << (POPTRIE_STRIDE - 1 - i)))
+			ip->a[bit / CHAR_BIT] |= msk;
+		else
+			ip->a[bit / CHAR_BIT] &= ~msk;
+	}
+}
+
+/*
+ * Get the next hop of the prefix ip/depth, given by the routes
+ * not longer than depth
+ */
+static uint64_t
+get_cover_nh(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	const struct rte_ipv6_addr *ip, uint8_t depth)
+{
+	struct rte_rib6_node *tmp;
+	uint64_t nh = dp->def_nh;
+	uint8_t tmp_depth;
+
+	tmp = rte_rib6_lookup(rib, ip);
+	while (tmp != NULL) {
+		rte_rib6_get_depth(tmp, &tmp_depth);
+		if (tmp_depth <= depth) {
+			rte_rib6_get_nh(tmp, &nh);
+			break;
+		}
+		tmp = rte_rib6_lookup_parent(tmp);
+	}
+	return nh;
+}
+
+/*
+ * Write the next hops of the routes covered by ip/depth to the slots
+ * of the node resolving the bits off to off + 5. The slots covering
+ * longer routes are marked in ext.
+ */
+static void
+paint_slots(struct rte_rib6 *rib, const struct rte_ipv6_addr *ip,
+	uint8_t depth, uint8_t off, uint64_t *vals, uint64_t *ext)
+{
+	struct rte_rib6_node *tmp = NULL;
+	struct rte_ipv6_addr tmp_ip;
+	uint64_t tmp_nh;
+	uint32_t i, slot, n;
+	uint8_t tmp_depth;
+
+	while ((tmp = rte_rib6_get_nxt(rib, ip, depth, tmp,
+			RTE_RIB6_GET_NXT_COVER)) != NULL) {
+		rte_rib6_get_ip(tmp, &tmp_ip);
+		rte_rib6_get_depth(tmp, &tmp_depth);
+		slot = get_slot(&tmp_ip, off);
+		if (tmp_depth > off + POPTRIE_STRIDE) {
+			*ext |= 1ULL << slot;
+			continue;
+		}
+		rte_rib6_get_nh(tmp, &tmp_nh);
+		n = 1 << (off + POPTRIE_STRIDE - tmp_depth);
+		for (i = slot; i < slot + n; i++)
+			vals[i] = tmp_nh;
+		paint_slots(rib, &tmp_ip, tmp_depth, off, vals, ext);
+	}
+}
+
+/*
+ * Build the node resolving the bits off to off + 5 of the prefix ip/off
+ * whose next hop is def. If old is not NULL, the slots out of
+ * first to last are kept from old, and the other ones built from the RIB.
+ * Return 1 with nothing allocated if the node would only have
+ * identical leaves, their next hop put in nh, 0 on success,
+ * or a negative value on error.
+ */
+static int
+build_node(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	const struct rte_ipv6_addr *ip, uint8_t off, uint64_t def,
+	const struct poptrie_node *old, uint32_t first, uint32_t last,
+	struct poptrie_node *node, uint64_t *nh)
+{
+	struct poptrie_node children[POPTRIE_NODE_NUM_ENT];
+	uint64_t vals[POPTRIE_NODE_NUM_ENT];
+	struct rte_ipv6_addr child_ip;
+	uint64_t ext = 0, built = 0, vector = 0, leafvec = 0, bit, prev = 0;
+	uint32_t i, k = 0, nb_children = 0, nb_leaves = 0;
+	int64_t base0 = 0, base1 = 0;
+	int ret;
+
+	for (i = 0; i < POPTRIE_NODE_NUM_ENT; i++)
+		vals[i] = def;
+	paint_slots(rib, ip, off, off, vals, &ext);
+
+	for (i = 0; i < POPTRIE_NODE_NUM_ENT; i++) {
+		bit = 1ULL << i;
+		if (old != NULL && (i < first || i > last)) {
+			/* keep the slot of the old node */
+			if (old->vector & bit) {
+				children[nb_children++] = dp->nodes[old->base1 + k++];
+				vector |= bit;
+			} else
+				vals[i] = get_leaf(dp, old->base0 +
+					rte_popcount64(old->leafvec &
+					poptrie_slot_msk(i)) - 1) >> 1;
+			continue;
+		}
+		if (old != NULL && (old->vector & bit))
+			k++;
+		if ((ext & bit) == 0)
+			continue;
+
+		child_ip = *ip;
+		set_slot(&child_ip, off, i);
+		ret = build_node(dp, rib, &child_ip, off + POPTRIE_STRIDE,
+			vals[i], NULL, 0, POPTRIE_NODE_NUM_ENT - 1,
+			&children[nb_children], &vals[i]);
+		if (ret < 0)
+			goto free_children;
+		if (ret == 0) {
+			nb_children++;
+			vector |= bit;
+			built |= bit;
+		}
+	}
+
+	/* find the runs of identical leaves */
+	for (i = 0; i < POPTRIE_NODE_NUM_ENT; i++) {
+		if (vector & (1ULL << i))
+			continue;
+		if (nb_leaves == 0 || vals[i] != prev) {
+			leafvec |= 1ULL << i;
+			nb_leaves++;
+			prev = vals[i];
+		}
+	}
+	if (vector == 0 && nb_leaves == 1) {
+		*nh = prev;
+		return 1;
+	}
+
+	if (nb_children != 0) {
+		base1 = blk_alloc(dp, POPTRIE_NODE_POOL, nb_children);
+		if (base1 < 0) {
+			ret = base1;
+			goto free_children;
+		}
+	}
+	if (nb_leaves != 0) {
+		base0 = blk_alloc(dp, POPTRIE_LEAF_POOL, nb_leaves);
+		if (base0 < 0) {
+			ret = base0;
+			blk_free(dp, POPTRIE_NODE_POOL, base1, nb_children, false);
+			goto free_children;
+		}
+	}
+
+	memcpy(&dp->nodes[base1], children, sizeof(children[0]) * nb_children);
+	for (i = 0, k = 0; i < POPTRIE_NODE_NUM_ENT; i++) {
+		if (leafvec & (1ULL << i))
+			set_leaf(dp, base0 + k++, vals[i] << 1);
+	}
+
+	node->vector = vector;
+	node->leafvec = leafvec;
+	node->base0 = base0;
+	node->base1 = base1;
+	return 0;
+
+free_children:
+	for (i = 0, k = 0; i < POPTRIE_NODE_NUM_ENT; i++) {
+		if ((vector & (1ULL << i)) == 0)
+			continue;
+		if (built & (1ULL << i))
+			free_node(dp, &children[k], 0, POPTRIE_NODE_NUM_ENT - 1,
+				false);
+		k++;
+	}
+	return ret;
+}
+
+/*
+ * Rebuild the subtree of a direct table entry. The previous entry is
+ * put in old, its subtree is left to the caller to free once the readers
+ * are done with it.
+ */
+static int
+update_dir(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib, uint32_t slot,
+	uint64_t *old)
+{
+	struct rte_ipv6_addr ip = RTE_IPV6_ADDR_UNSPEC;
+	struct poptrie_node node;
+	uint64_t def, nh, ent;
+	int64_t idx;
+	int ret;
+
+	ip.a[0] = slot >> CHAR_BIT;
+	ip.a[1] = slot;
+	def = get_cover_nh(dp, rib, &ip, POPTRIE_DIR_BITS);
+	ret = build_node(dp, rib, &ip, POPTRIE_DIR_BITS, def, NULL, 0,
+		POPTRIE_NODE_NUM_ENT - 1, &node, &nh);
+	if (ret < 0)
+		return ret;
+
+	if (ret == 1)
+		ent = nh << 1;
+	else {
+		idx = blk_alloc(dp, POPTRIE_NODE_POOL, 1);
+		if (idx < 0) {
+			free_node(dp, &node, 0, POPTRIE_NODE_NUM_ENT - 1,
+				false);
+			return idx;
+		}
+		dp->nodes[idx] = node;
+		ent = (idx << 1) | POPTRIE_EXT_ENT;
+	}
+
+	*old = dp->dir[slot];
+	if (*old == ent)
+		return 0;
+	rte_atomic_thread_fence(rte_memory_order_release);
+	dp->dir[slot] = ent;
+	return 0;
+}
+
+/*
+ * Free the subtree of a replaced direct table entry
+ */
+static void
+free_dir_ent(struct rte_poptrie_tbl *dp, uint64_t ent)
+{
+	if (!poptrie_is_ext(ent))
+		return;
+	free_node(dp, &dp->nodes[ent >> 1], 0, POPTRIE_NODE_NUM_ENT - 1,
+		true);
+	blk_free(dp, POPTRIE_NODE_POOL, ent >> 1, 1, true);
+}
+
+/*
+ * Rebuild the direct table entries first to last, waiting once
+ * for the readers before freeing the replaced subtrees.
+ */
+static int
+update_dir_range(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	uint32_t first, uint32_t last)
+{
+	uint64_t ent, *old = &ent;
+	uint32_t i, n = last - first + 1;
+	int ret = 0;
+
+	if (n > 1) {
+		old = rte_malloc(NULL, sizeof(*old) * n, 0);
+		if (old == NULL)
+			return -ENOMEM;
+	}
+
+	for (i = 0; i < n; i++) {
+		ret = update_dir(dp, rib, first + i, &old[i]);
+		if (ret != 0)
+			break;
+	}
+
+	wait_readers(dp);
+	n = i;
+	for (i = 0; i < n; i++)
+		free_dir_ent(dp, old[i]);
+	if (old != &ent)
+		rte_free(old);
+	return ret;
+}
+
+/*
+ * Rebuild the slots first to last of the node at level lvl of the path
+ * to ip. The node is replaced by a new one, written either to the direct
+ * table, or to a new copy of the child nodes of its parent. A node
+ * left with identical leaves only is collapsed into a leaf of its parent,
+ * up to the direct table.
+ */
+static int
+update_node(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	const struct rte_ipv6_addr *ip, uint8_t off, uint32_t slot,
+	const uint32_t *path, uint32_t lvl, uint32_t first, uint32_t last)
+{
+	struct poptrie_node old, node, *parent;
+	struct rte_ipv6_addr ip_masked;
+	uint64_t def, nh;
+	uint32_t nb_children, node_idx;
+	int64_t idx;
+	int ret;
+
+	for (;;) {
+		node_idx = path[lvl];
+		old = dp->nodes[node_idx];
+		ip_masked = *ip;
+		rte_ipv6_addr_mask(&ip_masked, off);
+		def = get_cover_nh(dp, rib, &ip_masked, off);
+		ret = build_node(dp, rib, &ip_masked, off, def, &old,
+			first, last, &node, &nh);
+		if (ret != 1 || lvl == 0)
+			break;
+		/* rebuild the slot of the parent pointing to the node */
+		lvl--;
+		off -= POPTRIE_STRIDE;
+		first = last = get_slot(ip, off);
+	}
+	if (ret < 0)
+		return ret;
+
+	parent = (lvl == 0) ? NULL : &dp->nodes[path[lvl - 1]];
+	nb_children = (parent == NULL) ? 1 : rte_popcount64(parent->vector);
+
+	if (ret == 1) {
+		/* the first level node turns into a direct table leaf */
+		dp->dir[slot] = nh << 1;
+	} else {
+		idx = blk_alloc(dp, POPTRIE_NODE_POOL, nb_children);
+		if (idx < 0) {
+			free_node(dp, &node, first, last, false);
+			return idx;
+		}
+
+		if (parent == NULL) {
+			dp->nodes[idx] = node;
+			rte_atomic_thread_fence(rte_memory_order_release);
+			dp->dir[slot] = (idx << 1) | POPTRIE_EXT_ENT;
+		} else {
+			memcpy(&dp->nodes[idx], &dp->nodes[parent->base1],
+				sizeof(node) * nb_children);
+			dp->nodes[idx + node_idx - parent->base1] = node;
+			node_idx = parent->base1;
+			rte_atomic_store_explicit(
+				(RTE_ATOMIC(uint32_t) *)&parent->base1, idx,
+				rte_memory_order_release);
+		}
+	}
+
+	wait_readers(dp);
+	free_node(dp, &old, first, last, true);
+	blk_free(dp, POPTRIE_NODE_POOL, node_idx, nb_children, true);
+	return 0;
+}
+
+/*
+ * Update the dataplane for the addresses covered by ip/depth,
+ * from the routes of the RIB
+ */
+static int
+update_dp(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	const struct rte_ipv6_addr *ip, uint8_t depth)
+{
+	uint32_t path[POPTRIE_MAX_LEVELS];
+	struct poptrie_node *node;
+	uint32_t slot, first, last, lvl, v;
+	uint64_t ent;
+	uint8_t off;
+
+	slot = ip->a[0] << CHAR_BIT | ip->a[1];
+	if (depth <= POPTRIE_DIR_BITS)
+		return update_dir_range(dp, rib, slot,
+			slot + (1 << (POPTRIE_DIR_BITS - depth)) - 1);
+
+	ent = dp->dir[slot];
+	if (!poptrie_is_ext(ent))
+		return update_dir_range(dp, rib, slot, slot);
+
+	/* find the node whose slots are covered by the prefix */
+	path[0] = ent >> 1;
+	for (off = POPTRIE_DIR_BITS, lvl = 0; ; off += POPTRIE_STRIDE, lvl++) {
+		node = &dp->nodes[path[lvl]];
+		v = get_slot(ip, off);
+		if (depth <= off + POPTRIE_STRIDE) {
+			first = v;
+			last = v + (1 << (off + POPTRIE_STRIDE - depth)) - 1;
+			break;
+		}
+		if ((node->vector & (1ULL << v)) == 0) {
+			first = last = v;
+			break;
+		}
+		path[lvl + 1] = node->base1 +
+			rte_popcount64(node->vector & poptrie_slot_msk(v)) - 1;
+	}
+
+	return update_node(dp, rib, ip, off, slot, path, lvl, first, last);
+}
+
+int
+poptrie_modify(struct rte_fib6 *fib, const struct rte_ipv6_addr *ip,
+	uint8_t depth, uint64_t next_hop, int op)
+{
+	struct rte_poptrie_tbl *dp;
+	struct rte_rib6 *rib;
+	struct rte_rib6_node *node;
+	struct rte_rib6_node *parent;
+	struct rte_ipv6_addr ip_masked;
+	uint64_t par_nh, node_nh;
+	int ret;
+
+	if ((fib == NULL) || (ip == NULL) || (depth > RTE_IPV6_MAX_DEPTH))
+		return -EINVAL;
+
+	dp = rte_fib6_get_dp(fib);
+	RTE_ASSERT(dp);
+	rib = rte_fib6_get_rib(fib);
+	RTE_ASSERT(rib);
+
+	ip_masked = *ip;
+	rte_ipv6_addr_mask(&ip_masked, depth);
+
+	node = rte_rib6_lookup_exact(rib, &ip_masked, depth);
+	switch (op) {
+	case RTE_FIB6_ADD:
+		if (next_hop > get_max_nh(dp->nh_sz))
+			return -EINVAL;
+
+		if (node != NULL) {
+			rte_rib6_get_nh(node, &node_nh);
+			if (node_nh == next_hop)
+				return 0;
+			rte_rib6_set_nh(node, next_hop);
+			ret = update_dp(dp, rib, &ip_masked, depth);
+			if (ret != 0) {
+				rte_rib6_set_nh(node, node_nh);
+				update_dp(dp, rib, &ip_masked, depth);
+			}
+			return ret;
+		}
+
+		node = rte_rib6_insert(rib, &ip_masked, depth);
+		if (node == NULL)
+			return -rte_errno;
+		rte_rib6_set_nh(node, next_hop);
+		parent = rte_rib6_lookup_parent(node);
+		if (parent != NULL) {
+			rte_rib6_get_nh(parent, &par_nh);
+			if (par_nh == next_hop)
+				return 0;
+		}
+		ret = update_dp(dp, rib, &ip_masked, depth);
+		if (ret != 0) {
+			rte_rib6_remove(rib, &ip_masked, depth);
+			update_dp(dp, rib, &ip_masked, depth);
+		}
+		return ret;
+	case RTE_FIB6_DEL:
+		if (node == NULL)
+			return -ENOENT;
+
+		rte_rib6_get_nh(node, &node_nh);
+		parent = rte_rib6_lookup_parent(node);
+		if (parent != NULL)
+			rte_rib6_get_nh(parent, &par_nh);
+		else
+			par_nh = dp->def_nh;
+		rte_rib6_remove(rib, &ip_masked, depth);
+		if (par_nh == node_nh)
+			return 0;
+
+		ret = update_dp(dp, rib, &ip_masked, depth);
+		if (ret != 0) {
+			node = rte_rib6_insert(rib, &ip_masked, depth);
+			if (node != NULL) {
+				rte_rib6_set_nh(node, node_nh);
+				update_dp(dp, rib, &ip_masked, depth);
+			}
+		}
+		return ret;
+	default:
+		break;
+	}
+	return -EINVAL;
+}
+
+void *
+poptrie_create(const char *name, int socket_id,
+	struct rte_fib6_conf *conf)
+{
+	char mem_name[POPTRIE_NAMESIZE];
+	struct rte_poptrie_tbl *dp = NULL;
+	uint64_t	def_nh;
+	uint32_t	num_nodes, num_leaves, i;
+	enum rte_fib_trie_nh_sz	nh_sz;
+
+	if ((name == NULL) || (conf == NULL) ||
+			(conf->poptrie.nh_sz < RTE_FIB6_TRIE_2B) ||
+			(conf->poptrie.nh_sz > RTE_FIB6_TRIE_8B) ||
+			(conf->poptrie.num_nodes == 0) ||
+			(conf->poptrie.num_nodes > POPTRIE_MAX_ENT) ||
+			(conf->poptrie.num_leaves == 0) ||
+			(conf->poptrie.num_leaves > POPTRIE_MAX_ENT) ||
+			(conf->default_nh >
+			get_max_nh(conf->poptrie.nh_sz))) {
+
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	def_nh = conf->default_nh;
+	nh_sz = conf->poptrie.nh_sz;
+	num_nodes = RTE_ALIGN_CEIL(conf->poptrie.num_nodes,
+		POPTRIE_NODE_NUM_ENT);
+	num_leaves = RTE_ALIGN_CEIL(conf->poptrie.num_leaves,
+		POPTRIE_NODE_NUM_ENT);
+
+	dp = rte_zmalloc_socket(name, sizeof(struct rte_poptrie_tbl) +
+		POPTRIE_DIR_NUM_ENT * sizeof(uint64_t),
+		RTE_CACHE_LINE_SIZE, socket_id);
+	if (dp == NULL) {
+		rte_errno = ENOMEM;
+		return dp;
+	}
+
+	for (i = 0; i < POPTRIE_DIR_NUM_ENT; i++)
+		dp->dir[i] = def_nh << 1;
+	dp->def_nh = def_nh;
+	dp->nh_sz = nh_sz;
+
+	snprintf(mem_name, sizeof(mem_name), "NODES_%p", dp);
+	dp->nodes = rte_zmalloc_socket(mem_name,
+		sizeof(struct poptrie_node) * num_nodes,
+		RTE_CACHE_LINE_SIZE, socket_id);
+	/* the vector lookup reads leaves with 4 bytes loads */
+	snprintf(mem_name, sizeof(mem_name), "LEAVES_%p", dp);
+	dp->leaves = rte_zmalloc_socket(mem_name,
+		((size_t)num_leaves << nh_sz) + sizeof(uint32_t),
+		RTE_CACHE_LINE_SIZE, socket_id);
+	if (dp->nodes == NULL || dp->leaves == NULL)
+		goto free_dp;
+
+	snprintf(mem_name, sizeof(mem_name), "NODE_POOL_%p", dp);
+	if (pool_init(&dp->node_pool, num_nodes, mem_name, socket_id) != 0)
+		goto free_dp;
+	snprintf(mem_name, sizeof(mem_name), "LEAF_POOL_%p", dp);
+	if (pool_init(&dp->leaf_pool, num_leaves, mem_name, socket_id) != 0)
+		goto free_dp;
+
+	return dp;
+
+free_dp:
+	pool_free(&dp->leaf_pool);
+	pool_free(&dp->node_pool);
+	rte_free(dp->leaves);
+	rte_free(dp->nodes);
+	rte_free(dp);
+	rte_errno = ENOMEM;
+	return NULL;
+}
+
+void
+poptrie_free(void *p)
+{
+	struct rte_poptrie_tbl *dp = (struct rte_poptrie_tbl *)p;
+
+	rte_rcu_qsbr_dq_delete(dp->dq);
+	pool_free(&dp->leaf_pool);
+	pool_free(&dp->node_pool);
+	rte_free(dp->leaves);
+	rte_free(dp->nodes);
+	rte_free(dp);
+}
+
+int
+poptrie_rcu_qsbr_add(struct rte_poptrie_tbl *dp,
+	struct rte_fib6_rcu_config *cfg, const char *name)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+
+	if (dp == NULL || cfg == NULL)
+		return -EINVAL;
+
+	if (dp->v != NULL)
+		return -EEXIST;
+
+	switch (cfg->mode) {
+	case RTE_FIB6_QSBR_MODE_DQ:
+		/* Init QSBR defer queue. */
+		snprintf(rcu_dq_name, sizeof(rcu_dq_name),
+			"FIB_RCU_%s", name);
+		params.name = rcu_dq_name;
+		params.size = cfg->dq_size;
+		if (params.size == 0)
+			params.size = RTE_FIB6_RCU_DQ_RECLAIM_SZ;
+		params.trigger_reclaim_limit = cfg->reclaim_thd;
+		params.max_reclaim_size = cfg->reclaim_max;
+		if (params.max_reclaim_size == 0)
+			params.max_reclaim_size = RTE_FIB6_RCU_DQ_RECLAIM_MAX;
+		params.esize = sizeof(uint64_t);
+		params.free_fn = __rcu_qsbr_free_resource;
+		params.p = dp;
+		params.v = cfg->v;
+		dp->dq = rte_rcu_qsbr_dq_create(&params);
+		if (dp->dq == NULL) {
+			FIB_LOG(ERR, "FIB6 defer queue creation failed");
+			return -ENOMEM;
+		}
+		break;
+	case RTE_FIB6_QSBR_MODE_SYNC:
+		/* No other things to do. */
+		break;
+	default:
+		return -EINVAL;
+	}
+	dp->rcu_mode = cfg->mode;
+	dp->v = cfg->v;
+
+	return 0;
+}
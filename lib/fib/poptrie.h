@@ -0,0 +1,146 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _POPTRIE_H_
+#define _POPTRIE_H_
+
+#include <stdalign.h>
+
+#include <rte_common.h>
+#include <rte_bitops.h>
+#include <rte_byteorder.h>
+#include <rte_fib6.h>
+
+/**
+ * @file
+ * Poptrie based IPv6 Longest Prefix Match (LPM)
+ *
+ * The first 16 bits of the address index a direct table,
+ * then every node consumes 6 more bits. A node keeps two 64 bits maps:
+ * the slots pointing to child nodes, and the slots starting a run of
+ * identical leaves. Child nodes and leaves of a node are contiguous,
+ * the index of a slot is found with a popcount of the map.
+ */
+
+/* @internal Number of bits resolved by the direct table. */
+#define POPTRIE_DIR_BITS	16
+/* @internal Total number of direct table entries. */
+#define POPTRIE_DIR_NUM_ENT	(1 << POPTRIE_DIR_BITS)
+/* @internal Number of bits resolved by a node. */
+#define POPTRIE_STRIDE		6
+/* @internal Number of slots of a node. */
+#define POPTRIE_NODE_NUM_ENT	(1 << POPTRIE_STRIDE)
+/* @internal Bit of an entry pointing to a node rather than a next hop. */
+#define POPTRIE_EXT_ENT		1
+/* @internal Maximum number of nodes on the path to a leaf. */
+#define POPTRIE_MAX_LEVELS	\
+	((RTE_IPV6_MAX_DEPTH - POPTRIE_DIR_BITS + POPTRIE_STRIDE - 1) / \
+	POPTRIE_STRIDE)
+/* @internal Number of nodes consuming the first 64 bits of the address. */
+#define POPTRIE_HI_LEVELS	((64 - POPTRIE_DIR_BITS) / POPTRIE_STRIDE)
+/* @internal Largest block of the node and leaf pools, one per node. */
+#define POPTRIE_MAX_ORDER	POPTRIE_STRIDE
+
+struct poptrie_node {
+	uint64_t	vector;	/**< bitmap of the slots with a child node */
+	uint64_t	leafvec; /**< bitmap of the slots starting a leaf run */
+	uint32_t	base0;	/**< index of the first leaf */
+	uint32_t	base1;	/**< index of the first child node */
+};
+
+/* Buddy allocator of node or leaf indexes */
+struct poptrie_pool {
+	uint32_t	size;	/**< Number of entries */
+	uint32_t	used;	/**< Number of allocated entries */
+	uint32_t	*next;	/**< Next free block of the same order */
+	uint32_t	*prev;	/**< Previous free block of the same order */
+	uint8_t		*order;	/**< Order + 1 of a free block, 0 otherwise */
+	uint32_t	head[POPTRIE_MAX_ORDER + 1]; /**< Free lists */
+};
+
+struct rte_poptrie_tbl {
+	uint64_t	def_nh;		/**< Default next hop */
+	enum rte_fib_trie_nh_sz	nh_sz;	/**< Size of nexthop entry */
+	struct poptrie_node	*nodes;	/**< Node table */
+	void		*leaves;	/**< Leaf table */
+	struct poptrie_pool	node_pool;
+	struct poptrie_pool	leaf_pool;
+	/* RCU config. */
+	enum rte_fib6_qsbr_mode rcu_mode; /**< Blocking, defer queue. */
+	struct rte_rcu_qsbr *v; /**< RCU QSBR variable. */
+	struct rte_rcu_qsbr_dq *dq; /**< RCU QSBR defer queue. */
+	/* direct table. */
+	alignas(RTE_CACHE_LINE_SIZE) uint64_t	dir[];
+};
+
+static inline int
+poptrie_is_ext(uint64_t ent)
+{
+	return (ent & POPTRIE_EXT_ENT) == POPTRIE_EXT_ENT;
+}
+
+/* bitmask of the slots up to and including slot v */
+static inline uint64_t
+poptrie_slot_msk(uint32_t v)
+{
+	return (2ULL << v) - 1;
+}
+
+#define POPTRIE_LOOKUP_FUNC(suffix, type)				\
+static inline void rte_poptrie_lookup_bulk_##suffix(void *p,		\
+	const struct rte_ipv6_addr *ips,				\
+	uint64_t *next_hops, const unsigned int n)			\
+{									\
+	struct rte_poptrie_tbl *dp = (struct rte_poptrie_tbl *)p;	\
+	const struct poptrie_node *node;				\
+	uint64_t ent, key, hi, lo, bit, msk;				\
+	uint32_t i, v, lvl;						\
+									\
+	for (i = 0; i < n; i++) {					\
+		hi = rte_be_to_cpu_64(((const unaligned_uint64_t *)ips[i].a)[0]);	\
+		lo = rte_be_to_cpu_64(((const unaligned_uint64_t *)ips[i].a)[1]);	\
+		ent = dp->dir[hi >> (64 - POPTRIE_DIR_BITS)];		\
+		key = hi << POPTRIE_DIR_BITS;				\
+		for (lvl = 0; poptrie_is_ext(ent); lvl++) {		\
+			if (lvl == POPTRIE_HI_LEVELS)			\
+				key = lo;				\
+			node = &dp->nodes[ent >> 1];			\
+			v = key >> (64 - POPTRIE_STRIDE);		\
+			key <<= POPTRIE_STRIDE;				\
+			bit = 1ULL << v;				\
+			msk = poptrie_slot_msk(v);			\
+			if (node->vector & bit)				\
+				ent = ((uint64_t)(node->base1 +		\
+					rte_popcount64(node->vector & msk) - 1) \
+					<< 1) | POPTRIE_EXT_ENT;	\
+			else						\
+				ent = ((const type *)dp->leaves)[node->base0 + \
+					rte_popcount64(node->leafvec & msk) - 1]; \
+		}							\
+		next_hops[i] = ent >> 1;				\
+	}								\
+}
+POPTRIE_LOOKUP_FUNC(2b, uint16_t)
+POPTRIE_LOOKUP_FUNC(4b, uint32_t)
+POPTRIE_LOOKUP_FUNC(8b, uint64_t)
+
+void
+poptrie_free(void *p);
+
+void *
+poptrie_create(const char *name, int socket_id, struct rte_fib6_conf *conf)
+	__rte_malloc __rte_dealloc(poptrie_free, 1);
+
+rte_fib6_lookup_fn_t
+poptrie_get_lookup_fn(void *p, enum rte_fib6_lookup_type type);
+
+int
+poptrie_modify(struct rte_fib6 *fib, const struct rte_ipv6_addr *ip,
+	uint8_t depth, uint64_t next_hop, int op);
+
+int
+poptrie_rcu_qsbr_add(struct rte_poptrie_tbl *dp,
+	struct rte_fib6_rcu_config *cfg, const char *name);
+
+#endif /* _POPTRIE_H_ */
@@ -0,0 +1,205 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+#include <rte_fib6.h>
+
+#include "poptrie.h"
+#include "poptrie_avx2.h"
+
+/* state of the lookup of 4 addresses */
+struct poptrie_x4 {
+	__m256i		hi;	/* first 8 bytes of the addresses */
+	__m256i		lo;	/* last 8 bytes of the addresses */
+	__m256i		key;	/* bits left to resolve */
+	__m256i		ent;	/* current entry */
+	__m256i		msk_ext; /* lanes pointing to a node */
+};
+
+static __rte_always_inline void
+transpose_x4(const struct rte_ipv6_addr *ips, __m256i *first, __m256i *second)
+{
+	__m256i tmp1, tmp2;
+	/* swap the bytes of each 8 bytes chunk to host order */
+	const __m256i bswap = _mm256_setr_epi8(
+		7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+		7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+	tmp1 = _mm256_shuffle_epi8(
+		_mm256_loadu_si256((const __m256i *)&ips[0]), bswap);
+	tmp2 = _mm256_shuffle_epi8(
+		_mm256_loadu_si256((const __m256i *)&ips[2]), bswap);
+
+	*first = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(tmp1, tmp2),
+		0xd8);
+	*second = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(tmp1, tmp2),
+		0xd8);
+}
+
+/* popcount of every 64 bits lane */
+static __rte_always_inline __m256i
+popcnt_x4(__m256i v)
+{
+	const __m256i lut = _mm256_setr_epi8(
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i nibble = _mm256_set1_epi8(0x0f);
+	__m256i cnt;
+
+	cnt = _mm256_add_epi8(
+		_mm256_shuffle_epi8(lut, _mm256_and_si256(v, nibble)),
+		_mm256_shuffle_epi8(lut,
+			_mm256_and_si256(_mm256_srli_epi16(v, 4), nibble)));
+	return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+static __rte_always_inline __m256i
+test_x4(__m256i a, __m256i b)
+{
+	return _mm256_xor_si256(_mm256_cmpeq_epi64(_mm256_and_si256(a, b),
+		_mm256_setzero_si256()), _mm256_set1_epi64x(-1));
+}
+
+static __rte_always_inline void
+poptrie_avx2_init_x4(struct rte_poptrie_tbl *dp,
+	const struct rte_ipv6_addr *ips, struct poptrie_x4 *s)
+{
+	const __m256i lsb = _mm256_set1_epi64x(POPTRIE_EXT_ENT);
+
+	transpose_x4(ips, &s->hi, &s->lo);
+	s->ent = _mm256_i64gather_epi64((const long long *)dp->dir,
+		_mm256_srli_epi64(s->hi, 64 - POPTRIE_DIR_BITS), 8);
+	s->key = _mm256_slli_epi64(s->hi, POPTRIE_DIR_BITS);
+	s->msk_ext = test_x4(s->ent, lsb);
+}
+
+/* go one level down for the lanes pointing to a node */
+static __rte_always_inline void
+poptrie_avx2_step_x4(struct rte_poptrie_tbl *dp, struct poptrie_x4 *s,
+	int size)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i lsb = _mm256_set1_epi64x(POPTRIE_EXT_ENT);
+	const __m256i lo32 = _mm256_set1_epi64x(UINT32_MAX);
+	const long long *nodes = (const long long *)dp->nodes;
+	__m256i idx, off, vector, leafvec, bases, v, bit, msk, cnt, base;
+	__m256i msk_node, msk_leaf, leaves;
+	__m128i leaves32;
+
+	/* byte offsets of the nodes */
+	idx = _mm256_srli_epi64(s->ent, 1);
+	off = _mm256_add_epi64(_mm256_slli_epi64(idx, 4),
+		_mm256_slli_epi64(idx, 3));
+	vector = _mm256_mask_i64gather_epi64(zero, nodes, off, s->msk_ext, 1);
+	leafvec = _mm256_mask_i64gather_epi64(zero, nodes + 1, off,
+		s->msk_ext, 1);
+	bases = _mm256_mask_i64gather_epi64(zero, nodes + 2, off,
+		s->msk_ext, 1);
+
+	v = _mm256_srli_epi64(s->key, 64 - POPTRIE_STRIDE);
+	s->key = _mm256_slli_epi64(s->key, POPTRIE_STRIDE);
+	bit = _mm256_sllv_epi64(lsb, v);
+	msk = _mm256_sub_epi64(_mm256_slli_epi64(bit, 1), lsb);
+
+	msk_node = _mm256_and_si256(s->msk_ext, test_x4(vector, bit));
+	msk_leaf = _mm256_andnot_si256(msk_node, s->msk_ext);
+
+	/* index of the child node or of the leaf */
+	cnt = popcnt_x4(_mm256_and_si256(
+		_mm256_blendv_epi8(leafvec, vector, msk_node), msk));
+	base = _mm256_blendv_epi8(_mm256_and_si256(bases, lo32),
+		_mm256_srli_epi64(bases, 32), msk_node);
+	idx = _mm256_sub_epi64(_mm256_add_epi64(base, cnt), lsb);
+
+	s->ent = _mm256_blendv_epi8(s->ent,
+		_mm256_or_si256(_mm256_slli_epi64(idx, 1), lsb), msk_node);
+	if (size == sizeof(uint16_t)) {
+		leaves32 = _mm256_mask_i64gather_epi32(_mm_setzero_si128(),
+			(const int *)dp->leaves, idx,
+			_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+			msk_leaf, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6))),
+			2);
+		leaves = _mm256_and_si256(_mm256_cvtepu32_epi64(leaves32),
+			_mm256_set1_epi64x(UINT16_MAX));
+	} else if (size == sizeof(uint32_t)) {
+		leaves32 = _mm256_mask_i64gather_epi32(_mm_setzero_si128(),
+			(const int *)dp->leaves, idx,
+			_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+			msk_leaf, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6))),
+			4);
+		leaves = _mm256_cvtepu32_epi64(leaves32);
+	} else
+		leaves = _mm256_mask_i64gather_epi64(zero,
+			(const long long *)dp->leaves, idx, msk_leaf, 8);
+	s->ent = _mm256_blendv_epi8(s->ent, leaves, msk_leaf);
+
+	s->msk_ext = msk_node;
+}
+
+static __rte_always_inline void
+poptrie_avx2_lookup_x4x2(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, int size)
+{
+	struct rte_poptrie_tbl *dp = (struct rte_poptrie_tbl *)p;
+	struct poptrie_x4 s1, s2;
+	int lvl;
+
+	poptrie_avx2_init_x4(dp, ips, &s1);
+	poptrie_avx2_init_x4(dp, ips + 4, &s2);
+
+	/* all the lanes are at the same level of the poptrie */
+	for (lvl = 0; !_mm256_testz_si256(_mm256_or_si256(s1.msk_ext,
+			s2.msk_ext), _mm256_set1_epi64x(-1)); lvl++) {
+		if (lvl == POPTRIE_HI_LEVELS) {
+			s1.key = s1.lo;
+			s2.key = s2.lo;
+		}
+		poptrie_avx2_step_x4(dp, &s1, size);
+		poptrie_avx2_step_x4(dp, &s2, size);
+	}
+
+	_mm256_storeu_si256((__m256i *)next_hops,
+		_mm256_srli_epi64(s1.ent, 1));
+	_mm256_storeu_si256((__m256i *)(next_hops + 4),
+		_mm256_srli_epi64(s2.ent, 1));
+}
+
+void
+rte_poptrie_avx2_lookup_bulk_2b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+	for (i = 0; i < (n / 8); i++) {
+		poptrie_avx2_lookup_x4x2(p, &ips[i * 8],
+				next_hops + i * 8, sizeof(uint16_t));
+	}
+	rte_poptrie_lookup_bulk_2b(p, &ips[i * 8],
+			next_hops + i * 8, n - i * 8);
+}
+
+void
+rte_poptrie_avx2_lookup_bulk_4b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+	for (i = 0; i < (n / 8); i++) {
+		poptrie_avx2_lookup_x4x2(p, &ips[i * 8],
+				next_hops + i * 8, sizeof(uint32_t));
+	}
+	rte_poptrie_lookup_bulk_4b(p, &ips[i * 8],
+			next_hops + i * 8, n - i * 8);
+}
+
+void
+rte_poptrie_avx2_lookup_bulk_8b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+	for (i = 0; i < (n / 8); i++) {
+		poptrie_avx2_lookup_x4x2(p, &ips[i * 8],
+				next_hops + i * 8, sizeof(uint64_t));
+	}
+	rte_poptrie_lookup_bulk_8b(p, &ips[i * 8],
+			next_hops + i * 8, n - i * 8);
+}
@@ -0,0 +1,204 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+#include <rte_fib6.h>
+
+#include "poptrie.h"
+#include "poptrie_avx512.h"
+
+/* state of the lookup of 8 addresses */
+struct poptrie_x8 {
+	__m512i		hi;	/* first 8 bytes of the addresses */
+	__m512i		lo;	/* last 8 bytes of the addresses */
+	__m512i		key;	/* bits left to resolve */
+	__m512i		ent;	/* current entry */
+	__mmask8	msk_ext; /* lanes pointing to a node */
+};
+
+static __rte_always_inline void
+transpose_x8(const struct rte_ipv6_addr *ips, __m512i *first, __m512i *second)
+{
+	__m512i tmp1, tmp2;
+	const __rte_x86_zmm_t perm_idxes = {
+		.u64 = { 0, 2, 4, 6, 1, 3, 5, 7 },
+	};
+	/* swap the bytes of each 8 bytes chunk to host order */
+	const __rte_x86_zmm_t bswap = {
+		.u8 = { 7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8,
+			7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8,
+			7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8,
+			7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8
+		},
+	};
+
+	tmp1 = _mm512_shuffle_epi8(_mm512_loadu_si512(&ips[0]), bswap.z);
+	tmp2 = _mm512_shuffle_epi8(_mm512_loadu_si512(&ips[4]), bswap.z);
+
+	*first = _mm512_permutexvar_epi64(perm_idxes.z,
+		_mm512_unpacklo_epi64(tmp1, tmp2));
+	*second = _mm512_permutexvar_epi64(perm_idxes.z,
+		_mm512_unpackhi_epi64(tmp1, tmp2));
+}
+
+/* popcount of every 64 bits lane */
+static __rte_always_inline __m512i
+popcnt_x8(__m512i v)
+{
+	const __rte_x86_zmm_t lut = {
+		.u8 = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+		},
+	};
+	const __m512i nibble = _mm512_set1_epi8(0x0f);
+	__m512i cnt;
+
+	cnt = _mm512_add_epi8(
+		_mm512_shuffle_epi8(lut.z, _mm512_and_si512(v, nibble)),
+		_mm512_shuffle_epi8(lut.z,
+			_mm512_and_si512(_mm512_srli_epi16(v, 4), nibble)));
+	return _mm512_sad_epu8(cnt, _mm512_setzero_si512());
+}
+
+static __rte_always_inline void
+poptrie_vec_init_x8(struct rte_poptrie_tbl *dp,
+	const struct rte_ipv6_addr *ips, struct poptrie_x8 *s)
+{
+	const __m512i lsb = _mm512_set1_epi64(POPTRIE_EXT_ENT);
+
+	transpose_x8(ips, &s->hi, &s->lo);
+	s->ent = _mm512_i64gather_epi64(
+		_mm512_srli_epi64(s->hi, 64 - POPTRIE_DIR_BITS),
+		(const void *)dp->dir, 8);
+	s->key = _mm512_slli_epi64(s->hi, POPTRIE_DIR_BITS);
+	s->msk_ext = _mm512_test_epi64_mask(s->ent, lsb);
+}
+
+/* go one level down for the lanes pointing to a node */
+static __rte_always_inline void
+poptrie_vec_step_x8(struct rte_poptrie_tbl *dp, struct poptrie_x8 *s,
+	int size)
+{
+	const __m512i zero = _mm512_setzero_si512();
+	const __m512i lsb = _mm512_set1_epi64(POPTRIE_EXT_ENT);
+	const __m512i lo32 = _mm512_set1_epi64(UINT32_MAX);
+	__m512i idx, off, vector, leafvec, bases, v, bit, msk, cnt, base;
+	__m256i leaves;
+	__mmask8 msk_node, msk_leaf;
+
+	/* byte offsets of the nodes */
+	idx = _mm512_srli_epi64(s->ent, 1);
+	off = _mm512_add_epi64(_mm512_slli_epi64(idx, 4),
+		_mm512_slli_epi64(idx, 3));
+	vector = _mm512_mask_i64gather_epi64(zero, s->msk_ext, off,
+		(const void *)&dp->nodes->vector, 1);
+	leafvec = _mm512_mask_i64gather_epi64(zero, s->msk_ext, off,
+		(const void *)&dp->nodes->leafvec, 1);
+	bases = _mm512_mask_i64gather_epi64(zero, s->msk_ext, off,
+		(const void *)&dp->nodes->base0, 1);
+
+	v = _mm512_srli_epi64(s->key, 64 - POPTRIE_STRIDE);
+	s->key = _mm512_slli_epi64(s->key, POPTRIE_STRIDE);
+	bit = _mm512_sllv_epi64(lsb, v);
+	msk = _mm512_sub_epi64(_mm512_slli_epi64(bit, 1), lsb);
+
+	msk_node = _mm512_mask_test_epi64_mask(s->msk_ext, vector, bit);
+	msk_leaf = s->msk_ext & ~msk_node;
+
+	/* index of the child node or of the leaf */
+	cnt = popcnt_x8(_mm512_and_si512(
+		_mm512_mask_blend_epi64(msk_node, leafvec, vector), msk));
+	base = _mm512_mask_blend_epi64(msk_node,
+		_mm512_and_si512(bases, lo32), _mm512_srli_epi64(bases, 32));
+	idx = _mm512_sub_epi64(_mm512_add_epi64(base, cnt), lsb);
+
+	s->ent = _mm512_mask_mov_epi64(s->ent, msk_node,
+		_mm512_or_si512(_mm512_slli_epi64(idx, 1), lsb));
+	if (size == sizeof(uint16_t)) {
+		leaves = _mm512_mask_i64gather_epi32(_mm256_setzero_si256(),
+			msk_leaf, idx, (const void *)dp->leaves, 2);
+		s->ent = _mm512_mask_mov_epi64(s->ent, msk_leaf,
+			_mm512_and_si512(_mm512_cvtepu32_epi64(leaves),
+			_mm512_set1_epi64(UINT16_MAX)));
+	} else if (size == sizeof(uint32_t)) {
+		leaves = _mm512_mask_i64gather_epi32(_mm256_setzero_si256(),
+			msk_leaf, idx, (const void *)dp->leaves, 4);
+		s->ent = _mm512_mask_mov_epi64(s->ent, msk_leaf,
+			_mm512_cvtepu32_epi64(leaves));
+	} else
+		s->ent = _mm512_mask_i64gather_epi64(s->ent, msk_leaf, idx,
+			(const void *)dp->leaves, 8);
+
+	s->msk_ext = msk_node;
+}
+
+static __rte_always_inline void
+poptrie_vec_lookup_x8x2(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, int size)
+{
+	struct rte_poptrie_tbl *dp = (struct rte_poptrie_tbl *)p;
+	struct poptrie_x8 s1, s2;
+	int lvl;
+
+	poptrie_vec_init_x8(dp, ips, &s1);
+	poptrie_vec_init_x8(dp, ips + 8, &s2);
+
+	/* all the lanes are at the same level of the poptrie */
+	for (lvl = 0; (s1.msk_ext | s2.msk_ext) != 0; lvl++) {
+		if (lvl == POPTRIE_HI_LEVELS) {
+			s1.key = s1.lo;
+			s2.key = s2.lo;
+		}
+		poptrie_vec_step_x8(dp, &s1, size);
+		poptrie_vec_step_x8(dp, &s2, size);
+	}
+
+	_mm512_storeu_si512(next_hops, _mm512_srli_epi64(s1.ent, 1));
+	_mm512_storeu_si512(next_hops + 8, _mm512_srli_epi64(s2.ent, 1));
+}
+
+void
+rte_poptrie_vec_lookup_bulk_2b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+	for (i = 0; i < (n / 16); i++) {
+		poptrie_vec_lookup_x8x2(p, &ips[i * 16],
+				next_hops + i * 16, sizeof(uint16_t));
+	}
+	rte_poptrie_lookup_bulk_2b(p, &ips[i * 16],
+			next_hops + i * 16, n - i * 16);
+}
+
+void
+rte_poptrie_vec_lookup_bulk_4b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+	for (i = 0; i < (n / 16); i++) {
+		poptrie_vec_lookup_x8x2(p, &ips[i * 16],
+				next_hops + i * 16, sizeof(uint32_t));
+	}
+	rte_poptrie_lookup_bulk_4b(p, &ips[i * 16],
+			next_hops + i * 16, n - i * 16);
+}
+
+void
+rte_poptrie_vec_lookup_bulk_8b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+	for (i = 0; i < (n / 16); i++) {
+		poptrie_vec_lookup_x8x2(p, &ips[i * 16],
+				next_hops + i * 16, sizeof(uint64_t));
+	}
+	rte_poptrie_lookup_bulk_8b(p, &ips[i * 16],
+			next_hops + i * 16, n - i * 16);
+}
@@ -37,6 +37,13 @@ EAL_REGISTER_TAILQ(rte_fib_tailq)
 #define FIB_RETURN_IF_TRUE(cond, retval)
 #endif
 
+#define FIB_BULK_RADIX_BITS	11
+#define FIB_BULK_RADIX_SIZE	(1 << FIB_BULK_RADIX_BITS)
+#define FIB_BULK_KEY_BITS	41
+
+typedef int (*fib_add_bulk_fn_t)(struct rte_fib *fib,
+	const struct rte_fib_route *routes, unsigned int n);
+
 struct rte_fib {
 	char			name[RTE_FIB_NAMESIZE];
 	enum rte_fib_type	type;	/**< Type of FIB struct */
@@ -45,6 +52,7 @@ struct rte_fib {
 	void			*dp;	/**< pointer to the dataplane struct*/
 	rte_fib_lookup_fn_t	lookup;	/**< FIB lookup function */
 	rte_fib_modify_fn_t	modify; /**< modify FIB datastructure */
+	fib_add_bulk_fn_t	add_bulk; /**< bulk add, NULL if not supported */
 	uint64_t		def_nh;
 };
 
@@ -111,6 +119,7 @@ init_dataplane(struct rte_fib *fib, __rte_unused int socket_id,
 		fib->lookup = dir24_8_get_lookup_fn(fib->dp,
 			RTE_FIB_LOOKUP_DEFAULT, !!(fib->flags & RTE_FIB_F_LOOKUP_NETWORK_ORDER));
 		fib->modify = dir24_8_modify;
+		fib->add_bulk = dir24_8_add_bulk;
 		return 0;
 	default:
 		return -EINVAL;
@@ -138,6 +147,124 @@ rte_fib_delete(struct rte_fib *fib, uint32_t ip, uint8_t depth)
 	return fib->modify(fib, ip, depth, 0, RTE_FIB_DEL);
 }
 
+/*
+ * Sort key of a prepared route: prefixes up to /24 ordered by length
+ * and address, followed by the longer ones ordered by their /24,
+ * length and address. The address must be already masked.
+ */
+static inline uint64_t
+bulk_route_key(const struct rte_fib_route *route)
+{
+	if (route->depth <= 24)
+		return ((uint64_t)route->depth << 32) | route->ip;
+	return (1ULL << 40) | ((uint64_t)(route->ip >> 8) << 14) |
+		((uint64_t)route->depth << 8) | (route->ip & UINT8_MAX);
+}
+
+static bool
+bulk_is_prepared(const struct rte_fib_route *routes, unsigned int n)
+{
+	unsigned int i;
+
+	for (i = 1; i < n; i++) {
+		if (bulk_route_key(&routes[i - 1]) >=
+				bulk_route_key(&routes[i]))
+			return false;
+	}
+	return true;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_fib_bulk_prepare, 26.03)
+int
+rte_fib_bulk_prepare(struct rte_fib_route *routes, unsigned int n)
+{
+	struct rte_fib_route *tmp, *src, *dst;
+	uint32_t cnt[FIB_BULK_RADIX_SIZE];
+	uint32_t i, j, sum, c, digit;
+	unsigned int shift;
+
+	if (((routes == NULL) && (n != 0)) || (n > INT32_MAX))
+		return -EINVAL;
+
+	for (i = 0; i < n; i++) {
+		if (routes[i].depth > RTE_FIB_MAXDEPTH)
+			return -EINVAL;
+		routes[i].ip &= rte_rib_depth_to_mask(routes[i].depth);
+	}
+
+	if (bulk_is_prepared(routes, n))
+		return n;
+
+	tmp = rte_malloc("FIB_BULK", sizeof(*tmp) * n, 0);
+	if (tmp == NULL)
+		return -ENOMEM;
+
+	/*
+	 * LSD radix sort keeps the input order of equal keys,
+	 * so the last occurrence of a prefix ends up last in its run.
+	 * Even number of passes leaves the result in routes.
+	 */
+	src = routes;
+	dst = tmp;
+	for (shift = 0; shift < FIB_BULK_KEY_BITS;
+			shift += FIB_BULK_RADIX_BITS) {
+		memset(cnt, 0, sizeof(cnt));
+		for (i = 0; i < n; i++)
+			cnt[(bulk_route_key(&src[i]) >> shift) &
+				(FIB_BULK_RADIX_SIZE - 1)]++;
+		for (i = 0, sum = 0; i < FIB_BULK_RADIX_SIZE; i++) {
+			c = cnt[i];
+			cnt[i] = sum;
+			sum += c;
+		}
+		for (i = 0; i < n; i++) {
+			digit = (bulk_route_key(&src[i]) >> shift) &
+				(FIB_BULK_RADIX_SIZE - 1);
+			dst[cnt[digit]++] = src[i];
+		}
+		RTE_SWAP(src, dst);
+	}
+	RTE_ASSERT(src == routes);
+	rte_free(tmp);
+
+	for (i = 0, j = 0; i < n; i++) {
+		if ((i + 1 < n) && (bulk_route_key(&routes[i]) ==
+				bulk_route_key(&routes[i + 1])))
+			continue;
+		routes[j++] = routes[i];
+	}
+
+	return j;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_fib_add_bulk, 26.03)
+int
+rte_fib_add_bulk(struct rte_fib *fib, struct rte_fib_route *routes,
+	unsigned int n)
+{
+	unsigned int i;
+	int ret;
+
+	if ((fib == NULL) || (fib->modify == NULL))
+		return -EINVAL;
+
+	ret = rte_fib_bulk_prepare(routes, n);
+	if (ret < 0)
+		return ret;
+	n = ret;
+
+	if (fib->add_bulk != NULL)
+		return fib->add_bulk(fib, routes, n);
+
+	for (i = 0; i < n; i++) {
+		ret = fib->modify(fib, routes[i].ip, routes[i].depth,
+			routes[i].next_hop, RTE_FIB_ADD);
+		if (ret != 0)
+			return ret;
+	}
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_fib_lookup_bulk)
 int
 rte_fib_lookup_bulk(struct rte_fib *fib, uint32_t *ips,
@@ -87,8 +87,12 @@ enum rte_fib_lookup_type {
 	/**<
 	 * Unified lookup function for all next hop sizes
 	 */
-	RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512
+	RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512,
 	/**< Vector implementation using AVX512 */
+	RTE_FIB_LOOKUP_DIR24_8_VECTOR_NEON,
+	/**< Vector implementation using NEON */
+	RTE_FIB_LOOKUP_DIR24_8_VECTOR_SVE
+	/**< Vector implementation using SVE gathers */
 };
 
 /** If set, fib lookup is expecting IPv4 address in network byte order */
@@ -112,6 +116,13 @@ struct rte_fib_conf {
 	unsigned int flags; /**< Optional feature flags from RTE_FIB_F_* */
 };
 
+/** Route entry for FIB bulk update. */
+struct rte_fib_route {
+	uint32_t	ip;	/**< IPv4 prefix address */
+	uint8_t		depth;	/**< Prefix length */
+	uint64_t	next_hop; /**< Next hop of the prefix */
+};
+
 /** FIB RCU QSBR configuration structure. */
 struct rte_fib_rcu_config {
 	/** RCU QSBR variable. */
@@ -204,6 +215,67 @@ rte_fib_add(struct rte_fib *fib, uint32_t ip, uint8_t depth, uint64_t next_hop);
 int
 rte_fib_delete(struct rte_fib *fib, uint32_t ip, uint8_t depth);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Prepare a batch of routes for rte_fib_add_bulk().
+ *
+ * The prefix addresses are masked to their length, and the routes are
+ * sorted so that shorter prefixes come first and the prefixes longer
+ * than /24 are grouped by the /24 they belong to.
+ * If the same prefix appears several times, only the last occurrence
+ * is kept.
+ *
+ * This function does not access any FIB, so several threads may
+ * prepare their own batches in parallel, while another thread
+ * applies the already prepared ones.
+ *
+ * @param routes
+ *   Array of routes, sorted and coalesced in place
+ * @param n
+ *   Number of elements in routes array
+ * @return
+ *   Number of routes left in the array on success, negative value otherwise:
+ *   - -EINVAL - invalid parameters
+ *   - -ENOMEM - memory allocation failure
+ */
+__rte_experimental
+int
+rte_fib_bulk_prepare(struct rte_fib_route *routes, unsigned int n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Add a batch of routes to the FIB.
+ *
+ * The routes are prepared first with rte_fib_bulk_prepare(),
+ * unless they already are in the prepared order.
+ * For the DIR24_8 FIB, the number of tbl8 groups needed by the whole
+ * batch is checked before any change, and each tbl8 group is written
+ * out once for all the routes falling into it.
+ *
+ * As with rte_fib_add(), updates of a FIB must be serialized by the
+ * caller. Batches modifying disjoint sets of prefixes may be applied
+ * in any order.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param routes
+ *   Array of routes to be added to the FIB, sorted and coalesced in place
+ * @param n
+ *   Number of elements in routes array
+ * @return
+ *   0 on success, negative value otherwise.
+ *   On failure, the routes preceding the failed one in the
+ *   prepared array stay in the FIB.
+ */
+__rte_experimental
+int
+rte_fib_add_bulk(struct rte_fib *fib, struct rte_fib_route *routes,
+	unsigned int n);
+
 /**
  * Lookup multiple IP addresses in the FIB.
  *
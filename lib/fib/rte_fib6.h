@@ -51,7 +51,8 @@ enum rte_fib6_qsbr_mode {
 /** Type of FIB struct */
 enum rte_fib6_type {
 	RTE_FIB6_DUMMY,		/**< RIB6 tree based FIB */
-	RTE_FIB6_TRIE		/**< TRIE based fib  */
+	RTE_FIB6_TRIE,		/**< TRIE based fib  */
+	RTE_FIB6_POPTRIE	/**< Popcount compressed multibit trie */
 };
 
 /** Modify FIB function */
@@ -68,7 +69,7 @@ enum rte_fib6_op {
 	RTE_FIB6_DEL,
 };
 
-/** Size of nexthop (1 << nh_sz) bits for TRIE based FIB */
+/** Size of nexthop (1 << nh_sz) bits for TRIE and POPTRIE based FIB */
 enum rte_fib_trie_nh_sz {
 	RTE_FIB6_TRIE_2B = 1,
 	RTE_FIB6_TRIE_4B,
@@ -80,7 +81,12 @@ enum rte_fib6_lookup_type {
 	RTE_FIB6_LOOKUP_DEFAULT,
 	/**< Selects the best implementation based on the max simd bitwidth */
 	RTE_FIB6_LOOKUP_TRIE_SCALAR, /**< Scalar lookup function implementation*/
-	RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512 /**< Vector implementation using AVX512 */
+	RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512, /**< Vector implementation using AVX512 */
+	RTE_FIB6_LOOKUP_TRIE_VECTOR_NEON, /**< Vector implementation using NEON */
+	RTE_FIB6_LOOKUP_TRIE_VECTOR_SVE, /**< Vector implementation using SVE gathers */
+	RTE_FIB6_LOOKUP_POPTRIE_SCALAR, /**< Scalar poptrie lookup */
+	RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX2, /**< Poptrie lookup using AVX2 */
+	RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX512 /**< Poptrie lookup using AVX512 */
 };
 
 /** FIB configuration structure */
@@ -96,6 +102,13 @@ struct rte_fib6_conf {
 			enum rte_fib_trie_nh_sz nh_sz;
 			uint32_t	num_tbl8;
 		} trie;
+		struct {
+			enum rte_fib_trie_nh_sz nh_sz;
+			/** Number of 64-slot internal nodes */
+			uint32_t	num_nodes;
+			/** Number of leaves, shared by all the nodes */
+			uint32_t	num_leaves;
+		} poptrie;
 	};
 };
 
@@ -10,6 +10,7 @@
 #include <rte_malloc.h>
 #include <rte_cpuflags.h>
 #include <rte_errno.h>
+#include <rte_vect.h>
 
 #include <rte_rib6.h>
 #include <rte_fib6.h>
@@ -20,6 +21,13 @@
 
 #include "trie_avx512.h"
 
+#elif defined(RTE_ARCH_ARM64)
+
+#include "trie_neon.h"
+#ifdef RTE_HAS_SVE_ACLE
+#include "trie_sve.h"
+#endif
+
 #endif /* CC_AVX512_SUPPORT */
 
 #define TRIE_NAMESIZE		64
@@ -69,6 +77,51 @@ get_vector_fn(enum rte_fib_trie_nh_sz nh_sz)
 	return NULL;
 }
 
+static inline rte_fib6_lookup_fn_t
+get_neon_fn(enum rte_fib_trie_nh_sz nh_sz)
+{
+#ifdef RTE_ARCH_ARM64
+	if (rte_vect_get_max_simd_bitwidth() < RTE_VECT_SIMD_128)
+		return NULL;
+	switch (nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return rte_trie_neon_lookup_bulk_2b;
+	case RTE_FIB6_TRIE_4B:
+		return rte_trie_neon_lookup_bulk_4b;
+	case RTE_FIB6_TRIE_8B:
+		return rte_trie_neon_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+#else
+	RTE_SET_USED(nh_sz);
+#endif
+	return NULL;
+}
+
+static inline rte_fib6_lookup_fn_t
+get_sve_fn(enum rte_fib_trie_nh_sz nh_sz)
+{
+#ifdef RTE_HAS_SVE_ACLE
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_SVE) <= 0 ||
+			rte_vect_get_max_simd_bitwidth() < RTE_VECT_SIMD_128)
+		return NULL;
+	switch (nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return rte_trie_sve_lookup_bulk_2b;
+	case RTE_FIB6_TRIE_4B:
+		return rte_trie_sve_lookup_bulk_4b;
+	case RTE_FIB6_TRIE_8B:
+		return rte_trie_sve_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+#else
+	RTE_SET_USED(nh_sz);
+#endif
+	return NULL;
+}
+
 rte_fib6_lookup_fn_t
 trie_get_lookup_fn(void *p, enum rte_fib6_lookup_type type)
 {
@@ -86,8 +139,16 @@ trie_get_lookup_fn(void *p, enum rte_fib6_lookup_type type)
 		return get_scalar_fn(nh_sz);
 	case RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512:
 		return get_vector_fn(nh_sz);
+	case RTE_FIB6_LOOKUP_TRIE_VECTOR_NEON:
+		return get_neon_fn(nh_sz);
+	case RTE_FIB6_LOOKUP_TRIE_VECTOR_SVE:
+		return get_sve_fn(nh_sz);
 	case RTE_FIB6_LOOKUP_DEFAULT:
 		ret_fn = get_vector_fn(nh_sz);
+		if (ret_fn == NULL)
+			ret_fn = get_sve_fn(nh_sz);
+		if (ret_fn == NULL)
+			ret_fn = get_neon_fn(nh_sz);
 		return (ret_fn != NULL) ? ret_fn : get_scalar_fn(nh_sz);
 	default:
 		return NULL;
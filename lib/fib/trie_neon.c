@@ -0,0 +1,123 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+#include <rte_fib6.h>
+
+#include "trie.h"
+#include "trie_neon.h"
+
+/*
+ * NEON has no gather instruction: the addresses of 4 lanes are
+ * transposed and their bytes extracted on vectors, while the table
+ * entries are loaded one by one.
+ */
+
+static __rte_always_inline uint64_t
+get_ent(const uint64_t *tbl, uint64_t idx, int size)
+{
+	if (size == sizeof(uint16_t))
+		return ((const uint16_t *)tbl)[idx];
+	else if (size == sizeof(uint32_t))
+		return ((const uint32_t *)tbl)[idx];
+	return tbl[idx];
+}
+
+static __rte_always_inline uint32x4_t
+get_bytes(const uint32x4x4_t *w, unsigned int j)
+{
+	/* words are in host order, byte 0 of each word is the msb */
+	return vandq_u32(vshlq_u32(w->val[j / 4],
+		vdupq_n_s32(-8 * (3 - (int)(j % 4)))), vdupq_n_u32(UINT8_MAX));
+}
+
+static __rte_always_inline void
+trie_neon_lookup_x4(struct rte_trie_tbl *dp, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, int size)
+{
+	uint32x4x4_t w;
+	uint32_t idxes[4], bytes[4];
+	uint64_t ents[4];
+	unsigned int i, j;
+	int ext;
+
+	/* transpose the 4 byte words of the 4 addresses, to host order */
+	w = vld4q_u32((const uint32_t *)ips);
+	for (i = 0; i < 4; i++)
+		w.val[i] = vreinterpretq_u32_u8(vrev32q_u8(
+			vreinterpretq_u8_u32(w.val[i])));
+
+	/* lookup in tbl24 */
+	vst1q_u32(idxes, vshrq_n_u32(w.val[0], 8));
+	ext = 0;
+	for (i = 0; i < RTE_DIM(ents); i++) {
+		ents[i] = get_ent(dp->tbl24, idxes[i], size);
+		ext |= is_entry_extended(ents[i]);
+	}
+
+	/* walk tbl8 levels while some entries are extended */
+	for (j = 3; ext != 0; j++) {
+		vst1q_u32(bytes, get_bytes(&w, j));
+		ext = 0;
+		for (i = 0; i < RTE_DIM(ents); i++) {
+			if (!is_entry_extended(ents[i]))
+				continue;
+			ents[i] = get_ent(dp->tbl8, bytes[i] +
+				(ents[i] >> 1) * TRIE_TBL8_GRP_NUM_ENT, size);
+			ext |= is_entry_extended(ents[i]);
+		}
+	}
+
+	vst1q_u64(next_hops, vshrq_n_u64(vld1q_u64(ents), 1));
+	vst1q_u64(next_hops + 2, vshrq_n_u64(vld1q_u64(ents + 2), 1));
+}
+
+static __rte_always_inline void
+trie_neon_lookup_bulk(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n, int size)
+{
+	struct rte_trie_tbl *dp = (struct rte_trie_tbl *)p;
+	uint32_t i, j;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		/* prefetch tbl24 entries of the IPs two iterations ahead */
+		for (j = i + 8; (j < i + 12) && (j < n); j++)
+			rte_prefetch0(get_tbl24_p(dp, &ips[j], dp->nh_sz));
+		trie_neon_lookup_x4(dp, ips + i, next_hops + i, size);
+	}
+
+	/* lookup remaining IPs */
+	switch (size) {
+	case sizeof(uint16_t):
+		rte_trie_lookup_bulk_2b(p, ips + i, next_hops + i, n - i);
+		break;
+	case sizeof(uint32_t):
+		rte_trie_lookup_bulk_4b(p, ips + i, next_hops + i, n - i);
+		break;
+	default:
+		rte_trie_lookup_bulk_8b(p, ips + i, next_hops + i, n - i);
+		break;
+	}
+}
+
+void
+rte_trie_neon_lookup_bulk_2b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	trie_neon_lookup_bulk(p, ips, next_hops, n, sizeof(uint16_t));
+}
+
+void
+rte_trie_neon_lookup_bulk_4b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	trie_neon_lookup_bulk(p, ips, next_hops, n, sizeof(uint32_t));
+}
+
+void
+rte_trie_neon_lookup_bulk_8b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	trie_neon_lookup_bulk(p, ips, next_hops, n, sizeof(uint64_t));
+}
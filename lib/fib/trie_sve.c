@@ -0,0 +1,129 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+#include <rte_fib6.h>
+
+#include "trie.h"
+#include "trie_sve.h"
+
+static __rte_always_inline svuint32_t
+gather_x32(svbool_t pg, const uint64_t *tbl, svuint32_t idx, int size)
+{
+	if (size == sizeof(uint16_t))
+		return svld1uh_gather_u32index_u32(pg, (const uint16_t *)tbl,
+			idx);
+	return svld1_gather_u32index_u32(pg, (const uint32_t *)tbl, idx);
+}
+
+/* lookup with 32 bit lanes, for 2 and 4 bytes next hops */
+static __rte_always_inline void
+trie_sve_lookup_bulk_x32(struct rte_trie_tbl *dp,
+	const struct rte_ipv6_addr *ips, uint64_t *next_hops,
+	const unsigned int n, int size)
+{
+	/* offsets of the addresses processed by the lanes */
+	const svuint32_t offs = svindex_u32(0, sizeof(struct rte_ipv6_addr));
+	const uint8_t *a;
+	svuint32_t idx, res;
+	svbool_t pg, pe;
+	uint32_t i, j;
+
+	for (i = 0; i < n; i += svcntw()) {
+		pg = svwhilelt_b32_u32(i, n);
+		a = ips[i].a;
+
+		/* lookup in tbl24 */
+		idx = svorr_u32_x(pg,
+			svlsl_n_u32_x(pg,
+				svld1ub_gather_u32offset_u32(pg, &a[0], offs), 16),
+			svlsl_n_u32_x(pg,
+				svld1ub_gather_u32offset_u32(pg, &a[1], offs), 8));
+		idx = svorr_u32_x(pg, idx,
+			svld1ub_gather_u32offset_u32(pg, &a[2], offs));
+		res = gather_x32(pg, dp->tbl24, idx, size);
+
+		/* walk tbl8 levels while some entries are extended */
+		pe = svcmpne_n_u32(pg, svand_n_u32_x(pg, res, TRIE_EXT_ENT), 0);
+		for (j = 3; svptest_any(pg, pe); j++) {
+			idx = svadd_u32_x(pe,
+				svlsl_n_u32_x(pe, svlsr_n_u32_x(pe, res, 1), 8),
+				svld1ub_gather_u32offset_u32(pe, &a[j], offs));
+			res = svsel_u32(pe, gather_x32(pe, dp->tbl8, idx, size),
+				res);
+			pe = svcmpne_n_u32(pe,
+				svand_n_u32_x(pe, res, TRIE_EXT_ENT), 0);
+		}
+
+		res = svlsr_n_u32_x(pg, res, 1);
+		svst1_u64(svwhilelt_b64_u32(i, n), &next_hops[i],
+			svunpklo_u64(res));
+		svst1_u64(svwhilelt_b64_u32(i + svcntd(), n),
+			&next_hops[i + svcntd()], svunpkhi_u64(res));
+	}
+}
+
+/* lookup with 64 bit lanes, for 8 bytes next hops */
+static __rte_always_inline void
+trie_sve_lookup_bulk_x64(struct rte_trie_tbl *dp,
+	const struct rte_ipv6_addr *ips, uint64_t *next_hops,
+	const unsigned int n)
+{
+	/* offsets of the addresses processed by the lanes */
+	const svuint64_t offs = svindex_u64(0, sizeof(struct rte_ipv6_addr));
+	const uint8_t *a;
+	svuint64_t idx, res;
+	svbool_t pg, pe;
+	uint32_t i, j;
+
+	for (i = 0; i < n; i += svcntd()) {
+		pg = svwhilelt_b64_u32(i, n);
+		a = ips[i].a;
+
+		/* lookup in tbl24 */
+		idx = svorr_u64_x(pg,
+			svlsl_n_u64_x(pg,
+				svld1ub_gather_u64offset_u64(pg, &a[0], offs), 16),
+			svlsl_n_u64_x(pg,
+				svld1ub_gather_u64offset_u64(pg, &a[1], offs), 8));
+		idx = svorr_u64_x(pg, idx,
+			svld1ub_gather_u64offset_u64(pg, &a[2], offs));
+		res = svld1_gather_u64index_u64(pg, dp->tbl24, idx);
+
+		/* walk tbl8 levels while some entries are extended */
+		pe = svcmpne_n_u64(pg, svand_n_u64_x(pg, res, TRIE_EXT_ENT), 0);
+		for (j = 3; svptest_any(pg, pe); j++) {
+			idx = svadd_u64_x(pe,
+				svlsl_n_u64_x(pe, svlsr_n_u64_x(pe, res, 1), 8),
+				svld1ub_gather_u64offset_u64(pe, &a[j], offs));
+			res = svsel_u64(pe,
+				svld1_gather_u64index_u64(pe, dp->tbl8, idx), res);
+			pe = svcmpne_n_u64(pe,
+				svand_n_u64_x(pe, res, TRIE_EXT_ENT), 0);
+		}
+
+		svst1_u64(pg, &next_hops[i], svlsr_n_u64_x(pg, res, 1));
+	}
+}
+
+void
+rte_trie_sve_lookup_bulk_2b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	trie_sve_lookup_bulk_x32(p, ips, next_hops, n, sizeof(uint16_t));
+}
+
+void
+rte_trie_sve_lookup_bulk_4b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	trie_sve_lookup_bulk_x32(p, ips, next_hops, n, sizeof(uint32_t));
+}
+
+void
+rte_trie_sve_lookup_bulk_8b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	trie_sve_lookup_bulk_x64(p, ips, next_hops, n);
+}
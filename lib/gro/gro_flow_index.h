@@ -0,0 +1,225 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _GRO_FLOW_INDEX_H_
+#define _GRO_FLOW_INDEX_H_
+
+#include <string.h>
+
+#include <rte_atomic.h>
+#include <rte_common.h>
+#include <rte_bitops.h>
+#include <rte_hash_crc.h>
+#include <rte_malloc.h>
+#include <rte_vect.h>
+
+#include "rte_gro.h"
+
+/*
+ * Hashed index over the flow array of a reassembly table, so that the
+ * flow of a packet is found without comparing its key with every flow.
+ *
+ * Each bucket keeps the signatures (i.e. the hash values) and the flow
+ * array indexes of up to GRO_FLOW_BKT_ENTRIES flows in one cache line.
+ * The signatures of a bucket are compared with one SIMD instruction, and
+ * only the flows whose signature matches get their key compared. A flow
+ * is stored in its primary bucket or, if full, in the adjacent one. If
+ * both are full, the flow is only counted as an overflow flow, and the
+ * lookups fall back to scanning the flow array while there is any.
+ */
+
+#define GRO_FLOW_BKT_ENTRIES 8
+/* A zero signature indicates an empty entry */
+#define GRO_FLOW_SIG_EMPTY 0
+
+/*
+ * The maximum number of buckets used by rte_gro_reassemble_burst(),
+ * which are allocated in the stack.
+ */
+#define GRO_FLOW_BURST_BKT_NUM (RTE_GRO_MAX_BURST_ITEM_NUM / 2)
+
+struct __rte_cache_aligned gro_flow_bkt {
+	uint32_t sig[GRO_FLOW_BKT_ENTRIES];
+	uint32_t flow_idx[GRO_FLOW_BKT_ENTRIES];
+};
+
+struct gro_flow_index {
+	struct gro_flow_bkt *bkts;
+	uint32_t bkt_mask;
+	/* number of flows which are not in their buckets */
+	uint32_t nb_overflow;
+};
+
+/*
+ * Get the number of buckets for a table of max_flow_num flows. It keeps
+ * the average bucket load under a quarter.
+ */
+static inline uint32_t
+gro_flow_index_bkt_num(uint32_t max_flow_num)
+{
+	return RTE_MAX(rte_align32pow2(max_flow_num) / 2, 2U);
+}
+
+static inline int
+gro_flow_index_create(struct gro_flow_index *idx, uint32_t max_flow_num,
+		uint16_t socket_id)
+{
+	uint32_t nb_bkts = gro_flow_index_bkt_num(max_flow_num);
+
+	idx->bkts = rte_zmalloc_socket(__func__,
+			sizeof(struct gro_flow_bkt) * nb_bkts,
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (idx->bkts == NULL)
+		return -1;
+	idx->bkt_mask = nb_bkts - 1;
+	idx->nb_overflow = 0;
+
+	return 0;
+}
+
+static inline void
+gro_flow_index_free(struct gro_flow_index *idx)
+{
+	rte_free(idx->bkts);
+	idx->bkts = NULL;
+}
+
+/*
+ * Initialize an index on caller-provided buckets, which must be able to
+ * hold gro_flow_index_bkt_num(max_flow_num) buckets.
+ */
+static inline void
+gro_flow_index_init(struct gro_flow_index *idx, struct gro_flow_bkt *bkts,
+		uint32_t max_flow_num)
+{
+	uint32_t nb_bkts = gro_flow_index_bkt_num(max_flow_num);
+
+	memset(bkts, 0, sizeof(struct gro_flow_bkt) * nb_bkts);
+	idx->bkts = bkts;
+	idx->bkt_mask = nb_bkts - 1;
+	idx->nb_overflow = 0;
+}
+
+/*
+ * The keys are built field by field right before being hashed by words:
+ * the barrier prevents the compiler from reading them before they are
+ * stored, as the accesses do not have compatible types.
+ */
+static inline uint32_t
+gro_flow_hash(const void *key, uint32_t key_len)
+{
+	rte_compiler_barrier();
+	return rte_hash_crc(key, key_len, UINT32_MAX);
+}
+
+static inline uint32_t
+gro_flow_sig(uint32_t hash)
+{
+	return hash == GRO_FLOW_SIG_EMPTY ? 1 : hash;
+}
+
+/*
+ * Get the n-th (0 or 1) bucket which may hold a flow. The two buckets
+ * are in adjacent cache lines.
+ */
+static inline struct gro_flow_bkt *
+gro_flow_index_bkt(const struct gro_flow_index *idx, uint32_t hash,
+		uint32_t n)
+{
+	return &idx->bkts[((hash & idx->bkt_mask) ^ n)];
+}
+
+/*
+ * Compare all the signatures of a bucket with sig, and return a bitmask
+ * of the matching entries.
+ */
+static inline uint32_t
+gro_flow_bkt_match(const struct gro_flow_bkt *bkt, uint32_t sig)
+{
+#if defined(__AVX2__)
+	__m256i v = _mm256_load_si256((const __m256i *)bkt->sig);
+
+	v = _mm256_cmpeq_epi32(v, _mm256_set1_epi32(sig));
+	return _mm256_movemask_ps(_mm256_castsi256_ps(v));
+#elif defined(RTE_ARCH_X86)
+	__m128i s = _mm_set1_epi32(sig);
+	__m128i lo = _mm_load_si128((const __m128i *)bkt->sig);
+	__m128i hi = _mm_load_si128((const __m128i *)&bkt->sig[4]);
+
+	lo = _mm_cmpeq_epi32(lo, s);
+	hi = _mm_cmpeq_epi32(hi, s);
+	return _mm_movemask_ps(_mm_castsi128_ps(lo)) |
+		(_mm_movemask_ps(_mm_castsi128_ps(hi)) << 4);
+#elif defined(RTE_ARCH_ARM64)
+	static const uint32_t lo_bits[4] = {1, 2, 4, 8};
+	static const uint32_t hi_bits[4] = {16, 32, 64, 128};
+	uint32x4_t s = vdupq_n_u32(sig);
+	uint32x4_t lo, hi;
+
+	lo = vandq_u32(vceqq_u32(vld1q_u32(bkt->sig), s), vld1q_u32(lo_bits));
+	hi = vandq_u32(vceqq_u32(vld1q_u32(&bkt->sig[4]), s),
+			vld1q_u32(hi_bits));
+	return vaddvq_u32(vorrq_u32(lo, hi));
+#else
+	uint32_t i, hits = 0;
+
+	for (i = 0; i < GRO_FLOW_BKT_ENTRIES; i++)
+		hits |= (uint32_t)(bkt->sig[i] == sig) << i;
+	return hits;
+#endif
+}
+
+/*
+ * Add a flow into the index. If both buckets of the flow are full, the
+ * flow is counted as an overflow flow, which the lookups have to find
+ * by scanning the flow array.
+ */
+static inline void
+gro_flow_index_add(struct gro_flow_index *idx, uint32_t hash,
+		uint32_t flow_idx)
+{
+	struct gro_flow_bkt *bkt;
+	uint32_t n, i, free_slots;
+
+	for (n = 0; n < 2; n++) {
+		bkt = gro_flow_index_bkt(idx, hash, n);
+		free_slots = gro_flow_bkt_match(bkt, GRO_FLOW_SIG_EMPTY);
+		if (free_slots != 0) {
+			i = rte_ctz32(free_slots);
+			bkt->sig[i] = gro_flow_sig(hash);
+			bkt->flow_idx[i] = flow_idx;
+			return;
+		}
+	}
+
+	idx->nb_overflow++;
+}
+
+/* Remove a flow, which was added into the index, from the index. */
+static inline void
+gro_flow_index_del(struct gro_flow_index *idx, uint32_t hash,
+		uint32_t flow_idx)
+{
+	struct gro_flow_bkt *bkt;
+	uint32_t n, i, hits;
+
+	for (n = 0; n < 2; n++) {
+		bkt = gro_flow_index_bkt(idx, hash, n);
+		hits = gro_flow_bkt_match(bkt, gro_flow_sig(hash));
+		while (hits != 0) {
+			i = rte_ctz32(hits);
+			if (bkt->flow_idx[i] == flow_idx) {
+				bkt->sig[i] = GRO_FLOW_SIG_EMPTY;
+				return;
+			}
+			hits &= hits - 1;
+		}
+	}
+
+	/* the flow did not fit into its buckets */
+	idx->nb_overflow--;
+}
+
+#endif
@@ -23,6 +23,8 @@ struct gro_tcp4_flow {
 	 * INVALID_ARRAY_INDEX indicates an empty flow.
 	 */
 	uint32_t start_index;
+	/* The hash value of the key, which indexes the flow */
+	uint32_t hash;
 };
 
 /*
@@ -41,6 +43,8 @@ struct gro_tcp4_tbl {
 	uint32_t max_item_num;
 	/* flow array size */
 	uint32_t max_flow_num;
+	/* hashed index of the flows */
+	struct gro_flow_index flow_index;
 };
 
 /**
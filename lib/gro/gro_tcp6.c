@@ -57,6 +57,14 @@ gro_tcp6_tbl_create(uint16_t socket_id,
 		tbl->flows[i].start_index = INVALID_ARRAY_INDEX;
 	tbl->max_flow_num = entries_num;
 
+	if (gro_flow_index_create(&tbl->flow_index, entries_num,
+				socket_id) != 0) {
+		rte_free(tbl->flows);
+		rte_free(tbl->items);
+		rte_free(tbl);
+		return NULL;
+	}
+
 	return tbl;
 }
 
@@ -68,6 +76,7 @@ gro_tcp6_tbl_destroy(void *tbl)
 	if (tcp_tbl) {
 		rte_free(tcp_tbl->items);
 		rte_free(tcp_tbl->flows);
+		gro_flow_index_free(&tcp_tbl->flow_index);
 	}
 	rte_free(tcp_tbl);
 }
@@ -78,15 +87,54 @@ find_an_empty_flow(struct gro_tcp6_tbl *tbl)
 	uint32_t i;
 	uint32_t max_flow_num = tbl->max_flow_num;
 
-	for (i = 0; i < max_flow_num; i++)
+	/* Start from the current flow number, which is likely to be free. */
+	for (i = tbl->flow_num; i < max_flow_num; i++)
 		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
 			return i;
+	for (i = 0; i < tbl->flow_num; i++)
+		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
+			return i;
+	return INVALID_ARRAY_INDEX;
+}
+
+static inline uint32_t
+find_flow(struct gro_tcp6_tbl *tbl,
+		struct tcp6_flow_key *key,
+		uint32_t hash)
+{
+	struct gro_flow_bkt *bkt;
+	uint32_t n, hits, flow_idx;
+
+	/* Only compare the keys of the flows whose signature matches. */
+	for (n = 0; n < 2; n++) {
+		bkt = gro_flow_index_bkt(&tbl->flow_index, hash, n);
+		hits = gro_flow_bkt_match(bkt, gro_flow_sig(hash));
+		while (hits != 0) {
+			flow_idx = bkt->flow_idx[rte_ctz32(hits)];
+			if (is_same_tcp6_flow(&tbl->flows[flow_idx].key, key))
+				return flow_idx;
+			hits &= hits - 1;
+		}
+	}
+
+	/* Look for the flows which did not fit into their buckets. */
+	if (likely(tbl->flow_index.nb_overflow == 0))
+		return INVALID_ARRAY_INDEX;
+	for (flow_idx = 0, n = 0; n < tbl->flow_num; flow_idx++) {
+		if (tbl->flows[flow_idx].start_index == INVALID_ARRAY_INDEX)
+			continue;
+		n++;
+		if (tbl->flows[flow_idx].hash == hash &&
+				is_same_tcp6_flow(&tbl->flows[flow_idx].key, key))
+			return flow_idx;
+	}
 	return INVALID_ARRAY_INDEX;
 }
 
 static inline uint32_t
 insert_new_flow(struct gro_tcp6_tbl *tbl,
 		struct tcp6_flow_key *src,
+		uint32_t hash,
 		uint32_t item_idx)
 {
 	struct tcp6_flow_key *dst;
@@ -95,6 +143,7 @@ insert_new_flow(struct gro_tcp6_tbl *tbl,
 	flow_idx = find_an_empty_flow(tbl);
 	if (unlikely(flow_idx == INVALID_ARRAY_INDEX))
 		return INVALID_ARRAY_INDEX;
+	gro_flow_index_add(&tbl->flow_index, hash, flow_idx);
 
 	dst = &(tbl->flows[flow_idx].key);
 
@@ -104,6 +153,7 @@ insert_new_flow(struct gro_tcp6_tbl *tbl,
 	dst->vtc_flow = src->vtc_flow;
 
 	tbl->flows[flow_idx].start_index = item_idx;
+	tbl->flows[flow_idx].hash = hash;
 	tbl->flow_num++;
 
 	return flow_idx;
@@ -134,10 +184,9 @@ gro_tcp6_reassemble(struct rte_mbuf *pkt,
 	int32_t tcp_dl;
 	uint16_t ip_tlen;
 	struct tcp6_flow_key key;
-	uint32_t i, max_flow_num, remaining_flow_num;
+	uint32_t i, hash;
 	uint32_t sent_seq;
 	struct rte_tcp_hdr *tcp_hdr;
-	uint8_t find;
 	uint32_t item_idx;
 	/*
 	 * Don't process the packet whose TCP header length is greater
@@ -173,30 +222,21 @@ gro_tcp6_reassemble(struct rte_mbuf *pkt,
 	key.cmn_key.src_port = tcp_hdr->src_port;
 	key.cmn_key.dst_port = tcp_hdr->dst_port;
 	key.cmn_key.recv_ack = tcp_hdr->recv_ack;
-	key.vtc_flow = ipv6_hdr->vtc_flow;
+	/* The traffic class isn't part of the flow, so don't hash it. */
+	key.vtc_flow = ipv6_hdr->vtc_flow & rte_cpu_to_be_32(0xF00FFFFF);
 
 	/* Search for a matched flow. */
-	max_flow_num = tbl->max_flow_num;
-	remaining_flow_num = tbl->flow_num;
-	find = 0;
-	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
-		if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
-			if (is_same_tcp6_flow(&tbl->flows[i].key, &key)) {
-				find = 1;
-				break;
-			}
-			remaining_flow_num--;
-		}
-	}
+	hash = gro_flow_hash(&key, sizeof(key));
+	i = find_flow(tbl, &key, hash);
 
-	if (find == 0) {
+	if (i == INVALID_ARRAY_INDEX) {
 		sent_seq = rte_be_to_cpu_32(tcp_hdr->sent_seq);
 		item_idx = insert_new_tcp_item(pkt, tbl->items, &tbl->item_num,
 						tbl->max_item_num, start_time,
 						INVALID_ARRAY_INDEX, sent_seq, 0, true);
 		if (item_idx == INVALID_ARRAY_INDEX)
 			return -1;
-		if (insert_new_flow(tbl, &key, item_idx) ==
+		if (insert_new_flow(tbl, &key, hash, item_idx) ==
 			INVALID_ARRAY_INDEX) {
 			/*
 			 * Fail to insert a new flow, so delete the
@@ -240,8 +280,11 @@ gro_tcp6_tbl_timeout_flush(struct gro_tcp6_tbl *tbl,
 				j = delete_tcp_item(tbl->items, j,
 						&tbl->item_num, INVALID_ARRAY_INDEX);
 				tbl->flows[i].start_index = j;
-				if (j == INVALID_ARRAY_INDEX)
+				if (j == INVALID_ARRAY_INDEX) {
+					gro_flow_index_del(&tbl->flow_index,
+							tbl->flows[i].hash, i);
 					tbl->flow_num--;
+				}
 
 				if (unlikely(k == nb_out))
 					return k;
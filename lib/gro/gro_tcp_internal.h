@@ -5,13 +5,24 @@
 #ifndef _GRO_TCP_INTERNAL_H_
 #define _GRO_TCP_INTERNAL_H_
 
+/*
+ * Items are mostly allocated and freed in order, so the search starts
+ * from the current item number, which is likely to be free.
+ */
 static inline uint32_t
 find_an_empty_item(struct gro_tcp_item *items,
+	uint32_t item_num,
 	uint32_t max_item_num)
 {
 	uint32_t i;
 
-	for (i = 0; i < max_item_num; i++)
+	if (unlikely(item_num >= max_item_num))
+		return INVALID_ARRAY_INDEX;
+
+	for (i = item_num; i < max_item_num; i++)
+		if (items[i].firstseg == NULL)
+			return i;
+	for (i = 0; i < item_num; i++)
 		if (items[i].firstseg == NULL)
 			return i;
 	return INVALID_ARRAY_INDEX;
@@ -30,7 +41,7 @@ insert_new_tcp_item(struct rte_mbuf *pkt,
 {
 	uint32_t item_idx;
 
-	item_idx = find_an_empty_item(items, max_item_num);
+	item_idx = find_an_empty_item(items, *item_num, max_item_num);
 	if (item_idx == INVALID_ARRAY_INDEX)
 		return INVALID_ARRAY_INDEX;
 
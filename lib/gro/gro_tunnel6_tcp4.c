@@ -0,0 +1,527 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_ethdev.h>
+#include <rte_udp.h>
+#include <rte_vxlan.h>
+#include <rte_geneve.h>
+
+#include "gro_tunnel6_tcp4.h"
+
+static void *
+gro_tunnel6_tcp4_tbl_create(uint16_t socket_id,
+		uint16_t max_flow_num,
+		uint16_t max_item_per_flow,
+		uint8_t tnl_type)
+{
+	struct gro_tunnel6_tcp4_tbl *tbl;
+	size_t size;
+	uint32_t entries_num, i;
+
+	entries_num = max_flow_num * max_item_per_flow;
+	entries_num = RTE_MIN(entries_num, GRO_TUNNEL6_TCP4_TBL_MAX_ITEM_NUM);
+
+	if (entries_num == 0)
+		return NULL;
+
+	tbl = rte_zmalloc_socket(__func__,
+			sizeof(struct gro_tunnel6_tcp4_tbl),
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (tbl == NULL)
+		return NULL;
+
+	size = sizeof(struct gro_tcp_item) * entries_num;
+	tbl->items = rte_zmalloc_socket(__func__,
+			size,
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (tbl->items == NULL) {
+		rte_free(tbl);
+		return NULL;
+	}
+	tbl->max_item_num = entries_num;
+
+	size = sizeof(struct gro_tunnel6_tcp4_flow) * entries_num;
+	tbl->flows = rte_zmalloc_socket(__func__,
+			size,
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (tbl->flows == NULL) {
+		rte_free(tbl->items);
+		rte_free(tbl);
+		return NULL;
+	}
+
+	for (i = 0; i < entries_num; i++)
+		tbl->flows[i].start_index = INVALID_ARRAY_INDEX;
+	tbl->max_flow_num = entries_num;
+
+	if (gro_flow_index_create(&tbl->flow_index, entries_num,
+				socket_id) != 0) {
+		rte_free(tbl->flows);
+		rte_free(tbl->items);
+		rte_free(tbl);
+		return NULL;
+	}
+	tbl->tnl_type = tnl_type;
+
+	return tbl;
+}
+
+void *
+gro_ipv6_vxlan_tcp4_tbl_create(uint16_t socket_id,
+		uint16_t max_flow_num,
+		uint16_t max_item_per_flow)
+{
+	return gro_tunnel6_tcp4_tbl_create(socket_id, max_flow_num,
+			max_item_per_flow, GRO_TUNNEL6_TYPE_VXLAN);
+}
+
+void *
+gro_ipv6_geneve_tcp4_tbl_create(uint16_t socket_id,
+		uint16_t max_flow_num,
+		uint16_t max_item_per_flow)
+{
+	return gro_tunnel6_tcp4_tbl_create(socket_id, max_flow_num,
+			max_item_per_flow, GRO_TUNNEL6_TYPE_GENEVE);
+}
+
+void
+gro_tunnel6_tcp4_tbl_destroy(void *tbl)
+{
+	struct gro_tunnel6_tcp4_tbl *tnl_tbl = tbl;
+
+	if (tnl_tbl) {
+		rte_free(tnl_tbl->items);
+		rte_free(tnl_tbl->flows);
+		gro_flow_index_free(&tnl_tbl->flow_index);
+	}
+	rte_free(tnl_tbl);
+}
+
+static inline uint32_t
+find_an_empty_item(struct gro_tunnel6_tcp4_tbl *tbl)
+{
+	uint32_t max_item_num = tbl->max_item_num, i;
+
+	/* Start from the current item number, which is likely to be free. */
+	for (i = tbl->item_num; i < max_item_num; i++)
+		if (tbl->items[i].firstseg == NULL)
+			return i;
+	for (i = 0; i < tbl->item_num; i++)
+		if (tbl->items[i].firstseg == NULL)
+			return i;
+	return INVALID_ARRAY_INDEX;
+}
+
+static inline uint32_t
+find_an_empty_flow(struct gro_tunnel6_tcp4_tbl *tbl)
+{
+	uint32_t i;
+	uint32_t max_flow_num = tbl->max_flow_num;
+
+	/* Start from the current flow number, which is likely to be free. */
+	for (i = tbl->flow_num; i < max_flow_num; i++)
+		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
+			return i;
+	for (i = 0; i < tbl->flow_num; i++)
+		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
+			return i;
+	return INVALID_ARRAY_INDEX;
+}
+
+static inline uint32_t
+insert_new_item(struct gro_tunnel6_tcp4_tbl *tbl,
+		struct rte_mbuf *pkt,
+		uint64_t start_time,
+		uint32_t prev_idx,
+		uint32_t sent_seq,
+		uint16_t ip_id,
+		uint8_t is_atomic)
+{
+	uint32_t item_idx;
+
+	item_idx = find_an_empty_item(tbl);
+	if (unlikely(item_idx == INVALID_ARRAY_INDEX))
+		return INVALID_ARRAY_INDEX;
+
+	tbl->items[item_idx].firstseg = pkt;
+	tbl->items[item_idx].lastseg = rte_pktmbuf_lastseg(pkt);
+	tbl->items[item_idx].start_time = start_time;
+	tbl->items[item_idx].next_pkt_idx = INVALID_ARRAY_INDEX;
+	tbl->items[item_idx].sent_seq = sent_seq;
+	tbl->items[item_idx].l3.ip_id = ip_id;
+	tbl->items[item_idx].nb_merged = 1;
+	tbl->items[item_idx].is_atomic = is_atomic;
+	tbl->item_num++;
+
+	/* If the previous packet exists, chain the new one with it. */
+	if (prev_idx != INVALID_ARRAY_INDEX) {
+		tbl->items[item_idx].next_pkt_idx =
+			tbl->items[prev_idx].next_pkt_idx;
+		tbl->items[prev_idx].next_pkt_idx = item_idx;
+	}
+
+	return item_idx;
+}
+
+static inline uint32_t
+delete_item(struct gro_tunnel6_tcp4_tbl *tbl,
+		uint32_t item_idx,
+		uint32_t prev_item_idx)
+{
+	uint32_t next_idx = tbl->items[item_idx].next_pkt_idx;
+
+	/* NULL indicates an empty item. */
+	tbl->items[item_idx].firstseg = NULL;
+	tbl->item_num--;
+	if (prev_item_idx != INVALID_ARRAY_INDEX)
+		tbl->items[prev_item_idx].next_pkt_idx = next_idx;
+
+	return next_idx;
+}
+
+static inline uint32_t
+insert_new_flow(struct gro_tunnel6_tcp4_tbl *tbl,
+		struct tunnel6_tcp4_flow_key *src,
+		uint32_t hash,
+		uint32_t item_idx)
+{
+	struct tunnel6_tcp4_flow_key *dst;
+	uint32_t flow_idx;
+
+	flow_idx = find_an_empty_flow(tbl);
+	if (unlikely(flow_idx == INVALID_ARRAY_INDEX))
+		return INVALID_ARRAY_INDEX;
+	gro_flow_index_add(&tbl->flow_index, hash, flow_idx);
+
+	dst = &(tbl->flows[flow_idx].key);
+
+	ASSIGN_COMMON_TCP_KEY((&(src->inner_key.cmn_key)), (&(dst->inner_key.cmn_key)));
+	dst->inner_key.ip_src_addr = src->inner_key.ip_src_addr;
+	dst->inner_key.ip_dst_addr = src->inner_key.ip_dst_addr;
+
+	dst->tnl_hdr[0] = src->tnl_hdr[0];
+	dst->tnl_hdr[1] = src->tnl_hdr[1];
+	rte_ether_addr_copy(&(src->outer_eth_saddr), &(dst->outer_eth_saddr));
+	rte_ether_addr_copy(&(src->outer_eth_daddr), &(dst->outer_eth_daddr));
+	dst->outer_src_addr = src->outer_src_addr;
+	dst->outer_dst_addr = src->outer_dst_addr;
+	dst->outer_vtc_flow = src->outer_vtc_flow;
+	dst->outer_src_port = src->outer_src_port;
+	dst->outer_dst_port = src->outer_dst_port;
+
+	tbl->flows[flow_idx].start_index = item_idx;
+	tbl->flows[flow_idx].hash = hash;
+	tbl->flow_num++;
+
+	return flow_idx;
+}
+
+static inline int
+is_same_tunnel6_tcp4_flow(const struct tunnel6_tcp4_flow_key *k1,
+		const struct tunnel6_tcp4_flow_key *k2)
+{
+	return ((k1->outer_vtc_flow == k2->outer_vtc_flow) &&
+			rte_is_same_ether_addr(&k1->outer_eth_saddr,
+					&k2->outer_eth_saddr) &&
+			rte_is_same_ether_addr(&k1->outer_eth_daddr,
+				&k2->outer_eth_daddr) &&
+			rte_ipv6_addr_eq(&k1->outer_src_addr,
+				&k2->outer_src_addr) &&
+			rte_ipv6_addr_eq(&k1->outer_dst_addr,
+				&k2->outer_dst_addr) &&
+			(k1->outer_src_port == k2->outer_src_port) &&
+			(k1->outer_dst_port == k2->outer_dst_port) &&
+			(k1->tnl_hdr[0] == k2->tnl_hdr[0]) &&
+			(k1->tnl_hdr[1] == k2->tnl_hdr[1]) &&
+			is_same_tcp4_flow(k1->inner_key, k2->inner_key));
+}
+
+static inline uint32_t
+find_flow(struct gro_tunnel6_tcp4_tbl *tbl,
+		struct tunnel6_tcp4_flow_key *key,
+		uint32_t hash)
+{
+	struct gro_flow_bkt *bkt;
+	uint32_t n, hits, flow_idx;
+
+	/* Only compare the keys of the flows whose signature matches. */
+	for (n = 0; n < 2; n++) {
+		bkt = gro_flow_index_bkt(&tbl->flow_index, hash, n);
+		hits = gro_flow_bkt_match(bkt, gro_flow_sig(hash));
+		while (hits != 0) {
+			flow_idx = bkt->flow_idx[rte_ctz32(hits)];
+			if (is_same_tunnel6_tcp4_flow(&tbl->flows[flow_idx].key, key))
+				return flow_idx;
+			hits &= hits - 1;
+		}
+	}
+
+	/* Look for the flows which did not fit into their buckets. */
+	if (likely(tbl->flow_index.nb_overflow == 0))
+		return INVALID_ARRAY_INDEX;
+	for (flow_idx = 0, n = 0; n < tbl->flow_num; flow_idx++) {
+		if (tbl->flows[flow_idx].start_index == INVALID_ARRAY_INDEX)
+			continue;
+		n++;
+		if (tbl->flows[flow_idx].hash == hash &&
+				is_same_tunnel6_tcp4_flow(&tbl->flows[flow_idx].key, key))
+			return flow_idx;
+	}
+	return INVALID_ARRAY_INDEX;
+}
+
+static inline void
+update_tunnel6_header(struct gro_tcp_item *item)
+{
+	struct rte_ipv6_hdr *ipv6_hdr;
+	struct rte_ipv4_hdr *ipv4_hdr;
+	struct rte_udp_hdr *udp_hdr;
+	struct rte_mbuf *pkt = item->firstseg;
+	uint16_t len;
+
+	/* Update the outer IPv6 header. */
+	len = pkt->pkt_len - pkt->outer_l2_len - pkt->outer_l3_len;
+	ipv6_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv6_hdr *,
+					   pkt->outer_l2_len);
+	ipv6_hdr->payload_len = rte_cpu_to_be_16(len);
+
+	/* Update the outer UDP header. */
+	udp_hdr = (struct rte_udp_hdr *)((char *)ipv6_hdr + pkt->outer_l3_len);
+	udp_hdr->dgram_len = rte_cpu_to_be_16(len);
+
+	/* Update the inner IPv4 header. */
+	len -= pkt->l2_len;
+	ipv4_hdr = (struct rte_ipv4_hdr *)((char *)udp_hdr + pkt->l2_len);
+	ipv4_hdr->total_length = rte_cpu_to_be_16(len);
+}
+
+int32_t
+gro_tunnel6_tcp4_reassemble(struct rte_mbuf *pkt,
+		struct gro_tunnel6_tcp4_tbl *tbl,
+		uint64_t start_time)
+{
+	struct rte_ether_hdr *outer_eth_hdr, *eth_hdr;
+	struct rte_ipv6_hdr *outer_ipv6_hdr;
+	struct rte_ipv4_hdr *ipv4_hdr;
+	struct rte_tcp_hdr *tcp_hdr;
+	struct rte_udp_hdr *udp_hdr;
+	rte_be32_t *tnl_hdr;
+	uint32_t sent_seq;
+	int32_t tcp_dl;
+	uint16_t frag_off, ip_id, l2_offset;
+	uint8_t is_atomic;
+
+	struct tunnel6_tcp4_flow_key key;
+	uint32_t cur_idx, prev_idx, item_idx;
+	uint32_t i, hash;
+	int cmp;
+	uint16_t hdr_len;
+
+	/*
+	 * Don't process the packet whose TCP header length is greater
+	 * than 60 bytes or less than 20 bytes.
+	 */
+	if (unlikely(INVALID_TCP_HDRLEN(pkt->l4_len)))
+		return -1;
+
+	/* Don't process the packet with outer IPv6 extension headers. */
+	if (unlikely(pkt->outer_l3_len != sizeof(struct rte_ipv6_hdr)))
+		return -1;
+
+	outer_eth_hdr = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr *);
+	outer_ipv6_hdr = (struct rte_ipv6_hdr *)((char *)outer_eth_hdr +
+			pkt->outer_l2_len);
+	if (unlikely(outer_ipv6_hdr->proto != IPPROTO_UDP))
+		return -1;
+	udp_hdr = (struct rte_udp_hdr *)((char *)outer_ipv6_hdr +
+			pkt->outer_l3_len);
+	tnl_hdr = (rte_be32_t *)((char *)udp_hdr +
+			sizeof(struct rte_udp_hdr));
+
+	/*
+	 * Don't process the GENEVE packet which carries options, as they
+	 * would have to be compared between the packets as well.
+	 */
+	if (tbl->tnl_type == GRO_TUNNEL6_TYPE_GENEVE &&
+			((struct rte_geneve_hdr *)tnl_hdr)->opt_len != 0)
+		return -1;
+
+	/*
+	 * The VxLAN and the GENEVE (without options) headers have the
+	 * same size.
+	 */
+	eth_hdr = (struct rte_ether_hdr *)((char *)tnl_hdr +
+			sizeof(struct rte_vxlan_hdr));
+	ipv4_hdr = (struct rte_ipv4_hdr *)((char *)udp_hdr + pkt->l2_len);
+	tcp_hdr = (struct rte_tcp_hdr *)((char *)ipv4_hdr + pkt->l3_len);
+
+	/*
+	 * Don't process the packet which has FIN, SYN, RST, PSH, URG,
+	 * ECE or CWR set.
+	 */
+	if (tcp_hdr->tcp_flags != RTE_TCP_ACK_FLAG)
+		return -1;
+
+	l2_offset = pkt->outer_l2_len + pkt->outer_l3_len;
+	hdr_len = l2_offset + pkt->l2_len + pkt->l3_len + pkt->l4_len;
+	/*
+	 * Don't process the packet whose payload length is less than or
+	 * equal to 0.
+	 */
+	tcp_dl = pkt->pkt_len - hdr_len;
+	if (tcp_dl <= 0)
+		return -1;
+
+	/*
+	 * Save IPv4 ID for the packet whose DF bit is 0. For the packet
+	 * whose DF bit is 1, IPv4 ID is ignored.
+	 */
+	frag_off = rte_be_to_cpu_16(ipv4_hdr->fragment_offset);
+	is_atomic = (frag_off & RTE_IPV4_HDR_DF_FLAG) == RTE_IPV4_HDR_DF_FLAG;
+	ip_id = is_atomic ? 0 : rte_be_to_cpu_16(ipv4_hdr->packet_id);
+
+	sent_seq = rte_be_to_cpu_32(tcp_hdr->sent_seq);
+
+	rte_ether_addr_copy(&(eth_hdr->src_addr), &(key.inner_key.cmn_key.eth_saddr));
+	rte_ether_addr_copy(&(eth_hdr->dst_addr), &(key.inner_key.cmn_key.eth_daddr));
+	key.inner_key.ip_src_addr = ipv4_hdr->src_addr;
+	key.inner_key.ip_dst_addr = ipv4_hdr->dst_addr;
+	key.inner_key.cmn_key.recv_ack = tcp_hdr->recv_ack;
+	key.inner_key.cmn_key.src_port = tcp_hdr->src_port;
+	key.inner_key.cmn_key.dst_port = tcp_hdr->dst_port;
+
+	key.tnl_hdr[0] = tnl_hdr[0];
+	key.tnl_hdr[1] = tnl_hdr[1];
+	rte_ether_addr_copy(&(outer_eth_hdr->src_addr), &(key.outer_eth_saddr));
+	rte_ether_addr_copy(&(outer_eth_hdr->dst_addr), &(key.outer_eth_daddr));
+	key.outer_src_addr = outer_ipv6_hdr->src_addr;
+	key.outer_dst_addr = outer_ipv6_hdr->dst_addr;
+	/* The traffic class isn't part of the flow, so don't hash it. */
+	key.outer_vtc_flow = outer_ipv6_hdr->vtc_flow &
+		rte_cpu_to_be_32(0xF00FFFFF);
+	key.outer_src_port = udp_hdr->src_port;
+	key.outer_dst_port = udp_hdr->dst_port;
+
+	/* Search for a matched flow. */
+	hash = gro_flow_hash(&key, sizeof(key));
+	i = find_flow(tbl, &key, hash);
+
+	/*
+	 * Can't find a matched flow. Insert a new flow and store the
+	 * packet into the flow.
+	 */
+	if (i == INVALID_ARRAY_INDEX) {
+		item_idx = insert_new_item(tbl, pkt, start_time,
+				INVALID_ARRAY_INDEX, sent_seq, ip_id,
+				is_atomic);
+		if (item_idx == INVALID_ARRAY_INDEX)
+			return -1;
+		if (insert_new_flow(tbl, &key, hash, item_idx) ==
+				INVALID_ARRAY_INDEX) {
+			/*
+			 * Fail to insert a new flow, so
+			 * delete the inserted packet.
+			 */
+			delete_item(tbl, item_idx, INVALID_ARRAY_INDEX);
+			return -1;
+		}
+		return 0;
+	}
+
+	/* Check all packets in the flow and try to find a neighbor. */
+	cur_idx = tbl->flows[i].start_index;
+	prev_idx = cur_idx;
+	do {
+		cmp = check_seq_option(&(tbl->items[cur_idx]), tcp_hdr,
+				sent_seq, ip_id, pkt->l4_len, tcp_dl,
+				l2_offset, is_atomic);
+		if (cmp) {
+			if (merge_two_tcp_packets(&(tbl->items[cur_idx]),
+						pkt, cmp, sent_seq,
+						tcp_hdr->tcp_flags, ip_id,
+						l2_offset))
+				return 1;
+			/*
+			 * Can't merge two packets, as the packet
+			 * length will be greater than the max value.
+			 * Insert the packet into the flow.
+			 */
+			if (insert_new_item(tbl, pkt, start_time, prev_idx,
+						sent_seq, ip_id, is_atomic) ==
+					INVALID_ARRAY_INDEX)
+				return -1;
+			return 0;
+		}
+		prev_idx = cur_idx;
+		cur_idx = tbl->items[cur_idx].next_pkt_idx;
+	} while (cur_idx != INVALID_ARRAY_INDEX);
+
+	/* Can't find neighbor. Insert the packet into the flow. */
+	if (insert_new_item(tbl, pkt, start_time, prev_idx, sent_seq,
+				ip_id, is_atomic) == INVALID_ARRAY_INDEX)
+		return -1;
+
+	return 0;
+}
+
+uint16_t
+gro_tunnel6_tcp4_tbl_timeout_flush(struct gro_tunnel6_tcp4_tbl *tbl,
+		uint64_t flush_timestamp,
+		struct rte_mbuf **out,
+		uint16_t nb_out)
+{
+	uint16_t k = 0;
+	uint32_t i, j;
+	uint32_t max_flow_num = tbl->max_flow_num;
+
+	for (i = 0; i < max_flow_num; i++) {
+		if (unlikely(tbl->flow_num == 0))
+			return k;
+
+		j = tbl->flows[i].start_index;
+		while (j != INVALID_ARRAY_INDEX) {
+			if (tbl->items[j].start_time <= flush_timestamp) {
+				out[k++] = tbl->items[j].firstseg;
+				if (tbl->items[j].nb_merged > 1)
+					update_tunnel6_header(&(tbl->items[j]));
+				/*
+				 * Delete the item and get the next packet
+				 * index.
+				 */
+				j = delete_item(tbl, j, INVALID_ARRAY_INDEX);
+				tbl->flows[i].start_index = j;
+				if (j == INVALID_ARRAY_INDEX) {
+					gro_flow_index_del(&tbl->flow_index,
+							tbl->flows[i].hash, i);
+					tbl->flow_num--;
+				}
+
+				if (unlikely(k == nb_out))
+					return k;
+			} else
+				/*
+				 * The left packets in the flow won't be
+				 * timeout. Go to check other flows.
+				 */
+				break;
+		}
+	}
+	return k;
+}
+
+uint32_t
+gro_tunnel6_tcp4_tbl_pkt_count(void *tbl)
+{
+	struct gro_tunnel6_tcp4_tbl *gro_tbl = tbl;
+
+	if (gro_tbl)
+		return gro_tbl->item_num;
+
+	return 0;
+}
@@ -7,6 +7,7 @@
 #include <rte_ethdev.h>
 
 #include "gro_udp4.h"
+#include "gro_udp_internal.h"
 
 void *
 gro_udp4_tbl_create(uint16_t socket_id,
@@ -71,18 +72,6 @@ gro_udp4_tbl_destroy(void *tbl)
 	rte_free(udp_tbl);
 }
 
-static inline uint32_t
-find_an_empty_item(struct gro_udp4_tbl *tbl)
-{
-	uint32_t i;
-	uint32_t max_item_num = tbl->max_item_num;
-
-	for (i = 0; i < max_item_num; i++)
-		if (tbl->items[i].firstseg == NULL)
-			return i;
-	return INVALID_ARRAY_INDEX;
-}
-
 static inline uint32_t
 find_an_empty_flow(struct gro_udp4_tbl *tbl)
 {
@@ -95,54 +84,6 @@ find_an_empty_flow(struct gro_udp4_tbl *tbl)
 	return INVALID_ARRAY_INDEX;
 }
 
-static inline uint32_t
-insert_new_item(struct gro_udp4_tbl *tbl,
-		struct rte_mbuf *pkt,
-		uint64_t start_time,
-		uint32_t prev_idx,
-		uint16_t frag_offset,
-		uint8_t is_last_frag)
-{
-	uint32_t item_idx;
-
-	item_idx = find_an_empty_item(tbl);
-	if (unlikely(item_idx == INVALID_ARRAY_INDEX))
-		return INVALID_ARRAY_INDEX;
-
-	tbl->items[item_idx].firstseg = pkt;
-	tbl->items[item_idx].lastseg = rte_pktmbuf_lastseg(pkt);
-	tbl->items[item_idx].start_time = start_time;
-	tbl->items[item_idx].next_pkt_idx = INVALID_ARRAY_INDEX;
-	tbl->items[item_idx].frag_offset = frag_offset;
-	tbl->items[item_idx].is_last_frag = is_last_frag;
-	tbl->items[item_idx].nb_merged = 1;
-	tbl->item_num++;
-
-	/* if the previous packet exists, chain them together. */
-	if (prev_idx != INVALID_ARRAY_INDEX) {
-		tbl->items[item_idx].next_pkt_idx =
-			tbl->items[prev_idx].next_pkt_idx;
-		tbl->items[prev_idx].next_pkt_idx = item_idx;
-	}
-
-	return item_idx;
-}
-
-static inline uint32_t
-delete_item(struct gro_udp4_tbl *tbl, uint32_t item_idx,
-		uint32_t prev_item_idx)
-{
-	uint32_t next_idx = tbl->items[item_idx].next_pkt_idx;
-
-	/* NULL indicates an empty item */
-	tbl->items[item_idx].firstseg = NULL;
-	tbl->item_num--;
-	if (prev_item_idx != INVALID_ARRAY_INDEX)
-		tbl->items[prev_item_idx].next_pkt_idx = next_idx;
-
-	return next_idx;
-}
-
 static inline uint32_t
 insert_new_flow(struct gro_udp4_tbl *tbl,
 		struct udp4_flow_key *src,
@@ -205,9 +146,8 @@ gro_udp4_reassemble(struct rte_mbuf *pkt,
 	uint8_t is_last_frag;
 
 	struct udp4_flow_key key;
-	uint32_t cur_idx, prev_idx, item_idx;
+	uint32_t item_idx;
 	uint32_t i, max_flow_num, remaining_flow_num;
-	int cmp;
 	uint8_t find;
 
 	eth_hdr = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr *);
@@ -266,7 +206,8 @@ gro_udp4_reassemble(struct rte_mbuf *pkt,
 	 * packet into the flow.
 	 */
 	if (find == 0) {
-		item_idx = insert_new_item(tbl, pkt, start_time,
+		item_idx = insert_new_udp_item(pkt, tbl->items,
+				&tbl->item_num, tbl->max_item_num, start_time,
 				INVALID_ARRAY_INDEX, frag_offset,
 				is_last_frag);
 		if (unlikely(item_idx == INVALID_ARRAY_INDEX))
@@ -277,105 +218,17 @@ gro_udp4_reassemble(struct rte_mbuf *pkt,
 			 * Fail to insert a new flow, so delete the
 			 * stored packet.
 			 */
-			delete_item(tbl, item_idx, INVALID_ARRAY_INDEX);
+			delete_udp_item(tbl->items, item_idx,
+					&tbl->item_num, INVALID_ARRAY_INDEX);
 			return -1;
 		}
 		return 0;
 	}
 
-	/*
-	 * Check all packets in the flow and try to find a neighbor for
-	 * the input packet.
-	 */
-	cur_idx = tbl->flows[i].start_index;
-	prev_idx = cur_idx;
-	do {
-		cmp = udp4_check_neighbor(&(tbl->items[cur_idx]),
-				frag_offset, ip_dl, 0);
-		if (cmp) {
-			if (merge_two_udp4_packets(&(tbl->items[cur_idx]),
-						pkt, cmp, frag_offset,
-						is_last_frag, 0))
-				return 1;
-			/*
-			 * Fail to merge the two packets, as the packet
-			 * length is greater than the max value. Store
-			 * the packet into the flow.
-			 */
-			if (insert_new_item(tbl, pkt, start_time, prev_idx,
-						frag_offset, is_last_frag) ==
-					INVALID_ARRAY_INDEX)
-				return -1;
-			return 0;
-		}
-
-		/* Ensure inserted items are ordered by frag_offset */
-		if (frag_offset
-			< tbl->items[cur_idx].frag_offset) {
-			break;
-		}
-
-		prev_idx = cur_idx;
-		cur_idx = tbl->items[cur_idx].next_pkt_idx;
-	} while (cur_idx != INVALID_ARRAY_INDEX);
-
-	/* Fail to find a neighbor, so store the packet into the flow. */
-	if (cur_idx == tbl->flows[i].start_index) {
-		/* Insert it before the first packet of the flow */
-		item_idx = insert_new_item(tbl, pkt, start_time,
-				INVALID_ARRAY_INDEX, frag_offset,
-				is_last_frag);
-		if (unlikely(item_idx == INVALID_ARRAY_INDEX))
-			return -1;
-		tbl->items[item_idx].next_pkt_idx = cur_idx;
-		tbl->flows[i].start_index = item_idx;
-	} else {
-		if (insert_new_item(tbl, pkt, start_time, prev_idx,
-				frag_offset, is_last_frag)
-			== INVALID_ARRAY_INDEX)
-			return -1;
-	}
-
-	return 0;
-}
-
-static int
-gro_udp4_merge_items(struct gro_udp4_tbl *tbl,
-			   uint32_t start_idx)
-{
-	uint16_t frag_offset;
-	uint8_t is_last_frag;
-	int16_t ip_dl;
-	struct rte_mbuf *pkt;
-	int cmp;
-	uint32_t item_idx;
-	uint16_t hdr_len;
-
-	item_idx = tbl->items[start_idx].next_pkt_idx;
-	while (item_idx != INVALID_ARRAY_INDEX) {
-		pkt = tbl->items[item_idx].firstseg;
-		hdr_len = pkt->l2_len + pkt->l3_len;
-		ip_dl = pkt->pkt_len - hdr_len;
-		frag_offset = tbl->items[item_idx].frag_offset;
-		is_last_frag = tbl->items[item_idx].is_last_frag;
-		cmp = udp4_check_neighbor(&(tbl->items[start_idx]),
-					frag_offset, ip_dl, 0);
-		if (cmp) {
-			if (merge_two_udp4_packets(
-					&(tbl->items[start_idx]),
-					pkt, cmp, frag_offset,
-					is_last_frag, 0)) {
-				item_idx = delete_item(tbl, item_idx,
-							INVALID_ARRAY_INDEX);
-				tbl->items[start_idx].next_pkt_idx
-					= item_idx;
-			} else
-				return 0;
-		} else
-			return 0;
-	}
-
-	return 0;
+	return process_udp_item(pkt, tbl->items, &tbl->item_num,
+			tbl->max_item_num, start_time,
+			&tbl->flows[i].start_index, frag_offset, ip_dl,
+			is_last_frag);
 }
 
 uint16_t
@@ -395,7 +248,7 @@ gro_udp4_tbl_timeout_flush(struct gro_udp4_tbl *tbl,
 		j = tbl->flows[i].start_index;
 		while (j != INVALID_ARRAY_INDEX) {
 			if (tbl->items[j].start_time <= flush_timestamp) {
-				gro_udp4_merge_items(tbl, j);
+				merge_udp_items(tbl->items, &tbl->item_num, j);
 				out[k++] = tbl->items[j].firstseg;
 				if (tbl->items[j].nb_merged > 1)
 					update_header(&(tbl->items[j]));
@@ -403,7 +256,9 @@ gro_udp4_tbl_timeout_flush(struct gro_udp4_tbl *tbl,
 				 * Delete the packet and get the next
 				 * packet in the flow.
 				 */
-				j = delete_item(tbl, j, INVALID_ARRAY_INDEX);
+				j = delete_udp_item(tbl->items, j,
+						&tbl->item_num,
+						INVALID_ARRAY_INDEX);
 				tbl->flows[i].start_index = j;
 				if (j == INVALID_ARRAY_INDEX)
 					tbl->flow_num--;
@@ -0,0 +1,191 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _GRO_UDP_INTERNAL_H_
+#define _GRO_UDP_INTERNAL_H_
+
+#include "gro_udp4.h"
+
+/*
+ * Item array functions shared by the UDP/IPv4 and UDP/IPv6 reassembly
+ * tables. The items of a flow are chained in the order of their
+ * fragment offsets.
+ */
+
+static inline uint32_t
+find_an_empty_udp_item(struct gro_udp4_item *items,
+		uint32_t max_item_num)
+{
+	uint32_t i;
+
+	for (i = 0; i < max_item_num; i++)
+		if (items[i].firstseg == NULL)
+			return i;
+	return INVALID_ARRAY_INDEX;
+}
+
+static inline uint32_t
+insert_new_udp_item(struct rte_mbuf *pkt,
+		struct gro_udp4_item *items,
+		uint32_t *item_num,
+		uint32_t max_item_num,
+		uint64_t start_time,
+		uint32_t prev_idx,
+		uint16_t frag_offset,
+		uint8_t is_last_frag)
+{
+	uint32_t item_idx;
+
+	item_idx = find_an_empty_udp_item(items, max_item_num);
+	if (unlikely(item_idx == INVALID_ARRAY_INDEX))
+		return INVALID_ARRAY_INDEX;
+
+	items[item_idx].firstseg = pkt;
+	items[item_idx].lastseg = rte_pktmbuf_lastseg(pkt);
+	items[item_idx].start_time = start_time;
+	items[item_idx].next_pkt_idx = INVALID_ARRAY_INDEX;
+	items[item_idx].frag_offset = frag_offset;
+	items[item_idx].is_last_frag = is_last_frag;
+	items[item_idx].nb_merged = 1;
+	(*item_num) += 1;
+
+	/* if the previous packet exists, chain them together. */
+	if (prev_idx != INVALID_ARRAY_INDEX) {
+		items[item_idx].next_pkt_idx =
+			items[prev_idx].next_pkt_idx;
+		items[prev_idx].next_pkt_idx = item_idx;
+	}
+
+	return item_idx;
+}
+
+static inline uint32_t
+delete_udp_item(struct gro_udp4_item *items, uint32_t item_idx,
+		uint32_t *item_num,
+		uint32_t prev_item_idx)
+{
+	uint32_t next_idx = items[item_idx].next_pkt_idx;
+
+	/* NULL indicates an empty item */
+	items[item_idx].firstseg = NULL;
+	(*item_num) -= 1;
+	if (prev_item_idx != INVALID_ARRAY_INDEX)
+		items[prev_item_idx].next_pkt_idx = next_idx;
+
+	return next_idx;
+}
+
+/*
+ * Merge the packet with a neighbor in the flow whose first item is
+ * *start_idx, or store it into the flow.
+ * Return 1 if the packet is merged, 0 if it is stored, and -1 if
+ * there is no available space in the table.
+ */
+static inline int32_t
+process_udp_item(struct rte_mbuf *pkt,
+		struct gro_udp4_item *items,
+		uint32_t *item_num,
+		uint32_t max_item_num,
+		uint64_t start_time,
+		uint32_t *start_idx,
+		uint16_t frag_offset,
+		uint16_t ip_dl,
+		uint8_t is_last_frag)
+{
+	uint32_t cur_idx, prev_idx, item_idx;
+	int cmp;
+
+	/*
+	 * Check all packets in the flow and try to find a neighbor for
+	 * the input packet.
+	 */
+	cur_idx = *start_idx;
+	prev_idx = cur_idx;
+	do {
+		cmp = udp4_check_neighbor(&items[cur_idx], frag_offset,
+				ip_dl, 0);
+		if (cmp) {
+			if (merge_two_udp4_packets(&items[cur_idx], pkt, cmp,
+						frag_offset, is_last_frag, 0))
+				return 1;
+			/*
+			 * Fail to merge the two packets, as the packet
+			 * length is greater than the max value. Store
+			 * the packet into the flow.
+			 */
+			if (insert_new_udp_item(pkt, items, item_num,
+						max_item_num, start_time,
+						prev_idx, frag_offset,
+						is_last_frag) ==
+					INVALID_ARRAY_INDEX)
+				return -1;
+			return 0;
+		}
+
+		/* Ensure inserted items are ordered by frag_offset */
+		if (frag_offset < items[cur_idx].frag_offset)
+			break;
+
+		prev_idx = cur_idx;
+		cur_idx = items[cur_idx].next_pkt_idx;
+	} while (cur_idx != INVALID_ARRAY_INDEX);
+
+	/* Fail to find a neighbor, so store the packet into the flow. */
+	if (cur_idx == *start_idx) {
+		/* Insert it before the first packet of the flow */
+		item_idx = insert_new_udp_item(pkt, items, item_num,
+				max_item_num, start_time, INVALID_ARRAY_INDEX,
+				frag_offset, is_last_frag);
+		if (unlikely(item_idx == INVALID_ARRAY_INDEX))
+			return -1;
+		items[item_idx].next_pkt_idx = cur_idx;
+		*start_idx = item_idx;
+	} else {
+		if (insert_new_udp_item(pkt, items, item_num, max_item_num,
+				start_time, prev_idx, frag_offset,
+				is_last_frag) == INVALID_ARRAY_INDEX)
+			return -1;
+	}
+
+	return 0;
+}
+
+/*
+ * Merge the packets following the item start_idx into it,
+ * as long as they are neighbors.
+ */
+static inline void
+merge_udp_items(struct gro_udp4_item *items,
+		uint32_t *item_num,
+		uint32_t start_idx)
+{
+	uint16_t frag_offset;
+	uint8_t is_last_frag;
+	int16_t ip_dl;
+	struct rte_mbuf *pkt;
+	int cmp;
+	uint32_t item_idx;
+	uint16_t hdr_len;
+
+	item_idx = items[start_idx].next_pkt_idx;
+	while (item_idx != INVALID_ARRAY_INDEX) {
+		pkt = items[item_idx].firstseg;
+		hdr_len = pkt->l2_len + pkt->l3_len;
+		ip_dl = pkt->pkt_len - hdr_len;
+		frag_offset = items[item_idx].frag_offset;
+		is_last_frag = items[item_idx].is_last_frag;
+		cmp = udp4_check_neighbor(&items[start_idx], frag_offset,
+				ip_dl, 0);
+		if (cmp == 0 || merge_two_udp4_packets(&items[start_idx],
+					pkt, cmp, frag_offset,
+					is_last_frag, 0) == 0)
+			return;
+
+		item_idx = delete_udp_item(items, item_idx, item_num,
+				INVALID_ARRAY_INDEX);
+		items[start_idx].next_pkt_idx = item_idx;
+	}
+}
+
+#endif
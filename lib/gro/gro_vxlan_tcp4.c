@@ -57,6 +57,14 @@ gro_vxlan_tcp4_tbl_create(uint16_t socket_id,
 		tbl->flows[i].start_index = INVALID_ARRAY_INDEX;
 	tbl->max_flow_num = entries_num;
 
+	if (gro_flow_index_create(&tbl->flow_index, entries_num,
+				socket_id) != 0) {
+		rte_free(tbl->flows);
+		rte_free(tbl->items);
+		rte_free(tbl);
+		return NULL;
+	}
+
 	return tbl;
 }
 
@@ -68,6 +76,7 @@ gro_vxlan_tcp4_tbl_destroy(void *tbl)
 	if (vxlan_tbl) {
 		rte_free(vxlan_tbl->items);
 		rte_free(vxlan_tbl->flows);
+		gro_flow_index_free(&vxlan_tbl->flow_index);
 	}
 	rte_free(vxlan_tbl);
 }
@@ -77,7 +86,11 @@ find_an_empty_item(struct gro_vxlan_tcp4_tbl *tbl)
 {
 	uint32_t max_item_num = tbl->max_item_num, i;
 
-	for (i = 0; i < max_item_num; i++)
+	/* Start from the current item number, which is likely to be free. */
+	for (i = tbl->item_num; i < max_item_num; i++)
+		if (tbl->items[i].inner_item.firstseg == NULL)
+			return i;
+	for (i = 0; i < tbl->item_num; i++)
 		if (tbl->items[i].inner_item.firstseg == NULL)
 			return i;
 	return INVALID_ARRAY_INDEX;
@@ -86,9 +99,14 @@ find_an_empty_item(struct gro_vxlan_tcp4_tbl *tbl)
 static inline uint32_t
 find_an_empty_flow(struct gro_vxlan_tcp4_tbl *tbl)
 {
-	uint32_t max_flow_num = tbl->max_flow_num, i;
+	uint32_t i;
+	uint32_t max_flow_num = tbl->max_flow_num;
 
-	for (i = 0; i < max_flow_num; i++)
+	/* Start from the current flow number, which is likely to be free. */
+	for (i = tbl->flow_num; i < max_flow_num; i++)
+		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
+			return i;
+	for (i = 0; i < tbl->flow_num; i++)
 		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
 			return i;
 	return INVALID_ARRAY_INDEX;
@@ -152,6 +170,7 @@ delete_item(struct gro_vxlan_tcp4_tbl *tbl,
 static inline uint32_t
 insert_new_flow(struct gro_vxlan_tcp4_tbl *tbl,
 		struct vxlan_tcp4_flow_key *src,
+		uint32_t hash,
 		uint32_t item_idx)
 {
 	struct vxlan_tcp4_flow_key *dst;
@@ -160,6 +179,7 @@ insert_new_flow(struct gro_vxlan_tcp4_tbl *tbl,
 	flow_idx = find_an_empty_flow(tbl);
 	if (unlikely(flow_idx == INVALID_ARRAY_INDEX))
 		return INVALID_ARRAY_INDEX;
+	gro_flow_index_add(&tbl->flow_index, hash, flow_idx);
 
 	dst = &(tbl->flows[flow_idx].key);
 
@@ -177,6 +197,7 @@ insert_new_flow(struct gro_vxlan_tcp4_tbl *tbl,
 	dst->outer_dst_port = src->outer_dst_port;
 
 	tbl->flows[flow_idx].start_index = item_idx;
+	tbl->flows[flow_idx].hash = hash;
 	tbl->flow_num++;
 
 	return flow_idx;
@@ -199,6 +220,40 @@ is_same_vxlan_tcp4_flow(struct vxlan_tcp4_flow_key k1,
 			is_same_tcp4_flow(k1.inner_key, k2.inner_key));
 }
 
+static inline uint32_t
+find_flow(struct gro_vxlan_tcp4_tbl *tbl,
+		struct vxlan_tcp4_flow_key *key,
+		uint32_t hash)
+{
+	struct gro_flow_bkt *bkt;
+	uint32_t n, hits, flow_idx;
+
+	/* Only compare the keys of the flows whose signature matches. */
+	for (n = 0; n < 2; n++) {
+		bkt = gro_flow_index_bkt(&tbl->flow_index, hash, n);
+		hits = gro_flow_bkt_match(bkt, gro_flow_sig(hash));
+		while (hits != 0) {
+			flow_idx = bkt->flow_idx[rte_ctz32(hits)];
+			if (is_same_vxlan_tcp4_flow(tbl->flows[flow_idx].key, *key))
+				return flow_idx;
+			hits &= hits - 1;
+		}
+	}
+
+	/* Look for the flows which did not fit into their buckets. */
+	if (likely(tbl->flow_index.nb_overflow == 0))
+		return INVALID_ARRAY_INDEX;
+	for (flow_idx = 0, n = 0; n < tbl->flow_num; flow_idx++) {
+		if (tbl->flows[flow_idx].start_index == INVALID_ARRAY_INDEX)
+			continue;
+		n++;
+		if (tbl->flows[flow_idx].hash == hash &&
+				is_same_vxlan_tcp4_flow(tbl->flows[flow_idx].key, *key))
+			return flow_idx;
+	}
+	return INVALID_ARRAY_INDEX;
+}
+
 static inline int
 check_vxlan_seq_option(struct gro_vxlan_tcp4_item *item,
 		struct rte_tcp_hdr *tcp_hdr,
@@ -296,10 +351,9 @@ gro_vxlan_tcp4_reassemble(struct rte_mbuf *pkt,
 
 	struct vxlan_tcp4_flow_key key;
 	uint32_t cur_idx, prev_idx, item_idx;
-	uint32_t i, max_flow_num, remaining_flow_num;
+	uint32_t i, hash;
 	int cmp;
 	uint16_t hdr_len;
-	uint8_t find;
 
 	/*
 	 * Don't process the packet whose TCP header length is greater
@@ -370,30 +424,20 @@ gro_vxlan_tcp4_reassemble(struct rte_mbuf *pkt,
 	key.outer_dst_port = udp_hdr->dst_port;
 
 	/* Search for a matched flow. */
-	max_flow_num = tbl->max_flow_num;
-	remaining_flow_num = tbl->flow_num;
-	find = 0;
-	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
-		if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
-			if (is_same_vxlan_tcp4_flow(tbl->flows[i].key, key)) {
-				find = 1;
-				break;
-			}
-			remaining_flow_num--;
-		}
-	}
+	hash = gro_flow_hash(&key, sizeof(key));
+	i = find_flow(tbl, &key, hash);
 
 	/*
 	 * Can't find a matched flow. Insert a new flow and store the
 	 * packet into the flow.
 	 */
-	if (find == 0) {
+	if (i == INVALID_ARRAY_INDEX) {
 		item_idx = insert_new_item(tbl, pkt, start_time,
 				INVALID_ARRAY_INDEX, sent_seq, outer_ip_id,
 				ip_id, outer_is_atomic, is_atomic);
 		if (item_idx == INVALID_ARRAY_INDEX)
 			return -1;
-		if (insert_new_flow(tbl, &key, item_idx) ==
+		if (insert_new_flow(tbl, &key, hash, item_idx) ==
 				INVALID_ARRAY_INDEX) {
 			/*
 			 * Fail to insert a new flow, so
@@ -470,8 +514,11 @@ gro_vxlan_tcp4_tbl_timeout_flush(struct gro_vxlan_tcp4_tbl *tbl,
 				 */
 				j = delete_item(tbl, j, INVALID_ARRAY_INDEX);
 				tbl->flows[i].start_index = j;
-				if (j == INVALID_ARRAY_INDEX)
+				if (j == INVALID_ARRAY_INDEX) {
+					gro_flow_index_del(&tbl->flow_index,
+							tbl->flows[i].hash, i);
 					tbl->flow_num--;
+				}
 
 				if (unlikely(k == nb_out))
 					return k;
@@ -33,6 +33,8 @@ struct gro_vxlan_tcp4_flow {
 	 * indicates an empty flow.
 	 */
 	uint32_t start_index;
+	/* The hash value of the key, which indexes the flow */
+	uint32_t hash;
 };
 
 struct gro_vxlan_tcp4_item {
@@ -60,6 +62,8 @@ struct gro_vxlan_tcp4_tbl {
 	uint32_t max_item_num;
 	/* the maximum flow number */
 	uint32_t max_flow_num;
+	/* hashed index of the flows */
+	struct gro_flow_index flow_index;
 };
 
 /**
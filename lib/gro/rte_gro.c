@@ -11,9 +11,19 @@
 #include "gro_tcp4.h"
 #include "gro_tcp6.h"
 #include "gro_udp4.h"
+#include "gro_udp6.h"
+#include "gro_tunnel6_tcp4.h"
 #include "gro_vxlan_tcp4.h"
 #include "gro_vxlan_udp4.h"
 
+/*
+ * Allocate an array of n elements in the stack of the caller,
+ * aligned on a cache line.
+ */
+#define GRO_BURST_ALLOC(p, n) \
+	((p) = RTE_PTR_ALIGN_CEIL(alloca((n) * sizeof(*(p)) + \
+			RTE_CACHE_LINE_SIZE), RTE_CACHE_LINE_SIZE))
+
 typedef void *(*gro_tbl_create_fn)(uint16_t socket_id,
 		uint16_t max_flow_num,
 		uint16_t max_item_per_flow);
@@ -22,16 +32,22 @@ typedef uint32_t (*gro_tbl_pkt_count_fn)(void *tbl);
 
 static gro_tbl_create_fn tbl_create_fn[RTE_GRO_TYPE_MAX_NUM] = {
 		gro_tcp4_tbl_create, gro_vxlan_tcp4_tbl_create,
-		gro_udp4_tbl_create, gro_vxlan_udp4_tbl_create, gro_tcp6_tbl_create, NULL};
+		gro_udp4_tbl_create, gro_vxlan_udp4_tbl_create, gro_tcp6_tbl_create,
+		gro_udp6_tbl_create, gro_ipv6_vxlan_tcp4_tbl_create,
+		gro_ipv6_geneve_tcp4_tbl_create, NULL};
 static gro_tbl_destroy_fn tbl_destroy_fn[RTE_GRO_TYPE_MAX_NUM] = {
 			gro_tcp4_tbl_destroy, gro_vxlan_tcp4_tbl_destroy,
 			gro_udp4_tbl_destroy, gro_vxlan_udp4_tbl_destroy,
-			gro_tcp6_tbl_destroy,
+			gro_tcp6_tbl_destroy, gro_udp6_tbl_destroy,
+			gro_tunnel6_tcp4_tbl_destroy,
+			gro_tunnel6_tcp4_tbl_destroy,
 			NULL};
 static gro_tbl_pkt_count_fn tbl_pkt_count_fn[RTE_GRO_TYPE_MAX_NUM] = {
 			gro_tcp4_tbl_pkt_count, gro_vxlan_tcp4_tbl_pkt_count,
 			gro_udp4_tbl_pkt_count, gro_vxlan_udp4_tbl_pkt_count,
-			gro_tcp6_tbl_pkt_count,
+			gro_tcp6_tbl_pkt_count, gro_udp6_tbl_pkt_count,
+			gro_tunnel6_tcp4_tbl_pkt_count,
+			gro_tunnel6_tcp4_tbl_pkt_count,
 			NULL};
 
 #define IS_IPV4_TCP_PKT(ptype) (RTE_ETH_IS_IPV4_HDR(ptype) && \
@@ -76,6 +92,37 @@ static gro_tbl_pkt_count_fn tbl_pkt_count_fn[RTE_GRO_TYPE_MAX_NUM] = {
 		 ((ptype & RTE_PTYPE_INNER_L3_MASK) == \
 		  RTE_PTYPE_INNER_L3_IPV4_EXT_UNKNOWN)))
 
+/* Only IPv6 fragments are processed, so UDP isn't known but for the first one */
+#define IS_IPV6_UDP_PKT(ptype) (RTE_ETH_IS_IPV6_HDR(ptype) && \
+		((ptype & RTE_PTYPE_L4_UDP) == RTE_PTYPE_L4_UDP) && \
+		(RTE_ETH_IS_TUNNEL_PKT(ptype) == 0))
+
+#define IS_IPV6_UDP_TUNNEL_TCP4_PKT(ptype, tunnel) \
+		(RTE_ETH_IS_IPV6_HDR(ptype) && \
+		((ptype & RTE_PTYPE_L4_MASK) == RTE_PTYPE_L4_UDP) && \
+		((ptype & RTE_PTYPE_TUNNEL_MASK) == (tunnel)) && \
+		((ptype & RTE_PTYPE_INNER_L4_MASK) == \
+		 RTE_PTYPE_INNER_L4_TCP) && \
+		(((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4) || \
+		 ((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4_EXT) || \
+		 ((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4_EXT_UNKNOWN)))
+
+#define IS_IPV6_VXLAN_TCP4_PKT(ptype) \
+		IS_IPV6_UDP_TUNNEL_TCP4_PKT(ptype, RTE_PTYPE_TUNNEL_VXLAN)
+
+#define IS_IPV6_GENEVE_TCP4_PKT(ptype) \
+		IS_IPV6_UDP_TUNNEL_TCP4_PKT(ptype, RTE_PTYPE_TUNNEL_GENEVE)
+
+/* All the GRO types which are supported */
+#define GRO_SUPPORTED_TYPES (RTE_GRO_IPV4_VXLAN_TCP_IPV4 | \
+		RTE_GRO_TCP_IPV4 | RTE_GRO_TCP_IPV6 | \
+		RTE_GRO_IPV4_VXLAN_UDP_IPV4 | RTE_GRO_UDP_IPV4 | \
+		RTE_GRO_UDP_IPV6 | RTE_GRO_IPV6_VXLAN_TCP_IPV4 | \
+		RTE_GRO_IPV6_GENEVE_TCP_IPV4)
+
 /*
  * GRO context structure. It keeps the table structures, which are
  * used to merge packets, for different GRO types. Before using
@@ -161,10 +208,12 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 	struct gro_tcp4_tbl tcp_tbl;
 	struct gro_tcp4_flow tcp_flows[RTE_GRO_MAX_BURST_ITEM_NUM];
 	struct gro_tcp_item tcp_items[RTE_GRO_MAX_BURST_ITEM_NUM] = {{0} };
+	struct gro_flow_bkt tcp_bkts[GRO_FLOW_BURST_BKT_NUM];
 
 	struct gro_tcp6_tbl tcp6_tbl;
 	struct gro_tcp6_flow tcp6_flows[RTE_GRO_MAX_BURST_ITEM_NUM];
 	struct gro_tcp_item tcp6_items[RTE_GRO_MAX_BURST_ITEM_NUM] = {{0} };
+	struct gro_flow_bkt tcp6_bkts[GRO_FLOW_BURST_BKT_NUM];
 
 	/* allocate a reassembly table for UDP/IPv4 GRO */
 	struct gro_udp4_tbl udp_tbl;
@@ -176,6 +225,7 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 	struct gro_vxlan_tcp4_flow vxlan_tcp_flows[RTE_GRO_MAX_BURST_ITEM_NUM];
 	struct gro_vxlan_tcp4_item vxlan_tcp_items[RTE_GRO_MAX_BURST_ITEM_NUM]
 			= {{{0}, 0, 0} };
+	struct gro_flow_bkt vxlan_tcp_bkts[GRO_FLOW_BURST_BKT_NUM];
 
 	/* Allocate a reassembly table for VXLAN UDP GRO */
 	struct gro_vxlan_udp4_tbl vxlan_udp_tbl;
@@ -183,16 +233,22 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 	struct gro_vxlan_udp4_item vxlan_udp_items[RTE_GRO_MAX_BURST_ITEM_NUM]
 			= {{{0}} };
 
+	/*
+	 * Reassembly tables for UDP/IPv6 and VxLAN/GENEVE TCP over IPv6 GRO,
+	 * whose arrays are only allocated in the stack when requested.
+	 */
+	struct gro_udp6_tbl udp6_tbl;
+	struct gro_tunnel6_tcp4_tbl vxlan6_tcp_tbl;
+	struct gro_tunnel6_tcp4_tbl geneve6_tcp_tbl;
+
 	uint32_t item_num;
 	int32_t ret;
 	uint16_t i, unprocess_num = 0, nb_after_gro = nb_pkts;
 	uint8_t do_tcp4_gro = 0, do_vxlan_tcp_gro = 0, do_udp4_gro = 0,
-		do_vxlan_udp_gro = 0, do_tcp6_gro = 0;
+		do_vxlan_udp_gro = 0, do_tcp6_gro = 0, do_udp6_gro = 0,
+		do_vxlan6_tcp_gro = 0, do_geneve6_tcp_gro = 0;
 
-	if (unlikely((param->gro_types & (RTE_GRO_IPV4_VXLAN_TCP_IPV4 |
-					RTE_GRO_TCP_IPV4 | RTE_GRO_TCP_IPV6 |
-					RTE_GRO_IPV4_VXLAN_UDP_IPV4 |
-					RTE_GRO_UDP_IPV4)) == 0))
+	if (unlikely((param->gro_types & GRO_SUPPORTED_TYPES) == 0))
 		return nb_pkts;
 
 	/* Get the maximum number of packets */
@@ -210,6 +266,7 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		vxlan_tcp_tbl.item_num = 0;
 		vxlan_tcp_tbl.max_flow_num = item_num;
 		vxlan_tcp_tbl.max_item_num = item_num;
+		gro_flow_index_init(&vxlan_tcp_tbl.flow_index, vxlan_tcp_bkts, item_num);
 		do_vxlan_tcp_gro = 1;
 	}
 
@@ -236,6 +293,7 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		tcp_tbl.item_num = 0;
 		tcp_tbl.max_flow_num = item_num;
 		tcp_tbl.max_item_num = item_num;
+		gro_flow_index_init(&tcp_tbl.flow_index, tcp_bkts, item_num);
 		do_tcp4_gro = 1;
 	}
 
@@ -262,9 +320,64 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		tcp6_tbl.item_num = 0;
 		tcp6_tbl.max_flow_num = item_num;
 		tcp6_tbl.max_item_num = item_num;
+		gro_flow_index_init(&tcp6_tbl.flow_index, tcp6_bkts, item_num);
 		do_tcp6_gro = 1;
 	}
 
+	if (param->gro_types & RTE_GRO_UDP_IPV6) {
+		GRO_BURST_ALLOC(udp6_tbl.flows, item_num);
+		GRO_BURST_ALLOC(udp6_tbl.items, item_num);
+		memset(udp6_tbl.items, 0, item_num * sizeof(udp6_tbl.items[0]));
+		for (i = 0; i < item_num; i++)
+			udp6_tbl.flows[i].start_index = INVALID_ARRAY_INDEX;
+
+		udp6_tbl.flow_num = 0;
+		udp6_tbl.item_num = 0;
+		udp6_tbl.max_flow_num = item_num;
+		udp6_tbl.max_item_num = item_num;
+		do_udp6_gro = 1;
+	}
+
+	if (param->gro_types & RTE_GRO_IPV6_VXLAN_TCP_IPV4) {
+		GRO_BURST_ALLOC(vxlan6_tcp_tbl.flows, item_num);
+		GRO_BURST_ALLOC(vxlan6_tcp_tbl.items, item_num);
+		GRO_BURST_ALLOC(vxlan6_tcp_tbl.flow_index.bkts,
+				gro_flow_index_bkt_num(item_num));
+		memset(vxlan6_tcp_tbl.items, 0,
+				item_num * sizeof(vxlan6_tcp_tbl.items[0]));
+		for (i = 0; i < item_num; i++)
+			vxlan6_tcp_tbl.flows[i].start_index = INVALID_ARRAY_INDEX;
+
+		vxlan6_tcp_tbl.flow_num = 0;
+		vxlan6_tcp_tbl.item_num = 0;
+		vxlan6_tcp_tbl.max_flow_num = item_num;
+		vxlan6_tcp_tbl.max_item_num = item_num;
+		gro_flow_index_init(&vxlan6_tcp_tbl.flow_index,
+				vxlan6_tcp_tbl.flow_index.bkts, item_num);
+		vxlan6_tcp_tbl.tnl_type = GRO_TUNNEL6_TYPE_VXLAN;
+		do_vxlan6_tcp_gro = 1;
+	}
+
+	if (param->gro_types & RTE_GRO_IPV6_GENEVE_TCP_IPV4) {
+		GRO_BURST_ALLOC(geneve6_tcp_tbl.flows, item_num);
+		GRO_BURST_ALLOC(geneve6_tcp_tbl.items, item_num);
+		GRO_BURST_ALLOC(geneve6_tcp_tbl.flow_index.bkts,
+				gro_flow_index_bkt_num(item_num));
+		memset(geneve6_tcp_tbl.items, 0,
+				item_num * sizeof(geneve6_tcp_tbl.items[0]));
+		for (i = 0; i < item_num; i++)
+			geneve6_tcp_tbl.flows[i].start_index = INVALID_ARRAY_INDEX;
+
+		geneve6_tcp_tbl.flow_num = 0;
+		geneve6_tcp_tbl.item_num = 0;
+		geneve6_tcp_tbl.max_flow_num = item_num;
+		geneve6_tcp_tbl.max_item_num = item_num;
+		gro_flow_index_init(&geneve6_tcp_tbl.flow_index,
+				geneve6_tcp_tbl.flow_index.bkts, item_num);
+		geneve6_tcp_tbl.tnl_type = GRO_TUNNEL6_TYPE_GENEVE;
+		do_geneve6_tcp_gro = 1;
+	}
+
 	for (i = 0; i < nb_pkts; i++) {
 		/*
 		 * The timestamp is ignored, since all packets
@@ -312,6 +425,32 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 				nb_after_gro--;
 			else if (ret < 0)
 				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_VXLAN_TCP4_PKT(pkts[i]->packet_type) &&
+				do_vxlan6_tcp_gro) {
+			ret = gro_tunnel6_tcp4_reassemble(pkts[i],
+							&vxlan6_tcp_tbl, 0);
+			if (ret > 0)
+				/* Merge successfully */
+				nb_after_gro--;
+			else if (ret < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_GENEVE_TCP4_PKT(pkts[i]->packet_type) &&
+				do_geneve6_tcp_gro) {
+			ret = gro_tunnel6_tcp4_reassemble(pkts[i],
+							&geneve6_tcp_tbl, 0);
+			if (ret > 0)
+				/* Merge successfully */
+				nb_after_gro--;
+			else if (ret < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_UDP_PKT(pkts[i]->packet_type) &&
+				do_udp6_gro) {
+			ret = gro_udp6_reassemble(pkts[i], &udp6_tbl, 0);
+			if (ret > 0)
+				/* merge successfully */
+				nb_after_gro--;
+			else if (ret < 0)
+				pkts[unprocess_num++] = pkts[i];
 		} else
 			pkts[unprocess_num++] = pkts[i];
 	}
@@ -347,6 +486,21 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 			i += gro_tcp6_tbl_timeout_flush(&tcp6_tbl, 0,
 					&pkts[i], nb_pkts - i);
 		}
+
+		if (do_vxlan6_tcp_gro) {
+			i += gro_tunnel6_tcp4_tbl_timeout_flush(&vxlan6_tcp_tbl,
+					0, &pkts[i], nb_pkts - i);
+		}
+
+		if (do_geneve6_tcp_gro) {
+			i += gro_tunnel6_tcp4_tbl_timeout_flush(&geneve6_tcp_tbl,
+					0, &pkts[i], nb_pkts - i);
+		}
+
+		if (do_udp6_gro) {
+			i += gro_udp6_tbl_timeout_flush(&udp6_tbl, 0,
+					&pkts[i], nb_pkts - i);
+		}
 	}
 
 	return nb_after_gro;
@@ -360,14 +514,13 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 {
 	struct gro_ctx *gro_ctx = ctx;
 	void *tcp_tbl, *udp_tbl, *vxlan_tcp_tbl, *vxlan_udp_tbl, *tcp6_tbl;
+	void *udp6_tbl, *vxlan6_tcp_tbl, *geneve6_tcp_tbl;
 	uint64_t current_time;
 	uint16_t i, unprocess_num = 0;
 	uint8_t do_tcp4_gro, do_vxlan_tcp_gro, do_udp4_gro, do_vxlan_udp_gro, do_tcp6_gro;
+	uint8_t do_udp6_gro, do_vxlan6_tcp_gro, do_geneve6_tcp_gro;
 
-	if (unlikely((gro_ctx->gro_types & (RTE_GRO_IPV4_VXLAN_TCP_IPV4 |
-					RTE_GRO_TCP_IPV4 | RTE_GRO_TCP_IPV6 |
-					RTE_GRO_IPV4_VXLAN_UDP_IPV4 |
-					RTE_GRO_UDP_IPV4)) == 0))
+	if (unlikely((gro_ctx->gro_types & GRO_SUPPORTED_TYPES) == 0))
 		return nb_pkts;
 
 	tcp_tbl = gro_ctx->tbls[RTE_GRO_TCP_IPV4_INDEX];
@@ -375,6 +528,9 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 	udp_tbl = gro_ctx->tbls[RTE_GRO_UDP_IPV4_INDEX];
 	vxlan_udp_tbl = gro_ctx->tbls[RTE_GRO_IPV4_VXLAN_UDP_IPV4_INDEX];
 	tcp6_tbl = gro_ctx->tbls[RTE_GRO_TCP_IPV6_INDEX];
+	udp6_tbl = gro_ctx->tbls[RTE_GRO_UDP_IPV6_INDEX];
+	vxlan6_tcp_tbl = gro_ctx->tbls[RTE_GRO_IPV6_VXLAN_TCP_IPV4_INDEX];
+	geneve6_tcp_tbl = gro_ctx->tbls[RTE_GRO_IPV6_GENEVE_TCP_IPV4_INDEX];
 
 	do_tcp4_gro = (gro_ctx->gro_types & RTE_GRO_TCP_IPV4) ==
 		RTE_GRO_TCP_IPV4;
@@ -385,6 +541,11 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 	do_vxlan_udp_gro = (gro_ctx->gro_types & RTE_GRO_IPV4_VXLAN_UDP_IPV4) ==
 		RTE_GRO_IPV4_VXLAN_UDP_IPV4;
 	do_tcp6_gro = (gro_ctx->gro_types & RTE_GRO_TCP_IPV6) == RTE_GRO_TCP_IPV6;
+	do_udp6_gro = (gro_ctx->gro_types & RTE_GRO_UDP_IPV6) == RTE_GRO_UDP_IPV6;
+	do_vxlan6_tcp_gro = (gro_ctx->gro_types & RTE_GRO_IPV6_VXLAN_TCP_IPV4) ==
+		RTE_GRO_IPV6_VXLAN_TCP_IPV4;
+	do_geneve6_tcp_gro = (gro_ctx->gro_types & RTE_GRO_IPV6_GENEVE_TCP_IPV4) ==
+		RTE_GRO_IPV6_GENEVE_TCP_IPV4;
 
 	current_time = rte_rdtsc();
 
@@ -414,6 +575,21 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 			if (gro_tcp6_reassemble(pkts[i], tcp6_tbl,
 						current_time) < 0)
 				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_VXLAN_TCP4_PKT(pkts[i]->packet_type) &&
+				do_vxlan6_tcp_gro) {
+			if (gro_tunnel6_tcp4_reassemble(pkts[i], vxlan6_tcp_tbl,
+						current_time) < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_GENEVE_TCP4_PKT(pkts[i]->packet_type) &&
+				do_geneve6_tcp_gro) {
+			if (gro_tunnel6_tcp4_reassemble(pkts[i], geneve6_tcp_tbl,
+						current_time) < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_UDP_PKT(pkts[i]->packet_type) &&
+				do_udp6_gro) {
+			if (gro_udp6_reassemble(pkts[i], udp6_tbl,
+						current_time) < 0)
+				pkts[unprocess_num++] = pkts[i];
 		} else
 			pkts[unprocess_num++] = pkts[i];
 	}
@@ -474,7 +650,28 @@ rte_gro_timeout_flush(void *ctx,
 				gro_ctx->tbls[RTE_GRO_TCP_IPV6_INDEX],
 				flush_timestamp,
 				&out[num], left_nb_out);
+		left_nb_out = max_nb_out - num;
+	}
 
+	if ((gro_types & RTE_GRO_IPV6_VXLAN_TCP_IPV4) && left_nb_out > 0) {
+		num += gro_tunnel6_tcp4_tbl_timeout_flush(gro_ctx->tbls[
+				RTE_GRO_IPV6_VXLAN_TCP_IPV4_INDEX],
+				flush_timestamp, &out[num], left_nb_out);
+		left_nb_out = max_nb_out - num;
+	}
+
+	if ((gro_types & RTE_GRO_IPV6_GENEVE_TCP_IPV4) && left_nb_out > 0) {
+		num += gro_tunnel6_tcp4_tbl_timeout_flush(gro_ctx->tbls[
+				RTE_GRO_IPV6_GENEVE_TCP_IPV4_INDEX],
+				flush_timestamp, &out[num], left_nb_out);
+		left_nb_out = max_nb_out - num;
+	}
+
+	if ((gro_types & RTE_GRO_UDP_IPV6) && left_nb_out > 0) {
+		num += gro_udp6_tbl_timeout_flush(
+				gro_ctx->tbls[RTE_GRO_UDP_IPV6_INDEX],
+				flush_timestamp,
+				&out[num], left_nb_out);
 	}
 
 	return num;
@@ -38,6 +38,47 @@
 #define IS_IPV4_UDP(flag) (((flag) & (RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV4)) == \
 		(RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV4))
 
+#define IS_IPV6_TCP(flag) (((flag) & (RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_IPV6)) == \
+		(RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_IPV6))
+
+#define IS_IPV6_UDP(flag) (((flag) & (RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV6)) == \
+		(RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV6))
+
+/*
+ * Tunnel packet matching, where 'seg' is the L4 segmentation flag, 'l3'
+ * and 'outer_l3' are the inner and outer IP version flags and 'tnl' is
+ * the tunnel type.
+ */
+#define IS_TUNNEL_PKT(flag, seg, l3, outer_l3, tnl) \
+	(((flag) & ((seg) | RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IPV6 | \
+		    RTE_MBUF_F_TX_OUTER_IPV4 | RTE_MBUF_F_TX_OUTER_IPV6 | \
+		    RTE_MBUF_F_TX_TUNNEL_MASK)) == \
+	 ((seg) | (l3) | (outer_l3) | (tnl)))
+
+#define IS_IPV6_VXLAN_TCP4(flag) IS_TUNNEL_PKT(flag, RTE_MBUF_F_TX_TCP_SEG, \
+		RTE_MBUF_F_TX_IPV4, RTE_MBUF_F_TX_OUTER_IPV6, RTE_MBUF_F_TX_TUNNEL_VXLAN)
+
+#define IS_IPV6_GRE_TCP4(flag) IS_TUNNEL_PKT(flag, RTE_MBUF_F_TX_TCP_SEG, \
+		RTE_MBUF_F_TX_IPV4, RTE_MBUF_F_TX_OUTER_IPV6, RTE_MBUF_F_TX_TUNNEL_GRE)
+
+#define IS_IPV6_VXLAN_UDP4(flag) IS_TUNNEL_PKT(flag, RTE_MBUF_F_TX_UDP_SEG, \
+		RTE_MBUF_F_TX_IPV4, RTE_MBUF_F_TX_OUTER_IPV6, RTE_MBUF_F_TX_TUNNEL_VXLAN)
+
+#define IS_IPV4_VXLAN_TCP6(flag) IS_TUNNEL_PKT(flag, RTE_MBUF_F_TX_TCP_SEG, \
+		RTE_MBUF_F_TX_IPV6, RTE_MBUF_F_TX_OUTER_IPV4, RTE_MBUF_F_TX_TUNNEL_VXLAN)
+
+#define IS_IPV6_VXLAN_TCP6(flag) IS_TUNNEL_PKT(flag, RTE_MBUF_F_TX_TCP_SEG, \
+		RTE_MBUF_F_TX_IPV6, RTE_MBUF_F_TX_OUTER_IPV6, RTE_MBUF_F_TX_TUNNEL_VXLAN)
+
+#define IS_IPV4_GRE_TCP6(flag) IS_TUNNEL_PKT(flag, RTE_MBUF_F_TX_TCP_SEG, \
+		RTE_MBUF_F_TX_IPV6, RTE_MBUF_F_TX_OUTER_IPV4, RTE_MBUF_F_TX_TUNNEL_GRE)
+
+#define IS_IPV6_GRE_TCP6(flag) IS_TUNNEL_PKT(flag, RTE_MBUF_F_TX_TCP_SEG, \
+		RTE_MBUF_F_TX_IPV6, RTE_MBUF_F_TX_OUTER_IPV6, RTE_MBUF_F_TX_TUNNEL_GRE)
+
+/* IPv6 packets carrying a fragment header are not processed. */
+#define IS_IPV6_FRAGMENTED(proto) ((proto) == IPPROTO_FRAGMENT)
+
 /**
  * Internal function which updates the UDP header of a packet, following
  * segmentation. This is required to update the header's datagram length field.
@@ -110,6 +151,28 @@ update_ipv4_header(struct rte_mbuf *pkt, uint16_t l3_offset, uint16_t id)
 	ipv4_hdr->packet_id = rte_cpu_to_be_16(id);
 }
 
+/**
+ * Internal function which updates the IPv6 header of a packet, following
+ * segmentation. This is required to update the header's 'payload_len'
+ * field, to reflect the reduced length of the now-segmented packet. Any
+ * extension headers are counted as part of the payload.
+ *
+ * @param pkt
+ *  The packet containing the IPv6 header.
+ * @param l3_offset
+ *  The offset of the IPv6 header from the start of the packet.
+ */
+static inline void
+update_ipv6_header(struct rte_mbuf *pkt, uint16_t l3_offset)
+{
+	struct rte_ipv6_hdr *ipv6_hdr;
+
+	ipv6_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv6_hdr *,
+					   l3_offset);
+	ipv6_hdr->payload_len = rte_cpu_to_be_16(pkt->pkt_len - l3_offset -
+			sizeof(struct rte_ipv6_hdr));
+}
+
 /**
  * Internal function which divides the input packet into small segments.
  * Each of the newly-created segments is organized as a two-segment MBUF,
@@ -0,0 +1,113 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+
+#include <rte_random.h>
+
+#include "gso_common.h"
+#include "gso_udp6.h"
+
+static inline void
+update_ipv6_udp_headers(struct rte_mbuf *pkt, struct rte_mbuf **segs,
+		uint16_t nb_segs)
+{
+	struct rte_ipv6_hdr *ipv6_hdr;
+	struct rte_ipv6_fragment_ext *frag_hdr;
+	uint16_t l2_hdrlen = pkt->l2_len, l3_hdrlen = pkt->l3_len;
+	uint16_t frag_offset = 0, is_mf;
+	uint16_t tail_idx = nb_segs - 1, length, i;
+	uint32_t id;
+
+	/* All fragments of the datagram share one identification value. */
+	id = rte_cpu_to_be_32((uint32_t)rte_rand());
+
+	/*
+	 * The first part of each output segment holds a copy of the L2
+	 * and IPv6 headers only, so the fragment header is appended to
+	 * it, right after the IPv6 header.
+	 */
+	for (i = 0; i < nb_segs; i++) {
+		ipv6_hdr = rte_pktmbuf_mtod_offset(segs[i],
+			struct rte_ipv6_hdr *, l2_hdrlen);
+		frag_hdr = (struct rte_ipv6_fragment_ext *)
+			((char *)ipv6_hdr + l3_hdrlen);
+
+		segs[i]->data_len += RTE_IPV6_FRAG_HDR_SIZE;
+		segs[i]->pkt_len += RTE_IPV6_FRAG_HDR_SIZE;
+
+		frag_hdr->next_header = ipv6_hdr->proto;
+		frag_hdr->reserved = 0;
+		is_mf = i < tail_idx ? 1 : 0;
+		frag_hdr->frag_data = rte_cpu_to_be_16(
+			RTE_IPV6_SET_FRAG_DATA(frag_offset, is_mf));
+		frag_hdr->id = id;
+
+		ipv6_hdr->proto = IPPROTO_FRAGMENT;
+		length = segs[i]->pkt_len - l2_hdrlen - l3_hdrlen;
+		ipv6_hdr->payload_len = rte_cpu_to_be_16(length);
+
+		/* Fragment offset is kept in bytes, with the low 3 bits clear. */
+		frag_offset += length - RTE_IPV6_FRAG_HDR_SIZE;
+	}
+}
+
+int
+gso_udp6_segment(struct rte_mbuf *pkt,
+		uint16_t gso_size,
+		struct rte_mempool *direct_pool,
+		struct rte_mempool *indirect_pool,
+		struct rte_mbuf **pkts_out,
+		uint16_t nb_pkts_out)
+{
+	struct rte_ipv6_hdr *ipv6_hdr;
+	uint32_t hdr_room;
+	uint16_t pyld_unit_size, hdr_offset;
+	int ret;
+
+	/* Don't process the fragmented packet */
+	ipv6_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv6_hdr *,
+			pkt->l2_len);
+	if (unlikely(IS_IPV6_FRAGMENTED(ipv6_hdr->proto)))
+		return 0;
+
+	/*
+	 * The fragment header must follow the unfragmentable part of the
+	 * packet, which is only known when there are no extension headers.
+	 */
+	if (unlikely(pkt->l3_len != sizeof(struct rte_ipv6_hdr)))
+		return -ENOTSUP;
+
+	/*
+	 * UDP fragmentation is the same as IP fragmentation.
+	 * Except the first one, other output packets just have l2
+	 * and l3 headers.
+	 */
+	hdr_offset = pkt->l2_len + pkt->l3_len;
+
+	/* Don't process the packet without data. */
+	if (unlikely(hdr_offset + pkt->l4_len >= pkt->pkt_len))
+		return 0;
+
+	/* Room is needed in each header segment for the fragment header. */
+	hdr_room = rte_pktmbuf_data_room_size(direct_pool);
+	if (unlikely(hdr_offset + RTE_IPV6_FRAG_HDR_SIZE >= gso_size ||
+			hdr_offset + RTE_IPV6_FRAG_HDR_SIZE +
+			RTE_PKTMBUF_HEADROOM > hdr_room))
+		return -EINVAL;
+
+	/* pyld_unit_size must be a multiple of 8 because frag_off
+	 * uses 8 bytes as unit.
+	 */
+	pyld_unit_size = (gso_size - hdr_offset - RTE_IPV6_FRAG_HDR_SIZE) &
+		~7U;
+
+	/* Segment the payload */
+	ret = gso_do_segment(pkt, hdr_offset, pyld_unit_size, direct_pool,
+			indirect_pool, pkts_out, nb_pkts_out);
+	if (ret > 1)
+		update_ipv6_udp_headers(pkt, pkts_out, ret);
+
+	return ret;
+}
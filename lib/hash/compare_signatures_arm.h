@@ -13,9 +13,6 @@
 
 #include "rte_cuckoo_hash.h"
 
-/* Arm's version uses a densely packed hitmask buffer: every bit is in use. */
-#define DENSE_HASH_BULK_LOOKUP 1
-
 static inline void
 compare_signatures_dense(uint16_t *hitmask_buffer,
 			const uint16_t *prim_bucket_sigs,
@@ -13,12 +13,6 @@
 
 #include "rte_cuckoo_hash.h"
 
-/*
- * The generic version could use either a dense or sparsely packed hitmask buffer,
- * but the dense one is slightly faster.
- */
-#define DENSE_HASH_BULK_LOOKUP 1
-
 static inline void
 compare_signatures_dense(uint16_t *hitmask_buffer,
 			const uint16_t *prim_bucket_sigs,
@@ -13,38 +13,40 @@
 
 #include "rte_cuckoo_hash.h"
 
-/* x86's version uses a sparsely packed hitmask buffer: every other bit is padding. */
-#define DENSE_HASH_BULK_LOOKUP 0
-
 static inline void
-compare_signatures_sparse(uint32_t *prim_hash_matches, uint32_t *sec_hash_matches,
-			const struct rte_hash_bucket *prim_bkt,
-			const struct rte_hash_bucket *sec_bkt,
+compare_signatures_dense(uint16_t *hitmask_buffer,
+			const uint16_t *prim_bucket_sigs,
+			const uint16_t *sec_bucket_sigs,
 			uint16_t sig,
 			enum rte_hash_sig_compare_function sig_cmp_fn)
 {
-	unsigned int i;
+	static_assert(sizeof(*hitmask_buffer) >= 2 * (RTE_HASH_BUCKET_ENTRIES / 8),
+			"hitmask_buffer must be wide enough to fit a dense hitmask");
 
-	/* For match mask the first bit of every two bits indicates the match */
+	/* For match mask every bits indicates the match */
 	switch (sig_cmp_fn) {
 #if defined(__SSE2__) && RTE_HASH_BUCKET_ENTRIES <= 8
 	case RTE_HASH_COMPARE_SSE:
-		/* Compare all signatures in the bucket */
-		*prim_hash_matches = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_load_si128(
-			(__m128i const *)prim_bkt->sig_current), _mm_set1_epi16(sig)));
-		/* Extract the even-index bits only */
-		*prim_hash_matches &= 0x5555;
-		/* Compare all signatures in the bucket */
-		*sec_hash_matches = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_load_si128(
-			(__m128i const *)sec_bkt->sig_current), _mm_set1_epi16(sig)));
-		/* Extract the even-index bits only */
-		*sec_hash_matches &= 0x5555;
+	case RTE_HASH_COMPARE_AVX512: {
+		const __m128i vsig = _mm_set1_epi16(sig);
+
+		/*
+		 * Compare all signatures of both buckets, and pack the 16-bit
+		 * results to bytes so that movemask gives one bit per entry.
+		 */
+		*hitmask_buffer = _mm_movemask_epi8(_mm_packs_epi16(
+			_mm_cmpeq_epi16(_mm_load_si128(
+				(__m128i const *)prim_bucket_sigs), vsig),
+			_mm_cmpeq_epi16(_mm_load_si128(
+				(__m128i const *)sec_bucket_sigs), vsig)));
 		break;
+	}
 #endif
 	default:
-		for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
-			*prim_hash_matches |= (sig == prim_bkt->sig_current[i]) << (i << 1);
-			*sec_hash_matches |= (sig == sec_bkt->sig_current[i]) << (i << 1);
+		for (unsigned int i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
+			*hitmask_buffer |= (sig == prim_bucket_sigs[i]) << i;
+			*hitmask_buffer |=
+				((sig == sec_bucket_sigs[i]) << i) << RTE_HASH_BUCKET_ENTRIES;
 		}
 	}
 }
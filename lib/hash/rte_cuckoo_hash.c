@@ -42,6 +42,7 @@ enum rte_hash_sig_compare_function {
 	RTE_HASH_COMPARE_SSE,
 	RTE_HASH_COMPARE_NEON,
 	RTE_HASH_COMPARE_SVE,
+	RTE_HASH_COMPARE_AVX512,
 };
 
 #if defined(__ARM_NEON)
@@ -52,13 +53,43 @@ enum rte_hash_sig_compare_function {
 #include "compare_signatures_generic.h"
 #endif
 
+#ifdef CC_AVX512_SUPPORT
+#include "rte_cuckoo_hash_avx512.h"
+#endif
+
+/*
+ * Table storing all different key compare functions
+ * (multi-process supported)
+ */
+#if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
+static const rte_hash_cmp_eq_t cmp_jump_table[NUM_KEY_CMP_CASES] = {
+	NULL,
+	rte_hash_k16_cmp_eq,
+	rte_hash_k32_cmp_eq,
+	rte_hash_k48_cmp_eq,
+	rte_hash_k64_cmp_eq,
+	rte_hash_k80_cmp_eq,
+	rte_hash_k96_cmp_eq,
+	rte_hash_k112_cmp_eq,
+	rte_hash_k128_cmp_eq,
+	memcmp
+};
+#else
+static const rte_hash_cmp_eq_t cmp_jump_table[NUM_KEY_CMP_CASES] = {
+	NULL,
+	memcmp
+};
+#endif
+
 /* Mask of all flags supported by this version */
 #define RTE_HASH_EXTRA_FLAGS_MASK (RTE_HASH_EXTRA_FLAGS_TRANS_MEM_SUPPORT | \
 				   RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD | \
 				   RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY | \
 				   RTE_HASH_EXTRA_FLAGS_EXT_TABLE |	\
 				   RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL | \
-				   RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF)
+				   RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF | \
+				   RTE_HASH_EXTRA_FLAGS_RESIZABLE | \
+				   RTE_HASH_EXTRA_FLAGS_KEY_INLINE)
 
 #define FOR_EACH_BUCKET(CURRENT_BKT, START_BUCKET)                            \
 	for (CURRENT_BKT = START_BUCKET;                                      \
@@ -156,6 +187,80 @@ get_alt_bucket_index(const struct rte_hash *h,
 	return (cur_bkt_idx ^ sig) & h->bucket_bitmask;
 }
 
+/*
+ * Get the key store entry of a key index. The key store of a resizable
+ * table is made of segments of doubling size, so that its entries never
+ * move when it grows: the first segment holds the dummy entry and the
+ * key positions (i.e. index - 1) [0, 2^key_seg_shift), segment s > 0
+ * the positions [2^(key_seg_shift + s - 1), 2^(key_seg_shift + s)).
+ * The dummy entry maps to segment 32 - key_seg_shift, which is the first
+ * segment again. Other tables have a single segment, key_seg_shift
+ * being 31.
+ */
+static inline struct rte_hash_key *
+get_key_slot(const struct rte_hash *h, uint32_t key_idx)
+{
+	uint32_t seg = rte_fls_u32((key_idx - 1) >> h->key_seg_shift);
+
+	return (struct rte_hash_key *)(h->key_segs[seg] +
+			(uintptr_t)key_idx * h->key_entry_size);
+}
+
+/* Get the number of key positions of a resizable table before segment seg */
+static inline uint32_t
+key_seg_start(const struct rte_hash *h, uint32_t seg)
+{
+	return seg == 0 ? 0 : RTE_BIT32(h->key_seg_shift + seg - 1);
+}
+
+/* Get the allocated address of segment seg > 0 of a resizable table */
+static inline void *
+key_seg_mem(const struct rte_hash *h, uint32_t seg)
+{
+	return (void *)(h->key_segs[seg] +
+		((uintptr_t)key_seg_start(h, seg) + 1) * h->key_entry_size);
+}
+
+/* Free a list of bucket tables, with the buckets they migrate */
+static void
+bkt_tbl_free(struct rte_hash_bkt_tbl *tbl)
+{
+	struct rte_hash_bkt_tbl *next;
+
+	for (; tbl != NULL; tbl = next) {
+		next = tbl->next;
+		rte_free(tbl->old_buckets);
+		rte_free(tbl);
+	}
+}
+
+/* Record the time of an add or lookup of a key, aging being enabled */
+static inline void
+age_touch(const struct rte_hash *h, int32_t position, uint64_t now)
+{
+	/* Key index of the position, adding the first dummy index */
+	rte_atomic_store_explicit(&h->age_ts[position + 1], now,
+			rte_memory_order_relaxed);
+}
+
+/* Record the time of the lookup of the keys found by a bulk lookup */
+static inline void
+age_touch_bulk(const struct rte_hash *h, const int32_t *positions,
+		int32_t num_keys)
+{
+	uint64_t now;
+	int32_t i;
+
+	if (h->age_ts == NULL)
+		return;
+
+	now = rte_get_tsc_cycles();
+	for (i = 0; i < num_keys; i++) {
+		if (positions[i] >= 0)
+			age_touch(h, positions[i], now);
+	}
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_create)
 struct rte_hash *
 rte_hash_create(const struct rte_hash_parameters *params)
@@ -180,6 +285,9 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	RTE_ATOMIC(uint32_t) *tbl_chng_cnt = NULL;
 	struct lcore_cache *local_free_slots = NULL;
 	unsigned int readwrite_concur_lf_support = 0;
+	unsigned int resizable = 0;
+	unsigned int key_inline = 0;
+	struct rte_hash_bkt_tbl *bkt_tbl = NULL;
 	uint32_t i;
 
 	rte_hash_function default_hash_func = (rte_hash_function)rte_jhash;
@@ -237,12 +345,45 @@ rte_hash_create(const struct rte_hash_parameters *params)
 		return NULL;
 	}
 
+	if ((params->extra_flag & RTE_HASH_EXTRA_FLAGS_RESIZABLE) &&
+	    (params->extra_flag & (RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD |
+				   RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY |
+				   RTE_HASH_EXTRA_FLAGS_EXT_TABLE))) {
+		rte_errno = EINVAL;
+		HASH_LOG(ERR, "%s: resizable table supports neither multi-writer, rw concurrency with lock nor ext table",
+			__func__);
+		return NULL;
+	}
+
+	if ((params->extra_flag & RTE_HASH_EXTRA_FLAGS_KEY_INLINE) &&
+	    (params->extra_flag & (RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF |
+				   RTE_HASH_EXTRA_FLAGS_EXT_TABLE |
+				   RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL |
+				   RTE_HASH_EXTRA_FLAGS_RESIZABLE))) {
+		rte_errno = EINVAL;
+		HASH_LOG(ERR, "%s: key inline table supports neither rw concurrency lock free, ext table, no free on delete nor resize",
+			__func__);
+		return NULL;
+	}
+
+	if ((params->extra_flag & RTE_HASH_EXTRA_FLAGS_KEY_INLINE) &&
+	    params->key_len > RTE_HASH_KEY_INLINE_LEN_MAX) {
+		rte_errno = EINVAL;
+		HASH_LOG(ERR, "%s() key_len of key inline table must be at most %d",
+			__func__, RTE_HASH_KEY_INLINE_LEN_MAX);
+		return NULL;
+	}
+
+	if (params->extra_flag & RTE_HASH_EXTRA_FLAGS_KEY_INLINE)
+		key_inline = 1;
+
 	/* Check extra flags field to check extra options. */
 	if (params->extra_flag & RTE_HASH_EXTRA_FLAGS_TRANS_MEM_SUPPORT)
 		hw_trans_mem_support = 1;
 
 	if (params->extra_flag & RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD) {
-		use_local_cache = 1;
+		/* A key inline table has no key store slots to cache */
+		use_local_cache = !key_inline;
 		writer_takes_lock = 1;
 	}
 
@@ -266,6 +407,9 @@ rte_hash_create(const struct rte_hash_parameters *params)
 		no_free_on_del = 1;
 	}
 
+	if (params->extra_flag & RTE_HASH_EXTRA_FLAGS_RESIZABLE)
+		resizable = 1;
+
 	/* Store all keys and leave the first entry as a dummy entry for lookup_bulk */
 	if (use_local_cache)
 		/*
@@ -284,15 +428,21 @@ rte_hash_create(const struct rte_hash_parameters *params)
 		HASH_LOG(NOTICE, "ring name truncated to '%s'", ring_name);
 
 	/* Create ring (Dummy slot index is not enqueued) */
-	r = rte_ring_create_elem(ring_name, sizeof(uint32_t),
-			rte_align32pow2(num_key_slots), params->socket_id, 0);
-	if (r == NULL) {
-		HASH_LOG(ERR, "ring creation failed: %s", rte_strerror(rte_errno));
-		goto err;
+	if (!key_inline) {
+		r = rte_ring_create_elem(ring_name, sizeof(uint32_t),
+				rte_align32pow2(num_key_slots), params->socket_id, 0);
+		if (r == NULL) {
+			HASH_LOG(ERR, "ring creation failed: %s", rte_strerror(rte_errno));
+			goto err;
+		}
 	}
 
 	const uint32_t num_buckets = rte_align32pow2(params->entries) /
-						RTE_HASH_BUCKET_ENTRIES;
+		(key_inline ? RTE_HASH_INLINE_BUCKET_ENTRIES :
+			      RTE_HASH_BUCKET_ENTRIES);
+	const size_t bucket_size = key_inline ?
+		sizeof(struct rte_hash_inline_bucket) :
+		sizeof(struct rte_hash_bucket);
 
 	/* Create ring for extendable buckets. */
 	if (ext_table_support) {
@@ -346,8 +496,7 @@ rte_hash_create(const struct rte_hash_parameters *params)
 		goto err_unlock;
 	}
 
-	buckets = rte_zmalloc_socket(NULL,
-				num_buckets * sizeof(struct rte_hash_bucket),
+	buckets = rte_zmalloc_socket(NULL, num_buckets * bucket_size,
 				RTE_CACHE_LINE_SIZE, params->socket_id);
 
 	if (buckets == NULL) {
@@ -387,14 +536,20 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	const uint32_t key_entry_size =
 		RTE_ALIGN(sizeof(struct rte_hash_key) + params->key_len,
 			  KEY_ALIGNMENT);
-	const uint64_t key_tbl_size = (uint64_t) key_entry_size * num_key_slots;
-
-	k = rte_zmalloc_socket(NULL, key_tbl_size,
-			RTE_CACHE_LINE_SIZE, params->socket_id);
+	/* The first key store segment of a resizable table is full size */
+	const uint64_t key_tbl_size = (uint64_t) key_entry_size *
+		(resizable ? num_buckets * RTE_HASH_BUCKET_ENTRIES + 1 :
+			     num_key_slots);
+
+	/* The keys of a key inline table are stored in the buckets */
+	if (!key_inline) {
+		k = rte_zmalloc_socket(NULL, key_tbl_size,
+				RTE_CACHE_LINE_SIZE, params->socket_id);
 
-	if (k == NULL) {
-		HASH_LOG(ERR, "memory allocation failed");
-		goto err_unlock;
+		if (k == NULL) {
+			HASH_LOG(ERR, "memory allocation failed");
+			goto err_unlock;
+		}
 	}
 
 	tbl_chng_cnt = rte_zmalloc_socket(NULL, sizeof(uint32_t),
@@ -405,6 +560,17 @@ rte_hash_create(const struct rte_hash_parameters *params)
 		goto err_unlock;
 	}
 
+	if (resizable) {
+		bkt_tbl = rte_zmalloc_socket(NULL, sizeof(*bkt_tbl), 0,
+				params->socket_id);
+		if (bkt_tbl == NULL) {
+			HASH_LOG(ERR, "memory allocation failed");
+			goto err_unlock;
+		}
+		bkt_tbl->buckets = buckets;
+		bkt_tbl->bucket_bitmask = num_buckets - 1;
+	}
+
 /*
  * If x86 architecture is used, select appropriate compare function,
  * which may use x86 intrinsics, otherwise use memcmp
@@ -467,15 +633,27 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	h->key_len = params->key_len;
 	h->key_entry_size = key_entry_size;
 	h->hash_func_init_val = params->hash_func_init_val;
+	h->socket_id = params->socket_id;
 
 	h->num_buckets = num_buckets;
 	h->bucket_bitmask = h->num_buckets - 1;
-	h->buckets = buckets;
+	h->key_inline = key_inline;
+	if (key_inline)
+		h->inline_buckets = buckets;
+	else
+		h->buckets = buckets;
 	h->buckets_ext = buckets_ext;
 	h->free_ext_bkts = r_ext;
 	h->hash_func = (params->hash_func == NULL) ?
 		default_hash_func : params->hash_func;
 	h->key_store = k;
+	h->key_seg_shift = resizable ?
+		rte_log2_u32(num_buckets * RTE_HASH_BUCKET_ENTRIES) : 31;
+	h->key_segs[0] = (uintptr_t)k;
+	h->key_segs[32 - h->key_seg_shift] = (uintptr_t)k;
+	h->nb_key_segs = 1;
+	h->resizable = resizable;
+	h->bkt_tbl = bkt_tbl;
 	h->free_slots = r;
 	h->ext_bkt_to_free = ext_bkt_to_free;
 	h->tbl_chng_cnt = tbl_chng_cnt;
@@ -490,8 +668,14 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	h->readwrite_concur_lf_support = readwrite_concur_lf_support;
 
 #if defined(RTE_ARCH_X86)
-	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_SSE2))
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_SSE2)) {
 		h->sig_cmp_fn = RTE_HASH_COMPARE_SSE;
+#ifdef CC_AVX512_SUPPORT
+		if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW) > 0 &&
+				rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512)
+			h->sig_cmp_fn = RTE_HASH_COMPARE_AVX512;
+#endif
+	}
 	else
 #elif defined(RTE_ARCH_ARM64)
 	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_NEON)) {
@@ -519,8 +703,10 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	}
 
 	/* Populate free slots ring. Entry zero is reserved for key misses. */
-	for (i = 1; i < num_key_slots; i++)
-		rte_ring_sp_enqueue_elem(r, &i, sizeof(uint32_t));
+	if (!key_inline) {
+		for (i = 1; i < num_key_slots; i++)
+			rte_ring_sp_enqueue_elem(r, &i, sizeof(uint32_t));
+	}
 
 	te->data = (void *) h;
 	TAILQ_INSERT_TAIL(hash_list, te, next);
@@ -540,6 +726,7 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	rte_free(k);
 	rte_free((void *)(uintptr_t)tbl_chng_cnt);
 	rte_free(ext_bkt_to_free);
+	rte_free(bkt_tbl);
 	return NULL;
 }
 
@@ -549,6 +736,7 @@ rte_hash_free(struct rte_hash *h)
 {
 	struct rte_tailq_entry *te;
 	struct rte_hash_list *hash_list;
+	uint32_t i;
 
 	if (h == NULL)
 		return;
@@ -581,12 +769,22 @@ rte_hash_free(struct rte_hash *h)
 		rte_free(h->readwrite_lock);
 	rte_ring_free(h->free_slots);
 	rte_ring_free(h->free_ext_bkts);
+	if (h->resizable) {
+		for (i = 1; i < h->nb_key_segs; i++)
+			rte_free(key_seg_mem(h, i));
+		bkt_tbl_free(h->retired_bkt_tbl);
+		bkt_tbl_free(h->next_bkt_tbl);
+		/* Also frees the buckets being migrated */
+		bkt_tbl_free(h->bkt_tbl);
+	}
 	rte_free(h->key_store);
 	rte_free(h->buckets);
+	rte_free(h->inline_buckets);
 	rte_free(h->buckets_ext);
 	rte_free((void *)(uintptr_t)h->tbl_chng_cnt);
 	rte_free(h->ext_bkt_to_free);
 	rte_free(h->hash_rcu_cfg);
+	rte_free((void *)(uintptr_t)h->age_ts);
 	rte_free(h);
 	rte_free(te);
 }
@@ -604,6 +802,9 @@ int32_t
 rte_hash_max_key_id(const struct rte_hash *h)
 {
 	RETURN_IF_TRUE((h == NULL), -EINVAL);
+	if (h->key_inline)
+		/* Positions are the entries of the buckets */
+		return h->num_buckets * RTE_HASH_INLINE_BUCKET_ENTRIES;
 	if (h->use_local_cache)
 		/*
 		 * Increase number of slots by total number of indices
@@ -625,6 +826,9 @@ rte_hash_count(const struct rte_hash *h)
 	if (h == NULL)
 		return -EINVAL;
 
+	if (h->key_inline)
+		return h->nb_inline_keys;
+
 	if (h->use_local_cache) {
 		tot_ring_cnt = h->entries + (RTE_MAX_LCORE - 1) *
 					(LCORE_CACHE_SIZE - 1);
@@ -704,8 +908,39 @@ rte_hash_reset(struct rte_hash *h)
 			HASH_LOG(ERR, "RCU reclaim all resources failed");
 	}
 
+	if (h->key_inline) {
+		memset(h->inline_buckets, 0, h->num_buckets *
+				sizeof(struct rte_hash_inline_bucket));
+		h->nb_inline_keys = 0;
+		__hash_rw_writer_unlock(h);
+		return;
+	}
+
 	memset(h->buckets, 0, h->num_buckets * sizeof(struct rte_hash_bucket));
-	memset(h->key_store, 0, h->key_entry_size * (h->entries + 1));
+	if (h->resizable) {
+		struct rte_hash_bkt_tbl *tbl = h->bkt_tbl;
+
+		/* Drop the buckets being migrated, no reader uses them */
+		if (h->old_buckets != NULL) {
+			rte_free(h->old_buckets);
+			tbl->old_buckets = NULL;
+			tbl->old_bucket_bitmask = 0;
+			bkt_tbl_free(h->next_bkt_tbl);
+			h->next_bkt_tbl = NULL;
+			h->old_buckets = NULL;
+			h->old_num_buckets = 0;
+			h->migrate_idx = 0;
+		}
+		bkt_tbl_free(h->retired_bkt_tbl);
+		h->retired_bkt_tbl = NULL;
+
+		memset(h->key_store, 0, h->key_entry_size *
+				((size_t)key_seg_start(h, 1) + 1));
+		for (i = 1; i < h->nb_key_segs; i++)
+			memset(key_seg_mem(h, i), 0, (size_t)h->key_entry_size *
+					key_seg_start(h, i));
+	} else
+		memset(h->key_store, 0, h->key_entry_size * (h->entries + 1));
 	*h->tbl_chng_cnt = 0;
 
 	/* reset the free ring */
@@ -769,12 +1004,11 @@ search_and_update(const struct rte_hash *h, void *data, const void *key,
 	struct rte_hash_bucket *bkt, uint16_t sig)
 {
 	int i;
-	struct rte_hash_key *k, *keys = h->key_store;
+	struct rte_hash_key *k;
 
 	for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
 		if (bkt->sig_current[i] == sig) {
-			k = (struct rte_hash_key *) ((char *)keys +
-					bkt->key_idx[i] * h->key_entry_size);
+			k = get_key_slot(h, bkt->key_idx[i]);
 			if (rte_hash_cmp_eq(key, k->key, h) == 0) {
 				/* The store to application data at *data
 				 * should not leak after the store to pdata
@@ -1064,16 +1298,618 @@ alloc_slot(const struct rte_hash *h, struct lcore_cache *cached_free_slots)
 			cached_free_slots->len += n_slots;
 		}
 
-		/* Get a free slot from the local cache */
-		cached_free_slots->len--;
-		slot_id = cached_free_slots->objs[cached_free_slots->len];
-	} else {
-		if (rte_ring_sc_dequeue_elem(h->free_slots, &slot_id,
-						sizeof(uint32_t)) != 0)
-			return EMPTY_SLOT;
+		/* Get a free slot from the local cache */
+		cached_free_slots->len--;
+		slot_id = cached_free_slots->objs[cached_free_slots->len];
+	} else {
+		if (rte_ring_sc_dequeue_elem(h->free_slots, &slot_id,
+						sizeof(uint32_t)) != 0)
+			return EMPTY_SLOT;
+	}
+
+	return slot_id;
+}
+
+/* Get the primary (n = 0) or secondary (n = 1) bucket of a hash in the
+ * buckets being migrated.
+ */
+static inline struct rte_hash_bucket *
+get_old_bkt(const struct rte_hash *h, hash_sig_t sig, unsigned int n)
+{
+	const uint32_t old_bitmask = h->old_num_buckets - 1;
+	uint32_t bucket_idx = sig & old_bitmask;
+
+	if (n != 0)
+		bucket_idx = (bucket_idx ^ get_short_sig(sig)) & old_bitmask;
+	return &h->old_buckets[bucket_idx];
+}
+
+/* Insert a key of the buckets being migrated into the current buckets */
+static int
+migrate_key(const struct rte_hash *h, uint32_t key_idx)
+{
+	struct rte_hash_key *k = get_key_slot(h, key_idx);
+	const hash_sig_t sig = rte_hash_hash(h, k->key);
+	const uint16_t short_sig = get_short_sig(sig);
+	const uint32_t prim_bucket_idx = get_prim_bucket_index(h, sig);
+	const uint32_t sec_bucket_idx = get_alt_bucket_index(h,
+					prim_bucket_idx, short_sig);
+	struct rte_hash_bucket *prim_bkt = &h->buckets[prim_bucket_idx];
+	struct rte_hash_bucket *sec_bkt = &h->buckets[sec_bucket_idx];
+	const void *key = k->key;
+	int32_t ret_val;
+	int ret;
+
+	ret = rte_hash_cuckoo_insert_mw(h, prim_bkt, sec_bkt, key, k->pdata,
+					short_sig, key_idx, &ret_val);
+	if (ret == -1)
+		ret = rte_hash_cuckoo_make_space_mw(h, prim_bkt, sec_bkt, key,
+				k->pdata, short_sig, prim_bucket_idx,
+				key_idx, &ret_val);
+	if (ret == -ENOSPC)
+		ret = rte_hash_cuckoo_make_space_mw(h, sec_bkt, prim_bkt, key,
+				k->pdata, short_sig, sec_bucket_idx,
+				key_idx, &ret_val);
+
+	return ret < 0 ? ret : 0;
+}
+
+/* Remove a key inserted by migrate_key() from the current buckets */
+static void
+unmigrate_key(const struct rte_hash *h, uint32_t key_idx)
+{
+	const hash_sig_t sig = rte_hash_hash(h, get_key_slot(h, key_idx)->key);
+	const uint32_t prim_bucket_idx = get_prim_bucket_index(h, sig);
+	struct rte_hash_bucket *bkt;
+	unsigned int i, n;
+
+	for (n = 0; n < 2; n++) {
+		bkt = &h->buckets[n == 0 ? prim_bucket_idx :
+			get_alt_bucket_index(h, prim_bucket_idx,
+					get_short_sig(sig))];
+		for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
+			if (bkt->key_idx[i] == key_idx) {
+				bkt->sig_current[i] = NULL_SIGNATURE;
+				rte_atomic_store_explicit(&bkt->key_idx[i],
+						EMPTY_SLOT,
+						rte_memory_order_release);
+				return;
+			}
+		}
+	}
+}
+
+/* Free the replaced bucket tables, once no reader can use them */
+static void
+free_retired_bkt_tbl(struct rte_hash *h)
+{
+	if (h->hash_rcu_cfg != NULL)
+		rte_rcu_qsbr_synchronize(h->hash_rcu_cfg->v,
+					 RTE_QSBR_THRID_INVALID);
+	else if (h->readwrite_concur_lf_support)
+		/* Without RCU, they are kept until rte_hash_free() */
+		return;
+
+	bkt_tbl_free(h->retired_bkt_tbl);
+	h->retired_bkt_tbl = NULL;
+}
+
+/*
+ * Move the keys of up to nb_bkts buckets being migrated to the current
+ * buckets. The keys of a bucket are inserted into the current buckets
+ * before being removed from the old one and, as for a cuckoo move, the
+ * lock free readers are informed in between, so that they do not miss
+ * the keys.
+ */
+static int
+migrate_buckets(struct rte_hash *h, uint32_t nb_bkts)
+{
+	struct rte_hash_bkt_tbl *tbl;
+	struct rte_hash_bucket *bkt;
+	uint32_t i, j, key_idx, moved;
+	int ret;
+
+	nb_bkts = RTE_MIN(nb_bkts, h->old_num_buckets - h->migrate_idx);
+	for (; nb_bkts != 0; nb_bkts--, h->migrate_idx++) {
+		bkt = &h->old_buckets[h->migrate_idx];
+		moved = 0;
+		for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
+			key_idx = bkt->key_idx[i];
+			if (key_idx == EMPTY_SLOT)
+				continue;
+			ret = migrate_key(h, key_idx);
+			if (ret < 0) {
+				for (j = 0; j < i; j++) {
+					if (bkt->key_idx[j] != EMPTY_SLOT)
+						unmigrate_key(h,
+							bkt->key_idx[j]);
+				}
+				HASH_LOG(ERR, "%s: cannot move the keys of bucket %u",
+					__func__, h->migrate_idx);
+				return ret;
+			}
+			moved++;
+		}
+		if (moved == 0)
+			continue;
+
+		if (h->readwrite_concur_lf_support) {
+			/* Inform the readers that the keys have moved.
+			 * Since there is one writer, load acquire on
+			 * tbl_chng_cnt is not required.
+			 */
+			rte_atomic_store_explicit(h->tbl_chng_cnt,
+					 *h->tbl_chng_cnt + 1,
+					 rte_memory_order_release);
+			/* The stores to key_idx should not move above
+			 * the store to tbl_chng_cnt.
+			 */
+			rte_atomic_thread_fence(rte_memory_order_release);
+		}
+		for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
+			bkt->sig_current[i] = NULL_SIGNATURE;
+			rte_atomic_store_explicit(&bkt->key_idx[i], EMPTY_SLOT,
+					rte_memory_order_release);
+		}
+	}
+
+	if (h->migrate_idx != h->old_num_buckets)
+		return 0;
+
+	/* All the keys are moved, stop searching the old buckets */
+	tbl = rte_atomic_load_explicit(&h->bkt_tbl, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&h->bkt_tbl, h->next_bkt_tbl,
+			rte_memory_order_release);
+	h->next_bkt_tbl = NULL;
+	h->old_buckets = NULL;
+	h->old_num_buckets = 0;
+	h->migrate_idx = 0;
+
+	/* The old buckets are freed with the table which references them */
+	tbl->next = h->retired_bkt_tbl;
+	h->retired_bkt_tbl = tbl;
+	free_retired_bkt_tbl(h);
+
+	return 0;
+}
+
+static void __hash_rcu_qsbr_dq_grow(struct rte_hash *h);
+
+/*
+ * Grow a resizable table to num_buckets buckets. The current buckets
+ * become the old buckets, whose keys are moved to the new buckets by the
+ * following adds and deletes, and the key store gets a new segment for
+ * the new key positions.
+ */
+static int
+grow(struct rte_hash *h, uint32_t num_buckets)
+{
+	const uint32_t entries = num_buckets * RTE_HASH_BUCKET_ENTRIES;
+	const uint32_t nb_key_segs = rte_log2_u32(entries) -
+					h->key_seg_shift + 1;
+	struct rte_hash_bkt_tbl *tbl = NULL, *next_tbl = NULL, *cur_tbl;
+	struct rte_hash_bucket *buckets = NULL;
+	char ring_name[RTE_RING_NAMESIZE];
+	uint32_t slots[LCORE_CACHE_SIZE];
+	struct rte_ring *r = NULL;
+	uint32_t seg, i, n;
+	void *mem;
+	int ret;
+
+	if (num_buckets <= h->num_buckets)
+		return 0;
+
+	/* Complete the previous resize first */
+	if (h->old_buckets != NULL) {
+		ret = migrate_buckets(h, UINT32_MAX);
+		if (ret < 0)
+			return ret;
+	}
+
+	for (seg = h->nb_key_segs; seg < nb_key_segs; seg++) {
+		mem = rte_zmalloc_socket(NULL, (size_t)h->key_entry_size *
+				key_seg_start(h, seg), RTE_CACHE_LINE_SIZE,
+				h->socket_id);
+		if (mem == NULL)
+			goto err;
+		h->key_segs[seg] = (uintptr_t)mem -
+			((uintptr_t)key_seg_start(h, seg) + 1) *
+			h->key_entry_size;
+	}
+
+	buckets = rte_zmalloc_socket(NULL,
+			num_buckets * sizeof(struct rte_hash_bucket),
+			RTE_CACHE_LINE_SIZE, h->socket_id);
+	tbl = rte_zmalloc_socket(NULL, sizeof(*tbl), 0, h->socket_id);
+	next_tbl = rte_zmalloc_socket(NULL, sizeof(*next_tbl), 0,
+			h->socket_id);
+	if (buckets == NULL || tbl == NULL || next_tbl == NULL)
+		goto err;
+
+	/* The ring name alternates, as both rings exist for a while */
+	if (snprintf(ring_name, sizeof(ring_name), "%s_%s",
+			strncmp(h->free_slots->name, "HT_", 3) == 0 ?
+			"HTR" : "HT", h->name) >= (int)sizeof(ring_name))
+		HASH_LOG(NOTICE, "ring name truncated to '%s'", ring_name);
+	r = rte_ring_create_elem(ring_name, sizeof(uint32_t),
+			rte_align32pow2(entries + 1), h->socket_id, 0);
+	if (r == NULL)
+		goto err;
+
+	/* Move the free key positions to the new ring, then add new ones */
+	while ((n = rte_ring_sc_dequeue_burst_elem(h->free_slots, slots,
+			sizeof(uint32_t), RTE_DIM(slots), NULL)) != 0)
+		rte_ring_sp_enqueue_bulk_elem(r, slots, sizeof(uint32_t), n,
+				NULL);
+	for (i = h->entries + 1; i <= entries; i++)
+		rte_ring_sp_enqueue_elem(r, &i, sizeof(uint32_t));
+	rte_ring_free(h->free_slots);
+	h->free_slots = r;
+	h->nb_key_segs = nb_key_segs;
+	h->entries = entries;
+
+	tbl->buckets = buckets;
+	tbl->bucket_bitmask = num_buckets - 1;
+	tbl->old_buckets = h->buckets;
+	tbl->old_bucket_bitmask = h->bucket_bitmask;
+	next_tbl->buckets = buckets;
+	next_tbl->bucket_bitmask = num_buckets - 1;
+	h->next_bkt_tbl = next_tbl;
+
+	h->old_buckets = h->buckets;
+	h->old_num_buckets = h->num_buckets;
+	h->migrate_idx = 0;
+	h->buckets = buckets;
+	h->num_buckets = num_buckets;
+	h->bucket_bitmask = num_buckets - 1;
+
+	/* Lock free readers search the new buckets, then the old ones */
+	cur_tbl = rte_atomic_load_explicit(&h->bkt_tbl,
+			rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&h->bkt_tbl, tbl, rte_memory_order_release);
+	cur_tbl->next = h->retired_bkt_tbl;
+	h->retired_bkt_tbl = cur_tbl;
+
+	__hash_rcu_qsbr_dq_grow(h);
+
+	return 0;
+
+err:
+	HASH_LOG(ERR, "%s: cannot grow to %u entries", __func__, entries);
+	for (i = h->nb_key_segs; i < seg; i++)
+		rte_free(key_seg_mem(h, i));
+	rte_free(buckets);
+	rte_free(tbl);
+	rte_free(next_tbl);
+	return -ENOMEM;
+}
+
+/*
+ * Double the size of a resizable table on which an add failed. Return 0
+ * if the add can be retried.
+ */
+static int
+grow_full(const struct rte_hash *h)
+{
+	/* The table geometry changes on add, although the table is const */
+	struct rte_hash *wh = RTE_CAST_PTR(struct rte_hash *, h);
+
+	if (!h->resizable || h->num_buckets >
+			RTE_HASH_ENTRIES_MAX / RTE_HASH_BUCKET_ENTRIES / 2)
+		return -ENOSPC;
+
+	/* Failing to insert a key in a table which is mostly empty is due
+	 * to colliding keys, and growing the table would not help.
+	 */
+	if ((uint32_t)rte_hash_count(h) < h->entries / 2)
+		return -ENOSPC;
+
+	return grow(wh, h->num_buckets * 2);
+}
+
+/*
+ * Key inline tables store the keys and their data in the buckets, two
+ * entries per cache line. The position of a key is the index of its entry
+ * in the buckets.
+ */
+static inline int32_t
+inline_position(const struct rte_hash *h,
+		const struct rte_hash_inline_bucket *bkt, unsigned int i)
+{
+	return (bkt - h->inline_buckets) * RTE_HASH_INLINE_BUCKET_ENTRIES + i;
+}
+
+/* Search a key in a bucket of a key inline table, return its entry or -1 */
+static inline int
+inline_search_bucket(const struct rte_hash *h,
+		const struct rte_hash_inline_bucket *bkt,
+		const void *key, uint16_t sig)
+{
+	unsigned int i;
+
+	for (i = 0; i < RTE_HASH_INLINE_BUCKET_ENTRIES; i++) {
+		if ((bkt->used & RTE_BIT32(i)) && bkt->sig_current[i] == sig &&
+				rte_hash_cmp_eq(key, bkt->entry[i].key, h) == 0)
+			return i;
+	}
+	return -1;
+}
+
+/* Get a free entry of a bucket of a key inline table, or -1 */
+static inline int
+inline_free_entry(const struct rte_hash_inline_bucket *bkt)
+{
+	unsigned int free = ~bkt->used &
+			RTE_GENMASK32(RTE_HASH_INLINE_BUCKET_ENTRIES - 1, 0);
+
+	return free == 0 ? -1 : (int)rte_ctz32(free);
+}
+
+static inline void
+inline_move_entry(struct rte_hash_inline_bucket *dst, unsigned int dst_i,
+		struct rte_hash_inline_bucket *src, unsigned int src_i)
+{
+	dst->sig_current[dst_i] = src->sig_current[src_i];
+	dst->entry[dst_i] = src->entry[src_i];
+	dst->used |= RTE_BIT32(dst_i);
+	src->used &= ~RTE_BIT32(src_i);
+}
+
+struct inline_queue_node {
+	uint32_t bkt_idx;	/* Bucket on the bfs search */
+	int32_t prev;		/* Parent node in search path, or -1 */
+	uint32_t prev_slot;	/* Parent slot in search path */
+};
+
+/*
+ * Make space in the full primary or secondary bucket of a key inline
+ * table, displacing keys to their alternative buckets along the shortest
+ * path found by a breadth-first search. Return the bucket with a free
+ * entry and set the entry, or return NULL if no path was found.
+ */
+static struct rte_hash_inline_bucket *
+inline_make_space(const struct rte_hash *h, uint32_t prim_bkt_idx,
+		uint32_t sec_bkt_idx, int *free_entry)
+{
+	struct inline_queue_node queue[RTE_HASH_BFS_QUEUE_MAX_LEN];
+	struct rte_hash_inline_bucket *bkt, *prev_bkt;
+	const struct inline_queue_node *node;
+	uint32_t head = 0, tail = 0;
+	unsigned int i;
+	int entry;
+
+	queue[tail++] = (struct inline_queue_node){ prim_bkt_idx, -1, 0 };
+	queue[tail++] = (struct inline_queue_node){ sec_bkt_idx, -1, 0 };
+
+	while (head < tail) {
+		node = &queue[head];
+		bkt = &h->inline_buckets[node->bkt_idx];
+		entry = inline_free_entry(bkt);
+		if (entry >= 0)
+			break;
+		if (tail + RTE_HASH_INLINE_BUCKET_ENTRIES >
+				RTE_HASH_BFS_QUEUE_MAX_LEN)
+			return NULL;
+		for (i = 0; i < RTE_HASH_INLINE_BUCKET_ENTRIES; i++)
+			queue[tail++] = (struct inline_queue_node){
+				get_alt_bucket_index(h, node->bkt_idx,
+						bkt->sig_current[i]),
+				head, i };
+		head++;
+	}
+	if (head == tail)
+		return NULL;
+
+	/*
+	 * Move the keys along the path, from the bucket with a free entry.
+	 * A bucket may appear several times in the path, so check that the
+	 * key to move still has the next bucket as alternative: the keys
+	 * moved so far are in valid buckets if the path is given up.
+	 */
+	while (node->prev >= 0) {
+		prev_bkt = &h->inline_buckets[queue[node->prev].bkt_idx];
+		if (get_alt_bucket_index(h, queue[node->prev].bkt_idx,
+				prev_bkt->sig_current[node->prev_slot]) !=
+				node->bkt_idx)
+			return NULL;
+		inline_move_entry(bkt, entry, prev_bkt, node->prev_slot);
+		entry = node->prev_slot;
+		bkt = prev_bkt;
+		node = &queue[node->prev];
+	}
+
+	*free_entry = entry;
+	return bkt;
+}
+
+static int32_t
+__rte_hash_inline_add(const struct rte_hash *h, const void *key,
+		hash_sig_t sig, void *data)
+{
+	struct rte_hash_inline_bucket *prim_bkt, *sec_bkt, *bkt;
+	uint32_t prim_bucket_idx, sec_bucket_idx;
+	uint16_t short_sig;
+	int32_t ret;
+	int entry;
+
+	short_sig = get_short_sig(sig);
+	prim_bucket_idx = get_prim_bucket_index(h, sig);
+	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
+	prim_bkt = &h->inline_buckets[prim_bucket_idx];
+	sec_bkt = &h->inline_buckets[sec_bucket_idx];
+	rte_prefetch0(prim_bkt);
+	rte_prefetch0(sec_bkt);
+
+	__hash_rw_writer_lock(h);
+
+	/* Update the data of an existing key */
+	bkt = prim_bkt;
+	entry = inline_search_bucket(h, bkt, key, short_sig);
+	if (entry < 0) {
+		bkt = sec_bkt;
+		entry = inline_search_bucket(h, bkt, key, short_sig);
+	}
+	if (entry >= 0) {
+		bkt->entry[entry].pdata = data;
+		ret = inline_position(h, bkt, entry);
+		goto exit;
+	}
+
+	bkt = prim_bkt;
+	entry = inline_free_entry(bkt);
+	if (entry < 0) {
+		bkt = sec_bkt;
+		entry = inline_free_entry(bkt);
+	}
+	if (entry < 0) {
+		bkt = inline_make_space(h, prim_bucket_idx, sec_bucket_idx,
+				&entry);
+		if (bkt == NULL) {
+			ret = -ENOSPC;
+			goto exit;
+		}
+	}
+
+	bkt->sig_current[entry] = short_sig;
+	memcpy(bkt->entry[entry].key, key, h->key_len);
+	bkt->entry[entry].pdata = data;
+	bkt->used |= RTE_BIT32(entry);
+	RTE_CAST_PTR(struct rte_hash *, h)->nb_inline_keys++;
+	ret = inline_position(h, bkt, entry);
+
+exit:
+	__hash_rw_writer_unlock(h);
+	return ret;
+}
+
+static int32_t
+__rte_hash_inline_lookup(const struct rte_hash *h, const void *key,
+		hash_sig_t sig, void **data)
+{
+	const struct rte_hash_inline_bucket *bkt;
+	uint32_t prim_bucket_idx;
+	uint16_t short_sig;
+	int32_t ret = -ENOENT;
+	int entry;
+
+	short_sig = get_short_sig(sig);
+	prim_bucket_idx = get_prim_bucket_index(h, sig);
+
+	__hash_rw_reader_lock(h);
+
+	bkt = &h->inline_buckets[prim_bucket_idx];
+	entry = inline_search_bucket(h, bkt, key, short_sig);
+	if (entry < 0) {
+		bkt = &h->inline_buckets[get_alt_bucket_index(h,
+				prim_bucket_idx, short_sig)];
+		entry = inline_search_bucket(h, bkt, key, short_sig);
+	}
+	if (entry >= 0) {
+		if (data != NULL)
+			*data = bkt->entry[entry].pdata;
+		ret = inline_position(h, bkt, entry);
+	}
+
+	__hash_rw_reader_unlock(h);
+	return ret;
+}
+
+static int32_t
+__rte_hash_inline_del(const struct rte_hash *h, const void *key,
+		hash_sig_t sig)
+{
+	struct rte_hash_inline_bucket *bkt;
+	uint32_t prim_bucket_idx;
+	uint16_t short_sig;
+	int32_t ret = -ENOENT;
+	int entry;
+
+	short_sig = get_short_sig(sig);
+	prim_bucket_idx = get_prim_bucket_index(h, sig);
+
+	__hash_rw_writer_lock(h);
+
+	bkt = &h->inline_buckets[prim_bucket_idx];
+	entry = inline_search_bucket(h, bkt, key, short_sig);
+	if (entry < 0) {
+		bkt = &h->inline_buckets[get_alt_bucket_index(h,
+				prim_bucket_idx, short_sig)];
+		entry = inline_search_bucket(h, bkt, key, short_sig);
+	}
+	if (entry >= 0) {
+		bkt->used &= ~RTE_BIT32(entry);
+		RTE_CAST_PTR(struct rte_hash *, h)->nb_inline_keys--;
+		ret = inline_position(h, bkt, entry);
+	}
+
+	__hash_rw_writer_unlock(h);
+	return ret;
+}
+
+/*
+ * Bulk lookup in a key inline table. The primary buckets are searched
+ * first, and the secondary buckets are only read for the keys which are
+ * not in their primary bucket, so that most positive lookups read a
+ * single cache line.
+ */
+static void
+__rte_hash_inline_lookup_bulk(const struct rte_hash *h, const void **keys,
+		const hash_sig_t *prim_hash, int32_t num_keys,
+		int32_t *positions, uint64_t *hit_mask, void *data[])
+{
+	const struct rte_hash_inline_bucket *bkt[RTE_HASH_LOOKUP_BULK_MAX];
+	uint16_t sig[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t bkt_idx[RTE_HASH_LOOKUP_BULK_MAX];
+	uint64_t hits = 0, misses = 0;
+	hash_sig_t hash;
+	int32_t i;
+	int entry;
+
+	for (i = 0; i < num_keys; i++) {
+		hash = prim_hash != NULL ? prim_hash[i] :
+				rte_hash_hash(h, keys[i]);
+		sig[i] = get_short_sig(hash);
+		bkt_idx[i] = get_prim_bucket_index(h, hash);
+		bkt[i] = &h->inline_buckets[bkt_idx[i]];
+		rte_prefetch0(bkt[i]);
+	}
+
+	__hash_rw_reader_lock(h);
+
+	/* Search the primary buckets, prefetch the secondary ones of misses */
+	for (i = 0; i < num_keys; i++) {
+		entry = inline_search_bucket(h, bkt[i], keys[i], sig[i]);
+		if (entry >= 0) {
+			positions[i] = inline_position(h, bkt[i], entry);
+			if (data != NULL)
+				data[i] = bkt[i]->entry[entry].pdata;
+			hits |= 1ULL << i;
+			continue;
+		}
+		bkt[i] = &h->inline_buckets[get_alt_bucket_index(h,
+				bkt_idx[i], sig[i])];
+		rte_prefetch0(bkt[i]);
+		misses |= 1ULL << i;
+	}
+
+	/* Search the secondary buckets */
+	while (misses != 0) {
+		i = rte_ctz64(misses);
+		misses &= misses - 1;
+		entry = inline_search_bucket(h, bkt[i], keys[i], sig[i]);
+		if (entry >= 0) {
+			positions[i] = inline_position(h, bkt[i], entry);
+			if (data != NULL)
+				data[i] = bkt[i]->entry[entry].pdata;
+			hits |= 1ULL << i;
+		} else
+			positions[i] = -ENOENT;
 	}
 
-	return slot_id;
+	__hash_rw_reader_unlock(h);
+
+	if (hit_mask != NULL)
+		*hit_mask = hits;
 }
 
 static inline int32_t
@@ -1083,7 +1919,7 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	uint16_t short_sig;
 	uint32_t prim_bucket_idx, sec_bucket_idx;
 	struct rte_hash_bucket *prim_bkt, *sec_bkt, *cur_bkt;
-	struct rte_hash_key *new_k, *keys = h->key_store;
+	struct rte_hash_key *new_k;
 	uint32_t ext_bkt_id = 0;
 	uint32_t slot_id;
 	int ret;
@@ -1093,6 +1929,14 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	int32_t ret_val;
 	struct rte_hash_bucket *last;
 
+	if (h->key_inline)
+		return __rte_hash_inline_add(h, key, sig, data);
+
+	/* Move some keys of the table being resized */
+	if (h->old_buckets != NULL)
+		migrate_buckets(RTE_CAST_PTR(struct rte_hash *, h),
+				RTE_HASH_RESIZE_STEP);
+
 	short_sig = get_short_sig(sig);
 	prim_bucket_idx = get_prim_bucket_index(h, sig);
 	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
@@ -1118,6 +1962,19 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 		}
 	}
 
+	/* Check if key is in the buckets being migrated */
+	if (h->old_buckets != NULL) {
+		ret = search_and_update(h, data, key, get_old_bkt(h, sig, 0),
+					short_sig);
+		if (ret == -1)
+			ret = search_and_update(h, data, key,
+					get_old_bkt(h, sig, 1), short_sig);
+		if (ret != -1) {
+			__hash_rw_writer_unlock(h);
+			return ret;
+		}
+	}
+
 	__hash_rw_writer_unlock(h);
 
 	/* Did not find a match, so get a new slot for storing the new key */
@@ -1136,11 +1993,15 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 			if (ret == 0)
 				slot_id = alloc_slot(h, cached_free_slots);
 		}
-		if (slot_id == EMPTY_SLOT)
+		if (slot_id == EMPTY_SLOT) {
+			if (h->resizable && grow_full(h) == 0)
+				return __rte_hash_add_key_with_hash(h, key,
+								    sig, data);
 			return -ENOSPC;
+		}
 	}
 
-	new_k = RTE_PTR_ADD(keys, slot_id * h->key_entry_size);
+	new_k = get_key_slot(h, slot_id);
 	/* The store to application data (by the application) at *data should
 	 * not leak after the store of pdata in the key store. i.e. pdata is
 	 * the guard variable. Release the application data to the readers.
@@ -1185,6 +2046,8 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	/* if ext table not enabled, we failed the insertion */
 	if (!h->ext_table_support) {
 		enqueue_slot_back(h, cached_free_slots, slot_id);
+		if (h->resizable && grow_full(h) == 0)
+			return __rte_hash_add_key_with_hash(h, key, sig, data);
 		return ret;
 	}
 
@@ -1269,13 +2132,25 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 
 }
 
+/* Add a key, recording the time of the add if aging is enabled */
+static inline int32_t
+__rte_hash_add_key(const struct rte_hash *h, const void *key,
+		hash_sig_t sig, void *data)
+{
+	int32_t ret = __rte_hash_add_key_with_hash(h, key, sig, data);
+
+	if (h->age_ts != NULL && ret >= 0)
+		age_touch(h, ret, rte_get_tsc_cycles());
+	return ret;
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_add_key_with_hash)
 int32_t
 rte_hash_add_key_with_hash(const struct rte_hash *h,
 			const void *key, hash_sig_t sig)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
-	return __rte_hash_add_key_with_hash(h, key, sig, 0);
+	return __rte_hash_add_key(h, key, sig, 0);
 }
 
 RTE_EXPORT_SYMBOL(rte_hash_add_key)
@@ -1283,7 +2158,7 @@ int32_t
 rte_hash_add_key(const struct rte_hash *h, const void *key)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
-	return __rte_hash_add_key_with_hash(h, key, rte_hash_hash(h, key), 0);
+	return __rte_hash_add_key(h, key, rte_hash_hash(h, key), 0);
 }
 
 RTE_EXPORT_SYMBOL(rte_hash_add_key_with_hash_data)
@@ -1294,7 +2169,7 @@ rte_hash_add_key_with_hash_data(const struct rte_hash *h,
 	int ret;
 
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
-	ret = __rte_hash_add_key_with_hash(h, key, sig, data);
+	ret = __rte_hash_add_key(h, key, sig, data);
 	if (ret >= 0)
 		return 0;
 	else
@@ -1309,7 +2184,7 @@ rte_hash_add_key_data(const struct rte_hash *h, const void *key, void *data)
 
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
 
-	ret = __rte_hash_add_key_with_hash(h, key, rte_hash_hash(h, key), data);
+	ret = __rte_hash_add_key(h, key, rte_hash_hash(h, key), data);
 	if (ret >= 0)
 		return 0;
 	else
@@ -1323,13 +2198,12 @@ search_one_bucket_l(const struct rte_hash *h, const void *key,
 		const struct rte_hash_bucket *bkt)
 {
 	int i;
-	struct rte_hash_key *k, *keys = h->key_store;
+	struct rte_hash_key *k;
 
 	for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
 		if (bkt->sig_current[i] == sig &&
 				bkt->key_idx[i] != EMPTY_SLOT) {
-			k = (struct rte_hash_key *) ((char *)keys +
-					bkt->key_idx[i] * h->key_entry_size);
+			k = get_key_slot(h, bkt->key_idx[i]);
 
 			if (rte_hash_cmp_eq(key, k->key, h) == 0) {
 				if (data != NULL)
@@ -1352,7 +2226,7 @@ search_one_bucket_lf(const struct rte_hash *h, const void *key, uint16_t sig,
 {
 	int i;
 	uint32_t key_idx;
-	struct rte_hash_key *k, *keys = h->key_store;
+	struct rte_hash_key *k;
 
 	for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
 		/* Signature comparison is done before the acquire-load
@@ -1366,8 +2240,7 @@ search_one_bucket_lf(const struct rte_hash *h, const void *key, uint16_t sig,
 			key_idx = rte_atomic_load_explicit(&bkt->key_idx[i],
 					  rte_memory_order_acquire);
 			if (key_idx != EMPTY_SLOT) {
-				k = (struct rte_hash_key *) ((char *)keys +
-						key_idx * h->key_entry_size);
+				k = get_key_slot(h, key_idx);
 
 				if (rte_hash_cmp_eq(key, k->key, h) == 0) {
 					if (data != NULL) {
@@ -1423,6 +2296,19 @@ __rte_hash_lookup_with_hash_l(const struct rte_hash *h, const void *key,
 		}
 	}
 
+	/* Check if key is in the buckets being migrated */
+	if (unlikely(h->old_buckets != NULL)) {
+		ret = search_one_bucket_l(h, key, short_sig, data,
+					get_old_bkt(h, sig, 0));
+		if (ret == -1)
+			ret = search_one_bucket_l(h, key, short_sig, data,
+					get_old_bkt(h, sig, 1));
+		if (ret != -1) {
+			__hash_rw_reader_unlock(h);
+			return ret;
+		}
+	}
+
 	__hash_rw_reader_unlock(h);
 
 	return -ENOENT;
@@ -1485,23 +2371,106 @@ __rte_hash_lookup_with_hash_lf(const struct rte_hash *h, const void *key,
 	return -ENOENT;
 }
 
+/* Search the primary and secondary buckets of a key */
+static inline int32_t
+search_bkt_pair_lf(const struct rte_hash *h, const void *key, hash_sig_t sig,
+		void **data, const struct rte_hash_bucket *buckets,
+		uint32_t bucket_bitmask)
+{
+	const uint16_t short_sig = get_short_sig(sig);
+	const uint32_t prim_bucket_idx = sig & bucket_bitmask;
+	const uint32_t sec_bucket_idx = (prim_bucket_idx ^ short_sig) &
+						bucket_bitmask;
+	int32_t ret;
+
+	ret = search_one_bucket_lf(h, key, short_sig, data,
+				&buckets[prim_bucket_idx]);
+	if (ret != -1)
+		return ret;
+	return search_one_bucket_lf(h, key, short_sig, data,
+				&buckets[sec_bucket_idx]);
+}
+
+static inline int32_t
+__rte_hash_lookup_with_hash_resizable_lf(const struct rte_hash *h,
+		const void *key, hash_sig_t sig, void **data)
+{
+	const struct rte_hash_bkt_tbl *tbl;
+	uint32_t cnt_b, cnt_a;
+	int32_t ret;
+
+	do {
+		/* Load the table change counter before the buckets, so
+		 * that keys moved from the buckets loaded are detected.
+		 */
+		cnt_b = rte_atomic_load_explicit(h->tbl_chng_cnt,
+				rte_memory_order_acquire);
+		tbl = rte_atomic_load_explicit(&h->bkt_tbl,
+				rte_memory_order_acquire);
+
+		ret = search_bkt_pair_lf(h, key, sig, data, tbl->buckets,
+				tbl->bucket_bitmask);
+		if (ret != -1)
+			return ret;
+
+		/* Check if key is in the buckets being migrated */
+		if (tbl->old_buckets != NULL) {
+			ret = search_bkt_pair_lf(h, key, sig, data,
+					tbl->old_buckets,
+					tbl->old_bucket_bitmask);
+			if (ret != -1)
+				return ret;
+		}
+
+		/* The loads of sig_current in search_one_bucket
+		 * should not move below the load from tbl_chng_cnt.
+		 */
+		rte_atomic_thread_fence(rte_memory_order_acquire);
+		/* Re-read the table change counter to check if the
+		 * table has changed during search. If yes, re-do
+		 * the search.
+		 */
+		cnt_a = rte_atomic_load_explicit(h->tbl_chng_cnt,
+					rte_memory_order_acquire);
+	} while (cnt_b != cnt_a);
+
+	return -ENOENT;
+}
+
 static inline int32_t
 __rte_hash_lookup_with_hash(const struct rte_hash *h, const void *key,
 					hash_sig_t sig, void **data)
 {
-	if (h->readwrite_concur_lf_support)
+	if (h->key_inline)
+		return __rte_hash_inline_lookup(h, key, sig, data);
+	if (h->readwrite_concur_lf_support) {
+		if (h->resizable)
+			return __rte_hash_lookup_with_hash_resizable_lf(h, key,
+							sig, data);
 		return __rte_hash_lookup_with_hash_lf(h, key, sig, data);
-	else
+	} else
 		return __rte_hash_lookup_with_hash_l(h, key, sig, data);
 }
 
+/* Look up a key, recording the time of the lookup if aging is enabled */
+static inline int32_t
+__rte_hash_lookup(const struct rte_hash *h, const void *key,
+		hash_sig_t sig, void **data)
+{
+	int32_t ret = __rte_hash_lookup_with_hash(h, key, sig, data);
+
+	if (h->age_ts != NULL && ret >= 0)
+		age_touch(h, ret, rte_get_tsc_cycles());
+	return ret;
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_lookup_with_hash)
 int32_t
 rte_hash_lookup_with_hash(const struct rte_hash *h,
 			const void *key, hash_sig_t sig)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
-	return __rte_hash_lookup_with_hash(h, key, sig, NULL);
+	return __rte_hash_lookup(h, key, sig, NULL);
 }
 
 RTE_EXPORT_SYMBOL(rte_hash_lookup)
@@ -1509,7 +2478,7 @@ int32_t
 rte_hash_lookup(const struct rte_hash *h, const void *key)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
-	return __rte_hash_lookup_with_hash(h, key, rte_hash_hash(h, key), NULL);
+	return __rte_hash_lookup(h, key, rte_hash_hash(h, key), NULL);
 }
 
 RTE_EXPORT_SYMBOL(rte_hash_lookup_with_hash_data)
@@ -1518,7 +2487,7 @@ rte_hash_lookup_with_hash_data(const struct rte_hash *h,
 			const void *key, hash_sig_t sig, void **data)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
-	return __rte_hash_lookup_with_hash(h, key, sig, data);
+	return __rte_hash_lookup(h, key, sig, data);
 }
 
 RTE_EXPORT_SYMBOL(rte_hash_lookup_data)
@@ -1526,7 +2495,7 @@ int
 rte_hash_lookup_data(const struct rte_hash *h, const void *key, void **data)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
-	return __rte_hash_lookup_with_hash(h, key, rte_hash_hash(h, key), data);
+	return __rte_hash_lookup(h, key, rte_hash_hash(h, key), data);
 }
 
 static int
@@ -1560,16 +2529,14 @@ __hash_rcu_qsbr_free_resource(void *p, void *e, unsigned int n)
 {
 	void *key_data = NULL;
 	int ret;
-	struct rte_hash_key *keys, *k;
+	struct rte_hash_key *k;
 	struct rte_hash *h = (struct rte_hash *)p;
 	struct __rte_hash_rcu_dq_entry rcu_dq_entry =
 			*((struct __rte_hash_rcu_dq_entry *)e);
 
 	RTE_SET_USED(n);
-	keys = h->key_store;
 
-	k = (struct rte_hash_key *) ((char *)keys +
-				rcu_dq_entry.key_idx * h->key_entry_size);
+	k = get_key_slot(h, rcu_dq_entry.key_idx);
 	key_data = k->pdata;
 	if (h->hash_rcu_cfg->free_key_data_func)
 		h->hash_rcu_cfg->free_key_data_func(h->hash_rcu_cfg->key_data_ptr,
@@ -1602,6 +2569,12 @@ rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg)
 		return 1;
 	}
 
+	/* A key inline table has no key store slots to reclaim */
+	if (h->key_inline) {
+		rte_errno = ENOTSUP;
+		return 1;
+	}
+
 	const uint32_t total_entries = h->use_local_cache ?
 		h->entries + (RTE_MAX_LCORE - 1) * (LCORE_CACHE_SIZE - 1) + 1
 							: h->entries + 1;
@@ -1662,6 +2635,48 @@ rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg)
 	return 0;
 }
 
+/*
+ * Recreate the defer queue of a table which has grown, if the queue is too
+ * small to hold all its key positions.
+ */
+static void
+__hash_rcu_qsbr_dq_grow(struct rte_hash *h)
+{
+	struct rte_hash_rcu_config *hash_rcu_cfg = h->hash_rcu_cfg;
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+
+	if (h->dq == NULL || hash_rcu_cfg->dq_size > h->entries)
+		return;
+
+	/* Reclaim all the deleted keys, then replace the queue */
+	rte_rcu_qsbr_synchronize(hash_rcu_cfg->v, RTE_QSBR_THRID_INVALID);
+	if (rte_rcu_qsbr_dq_delete(h->dq) != 0) {
+		HASH_LOG(ERR, "%s: could not delete the defer queue", __func__);
+		return;
+	}
+
+	if (snprintf(rcu_dq_name, sizeof(rcu_dq_name), "HASH_RCU_%s", h->name)
+			>= (int)sizeof(rcu_dq_name))
+		HASH_LOG(NOTICE, "HASH defer queue name truncated to: %s", rcu_dq_name);
+	params.name = rcu_dq_name;
+	params.size = h->entries + 1;
+	params.trigger_reclaim_limit = hash_rcu_cfg->trigger_reclaim_limit;
+	params.max_reclaim_size = hash_rcu_cfg->max_reclaim_size;
+	params.esize = sizeof(struct __rte_hash_rcu_dq_entry);
+	params.free_fn = __hash_rcu_qsbr_free_resource;
+	params.p = h;
+	params.v = hash_rcu_cfg->v;
+	h->dq = rte_rcu_qsbr_dq_create(&params);
+	if (h->dq == NULL) {
+		/* Deleted keys are then freed as in sync mode */
+		HASH_LOG(ERR, "HASH defer queue creation failed: %s",
+			rte_strerror(rte_errno));
+		return;
+	}
+	hash_rcu_cfg->dq_size = params.size;
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_rcu_qsbr_dq_reclaim, 24.07)
 int rte_hash_rcu_qsbr_dq_reclaim(struct rte_hash *h, unsigned int *freed, unsigned int *pending,
 				 unsigned int *available)
@@ -1747,7 +2762,7 @@ static inline int32_t
 search_and_remove(const struct rte_hash *h, const void *key,
 			struct rte_hash_bucket *bkt, uint16_t sig, int *pos)
 {
-	struct rte_hash_key *k, *keys = h->key_store;
+	struct rte_hash_key *k;
 	unsigned int i;
 	uint32_t key_idx;
 
@@ -1756,8 +2771,7 @@ search_and_remove(const struct rte_hash *h, const void *key,
 		key_idx = rte_atomic_load_explicit(&bkt->key_idx[i],
 					  rte_memory_order_acquire);
 		if (bkt->sig_current[i] == sig && key_idx != EMPTY_SLOT) {
-			k = (struct rte_hash_key *) ((char *)keys +
-					key_idx * h->key_entry_size);
+			k = get_key_slot(h, key_idx);
 			if (rte_hash_cmp_eq(key, k->key, h) == 0) {
 				bkt->sig_current[i] = NULL_SIGNATURE;
 				/* Free the key store index if
@@ -1795,6 +2809,14 @@ __rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
 	uint32_t index = EMPTY_SLOT;
 	struct __rte_hash_rcu_dq_entry rcu_dq_entry;
 
+	if (h->key_inline)
+		return __rte_hash_inline_del(h, key, sig);
+
+	/* Move some keys of the table being resized */
+	if (h->old_buckets != NULL)
+		migrate_buckets(RTE_CAST_PTR(struct rte_hash *, h),
+				RTE_HASH_RESIZE_STEP);
+
 	short_sig = get_short_sig(sig);
 	prim_bucket_idx = get_prim_bucket_index(h, sig);
 	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
@@ -1823,6 +2845,17 @@ __rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
 		}
 	}
 
+	/* Look for key in the buckets being migrated */
+	if (h->old_buckets != NULL) {
+		ret = search_and_remove(h, key, get_old_bkt(h, sig, 0),
+					short_sig, &pos);
+		if (ret == -1)
+			ret = search_and_remove(h, key, get_old_bkt(h, sig, 1),
+						short_sig, &pos);
+		if (ret != -1)
+			goto return_key;
+	}
+
 	__hash_rw_writer_unlock(h);
 	return -ENOENT;
 
@@ -1911,9 +2944,23 @@ rte_hash_get_key_with_position(const struct rte_hash *h, const int32_t position,
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
 
-	struct rte_hash_key *k, *keys = h->key_store;
-	k = (struct rte_hash_key *) ((char *) keys + (position + 1) *
-				     h->key_entry_size);
+	if (h->key_inline) {
+		struct rte_hash_inline_bucket *bkt;
+		uint32_t entry = position % RTE_HASH_INLINE_BUCKET_ENTRIES;
+
+		if (position < 0 || (uint32_t)position >=
+				h->num_buckets * RTE_HASH_INLINE_BUCKET_ENTRIES)
+			return -EINVAL;
+		bkt = &h->inline_buckets[position /
+				RTE_HASH_INLINE_BUCKET_ENTRIES];
+		*key = bkt->entry[entry].key;
+		if (!(bkt->used & RTE_BIT32(entry)))
+			return -ENOENT;
+		return 0;
+	}
+
+	struct rte_hash_key *k;
+	k = get_key_slot(h, position + 1);
 	*key = k->key;
 
 	if (position !=
@@ -1935,6 +2982,10 @@ rte_hash_free_key_with_position(const struct rte_hash *h,
 
 	RETURN_IF_TRUE(((h == NULL) || (key_idx == EMPTY_SLOT)), -EINVAL);
 
+	/* Deleted keys of a key inline table are always freed */
+	if (h->key_inline)
+		return -EINVAL;
+
 	const uint32_t total_entries = h->use_local_cache ?
 		h->entries + (RTE_MAX_LCORE - 1) * (LCORE_CACHE_SIZE - 1) + 1
 							: h->entries + 1;
@@ -1957,6 +3008,38 @@ rte_hash_free_key_with_position(const struct rte_hash *h,
 
 }
 
+/*
+ * Compare the signatures of the primary and secondary buckets of the keys,
+ * giving a dense hitmask per key: one bit per entry of the primary bucket,
+ * then one bit per entry of the secondary bucket.
+ */
+static inline void
+compare_signatures_bulk(uint16_t *hitmask_buffer,
+		const struct rte_hash_bucket **primary_bkt,
+		const struct rte_hash_bucket **secondary_bkt,
+		const uint16_t *sig, int32_t num_keys,
+		enum rte_hash_sig_compare_function sig_cmp_fn)
+{
+	int32_t i;
+
+#ifdef CC_AVX512_SUPPORT
+	/* Compare the buckets of two keys at once */
+	if (sig_cmp_fn == RTE_HASH_COMPARE_AVX512) {
+		rte_hash_compare_signatures_avx512(hitmask_buffer, primary_bkt,
+				secondary_bkt, sig, num_keys);
+		return;
+	}
+#endif
+
+	for (i = 0; i < num_keys; i++) {
+		hitmask_buffer[i] = 0;
+		compare_signatures_dense(&hitmask_buffer[i],
+			primary_bkt[i]->sig_current,
+			secondary_bkt[i]->sig_current,
+			sig[i], sig_cmp_fn);
+	}
+}
+
 static inline void
 __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 		const struct rte_hash_bucket **primary_bkt,
@@ -1969,59 +3052,38 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 	int32_t ret;
 	struct rte_hash_bucket *cur_bkt, *next_bkt;
 
-#if DENSE_HASH_BULK_LOOKUP
-	const int hitmask_padding = 0;
-	uint16_t hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX] = {0};
-#else
-	const int hitmask_padding = 1;
-	uint32_t prim_hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX] = {0};
-	uint32_t sec_hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX] = {0};
-#endif
+	uint16_t hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX];
 
 	__hash_rw_reader_lock(h);
 
-	/* Compare signatures and prefetch key slot of first hit */
+	/* Compare signatures */
+	compare_signatures_bulk(hitmask_buffer, primary_bkt, secondary_bkt,
+			sig, num_keys, h->sig_cmp_fn);
+
+	/* Prefetch key slot of first hit */
 	for (i = 0; i < num_keys; i++) {
-#if DENSE_HASH_BULK_LOOKUP
 		uint16_t *hitmask = &hitmask_buffer[i];
-		compare_signatures_dense(hitmask,
-			primary_bkt[i]->sig_current,
-			secondary_bkt[i]->sig_current,
-			sig[i], h->sig_cmp_fn);
 		const unsigned int prim_hitmask = *(uint8_t *)(hitmask);
 		const unsigned int sec_hitmask = *((uint8_t *)(hitmask)+1);
-#else
-		compare_signatures_sparse(&prim_hitmask_buffer[i], &sec_hitmask_buffer[i],
-			primary_bkt[i], secondary_bkt[i],
-			sig[i], h->sig_cmp_fn);
-		const unsigned int prim_hitmask = prim_hitmask_buffer[i];
-		const unsigned int sec_hitmask = sec_hitmask_buffer[i];
-#endif
 
 		if (prim_hitmask) {
 			uint32_t first_hit =
-					rte_ctz32(prim_hitmask)
-					>> hitmask_padding;
+					rte_ctz32(prim_hitmask);
 			uint32_t key_idx =
 				primary_bkt[i]->key_idx[first_hit];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				get_key_slot(h, key_idx);
 			rte_prefetch0(key_slot);
 			continue;
 		}
 
 		if (sec_hitmask) {
 			uint32_t first_hit =
-					rte_ctz32(sec_hitmask)
-					>> hitmask_padding;
+					rte_ctz32(sec_hitmask);
 			uint32_t key_idx =
 				secondary_bkt[i]->key_idx[first_hit];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				get_key_slot(h, key_idx);
 			rte_prefetch0(key_slot);
 		}
 	}
@@ -2029,24 +3091,16 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 	/* Compare keys, first hits in primary first */
 	for (i = 0; i < num_keys; i++) {
 		positions[i] = -ENOENT;
-#if DENSE_HASH_BULK_LOOKUP
 		uint16_t *hitmask = &hitmask_buffer[i];
 		unsigned int prim_hitmask = *(uint8_t *)(hitmask);
 		unsigned int sec_hitmask = *((uint8_t *)(hitmask)+1);
-#else
-		unsigned int prim_hitmask = prim_hitmask_buffer[i];
-		unsigned int sec_hitmask = sec_hitmask_buffer[i];
-#endif
 		while (prim_hitmask) {
 			uint32_t hit_index =
-					rte_ctz32(prim_hitmask)
-					>> hitmask_padding;
+					rte_ctz32(prim_hitmask);
 			uint32_t key_idx =
 				primary_bkt[i]->key_idx[hit_index];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				get_key_slot(h, key_idx);
 
 			/*
 			 * If key index is 0, do not compare key,
@@ -2062,19 +3116,16 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 				positions[i] = key_idx - 1;
 				goto next_key;
 			}
-			prim_hitmask &= ~(1 << (hit_index << hitmask_padding));
+			prim_hitmask &= ~(1 << hit_index);
 		}
 
 		while (sec_hitmask) {
 			uint32_t hit_index =
-					rte_ctz32(sec_hitmask)
-					>> hitmask_padding;
+					rte_ctz32(sec_hitmask);
 			uint32_t key_idx =
 				secondary_bkt[i]->key_idx[hit_index];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				get_key_slot(h, key_idx);
 
 			/*
 			 * If key index is 0, do not compare key,
@@ -2091,7 +3142,7 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 				positions[i] = key_idx - 1;
 				goto next_key;
 			}
-			sec_hitmask &= ~(1 << (hit_index << hitmask_padding));
+			sec_hitmask &= ~(1 << hit_index);
 		}
 next_key:
 		continue;
@@ -2144,16 +3195,7 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 	struct rte_hash_bucket *cur_bkt, *next_bkt;
 	uint32_t cnt_b, cnt_a;
 
-#if DENSE_HASH_BULK_LOOKUP
-	const int hitmask_padding = 0;
-	uint16_t hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX] = {0};
-	static_assert(sizeof(*hitmask_buffer)*8/2 == RTE_HASH_BUCKET_ENTRIES,
-	"The hitmask must be exactly wide enough to accept the whole hitmask chen it is dense");
-#else
-	const int hitmask_padding = 1;
-	uint32_t prim_hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX] = {0};
-	uint32_t sec_hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX] = {0};
-#endif
+	uint16_t hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX];
 
 	for (i = 0; i < num_keys; i++)
 		positions[i] = -ENOENT;
@@ -2166,74 +3208,52 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 		cnt_b = rte_atomic_load_explicit(h->tbl_chng_cnt,
 					rte_memory_order_acquire);
 
-		/* Compare signatures and prefetch key slot of first hit */
+		/* Compare signatures */
+		compare_signatures_bulk(hitmask_buffer, primary_bkt,
+				secondary_bkt, sig, num_keys, h->sig_cmp_fn);
+
+		/* Prefetch key slot of first hit */
 		for (i = 0; i < num_keys; i++) {
-#if DENSE_HASH_BULK_LOOKUP
 			uint16_t *hitmask = &hitmask_buffer[i];
-			compare_signatures_dense(hitmask,
-				primary_bkt[i]->sig_current,
-				secondary_bkt[i]->sig_current,
-				sig[i], h->sig_cmp_fn);
 			const unsigned int prim_hitmask = *(uint8_t *)(hitmask);
 			const unsigned int sec_hitmask = *((uint8_t *)(hitmask)+1);
-#else
-			compare_signatures_sparse(&prim_hitmask_buffer[i], &sec_hitmask_buffer[i],
-				primary_bkt[i], secondary_bkt[i],
-				sig[i], h->sig_cmp_fn);
-			const unsigned int prim_hitmask = prim_hitmask_buffer[i];
-			const unsigned int sec_hitmask = sec_hitmask_buffer[i];
-#endif
 
 			if (prim_hitmask) {
 				uint32_t first_hit =
-						rte_ctz32(prim_hitmask)
-						>> hitmask_padding;
+						rte_ctz32(prim_hitmask);
 				uint32_t key_idx =
 					primary_bkt[i]->key_idx[first_hit];
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					get_key_slot(h, key_idx);
 				rte_prefetch0(key_slot);
 				continue;
 			}
 
 			if (sec_hitmask) {
 				uint32_t first_hit =
-						rte_ctz32(sec_hitmask)
-						>> hitmask_padding;
+						rte_ctz32(sec_hitmask);
 				uint32_t key_idx =
 					secondary_bkt[i]->key_idx[first_hit];
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					get_key_slot(h, key_idx);
 				rte_prefetch0(key_slot);
 			}
 		}
 
 		/* Compare keys, first hits in primary first */
 		for (i = 0; i < num_keys; i++) {
-#if DENSE_HASH_BULK_LOOKUP
 			uint16_t *hitmask = &hitmask_buffer[i];
 			unsigned int prim_hitmask = *(uint8_t *)(hitmask);
 			unsigned int sec_hitmask = *((uint8_t *)(hitmask)+1);
-#else
-			unsigned int prim_hitmask = prim_hitmask_buffer[i];
-			unsigned int sec_hitmask = sec_hitmask_buffer[i];
-#endif
 			while (prim_hitmask) {
 				uint32_t hit_index =
-						rte_ctz32(prim_hitmask)
-						>> hitmask_padding;
+						rte_ctz32(prim_hitmask);
 				uint32_t key_idx =
 				rte_atomic_load_explicit(
 					&primary_bkt[i]->key_idx[hit_index],
 					rte_memory_order_acquire);
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					get_key_slot(h, key_idx);
 
 				/*
 				 * If key index is 0, do not compare key,
@@ -2251,21 +3271,18 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 					positions[i] = key_idx - 1;
 					goto next_key;
 				}
-				prim_hitmask &= ~(1 << (hit_index << hitmask_padding));
+				prim_hitmask &= ~(1 << hit_index);
 			}
 
 			while (sec_hitmask) {
 				uint32_t hit_index =
-						rte_ctz32(sec_hitmask)
-						>> hitmask_padding;
+						rte_ctz32(sec_hitmask);
 				uint32_t key_idx =
 				rte_atomic_load_explicit(
 					&secondary_bkt[i]->key_idx[hit_index],
 					rte_memory_order_acquire);
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					get_key_slot(h, key_idx);
 
 				/*
 				 * If key index is 0, do not compare key,
@@ -2284,7 +3301,7 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 					positions[i] = key_idx - 1;
 					goto next_key;
 				}
-				sec_hitmask &= ~(1 << (hit_index << hitmask_padding));
+				sec_hitmask &= ~(1 << hit_index);
 			}
 next_key:
 			continue;
@@ -2339,9 +3356,69 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 		*hit_mask = hits;
 }
 
+/*
+ * Look up again, one by one, the keys missed by a bulk lookup of a table
+ * being resized, as they may be in the buckets being migrated.
+ */
+static inline void
+__bulk_lookup_resize_misses(const struct rte_hash *h, const void **keys,
+		const hash_sig_t *prim_hash, int32_t num_keys,
+		int32_t *positions, uint64_t *hit_mask, void *data[])
+{
+	hash_sig_t sig;
+	int32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		if (positions[i] >= 0)
+			continue;
+		sig = prim_hash != NULL ? prim_hash[i] :
+			rte_hash_hash(h, keys[i]);
+		positions[i] = __rte_hash_lookup_with_hash(h, keys[i], sig,
+				data != NULL ? &data[i] : NULL);
+		if (positions[i] >= 0 && hit_mask != NULL)
+			*hit_mask |= 1ULL << i;
+	}
+}
+
+/*
+ * Get the buckets searched by a bulk lookup. For a resizable table with
+ * lock free readers, they are given by the bucket table returned in tbl.
+ */
+static inline const struct rte_hash_bucket *
+__bulk_lookup_buckets(const struct rte_hash *h,
+		const struct rte_hash_bkt_tbl **tbl, uint32_t *bucket_bitmask)
+{
+	if (h->readwrite_concur_lf_support && h->resizable) {
+		*tbl = rte_atomic_load_explicit(&h->bkt_tbl,
+				rte_memory_order_acquire);
+		*bucket_bitmask = (*tbl)->bucket_bitmask;
+		return (*tbl)->buckets;
+	}
+
+	*tbl = NULL;
+	*bucket_bitmask = h->bucket_bitmask;
+	return h->buckets;
+}
+
+/*
+ * Check if the keys missed by a bulk lookup may have been in other
+ * buckets than the ones searched.
+ */
+static inline bool
+__bulk_lookup_resized(const struct rte_hash *h,
+		const struct rte_hash_bkt_tbl *tbl)
+{
+	if (tbl != NULL)
+		return tbl->old_buckets != NULL ||
+			tbl != rte_atomic_load_explicit(&h->bkt_tbl,
+					rte_memory_order_acquire);
+	return h->old_buckets != NULL;
+}
+
 #define PREFETCH_OFFSET 4
 static inline void
 __bulk_lookup_prefetching_loop(const struct rte_hash *h,
+	const struct rte_hash_bucket *buckets, uint32_t bucket_bitmask,
 	const void **keys, int32_t num_keys,
 	uint16_t *sig,
 	const struct rte_hash_bucket **primary_bkt,
@@ -2366,11 +3443,11 @@ __bulk_lookup_prefetching_loop(const struct rte_hash *h,
 		prim_hash[i] = rte_hash_hash(h, keys[i]);
 
 		sig[i] = get_short_sig(prim_hash[i]);
-		prim_index[i] = get_prim_bucket_index(h, prim_hash[i]);
-		sec_index[i] = get_alt_bucket_index(h, prim_index[i], sig[i]);
+		prim_index[i] = prim_hash[i] & bucket_bitmask;
+		sec_index[i] = (prim_index[i] ^ sig[i]) & bucket_bitmask;
 
-		primary_bkt[i] = &h->buckets[prim_index[i]];
-		secondary_bkt[i] = &h->buckets[sec_index[i]];
+		primary_bkt[i] = &buckets[prim_index[i]];
+		secondary_bkt[i] = &buckets[sec_index[i]];
 
 		rte_prefetch0(primary_bkt[i]);
 		rte_prefetch0(secondary_bkt[i]);
@@ -2381,11 +3458,11 @@ __bulk_lookup_prefetching_loop(const struct rte_hash *h,
 		prim_hash[i] = rte_hash_hash(h, keys[i]);
 
 		sig[i] = get_short_sig(prim_hash[i]);
-		prim_index[i] = get_prim_bucket_index(h, prim_hash[i]);
-		sec_index[i] = get_alt_bucket_index(h, prim_index[i], sig[i]);
+		prim_index[i] = prim_hash[i] & bucket_bitmask;
+		sec_index[i] = (prim_index[i] ^ sig[i]) & bucket_bitmask;
 
-		primary_bkt[i] = &h->buckets[prim_index[i]];
-		secondary_bkt[i] = &h->buckets[sec_index[i]];
+		primary_bkt[i] = &buckets[prim_index[i]];
+		secondary_bkt[i] = &buckets[sec_index[i]];
 
 		rte_prefetch0(primary_bkt[i]);
 		rte_prefetch0(secondary_bkt[i]);
@@ -2401,12 +3478,20 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 	uint16_t sig[RTE_HASH_LOOKUP_BULK_MAX];
 	const struct rte_hash_bucket *primary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
 	const struct rte_hash_bucket *secondary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
+	const struct rte_hash_bkt_tbl *tbl;
+	const struct rte_hash_bucket *buckets;
+	uint32_t bucket_bitmask;
 
-	__bulk_lookup_prefetching_loop(h, keys, num_keys, sig,
-		primary_bkt, secondary_bkt);
+	buckets = __bulk_lookup_buckets(h, &tbl, &bucket_bitmask);
+	__bulk_lookup_prefetching_loop(h, buckets, bucket_bitmask, keys,
+		num_keys, sig, primary_bkt, secondary_bkt);
 
 	__bulk_lookup_l(h, keys, primary_bkt, secondary_bkt, sig, num_keys,
 		positions, hit_mask, data);
+
+	if (unlikely(__bulk_lookup_resized(h, tbl)))
+		__bulk_lookup_resize_misses(h, keys, NULL, num_keys,
+			positions, hit_mask, data);
 }
 
 static inline void
@@ -2417,12 +3502,20 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 	uint16_t sig[RTE_HASH_LOOKUP_BULK_MAX];
 	const struct rte_hash_bucket *primary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
 	const struct rte_hash_bucket *secondary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
+	const struct rte_hash_bkt_tbl *tbl;
+	const struct rte_hash_bucket *buckets;
+	uint32_t bucket_bitmask;
 
-	__bulk_lookup_prefetching_loop(h, keys, num_keys, sig,
-		primary_bkt, secondary_bkt);
+	buckets = __bulk_lookup_buckets(h, &tbl, &bucket_bitmask);
+	__bulk_lookup_prefetching_loop(h, buckets, bucket_bitmask, keys,
+		num_keys, sig, primary_bkt, secondary_bkt);
 
 	__bulk_lookup_lf(h, keys, primary_bkt, secondary_bkt, sig, num_keys,
 		positions, hit_mask, data);
+
+	if (unlikely(__bulk_lookup_resized(h, tbl)))
+		__bulk_lookup_resize_misses(h, keys, NULL, num_keys,
+			positions, hit_mask, data);
 }
 
 static inline void
@@ -2430,12 +3523,17 @@ __rte_hash_lookup_bulk(const struct rte_hash *h, const void **keys,
 			int32_t num_keys, int32_t *positions,
 			uint64_t *hit_mask, void *data[])
 {
-	if (h->readwrite_concur_lf_support)
+	if (h->key_inline)
+		__rte_hash_inline_lookup_bulk(h, keys, NULL, num_keys,
+				positions, hit_mask, data);
+	else if (h->readwrite_concur_lf_support)
 		__rte_hash_lookup_bulk_lf(h, keys, num_keys, positions,
 					  hit_mask, data);
 	else
 		__rte_hash_lookup_bulk_l(h, keys, num_keys, positions,
 					 hit_mask, data);
+
+	age_touch_bulk(h, positions, num_keys);
 }
 
 RTE_EXPORT_SYMBOL(rte_hash_lookup_bulk)
@@ -2481,6 +3579,11 @@ __rte_hash_lookup_with_hash_bulk_l(const struct rte_hash *h,
 	uint16_t sig[RTE_HASH_LOOKUP_BULK_MAX];
 	const struct rte_hash_bucket *primary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
 	const struct rte_hash_bucket *secondary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
+	const struct rte_hash_bkt_tbl *tbl;
+	const struct rte_hash_bucket *buckets;
+	uint32_t bucket_bitmask;
+
+	buckets = __bulk_lookup_buckets(h, &tbl, &bucket_bitmask);
 
 	/*
 	 * Prefetch keys, calculate primary and
@@ -2490,11 +3593,11 @@ __rte_hash_lookup_with_hash_bulk_l(const struct rte_hash *h,
 		rte_prefetch0(keys[i]);
 
 		sig[i] = get_short_sig(prim_hash[i]);
-		prim_index[i] = get_prim_bucket_index(h, prim_hash[i]);
-		sec_index[i] = get_alt_bucket_index(h, prim_index[i], sig[i]);
+		prim_index[i] = prim_hash[i] & bucket_bitmask;
+		sec_index[i] = (prim_index[i] ^ sig[i]) & bucket_bitmask;
 
-		primary_bkt[i] = &h->buckets[prim_index[i]];
-		secondary_bkt[i] = &h->buckets[sec_index[i]];
+		primary_bkt[i] = &buckets[prim_index[i]];
+		secondary_bkt[i] = &buckets[sec_index[i]];
 
 		rte_prefetch0(primary_bkt[i]);
 		rte_prefetch0(secondary_bkt[i]);
@@ -2502,6 +3605,10 @@ __rte_hash_lookup_with_hash_bulk_l(const struct rte_hash *h,
 
 	__bulk_lookup_l(h, keys, primary_bkt, secondary_bkt, sig, num_keys,
 		positions, hit_mask, data);
+
+	if (unlikely(__bulk_lookup_resized(h, tbl)))
+		__bulk_lookup_resize_misses(h, keys, prim_hash, num_keys,
+			positions, hit_mask, data);
 }
 
 static inline void
@@ -2516,6 +3623,11 @@ __rte_hash_lookup_with_hash_bulk_lf(const struct rte_hash *h,
 	uint16_t sig[RTE_HASH_LOOKUP_BULK_MAX];
 	const struct rte_hash_bucket *primary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
 	const struct rte_hash_bucket *secondary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
+	const struct rte_hash_bkt_tbl *tbl;
+	const struct rte_hash_bucket *buckets;
+	uint32_t bucket_bitmask;
+
+	buckets = __bulk_lookup_buckets(h, &tbl, &bucket_bitmask);
 
 	/*
 	 * Prefetch keys, calculate primary and
@@ -2525,11 +3637,11 @@ __rte_hash_lookup_with_hash_bulk_lf(const struct rte_hash *h,
 		rte_prefetch0(keys[i]);
 
 		sig[i] = get_short_sig(prim_hash[i]);
-		prim_index[i] = get_prim_bucket_index(h, prim_hash[i]);
-		sec_index[i] = get_alt_bucket_index(h, prim_index[i], sig[i]);
+		prim_index[i] = prim_hash[i] & bucket_bitmask;
+		sec_index[i] = (prim_index[i] ^ sig[i]) & bucket_bitmask;
 
-		primary_bkt[i] = &h->buckets[prim_index[i]];
-		secondary_bkt[i] = &h->buckets[sec_index[i]];
+		primary_bkt[i] = &buckets[prim_index[i]];
+		secondary_bkt[i] = &buckets[sec_index[i]];
 
 		rte_prefetch0(primary_bkt[i]);
 		rte_prefetch0(secondary_bkt[i]);
@@ -2537,6 +3649,10 @@ __rte_hash_lookup_with_hash_bulk_lf(const struct rte_hash *h,
 
 	__bulk_lookup_lf(h, keys, primary_bkt, secondary_bkt, sig, num_keys,
 		positions, hit_mask, data);
+
+	if (unlikely(__bulk_lookup_resized(h, tbl)))
+		__bulk_lookup_resize_misses(h, keys, prim_hash, num_keys,
+			positions, hit_mask, data);
 }
 
 static inline void
@@ -2544,12 +3660,17 @@ __rte_hash_lookup_with_hash_bulk(const struct rte_hash *h, const void **keys,
 			hash_sig_t *prim_hash, int32_t num_keys,
 			int32_t *positions, uint64_t *hit_mask, void *data[])
 {
-	if (h->readwrite_concur_lf_support)
+	if (h->key_inline)
+		__rte_hash_inline_lookup_bulk(h, keys, prim_hash, num_keys,
+				positions, hit_mask, data);
+	else if (h->readwrite_concur_lf_support)
 		__rte_hash_lookup_with_hash_bulk_lf(h, keys, prim_hash,
 				num_keys, positions, hit_mask, data);
 	else
 		__rte_hash_lookup_with_hash_bulk_l(h, keys, prim_hash,
 				num_keys, positions, hit_mask, data);
+
+	age_touch_bulk(h, positions, num_keys);
 }
 
 RTE_EXPORT_SYMBOL(rte_hash_lookup_with_hash_bulk)
@@ -2587,6 +3708,34 @@ rte_hash_lookup_with_hash_bulk_data(const struct rte_hash *h,
 	return rte_popcount64(*hit_mask);
 }
 
+/* Iterate the entries of a key inline table, the position being next */
+static int32_t
+__rte_hash_inline_iterate(const struct rte_hash *h, const void **key,
+		void **data, uint32_t *next)
+{
+	const uint32_t total_entries = h->num_buckets *
+					RTE_HASH_INLINE_BUCKET_ENTRIES;
+	const struct rte_hash_inline_bucket *bkt;
+	uint32_t entry;
+	int32_t position;
+
+	__hash_rw_reader_lock(h);
+	for (; *next < total_entries; (*next)++) {
+		bkt = &h->inline_buckets[*next / RTE_HASH_INLINE_BUCKET_ENTRIES];
+		entry = *next % RTE_HASH_INLINE_BUCKET_ENTRIES;
+		if (bkt->used & RTE_BIT32(entry)) {
+			*key = bkt->entry[entry].key;
+			*data = bkt->entry[entry].pdata;
+			position = (*next)++;
+			__hash_rw_reader_unlock(h);
+			return position;
+		}
+	}
+	__hash_rw_reader_unlock(h);
+
+	return -ENOENT;
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_iterate)
 int32_t
 rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32_t *next)
@@ -2596,9 +3745,19 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 
 	RETURN_IF_TRUE(((h == NULL) || (next == NULL)), -EINVAL);
 
+	if (h->key_inline)
+		return __rte_hash_inline_iterate(h, key, data, next);
+
 	const uint32_t total_entries_main = h->num_buckets *
 							RTE_HASH_BUCKET_ENTRIES;
-	const uint32_t total_entries = total_entries_main << 1;
+	/* The buckets being migrated of a resizable table are iterated
+	 * after the main table, as the extendable buckets.
+	 */
+	const struct rte_hash_bucket *buckets_ext = h->resizable ?
+					h->old_buckets : h->buckets_ext;
+	const uint32_t total_entries = h->resizable ? total_entries_main +
+			h->old_num_buckets * RTE_HASH_BUCKET_ENTRIES :
+			total_entries_main << 1;
 
 	/* Out of bounds of all buckets (both main table and ext table) */
 	if (*next >= total_entries_main)
@@ -2620,8 +3779,7 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 	}
 
 	__hash_rw_reader_lock(h);
-	next_key = (struct rte_hash_key *) ((char *)h->key_store +
-				position * h->key_entry_size);
+	next_key = get_key_slot(h, position);
 	/* Return key and data */
 	*key = next_key->key;
 	*data = next_key->pdata;
@@ -2636,13 +3794,13 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 /* Begin to iterate extendable buckets */
 extend_table:
 	/* Out of total bound or if ext bucket feature is not enabled */
-	if (*next >= total_entries || !h->ext_table_support)
+	if (*next >= total_entries || buckets_ext == NULL)
 		return -ENOENT;
 
 	bucket_idx = (*next - total_entries_main) / RTE_HASH_BUCKET_ENTRIES;
 	idx = (*next - total_entries_main) % RTE_HASH_BUCKET_ENTRIES;
 
-	while ((position = h->buckets_ext[bucket_idx].key_idx[idx]) == EMPTY_SLOT) {
+	while ((position = buckets_ext[bucket_idx].key_idx[idx]) == EMPTY_SLOT) {
 		(*next)++;
 		if (*next == total_entries)
 			return -ENOENT;
@@ -2651,8 +3809,7 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 		idx = (*next - total_entries_main) % RTE_HASH_BUCKET_ENTRIES;
 	}
 	__hash_rw_reader_lock(h);
-	next_key = (struct rte_hash_key *) ((char *)h->key_store +
-				position * h->key_entry_size);
+	next_key = get_key_slot(h, position);
 	/* Return key and data */
 	*key = next_key->key;
 	*data = next_key->pdata;
@@ -2663,3 +3820,134 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 	(*next)++;
 	return position - 1;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_resize, 26.03)
+int
+rte_hash_resize(struct rte_hash *h, uint32_t entries)
+{
+	if (h == NULL || !h->resizable || entries > RTE_HASH_ENTRIES_MAX)
+		return -EINVAL;
+
+	return grow(h, rte_align32pow2(entries) / RTE_HASH_BUCKET_ENTRIES);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_resize_step, 26.03)
+int
+rte_hash_resize_step(struct rte_hash *h, uint32_t nb_buckets)
+{
+	int ret;
+
+	if (h == NULL || !h->resizable)
+		return -EINVAL;
+
+	if (h->old_buckets == NULL)
+		return 0;
+
+	ret = migrate_buckets(h, nb_buckets);
+	if (ret < 0)
+		return ret;
+
+	return h->old_num_buckets - h->migrate_idx;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_age_enable, 26.03)
+int
+rte_hash_age_enable(struct rte_hash *h, uint64_t timeout)
+{
+	RTE_ATOMIC(uint64_t) *age_ts;
+	uint32_t total_entries, i;
+	uint64_t now;
+
+	if (h == NULL)
+		return -EINVAL;
+
+	/* The key indexes of these tables are not fixed */
+	if (h->resizable || h->key_inline)
+		return -ENOTSUP;
+
+	h->age_timeout = timeout;
+	if (h->age_ts != NULL)
+		return 0;
+
+	total_entries = h->use_local_cache ?
+		h->entries + (RTE_MAX_LCORE - 1) * (LCORE_CACHE_SIZE - 1) + 1
+							: h->entries + 1;
+	age_ts = rte_malloc_socket(NULL, total_entries * sizeof(*age_ts),
+			RTE_CACHE_LINE_SIZE, h->socket_id);
+	if (age_ts == NULL) {
+		HASH_LOG(ERR, "age memory allocation failed");
+		return -ENOMEM;
+	}
+
+	/* The keys already added are fresh */
+	now = rte_get_tsc_cycles();
+	for (i = 0; i < total_entries; i++)
+		age_ts[i] = now;
+	h->age_ts = age_ts;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_age_expire, 26.03)
+int32_t
+rte_hash_age_expire(struct rte_hash *h, uint32_t nb_buckets,
+		uint32_t max_expired, int32_t *positions, void **data)
+{
+	uint32_t expired_idx[RTE_HASH_BUCKET_ENTRIES];
+	uint32_t nb_expired = 0, nb, i, j, key_idx;
+	struct rte_hash_bucket *bkt;
+	struct rte_hash_key *k;
+	void *key_data;
+	uint64_t now;
+	int64_t age;
+	int32_t pos;
+
+	if (h == NULL || h->age_ts == NULL || positions == NULL)
+		return -EINVAL;
+
+	now = rte_get_tsc_cycles();
+	for (i = 0; i < nb_buckets && nb_expired < max_expired; i++) {
+		/*
+		 * Collect the expired keys of a bucket before deleting them,
+		 * as the deletes may move the keys of the extendable buckets
+		 * to the bucket, and free the last extendable bucket.
+		 */
+		for (bkt = &h->buckets[h->age_cursor]; bkt != NULL;
+				bkt = bkt->next) {
+			nb = 0;
+			for (j = 0; j < RTE_HASH_BUCKET_ENTRIES; j++) {
+				key_idx = rte_atomic_load_explicit(
+						&bkt->key_idx[j],
+						rte_memory_order_relaxed);
+				if (key_idx == EMPTY_SLOT)
+					continue;
+				/* A reader may have set a later time */
+				age = now - rte_atomic_load_explicit(
+						&h->age_ts[key_idx],
+						rte_memory_order_relaxed);
+				if (age > 0 && (uint64_t)age > h->age_timeout)
+					expired_idx[nb++] = key_idx;
+			}
+
+			for (j = 0; j < nb && nb_expired < max_expired; j++) {
+				k = get_key_slot(h, expired_idx[j]);
+				key_data = k->pdata;
+				pos = __rte_hash_del_key_with_hash(h, k->key,
+						rte_hash_hash(h, k->key));
+				if (pos < 0)
+					continue;
+				positions[nb_expired] = pos;
+				if (data != NULL)
+					data[nb_expired] = key_data;
+				nb_expired++;
+			}
+			/* Age the bucket again in the next call */
+			if (j < nb)
+				return nb_expired;
+		}
+
+		h->age_cursor = (h->age_cursor + 1) & h->bucket_bitmask;
+	}
+
+	return nb_expired;
+}
@@ -52,23 +52,6 @@ enum cmp_jump_table_case {
 	KEY_OTHER_BYTES,
 	NUM_KEY_CMP_CASES,
 };
-
-/*
- * Table storing all different key compare functions
- * (multi-process supported)
- */
-const rte_hash_cmp_eq_t cmp_jump_table[NUM_KEY_CMP_CASES] = {
-	NULL,
-	rte_hash_k16_cmp_eq,
-	rte_hash_k32_cmp_eq,
-	rte_hash_k48_cmp_eq,
-	rte_hash_k64_cmp_eq,
-	rte_hash_k80_cmp_eq,
-	rte_hash_k96_cmp_eq,
-	rte_hash_k112_cmp_eq,
-	rte_hash_k128_cmp_eq,
-	memcmp
-};
 #else
 /*
  * All different options to select a key compare function,
@@ -80,15 +63,6 @@ enum cmp_jump_table_case {
 	NUM_KEY_CMP_CASES,
 };
 
-/*
- * Table storing all different key compare functions
- * (multi-process supported)
- */
-const rte_hash_cmp_eq_t cmp_jump_table[NUM_KEY_CMP_CASES] = {
-	NULL,
-	memcmp
-};
-
 #endif
 
 
@@ -119,6 +93,15 @@ const rte_hash_cmp_eq_t cmp_jump_table[NUM_KEY_CMP_CASES] = {
 
 #define RTE_HASH_TSX_MAX_RETRY  10
 
+/* Number of key store segments, see get_key_slot() */
+#define RTE_HASH_KEY_SEGS		33
+
+/* Number of buckets migrated by each add or delete while resizing */
+#define RTE_HASH_RESIZE_STEP		4
+
+/* Number of entries in a bucket of a key inline table */
+#define RTE_HASH_INLINE_BUCKET_ENTRIES	2
+
 struct __rte_cache_aligned lcore_cache {
 	unsigned len; /**< Cache len */
 	uint32_t objs[LCORE_CACHE_SIZE]; /**< Cache objects */
@@ -145,6 +128,39 @@ struct __rte_cache_aligned rte_hash_bucket {
 	void *next;
 };
 
+/** Entry of a key inline table, storing the key and its data */
+struct rte_hash_inline_entry {
+	uint8_t key[RTE_HASH_KEY_INLINE_LEN_MAX];
+	void *pdata;
+};
+
+/** Bucket of a key inline table, fitting in a single cache line */
+struct __rte_cache_aligned rte_hash_inline_bucket {
+	uint16_t sig_current[RTE_HASH_INLINE_BUCKET_ENTRIES];
+
+	uint8_t used;	/**< Bitmask of the entries in use */
+
+	struct rte_hash_inline_entry entry[RTE_HASH_INLINE_BUCKET_ENTRIES];
+};
+
+static_assert(sizeof(struct rte_hash_inline_bucket) == RTE_CACHE_LINE_SIZE,
+	"a key inline bucket must fit in a cache line");
+
+/**
+ * Buckets searched by the lock free readers of a resizable table.
+ * It is replaced, not modified, when the table grows, so that the
+ * readers see consistent buckets and bitmask.
+ */
+struct rte_hash_bkt_tbl {
+	struct rte_hash_bucket *buckets;	/**< Current buckets */
+	/** Buckets being migrated to the current ones, or NULL */
+	struct rte_hash_bucket *old_buckets;
+	uint32_t bucket_bitmask;		/**< Bitmask of current buckets */
+	uint32_t old_bucket_bitmask;		/**< Bitmask of old buckets */
+	/** Next table waiting for the readers to be freed */
+	struct rte_hash_bkt_tbl *next;
+};
+
 /** A hash table structure. */
 struct __rte_cache_aligned rte_hash {
 	char name[RTE_HASH_NAMESIZE];   /**< Name of the hash. */
@@ -202,6 +218,12 @@ struct __rte_cache_aligned rte_hash {
 	/**< Table with buckets storing all the	hash values and key indexes
 	 * to the key table.
 	 */
+	uint32_t key_seg_shift;
+	/**< Shift of a key position giving its key store segment. */
+	uintptr_t key_segs[RTE_HASH_KEY_SEGS];
+	/**< Address of the key store segments, minus the offset of their
+	 * first key index.
+	 */
 	rte_rwlock_t *readwrite_lock; /**< Read-write lock thread-safety. */
 	struct rte_hash_bucket *buckets_ext; /**< Extra buckets array */
 	struct rte_ring *free_ext_bkts; /**< Ring of indexes of free buckets */
@@ -214,6 +236,35 @@ struct __rte_cache_aligned rte_hash {
 	uint32_t *ext_bkt_to_free;
 	RTE_ATOMIC(uint32_t) *tbl_chng_cnt;
 	/**< Indicates if the hash table changed from last read. */
+	RTE_ATOMIC(uint64_t) *age_ts;
+	/**< Time of the last add or lookup of each key index, or NULL if
+	 * aging is not enabled.
+	 */
+
+	/* Fields used to grow a resizable table */
+	uint8_t resizable;		/**< If the table can grow */
+	int socket_id;			/**< NUMA socket of the table */
+	uint32_t nb_key_segs;		/**< Number of key store segments */
+	RTE_ATOMIC(struct rte_hash_bkt_tbl *) bkt_tbl;
+	/**< Buckets searched by the lock free readers */
+	struct rte_hash_bkt_tbl *next_bkt_tbl;
+	/**< Buckets to publish when the migration is complete */
+	struct rte_hash_bkt_tbl *retired_bkt_tbl;
+	/**< Replaced bucket tables, freed once not used by the readers */
+	struct rte_hash_bucket *old_buckets;
+	/**< Buckets whose keys are migrated to the current ones, or NULL */
+	uint32_t old_num_buckets;	/**< Number of buckets being migrated */
+	uint32_t migrate_idx;		/**< Next bucket to migrate */
+
+	/* Fields used by a key inline table */
+	uint8_t key_inline;		/**< If keys are stored in the buckets */
+	uint32_t nb_inline_keys;	/**< Number of keys in the table */
+	struct rte_hash_inline_bucket *inline_buckets;
+	/**< Buckets storing the keys and data of a key inline table */
+
+	/* Fields used by aging */
+	uint64_t age_timeout;		/**< Cycles after which keys expire */
+	uint32_t age_cursor;		/**< Next bucket to age */
 };
 
 struct queue_node {
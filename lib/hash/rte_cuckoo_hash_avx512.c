@@ -0,0 +1,68 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+
+#include "rte_hash.h"
+#include "rte_cuckoo_hash.h"
+#include "rte_cuckoo_hash_avx512.h"
+
+/* Load the signatures of a bucket */
+static __rte_always_inline __m128i
+bkt_sigs(const struct rte_hash_bucket *bkt)
+{
+	return _mm_load_si128((const __m128i *)bkt->sig_current);
+}
+
+/*
+ * Compare the signatures of two keys with the signatures of their primary
+ * and secondary buckets, with one instruction. The dense hitmask of each
+ * key is in one half of the returned mask.
+ */
+static __rte_always_inline uint32_t
+compare_signatures_x2(const struct rte_hash_bucket *prim_bkt0,
+	const struct rte_hash_bucket *sec_bkt0,
+	const struct rte_hash_bucket *prim_bkt1,
+	const struct rte_hash_bucket *sec_bkt1,
+	uint16_t sig0, uint16_t sig1)
+{
+	__m512i bkts, sigs;
+
+	bkts = _mm512_castsi128_si512(bkt_sigs(prim_bkt0));
+	bkts = _mm512_inserti32x4(bkts, bkt_sigs(sec_bkt0), 1);
+	bkts = _mm512_inserti32x4(bkts, bkt_sigs(prim_bkt1), 2);
+	bkts = _mm512_inserti32x4(bkts, bkt_sigs(sec_bkt1), 3);
+	sigs = _mm512_inserti64x4(_mm512_set1_epi16(sig0),
+			_mm256_set1_epi16(sig1), 1);
+
+	return _mm512_cmpeq_epi16_mask(bkts, sigs);
+}
+
+void
+rte_hash_compare_signatures_avx512(uint16_t *hitmask_buffer,
+	const struct rte_hash_bucket **primary_bkt,
+	const struct rte_hash_bucket **secondary_bkt,
+	const uint16_t *sig, int32_t num_keys)
+{
+	uint32_t hitmask;
+	int32_t i;
+
+	RTE_BUILD_BUG_ON(RTE_HASH_BUCKET_ENTRIES != 8);
+
+	for (i = 0; i + 1 < num_keys; i += 2) {
+		hitmask = compare_signatures_x2(primary_bkt[i],
+				secondary_bkt[i], primary_bkt[i + 1],
+				secondary_bkt[i + 1], sig[i], sig[i + 1]);
+		hitmask_buffer[i] = (uint16_t)hitmask;
+		hitmask_buffer[i + 1] = (uint16_t)(hitmask >> 16);
+	}
+
+	/* The last key of an odd number is compared twice */
+	if (i < num_keys) {
+		hitmask = compare_signatures_x2(primary_bkt[i],
+				secondary_bkt[i], primary_bkt[i],
+				secondary_bkt[i], sig[i], sig[i]);
+		hitmask_buffer[i] = (uint16_t)hitmask;
+	}
+}
@@ -0,0 +1,14 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_CUCKOO_HASH_AVX512_H_
+#define _RTE_CUCKOO_HASH_AVX512_H_
+
+void
+rte_hash_compare_signatures_avx512(uint16_t *hitmask_buffer,
+	const struct rte_hash_bucket **primary_bkt,
+	const struct rte_hash_bucket **secondary_bkt,
+	const uint16_t *sig, int32_t num_keys);
+
+#endif /* _RTE_CUCKOO_HASH_AVX512_H_ */
@@ -56,6 +56,34 @@ extern "C" {
  */
 #define RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF 0x20
 
+/** Flag to allow the table to grow when it is full.
+ * The table doubles its number of buckets when a key cannot be added,
+ * and moves the keys to the new buckets a few buckets at a time, with
+ * each following add or delete. Lookups are not blocked while resizing.
+ * It is supported with a single writer only, and cannot be combined with
+ * RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD, RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY
+ * or RTE_HASH_EXTRA_FLAGS_EXT_TABLE. With RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF,
+ * the replaced buckets are freed once the readers are quiescent if an RCU
+ * QSBR variable is associated with the table, or else when the table is
+ * freed.
+ */
+#define RTE_HASH_EXTRA_FLAGS_RESIZABLE 0x40
+
+/** Flag to store the keys and their data in the buckets.
+ * A positive lookup then reads a single cache line, instead of a bucket
+ * and a key store entry. The keys can be up to RTE_HASH_KEY_INLINE_LEN_MAX
+ * bytes long. The position of a key is the location of its entry in the
+ * buckets, which may change when other keys are added: it is not suitable
+ * as an offset into an array of user data. Lock free reader writer
+ * concurrency is not supported, and the flag cannot be combined with
+ * RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF, RTE_HASH_EXTRA_FLAGS_EXT_TABLE,
+ * RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL or RTE_HASH_EXTRA_FLAGS_RESIZABLE.
+ */
+#define RTE_HASH_EXTRA_FLAGS_KEY_INLINE 0x80
+
+/** Maximum key length of a table created with RTE_HASH_EXTRA_FLAGS_KEY_INLINE. */
+#define RTE_HASH_KEY_INLINE_LEN_MAX 16
+
 /**
  * The type of hash value of a key.
  * It should be a value of at least 32bit with fully random pattern.
@@ -209,6 +237,8 @@ rte_hash_count(const struct rte_hash *h);
 /**
  * Return the maximum key value ID that could possibly be returned by
  * rte_hash_add_key function.
+ * The max key ID of a table created with RTE_HASH_EXTRA_FLAGS_RESIZABLE
+ * increases when the table grows.
  *
  * @param h
  *  Hash table to query from
@@ -423,7 +453,9 @@ rte_hash_get_key_with_position(const struct rte_hash *h, const int32_t position,
  *   Position returned when the key was deleted.
  * @return
  *   - 0 if freed successfully
- *   - -EINVAL if the parameters are invalid.
+ *   - -EINVAL if the parameters are invalid, or if the table was created
+ *     with RTE_HASH_EXTRA_FLAGS_KEY_INLINE, whose positions are never
+ *     left to be freed.
  */
 int
 rte_hash_free_key_with_position(const struct rte_hash *h,
@@ -673,6 +705,7 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
  *   - EINVAL - invalid pointer
  *   - EEXIST - already added QSBR
  *   - ENOMEM - memory allocation failure
+ *   - ENOTSUP - table created with RTE_HASH_EXTRA_FLAGS_KEY_INLINE
  */
 int rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg);
 
@@ -700,6 +733,116 @@ __rte_experimental
 int rte_hash_rcu_qsbr_dq_reclaim(struct rte_hash *h, unsigned int *freed,
 		unsigned int *pending, unsigned int *available);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Grow a hash table created with RTE_HASH_EXTRA_FLAGS_RESIZABLE, so that
+ * it can store at least the given number of entries.
+ * The keys are not moved by this function, but by the following adds and
+ * deletes, or by rte_hash_resize_step().
+ * This function must be called from the writer thread.
+ *
+ * @param h
+ *   Hash table to grow.
+ * @param entries
+ *   Minimum number of entries of the table. Nothing is done if the table
+ *   already has as many entries.
+ * @return
+ *   - 0 on success.
+ *   - -EINVAL if the parameters are invalid or the table is not resizable.
+ *   - -ENOMEM if the memory cannot be allocated.
+ *   - -ENOSPC if the keys of a previous resize cannot be moved.
+ */
+__rte_experimental
+int
+rte_hash_resize(struct rte_hash *h, uint32_t entries);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Move to the new buckets the keys of some buckets of a table being
+ * resized, so that the resize completes without adding or deleting keys.
+ * This function must be called from the writer thread.
+ *
+ * @param h
+ *   Hash table being resized.
+ * @param nb_buckets
+ *   Maximum number of buckets whose keys are moved.
+ * @return
+ *   - The number of buckets whose keys remain to be moved, 0 when the
+ *     table is not being resized.
+ *   - -EINVAL if the parameters are invalid or the table is not resizable.
+ *   - -ENOSPC if the keys cannot be moved.
+ */
+__rte_experimental
+int
+rte_hash_resize_step(struct rte_hash *h, uint32_t nb_buckets);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Enable the aging of the keys of a hash table.
+ * The time of the last add or lookup of each key is then recorded, and the
+ * keys which are not used during the timeout can be deleted with
+ * rte_hash_age_expire(). It can be called again to change the timeout.
+ * This API should be called immediately after creating the hash table,
+ * and is not supported by the tables created with
+ * RTE_HASH_EXTRA_FLAGS_RESIZABLE or RTE_HASH_EXTRA_FLAGS_KEY_INLINE.
+ *
+ * @param h
+ *   Hash table to enable aging on.
+ * @param timeout
+ *   Time, in TSC cycles (see rte_get_tsc_hz()), after which a key which
+ *   is not added or looked up expires.
+ * @return
+ *   - 0 on success.
+ *   - -EINVAL if the parameters are invalid.
+ *   - -ENOTSUP if the table does not support aging.
+ *   - -ENOMEM if the memory cannot be allocated.
+ */
+__rte_experimental
+int
+rte_hash_age_enable(struct rte_hash *h, uint64_t timeout);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Delete the expired keys of a slice of buckets of a hash table with aging
+ * enabled. Each call continues from the bucket where the previous one
+ * stopped, so that the whole table is swept a few buckets at a time,
+ * bounding the time taken by each call.
+ * The expired keys are deleted as with rte_hash_del_key(): the same rules
+ * apply to free their position, and their data is freed by the internal
+ * RCU if it is configured with a free_key_data_func.
+ * This operation is not multi-thread safe with the other writers, and
+ * should be called from the writer thread. It can be called while lock
+ * free readers look up keys.
+ *
+ * @param h
+ *   Hash table to age.
+ * @param nb_buckets
+ *   Maximum number of buckets to search for expired keys.
+ * @param max_expired
+ *   Maximum number of keys to delete.
+ * @param positions
+ *   Output array of at least max_expired entries, with the positions of
+ *   the deleted keys.
+ * @param data
+ *   Output array of at least max_expired entries, with the data of the
+ *   deleted keys. It can be NULL.
+ * @return
+ *   - The number of deleted keys.
+ *   - -EINVAL if the parameters are invalid or aging is not enabled.
+ */
+__rte_experimental
+int32_t
+rte_hash_age_expire(struct rte_hash *h, uint32_t nb_buckets,
+		uint32_t max_expired, int32_t *positions, void **data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,6 +37,11 @@ extern int ipfrag_logtype;
 /* helper macros */
 #define	IP_FRAG_MBUF2DR(dr, mb)	((dr)->row[(dr)->cnt++] = (mb))
 
+/* number of fragments whose keys are prepared ahead by the bulk functions */
+#define	IP_FRAG_BULK_SIZE	32
+/* number of fragments whose table entries are prefetched ahead */
+#define	IP_FRAG_PREFETCH_AHEAD	2
+
 #define IPv6_KEY_BYTES(key) \
 	(key)[0], (key)[1], (key)[2], (key)[3]
 #define IPv6_KEY_BYTES_FMT \
@@ -44,8 +49,11 @@ extern int ipfrag_logtype;
 
 #ifdef RTE_LIBRTE_IP_FRAG_TBL_STAT
 #define	IP_FRAG_TBL_STAT_UPDATE(s, f, v)	((s)->f += (v))
+#define	IP_FRAG_SHARED_STAT_UPDATE(s, f, v)	\
+	rte_atomic_fetch_add_explicit(&(s)->f, (v), rte_memory_order_relaxed)
 #else
 #define	IP_FRAG_TBL_STAT_UPDATE(s, f, v)	do {} while (0)
+#define	IP_FRAG_SHARED_STAT_UPDATE(s, f, v)	do {} while (0)
 #endif /* IP_FRAG_TBL_STAT */
 
 /* internal functions declarations */
@@ -61,6 +69,28 @@ struct ip_frag_pkt * ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
 	const struct ip_frag_key *key, uint64_t tms,
 	struct ip_frag_pkt **free, struct ip_frag_pkt **stale);
 
+void ip_frag_key_hash(const struct ip_frag_key *key, uint32_t sig[2]);
+
+void ip_frag_prefetch(const struct rte_ip_frag_tbl *tbl,
+	const uint32_t sig[2]);
+
+struct ip_frag_pkt *ip_frag_find_hashed(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, const struct ip_frag_key *key,
+	uint64_t tms, const uint32_t sig[2]);
+
+struct ip_frag_pkt *ip_frag_lookup_hashed(struct rte_ip_frag_tbl *tbl,
+	const struct ip_frag_key *key, uint64_t tms, const uint32_t sig[2],
+	struct ip_frag_pkt **free, struct ip_frag_pkt **stale);
+
+struct ip_frag_pkt *ip_frag_shared_find(struct rte_ip_frag_shared_tbl *stbl,
+	struct rte_ip_frag_death_row *dr, const struct ip_frag_key *key,
+	uint64_t tms, uint32_t line[2]);
+
+struct rte_mbuf *ip_frag_shared_process(struct rte_ip_frag_shared_tbl *stbl,
+	struct rte_ip_frag_death_row *dr, struct rte_mbuf *mb,
+	const struct ip_frag_key *key, uint64_t tms, uint16_t ofs,
+	int32_t len, uint16_t more_frags);
+
 /* these functions need to be declared here as ip_frag_process relies on them */
 struct rte_mbuf *ipv4_frag_reassemble(struct ip_frag_pkt *fp);
 struct rte_mbuf *ipv6_frag_reassemble(struct ip_frag_pkt *fp);
@@ -185,4 +215,39 @@ ip_frag_tbl_del(struct rte_ip_frag_tbl *tbl, struct rte_ip_frag_death_row *dr,
 	IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, del_num, 1);
 }
 
+/* shared frag table helper functions */
+
+/* lock both hash lines of a key, in ascending order to avoid deadlocks */
+static inline void
+ip_frag_shared_lock(struct rte_ip_frag_shared_tbl *stbl, const uint32_t line[2])
+{
+	uint32_t lo, hi;
+
+	lo = RTE_MIN(line[0], line[1]);
+	hi = RTE_MAX(line[0], line[1]);
+
+	rte_spinlock_lock(&stbl->locks[lo].sl);
+	if (hi != lo)
+		rte_spinlock_lock(&stbl->locks[hi].sl);
+}
+
+static inline void
+ip_frag_shared_unlock(struct rte_ip_frag_shared_tbl *stbl,
+	const uint32_t line[2])
+{
+	if (line[1] != line[0])
+		rte_spinlock_unlock(&stbl->locks[line[1]].sl);
+	rte_spinlock_unlock(&stbl->locks[line[0]].sl);
+}
+
+/* if key is empty, the entry has been freed */
+static inline void
+ip_frag_shared_inuse(struct rte_ip_frag_shared_tbl *stbl,
+	const struct ip_frag_pkt *fp)
+{
+	if (ip_frag_key_is_empty(&fp->key))
+		rte_atomic_fetch_sub_explicit(&stbl->use_entries, 1,
+			rte_memory_order_relaxed);
+}
+
 #endif /* _IP_FRAG_COMMON_H_ */
@@ -14,6 +14,9 @@
 #define	IP_FRAG_TBL_POS(tbl, sig)	\
 	((tbl)->pkt + ((sig) & (tbl)->entry_mask))
 
+#define	IP_FRAG_TBL_LINE(stbl, sig)	\
+	(((sig) & (stbl)->tbl->entry_mask) >> (stbl)->line_shift)
+
 static inline void
 ip_frag_tbl_add(struct rte_ip_frag_tbl *tbl,  struct ip_frag_pkt *fp,
 	const struct ip_frag_key *key, uint64_t tms)
@@ -87,6 +90,16 @@ ipv6_frag_hash(const struct ip_frag_key *key, uint32_t *v1, uint32_t *v2)
 	*v2 = (v << 7) + (v >> 14);
 }
 
+static inline void
+ip_frag_hash(const struct ip_frag_key *key, uint32_t *v1, uint32_t *v2)
+{
+	/* different hashing methods for IPv4 and IPv6 */
+	if (key->key_len == IPV4_KEYLEN)
+		ipv4_frag_hash(key, v1, v2);
+	else
+		ipv6_frag_hash(key, v1, v2);
+}
+
 struct rte_mbuf *
 ip_frag_process(struct ip_frag_pkt *fp, struct rte_ip_frag_death_row *dr,
 	struct rte_mbuf *mb, uint16_t ofs, uint16_t len, uint16_t more_frags)
@@ -213,6 +226,24 @@ ip_frag_process(struct ip_frag_pkt *fp, struct rte_ip_frag_death_row *dr,
 }
 
 
+/* compute the hash values of a key. */
+void
+ip_frag_key_hash(const struct ip_frag_key *key, uint32_t sig[2])
+{
+	ip_frag_hash(key, &sig[0], &sig[1]);
+}
+
+/*
+ * prefetch the hash lines of a key. Only the first entry of each line is
+ * prefetched, as the entries of a line are used from the first one.
+ */
+void
+ip_frag_prefetch(const struct rte_ip_frag_tbl *tbl, const uint32_t sig[2])
+{
+	rte_prefetch0(&IP_FRAG_TBL_POS(tbl, sig[0])->key);
+	rte_prefetch0(&IP_FRAG_TBL_POS(tbl, sig[1])->key);
+}
+
 /*
  * Find an entry in the table for the corresponding fragment.
  * If such entry is not present, then allocate a new one.
@@ -221,6 +252,19 @@ ip_frag_process(struct ip_frag_pkt *fp, struct rte_ip_frag_death_row *dr,
 struct ip_frag_pkt *
 ip_frag_find(struct rte_ip_frag_tbl *tbl, struct rte_ip_frag_death_row *dr,
 	const struct ip_frag_key *key, uint64_t tms)
+{
+	uint32_t sig[2];
+
+	ip_frag_hash(key, &sig[0], &sig[1]);
+
+	return ip_frag_find_hashed(tbl, dr, key, tms, sig);
+}
+
+/* same as ip_frag_find(), with the hash values of the key given. */
+struct ip_frag_pkt *
+ip_frag_find_hashed(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, const struct ip_frag_key *key,
+	uint64_t tms, const uint32_t sig[2])
 {
 	struct ip_frag_pkt *pkt, *free, *stale, *lru;
 	uint64_t max_cycles;
@@ -235,7 +279,8 @@ ip_frag_find(struct rte_ip_frag_tbl *tbl, struct rte_ip_frag_death_row *dr,
 
 	IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, find_num, 1);
 
-	if ((pkt = ip_frag_lookup(tbl, key, tms, &free, &stale)) == NULL) {
+	if ((pkt = ip_frag_lookup_hashed(tbl, key, tms, sig, &free,
+			&stale)) == NULL) {
 
 		/*timed-out entry, free and invalidate it*/
 		if (stale != NULL) {
@@ -280,15 +325,19 @@ ip_frag_find(struct rte_ip_frag_tbl *tbl, struct rte_ip_frag_death_row *dr,
 	return pkt;
 }
 
-struct ip_frag_pkt *
-ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
+/*
+ * Search the two hash lines of a key for its entry.
+ * If not found, return a free and a timed out entry of these lines.
+ */
+static inline struct ip_frag_pkt *
+ip_frag_lookup_lines(struct rte_ip_frag_tbl *tbl,
 	const struct ip_frag_key *key, uint64_t tms,
+	struct ip_frag_pkt *p1, struct ip_frag_pkt *p2,
 	struct ip_frag_pkt **free, struct ip_frag_pkt **stale)
 {
-	struct ip_frag_pkt *p1, *p2;
 	struct ip_frag_pkt *empty, *old;
 	uint64_t max_cycles;
-	uint32_t i, assoc, sig1, sig2;
+	uint32_t i, assoc;
 
 	empty = NULL;
 	old = NULL;
@@ -296,35 +345,23 @@ ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
 	max_cycles = tbl->max_cycles;
 	assoc = tbl->bucket_entries;
 
-	if (tbl->last != NULL && ip_frag_key_cmp(key, &tbl->last->key) == 0)
-		return tbl->last;
-
-	/* different hashing methods for IPv4 and IPv6 */
-	if (key->key_len == IPV4_KEYLEN)
-		ipv4_frag_hash(key, &sig1, &sig2);
-	else
-		ipv6_frag_hash(key, &sig1, &sig2);
-
-	p1 = IP_FRAG_TBL_POS(tbl, sig1);
-	p2 = IP_FRAG_TBL_POS(tbl, sig2);
-
 	for (i = 0; i != assoc; i++) {
 		if (p1->key.key_len == IPV4_KEYLEN)
 			IP_FRAG_LOG(DEBUG, "%s:%d:\n"
-					"tbl: %p, max_entries: %u, use_entries: %u\n"
+					"tbl: %p, max_entries: %u\n"
 					"ipv4_frag_pkt line0: %p, index: %u from %u\n"
 			"key: <%" PRIx64 ", %#x>, start: %" PRIu64 "\n",
 					__func__, __LINE__,
-					tbl, tbl->max_entries, tbl->use_entries,
+					tbl, tbl->max_entries,
 					p1, i, assoc,
 			p1[i].key.src_dst[0], p1[i].key.id, p1[i].start);
 		else
 			IP_FRAG_LOG(DEBUG, "%s:%d:\n"
-					"tbl: %p, max_entries: %u, use_entries: %u\n"
+					"tbl: %p, max_entries: %u\n"
 					"ipv6_frag_pkt line0: %p, index: %u from %u\n"
 			"key: <" IPv6_KEY_BYTES_FMT ", %#x>, start: %" PRIu64 "\n",
 					__func__, __LINE__,
-					tbl, tbl->max_entries, tbl->use_entries,
+					tbl, tbl->max_entries,
 					p1, i, assoc,
 			IPv6_KEY_BYTES(p1[i].key.src_dst), p1[i].key.id, p1[i].start);
 
@@ -337,20 +374,20 @@ ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
 
 		if (p2->key.key_len == IPV4_KEYLEN)
 			IP_FRAG_LOG(DEBUG, "%s:%d:\n"
-					"tbl: %p, max_entries: %u, use_entries: %u\n"
+					"tbl: %p, max_entries: %u\n"
 					"ipv4_frag_pkt line1: %p, index: %u from %u\n"
 			"key: <%" PRIx64 ", %#x>, start: %" PRIu64 "\n",
 					__func__, __LINE__,
-					tbl, tbl->max_entries, tbl->use_entries,
+					tbl, tbl->max_entries,
 					p2, i, assoc,
 			p2[i].key.src_dst[0], p2[i].key.id, p2[i].start);
 		else
 			IP_FRAG_LOG(DEBUG, "%s:%d:\n"
-					"tbl: %p, max_entries: %u, use_entries: %u\n"
+					"tbl: %p, max_entries: %u\n"
 					"ipv6_frag_pkt line1: %p, index: %u from %u\n"
 			"key: <" IPv6_KEY_BYTES_FMT ", %#x>, start: %" PRIu64 "\n",
 					__func__, __LINE__,
-					tbl, tbl->max_entries, tbl->use_entries,
+					tbl, tbl->max_entries,
 					p2, i, assoc,
 			IPv6_KEY_BYTES(p2[i].key.src_dst), p2[i].key.id, p2[i].start);
 
@@ -366,3 +403,143 @@ ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
 	*stale = old;
 	return NULL;
 }
+
+struct ip_frag_pkt *
+ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
+	const struct ip_frag_key *key, uint64_t tms,
+	struct ip_frag_pkt **free, struct ip_frag_pkt **stale)
+{
+	uint32_t sig[2];
+
+	ip_frag_hash(key, &sig[0], &sig[1]);
+
+	return ip_frag_lookup_hashed(tbl, key, tms, sig, free, stale);
+}
+
+struct ip_frag_pkt *
+ip_frag_lookup_hashed(struct rte_ip_frag_tbl *tbl,
+	const struct ip_frag_key *key, uint64_t tms, const uint32_t sig[2],
+	struct ip_frag_pkt **free, struct ip_frag_pkt **stale)
+{
+	if (tbl->last != NULL && ip_frag_key_cmp(key, &tbl->last->key) == 0)
+		return tbl->last;
+
+	return ip_frag_lookup_lines(tbl, key, tms, IP_FRAG_TBL_POS(tbl, sig[0]),
+		IP_FRAG_TBL_POS(tbl, sig[1]), free, stale);
+}
+
+/* reserve an entry of the shared table, unless max_entries is reached */
+static inline int
+ip_frag_shared_reserve(struct rte_ip_frag_shared_tbl *stbl)
+{
+	uint32_t n;
+
+	n = rte_atomic_fetch_add_explicit(&stbl->use_entries, 1,
+		rte_memory_order_relaxed);
+	if (n < stbl->tbl->max_entries)
+		return 1;
+
+	rte_atomic_fetch_sub_explicit(&stbl->use_entries, 1,
+		rte_memory_order_relaxed);
+	return 0;
+}
+
+/*
+ * Find an entry in the shared table for the corresponding fragment.
+ * If such entry is not present, then allocate a new one.
+ * If the entry is stale, then free and reuse it.
+ * On success, the hash lines of the key are left locked, and their
+ * indexes are returned in line[].
+ */
+struct ip_frag_pkt *
+ip_frag_shared_find(struct rte_ip_frag_shared_tbl *stbl,
+	struct rte_ip_frag_death_row *dr, const struct ip_frag_key *key,
+	uint64_t tms, uint32_t line[2])
+{
+	struct rte_ip_frag_tbl *tbl;
+	struct ip_frag_pkt *pkt, *free, *stale;
+	uint32_t sig1, sig2;
+
+	tbl = stbl->tbl;
+	free = NULL;
+	stale = NULL;
+
+	ip_frag_hash(key, &sig1, &sig2);
+	line[0] = IP_FRAG_TBL_LINE(stbl, sig1);
+	line[1] = IP_FRAG_TBL_LINE(stbl, sig2);
+
+	ip_frag_shared_lock(stbl, line);
+
+	IP_FRAG_SHARED_STAT_UPDATE(&stbl->stat, find_num, 1);
+
+	pkt = ip_frag_lookup_lines(tbl, key, tms, IP_FRAG_TBL_POS(tbl, sig1),
+		IP_FRAG_TBL_POS(tbl, sig2), &free, &stale);
+	if (pkt == NULL) {
+
+		/* timed-out entry, free and reuse it for the new key. */
+		if (stale != NULL) {
+			ip_frag_free(stale, dr);
+			IP_FRAG_SHARED_STAT_UPDATE(&stbl->stat, del_num, 1);
+			pkt = stale;
+
+		/* found a free entry, check if we can use it. */
+		} else if (free != NULL) {
+			if (ip_frag_shared_reserve(stbl) != 0)
+				pkt = free;
+			else
+				IP_FRAG_SHARED_STAT_UPDATE(&stbl->stat,
+					fail_nospace, 1);
+		}
+
+		if (pkt != NULL) {
+			pkt->key = key[0];
+			ip_frag_reset(pkt, tms);
+			IP_FRAG_SHARED_STAT_UPDATE(&stbl->stat, add_num, 1);
+		}
+
+	/* we found the flow, but it is already timed out. */
+	} else if (tbl->max_cycles + pkt->start < tms) {
+		ip_frag_free(pkt, dr);
+		ip_frag_reset(pkt, tms);
+		IP_FRAG_SHARED_STAT_UPDATE(&stbl->stat, reuse_num, 1);
+	}
+
+	if (pkt == NULL) {
+		IP_FRAG_SHARED_STAT_UPDATE(&stbl->stat, fail_total, 1);
+		ip_frag_shared_unlock(stbl, line);
+	}
+
+	return pkt;
+}
+
+/*
+ * Add a fragment into the shared table, and reassemble the packet if all
+ * its fragments are collected.
+ */
+struct rte_mbuf *
+ip_frag_shared_process(struct rte_ip_frag_shared_tbl *stbl,
+	struct rte_ip_frag_death_row *dr, struct rte_mbuf *mb,
+	const struct ip_frag_key *key, uint64_t tms, uint16_t ofs,
+	int32_t len, uint16_t more_frags)
+{
+	struct ip_frag_pkt *fp;
+	uint32_t line[2];
+
+	/* check that fragment length is greater then zero. */
+	if (len <= 0) {
+		IP_FRAG_MBUF2DR(dr, mb);
+		return NULL;
+	}
+
+	fp = ip_frag_shared_find(stbl, dr, key, tms, line);
+	if (fp == NULL) {
+		IP_FRAG_MBUF2DR(dr, mb);
+		return NULL;
+	}
+
+	mb = ip_frag_process(fp, dr, mb, ofs, len, more_frags);
+	ip_frag_shared_inuse(stbl, fp);
+	ip_frag_shared_unlock(stbl, line);
+
+	return mb;
+}
@@ -11,6 +11,8 @@
  */
 
 #include <rte_ip_frag.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
 
 enum {
 	IP_LAST_FRAG_IDX,    /* index of last fragment */
@@ -85,4 +87,35 @@ struct rte_ip_frag_tbl {
 	struct ip_frag_pkt pkt[]; /* hash table. */
 };
 
+/* shared fragmentation table statistics, updated by multiple lcores */
+struct __rte_cache_aligned ip_frag_shared_tbl_stat {
+	RTE_ATOMIC(uint64_t) find_num;     /* total # of find/insert attempts. */
+	RTE_ATOMIC(uint64_t) add_num;      /* # of add ops. */
+	RTE_ATOMIC(uint64_t) del_num;      /* # of del ops. */
+	RTE_ATOMIC(uint64_t) reuse_num;    /* # of reuse (del/add) ops. */
+	RTE_ATOMIC(uint64_t) fail_total;   /* total # of add failures. */
+	RTE_ATOMIC(uint64_t) fail_nospace; /* # of 'no space' add failures. */
+};
+
+/* lock of a hash line, in its own cache line. */
+struct __rte_cache_aligned ip_frag_line_lock {
+	rte_spinlock_t sl;
+};
+
+/*
+ * fragmentation table shared by multiple lcores.
+ * Each hash line (i.e. bucket_entries entries) is protected by its own
+ * lock, and there is no LRU list: the timed out entries are reused by
+ * lookups, or deleted by rte_ip_frag_shared_table_del_expired_entries().
+ */
+struct rte_ip_frag_shared_tbl {
+	struct rte_ip_frag_tbl *tbl;         /* hash table. */
+	uint32_t nb_lines;                   /* number of hash lines. */
+	uint32_t line_shift;                 /* log2 of bucket_entries. */
+	RTE_ATOMIC(uint32_t) use_entries;    /* entries in use. */
+	RTE_ATOMIC(uint32_t) expire_line;    /* next line to check for expiry. */
+	struct ip_frag_shared_tbl_stat stat; /* statistics counters. */
+	struct ip_frag_line_lock locks[];    /* per hash line locks. */
+};
+
 #endif /* _IP_REASSEMBLY_H_ */
@@ -102,6 +102,89 @@ rte_ipv6_fragment_packet(struct rte_mbuf *pkt_in,
 		struct rte_mempool *pool_direct,
 		struct rte_mempool *pool_indirect);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * IPv6 fragmentation by copy.
+ *
+ * This function implements the fragmentation of IPv6 packets by copy
+ * into non-segmented mbufs, as rte_ipv4_fragment_copy_nonseg_packet()
+ * does for IPv4. It is mainly used to adapt Tx MBUF_FAST_FREE offload.
+ *
+ * @param pkt_in
+ *   The input packet.
+ * @param pkts_out
+ *   Array storing the output fragments.
+ * @param nb_pkts_out
+ *   Number of fragments.
+ * @param mtu_size
+ *   Size in bytes of the Maximum Transfer Unit (MTU) for the outgoing IPv6
+ *   datagrams. This value includes the size of the IPv6 header.
+ * @param pool_direct
+ *   MBUF pool used for allocating direct buffers for the output fragments.
+ *   Its data room must hold the IPv6 and fragment headers and the payload
+ *   of a fragment.
+ * @return
+ *   Upon successful completion - number of output fragments placed
+ *   in the pkts_out array.
+ *   Otherwise - (-1) * errno.
+ */
+__rte_experimental
+int32_t
+rte_ipv6_fragment_copy_nonseg_packet(struct rte_mbuf *pkt_in,
+	struct rte_mbuf **pkts_out,
+	uint16_t nb_pkts_out,
+	uint16_t mtu_size,
+	struct rte_mempool *pool_direct);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * IPv6 fragmentation with external buffers.
+ *
+ * This function implements the fragmentation of IPv6 packets without
+ * copying the payload, as rte_ipv6_fragment_packet() does, but the headers
+ * of all the fragments are built in one buffer, which is taken from
+ * pool_direct once per packet. All the segments of the fragments are
+ * external buffer (RTE_MBUF_F_EXTERNAL) mbufs: the first segment of each
+ * fragment is a view of its headers in that buffer, with 80 bytes of
+ * headroom, and the following ones are views of the data of the input
+ * packet. The mbufs of all the fragments are allocated in bulk from
+ * pool_indirect. The input packet is referenced by the fragments, so that
+ * the caller can free it as with rte_ipv6_fragment_packet(), and it is
+ * released with the buffer of the headers by the last freed fragment.
+ *
+ * @param pkt_in
+ *   The input packet.
+ * @param pkts_out
+ *   Array storing the output fragments.
+ * @param nb_pkts_out
+ *   Number of fragments.
+ * @param mtu_size
+ *   Size in bytes of the Maximum Transfer Unit (MTU) for the outgoing IPv6
+ *   datagrams. This value includes the size of the IPv6 header.
+ * @param pool_direct
+ *   MBUF pool used for allocating the buffer of the headers. Each fragment
+ *   takes 128 bytes of its data room, e.g. a buffer of
+ *   RTE_MBUF_DEFAULT_BUF_SIZE bytes holds the headers of 16 fragments.
+ * @param pool_indirect
+ *   MBUF pool used for allocating the mbufs of the output fragments.
+ * @return
+ *   Upon successful completion - number of output fragments placed
+ *   in the pkts_out array.
+ *   Otherwise - (-1) * errno.
+ */
+__rte_experimental
+int32_t
+rte_ipv6_fragment_extbuf_packet(struct rte_mbuf *pkt_in,
+	struct rte_mbuf **pkts_out,
+	uint16_t nb_pkts_out,
+	uint16_t mtu_size,
+	struct rte_mempool *pool_direct,
+	struct rte_mempool *pool_indirect);
+
 /**
  * This function implements reassembly of fragmented IPv6 packets.
  * Incoming mbuf should have its l2_len/l3_len fields setup correctly.
@@ -291,6 +374,227 @@ void
 rte_ip_frag_table_del_expired_entries(struct rte_ip_frag_tbl *tbl,
 	struct rte_ip_frag_death_row *dr, uint64_t tms);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reassemble a burst of fragmented IPv4 packets.
+ *
+ * It is equivalent to calling rte_ipv4_frag_reassemble_packet() for each
+ * fragment, but the keys of the fragments are computed, and the table
+ * entries they hash to prefetched, before the fragments are added into
+ * the table, which hides the table cache misses when the fragments belong
+ * to many packets.
+ * Incoming mbufs should have their l2_len/l3_len fields setup correctly.
+ *
+ * @param tbl
+ *   Table where to lookup/add the fragmented packets.
+ * @param dr
+ *   Death row to free buffers to. Each fragment may free up to
+ *   RTE_LIBRTE_IP_FRAG_MAX_FRAG + 1 mbufs, so the death row should be
+ *   flushed after at most RTE_IP_FRAG_DEATH_ROW_LEN fragments.
+ * @param mbs
+ *   Incoming mbufs with IPv4 fragments.
+ * @param nb_mbs
+ *   Number of mbufs in mbs.
+ * @param tms
+ *   Fragments arrival timestamp.
+ * @param out
+ *   Array where to store the reassembled packets. It may be mbs.
+ * @return
+ *   Number of reassembled packets stored in out.
+ */
+__rte_experimental
+uint16_t
+rte_ipv4_frag_reassemble_bulk(struct rte_ip_frag_tbl *tbl,
+		struct rte_ip_frag_death_row *dr, struct rte_mbuf **mbs,
+		uint16_t nb_mbs, uint64_t tms, struct rte_mbuf **out);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reassemble a burst of fragmented IPv6 packets.
+ *
+ * It is equivalent to calling rte_ipv6_frag_reassemble_packet() for each
+ * fragment, but the keys of the fragments are computed, and the table
+ * entries they hash to prefetched, before the fragments are added into
+ * the table, which hides the table cache misses when the fragments belong
+ * to many packets.
+ * Incoming mbufs should have their l2_len/l3_len fields setup correctly,
+ * and the fragment header must follow the fixed IPv6 header. Other
+ * packets are put on the death row.
+ *
+ * @param tbl
+ *   Table where to lookup/add the fragmented packets.
+ * @param dr
+ *   Death row to free buffers to. Each fragment may free up to
+ *   RTE_LIBRTE_IP_FRAG_MAX_FRAG + 1 mbufs, so the death row should be
+ *   flushed after at most RTE_IP_FRAG_DEATH_ROW_LEN fragments.
+ * @param mbs
+ *   Incoming mbufs with IPv6 fragments.
+ * @param nb_mbs
+ *   Number of mbufs in mbs.
+ * @param tms
+ *   Fragments arrival timestamp.
+ * @param out
+ *   Array where to store the reassembled packets. It may be mbs.
+ * @return
+ *   Number of reassembled packets stored in out.
+ */
+__rte_experimental
+uint16_t
+rte_ipv6_frag_reassemble_bulk(struct rte_ip_frag_tbl *tbl,
+		struct rte_ip_frag_death_row *dr, struct rte_mbuf **mbs,
+		uint16_t nb_mbs, uint64_t tms, struct rte_mbuf **out);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a new IP fragmentation table, which can be shared by multiple
+ * lcores. The fragments of a datagram may be added from different lcores,
+ * and the lcore which adds the last missing fragment gets the reassembled
+ * packet.
+ *
+ * Each hash line of the table is protected by its own lock, so the
+ * lcores only contend when they add fragments of datagrams which hash
+ * to the same lines.
+ *
+ * @param bucket_num
+ *   Number of buckets in the hash table.
+ * @param bucket_entries
+ *   Number of entries per bucket (e.g. hash associativity).
+ *   Should be power of two.
+ * @param max_entries
+ *   Maximum number of entries that could be stored in the table.
+ *   The value should be less or equal then bucket_num * bucket_entries.
+ * @param max_cycles
+ *   Maximum TTL in cycles for each fragmented packet.
+ * @param socket_id
+ *   The *socket_id* argument is the socket identifier in the case of
+ *   NUMA. The value can be *SOCKET_ID_ANY* if there is no NUMA constraints.
+ * @return
+ *   The pointer to the new allocated fragmentation table, on success. NULL on error.
+ */
+__rte_experimental
+struct rte_ip_frag_shared_tbl *
+rte_ip_frag_shared_table_create(uint32_t bucket_num, uint32_t bucket_entries,
+		uint32_t max_entries, uint64_t max_cycles, int socket_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free a shared IP fragmentation table, and the fragments it holds.
+ * No lcore may use the table anymore.
+ *
+ * @param tbl
+ *   Fragmentation table to free.
+ */
+__rte_experimental
+void
+rte_ip_frag_shared_table_destroy(struct rte_ip_frag_shared_tbl *tbl);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reassemble fragmented IPv4 packets with a shared table.
+ * It is safe to call it from multiple lcores at the same time, provided
+ * each lcore uses its own death row.
+ *
+ * @param tbl
+ *   Shared table where to lookup/add the fragmented packet.
+ * @param dr
+ *   Death row to free buffers to
+ * @param mb
+ *   Incoming mbuf with IPv4 fragment.
+ * @param tms
+ *   Fragment arrival timestamp.
+ * @param ip_hdr
+ *   Pointer to the IPV4 header inside the fragment.
+ * @return
+ *   Pointer to mbuf for reassembled packet, or NULL if:
+ *   - an error occurred.
+ *   - not all fragments of the packet are collected yet.
+ */
+__rte_experimental
+struct rte_mbuf *
+rte_ipv4_frag_shared_reassemble_packet(struct rte_ip_frag_shared_tbl *tbl,
+		struct rte_ip_frag_death_row *dr,
+		struct rte_mbuf *mb, uint64_t tms, struct rte_ipv4_hdr *ip_hdr);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reassemble fragmented IPv6 packets with a shared table.
+ * It is safe to call it from multiple lcores at the same time, provided
+ * each lcore uses its own death row.
+ *
+ * @param tbl
+ *   Shared table where to lookup/add the fragmented packet.
+ * @param dr
+ *   Death row to free buffers to
+ * @param mb
+ *   Incoming mbuf with IPv6 fragment.
+ * @param tms
+ *   Fragment arrival timestamp.
+ * @param ip_hdr
+ *   Pointer to the IPv6 header.
+ * @param frag_hdr
+ *   Pointer to the IPv6 fragment extension header.
+ * @return
+ *   Pointer to mbuf for reassembled packet, or NULL if:
+ *   - an error occurred.
+ *   - not all fragments of the packet are collected yet.
+ */
+__rte_experimental
+struct rte_mbuf *
+rte_ipv6_frag_shared_reassemble_packet(struct rte_ip_frag_shared_tbl *tbl,
+		struct rte_ip_frag_death_row *dr,
+		struct rte_mbuf *mb, uint64_t tms, struct rte_ipv6_hdr *ip_hdr,
+		struct rte_ipv6_fragment_ext *frag_hdr);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Delete expired fragments of a shared table.
+ * Each call checks a limited number of buckets, starting where the
+ * previous call (from any lcore) stopped.
+ *
+ * @param tbl
+ *   Shared table to delete expired fragments from
+ * @param dr
+ *   Death row to free buffers to
+ * @param tms
+ *   Current timestamp
+ */
+__rte_experimental
+void
+rte_ip_frag_shared_table_del_expired_entries(struct rte_ip_frag_shared_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, uint64_t tms);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Dump shared fragmentation table statistics to file.
+ * The counters are only updated if the library is built with
+ * RTE_LIBRTE_IP_FRAG_TBL_STAT.
+ *
+ * @param f
+ *   File to dump statistics to
+ * @param tbl
+ *   Shared fragmentation table to dump statistics from
+ */
+__rte_experimental
+void
+rte_ip_frag_shared_table_statistics_dump(FILE *f,
+	const struct rte_ip_frag_shared_tbl *tbl);
+
 /**@{@name Obsolete macros, kept here for compatibility reasons.
  * Will be deprecated/removed in future DPDK releases.
  */
@@ -150,3 +150,144 @@ rte_ip_frag_table_del_expired_entries(struct rte_ip_frag_tbl *tbl,
 		} else
 			return;
 }
+
+/* create fragmentation table shared by multiple lcores */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ip_frag_shared_table_create, 26.03)
+struct rte_ip_frag_shared_tbl *
+rte_ip_frag_shared_table_create(uint32_t bucket_num, uint32_t bucket_entries,
+	uint32_t max_entries, uint64_t max_cycles, int socket_id)
+{
+	struct rte_ip_frag_shared_tbl *stbl;
+	struct rte_ip_frag_tbl *tbl;
+	uint32_t i, nb_lines;
+	size_t sz;
+
+	tbl = rte_ip_frag_table_create(bucket_num, bucket_entries, max_entries,
+		max_cycles, socket_id);
+	if (tbl == NULL)
+		return NULL;
+
+	nb_lines = tbl->nb_entries / tbl->bucket_entries;
+	sz = sizeof(*stbl) + nb_lines * sizeof(stbl->locks[0]);
+	stbl = rte_zmalloc_socket(__func__, sz, RTE_CACHE_LINE_SIZE, socket_id);
+	if (stbl == NULL) {
+		IP_FRAG_LOG_LINE(ERR,
+			"%s: allocation of %zu bytes at socket %d failed",
+			__func__, sz, socket_id);
+		rte_free(tbl);
+		return NULL;
+	}
+
+	stbl->tbl = tbl;
+	stbl->nb_lines = nb_lines;
+	stbl->line_shift = rte_ctz32(tbl->bucket_entries);
+	for (i = 0; i != nb_lines; i++)
+		rte_spinlock_init(&stbl->locks[i].sl);
+
+	return stbl;
+}
+
+/* delete fragmentation table shared by multiple lcores */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ip_frag_shared_table_destroy, 26.03)
+void
+rte_ip_frag_shared_table_destroy(struct rte_ip_frag_shared_tbl *stbl)
+{
+	struct rte_ip_frag_tbl *tbl;
+	uint32_t i;
+
+	if (stbl == NULL)
+		return;
+
+	tbl = stbl->tbl;
+	for (i = 0; i != tbl->nb_entries; i++) {
+		if (!ip_frag_key_is_empty(&tbl->pkt[i].key))
+			ip_frag_free_immediate(&tbl->pkt[i]);
+	}
+
+	rte_free(tbl);
+	rte_free(stbl);
+}
+
+/* number of hash lines checked by each call of del_expired_entries */
+#define	IP_FRAG_SHARED_EXPIRE_LINES	32
+
+/* Delete expired fragments of a shared table */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ip_frag_shared_table_del_expired_entries, 26.03)
+void
+rte_ip_frag_shared_table_del_expired_entries(struct rte_ip_frag_shared_tbl *stbl,
+	struct rte_ip_frag_death_row *dr, uint64_t tms)
+{
+	struct rte_ip_frag_tbl *tbl;
+	struct ip_frag_pkt *fp;
+	uint64_t max_cycles;
+	uint32_t i, j, n, line;
+
+	tbl = stbl->tbl;
+	max_cycles = tbl->max_cycles;
+	n = RTE_MIN(stbl->nb_lines, (uint32_t)IP_FRAG_SHARED_EXPIRE_LINES);
+
+	for (i = 0; i != n; i++) {
+		line = rte_atomic_fetch_add_explicit(&stbl->expire_line, 1,
+			rte_memory_order_relaxed) & (stbl->nb_lines - 1);
+		fp = tbl->pkt + (line << stbl->line_shift);
+
+		rte_spinlock_lock(&stbl->locks[line].sl);
+		for (j = 0; j != tbl->bucket_entries; j++, fp++) {
+			if (ip_frag_key_is_empty(&fp->key) ||
+					max_cycles + fp->start >= tms)
+				continue;
+
+			/* check that death row has enough space */
+			if (RTE_IP_FRAG_DEATH_ROW_MBUF_LEN - dr->cnt <
+					fp->last_idx) {
+				rte_spinlock_unlock(&stbl->locks[line].sl);
+				return;
+			}
+
+			ip_frag_free(fp, dr);
+			ip_frag_key_invalidate(&fp->key);
+			rte_atomic_fetch_sub_explicit(&stbl->use_entries, 1,
+				rte_memory_order_relaxed);
+			IP_FRAG_SHARED_STAT_UPDATE(&stbl->stat, del_num, 1);
+		}
+		rte_spinlock_unlock(&stbl->locks[line].sl);
+	}
+}
+
+/* dump shared frag table statistics to file */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ip_frag_shared_table_statistics_dump, 26.03)
+void
+rte_ip_frag_shared_table_statistics_dump(FILE *f,
+	const struct rte_ip_frag_shared_tbl *stbl)
+{
+	uint64_t fail_total, fail_nospace;
+
+	fail_total = rte_atomic_load_explicit(&stbl->stat.fail_total,
+		rte_memory_order_relaxed);
+	fail_nospace = rte_atomic_load_explicit(&stbl->stat.fail_nospace,
+		rte_memory_order_relaxed);
+
+	fprintf(f, "max entries:\t%u;\n"
+		"entries in use:\t%u;\n"
+		"finds/inserts:\t%" PRIu64 ";\n"
+		"entries added:\t%" PRIu64 ";\n"
+		"entries deleted by timeout:\t%" PRIu64 ";\n"
+		"entries reused by timeout:\t%" PRIu64 ";\n"
+		"total add failures:\t%" PRIu64 ";\n"
+		"add no-space failures:\t%" PRIu64 ";\n"
+		"add hash-collisions failures:\t%" PRIu64 ";\n",
+		stbl->tbl->max_entries,
+		rte_atomic_load_explicit(&stbl->use_entries,
+			rte_memory_order_relaxed),
+		rte_atomic_load_explicit(&stbl->stat.find_num,
+			rte_memory_order_relaxed),
+		rte_atomic_load_explicit(&stbl->stat.add_num,
+			rte_memory_order_relaxed),
+		rte_atomic_load_explicit(&stbl->stat.del_num,
+			rte_memory_order_relaxed),
+		rte_atomic_load_explicit(&stbl->stat.reuse_num,
+			rte_memory_order_relaxed),
+		fail_total,
+		fail_nospace,
+		fail_total - fail_nospace);
+}
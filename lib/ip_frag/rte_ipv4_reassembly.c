@@ -79,6 +79,38 @@ ipv4_frag_reassemble(struct ip_frag_pkt *fp)
 	return m;
 }
 
+/*
+ * Get the key, the offset and the MF flag of an IPV4 fragment, and trim
+ * the padding at the end of the mbuf.
+ * Return the fragment length, which is not positive for invalid fragments.
+ */
+static inline int32_t
+ipv4_frag_prepare(struct rte_mbuf *mb, const struct rte_ipv4_hdr *ip_hdr,
+	struct ip_frag_key *key, uint16_t *ofs, uint16_t *more_frags)
+{
+	uint16_t flag_offset;
+	int32_t ip_len;
+	int32_t trim;
+
+	flag_offset = rte_be_to_cpu_16(ip_hdr->fragment_offset);
+	*ofs = (uint16_t)(flag_offset & RTE_IPV4_HDR_OFFSET_MASK);
+	*ofs *= RTE_IPV4_HDR_OFFSET_UNITS;
+	*more_frags = (uint16_t)(flag_offset & RTE_IPV4_HDR_MF_FLAG);
+
+	/* use first 8 bytes only */
+	memcpy(&key->src_dst[0], &ip_hdr->src_addr, 8);
+	key->id = ip_hdr->packet_id;
+	key->key_len = IPV4_KEYLEN;
+
+	ip_len = rte_be_to_cpu_16(ip_hdr->total_length) - mb->l3_len;
+	trim = mb->pkt_len - (ip_len + mb->l3_len + mb->l2_len);
+
+	if (unlikely(trim > 0) && ip_len > 0)
+		rte_pktmbuf_trim(mb, trim);
+
+	return ip_len;
+}
+
 /*
  * Process new mbuf with fragment of IPV4 packet.
  * Incoming mbuf should have it's l2_len/l3_len fields setup correctly.
@@ -103,30 +135,18 @@ rte_ipv4_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 {
 	struct ip_frag_pkt *fp;
 	struct ip_frag_key key;
-	uint16_t flag_offset, ip_ofs, ip_flag;
+	uint16_t ip_ofs, ip_flag;
 	int32_t ip_len;
-	int32_t trim;
-
-	flag_offset = rte_be_to_cpu_16(ip_hdr->fragment_offset);
-	ip_ofs = (uint16_t)(flag_offset & RTE_IPV4_HDR_OFFSET_MASK);
-	ip_flag = (uint16_t)(flag_offset & RTE_IPV4_HDR_MF_FLAG);
 
-	/* use first 8 bytes only */
-	memcpy(&key.src_dst[0], &ip_hdr->src_addr, 8);
-	key.id = ip_hdr->packet_id;
-	key.key_len = IPV4_KEYLEN;
-
-	ip_ofs *= RTE_IPV4_HDR_OFFSET_UNITS;
-	ip_len = rte_be_to_cpu_16(ip_hdr->total_length) - mb->l3_len;
-	trim = mb->pkt_len - (ip_len + mb->l3_len + mb->l2_len);
+	ip_len = ipv4_frag_prepare(mb, ip_hdr, &key, &ip_ofs, &ip_flag);
 
 	IP_FRAG_LOG(DEBUG, "%s:%d:\n"
 		"mbuf: %p, tms: %" PRIu64 ", key: <%" PRIx64 ", %#x>"
-		"ofs: %u, len: %d, padding: %d, flags: %#x\n"
+		"ofs: %u, len: %d, flags: %#x\n"
 		"tbl: %p, max_cycles: %" PRIu64 ", entry_mask: %#x, "
 		"max_entries: %u, use_entries: %u\n\n",
 		__func__, __LINE__,
-		mb, tms, key.src_dst[0], key.id, ip_ofs, ip_len, trim, ip_flag,
+		mb, tms, key.src_dst[0], key.id, ip_ofs, ip_len, ip_flag,
 		tbl, tbl->max_cycles, tbl->entry_mask, tbl->max_entries,
 		tbl->use_entries);
 
@@ -136,9 +156,6 @@ rte_ipv4_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 		return NULL;
 	}
 
-	if (unlikely(trim > 0))
-		rte_pktmbuf_trim(mb, trim);
-
 	/* try to find/add entry into the fragment's table. */
 	if ((fp = ip_frag_find(tbl, dr, &key, tms)) == NULL) {
 		IP_FRAG_MBUF2DR(dr, mb);
@@ -171,3 +188,102 @@ rte_ipv4_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 
 	return mb;
 }
+
+/*
+ * Process new mbuf with fragment of IPV4 packet, into a table shared by
+ * multiple lcores.
+ */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ipv4_frag_shared_reassemble_packet, 26.03)
+struct rte_mbuf *
+rte_ipv4_frag_shared_reassemble_packet(struct rte_ip_frag_shared_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, struct rte_mbuf *mb, uint64_t tms,
+	struct rte_ipv4_hdr *ip_hdr)
+{
+	struct ip_frag_key key;
+	uint16_t ip_ofs, ip_flag;
+	int32_t ip_len;
+
+	ip_len = ipv4_frag_prepare(mb, ip_hdr, &key, &ip_ofs, &ip_flag);
+
+	return ip_frag_shared_process(tbl, dr, mb, &key, tms, ip_ofs, ip_len,
+		ip_flag);
+}
+
+/*
+ * Process a burst of mbufs with fragments of IPV4 packets.
+ * The keys of up to IP_FRAG_BULK_SIZE fragments are computed before the
+ * fragments are inserted into the table, and the hash lines of each
+ * fragment are prefetched while the previous ones are inserted.
+ */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ipv4_frag_reassemble_bulk, 26.03)
+uint16_t
+rte_ipv4_frag_reassemble_bulk(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, struct rte_mbuf **mbs,
+	uint16_t nb_mbs, uint64_t tms, struct rte_mbuf **out)
+{
+	struct ip_frag_key key[IP_FRAG_BULK_SIZE];
+	uint32_t sig[IP_FRAG_BULK_SIZE][2];
+	uint16_t ofs[IP_FRAG_BULK_SIZE];
+	uint16_t more_frags[IP_FRAG_BULK_SIZE];
+	int32_t len[IP_FRAG_BULK_SIZE];
+	struct rte_ipv4_hdr *ip_hdr;
+	struct ip_frag_pkt *fp;
+	struct rte_mbuf *mb;
+	uint16_t i, j, n, nb_out;
+
+	nb_out = 0;
+
+	for (i = 0; i < nb_mbs; i += n) {
+		n = RTE_MIN(nb_mbs - i, IP_FRAG_BULK_SIZE);
+
+		/* compute the keys and their hash values. */
+		for (j = 0; j != n; j++) {
+			mb = mbs[i + j];
+			ip_hdr = rte_pktmbuf_mtod_offset(mb,
+				struct rte_ipv4_hdr *, mb->l2_len);
+			len[j] = ipv4_frag_prepare(mb, ip_hdr, &key[j], &ofs[j],
+				&more_frags[j]);
+			if (len[j] > 0)
+				ip_frag_key_hash(&key[j], sig[j]);
+		}
+
+		/* prefetch the hash lines of the first fragments. */
+		for (j = 0; j != RTE_MIN(n, IP_FRAG_PREFETCH_AHEAD); j++) {
+			if (len[j] > 0)
+				ip_frag_prefetch(tbl, sig[j]);
+		}
+
+		/* add the fragments into the table. */
+		for (j = 0; j != n; j++) {
+			mb = mbs[i + j];
+
+			/* prefetch the hash lines of a next fragment. */
+			if (j + IP_FRAG_PREFETCH_AHEAD < n &&
+					len[j + IP_FRAG_PREFETCH_AHEAD] > 0)
+				ip_frag_prefetch(tbl,
+					sig[j + IP_FRAG_PREFETCH_AHEAD]);
+
+			/* check that fragment length is greater then zero. */
+			if (len[j] <= 0) {
+				IP_FRAG_MBUF2DR(dr, mb);
+				continue;
+			}
+
+			fp = ip_frag_find_hashed(tbl, dr, &key[j], tms, sig[j]);
+			if (fp == NULL) {
+				IP_FRAG_MBUF2DR(dr, mb);
+				continue;
+			}
+
+			mb = ip_frag_process(fp, dr, mb, ofs[j], len[j],
+				more_frags[j]);
+			ip_frag_inuse(tbl, fp);
+
+			/* out may be mbs, but only consumed slots are reused. */
+			if (mb != NULL)
+				out[nb_out++] = mb;
+		}
+	}
+
+	return nb_out;
+}
@@ -194,3 +194,422 @@ rte_ipv6_fragment_packet(struct rte_mbuf *pkt_in,
 
 	return out_pkt_pos;
 }
+
+/**
+ * IPv6 fragmentation by copy.
+ *
+ * This function implements the fragmentation of IPv6 packets by copy
+ * into non-segmented mbufs.
+ *
+ * @param pkt_in
+ *   The input packet.
+ * @param pkts_out
+ *   Array storing the output fragments.
+ * @param mtu_size
+ *   Size in bytes of the Maximum Transfer Unit (MTU) for the outgoing IPv6
+ *   datagrams. This value includes the size of the IPv6 header.
+ * @param pool_direct
+ *   MBUF pool used for allocating direct buffers for the output fragments.
+ * @return
+ *   Upon successful completion - number of output fragments placed
+ *   in the pkts_out array.
+ *   Otherwise - (-1) * <errno>.
+ */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ipv6_fragment_copy_nonseg_packet, 26.03)
+int32_t
+rte_ipv6_fragment_copy_nonseg_packet(struct rte_mbuf *pkt_in,
+	struct rte_mbuf **pkts_out,
+	uint16_t nb_pkts_out,
+	uint16_t mtu_size,
+	struct rte_mempool *pool_direct)
+{
+	struct rte_mbuf *in_seg = NULL;
+	struct rte_ipv6_hdr *in_hdr;
+	uint32_t out_pkt_pos, in_seg_data_pos;
+	uint32_t more_in_segs;
+	uint16_t fragment_offset, frag_size, header_len;
+	uint16_t frag_bytes_remaining;
+
+	/*
+	 * Formal parameter checking.
+	 */
+	if (unlikely(pkt_in == NULL) || unlikely(pkts_out == NULL) ||
+	    unlikely(nb_pkts_out == 0) || unlikely(pool_direct == NULL) ||
+	    unlikely(mtu_size < RTE_IPV6_MIN_MTU) ||
+	    unlikely(pkt_in->data_len < sizeof(struct rte_ipv6_hdr)))
+		return -EINVAL;
+
+	/*
+	 * Ensure the IP payload length of all fragments (except the
+	 * last fragment) are a multiple of 8 bytes per RFC2460.
+	 */
+	header_len = sizeof(struct rte_ipv6_hdr) +
+		sizeof(struct rte_ipv6_fragment_ext);
+	frag_size = RTE_ALIGN_FLOOR(mtu_size - header_len,
+		RTE_IPV6_EHDR_FO_ALIGN);
+
+	/* Check that pkts_out is big enough to hold all fragments */
+	if (unlikely(frag_size * nb_pkts_out <
+	    (uint16_t)(pkt_in->pkt_len - sizeof(struct rte_ipv6_hdr))))
+		return -EINVAL;
+
+	in_hdr = rte_pktmbuf_mtod(pkt_in, struct rte_ipv6_hdr *);
+
+	in_seg = pkt_in;
+	in_seg_data_pos = sizeof(struct rte_ipv6_hdr);
+	out_pkt_pos = 0;
+	fragment_offset = 0;
+
+	more_in_segs = 1;
+	while (likely(more_in_segs)) {
+		struct rte_mbuf *out_pkt = NULL;
+		uint32_t more_out_segs;
+		struct rte_ipv6_hdr *out_hdr;
+
+		/* Allocate direct buffer */
+		out_pkt = rte_pktmbuf_alloc(pool_direct);
+		if (unlikely(out_pkt == NULL)) {
+			__free_fragments(pkts_out, out_pkt_pos);
+			return -ENOMEM;
+		}
+		if (unlikely(rte_pktmbuf_tailroom(out_pkt) <
+				header_len + frag_size)) {
+			rte_pktmbuf_free(out_pkt);
+			__free_fragments(pkts_out, out_pkt_pos);
+			return -EINVAL;
+		}
+
+		/* Reserve space for the IP header that will be built later */
+		out_pkt->data_len = header_len;
+		frag_bytes_remaining = frag_size;
+
+		more_out_segs = 1;
+		while (likely(more_out_segs && more_in_segs)) {
+			uint32_t len;
+
+			len = frag_bytes_remaining;
+			if (len > (in_seg->data_len - in_seg_data_pos))
+				len = in_seg->data_len - in_seg_data_pos;
+
+			memcpy(rte_pktmbuf_mtod_offset(out_pkt, char *,
+					out_pkt->data_len),
+				rte_pktmbuf_mtod_offset(in_seg, char *,
+					in_seg_data_pos),
+				len);
+
+			in_seg_data_pos += len;
+			frag_bytes_remaining -= len;
+			out_pkt->data_len += len;
+
+			/* Current output packet (i.e. fragment) done ? */
+			if (unlikely(frag_bytes_remaining == 0))
+				more_out_segs = 0;
+
+			/* Current input segment done ? */
+			if (unlikely(in_seg_data_pos == in_seg->data_len)) {
+				in_seg = in_seg->next;
+				in_seg_data_pos = 0;
+
+				if (unlikely(in_seg == NULL))
+					more_in_segs = 0;
+			}
+		}
+
+		/* Build the IP header */
+
+		out_pkt->pkt_len = out_pkt->data_len;
+		out_hdr = rte_pktmbuf_mtod(out_pkt, struct rte_ipv6_hdr *);
+
+		__fill_ipv6hdr_frag(out_hdr, in_hdr,
+		    (uint16_t)out_pkt->pkt_len - sizeof(struct rte_ipv6_hdr),
+		    fragment_offset, more_in_segs);
+
+		fragment_offset = (uint16_t)(fragment_offset +
+		    out_pkt->pkt_len - header_len);
+
+		/* Write the fragment to the output list */
+		pkts_out[out_pkt_pos] = out_pkt;
+		out_pkt_pos++;
+	}
+
+	return out_pkt_pos;
+}
+
+/*
+ * Size of the part of the header buffer which is used by one fragment of
+ * rte_ipv6_fragment_extbuf_packet(). The headers of the fragment are at
+ * its end, and the rest is the headroom of the fragment.
+ */
+#define IPV6_FRAG_EXTBUF_SLOT_SIZE 128
+
+/* Maximum number of mbufs allocated at once for the output fragments */
+#define IPV6_FRAG_EXTBUF_ALLOC_BULK 32
+
+/*
+ * Buffers referenced by the fragments of a packet, which are freed with
+ * the last fragment. It is stored in the header buffer, before the shared
+ * info of the external buffers.
+ */
+struct ipv6_frag_extbuf_ctx {
+	struct rte_mbuf *hdr_buf;
+	struct rte_mbuf *pkt_in;
+};
+
+/* mbufs allocated in bulk, and handed out one by one */
+struct ipv6_frag_mbuf_cache {
+	struct rte_mempool *mp;
+	uint32_t left; /* number of the mbufs which are still to allocate */
+	uint32_t pos;
+	uint32_t num;
+	struct rte_mbuf *mbufs[IPV6_FRAG_EXTBUF_ALLOC_BULK];
+};
+
+static inline struct rte_mbuf *
+__mbuf_cache_get(struct ipv6_frag_mbuf_cache *c)
+{
+	if (c->pos == c->num) {
+		c->pos = 0;
+		c->num = RTE_MIN(c->left,
+			(uint32_t)IPV6_FRAG_EXTBUF_ALLOC_BULK);
+		if (unlikely(c->num == 0) ||
+				rte_pktmbuf_alloc_bulk(c->mp, c->mbufs,
+					c->num) != 0) {
+			c->num = 0;
+			return NULL;
+		}
+		c->left -= c->num;
+	}
+
+	return c->mbufs[c->pos++];
+}
+
+/*
+ * Get the number of the payload segments of the fragments, i.e. the
+ * number of the intersections of the fragments with the segments of the
+ * input packet.
+ */
+static inline uint32_t
+__count_payload_segs(const struct rte_mbuf *in_seg, uint32_t data_pos,
+	uint32_t frag_size)
+{
+	uint32_t nb_segs = 0, ofs = 0, len;
+
+	for (; in_seg != NULL; in_seg = in_seg->next) {
+		len = in_seg->data_len - data_pos;
+		if (len != 0) {
+			nb_segs += (ofs + len - 1) / frag_size -
+				ofs / frag_size + 1;
+			ofs += len;
+		}
+		data_pos = 0;
+	}
+
+	return nb_segs;
+}
+
+static void
+__free_extbuf_ctx(void *addr __rte_unused, void *opaque)
+{
+	struct ipv6_frag_extbuf_ctx *ctx = opaque;
+
+	rte_pktmbuf_free(ctx->pkt_in);
+	rte_pktmbuf_free(ctx->hdr_buf);
+}
+
+/**
+ * IPv6 fragmentation with external buffers.
+ *
+ * This function implements the fragmentation of IPv6 packets, where all
+ * the segments of the fragments are external buffer mbufs: the first one
+ * is a view of the headers of the fragment, which are built in one buffer
+ * for all the fragments, and the following ones are views of the data of
+ * the input packet.
+ *
+ * @param pkt_in
+ *   The input packet.
+ * @param pkts_out
+ *   Array storing the output fragments.
+ * @param mtu_size
+ *   Size in bytes of the Maximum Transfer Unit (MTU) for the outgoing IPv6
+ *   datagrams. This value includes the size of the IPv6 header.
+ * @param pool_direct
+ *   MBUF pool used for allocating the buffer of the headers.
+ * @param pool_indirect
+ *   MBUF pool used for allocating the mbufs of the output fragments.
+ * @return
+ *   Upon successful completion - number of output fragments placed
+ *   in the pkts_out array.
+ *   Otherwise - (-1) * <errno>.
+ */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ipv6_fragment_extbuf_packet, 26.03)
+int32_t
+rte_ipv6_fragment_extbuf_packet(struct rte_mbuf *pkt_in,
+	struct rte_mbuf **pkts_out,
+	uint16_t nb_pkts_out,
+	uint16_t mtu_size,
+	struct rte_mempool *pool_direct,
+	struct rte_mempool *pool_indirect)
+{
+	struct ipv6_frag_mbuf_cache cache;
+	struct ipv6_frag_extbuf_ctx *ctx;
+	struct rte_mbuf_ext_shared_info *shinfo;
+	struct rte_mbuf *hdr_buf, *in_seg, *out_seg, *out_seg_prev;
+	struct rte_mbuf *out_pkt = NULL;
+	struct rte_ipv6_hdr *in_hdr;
+	uint32_t in_seg_data_pos, out_pkt_pos, nb_frags, nb_mbufs, nb_attached;
+	uint32_t payload_len, fragment_offset, frag_len, frag_bytes_remaining;
+	uint32_t slot_ofs, len;
+	uint16_t frag_size, header_len, hdr_buf_len;
+
+	/*
+	 * Formal parameter checking.
+	 */
+	if (unlikely(pkt_in == NULL) || unlikely(pkts_out == NULL) ||
+	    unlikely(nb_pkts_out == 0) ||
+	    unlikely(pool_direct == NULL) || unlikely(pool_indirect == NULL) ||
+	    unlikely(mtu_size < RTE_IPV6_MIN_MTU) ||
+	    unlikely(pkt_in->data_len < sizeof(struct rte_ipv6_hdr)))
+		return -EINVAL;
+
+	/*
+	 * Ensure the IP payload length of all fragments (except the
+	 * last fragment) are a multiple of 8 bytes per RFC2460.
+	 */
+	header_len = sizeof(struct rte_ipv6_hdr) +
+		sizeof(struct rte_ipv6_fragment_ext);
+	frag_size = RTE_ALIGN_FLOOR(mtu_size - header_len,
+		RTE_IPV6_EHDR_FO_ALIGN);
+
+	/* Check that pkts_out is big enough to hold all fragments */
+	payload_len = pkt_in->pkt_len - sizeof(struct rte_ipv6_hdr);
+	nb_frags = RTE_MAX((payload_len + frag_size - 1) / frag_size, 1U);
+	if (unlikely(nb_frags > nb_pkts_out))
+		return -EINVAL;
+
+	/*
+	 * Allocate the buffer of the headers of all the fragments, which
+	 * also keeps the shared info of the external buffers.
+	 */
+	hdr_buf = rte_pktmbuf_alloc(pool_direct);
+	if (unlikely(hdr_buf == NULL))
+		return -ENOMEM;
+
+	hdr_buf_len = hdr_buf->buf_len;
+	shinfo = rte_pktmbuf_ext_shinfo_init_helper(hdr_buf->buf_addr,
+		&hdr_buf_len, __free_extbuf_ctx, NULL);
+	if (unlikely(shinfo == NULL) ||
+	    unlikely(hdr_buf_len < sizeof(*ctx) +
+		nb_frags * IPV6_FRAG_EXTBUF_SLOT_SIZE)) {
+		rte_pktmbuf_free(hdr_buf);
+		return -EINVAL;
+	}
+	ctx = RTE_PTR_ALIGN_FLOOR(RTE_PTR_ADD(hdr_buf->buf_addr,
+		hdr_buf_len - sizeof(*ctx)), sizeof(uintptr_t));
+	ctx->hdr_buf = hdr_buf;
+	ctx->pkt_in = NULL;
+	shinfo->fcb_opaque = ctx;
+
+	/*
+	 * Each fragment takes one mbuf for its headers, and one for each
+	 * input segment which its payload is in.
+	 */
+	nb_mbufs = nb_frags + __count_payload_segs(pkt_in,
+		sizeof(struct rte_ipv6_hdr), frag_size);
+	cache.mp = pool_indirect;
+	cache.left = nb_mbufs;
+	cache.pos = 0;
+	cache.num = 0;
+
+	in_hdr = rte_pktmbuf_mtod(pkt_in, struct rte_ipv6_hdr *);
+
+	in_seg = pkt_in;
+	in_seg_data_pos = sizeof(struct rte_ipv6_hdr);
+	fragment_offset = 0;
+	nb_attached = 0;
+
+	for (out_pkt_pos = 0; out_pkt_pos < nb_frags; out_pkt_pos++) {
+		out_pkt = __mbuf_cache_get(&cache);
+		if (unlikely(out_pkt == NULL))
+			goto nomem;
+
+		/* Attach the fragment to its part of the header buffer */
+		slot_ofs = out_pkt_pos * IPV6_FRAG_EXTBUF_SLOT_SIZE;
+		rte_pktmbuf_attach_extbuf(out_pkt,
+			RTE_PTR_ADD(hdr_buf->buf_addr, slot_ofs),
+			rte_mbuf_iova_get(hdr_buf) + slot_ofs,
+			IPV6_FRAG_EXTBUF_SLOT_SIZE, shinfo);
+		out_pkt->data_off = IPV6_FRAG_EXTBUF_SLOT_SIZE - header_len;
+		out_pkt->data_len = header_len;
+		pkts_out[out_pkt_pos] = out_pkt;
+		nb_attached++;
+
+		frag_len = RTE_MIN(frag_size, payload_len - fragment_offset);
+		frag_bytes_remaining = frag_len;
+		out_seg_prev = out_pkt;
+		while (likely(frag_bytes_remaining != 0)) {
+			len = RTE_MIN(frag_bytes_remaining,
+				in_seg->data_len - in_seg_data_pos);
+			if (likely(len != 0)) {
+				out_seg = __mbuf_cache_get(&cache);
+				if (unlikely(out_seg == NULL))
+					goto nomem;
+
+				/* Attach the segment to the input data */
+				rte_pktmbuf_attach_extbuf(out_seg,
+					rte_pktmbuf_mtod_offset(in_seg, void *,
+						in_seg_data_pos),
+					rte_pktmbuf_iova_offset(in_seg,
+						in_seg_data_pos),
+					(uint16_t)len, shinfo);
+				out_seg->data_len = (uint16_t)len;
+				out_seg_prev->next = out_seg;
+				out_seg_prev = out_seg;
+				out_pkt->nb_segs++;
+				nb_attached++;
+
+				in_seg_data_pos += len;
+				frag_bytes_remaining -= len;
+			}
+
+			/* Current input segment done ? */
+			if (in_seg_data_pos == in_seg->data_len) {
+				in_seg = in_seg->next;
+				in_seg_data_pos = 0;
+			}
+		}
+
+		/* Build the IP header */
+		out_pkt->pkt_len = header_len + frag_len;
+		__fill_ipv6hdr_frag(rte_pktmbuf_mtod(out_pkt,
+				struct rte_ipv6_hdr *), in_hdr,
+			(uint16_t)(out_pkt->pkt_len -
+				sizeof(struct rte_ipv6_hdr)),
+			fragment_offset,
+			fragment_offset + frag_len < payload_len);
+
+		fragment_offset += frag_len;
+	}
+
+	/*
+	 * The input packet and the header buffer are freed with the last
+	 * segment of the fragments.
+	 */
+	rte_pktmbuf_refcnt_update(pkt_in, 1);
+	ctx->pkt_in = pkt_in;
+	rte_mbuf_ext_refcnt_set(shinfo, nb_mbufs);
+
+	return nb_frags;
+
+nomem:
+	rte_pktmbuf_free_bulk(&cache.mbufs[cache.pos], cache.num - cache.pos);
+	if (nb_attached == 0) {
+		rte_pktmbuf_free(hdr_buf);
+	} else {
+		rte_mbuf_ext_refcnt_set(shinfo, nb_attached);
+		/* The current fragment is freed too, if it was started. */
+		__free_fragments(pkts_out, out_pkt_pos +
+			(out_pkt != NULL ? 1 : 0));
+	}
+
+	return -ENOMEM;
+}
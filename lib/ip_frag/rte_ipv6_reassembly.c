@@ -113,6 +113,45 @@ ipv6_frag_reassemble(struct ip_frag_pkt *fp)
 	return m;
 }
 
+#define MORE_FRAGS(x) (((x) & 0x100) >> 8)
+#define FRAG_OFFSET(x) (rte_cpu_to_be_16(x) >> 3)
+
+/*
+ * Get the key, the offset and the M flag of an IPV6 fragment, and trim
+ * the padding at the end of the mbuf.
+ * Return the fragment length, which is not positive for invalid fragments.
+ */
+static inline int32_t
+ipv6_frag_prepare(struct rte_mbuf *mb, const struct rte_ipv6_hdr *ip_hdr,
+	const struct rte_ipv6_fragment_ext *frag_hdr, struct ip_frag_key *key,
+	uint16_t *ofs, uint16_t *more_frags)
+{
+	int32_t ip_len;
+	int32_t trim;
+
+	rte_memcpy(&key->src_dst[0], &ip_hdr->src_addr, 16);
+	rte_memcpy(&key->src_dst[2], &ip_hdr->dst_addr, 16);
+
+	key->id = frag_hdr->id;
+	key->key_len = IPV6_KEYLEN;
+
+	*ofs = FRAG_OFFSET(frag_hdr->frag_data) * 8;
+	*more_frags = MORE_FRAGS(frag_hdr->frag_data);
+
+	/*
+	 * as per RFC2460, payload length contains all extension headers
+	 * as well. Only the fragment header is supported, so this is
+	 * what is removed from the payload length.
+	 */
+	ip_len = rte_be_to_cpu_16(ip_hdr->payload_len) - sizeof(*frag_hdr);
+	trim = mb->pkt_len - (ip_len + mb->l3_len + mb->l2_len);
+
+	if (unlikely(trim > 0) && ip_len > 0)
+		rte_pktmbuf_trim(mb, trim);
+
+	return ip_len;
+}
+
 /*
  * Process new mbuf with fragment of IPV6 datagram.
  * Incoming mbuf should have its l2_len/l3_len fields setup correctly.
@@ -131,8 +170,6 @@ ipv6_frag_reassemble(struct ip_frag_pkt *fp)
  *   - an error occurred.
  *   - not all fragments of the packet are collected yet.
  */
-#define MORE_FRAGS(x) (((x) & 0x100) >> 8)
-#define FRAG_OFFSET(x) (rte_cpu_to_be_16(x) >> 3)
 RTE_EXPORT_SYMBOL(rte_ipv6_frag_reassemble_packet)
 struct rte_mbuf *
 rte_ipv6_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
@@ -141,38 +178,22 @@ rte_ipv6_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 {
 	struct ip_frag_pkt *fp;
 	struct ip_frag_key key;
-	uint16_t ip_ofs;
+	uint16_t ip_ofs, more_frags;
 	int32_t ip_len;
-	int32_t trim;
-
-	rte_memcpy(&key.src_dst[0], &ip_hdr->src_addr, 16);
-	rte_memcpy(&key.src_dst[2], &ip_hdr->dst_addr, 16);
-
-	key.id = frag_hdr->id;
-	key.key_len = IPV6_KEYLEN;
 
-	ip_ofs = FRAG_OFFSET(frag_hdr->frag_data) * 8;
-
-	/*
-	 * as per RFC2460, payload length contains all extension headers
-	 * as well.
-	 * since we don't support anything but frag headers,
-	 * this is what we remove from the payload len.
-	 */
-	ip_len = rte_be_to_cpu_16(ip_hdr->payload_len) - sizeof(*frag_hdr);
-	trim = mb->pkt_len - (ip_len + mb->l3_len + mb->l2_len);
+	ip_len = ipv6_frag_prepare(mb, ip_hdr, frag_hdr, &key, &ip_ofs,
+		&more_frags);
 
 	IP_FRAG_LOG(DEBUG, "%s:%d:\n"
 		"mbuf: %p, tms: %" PRIu64
 		", key: <" IPv6_KEY_BYTES_FMT ", %#x>, "
-		"ofs: %u, len: %d, padding: %d, flags: %#x\n"
+		"ofs: %u, len: %d, flags: %#x\n"
 		"tbl: %p, max_cycles: %" PRIu64 ", entry_mask: %#x, "
 		"max_entries: %u, use_entries: %u\n\n",
 		__func__, __LINE__,
 		mb, tms, IPv6_KEY_BYTES(key.src_dst), key.id, ip_ofs, ip_len,
-		trim, RTE_IPV6_GET_MF(frag_hdr->frag_data),
-		tbl, tbl->max_cycles, tbl->entry_mask, tbl->max_entries,
-		tbl->use_entries);
+		more_frags, tbl, tbl->max_cycles, tbl->entry_mask,
+		tbl->max_entries, tbl->use_entries);
 
 	/* check that fragment length is greater then zero. */
 	if (ip_len <= 0) {
@@ -180,9 +201,6 @@ rte_ipv6_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 		return NULL;
 	}
 
-	if (unlikely(trim > 0))
-		rte_pktmbuf_trim(mb, trim);
-
 	/* try to find/add entry into the fragment's table. */
 	fp = ip_frag_find(tbl, dr, &key, tms);
 	if (fp == NULL) {
@@ -201,8 +219,7 @@ rte_ipv6_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 
 
 	/* process the fragmented packet. */
-	mb = ip_frag_process(fp, dr, mb, ip_ofs, ip_len,
-			MORE_FRAGS(frag_hdr->frag_data));
+	mb = ip_frag_process(fp, dr, mb, ip_ofs, ip_len, more_frags);
 	ip_frag_inuse(tbl, fp);
 
 	IP_FRAG_LOG(DEBUG, "%s:%d:\n"
@@ -217,3 +234,110 @@ rte_ipv6_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 
 	return mb;
 }
+
+/*
+ * Process new mbuf with fragment of IPV6 datagram, into a table shared by
+ * multiple lcores.
+ */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ipv6_frag_shared_reassemble_packet, 26.03)
+struct rte_mbuf *
+rte_ipv6_frag_shared_reassemble_packet(struct rte_ip_frag_shared_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, struct rte_mbuf *mb, uint64_t tms,
+	struct rte_ipv6_hdr *ip_hdr, struct rte_ipv6_fragment_ext *frag_hdr)
+{
+	struct ip_frag_key key;
+	uint16_t ip_ofs, more_frags;
+	int32_t ip_len;
+
+	ip_len = ipv6_frag_prepare(mb, ip_hdr, frag_hdr, &key, &ip_ofs,
+		&more_frags);
+
+	return ip_frag_shared_process(tbl, dr, mb, &key, tms, ip_ofs, ip_len,
+		more_frags);
+}
+
+/*
+ * Process a burst of mbufs with fragments of IPV6 datagrams.
+ * The keys of up to IP_FRAG_BULK_SIZE fragments are computed before the
+ * fragments are inserted into the table, and the hash lines of each
+ * fragment are prefetched while the previous ones are inserted.
+ */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ipv6_frag_reassemble_bulk, 26.03)
+uint16_t
+rte_ipv6_frag_reassemble_bulk(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, struct rte_mbuf **mbs,
+	uint16_t nb_mbs, uint64_t tms, struct rte_mbuf **out)
+{
+	struct ip_frag_key key[IP_FRAG_BULK_SIZE];
+	uint32_t sig[IP_FRAG_BULK_SIZE][2];
+	uint16_t ofs[IP_FRAG_BULK_SIZE];
+	uint16_t more_frags[IP_FRAG_BULK_SIZE];
+	int32_t len[IP_FRAG_BULK_SIZE];
+	struct rte_ipv6_fragment_ext *frag_hdr;
+	struct rte_ipv6_hdr *ip_hdr;
+	struct ip_frag_pkt *fp;
+	struct rte_mbuf *mb;
+	uint16_t i, j, n, nb_out;
+
+	nb_out = 0;
+
+	for (i = 0; i < nb_mbs; i += n) {
+		n = RTE_MIN(nb_mbs - i, IP_FRAG_BULK_SIZE);
+
+		/* compute the keys and their hash values. */
+		for (j = 0; j != n; j++) {
+			mb = mbs[i + j];
+			ip_hdr = rte_pktmbuf_mtod_offset(mb,
+				struct rte_ipv6_hdr *, mb->l2_len);
+			frag_hdr = rte_ipv6_frag_get_ipv6_fragment_header(ip_hdr);
+			if (frag_hdr == NULL) {
+				len[j] = 0;
+				continue;
+			}
+
+			len[j] = ipv6_frag_prepare(mb, ip_hdr, frag_hdr, &key[j],
+				&ofs[j], &more_frags[j]);
+			if (len[j] > 0)
+				ip_frag_key_hash(&key[j], sig[j]);
+		}
+
+		/* prefetch the hash lines of the first fragments. */
+		for (j = 0; j != RTE_MIN(n, IP_FRAG_PREFETCH_AHEAD); j++) {
+			if (len[j] > 0)
+				ip_frag_prefetch(tbl, sig[j]);
+		}
+
+		/* add the fragments into the table. */
+		for (j = 0; j != n; j++) {
+			mb = mbs[i + j];
+
+			/* prefetch the hash lines of a next fragment. */
+			if (j + IP_FRAG_PREFETCH_AHEAD < n &&
+					len[j + IP_FRAG_PREFETCH_AHEAD] > 0)
+				ip_frag_prefetch(tbl,
+					sig[j + IP_FRAG_PREFETCH_AHEAD]);
+
+			/* check that fragment length is greater then zero. */
+			if (len[j] <= 0) {
+				IP_FRAG_MBUF2DR(dr, mb);
+				continue;
+			}
+
+			fp = ip_frag_find_hashed(tbl, dr, &key[j], tms, sig[j]);
+			if (fp == NULL) {
+				IP_FRAG_MBUF2DR(dr, mb);
+				continue;
+			}
+
+			mb = ip_frag_process(fp, dr, mb, ofs[j], len[j],
+				more_frags[j]);
+			ip_frag_inuse(tbl, fp);
+
+			/* out may be mbs, but only consumed slots are reused. */
+			if (mb != NULL)
+				out[nb_out++] = mb;
+		}
+	}
+
+	return nb_out;
+}
@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_common.h>
+#include <rte_vect.h>
+#include <rte_ip6.h>
+
+#include "lpm6.h"
+#include "lpm6_avx512.h"
+
+/*
+ * Load 16 addresses and put the 4 bytes chunk k
+ * of every address into dw[k]
+ */
+static __rte_always_inline void
+transpose_x16(const struct rte_ipv6_addr *ips, __m512i dw[4])
+{
+	__m512i a0, a1, a2, a3, lo, hi;
+	__m512i idx;
+	unsigned int k;
+
+	a0 = _mm512_loadu_si512(&ips[0]);
+	a1 = _mm512_loadu_si512(&ips[4]);
+	a2 = _mm512_loadu_si512(&ips[8]);
+	a3 = _mm512_loadu_si512(&ips[12]);
+
+	for (k = 0; k < 4; k++) {
+		idx = _mm512_add_epi32(_mm512_set1_epi32(k),
+			_mm512_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28,
+				0, 4, 8, 12, 16, 20, 24, 28));
+		lo = _mm512_permutex2var_epi32(a0, idx, a1);
+		hi = _mm512_permutex2var_epi32(a2, idx, a3);
+		dw[k] = _mm512_inserti64x4(lo, _mm512_castsi512_si256(hi), 1);
+	}
+}
+
+static __rte_always_inline void
+lpm6_lookup_x16(const uint32_t *tbl24, const uint32_t *tbl8,
+	const struct rte_ipv6_addr *ips, int32_t *next_hops)
+{
+	const __m512i ext = _mm512_set1_epi32(RTE_LPM6_VALID_EXT_ENTRY_BITMASK);
+	const __m512i nh_msk = _mm512_set1_epi32(RTE_LPM6_TBL8_BITMASK);
+	const __m512i byte_msk = _mm512_set1_epi32(UINT8_MAX);
+	__m512i dw[4], ent, idx, byte;
+	__mmask16 msk_ext, msk_hit;
+	unsigned int b;
+
+	/* the tbl8 index is computed with a shift */
+	RTE_BUILD_BUG_ON(RTE_LPM6_TBL8_GROUP_NUM_ENTRIES != 1 << 8);
+
+	transpose_x16(ips, dw);
+
+	/* the first 3 bytes of the addresses index tbl24 */
+	idx = _mm512_or_si512(_mm512_or_si512(
+		_mm512_slli_epi32(_mm512_and_si512(dw[0], byte_msk), 16),
+		_mm512_and_si512(dw[0], _mm512_set1_epi32(UINT8_MAX << 8))),
+		_mm512_and_si512(_mm512_srli_epi32(dw[0], 16), byte_msk));
+	ent = _mm512_i32gather_epi32(idx, (const void *)tbl24, 4);
+
+	/* all the lanes being resolved are at the same level */
+	for (b = LOOKUP_FIRST_BYTE - 1; b < RTE_IPV6_ADDR_SIZE; b++) {
+		msk_ext = _mm512_cmpeq_epi32_mask(_mm512_and_si512(ent, ext),
+			ext);
+		if (msk_ext == 0)
+			break;
+		byte = _mm512_and_si512(_mm512_srl_epi32(dw[b / 4],
+			_mm_cvtsi32_si128((b % 4) * 8)), byte_msk);
+		idx = _mm512_add_epi32(byte, _mm512_slli_epi32(
+			_mm512_and_si512(ent, nh_msk), 8));
+		ent = _mm512_mask_i32gather_epi32(ent, msk_ext, idx,
+			(const void *)tbl8, 4);
+	}
+
+	msk_hit = _mm512_test_epi32_mask(ent,
+		_mm512_set1_epi32(RTE_LPM6_LOOKUP_SUCCESS));
+	_mm512_storeu_si512(next_hops, _mm512_mask_and_epi32(
+		_mm512_set1_epi32(-1), msk_hit, ent, nh_msk));
+}
+
+unsigned int
+lpm6_lookup_bulk_avx512(const uint32_t *tbl24, const uint32_t *tbl8,
+	const struct rte_ipv6_addr *ips, int32_t *next_hops, unsigned int n)
+{
+	unsigned int i;
+
+	for (i = 0; i + 16 <= n; i += 16)
+		lpm6_lookup_x16(tbl24, tbl8, &ips[i], &next_hops[i]);
+	return i;
+}
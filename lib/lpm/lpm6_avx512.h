@@ -0,0 +1,21 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _LPM6_AVX512_H_
+#define _LPM6_AVX512_H_
+
+#include <stdint.h>
+
+struct rte_ipv6_addr;
+
+/*
+ * Look up the addresses by groups of 16, tbl24 and tbl8 being the
+ * tables of the LPM6 object.
+ * Return the number of addresses looked up, a multiple of 16.
+ */
+unsigned int
+lpm6_lookup_bulk_avx512(const uint32_t *tbl24, const uint32_t *tbl8,
+	const struct rte_ipv6_addr *ips, int32_t *next_hops, unsigned int n);
+
+#endif /* _LPM6_AVX512_H_ */
@@ -20,20 +20,21 @@
 #include <assert.h>
 #include <rte_jhash.h>
 #include <rte_tailq.h>
+#include <rte_prefetch.h>
+#include <rte_cpuflags.h>
+#include <rte_vect.h>
 
 #include "rte_lpm6.h"
+#include "lpm6.h"
 #include "lpm_log.h"
 
-#define RTE_LPM6_TBL24_NUM_ENTRIES        (1 << 24)
-#define RTE_LPM6_TBL8_GROUP_NUM_ENTRIES         256
-#define RTE_LPM6_TBL8_MAX_NUM_GROUPS      (1 << 21)
+#ifdef CC_AVX512_SUPPORT
+#include "lpm6_avx512.h"
+#endif
 
-#define RTE_LPM6_VALID_EXT_ENTRY_BITMASK 0xA0000000
-#define RTE_LPM6_LOOKUP_SUCCESS          0x20000000
-#define RTE_LPM6_TBL8_BITMASK            0x001FFFFF
+#define RTE_LPM6_TBL8_MAX_NUM_GROUPS      (1 << 21)
 
 #define ADD_FIRST_BYTE                            3
-#define LOOKUP_FIRST_BYTE                         4
 #define BYTE_SIZE                                 8
 #define BYTES2_SIZE                              16
 
@@ -42,6 +43,15 @@
 
 #define lpm6_tbl8_gindex next_hop
 
+/** Number of addresses looked up in lock-step by the scalar bulk lookup. */
+#define LOOKUP_BULK_GROUP                         16
+
+/** Bulk lookup implementations, stored as an index for multi-process. */
+enum lpm6_lookup_fn {
+	LPM6_LOOKUP_SCALAR = 0,
+	LPM6_LOOKUP_AVX512,
+};
+
 /** Flags for setting an entry as valid/invalid. */
 enum valid_flag {
 	INVALID = 0,
@@ -97,6 +107,7 @@ struct rte_lpm6 {
 	uint32_t max_rules;              /**< Max number of rules. */
 	uint32_t used_rules;             /**< Used rules so far. */
 	uint32_t number_tbl8s;           /**< Number of tbl8s to allocate. */
+	enum lpm6_lookup_fn lookup_fn;   /**< Bulk lookup implementation. */
 
 	/* LPM Tables. */
 	struct rte_hash *rules_tbl; /**< LPM rules. */
@@ -325,6 +336,12 @@ rte_lpm6_create(const char *name, int socket_id,
 	lpm->rules_tbl = rules_tbl;
 	lpm->tbl8_pool = tbl8_pool;
 	lpm->tbl8_hdrs = tbl8_hdrs;
+	lpm->lookup_fn = LPM6_LOOKUP_SCALAR;
+#ifdef CC_AVX512_SUPPORT
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) > 0 &&
+			rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512)
+		lpm->lookup_fn = LPM6_LOOKUP_AVX512;
+#endif
 
 	/* init the stack */
 	tbl8_pool_init(lpm);
@@ -943,6 +960,50 @@ rte_lpm6_lookup(const struct rte_lpm6 *lpm, const struct rte_ipv6_addr *ip,
 	return status;
 }
 
+/*
+ * Looks up at most LOOKUP_BULK_GROUP IP addresses in lock-step,
+ * so that the table entries of all the addresses are fetched in parallel
+ */
+static inline void
+lookup_bulk_group(const struct rte_lpm6 *lpm,
+		const struct rte_ipv6_addr *ips,
+		int32_t *next_hops, unsigned int n)
+{
+	const struct rte_lpm6_tbl_entry *tbl[LOOKUP_BULK_GROUP];
+	uint32_t tbl24_index, tbl8_index, tbl_entry;
+	uint32_t active = 0, todo;
+	unsigned int i;
+	uint8_t first_byte;
+
+	for (i = 0; i < n; i++) {
+		tbl24_index = (ips[i].a[0] << BYTES2_SIZE) |
+				(ips[i].a[1] << BYTE_SIZE) | ips[i].a[2];
+		tbl[i] = &lpm->tbl24[tbl24_index];
+		rte_prefetch0(tbl[i]);
+		active |= 1U << i;
+	}
+
+	for (first_byte = LOOKUP_FIRST_BYTE; active != 0; first_byte++) {
+		for (todo = active; todo != 0; todo &= todo - 1) {
+			i = rte_ctz32(todo);
+			tbl_entry = *(const uint32_t *)tbl[i];
+			if ((tbl_entry & RTE_LPM6_VALID_EXT_ENTRY_BITMASK) ==
+					RTE_LPM6_VALID_EXT_ENTRY_BITMASK) {
+				tbl8_index = ips[i].a[first_byte - 1] +
+					((tbl_entry & RTE_LPM6_TBL8_BITMASK) *
+					RTE_LPM6_TBL8_GROUP_NUM_ENTRIES);
+				tbl[i] = &lpm->tbl8[tbl8_index];
+				rte_prefetch0(tbl[i]);
+				continue;
+			}
+			next_hops[i] = (tbl_entry & RTE_LPM6_LOOKUP_SUCCESS) ?
+				(int32_t)(tbl_entry & RTE_LPM6_TBL8_BITMASK) :
+				-1;
+			active &= ~(1U << i);
+		}
+	}
+}
+
 /*
  * Looks up a group of IP addresses
  */
@@ -952,39 +1013,21 @@ rte_lpm6_lookup_bulk_func(const struct rte_lpm6 *lpm,
 		struct rte_ipv6_addr *ips,
 		int32_t *next_hops, unsigned int n)
 {
-	unsigned int i;
-	const struct rte_lpm6_tbl_entry *tbl;
-	const struct rte_lpm6_tbl_entry *tbl_next = NULL;
-	uint32_t tbl24_index, next_hop;
-	uint8_t first_byte;
-	int status;
+	unsigned int i = 0;
 
 	/* DEBUG: Check user input arguments. */
 	if ((lpm == NULL) || (ips == NULL) || (next_hops == NULL))
 		return -EINVAL;
 
-	for (i = 0; i < n; i++) {
-		first_byte = LOOKUP_FIRST_BYTE;
-		tbl24_index = (ips[i].a[0] << BYTES2_SIZE) |
-				(ips[i].a[1] << BYTE_SIZE) | ips[i].a[2];
-
-		/* Calculate pointer to the first entry to be inspected */
-		tbl = &lpm->tbl24[tbl24_index];
+#ifdef CC_AVX512_SUPPORT
+	if (lpm->lookup_fn == LPM6_LOOKUP_AVX512)
+		i = lpm6_lookup_bulk_avx512((const uint32_t *)lpm->tbl24,
+			(const uint32_t *)lpm->tbl8, ips, next_hops, n);
+#endif
 
-		do {
-			/* Continue inspecting following levels
-			 * until success or failure
-			 */
-			status = lookup_step(lpm, tbl, &tbl_next, &ips[i],
-					first_byte++, &next_hop);
-			tbl = tbl_next;
-		} while (status == 1);
-
-		if (status < 0)
-			next_hops[i] = -1;
-		else
-			next_hops[i] = (int32_t)next_hop;
-	}
+	for (; i < n; i += LOOKUP_BULK_GROUP)
+		lookup_bulk_group(lpm, &ips[i], &next_hops[i],
+			RTE_MIN(n - i, (unsigned int)LOOKUP_BULK_GROUP));
 
 	return 0;
 }
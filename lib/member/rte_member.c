@@ -17,6 +17,8 @@
 #include "rte_member_ht.h"
 #include "rte_member_vbf.h"
 #include "rte_member_sketch.h"
+#include "rte_member_cf.h"
+#include "rte_member_bbf.h"
 
 TAILQ_HEAD(rte_member_list, rte_tailq_entry);
 static struct rte_tailq_elem rte_member_tailq = {
@@ -81,6 +83,12 @@ rte_member_free(struct rte_member_setsum *setsum)
 	case RTE_MEMBER_TYPE_SKETCH:
 		rte_member_free_sketch(setsum);
 		break;
+	case RTE_MEMBER_TYPE_CF:
+		rte_member_free_cf(setsum);
+		break;
+	case RTE_MEMBER_TYPE_BBF:
+		rte_member_free_bbf(setsum);
+		break;
 	default:
 		break;
 	}
@@ -170,6 +178,12 @@ rte_member_create(const struct rte_member_parameters *params)
 	case RTE_MEMBER_TYPE_SKETCH:
 		ret = rte_member_create_sketch(setsum, params, sketch_key_ring);
 		break;
+	case RTE_MEMBER_TYPE_CF:
+		ret = rte_member_create_cf(setsum, params);
+		break;
+	case RTE_MEMBER_TYPE_BBF:
+		ret = rte_member_create_bbf(setsum, params);
+		break;
 	default:
 		goto error_unlock_exit;
 	}
@@ -207,6 +221,10 @@ rte_member_add(const struct rte_member_setsum *setsum, const void *key,
 		return rte_member_add_vbf(setsum, key, set_id);
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_add_sketch(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_CF:
+		return rte_member_add_cf(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_BBF:
+		return rte_member_add_bbf(setsum, key, set_id);
 	default:
 		return -EINVAL;
 	}
@@ -243,6 +261,10 @@ rte_member_lookup(const struct rte_member_setsum *setsum, const void *key,
 		return rte_member_lookup_vbf(setsum, key, set_id);
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_lookup_sketch(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_CF:
+		return rte_member_lookup_cf(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_BBF:
+		return rte_member_lookup_bbf(setsum, key, set_id);
 	default:
 		return -EINVAL;
 	}
@@ -264,6 +286,12 @@ rte_member_lookup_bulk(const struct rte_member_setsum *setsum,
 	case RTE_MEMBER_TYPE_VBF:
 		return rte_member_lookup_bulk_vbf(setsum, keys, num_keys,
 				set_ids);
+	case RTE_MEMBER_TYPE_CF:
+		return rte_member_lookup_bulk_cf(setsum, keys, num_keys,
+				set_ids);
+	case RTE_MEMBER_TYPE_BBF:
+		return rte_member_lookup_bulk_bbf(setsum, keys, num_keys,
+				set_ids);
 	default:
 		return -EINVAL;
 	}
@@ -355,10 +383,13 @@ rte_member_delete(const struct rte_member_setsum *setsum, const void *key,
 	switch (setsum->type) {
 	case RTE_MEMBER_TYPE_HT:
 		return rte_member_delete_ht(setsum, key, set_id);
-	/* current vBF implementation does not support delete function */
+	case RTE_MEMBER_TYPE_CF:
+		return rte_member_delete_cf(setsum, key);
+	/* current vBF and BBF implementations do not support delete function */
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_delete_sketch(setsum, key);
 	case RTE_MEMBER_TYPE_VBF:
+	case RTE_MEMBER_TYPE_BBF:
 	default:
 		return -EINVAL;
 	}
@@ -380,6 +411,12 @@ rte_member_reset(const struct rte_member_setsum *setsum)
 	case RTE_MEMBER_TYPE_SKETCH:
 		rte_member_reset_sketch(setsum);
 		return;
+	case RTE_MEMBER_TYPE_CF:
+		rte_member_reset_cf(setsum);
+		return;
+	case RTE_MEMBER_TYPE_BBF:
+		rte_member_reset_bbf(setsum);
+		return;
 	default:
 		return;
 	}
@@ -13,8 +13,10 @@
  * used to test if a key belongs to certain sets. Two types of such
  * "set-summary" structures are implemented: hash-table based (HT) and vector
  * bloom filter (vBF). For HT setsummary, two subtypes or modes are available,
- * cache and non-cache modes. The table below summarize some properties of
- * the different implementations.
+ * cache and non-cache modes. The cuckoo filter (CF) and the blocked bloom
+ * filter (BBF) test if a key belongs to a single set, with less memory per
+ * key. The table below summarize some properties of the different
+ * implementations.
  */
 
 /**
@@ -48,6 +50,21 @@
  * |properties| used for heavy hitter       |
  * |          | detection.                  |
  * +----------+-----------------------------+
+ * +==========+=====================+======================+
+ * |   type   |      CF             |     BBF              |
+ * +==========+=====================+======================+
+ * |structure | cuckoo filter with  | bloom filter of      |
+ * |          | packed fingerprints | cache line blocks    |
+ * +----------+---------------------+----------------------+
+ * |set id    | 1: single set       | 1: single set        |
+ * +----------+---------------------+----------------------+
+ * |usages &  | can delete,         | no deletion support, |
+ * |properties| user-specified      | user-specified       |
+ * |          | false-positive rate,| false-positive rate, |
+ * |          | fingerprint size    | one cache line read  |
+ * |          | from the rate,      | per lookup, SIMD     |
+ * |          | can become full.    | bulk lookup.         |
+ * +----------+---------------------+----------------------+
  * -->
  */
 
@@ -106,6 +123,8 @@ enum rte_member_setsum_type {
 	RTE_MEMBER_TYPE_HT = 0,  /**< Hash table based set summary. */
 	RTE_MEMBER_TYPE_VBF,     /**< Vector of bloom filters. */
 	RTE_MEMBER_TYPE_SKETCH,
+	RTE_MEMBER_TYPE_CF,      /**< Cuckoo filter. */
+	RTE_MEMBER_TYPE_BBF,     /**< Blocked bloom filter. */
 	RTE_MEMBER_NUM_TYPE
 };
 
@@ -113,6 +132,7 @@ enum rte_member_setsum_type {
 enum rte_member_sig_compare_function {
 	RTE_MEMBER_COMPARE_SCALAR = 0,
 	RTE_MEMBER_COMPARE_AVX2,
+	RTE_MEMBER_COMPARE_AVX512,
 	RTE_MEMBER_COMPARE_NUM
 };
 
@@ -176,6 +196,10 @@ struct __rte_cache_aligned rte_member_setsum {
 #ifdef RTE_ARCH_X86
 	bool use_avx512;
 #endif
+
+	/* Cuckoo filter, bucket_cnt is the number of buckets. */
+	uint32_t fp_bits;		/* Number of bits of a fingerprint. */
+	uint64_t fp_lanes;		/* Lowest bit of each bucket entry. */
 };
 
 /**
@@ -195,6 +219,10 @@ struct __rte_cache_aligned rte_member_parameters {
 	 *
 	 * vBF setsummary is a vector of bloom filters. It is used when number
 	 * of sets is not big (less than 32 for current implementation).
+	 *
+	 * CF and BBF setsummaries are cuckoo and blocked bloom filters for
+	 * a single set, with set ID 1. CF supports deletion, BBF does not,
+	 * but its lookups read only one cache line per key.
 	 */
 	enum rte_member_setsum_type type;
 
@@ -234,6 +262,10 @@ struct __rte_cache_aligned rte_member_parameters {
 	 * number of bits we need for each BF. User does not specify the size of
 	 * each BF directly because the optimal size depends on the num_keys
 	 * and false positive rate.
+	 *
+	 * For CF, num_keys is the number of keys the filter is sized for,
+	 * inserts may fail with -ENOSPC when it is reached.
+	 * For BBF, num_keys is the expected number of keys, as for vBF.
 	 */
 	uint32_t num_keys;
 
@@ -264,6 +296,12 @@ struct __rte_cache_aligned rte_member_parameters {
 	 * hash values used during lookup and insertion. For details please
 	 * refer to vBF implementation and membership library documentation.
 	 *
+	 * For CF, false_positive_rate gives the number of bits of the
+	 * fingerprints, which is also the number of bits used per entry:
+	 * false_pos = 8 / 2^bits, e.g. 10 bits for 1%.
+	 * For BBF, false_positive_rate gives the number of bits of the filter,
+	 * e.g. about 10.5 bits per key for 1%.
+	 *
 	 * For HT, This parameter is not directly set by users.
 	 * HT setsummary's false positive rate is in the order of:
 	 * false_pos = (1/bucket_count)*(1/2^16), since we use 16-bit signature.
@@ -464,6 +502,7 @@ rte_member_lookup_multi_bulk(const struct rte_member_setsum *setsum,
  *   For HT mode, the set_id has range as [1, 0x7FFF], MSB is reserved.
  *   For vBF mode the set id is limited by the num_set parameter when create
  *   the set-summary. For sketch mode, this id is ignored.
+ *   For CF and BBF modes, the set id must be 1.
  * @return
  *   HT (cache mode) and vBF should never fail unless the set_id is not in the
  *   valid range. In such case -EINVAL is returned.
@@ -474,7 +513,8 @@ rte_member_lookup_multi_bulk(const struct rte_member_setsum *setsum,
  *   Return 0 for HT (cache mode) if the add does not cause
  *   eviction, return 1 otherwise. Return 0 for non-cache mode if success,
  *   -ENOSPC for full, and 1 if cuckoo eviction happens.
- *   Always returns 0 for vBF mode and sketch.
+ *   CF mode returns the same values as HT non-cache mode.
+ *   Always returns 0 for vBF mode, BBF mode and sketch.
  */
 int
 rte_member_add(const struct rte_member_setsum *setsum, const void *key,
@@ -541,8 +581,12 @@ void
 rte_member_reset(const struct rte_member_setsum *setsum);
 
 /**
- * Delete items from the set-summary. Note that vBF does not support deletion
- * in current implementation. For vBF, error code of -EINVAL will be returned.
+ * Delete items from the set-summary. Note that vBF and BBF do not support
+ * deletion in current implementation. For them, error code of -EINVAL
+ * will be returned.
+ * For CF, a key added several times must be deleted as many times, and
+ * only keys that were added can be deleted, otherwise the entry of another
+ * key with the same fingerprint may be deleted.
  *
  * @param setsum
  *   Pointer to the set-summary.
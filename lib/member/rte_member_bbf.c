@@ -0,0 +1,260 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_prefetch.h>
+#include <rte_log.h>
+#include <rte_vect.h>
+#include <rte_cpuflags.h>
+
+#include "member.h"
+#include "rte_member.h"
+#include "rte_member_bbf.h"
+
+#ifdef RTE_ARCH_X86_64
+#include "rte_member_bbf_avx2.h"
+#ifdef CC_AVX512_SUPPORT
+#include "rte_member_bbf_avx512.h"
+#endif
+#endif
+
+/*
+ * The blocked bloom filter is an array of 256-bit blocks, aligned so that
+ * two blocks share a cache line. A key selects one block, and sets one bit
+ * in each 32-bit word of the block, so that a lookup reads a single
+ * cache line and tests all its bits at once with a 256-bit vector.
+ * The bit of each word is given by the upper bits of the product of the
+ * key hash with a different odd multiplier per word, as in the split block
+ * bloom filter used by Apache Parquet.
+ */
+
+static const uint32_t bbf_salts[RTE_MEMBER_BBF_BLOCK_WORDS] = {
+	RTE_MEMBER_BBF_SALTS
+};
+
+static inline void
+get_block_index(const struct rte_member_setsum *ss, const void *key,
+		uint32_t *block, uint32_t *hash)
+{
+	uint32_t first_hash = MEMBER_HASH_FUNC(key, ss->key_len,
+						ss->prim_hash_seed);
+
+	/*
+	 * The first hash value selects the block,
+	 * the second one selects the bits in the block.
+	 */
+	*block = ((uint64_t)first_hash * ss->bucket_cnt) >> 32;
+	*hash = MEMBER_HASH_FUNC(&first_hash, sizeof(uint32_t),
+			ss->sec_hash_seed);
+}
+
+static inline uint32_t
+bbf_bit(uint32_t hash, uint32_t word)
+{
+	return 1U << ((hash * bbf_salts[word]) >> 27);
+}
+
+static inline int
+bbf_test(const struct member_bbf_block *block, uint32_t hash)
+{
+	uint32_t i, bit;
+
+	for (i = 0; i < RTE_MEMBER_BBF_BLOCK_WORDS; i++) {
+		bit = bbf_bit(hash, i);
+		if ((block->words[i] & bit) != bit)
+			return 0;
+	}
+	return 1;
+}
+
+static uint32_t
+bbf_lookup_bulk_scalar(const struct member_bbf_block *blocks,
+		const uint32_t *block_idx, const uint32_t *hash,
+		uint32_t num_keys, member_set_t *set_ids)
+{
+	uint32_t i, num_matches = 0;
+
+	for (i = 0; i < num_keys; i++) {
+		set_ids[i] = bbf_test(&blocks[block_idx[i]], hash[i]);
+		num_matches += set_ids[i];
+	}
+	return num_matches;
+}
+
+/*
+ * False positive rate of the filter, the number of keys in a block
+ * follows a Poisson distribution of mean keys / blocks.
+ */
+static double
+bbf_false_positive_rate(uint32_t num_keys, uint32_t num_blocks)
+{
+	const uint32_t word_bits = sizeof(uint32_t) * 8;
+	double mean = (double)num_keys / num_blocks;
+	double fpr = 0, p;
+	uint32_t k, max_k;
+
+	max_k = mean + 10 * sqrt(mean) + 10;
+	for (k = 0; k <= max_k; k++) {
+		p = exp(k * log(mean) - mean - lgamma(k + 1));
+		fpr += p * pow(1 - pow(1 - 1.0 / word_bits, k),
+				RTE_MEMBER_BBF_BLOCK_WORDS);
+	}
+	return fpr;
+}
+
+int
+rte_member_create_bbf(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params)
+{
+	const uint32_t block_bits = sizeof(struct member_bbf_block) * 8;
+	uint64_t num_blocks;
+	double bits;
+
+	if (params->num_keys == 0 ||
+			params->false_positive_rate <= 0 ||
+			params->false_positive_rate >= 1) {
+		rte_errno = EINVAL;
+		MEMBER_LOG(ERR,
+			"Membership blocked bloom filter create with invalid parameters");
+		return -EINVAL;
+	}
+
+	/*
+	 * With k bits per key set in k different words, a standard bloom
+	 * filter needs -k * n / ln(1 - fp^(1/k)) bits for a false positive
+	 * rate fp. Blocks are more loaded than the average by chance,
+	 * so grow the filter until the rate of the blocked filter is met.
+	 */
+	bits = -(double)RTE_MEMBER_BBF_BLOCK_WORDS * params->num_keys /
+			log(1 - pow(params->false_positive_rate,
+				1.0 / RTE_MEMBER_BBF_BLOCK_WORDS));
+	num_blocks = ceil(bits / block_bits);
+	while (num_blocks < RTE_MEMBER_ENTRIES_MAX &&
+			bbf_false_positive_rate(params->num_keys, num_blocks) >
+			params->false_positive_rate)
+		num_blocks += num_blocks / 64 + 1;
+	if (num_blocks >= RTE_MEMBER_ENTRIES_MAX) {
+		rte_errno = EINVAL;
+		MEMBER_LOG(ERR, "Membership blocked bloom filter is too big");
+		return -EINVAL;
+	}
+
+	ss->num_set = 1;
+	ss->bucket_cnt = num_blocks;
+
+	ss->table = rte_zmalloc_socket(NULL,
+			(size_t)ss->bucket_cnt * sizeof(struct member_bbf_block),
+			RTE_CACHE_LINE_SIZE, ss->socket_id);
+	if (ss->table == NULL) {
+		MEMBER_LOG(ERR, "memory allocation failed for blocked bloom "
+				"filter setsummary");
+		return -ENOMEM;
+	}
+
+	ss->sig_cmp_fn = RTE_MEMBER_COMPARE_SCALAR;
+#ifdef RTE_ARCH_X86_64
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) &&
+			rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_256)
+		ss->sig_cmp_fn = RTE_MEMBER_COMPARE_AVX2;
+#ifdef CC_AVX512_SUPPORT
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) &&
+			rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512)
+		ss->sig_cmp_fn = RTE_MEMBER_COMPARE_AVX512;
+#endif
+#endif
+
+	MEMBER_LOG(DEBUG, "Blocked bloom filter created, "
+			"the table has %u blocks of %u bits, "
+			"%.2f bits per key, "
+			"false positive rate is about %.5f",
+			ss->bucket_cnt, block_bits,
+			(double)ss->bucket_cnt * block_bits / params->num_keys,
+			bbf_false_positive_rate(params->num_keys,
+				ss->bucket_cnt));
+	return 0;
+}
+
+int
+rte_member_lookup_bbf(const struct rte_member_setsum *ss, const void *key,
+		member_set_t *set_id)
+{
+	const struct member_bbf_block *blocks = ss->table;
+	uint32_t block, hash;
+
+	get_block_index(ss, key, &block, &hash);
+
+	if (bbf_test(&blocks[block], hash)) {
+		*set_id = 1;
+		return 1;
+	}
+
+	*set_id = RTE_MEMBER_NO_MATCH;
+	return 0;
+}
+
+uint32_t
+rte_member_lookup_bulk_bbf(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, member_set_t *set_ids)
+{
+	const struct member_bbf_block *blocks = ss->table;
+	uint32_t block_idx[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t hash[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		get_block_index(ss, keys[i], &block_idx[i], &hash[i]);
+		rte_prefetch0(&blocks[block_idx[i]]);
+	}
+
+	switch (ss->sig_cmp_fn) {
+#ifdef RTE_ARCH_X86_64
+#ifdef CC_AVX512_SUPPORT
+	case RTE_MEMBER_COMPARE_AVX512:
+		return bbf_lookup_bulk_avx512(blocks, block_idx, hash,
+				num_keys, set_ids);
+#endif
+	case RTE_MEMBER_COMPARE_AVX2:
+		return bbf_lookup_bulk_avx2(blocks, block_idx, hash,
+				num_keys, set_ids);
+#endif
+	default:
+		return bbf_lookup_bulk_scalar(blocks, block_idx, hash,
+				num_keys, set_ids);
+	}
+}
+
+int
+rte_member_add_bbf(const struct rte_member_setsum *ss,
+		const void *key, member_set_t set_id)
+{
+	struct member_bbf_block *blocks = ss->table;
+	uint32_t i, block, hash;
+
+	/* The blocked bloom filter holds a single set */
+	if (set_id != 1)
+		return -EINVAL;
+
+	get_block_index(ss, key, &block, &hash);
+
+	for (i = 0; i < RTE_MEMBER_BBF_BLOCK_WORDS; i++)
+		blocks[block].words[i] |= bbf_bit(hash, i);
+	return 0;
+}
+
+void
+rte_member_free_bbf(struct rte_member_setsum *ss)
+{
+	rte_free(ss->table);
+}
+
+void
+rte_member_reset_bbf(const struct rte_member_setsum *ss)
+{
+	memset(ss->table, 0,
+			(size_t)ss->bucket_cnt * sizeof(struct member_bbf_block));
+}
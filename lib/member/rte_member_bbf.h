@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_MEMBER_BBF_H_
+#define _RTE_MEMBER_BBF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of 32-bit words in a block, a key sets one bit in each word. */
+#define RTE_MEMBER_BBF_BLOCK_WORDS 8
+
+/* Multipliers giving the bit to set in each word of a block. */
+#define RTE_MEMBER_BBF_SALTS \
+	0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, \
+	0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+
+/* The block struct for blocked bloom filter setsum, two per cache line */
+struct __rte_aligned(32) member_bbf_block {
+	uint32_t words[RTE_MEMBER_BBF_BLOCK_WORDS];
+};
+
+int
+rte_member_create_bbf(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params);
+
+int
+rte_member_lookup_bbf(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t *set_id);
+
+uint32_t
+rte_member_lookup_bulk_bbf(const struct rte_member_setsum *setsum,
+		const void **keys, uint32_t num_keys,
+		member_set_t *set_ids);
+
+int
+rte_member_add_bbf(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t set_id);
+
+void
+rte_member_free_bbf(struct rte_member_setsum *ss);
+
+void
+rte_member_reset_bbf(const struct rte_member_setsum *setsum);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_MEMBER_BBF_H_ */
@@ -0,0 +1,35 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include "rte_member_bbf_avx2.h"
+
+/* Bits of a block a key with this hash sets, one per 32-bit lane */
+static __rte_always_inline __m256i
+bbf_mask_avx2(uint32_t hash)
+{
+	const __m256i salts = _mm256_setr_epi32(RTE_MEMBER_BBF_SALTS);
+	__m256i bit;
+
+	bit = _mm256_srli_epi32(
+		_mm256_mullo_epi32(_mm256_set1_epi32(hash), salts), 27);
+	return _mm256_sllv_epi32(_mm256_set1_epi32(1), bit);
+}
+
+uint32_t
+bbf_lookup_bulk_avx2(const struct member_bbf_block *blocks,
+		const uint32_t *block_idx, const uint32_t *hash,
+		uint32_t num_keys, member_set_t *set_ids)
+{
+	uint32_t i, num_matches = 0;
+	__m256i block;
+
+	for (i = 0; i < num_keys; i++) {
+		block = _mm256_load_si256(
+				(const __m256i *)&blocks[block_idx[i]]);
+		/* all the bits of the mask are set in the block */
+		set_ids[i] = _mm256_testc_si256(block, bbf_mask_avx2(hash[i]));
+		num_matches += set_ids[i];
+	}
+	return num_matches;
+}
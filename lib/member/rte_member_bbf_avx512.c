@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include "rte_member_bbf_avx512.h"
+
+/*
+ * Probe the blocks of two keys at once,
+ * the first key in the lower 256 bits and the second one in the upper bits.
+ */
+uint32_t
+bbf_lookup_bulk_avx512(const struct member_bbf_block *blocks,
+		const uint32_t *block_idx, const uint32_t *hash,
+		uint32_t num_keys, member_set_t *set_ids)
+{
+	const __m512i salts = _mm512_broadcast_i64x4(
+			_mm256_setr_epi32(RTE_MEMBER_BBF_SALTS));
+	const __m512i ones = _mm512_set1_epi32(1);
+	uint32_t i, num_matches = 0;
+	__m512i h, mask, block, missing;
+	__mmask16 miss;
+
+	for (i = 0; i + 1 < num_keys; i += 2) {
+		h = _mm512_inserti64x4(
+			_mm512_castsi256_si512(_mm256_set1_epi32(hash[i])),
+			_mm256_set1_epi32(hash[i + 1]), 1);
+		mask = _mm512_sllv_epi32(ones, _mm512_srli_epi32(
+				_mm512_mullo_epi32(h, salts), 27));
+
+		block = _mm512_inserti64x4(_mm512_castsi256_si512(
+				_mm256_load_si256((const __m256i *)
+					&blocks[block_idx[i]])),
+			_mm256_load_si256((const __m256i *)
+				&blocks[block_idx[i + 1]]), 1);
+
+		/* lanes where a bit of the mask is not set in the block */
+		missing = _mm512_andnot_si512(block, mask);
+		miss = _mm512_test_epi32_mask(missing, missing);
+
+		set_ids[i] = (miss & 0xff) == 0;
+		set_ids[i + 1] = (miss >> 8) == 0;
+		num_matches += set_ids[i] + set_ids[i + 1];
+	}
+
+	if (i < num_keys) {
+		h = _mm512_set1_epi32(hash[i]);
+		mask = _mm512_sllv_epi32(ones, _mm512_srli_epi32(
+				_mm512_mullo_epi32(h, salts), 27));
+		block = _mm512_castsi256_si512(_mm256_load_si256(
+				(const __m256i *)&blocks[block_idx[i]]));
+		missing = _mm512_andnot_si512(block, mask);
+		miss = _mm512_mask_test_epi32_mask(0xff, missing, missing);
+
+		set_ids[i] = miss == 0;
+		num_matches += set_ids[i];
+	}
+	return num_matches;
+}
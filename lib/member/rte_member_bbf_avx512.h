@@ -0,0 +1,25 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef RTE_MEMBER_BBF_AVX512_H
+#define RTE_MEMBER_BBF_AVX512_H
+
+#include <rte_vect.h>
+#include "rte_member.h"
+#include "rte_member_bbf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t
+bbf_lookup_bulk_avx512(const struct member_bbf_block *blocks,
+		const uint32_t *block_idx, const uint32_t *hash,
+		uint32_t num_keys, member_set_t *set_ids);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTE_MEMBER_BBF_AVX512_H */
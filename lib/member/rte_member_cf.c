@@ -0,0 +1,381 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <rte_byteorder.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_prefetch.h>
+#include <rte_random.h>
+#include <rte_log.h>
+
+#include "member.h"
+#include "rte_member.h"
+#include "rte_member_cf.h"
+
+/*
+ * The cuckoo filter is an array of buckets of RTE_MEMBER_CF_BUCKET_ENTRIES
+ * fingerprints of fp_bits each, as proposed by B. Fan, et al's paper
+ * "Cuckoo Filter: Practically Better Than Bloom".
+ * The buckets are packed in a bit array with no padding, so that the filter
+ * uses fp_bits per entry, and a bucket is read or written as a single
+ * unaligned 64-bit word, where its entries are lanes of fp_bits.
+ * A zero fingerprint marks an empty entry.
+ *
+ * A key maps to a primary bucket and to an alternative bucket derived from
+ * the primary one and the fingerprint only, so that fingerprints can be
+ * relocated and deleted without the key.
+ * Since the number of buckets is not a power of 2, the alternative bucket is
+ * (hash(fingerprint) - bucket) modulo the number of buckets, instead of xor.
+ * This is its own inverse as well.
+ */
+
+/* Multiplier used to hash the fingerprints */
+#define CF_FP_HASH_MUL 0x5bd1e995
+
+/* Number of bytes needed to store a bucket at any bit offset */
+#define CF_BUCKET_PADDING sizeof(uint64_t)
+
+static inline uint64_t
+cf_table_size(const struct rte_member_setsum *ss)
+{
+	return ((uint64_t)ss->bucket_cnt * RTE_MEMBER_CF_BUCKET_ENTRIES *
+			ss->fp_bits + 7) / 8 + CF_BUCKET_PADDING;
+}
+
+static inline uint32_t
+cf_fp_mask(const struct rte_member_setsum *ss)
+{
+	return (1U << ss->fp_bits) - 1;
+}
+
+static inline uint64_t
+cf_bucket_mask(const struct rte_member_setsum *ss)
+{
+	return ss->fp_lanes * cf_fp_mask(ss);
+}
+
+static inline uint64_t
+cf_bucket_bit(const struct rte_member_setsum *ss, uint32_t bucket)
+{
+	return (uint64_t)bucket * RTE_MEMBER_CF_BUCKET_ENTRIES * ss->fp_bits;
+}
+
+static inline const void *
+cf_bucket_addr(const struct rte_member_setsum *ss, uint32_t bucket)
+{
+	return (const uint8_t *)ss->table + (cf_bucket_bit(ss, bucket) >> 3);
+}
+
+/* Read all the entries of a bucket */
+static inline uint64_t
+cf_bucket_read(const struct rte_member_setsum *ss, uint32_t bucket)
+{
+	uint64_t bit = cf_bucket_bit(ss, bucket);
+	uint64_t word;
+
+	memcpy(&word, (const uint8_t *)ss->table + (bit >> 3), sizeof(word));
+	return (rte_le_to_cpu_64(word) >> (bit & 7)) & cf_bucket_mask(ss);
+}
+
+/* Write all the entries of a bucket, keeping the bits around it */
+static inline void
+cf_bucket_write(const struct rte_member_setsum *ss, uint32_t bucket,
+		uint64_t entries)
+{
+	uint64_t bit = cf_bucket_bit(ss, bucket);
+	uint8_t *p = (uint8_t *)ss->table + (bit >> 3);
+	uint64_t word;
+
+	memcpy(&word, p, sizeof(word));
+	word = rte_le_to_cpu_64(word);
+	word &= ~(cf_bucket_mask(ss) << (bit & 7));
+	word |= entries << (bit & 7);
+	word = rte_cpu_to_le_64(word);
+	memcpy(p, &word, sizeof(word));
+}
+
+static inline uint32_t
+cf_entry_get(const struct rte_member_setsum *ss, uint64_t entries,
+		uint32_t idx)
+{
+	return (entries >> (idx * ss->fp_bits)) & cf_fp_mask(ss);
+}
+
+static inline uint64_t
+cf_entry_set(const struct rte_member_setsum *ss, uint64_t entries,
+		uint32_t idx, uint32_t fp)
+{
+	uint32_t shift = idx * ss->fp_bits;
+
+	return (entries & ~((uint64_t)cf_fp_mask(ss) << shift)) |
+			((uint64_t)fp << shift);
+}
+
+/* Check if any entry of the bucket holds the fingerprint, without a loop */
+static inline int
+cf_bucket_has(const struct rte_member_setsum *ss, uint64_t entries,
+		uint32_t fp)
+{
+	uint64_t x = entries ^ (ss->fp_lanes * fp);
+
+	return ((x - ss->fp_lanes) & ~x &
+			(ss->fp_lanes << (ss->fp_bits - 1))) != 0;
+}
+
+/* Index of the first entry holding the fingerprint, -1 if none */
+static inline int
+cf_bucket_find(const struct rte_member_setsum *ss, uint64_t entries,
+		uint32_t fp)
+{
+	uint32_t i;
+
+	for (i = 0; i < RTE_MEMBER_CF_BUCKET_ENTRIES; i++) {
+		if (cf_entry_get(ss, entries, i) == fp)
+			return i;
+	}
+	return -1;
+}
+
+static inline uint32_t
+cf_alt_bucket(const struct rte_member_setsum *ss, uint32_t bucket,
+		uint32_t fp)
+{
+	uint32_t h = ((uint64_t)(fp * CF_FP_HASH_MUL) * ss->bucket_cnt) >> 32;
+
+	return h >= bucket ? h - bucket : h + ss->bucket_cnt - bucket;
+}
+
+static inline void
+get_buckets_index(const struct rte_member_setsum *ss, const void *key,
+		uint32_t *prim_bkt, uint32_t *sec_bkt, uint32_t *fp)
+{
+	uint32_t first_hash = MEMBER_HASH_FUNC(key, ss->key_len,
+						ss->prim_hash_seed);
+	uint32_t sec_hash = MEMBER_HASH_FUNC(&first_hash, sizeof(uint32_t),
+						ss->sec_hash_seed);
+
+	/*
+	 * The first hash value gives the fingerprint, zero is reserved
+	 * for empty entries. The second hash value gives the primary bucket.
+	 */
+	*fp = first_hash & cf_fp_mask(ss);
+	if (*fp == 0)
+		*fp = 1;
+	*prim_bkt = ((uint64_t)sec_hash * ss->bucket_cnt) >> 32;
+	*sec_bkt = cf_alt_bucket(ss, *prim_bkt, *fp);
+}
+
+int
+rte_member_create_cf(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params)
+{
+	uint64_t num_buckets;
+	uint32_t fp_bits, i;
+
+	if (params->num_keys == 0 ||
+			params->num_keys > RTE_MEMBER_ENTRIES_MAX ||
+			params->false_positive_rate <= 0 ||
+			params->false_positive_rate > 1) {
+		rte_errno = EINVAL;
+		MEMBER_LOG(ERR,
+			"Membership cuckoo filter create with invalid parameters");
+		return -EINVAL;
+	}
+
+	/*
+	 * A lookup compares the fingerprint with the entries of two buckets,
+	 * so the false positive rate is about 2 * entries / 2^fp_bits.
+	 */
+	fp_bits = ceil(log2(2.0 * RTE_MEMBER_CF_BUCKET_ENTRIES /
+			params->false_positive_rate));
+	fp_bits = RTE_MAX(fp_bits, (uint32_t)RTE_MEMBER_CF_MIN_FP_BITS);
+	fp_bits = RTE_MIN(fp_bits, (uint32_t)RTE_MEMBER_CF_MAX_FP_BITS);
+
+	num_buckets = (uint64_t)params->num_keys * 100 /
+			(RTE_MEMBER_CF_BUCKET_ENTRIES *
+			RTE_MEMBER_CF_LOAD_PERCENT) + 1;
+	num_buckets = RTE_MAX(num_buckets, (uint64_t)2);
+
+	ss->num_set = 1;
+	ss->bucket_cnt = num_buckets;
+	ss->fp_bits = fp_bits;
+	for (i = 0, ss->fp_lanes = 0; i < RTE_MEMBER_CF_BUCKET_ENTRIES; i++)
+		ss->fp_lanes |= 1ULL << (i * fp_bits);
+
+	ss->table = rte_zmalloc_socket(NULL, cf_table_size(ss),
+			RTE_CACHE_LINE_SIZE, ss->socket_id);
+	if (ss->table == NULL) {
+		MEMBER_LOG(ERR, "memory allocation failed for cuckoo filter "
+				"setsummary");
+		return -ENOMEM;
+	}
+
+	MEMBER_LOG(DEBUG, "Cuckoo filter created, "
+			"the table has %u buckets of %u entries, "
+			"%u bits per fingerprint, "
+			"false positive rate is about %.5f",
+			ss->bucket_cnt, RTE_MEMBER_CF_BUCKET_ENTRIES, fp_bits,
+			2.0 * RTE_MEMBER_CF_BUCKET_ENTRIES / (1 << fp_bits));
+	return 0;
+}
+
+int
+rte_member_lookup_cf(const struct rte_member_setsum *ss,
+		const void *key, member_set_t *set_id)
+{
+	uint32_t prim_bucket, sec_bucket, fp;
+
+	get_buckets_index(ss, key, &prim_bucket, &sec_bucket, &fp);
+
+	if (cf_bucket_has(ss, cf_bucket_read(ss, prim_bucket), fp) ||
+			cf_bucket_has(ss, cf_bucket_read(ss, sec_bucket), fp)) {
+		*set_id = 1;
+		return 1;
+	}
+
+	*set_id = RTE_MEMBER_NO_MATCH;
+	return 0;
+}
+
+uint32_t
+rte_member_lookup_bulk_cf(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, member_set_t *set_ids)
+{
+	uint32_t i;
+	uint32_t num_matches = 0;
+	uint32_t fp[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t prim_buckets[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t sec_buckets[RTE_MEMBER_LOOKUP_BULK_MAX];
+
+	for (i = 0; i < num_keys; i++) {
+		get_buckets_index(ss, keys[i], &prim_buckets[i],
+				&sec_buckets[i], &fp[i]);
+		rte_prefetch0(cf_bucket_addr(ss, prim_buckets[i]));
+		rte_prefetch0(cf_bucket_addr(ss, sec_buckets[i]));
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		if (cf_bucket_has(ss, cf_bucket_read(ss, prim_buckets[i]),
+					fp[i]) ||
+				cf_bucket_has(ss,
+					cf_bucket_read(ss, sec_buckets[i]),
+					fp[i])) {
+			set_ids[i] = 1;
+			num_matches++;
+		} else
+			set_ids[i] = RTE_MEMBER_NO_MATCH;
+	}
+	return num_matches;
+}
+
+/* Store the fingerprint in a free entry of the bucket */
+static inline int
+cf_bucket_insert(const struct rte_member_setsum *ss, uint32_t bucket,
+		uint32_t fp)
+{
+	uint64_t entries = cf_bucket_read(ss, bucket);
+	int idx = cf_bucket_find(ss, entries, 0);
+
+	if (idx < 0)
+		return -ENOSPC;
+
+	cf_bucket_write(ss, bucket, cf_entry_set(ss, entries, idx, fp));
+	return 0;
+}
+
+/*
+ * Make room for the fingerprint by relocating other fingerprints
+ * to their alternative buckets. The relocations are undone on failure
+ * so that no fingerprint is lost when the filter is full.
+ */
+static int
+cf_evict(const struct rte_member_setsum *ss, uint32_t bucket, uint32_t fp)
+{
+	uint32_t path_bucket[RTE_MEMBER_CF_MAX_KICKS];
+	uint8_t path_idx[RTE_MEMBER_CF_MAX_KICKS];
+	uint64_t entries;
+	uint32_t n, idx, victim;
+
+	for (n = 0; n < RTE_MEMBER_CF_MAX_KICKS; n++) {
+		idx = rte_rand() & (RTE_MEMBER_CF_BUCKET_ENTRIES - 1);
+		entries = cf_bucket_read(ss, bucket);
+		victim = cf_entry_get(ss, entries, idx);
+		cf_bucket_write(ss, bucket, cf_entry_set(ss, entries, idx, fp));
+		path_bucket[n] = bucket;
+		path_idx[n] = idx;
+
+		fp = victim;
+		bucket = cf_alt_bucket(ss, bucket, fp);
+		if (cf_bucket_insert(ss, bucket, fp) == 0)
+			return 1;
+	}
+
+	while (n-- > 0) {
+		entries = cf_bucket_read(ss, path_bucket[n]);
+		victim = cf_entry_get(ss, entries, path_idx[n]);
+		cf_bucket_write(ss, path_bucket[n],
+				cf_entry_set(ss, entries, path_idx[n], fp));
+		fp = victim;
+	}
+	return -ENOSPC;
+}
+
+int
+rte_member_add_cf(const struct rte_member_setsum *ss,
+		const void *key, member_set_t set_id)
+{
+	uint32_t prim_bucket, sec_bucket, fp;
+
+	/* The cuckoo filter holds a single set */
+	if (set_id != 1)
+		return -EINVAL;
+
+	/*
+	 * The fingerprint is stored even if it is already in the buckets,
+	 * since it may come from another key which can be deleted later.
+	 */
+	get_buckets_index(ss, key, &prim_bucket, &sec_bucket, &fp);
+
+	if (cf_bucket_insert(ss, prim_bucket, fp) == 0 ||
+			cf_bucket_insert(ss, sec_bucket, fp) == 0)
+		return 0;
+
+	return cf_evict(ss, (rte_rand() & 1) ? sec_bucket : prim_bucket, fp);
+}
+
+int
+rte_member_delete_cf(const struct rte_member_setsum *ss, const void *key)
+{
+	uint32_t bucket[2], fp, i;
+	uint64_t entries;
+	int idx;
+
+	get_buckets_index(ss, key, &bucket[0], &bucket[1], &fp);
+
+	for (i = 0; i < RTE_DIM(bucket); i++) {
+		entries = cf_bucket_read(ss, bucket[i]);
+		idx = cf_bucket_find(ss, entries, fp);
+		if (idx >= 0) {
+			cf_bucket_write(ss, bucket[i],
+					cf_entry_set(ss, entries, idx, 0));
+			return 0;
+		}
+	}
+	return -ENOENT;
+}
+
+void
+rte_member_free_cf(struct rte_member_setsum *ss)
+{
+	rte_free(ss->table);
+}
+
+void
+rte_member_reset_cf(const struct rte_member_setsum *ss)
+{
+	memset(ss->table, 0, cf_table_size(ss));
+}
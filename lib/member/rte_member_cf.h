@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_MEMBER_CF_H_
+#define _RTE_MEMBER_CF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Entry count per bucket in cuckoo filter mode. */
+#define RTE_MEMBER_CF_BUCKET_ENTRIES 4
+
+/* Maximum number of fingerprints relocated by one cuckoo filter insert. */
+#define RTE_MEMBER_CF_MAX_KICKS 500
+
+/* Load factor the cuckoo filter is sized for, in percent. */
+#define RTE_MEMBER_CF_LOAD_PERCENT 95
+
+/* Range of the fingerprint size in bits. */
+#define RTE_MEMBER_CF_MIN_FP_BITS 4
+#define RTE_MEMBER_CF_MAX_FP_BITS 16
+
+int
+rte_member_create_cf(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params);
+
+int
+rte_member_lookup_cf(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t *set_id);
+
+uint32_t
+rte_member_lookup_bulk_cf(const struct rte_member_setsum *setsum,
+		const void **keys, uint32_t num_keys,
+		member_set_t *set_ids);
+
+int
+rte_member_add_cf(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t set_id);
+
+int
+rte_member_delete_cf(const struct rte_member_setsum *setsum,
+		const void *key);
+
+void
+rte_member_free_cf(struct rte_member_setsum *ss);
+
+void
+rte_member_reset_cf(const struct rte_member_setsum *setsum);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_MEMBER_CF_H_ */
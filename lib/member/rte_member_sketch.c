@@ -20,9 +20,9 @@
 #include "rte_member_sketch.h"
 #include "rte_member_heap.h"
 
-#ifdef CC_AVX512_SUPPORT
+#if defined(CC_AVX512_SUPPORT) && defined(CC_AVX512_IFMA_SUPPORT)
 #include "rte_member_sketch_avx512.h"
-#endif /* CC_AVX512_SUPPORT */
+#endif /* CC_AVX512_SUPPORT && CC_AVX512_IFMA_SUPPORT */
 
 struct __rte_cache_aligned sketch_runtime {
 	uint64_t pkt_cnt;
@@ -133,7 +133,7 @@ rte_member_create_sketch(struct rte_member_setsum *ss,
 		rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512 &&
 		rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) == 1 &&
 		rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512IFMA) == 1) {
-#ifdef CC_AVX512_SUPPORT
+#if defined(CC_AVX512_SUPPORT) && defined(CC_AVX512_IFMA_SUPPORT)
 		ss->use_avx512 = true;
 #else
 		ss->use_avx512 = false;
@@ -141,7 +141,7 @@ rte_member_create_sketch(struct rte_member_setsum *ss,
 	}
 
 	if (ss->use_avx512 == true) {
-#ifdef CC_AVX512_SUPPORT
+#if defined(CC_AVX512_SUPPORT) && defined(CC_AVX512_IFMA_SUPPORT)
 		ss->num_row = NUM_ROW_VEC;
 		MEMBER_LOG(NOTICE,
 			"Membership Sketch AVX512 update/lookup/delete ops is selected");
@@ -722,6 +722,29 @@ rte_mempool_populate_anon(struct rte_mempool *mp)
 	return 0;
 }
 
+/* free the return channels of the lcores, each owned by its receiver */
+static void
+mempool_return_free(struct rte_mempool *mp)
+{
+	struct rte_mempool_return *ret;
+	unsigned int lcore_id, i;
+
+	if (mp->cache_size == 0)
+		return;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		ret = mp->local_cache[lcore_id].returns;
+		if (ret == NULL)
+			continue;
+		for (i = 0; i < ret->nb_src; i++)
+			rte_free(ret->src[i]);
+	}
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		rte_free(mp->local_cache[lcore_id].returns);
+		mp->local_cache[lcore_id].returns = NULL;
+	}
+}
+
 /* free a mempool */
 RTE_EXPORT_SYMBOL(rte_mempool_free)
 void
@@ -749,6 +772,7 @@ rte_mempool_free(struct rte_mempool *mp)
 
 	mempool_event_callback_invoke(RTE_MEMPOOL_EVENT_DESTROY, mp);
 	rte_mempool_trace_free(mp);
+	mempool_return_free(mp);
 	rte_mempool_free_memchunks(mp);
 	rte_mempool_ops_free(mp);
 	rte_memzone_free(mp->mz);
@@ -761,10 +785,21 @@ mempool_cache_init(struct rte_mempool_cache *cache, uint32_t size)
 	RTE_BUILD_BUG_ON(CALC_CACHE_FLUSHTHRESH(RTE_MEMPOOL_CACHE_MAX_SIZE) >
 			 RTE_SIZEOF_FIELD(struct rte_mempool_cache, objs) /
 			 RTE_SIZEOF_FIELD(struct rte_mempool_cache, objs[0]));
+	/* Check that adaptive bounds fit */
+	RTE_BUILD_BUG_ON(RTE_MEMPOOL_CACHE_MAX_SIZE > UINT16_MAX);
 
 	cache->size = size;
 	cache->flushthresh = CALC_CACHE_FLUSHTHRESH(size);
 	cache->len = 0;
+	cache->min_size = 0;
+	cache->max_size = 0;
+	cache->period_flushes = 0;
+	cache->period_refills = 0;
+	cache->flush_bulk = 0;
+	cache->flush_objs = 0;
+	cache->refill_bulk = 0;
+	cache->refill_objs = 0;
+	cache->returns = NULL;
 }
 
 /*
@@ -810,6 +845,118 @@ rte_mempool_cache_free(struct rte_mempool_cache *cache)
 	rte_free(cache);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_cache_adaptive_set, 26.03)
+int
+rte_mempool_cache_adaptive_set(struct rte_mempool *mp, uint32_t min_size,
+		uint32_t max_size)
+{
+	struct rte_mempool_cache *cache;
+	unsigned int lcore_id;
+	uint32_t size;
+
+	if (mp == NULL || mp->cache_size == 0)
+		return -EINVAL;
+
+	if (max_size != 0 && (min_size == 0 || min_size > max_size ||
+			max_size > RTE_MEMPOOL_CACHE_MAX_SIZE ||
+			max_size * 2 > mp->size))
+		return -EINVAL;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		cache = &mp->local_cache[lcore_id];
+
+		if (max_size == 0)
+			size = mp->cache_size;
+		else
+			size = RTE_MIN(RTE_MAX(cache->size, min_size),
+					max_size);
+		cache->min_size = min_size;
+		cache->max_size = max_size;
+		cache->period_flushes = 0;
+		cache->period_refills = 0;
+		cache->size = size;
+		cache->flushthresh = CALC_CACHE_FLUSHTHRESH(size);
+
+		/* Flush the objects above the new size, if any. */
+		if (cache->len > cache->flushthresh) {
+			rte_mempool_ops_enqueue_bulk(mp, &cache->objs[size],
+					cache->len - size);
+			cache->flush_bulk++;
+			cache->flush_objs += cache->len - size;
+			cache->len = size;
+		}
+	}
+
+	return 0;
+}
+
+/* get the return channels of an lcore, allocating them on first use */
+static struct rte_mempool_return *
+mempool_return_get(struct rte_mempool *mp, unsigned int lcore_id)
+{
+	struct rte_mempool_cache *cache = &mp->local_cache[lcore_id];
+
+	if (cache->returns == NULL)
+		cache->returns = rte_zmalloc_socket("MEMPOOL_RETURN",
+				sizeof(*cache->returns), RTE_CACHE_LINE_SIZE,
+				rte_lcore_to_socket_id(lcore_id));
+	return cache->returns;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_return_channel_add, 26.03)
+int
+rte_mempool_return_channel_add(struct rte_mempool *mp,
+		unsigned int free_lcore, unsigned int alloc_lcore,
+		unsigned int size)
+{
+	struct rte_mempool_return *src, *dst;
+	struct rte_ring *r;
+	char name[RTE_RING_NAMESIZE];
+	unsigned int i, j;
+	ssize_t memsize;
+	int ret;
+
+	if (mp == NULL || mp->cache_size == 0 ||
+			free_lcore >= RTE_MAX_LCORE ||
+			alloc_lcore >= RTE_MAX_LCORE ||
+			free_lcore == alloc_lcore ||
+			size == 0 || size > RTE_RING_SZ_MASK)
+		return -EINVAL;
+
+	src = mempool_return_get(mp, free_lcore);
+	dst = mempool_return_get(mp, alloc_lcore);
+	if (src == NULL || dst == NULL)
+		return -ENOMEM;
+
+	/* the ring of a channel is in both lcores, look for it in one */
+	for (i = 0; i < dst->nb_src; i++)
+		for (j = 0; j < src->nb_dst; j++)
+			if (dst->src[i] == src->dst[j])
+				return -EEXIST;
+
+	memsize = rte_ring_get_memsize(rte_align32pow2(size + 1));
+	if (memsize < 0)
+		return memsize;
+	r = rte_zmalloc_socket("MEMPOOL_RETURN_RING", memsize,
+			RTE_CACHE_LINE_SIZE,
+			rte_lcore_to_socket_id(alloc_lcore));
+	if (r == NULL)
+		return -ENOMEM;
+
+	snprintf(name, sizeof(name), "MPR_%u_%u", free_lcore, alloc_lcore);
+	ret = rte_ring_init(r, name, size,
+			RING_F_SP_ENQ | RING_F_SC_DEQ | RING_F_EXACT_SZ);
+	if (ret < 0) {
+		rte_free(r);
+		return ret;
+	}
+
+	src->dst[src->nb_dst++] = r;
+	dst->src[dst->nb_src++] = r;
+
+	return 0;
+}
+
 /* create an empty mempool */
 RTE_EXPORT_SYMBOL(rte_mempool_create_empty)
 struct rte_mempool *
@@ -1029,9 +1176,20 @@ rte_mempool_avail_count(const struct rte_mempool *mp)
 	if (mp->cache_size == 0)
 		return count;
 
-	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		const struct rte_mempool_return *ret;
+		unsigned int i;
+
 		count += mp->local_cache[lcore_id].len;
 
+		/* objects in the channels the lcore receives from */
+		ret = mp->local_cache[lcore_id].returns;
+		if (ret == NULL)
+			continue;
+		for (i = 0; i < ret->nb_src; i++)
+			count += rte_ring_count(ret->src[i]);
+	}
+
 	/*
 	 * due to race condition (access to len is not locked), the
 	 * total can be greater than size... so fix the result
@@ -1053,6 +1211,7 @@ rte_mempool_in_use_count(const struct rte_mempool *mp)
 static unsigned
 rte_mempool_dump_cache(FILE *f, const struct rte_mempool *mp)
 {
+	const struct rte_mempool_cache *cache;
 	unsigned lcore_id;
 	unsigned count = 0;
 	unsigned cache_count;
@@ -1063,8 +1222,31 @@ rte_mempool_dump_cache(FILE *f, const struct rte_mempool *mp)
 	if (mp->cache_size == 0)
 		return count;
 
+	if (mp->local_cache[0].max_size != 0)
+		fprintf(f, "    adaptive cache_size=[%u, %u]\n",
+			mp->local_cache[0].min_size,
+			mp->local_cache[0].max_size);
+
 	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
-		cache_count = mp->local_cache[lcore_id].len;
+		cache = &mp->local_cache[lcore_id];
+		if (cache->max_size != 0 && (cache->flush_bulk != 0 ||
+				cache->refill_bulk != 0))
+			fprintf(f, "    cache_size[%u]=%"PRIu32
+				" flushthresh=%"PRIu32"\n",
+				lcore_id, cache->size, cache->flushthresh);
+		if (cache->flush_bulk != 0 || cache->refill_bulk != 0)
+			fprintf(f, "    cache_backend[%u]=flush_bulk:%"PRIu64
+				" flush_objs:%"PRIu64" refill_bulk:%"PRIu64
+				" refill_objs:%"PRIu64"\n",
+				lcore_id, cache->flush_bulk, cache->flush_objs,
+				cache->refill_bulk, cache->refill_objs);
+		if (cache->returns != NULL && (cache->returns->sent_objs != 0 ||
+				cache->returns->recv_objs != 0))
+			fprintf(f, "    cache_return[%u]=sent_objs:%"PRIu64
+				" recv_objs:%"PRIu64"\n",
+				lcore_id, cache->returns->sent_objs,
+				cache->returns->recv_objs);
+		cache_count = cache->len;
 		if (cache_count == 0)
 			continue;
 		fprintf(f, "    cache_count[%u]=%"PRIu32"\n",
@@ -1627,10 +1809,86 @@ mempool_handle_info(const char *cmd __rte_unused, const char *params,
 	return 0;
 }
 
+static void
+mempool_cache_cb(struct rte_mempool *mp, void *arg)
+{
+	struct mempool_info_cb_arg *info = (struct mempool_info_cb_arg *)arg;
+	const struct rte_mempool_cache *cache;
+	struct rte_tel_data *c;
+	char name[RTE_TEL_MAX_STRING_LEN];
+	unsigned int lcore_id;
+
+	if (strncmp(mp->name, info->pool_name, RTE_MEMZONE_NAMESIZE))
+		return;
+
+	rte_tel_data_add_dict_string(info->d, "name", mp->name);
+	rte_tel_data_add_dict_uint(info->d, "cache_size", mp->cache_size);
+	if (mp->cache_size == 0)
+		return;
+	rte_tel_data_add_dict_uint(info->d, "adaptive_min_size",
+				  mp->local_cache[0].min_size);
+	rte_tel_data_add_dict_uint(info->d, "adaptive_max_size",
+				  mp->local_cache[0].max_size);
+
+	/* Dump the caches which were used only */
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		cache = &mp->local_cache[lcore_id];
+		if (cache->len == 0 && cache->flush_bulk == 0 &&
+				cache->refill_bulk == 0 &&
+				cache->returns == NULL)
+			continue;
+
+		c = rte_tel_data_alloc();
+		if (c == NULL)
+			return;
+		rte_tel_data_start_dict(c);
+		rte_tel_data_add_dict_uint(c, "size", cache->size);
+		rte_tel_data_add_dict_uint(c, "flushthresh",
+					  cache->flushthresh);
+		rte_tel_data_add_dict_uint(c, "len", cache->len);
+		rte_tel_data_add_dict_uint(c, "flush_bulk", cache->flush_bulk);
+		rte_tel_data_add_dict_uint(c, "flush_objs", cache->flush_objs);
+		rte_tel_data_add_dict_uint(c, "refill_bulk",
+					  cache->refill_bulk);
+		rte_tel_data_add_dict_uint(c, "refill_objs",
+					  cache->refill_objs);
+		if (cache->returns != NULL) {
+			rte_tel_data_add_dict_uint(c, "return_sent_objs",
+					cache->returns->sent_objs);
+			rte_tel_data_add_dict_uint(c, "return_recv_objs",
+					cache->returns->recv_objs);
+		}
+		snprintf(name, sizeof(name), "lcore_%u", lcore_id);
+		rte_tel_data_add_dict_container(info->d, name, c, 0);
+	}
+}
+
+static int
+mempool_handle_cache(const char *cmd __rte_unused, const char *params,
+		     struct rte_tel_data *d)
+{
+	struct mempool_info_cb_arg mp_arg;
+	char name[RTE_MEMZONE_NAMESIZE];
+
+	if (!params || strlen(params) == 0)
+		return -EINVAL;
+
+	rte_strlcpy(name, params, RTE_MEMZONE_NAMESIZE);
+
+	rte_tel_data_start_dict(d);
+	mp_arg.pool_name = name;
+	mp_arg.d = d;
+	rte_mempool_walk(mempool_cache_cb, &mp_arg);
+
+	return 0;
+}
+
 RTE_INIT(mempool_init_telemetry)
 {
 	rte_telemetry_register_cmd("/mempool/list", mempool_handle_list,
 		"Returns list of available mempool. Takes no parameters");
 	rte_telemetry_register_cmd("/mempool/info", mempool_handle_info,
 		"Returns mempool info. Parameters: pool_name");
+	rte_telemetry_register_cmd("/mempool/cache", mempool_handle_cache,
+		"Returns mempool per-lcore cache info. Parameters: pool_name");
 }
@@ -84,6 +84,25 @@ struct __rte_cache_aligned rte_mempool_debug_stats {
 };
 #endif
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this structure may change without prior notice.
+ *
+ * The return channels of an lcore, see rte_mempool_return_channel_add().
+ * Each channel is a single producer, single consumer ring carrying the
+ * objects freed by an lcore to the cache of an lcore allocating them.
+ */
+struct rte_mempool_return {
+	uint16_t nb_dst;	/**< Channels the lcore sends objects to */
+	uint16_t dst_idx;	/**< Next channel to send objects to */
+	uint16_t nb_src;	/**< Channels the lcore receives objects from */
+	uint16_t src_idx;	/**< Next channel to receive objects from */
+	uint64_t sent_objs;	/**< Objects sent to the channels */
+	uint64_t recv_objs;	/**< Objects received from the channels */
+	struct rte_ring *dst[RTE_MAX_LCORE]; /**< Channels to send to */
+	struct rte_ring *src[RTE_MAX_LCORE]; /**< Channels to receive from */
+};
+
 /**
  * A structure that stores a per-core object cache.
  */
@@ -104,6 +123,27 @@ struct __rte_cache_aligned rte_mempool_cache {
 		uint64_t get_success_objs;  /**< Objects successfully allocated. */
 	} stats;                        /**< Statistics */
 #endif
+	/*
+	 * Bounds of the size in adaptive mode, see
+	 * rte_mempool_cache_adaptive_set(); max_size is 0 if disabled.
+	 */
+	uint16_t min_size;	/**< Minimum size in adaptive mode */
+	uint16_t max_size;	/**< Maximum size in adaptive mode */
+	uint16_t period_flushes; /**< Flushes since the last adaptation */
+	uint16_t period_refills; /**< Refills since the last adaptation */
+	/*
+	 * Counters of the accesses to the backend done by the cache,
+	 * updated out of the fast path only.
+	 */
+	uint64_t flush_bulk;	/**< Number of flushes to the backend */
+	uint64_t flush_objs;	/**< Objects flushed to the backend */
+	uint64_t refill_bulk;	/**< Number of refills from the backend */
+	uint64_t refill_objs;	/**< Objects refilled from the backend */
+	/**
+	 * Return channels of the lcore, NULL if it has none,
+	 * see rte_mempool_return_channel_add().
+	 */
+	struct rte_mempool_return *returns;
 	/**
 	 * Cache objects
 	 *
@@ -1324,6 +1364,81 @@ rte_mempool_cache_create(uint32_t size, int socket_id);
 void
 rte_mempool_cache_free(struct rte_mempool_cache *cache);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enable or disable the adaptive sizing of the per-lcore default caches.
+ *
+ * In adaptive mode, each lcore cache tracks the balance of its flushes to
+ * and refills from the backend, and resizes itself within the bounds
+ * every RTE_MEMPOOL_CACHE_ADAPT_PERIOD of them:
+ *  - An lcore mostly freeing objects gets a higher flush threshold,
+ *    so that it flushes in bigger bursts, and a smaller size,
+ *    since it does not need objects to be refilled.
+ *  - Otherwise the cache size and the flush threshold grow,
+ *    so that the lcore refills in bigger bursts and absorbs bigger
+ *    variations of the number of objects it holds.
+ *
+ * This function must not be called while the mempool is used
+ * by other lcores.
+ *
+ * @param mp
+ *   A pointer to the mempool structure, created with a cache.
+ * @param min_size
+ *   The minimum size of the caches, must be at least 1.
+ * @param max_size
+ *   The maximum size of the caches, at most RTE_MEMPOOL_CACHE_MAX_SIZE,
+ *   and the pool must hold at least twice this number of objects.
+ *   0 disables the adaptive mode, restoring the size set at creation.
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: Invalid parameters or mempool without cache.
+ */
+__rte_experimental
+int
+rte_mempool_cache_adaptive_set(struct rte_mempool *mp, uint32_t min_size,
+		uint32_t max_size);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Add a return channel from an lcore freeing objects of the mempool
+ * to an lcore allocating them.
+ *
+ * When its default cache is full, the freeing lcore sends the objects
+ * to its return channels in turn, instead of the mempool backend.
+ * When its default cache is empty, the allocating lcore takes the objects
+ * from its return channels in turn, before refilling from the backend.
+ * In a pipeline where some lcores allocate the objects freed by others,
+ * the objects go back to the allocating lcores in bulk without contending
+ * on the backend, which is only used when the channels are full or empty.
+ *
+ * The channels are only used by the default caches of the two lcores,
+ * and are freed with the mempool.
+ * This function must not be called while the mempool is used.
+ *
+ * @param mp
+ *   A pointer to the mempool structure, created with a cache.
+ * @param free_lcore
+ *   The lcore sending the objects it frees.
+ * @param alloc_lcore
+ *   The lcore receiving the objects, different from free_lcore.
+ * @param size
+ *   The number of objects the channel can hold.
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: Invalid parameters or mempool without cache.
+ *   - -EEXIST: The channel already exists.
+ *   - -ENOMEM: Not enough memory.
+ */
+__rte_experimental
+int
+rte_mempool_return_channel_add(struct rte_mempool *mp,
+		unsigned int free_lcore, unsigned int alloc_lcore,
+		unsigned int size);
+
 /**
  * Get a pointer to the per-lcore default mempool cache.
  *
@@ -1349,6 +1464,110 @@ rte_mempool_default_cache(struct rte_mempool *mp, unsigned lcore_id)
 	return &mp->local_cache[lcore_id];
 }
 
+/**
+ * Number of flushes and refills of a cache between two adaptations
+ * of its size, see rte_mempool_cache_adaptive_set().
+ */
+#define RTE_MEMPOOL_CACHE_ADAPT_PERIOD 16
+
+/**
+ * @internal Resize a cache in adaptive mode, when it has accessed
+ * the backend RTE_MEMPOOL_CACHE_ADAPT_PERIOD times.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param cache
+ *   A pointer to a mempool cache structure in adaptive mode.
+ */
+static inline void
+rte_mempool_cache_adapt(struct rte_mempool *mp,
+			struct rte_mempool_cache *cache)
+{
+	uint32_t size, flushthresh;
+
+	if (cache->period_flushes * 4 >= RTE_MEMPOOL_CACHE_ADAPT_PERIOD * 3) {
+		/* Mostly puts: flush in bigger bursts, keep less objects. */
+		size = RTE_MAX(cache->size / 2, (uint32_t)cache->min_size);
+		flushthresh = RTE_MIN(cache->flushthresh * 2,
+				(uint32_t)cache->max_size * 2);
+	} else {
+		/* Mostly gets, or both: refill in bigger bursts. */
+		size = RTE_MIN(cache->size * 2, (uint32_t)cache->max_size);
+		flushthresh = (size * 3) / 2;
+	}
+	cache->size = size;
+	cache->flushthresh = RTE_MAX(flushthresh, size);
+	cache->period_flushes = 0;
+	cache->period_refills = 0;
+
+	/* Flush the objects above the new size, if over the threshold. */
+	if (unlikely(cache->len > cache->flushthresh)) {
+		rte_mempool_ops_enqueue_bulk(mp, &cache->objs[size],
+				cache->len - size);
+		cache->flush_bulk++;
+		cache->flush_objs += cache->len - size;
+		cache->len = size;
+	}
+}
+
+/**
+ * @internal Send objects to the return channels of an lcore,
+ * starting with the channel next in turn.
+ *
+ * @param ret
+ *   A pointer to the return channels of the lcore.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects).
+ * @param n
+ *   The number of objects to send.
+ * @return
+ *   The number of objects sent, at the beginning of obj_table.
+ */
+static inline unsigned int
+rte_mempool_return_send(struct rte_mempool_return *ret,
+			void * const *obj_table, unsigned int n)
+{
+	unsigned int i, sent = 0;
+
+	for (i = 0; i < ret->nb_dst && sent < n; i++) {
+		sent += rte_ring_sp_enqueue_burst(ret->dst[ret->dst_idx],
+				&obj_table[sent], n - sent, NULL);
+		if (++ret->dst_idx == ret->nb_dst)
+			ret->dst_idx = 0;
+	}
+	ret->sent_objs += sent;
+	return sent;
+}
+
+/**
+ * @internal Receive objects from the return channels of an lcore,
+ * starting with the channel next in turn.
+ *
+ * @param ret
+ *   A pointer to the return channels of the lcore.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects).
+ * @param n
+ *   The maximum number of objects to receive.
+ * @return
+ *   The number of objects received in obj_table.
+ */
+static inline unsigned int
+rte_mempool_return_recv(struct rte_mempool_return *ret,
+			void **obj_table, unsigned int n)
+{
+	unsigned int i, recv = 0;
+
+	for (i = 0; i < ret->nb_src && recv < n; i++) {
+		recv += rte_ring_sc_dequeue_burst(ret->src[ret->src_idx],
+				&obj_table[recv], n - recv, NULL);
+		if (++ret->src_idx == ret->nb_src)
+			ret->src_idx = 0;
+	}
+	ret->recv_objs += recv;
+	return recv;
+}
+
 /**
  * Flush a user-owned mempool cache to the specified mempool.
  *
@@ -1367,6 +1586,8 @@ rte_mempool_cache_flush(struct rte_mempool_cache *cache,
 		return;
 	rte_mempool_trace_cache_flush(cache, mp);
 	rte_mempool_ops_enqueue_bulk(mp, cache->objs, cache->len);
+	cache->flush_bulk++;
+	cache->flush_objs += cache->len;
 	cache->len = 0;
 }
 
@@ -1387,6 +1608,7 @@ rte_mempool_do_generic_put(struct rte_mempool *mp, void * const *obj_table,
 			   unsigned int n, struct rte_mempool_cache *cache)
 {
 	void **cache_objs;
+	unsigned int len;
 
 	/* No cache provided? */
 	if (unlikely(cache == NULL))
@@ -1410,8 +1632,24 @@ rte_mempool_do_generic_put(struct rte_mempool *mp, void * const *obj_table,
 		 * Flush the cache to make room for the objects.
 		 */
 		cache_objs = &cache->objs[0];
-		rte_mempool_ops_enqueue_bulk(mp, cache_objs, cache->len);
+		len = 0;
+		if (cache->returns != NULL && cache->returns->nb_dst != 0)
+			len = rte_mempool_return_send(cache->returns,
+					cache_objs, cache->len);
+		if (len < cache->len) {
+			rte_mempool_ops_enqueue_bulk(mp, &cache_objs[len],
+					cache->len - len);
+			cache->flush_bulk++;
+			cache->flush_objs += cache->len - len;
+		}
 		cache->len = n;
+		rte_memcpy(cache_objs, obj_table, sizeof(void *) * n);
+
+		if (cache->max_size != 0 &&
+				++cache->period_flushes + cache->period_refills >=
+				RTE_MEMPOOL_CACHE_ADAPT_PERIOD)
+			rte_mempool_cache_adapt(mp, cache);
+		return;
 	} else {
 		/* The request itself is too big for the cache. */
 		goto driver_enqueue_stats_incremented;
@@ -1517,7 +1755,7 @@ rte_mempool_do_generic_get(struct rte_mempool *mp, void **obj_table,
 			   unsigned int n, struct rte_mempool_cache *cache)
 {
 	int ret;
-	unsigned int remaining;
+	unsigned int remaining, returned = 0;
 	uint32_t index, len;
 	void **cache_objs;
 
@@ -1576,9 +1814,27 @@ rte_mempool_do_generic_get(struct rte_mempool *mp, void **obj_table,
 	if (unlikely(remaining > RTE_MEMPOOL_CACHE_MAX_SIZE))
 		goto driver_dequeue;
 
+	/* Take the objects other lcores returned to this one, if any. */
+	if (cache->returns != NULL && cache->returns->nb_src != 0) {
+		returned = rte_mempool_return_recv(cache->returns, obj_table,
+				remaining);
+		obj_table += returned;
+		remaining -= returned;
+		if (remaining == 0) {
+			/* Refill the cache from the channels too. */
+			cache->len = rte_mempool_return_recv(cache->returns,
+					cache->objs, cache->size);
+
+			RTE_MEMPOOL_CACHE_STAT_ADD(cache, get_success_bulk, 1);
+			RTE_MEMPOOL_CACHE_STAT_ADD(cache, get_success_objs, n);
+
+			return 0;
+		}
+	}
+
 	/* Fill the cache from the backend; fetch size + remaining objects. */
-	ret = rte_mempool_ops_dequeue_bulk(mp, cache->objs,
-			cache->size + remaining);
+	len = cache->size + remaining;
+	ret = rte_mempool_ops_dequeue_bulk(mp, cache->objs, len);
 	if (unlikely(ret < 0)) {
 		/*
 		 * We are buffer constrained, and not able to fetch all that.
@@ -1596,10 +1852,17 @@ rte_mempool_do_generic_get(struct rte_mempool *mp, void **obj_table,
 		*obj_table++ = *--cache_objs;
 
 	cache->len = cache->size;
+	cache->refill_bulk++;
+	cache->refill_objs += len;
 
 	RTE_MEMPOOL_CACHE_STAT_ADD(cache, get_success_bulk, 1);
 	RTE_MEMPOOL_CACHE_STAT_ADD(cache, get_success_objs, n);
 
+	if (cache->max_size != 0 &&
+			cache->period_flushes + ++cache->period_refills >=
+			RTE_MEMPOOL_CACHE_ADAPT_PERIOD)
+		rte_mempool_cache_adapt(mp, cache);
+
 	return 0;
 
 driver_dequeue:
@@ -1609,12 +1872,17 @@ rte_mempool_do_generic_get(struct rte_mempool *mp, void **obj_table,
 
 	if (unlikely(ret < 0)) {
 		if (likely(cache != NULL)) {
-			cache->len = n - remaining;
+			cache->len = n - remaining - returned;
 			/*
 			 * No further action is required to roll the first part
 			 * of the request back into the cache, as objects in
 			 * the cache are intact.
+			 * The objects taken from the return channels
+			 * go to the backend.
 			 */
+			if (returned != 0)
+				rte_mempool_ops_enqueue_bulk(mp,
+						obj_table - returned, returned);
 		}
 
 		RTE_MEMPOOL_STAT_ADD(mp, get_fail_bulk, 1);
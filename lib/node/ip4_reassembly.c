@@ -40,18 +40,42 @@ typedef struct ip4_reassembly_elem ip4_reassembly_elem_t;
 
 static struct ip4_reassembly_node_main ip4_reassembly_main;
 
+/* Move the mbufs freed by the reassembly to the drop edge */
+static __rte_always_inline uint16_t
+ip4_reassembly_dr_flush(struct rte_graph *graph, struct rte_node *node,
+			struct rte_ip_frag_death_row *dr)
+{
+	uint16_t cnt = dr->cnt;
+	void **to_free;
+
+	if (cnt == 0)
+		return 0;
+
+	to_free = rte_node_next_stream_get(graph, node,
+					   RTE_NODE_IP4_REASSEMBLY_NEXT_PKT_DROP, cnt);
+	rte_memcpy(to_free, dr->row, cnt * sizeof(to_free[0]));
+	rte_node_next_stream_put(graph, node, RTE_NODE_IP4_REASSEMBLY_NEXT_PKT_DROP,
+				 cnt);
+	NODE_INCREMENT_XSTAT_ID(node, 0, cnt, cnt);
+	dr->cnt = 0;
+
+	return cnt;
+}
+
 static uint16_t
 ip4_reassembly_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
 			    uint16_t nb_objs)
 {
 #define PREFETCH_OFFSET 4
-	struct rte_mbuf *mbuf, *mbuf_out;
+	/* The death row can hold the mbufs freed by this number of fragments */
+	struct rte_mbuf *frags[RTE_IP_FRAG_DEATH_ROW_LEN];
 	struct rte_ip_frag_death_row *dr;
 	struct ip4_reassembly_ctx *ctx;
 	struct rte_ipv4_hdr *ipv4_hdr;
 	struct rte_ip_frag_tbl *tbl;
-	void **to_next, **to_free;
-	uint16_t idx = 0;
+	uint16_t idx = 0, nb_frags = 0, nb_drop = 0;
+	void **to_next;
+	struct rte_mbuf *mbuf;
 	int i;
 
 	ctx = (struct ip4_reassembly_ctx *)node->ctx;
@@ -66,14 +90,16 @@ ip4_reassembly_node_process(struct rte_graph *graph, struct rte_node *node, void
 	}
 
 	to_next = node->objs;
-	for (i = 0; i < nb_objs - PREFETCH_OFFSET; i++) {
+	for (i = 0; i < nb_objs; i++) {
 #if RTE_GRAPH_BURST_SIZE > 64
 		/* Prefetch next-next mbufs */
 		if (likely(i + 8 < nb_objs))
 			rte_prefetch0(objs[i + 8]);
 #endif
-		rte_prefetch0(rte_pktmbuf_mtod_offset((struct rte_mbuf *)objs[i + PREFETCH_OFFSET],
-						      void *, sizeof(struct rte_ether_hdr)));
+		if (likely(i + PREFETCH_OFFSET < nb_objs))
+			rte_prefetch0(rte_pktmbuf_mtod_offset(
+				(struct rte_mbuf *)objs[i + PREFETCH_OFFSET],
+				void *, sizeof(struct rte_ether_hdr)));
 		mbuf = (struct rte_mbuf *)objs[i];
 
 		ipv4_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *,
@@ -82,50 +108,28 @@ ip4_reassembly_node_process(struct rte_graph *graph, struct rte_node *node, void
 			/* prepare mbuf: setup l2_len/l3_len. */
 			mbuf->l2_len = sizeof(struct rte_ether_hdr);
 			mbuf->l3_len = sizeof(struct rte_ipv4_hdr);
-
-			mbuf_out = rte_ipv4_frag_reassemble_packet(tbl, dr, mbuf, rte_rdtsc(),
-								   ipv4_hdr);
+			frags[nb_frags++] = mbuf;
 		} else {
-			mbuf_out = mbuf;
+			to_next[idx++] = (void *)mbuf;
 		}
 
-		if (mbuf_out)
-			to_next[idx++] = (void *)mbuf_out;
-	}
-
-	for (; i < nb_objs; i++) {
-		mbuf = (struct rte_mbuf *)objs[i];
-
-		ipv4_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *,
-						   sizeof(struct rte_ether_hdr));
-		if (rte_ipv4_frag_pkt_is_fragmented(ipv4_hdr)) {
-			/* prepare mbuf: setup l2_len/l3_len. */
-			mbuf->l2_len = sizeof(struct rte_ether_hdr);
-			mbuf->l3_len = sizeof(struct rte_ipv4_hdr);
-
-			mbuf_out = rte_ipv4_frag_reassemble_packet(tbl, dr, mbuf, rte_rdtsc(),
-								   ipv4_hdr);
-		} else {
-			mbuf_out = mbuf;
+		/*
+		 * Reassemble the fragments of the burst together, in slices
+		 * the death row can hold, and drain it after each slice.
+		 */
+		if (nb_frags == RTE_DIM(frags) || (i == nb_objs - 1 && nb_frags != 0)) {
+			idx += rte_ipv4_frag_reassemble_bulk(tbl, dr, frags, nb_frags,
+							     rte_rdtsc(),
+							     (struct rte_mbuf **)&to_next[idx]);
+			nb_frags = 0;
+			nb_drop += ip4_reassembly_dr_flush(graph, node, dr);
 		}
-
-		if (mbuf_out)
-			to_next[idx++] = (void *)mbuf_out;
 	}
+
 	node->idx = idx;
 	rte_node_next_stream_move(graph, node, 1);
-	if (dr->cnt) {
-		to_free = rte_node_next_stream_get(graph, node,
-						   RTE_NODE_IP4_REASSEMBLY_NEXT_PKT_DROP, dr->cnt);
-		rte_memcpy(to_free, dr->row, dr->cnt * sizeof(to_free[0]));
-		rte_node_next_stream_put(graph, node, RTE_NODE_IP4_REASSEMBLY_NEXT_PKT_DROP,
-					 dr->cnt);
-		idx += dr->cnt;
-		NODE_INCREMENT_XSTAT_ID(node, 0, dr->cnt, dr->cnt);
-		dr->cnt = 0;
-	}
 
-	return idx;
+	return idx + nb_drop;
 }
 
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip4_reassembly_configure, 23.11)
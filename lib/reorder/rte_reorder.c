@@ -13,8 +13,11 @@
 #include <rte_mbuf_dyn.h>
 #include <rte_eal_memconfig.h>
 #include <rte_errno.h>
+#include <rte_bitops.h>
 #include <rte_malloc.h>
+#include <rte_prefetch.h>
 #include <rte_tailq.h>
+#include <rte_vect.h>
 
 #include "rte_reorder.h"
 
@@ -68,18 +71,34 @@ rte_reorder_memory_footprint_get(unsigned int size)
 	return sizeof(struct rte_reorder_buffer) + (2 * size * sizeof(struct rte_mbuf *));
 }
 
-RTE_EXPORT_SYMBOL(rte_reorder_init)
-struct rte_reorder_buffer *
-rte_reorder_init(struct rte_reorder_buffer *b, unsigned int bufsize,
-		const char *name, unsigned int size)
+static int
+rte_reorder_seqn_dynfield_register(void)
 {
-	const unsigned int min_bufsize = rte_reorder_memory_footprint_get(size);
 	static const struct rte_mbuf_dynfield reorder_seqn_dynfield_desc = {
 		.name = RTE_REORDER_SEQN_DYNFIELD_NAME,
 		.size = sizeof(rte_reorder_seqn_t),
 		.align = alignof(rte_reorder_seqn_t),
 	};
 
+	rte_reorder_seqn_dynfield_offset = rte_mbuf_dynfield_register(&reorder_seqn_dynfield_desc);
+	if (rte_reorder_seqn_dynfield_offset < 0) {
+		REORDER_LOG(ERR,
+			"Failed to register mbuf field for reorder sequence number, rte_errno: %i",
+			rte_errno);
+		rte_errno = ENOMEM;
+		return -1;
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_SYMBOL(rte_reorder_init)
+struct rte_reorder_buffer *
+rte_reorder_init(struct rte_reorder_buffer *b, unsigned int bufsize,
+		const char *name, unsigned int size)
+{
+	const unsigned int min_bufsize = rte_reorder_memory_footprint_get(size);
+
 	if (b == NULL) {
 		REORDER_LOG(ERR, "Invalid reorder buffer parameter:"
 					" NULL");
@@ -105,14 +124,8 @@ rte_reorder_init(struct rte_reorder_buffer *b, unsigned int bufsize,
 		return NULL;
 	}
 
-	rte_reorder_seqn_dynfield_offset = rte_mbuf_dynfield_register(&reorder_seqn_dynfield_desc);
-	if (rte_reorder_seqn_dynfield_offset < 0) {
-		REORDER_LOG(ERR,
-			"Failed to register mbuf field for reorder sequence number, rte_errno: %i",
-			rte_errno);
-		rte_errno = ENOMEM;
+	if (rte_reorder_seqn_dynfield_register() < 0)
 		return NULL;
-	}
 
 	memset(b, 0, bufsize);
 	strlcpy(b->name, name, sizeof(b->name));
@@ -423,34 +436,158 @@ rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
 	return 0;
 }
 
+/* Number of mbufs whose sequence numbers are checked at once */
+#define REORDER_BURST_CHUNK 8U
+
+/*
+ * Compute the order buffer positions of REORDER_BURST_CHUNK sequence numbers,
+ * and return a bitmask of the ones in the reorder window.
+ */
+static inline uint32_t
+reorder_window_check(const struct rte_reorder_buffer *b, const uint32_t *seqn,
+		uint32_t *position)
+{
+#if defined(__AVX2__)
+	__m256i off, in;
+
+	off = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)seqn),
+			_mm256_set1_epi32(b->min_seqn));
+	in = _mm256_cmpeq_epi32(_mm256_min_epu32(off,
+			_mm256_set1_epi32(b->order_buf.mask)), off);
+	off = _mm256_and_si256(_mm256_add_epi32(off,
+			_mm256_set1_epi32(b->order_buf.head)),
+			_mm256_set1_epi32(b->order_buf.mask));
+	_mm256_storeu_si256((__m256i *)position, off);
+	return _mm256_movemask_ps(_mm256_castsi256_ps(in));
+#elif defined(RTE_ARCH_X86)
+	__m128i min = _mm_set1_epi32(b->min_seqn);
+	__m128i mask = _mm_set1_epi32(b->order_buf.mask);
+	__m128i head = _mm_set1_epi32(b->order_buf.head);
+	__m128i lo, hi, in_lo, in_hi;
+
+	lo = _mm_sub_epi32(_mm_loadu_si128((const __m128i *)seqn), min);
+	hi = _mm_sub_epi32(_mm_loadu_si128((const __m128i *)&seqn[4]), min);
+	in_lo = _mm_cmpeq_epi32(_mm_min_epu32(lo, mask), lo);
+	in_hi = _mm_cmpeq_epi32(_mm_min_epu32(hi, mask), hi);
+	_mm_storeu_si128((__m128i *)position,
+			_mm_and_si128(_mm_add_epi32(lo, head), mask));
+	_mm_storeu_si128((__m128i *)&position[4],
+			_mm_and_si128(_mm_add_epi32(hi, head), mask));
+	return _mm_movemask_ps(_mm_castsi128_ps(in_lo)) |
+		(_mm_movemask_ps(_mm_castsi128_ps(in_hi)) << 4);
+#elif defined(RTE_ARCH_ARM64)
+	static const uint32_t lo_bits[4] = {1, 2, 4, 8};
+	static const uint32_t hi_bits[4] = {16, 32, 64, 128};
+	uint32x4_t min = vdupq_n_u32(b->min_seqn);
+	uint32x4_t size = vdupq_n_u32(b->order_buf.size);
+	uint32x4_t mask = vdupq_n_u32(b->order_buf.mask);
+	uint32x4_t head = vdupq_n_u32(b->order_buf.head);
+	uint32x4_t lo, hi;
+
+	lo = vsubq_u32(vld1q_u32(seqn), min);
+	hi = vsubq_u32(vld1q_u32(&seqn[4]), min);
+	vst1q_u32(position, vandq_u32(vaddq_u32(lo, head), mask));
+	vst1q_u32(&position[4], vandq_u32(vaddq_u32(hi, head), mask));
+	lo = vandq_u32(vcltq_u32(lo, size), vld1q_u32(lo_bits));
+	hi = vandq_u32(vcltq_u32(hi, size), vld1q_u32(hi_bits));
+	return vaddvq_u32(vorrq_u32(lo, hi));
+#else
+	uint32_t i, offset, in = 0;
+
+	for (i = 0; i < REORDER_BURST_CHUNK; i++) {
+		offset = seqn[i] - b->min_seqn;
+		position[i] = (b->order_buf.head + offset) & b->order_buf.mask;
+		in |= (uint32_t)(offset < b->order_buf.size) << i;
+	}
+	return in;
+#endif
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_insert_burst, 26.03)
+unsigned int
+rte_reorder_insert_burst(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
+		unsigned int nb_mbufs, struct rte_mbuf **rejected)
+{
+	uint32_t seqn[REORDER_BURST_CHUNK] = {0};
+	uint32_t position[REORDER_BURST_CHUNK];
+	struct cir_buffer *order_buf = &b->order_buf;
+	unsigned int i, j, n, nb_in, nb_rejected = 0;
+	uint32_t in_window;
+
+	if (nb_mbufs == 0)
+		return 0;
+
+	if (!b->is_initialized) {
+		b->min_seqn = *rte_reorder_seqn(mbufs[0]);
+		b->is_initialized = 1;
+	}
+
+	for (i = 0; i < nb_mbufs; i += n) {
+		n = RTE_MIN(nb_mbufs - i, REORDER_BURST_CHUNK);
+		for (j = 0; j < n; j++)
+			seqn[j] = *rte_reorder_seqn(mbufs[i + j]);
+
+		/*
+		 * The mbufs up to the first one out of the window are stored
+		 * without moving the window, the next ones are inserted one
+		 * by one as the window may move.
+		 */
+		in_window = reorder_window_check(b, seqn, position);
+		nb_in = RTE_MIN(n, (unsigned int)rte_ctz32(~in_window));
+		for (j = 0; j < nb_in; j++)
+			order_buf->entries[position[j]] = mbufs[i + j];
+
+		for (; j < n; j++) {
+			if (rte_reorder_insert(b, mbufs[i + j]) < 0)
+				rejected[nb_rejected++] = mbufs[i + j];
+		}
+	}
+
+	return nb_mbufs - nb_rejected;
+}
+
 RTE_EXPORT_SYMBOL(rte_reorder_drain)
 unsigned int
 rte_reorder_drain(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
 		unsigned max_mbufs)
 {
 	unsigned int drain_cnt = 0;
+	unsigned int head, n;
 
 	struct cir_buffer *order_buf = &b->order_buf,
 			*ready_buf = &b->ready_buf;
 
-	/* Try to fetch requested number of mbufs from ready buffer */
+	/*
+	 * Try to fetch requested number of mbufs from ready buffer,
+	 * copying the contiguous entries up to the end of the ring at once.
+	 */
 	while ((drain_cnt < max_mbufs) && (ready_buf->tail != ready_buf->head)) {
-		mbufs[drain_cnt++] = ready_buf->entries[ready_buf->tail];
-		ready_buf->entries[ready_buf->tail] = NULL;
-		ready_buf->tail = (ready_buf->tail + 1) & ready_buf->mask;
+		if (ready_buf->tail < ready_buf->head)
+			n = ready_buf->head - ready_buf->tail;
+		else
+			n = ready_buf->size - ready_buf->tail;
+		n = RTE_MIN(n, max_mbufs - drain_cnt);
+		memcpy(&mbufs[drain_cnt], &ready_buf->entries[ready_buf->tail],
+				n * sizeof(mbufs[0]));
+		memset(&ready_buf->entries[ready_buf->tail], 0,
+				n * sizeof(mbufs[0]));
+		drain_cnt += n;
+		ready_buf->tail = (ready_buf->tail + n) & ready_buf->mask;
 	}
 
 	/*
 	 * If requested number of buffers not fetched from ready buffer, fetch
 	 * remaining buffers from order buffer
 	 */
-	while ((drain_cnt < max_mbufs) &&
-			(order_buf->entries[order_buf->head] != NULL)) {
-		mbufs[drain_cnt++] = order_buf->entries[order_buf->head];
-		order_buf->entries[order_buf->head] = NULL;
-		b->min_seqn++;
-		order_buf->head = (order_buf->head + 1) & order_buf->mask;
+	head = order_buf->head;
+	n = drain_cnt;
+	while ((drain_cnt < max_mbufs) && (order_buf->entries[head] != NULL)) {
+		mbufs[drain_cnt++] = order_buf->entries[head];
+		order_buf->entries[head] = NULL;
+		head = (head + 1) & order_buf->mask;
 	}
+	b->min_seqn += drain_cnt - n;
+	order_buf->head = head;
 
 	return drain_cnt;
 }
@@ -565,3 +702,300 @@ rte_reorder_min_seqn_set(struct rte_reorder_buffer *b, rte_reorder_seqn_t min_se
 
 	return 0;
 }
+
+/*
+ * Multi-stream reorder buffer.
+ *
+ * The packets of a stream are stored in a block of window entries, at the
+ * position given by their sequence number modulo the window, and a bitmap
+ * tells which positions hold a packet. A stream takes a block from the
+ * free list when its first packet is buffered, and gives it back once
+ * all its packets are drained.
+ */
+
+/* Block of a stream which has no buffered packet */
+#define REORDER_MULTI_NO_BLOCK UINT32_MAX
+/* Block of a stream which has never had a packet */
+#define REORDER_MULTI_UNINIT (UINT32_MAX - 1)
+/* Number of packets to prefetch the stream of, ahead of insertion */
+#define REORDER_MULTI_PREFETCH_OFFSET 4U
+
+struct reorder_stream {
+	uint32_t min_seqn; /**< Lowest seq. number that can be in the stream */
+	uint32_t block;    /**< Block of the stream packets */
+	uint64_t bitmap;   /**< Positions of the block holding a packet */
+};
+
+struct __rte_cache_aligned rte_reorder_multi {
+	uint32_t nb_streams;
+	uint32_t window;
+	uint32_t window_mask;  /**< [window - 1]: used for wrap-around */
+	uint32_t nb_blocks;
+	uint64_t window_bits;  /**< bitmap of a full window */
+	uint32_t nb_free;      /**< number of blocks in free_blocks */
+	uint32_t *free_blocks; /**< stack of free blocks */
+	struct reorder_stream *streams;
+	struct rte_mbuf **entries; /**< blocks of window entries */
+};
+
+static int
+rte_reorder_multi_check_params(const struct rte_reorder_multi_params *params)
+{
+	if (params == NULL) {
+		REORDER_LOG(ERR, "Invalid multi-stream reorder parameters: NULL");
+		return -EINVAL;
+	}
+	if (params->nb_streams == 0 || params->nb_blocks == 0 ||
+			params->nb_blocks >= REORDER_MULTI_UNINIT) {
+		REORDER_LOG(ERR, "Invalid number of streams (%u) or blocks (%u)",
+			params->nb_streams, params->nb_blocks);
+		return -EINVAL;
+	}
+	if (!rte_is_power_of_2(params->window) ||
+			params->window > RTE_REORDER_MULTI_MAX_WINDOW) {
+		REORDER_LOG(ERR, "Invalid reorder window %u"
+			" - Not a power of 2 up to %u",
+			params->window, RTE_REORDER_MULTI_MAX_WINDOW);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_multi_memory_footprint_get, 26.03)
+size_t
+rte_reorder_multi_memory_footprint_get(const struct rte_reorder_multi_params *params)
+{
+	return sizeof(struct rte_reorder_multi) +
+		RTE_ALIGN_CEIL((size_t)params->nb_blocks * params->window *
+			sizeof(struct rte_mbuf *), RTE_CACHE_LINE_SIZE) +
+		RTE_ALIGN_CEIL((size_t)params->nb_streams *
+			sizeof(struct reorder_stream), RTE_CACHE_LINE_SIZE) +
+		(size_t)params->nb_blocks * sizeof(uint32_t);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_multi_create, 26.03)
+struct rte_reorder_multi *
+rte_reorder_multi_create(const struct rte_reorder_multi_params *params)
+{
+	struct rte_reorder_multi *m;
+	size_t entries_size, streams_size;
+	uint32_t i;
+	int ret;
+
+	ret = rte_reorder_multi_check_params(params);
+	if (ret < 0) {
+		rte_errno = -ret;
+		return NULL;
+	}
+
+	if (rte_reorder_seqn_dynfield_register() < 0)
+		return NULL;
+
+	m = rte_zmalloc_socket("REORDER_MULTI",
+			rte_reorder_multi_memory_footprint_get(params),
+			RTE_CACHE_LINE_SIZE, params->socket_id);
+	if (m == NULL) {
+		REORDER_LOG(ERR, "Multi-stream reorder buffer allocation failed");
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	entries_size = RTE_ALIGN_CEIL((size_t)params->nb_blocks *
+			params->window * sizeof(struct rte_mbuf *),
+			RTE_CACHE_LINE_SIZE);
+	streams_size = RTE_ALIGN_CEIL((size_t)params->nb_streams *
+			sizeof(struct reorder_stream), RTE_CACHE_LINE_SIZE);
+
+	m->nb_streams = params->nb_streams;
+	m->window = params->window;
+	m->window_mask = params->window - 1;
+	m->window_bits = params->window == 64 ? UINT64_MAX :
+			RTE_BIT64(params->window) - 1;
+	m->nb_blocks = params->nb_blocks;
+	m->entries = (void *)&m[1];
+	m->streams = RTE_PTR_ADD(m->entries, entries_size);
+	m->free_blocks = RTE_PTR_ADD(m->streams, streams_size);
+
+	for (i = 0; i < m->nb_streams; i++)
+		m->streams[i].block = REORDER_MULTI_UNINIT;
+	/* lowest blocks on top of the stack */
+	for (i = 0; i < m->nb_blocks; i++)
+		m->free_blocks[i] = m->nb_blocks - 1 - i;
+	m->nb_free = m->nb_blocks;
+
+	return m;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_multi_free, 26.03)
+void
+rte_reorder_multi_free(struct rte_reorder_multi *m)
+{
+	struct reorder_stream *s;
+	uint64_t bits;
+	uint32_t i;
+
+	if (m == NULL)
+		return;
+
+	for (i = 0; i < m->nb_streams; i++) {
+		s = &m->streams[i];
+		if (s->block >= m->nb_blocks)
+			continue;
+		for (bits = s->bitmap; bits != 0; bits &= bits - 1)
+			rte_pktmbuf_free(m->entries[s->block * m->window +
+					rte_ctz64(bits)]);
+	}
+
+	rte_free(m);
+}
+
+/*
+ * Get the bitmap of a stream, bit n telling whether the packet of
+ * sequence number min_seqn + n is buffered.
+ */
+static inline uint64_t
+reorder_stream_bits(const struct rte_reorder_multi *m,
+		const struct reorder_stream *s)
+{
+	uint32_t shift = s->min_seqn & m->window_mask;
+
+	if (shift == 0)
+		return s->bitmap;
+	return ((s->bitmap >> shift) | (s->bitmap << (m->window - shift))) &
+			m->window_bits;
+}
+
+static inline void
+reorder_stream_release(struct rte_reorder_multi *m, struct reorder_stream *s)
+{
+	if (s->bitmap == 0) {
+		m->free_blocks[m->nb_free++] = s->block;
+		s->block = REORDER_MULTI_NO_BLOCK;
+	}
+}
+
+static inline int
+reorder_stream_insert(struct rte_reorder_multi *m, struct reorder_stream *s,
+		struct rte_mbuf *mbuf)
+{
+	uint32_t seqn = *rte_reorder_seqn(mbuf);
+	uint32_t offset, position;
+
+	if (unlikely(s->block >= m->nb_blocks)) {
+		/*
+		 * Nothing is buffered, so the window of a new stream, or the
+		 * window of a stream too far behind, starts at the packet.
+		 * A late packet (i.e. offset above half of the sequence
+		 * number space) is still rejected.
+		 */
+		offset = seqn - s->min_seqn;
+		if (s->block == REORDER_MULTI_UNINIT ||
+				(offset >= m->window && offset < (UINT32_MAX >> 1)))
+			offset = 0;
+		if (offset >= m->window || m->nb_free == 0)
+			return -1;
+		s->block = m->free_blocks[--m->nb_free];
+		s->min_seqn = seqn - offset;
+	} else {
+		/* the subtraction takes care of the sequence number wrapping */
+		offset = seqn - s->min_seqn;
+		if (offset >= m->window)
+			return -1;
+	}
+
+	position = seqn & m->window_mask;
+	if (s->bitmap & RTE_BIT64(position))
+		return -1;
+	m->entries[s->block * m->window + position] = mbuf;
+	s->bitmap |= RTE_BIT64(position);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_multi_insert_burst, 26.03)
+unsigned int
+rte_reorder_multi_insert_burst(struct rte_reorder_multi *m,
+		const uint32_t *stream_ids, struct rte_mbuf **mbufs,
+		unsigned int nb_mbufs, struct rte_mbuf **rejected)
+{
+	unsigned int i, nb_rejected = 0;
+
+	for (i = 0; i < RTE_MIN(nb_mbufs, REORDER_MULTI_PREFETCH_OFFSET); i++)
+		rte_prefetch0(&m->streams[stream_ids[i]]);
+
+	for (i = 0; i < nb_mbufs; i++) {
+		if (i + REORDER_MULTI_PREFETCH_OFFSET < nb_mbufs)
+			rte_prefetch0(&m->streams[stream_ids[i +
+					REORDER_MULTI_PREFETCH_OFFSET]]);
+
+		RTE_ASSERT(stream_ids[i] < m->nb_streams);
+		if (reorder_stream_insert(m, &m->streams[stream_ids[i]],
+				mbufs[i]) < 0)
+			rejected[nb_rejected++] = mbufs[i];
+	}
+
+	return nb_mbufs - nb_rejected;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_multi_drain, 26.03)
+unsigned int
+rte_reorder_multi_drain(struct rte_reorder_multi *m, uint32_t stream_id,
+		struct rte_mbuf **mbufs, unsigned int max_mbufs)
+{
+	struct reorder_stream *s = &m->streams[stream_id];
+	struct rte_mbuf **block;
+	uint32_t position;
+	uint64_t bits;
+	unsigned int i, n;
+
+	RTE_ASSERT(stream_id < m->nb_streams);
+	if (s->block >= m->nb_blocks)
+		return 0;
+
+	/* number of consecutive packets from the lowest sequence number */
+	bits = reorder_stream_bits(m, s);
+	n = bits == UINT64_MAX ? 64 : rte_ctz64(~bits);
+	n = RTE_MIN(n, max_mbufs);
+
+	block = &m->entries[s->block * m->window];
+	for (i = 0; i < n; i++) {
+		position = (s->min_seqn + i) & m->window_mask;
+		mbufs[i] = block[position];
+		s->bitmap &= ~RTE_BIT64(position);
+	}
+	s->min_seqn += n;
+	reorder_stream_release(m, s);
+
+	return n;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_multi_flush, 26.03)
+unsigned int
+rte_reorder_multi_flush(struct rte_reorder_multi *m, uint32_t stream_id,
+		struct rte_mbuf **mbufs, unsigned int max_mbufs)
+{
+	struct reorder_stream *s = &m->streams[stream_id];
+	struct rte_mbuf **block;
+	uint32_t offset = 0, position;
+	uint64_t bits;
+	unsigned int n = 0;
+
+	RTE_ASSERT(stream_id < m->nb_streams);
+	if (s->block >= m->nb_blocks)
+		return 0;
+
+	block = &m->entries[s->block * m->window];
+	for (bits = reorder_stream_bits(m, s); bits != 0 && n < max_mbufs;
+			bits &= bits - 1) {
+		offset = rte_ctz64(bits);
+		position = (s->min_seqn + offset) & m->window_mask;
+		mbufs[n++] = block[position];
+		s->bitmap &= ~RTE_BIT64(position);
+	}
+	if (n != 0)
+		s->min_seqn += offset + 1;
+	reorder_stream_release(m, s);
+
+	return n;
+}
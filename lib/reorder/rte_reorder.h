@@ -148,6 +148,35 @@ rte_reorder_reset(struct rte_reorder_buffer *b);
 int
 rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Insert a burst of mbufs in reorder buffer in their correct position
+ *
+ * It is equivalent to calling rte_reorder_insert() for each mbuf,
+ * the sequence numbers of several mbufs being checked at once
+ * against the reorder window.
+ *
+ * @param b
+ *   Reorder buffer where the mbufs have to be inserted.
+ * @param mbufs
+ *   mbufs of packets that need to be inserted in reorder buffer.
+ * @param nb_mbufs
+ *   Number of mbufs to insert.
+ * @param rejected
+ *   Array receiving the mbufs that cannot be inserted, in their input order.
+ *   It has room for nb_mbufs mbufs, and may be mbufs itself.
+ *   rte_errno is set as by rte_reorder_insert() for the last rejected mbuf.
+ * @return
+ *   Number of inserted mbufs, nb_mbufs minus the number of mbufs
+ *   written to rejected.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_insert_burst(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
+		unsigned int nb_mbufs, struct rte_mbuf **rejected);
+
 /**
  * Fetch reordered buffers
  *
@@ -231,6 +260,180 @@ __rte_experimental
 unsigned int
 rte_reorder_memory_footprint_get(unsigned int size);
 
+/**
+ * Multi-stream reorder buffer.
+ *
+ * It reorders packets per stream (e.g. per flow), each stream having its
+ * own sequence number space. The out of order packets of all the streams
+ * are kept in a shared pool of blocks: a stream holds a block only while
+ * it has packets waiting to be drained, so that the memory footprint
+ * depends on the number of streams being reordered at a time rather than
+ * on the total number of streams.
+ */
+struct rte_reorder_multi;
+
+/** Maximum reorder window of a stream in a multi-stream reorder buffer. */
+#define RTE_REORDER_MULTI_MAX_WINDOW 64
+
+/**
+ * Parameters of a multi-stream reorder buffer.
+ */
+struct rte_reorder_multi_params {
+	int socket_id;        /**< NUMA node of the buffer memory. */
+	uint32_t nb_streams;  /**< Number of streams, identified by 0 to nb_streams - 1. */
+	/**
+	 * Number of sequence numbers a stream can reorder, power of 2 up to
+	 * RTE_REORDER_MULTI_MAX_WINDOW.
+	 */
+	uint32_t window;
+	/** Number of streams which can have buffered packets at a time. */
+	uint32_t nb_blocks;
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Free a multi-stream reorder buffer, and the packets it holds.
+ *
+ * @param m
+ *   Multi-stream reorder buffer.
+ *   If m is NULL, no operation is performed.
+ */
+__rte_experimental
+void
+rte_reorder_multi_free(struct rte_reorder_multi *m);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Create a multi-stream reorder buffer.
+ *
+ * The first packet inserted for a stream sets the lowest sequence number
+ * expected by the stream.
+ *
+ * @param params
+ *   Parameters of the buffer.
+ * @return
+ *   The multi-stream reorder buffer, or NULL on error
+ *   On error case, rte_errno will be set appropriately:
+ *    - EINVAL - invalid parameters
+ *    - ENOMEM - not enough memory
+ */
+__rte_experimental
+struct rte_reorder_multi *
+rte_reorder_multi_create(const struct rte_reorder_multi_params *params)
+	__rte_malloc __rte_dealloc(rte_reorder_multi_free, 1);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Insert a burst of packets into a multi-stream reorder buffer.
+ *
+ * Each packet is inserted into the stream given by stream_ids,
+ * at the position of its sequence number.
+ * A packet is rejected if:
+ *  - its sequence number is lower than the one expected by its stream
+ *    (i.e. late or duplicate packet), or its position is already used;
+ *  - it is beyond the window of its stream, whereas the stream
+ *    has packets waiting for a missing one.
+ *    The stream may be flushed with rte_reorder_multi_flush()
+ *    before inserting the packet again;
+ *  - no block is available for its stream.
+ *
+ * If a stream has no buffered packet, a packet beyond its window
+ * is accepted and moves the window forward.
+ *
+ * @param m
+ *   Multi-stream reorder buffer.
+ * @param stream_ids
+ *   Stream of each packet.
+ * @param mbufs
+ *   Packets to insert.
+ * @param nb_mbufs
+ *   Number of packets to insert.
+ * @param rejected
+ *   Array receiving the rejected packets, in their input order.
+ *   It has room for nb_mbufs packets, and may be mbufs itself.
+ * @return
+ *   Number of inserted packets, nb_mbufs minus the number of packets
+ *   written to rejected.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_multi_insert_burst(struct rte_reorder_multi *m,
+		const uint32_t *stream_ids, struct rte_mbuf **mbufs,
+		unsigned int nb_mbufs, struct rte_mbuf **rejected);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Fetch the in-order packets of a stream.
+ *
+ * The packets from the lowest sequence number expected by the stream
+ * up to the first missing one are returned.
+ *
+ * @param m
+ *   Multi-stream reorder buffer.
+ * @param stream_id
+ *   Stream to drain.
+ * @param mbufs
+ *   Array of mbufs where the reordered packets are written.
+ * @param max_mbufs
+ *   The number of elements in the mbufs array.
+ * @return
+ *   Number of mbuf pointers written to mbufs.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_multi_drain(struct rte_reorder_multi *m, uint32_t stream_id,
+		struct rte_mbuf **mbufs, unsigned int max_mbufs);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Fetch the packets of a stream, skipping the missing ones.
+ *
+ * The buffered packets are returned in order, and the stream then expects
+ * the sequence number following the last returned one.
+ * It is used when the missing packets are considered lost,
+ * e.g. after a timeout.
+ *
+ * @param m
+ *   Multi-stream reorder buffer.
+ * @param stream_id
+ *   Stream to flush.
+ * @param mbufs
+ *   Array of mbufs where the reordered packets are written.
+ * @param max_mbufs
+ *   The number of elements in the mbufs array.
+ * @return
+ *   Number of mbuf pointers written to mbufs.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_multi_flush(struct rte_reorder_multi *m, uint32_t stream_id,
+		struct rte_mbuf **mbufs, unsigned int max_mbufs);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Determine the amount of memory needed by a multi-stream reorder buffer.
+ *
+ * @param params
+ *   Parameters of the buffer.
+ * @return
+ *   Multi-stream reorder buffer footprint measured in bytes.
+ */
+__rte_experimental
+size_t
+rte_reorder_multi_memory_footprint_get(const struct rte_reorder_multi_params *params);
+
 #ifdef __cplusplus
 }
 #endif
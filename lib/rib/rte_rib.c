@@ -34,35 +34,91 @@ EAL_REGISTER_TAILQ(rte_rib_tailq)
 #define RTE_RIB_NAMESIZE	64
 
 struct rte_rib_node {
-	struct rte_rib_node	*left;
-	struct rte_rib_node	*right;
-	struct rte_rib_node	*parent;
+	RTE_ATOMIC(struct rte_rib_node *) left;
+	RTE_ATOMIC(struct rte_rib_node *) right;
+	RTE_ATOMIC(struct rte_rib_node *) parent;
 	uint32_t	ip;
 	uint8_t		depth;
-	uint8_t		flag;
+	RTE_ATOMIC(uint8_t)	flag;
 	uint64_t	nh;
 	uint64_t ext[];
 };
 
 struct rte_rib {
 	char		name[RTE_RIB_NAMESIZE];
-	struct rte_rib_node	*tree;
+	RTE_ATOMIC(struct rte_rib_node *) tree;
 	struct rte_mempool	*node_pool;
 	uint32_t		cur_nodes;
 	uint32_t		cur_routes;
 	uint32_t		max_nodes;
+	struct rte_rcu_qsbr	*v;		/* RCU QSBR variable. */
+	enum rte_rib_qsbr_mode	rcu_mode;	/* Blocking, defer queue. */
+	struct rte_rcu_qsbr_dq	*dq;		/* RCU QSBR defer queue. */
 };
 
+/*
+ * The flag is read with acquire semantics so that a reader
+ * seeing a valid node also sees its next hop.
+ */
 static inline bool
 is_valid_node(const struct rte_rib_node *node)
 {
-	return (node->flag & RTE_RIB_VALID_NODE) == RTE_RIB_VALID_NODE;
+	return (rte_atomic_load_explicit(&node->flag,
+		rte_memory_order_acquire) & RTE_RIB_VALID_NODE) ==
+		RTE_RIB_VALID_NODE;
+}
+
+/*
+ * Set the flag of a node, publishing a route once its next hop is set
+ */
+static inline void
+set_flag(struct rte_rib_node *node, uint8_t flag)
+{
+	rte_atomic_store_explicit(&node->flag, flag, rte_memory_order_release);
+}
+
+/*
+ * Child and parent links are read with acquire semantics so that
+ * lookups and walks may run concurrently with a writer when
+ * the RIB is protected by RCU.
+ */
+static inline struct rte_rib_node *
+get_left(const struct rte_rib_node *node)
+{
+	return rte_atomic_load_explicit(&node->left, rte_memory_order_acquire);
+}
+
+static inline struct rte_rib_node *
+get_right(const struct rte_rib_node *node)
+{
+	return rte_atomic_load_explicit(&node->right, rte_memory_order_acquire);
+}
+
+static inline struct rte_rib_node *
+get_parent(const struct rte_rib_node *node)
+{
+	return rte_atomic_load_explicit(&node->parent,
+		rte_memory_order_acquire);
 }
 
+/*
+ * Publish a fully initialized node, making it reachable for readers
+ */
+static inline void
+set_link(RTE_ATOMIC(struct rte_rib_node *) *link, struct rte_rib_node *node)
+{
+	rte_atomic_store_explicit(link, node, rte_memory_order_release);
+}
+
+/*
+ * The side of a node is derived from its prefix rather than from
+ * the parent links, which may be changed by a concurrent writer.
+ */
 static inline bool
-is_right_node(const struct rte_rib_node *node)
+is_right_node(const struct rte_rib_node *node,
+	const struct rte_rib_node *parent)
 {
-	return node->parent->right == node;
+	return (node->ip & (1 << (31 - parent->depth))) != 0;
 }
 
 /*
@@ -79,7 +135,14 @@ get_nxt_node(struct rte_rib_node *node, uint32_t ip)
 {
 	if (node->depth == RIB_MAXDEPTH)
 		return NULL;
-	return (ip & (1 << (31 - node->depth))) ? node->right : node->left;
+	return (ip & (1 << (31 - node->depth))) ? get_right(node) :
+		get_left(node);
+}
+
+static inline RTE_ATOMIC(struct rte_rib_node *) *
+get_nxt_link(struct rte_rib_node *node, uint32_t ip)
+{
+	return (ip & (1 << (31 - node->depth))) ? &node->right : &node->left;
 }
 
 static struct rte_rib_node *
@@ -89,12 +152,21 @@ node_alloc(struct rte_rib *rib)
 	int ret;
 
 	ret = rte_mempool_get(rib->node_pool, (void *)&ent);
+	/* If the pool is empty try to reclaim removed nodes. */
+	if (unlikely(ret != 0 && rib->dq != NULL &&
+			rte_rcu_qsbr_dq_reclaim(rib->dq,
+				RTE_RIB_RCU_DQ_RECLAIM_MAX, NULL, NULL,
+				NULL) == 0))
+		ret = rte_mempool_get(rib->node_pool, (void *)&ent);
 	if (unlikely(ret != 0))
 		return NULL;
 	++rib->cur_nodes;
 	return ent;
 }
 
+/*
+ * Return a node to the pool, no reader may reach it anymore
+ */
 static void
 node_free(struct rte_rib *rib, struct rte_rib_node *ent)
 {
@@ -102,6 +174,32 @@ node_free(struct rte_rib *rib, struct rte_rib_node *ent)
 	rte_mempool_put(rib->node_pool, ent);
 }
 
+static void
+__rcu_qsbr_free_resource(void *p, void *data, unsigned int n __rte_unused)
+{
+	node_free(p, *(struct rte_rib_node **)data);
+}
+
+/*
+ * Free a node unlinked from the tree once readers are done with it.
+ * The node is left untouched so that a reader standing on it can
+ * still climb up or continue its walk.
+ */
+static void
+node_retire(struct rte_rib *rib, struct rte_rib_node *ent)
+{
+	if (rib->v == NULL) {
+		node_free(rib, ent);
+	} else if (rib->rcu_mode == RTE_RIB_QSBR_MODE_DQ &&
+			rte_rcu_qsbr_dq_enqueue(rib->dq, &ent) == 0) {
+		return;
+	} else {
+		/* Blocking mode, or the defer queue is full. */
+		rte_rcu_qsbr_synchronize(rib->v, RTE_QSBR_THRID_INVALID);
+		node_free(rib, ent);
+	}
+}
+
 RTE_EXPORT_SYMBOL(rte_rib_lookup)
 struct rte_rib_node *
 rte_rib_lookup(struct rte_rib *rib, uint32_t ip)
@@ -113,7 +211,7 @@ rte_rib_lookup(struct rte_rib *rib, uint32_t ip)
 		return NULL;
 	}
 
-	cur = rib->tree;
+	cur = rte_atomic_load_explicit(&rib->tree, rte_memory_order_acquire);
 	while ((cur != NULL) && is_covered(ip, cur->ip, cur->depth)) {
 		if (is_valid_node(cur))
 			prev = cur;
@@ -130,18 +228,19 @@ rte_rib_lookup_parent(struct rte_rib_node *ent)
 
 	if (ent == NULL)
 		return NULL;
-	tmp = ent->parent;
+	tmp = get_parent(ent);
 	while ((tmp != NULL) &&	!is_valid_node(tmp))
-		tmp = tmp->parent;
+		tmp = get_parent(tmp);
 	return tmp;
 }
 
 static struct rte_rib_node *
-__rib_lookup_exact(struct rte_rib *rib, uint32_t ip, uint8_t depth)
+__rib_lookup_exact(RTE_ATOMIC(struct rte_rib_node *) *root, uint32_t ip,
+	uint8_t depth)
 {
 	struct rte_rib_node *cur;
 
-	cur = rib->tree;
+	cur = rte_atomic_load_explicit(root, rte_memory_order_acquire);
 	while (cur != NULL) {
 		if ((cur->ip == ip) && (cur->depth == depth) &&
 				is_valid_node(cur))
@@ -164,7 +263,7 @@ rte_rib_lookup_exact(struct rte_rib *rib, uint32_t ip, uint8_t depth)
 	}
 	ip &= rte_rib_depth_to_mask(depth);
 
-	return __rib_lookup_exact(rib, ip, depth);
+	return __rib_lookup_exact(&rib->tree, ip, depth);
 }
 
 /*
@@ -177,7 +276,7 @@ struct rte_rib_node *
 rte_rib_get_nxt(struct rte_rib *rib, uint32_t ip,
 	uint8_t depth, struct rte_rib_node *last, int flag)
 {
-	struct rte_rib_node *tmp, *prev = NULL;
+	struct rte_rib_node *tmp, *parent, *child, *prev = NULL;
 
 	if (unlikely(rib == NULL || depth > RIB_MAXDEPTH)) {
 		rte_errno = EINVAL;
@@ -185,20 +284,32 @@ rte_rib_get_nxt(struct rte_rib *rib, uint32_t ip,
 	}
 
 	if (last == NULL) {
-		tmp = rib->tree;
+		tmp = rte_atomic_load_explicit(&rib->tree,
+			rte_memory_order_acquire);
 		while ((tmp) && (tmp->depth < depth))
 			tmp = get_nxt_node(tmp, ip);
 	} else {
 		tmp = last;
-		while ((tmp->parent != NULL) && (is_right_node(tmp) ||
-				(tmp->parent->right == NULL))) {
-			tmp = tmp->parent;
+		while (1) {
+			parent = get_parent(tmp);
+			if (parent == NULL) {
+				tmp = NULL;
+				break;
+			}
+			/* go to the right sibling subtree if there is one */
+			if (!is_right_node(tmp, parent)) {
+				child = get_right(parent);
+				if (child != NULL) {
+					tmp = child;
+					break;
+				}
+			}
+			tmp = parent;
 			if (is_valid_node(tmp) &&
 					(is_covered(tmp->ip, ip, depth) &&
 					(tmp->depth > depth)))
 				return tmp;
 		}
-		tmp = (tmp->parent) ? tmp->parent->right : NULL;
 	}
 	while (tmp) {
 		if (is_valid_node(tmp) &&
@@ -208,7 +319,8 @@ rte_rib_get_nxt(struct rte_rib *rib, uint32_t ip,
 			if (flag == RTE_RIB_GET_NXT_COVER)
 				return prev;
 		}
-		tmp = (tmp->left) ? tmp->left : tmp->right;
+		child = get_left(tmp);
+		tmp = (child != NULL) ? child : get_right(tmp);
 	}
 	return prev;
 }
@@ -217,40 +329,46 @@ RTE_EXPORT_SYMBOL(rte_rib_remove)
 void
 rte_rib_remove(struct rte_rib *rib, uint32_t ip, uint8_t depth)
 {
-	struct rte_rib_node *cur, *prev, *child;
+	struct rte_rib_node *cur, *parent, *child;
 
 	cur = rte_rib_lookup_exact(rib, ip, depth);
 	if (cur == NULL)
 		return;
 
 	--rib->cur_routes;
-	cur->flag &= ~RTE_RIB_VALID_NODE;
+	set_flag(cur, 0);
 	while (!is_valid_node(cur)) {
 		if ((cur->left != NULL) && (cur->right != NULL))
 			return;
 		child = (cur->left == NULL) ? cur->right : cur->left;
+		parent = cur->parent;
 		if (child != NULL)
-			child->parent = cur->parent;
-		if (cur->parent == NULL) {
-			rib->tree = child;
-			node_free(rib, cur);
+			set_link(&child->parent, parent);
+		if (parent == NULL) {
+			set_link(&rib->tree, child);
+			node_retire(rib, cur);
 			return;
 		}
-		if (cur->parent->left == cur)
-			cur->parent->left = child;
+		if (parent->left == cur)
+			set_link(&parent->left, child);
 		else
-			cur->parent->right = child;
-		prev = cur;
-		cur = cur->parent;
-		node_free(rib, prev);
+			set_link(&parent->right, child);
+		node_retire(rib, cur);
+		cur = parent;
 	}
 }
 
-RTE_EXPORT_SYMBOL(rte_rib_insert)
-struct rte_rib_node *
-rte_rib_insert(struct rte_rib *rib, uint32_t ip, uint8_t depth)
+/*
+ * Insert ip/depth with next hop nh into the tree hanging from root.
+ * New nodes are fully initialized before being linked, and
+ * an intermediate node becomes valid only once nh is set,
+ * so that readers never see a partially built route.
+ */
+static struct rte_rib_node *
+rib_insert(struct rte_rib *rib, RTE_ATOMIC(struct rte_rib_node *) *root,
+	uint32_t ip, uint8_t depth, uint64_t nh)
 {
-	struct rte_rib_node **tmp;
+	RTE_ATOMIC(struct rte_rib_node *) *tmp;
 	struct rte_rib_node *prev = NULL;
 	struct rte_rib_node *new_node = NULL;
 	struct rte_rib_node *common_node = NULL;
@@ -258,14 +376,8 @@ rte_rib_insert(struct rte_rib *rib, uint32_t ip, uint8_t depth)
 	uint32_t common_prefix;
 	uint8_t common_depth;
 
-	if (unlikely(rib == NULL || depth > RIB_MAXDEPTH)) {
-		rte_errno = EINVAL;
-		return NULL;
-	}
-
-	tmp = &rib->tree;
-	ip &= rte_rib_depth_to_mask(depth);
-	new_node = __rib_lookup_exact(rib, ip, depth);
+	tmp = root;
+	new_node = __rib_lookup_exact(root, ip, depth);
 	if (new_node != NULL) {
 		rte_errno = EEXIST;
 		return NULL;
@@ -281,16 +393,16 @@ rte_rib_insert(struct rte_rib *rib, uint32_t ip, uint8_t depth)
 	new_node->parent = NULL;
 	new_node->ip = ip;
 	new_node->depth = depth;
+	new_node->nh = nh;
 	new_node->flag = RTE_RIB_VALID_NODE;
 
 	/* traverse down the tree to find matching node or closest matching */
 	while (1) {
 		/* insert as the last node in the branch */
 		if (*tmp == NULL) {
-			*tmp = new_node;
 			new_node->parent = prev;
-			++rib->cur_routes;
-			return *tmp;
+			set_link(tmp, new_node);
+			return new_node;
 		}
 		/*
 		 * Intermediate node found.
@@ -300,8 +412,8 @@ rte_rib_insert(struct rte_rib *rib, uint32_t ip, uint8_t depth)
 		 */
 		if ((ip == (*tmp)->ip) && (depth == (*tmp)->depth)) {
 			node_free(rib, new_node);
-			(*tmp)->flag |= RTE_RIB_VALID_NODE;
-			++rib->cur_routes;
+			(*tmp)->nh = nh;
+			set_flag(*tmp, RTE_RIB_VALID_NODE);
 			return *tmp;
 		}
 		d = (*tmp)->depth;
@@ -324,8 +436,8 @@ rte_rib_insert(struct rte_rib *rib, uint32_t ip, uint8_t depth)
 		else
 			new_node->left = *tmp;
 		new_node->parent = (*tmp)->parent;
-		(*tmp)->parent = new_node;
-		*tmp = new_node;
+		set_link(&(*tmp)->parent, new_node);
+		set_link(tmp, new_node);
 	} else {
 		/* create intermediate node */
 		common_node = node_alloc(rib);
@@ -339,7 +451,6 @@ rte_rib_insert(struct rte_rib *rib, uint32_t ip, uint8_t depth)
 		common_node->flag = 0;
 		common_node->parent = (*tmp)->parent;
 		new_node->parent = common_node;
-		(*tmp)->parent = common_node;
 		if ((new_node->ip & (1 << (31 - common_depth))) == 0) {
 			common_node->left = new_node;
 			common_node->right = *tmp;
@@ -347,12 +458,223 @@ rte_rib_insert(struct rte_rib *rib, uint32_t ip, uint8_t depth)
 			common_node->left = *tmp;
 			common_node->right = new_node;
 		}
-		*tmp = common_node;
+		set_link(&(*tmp)->parent, common_node);
+		set_link(tmp, common_node);
 	}
-	++rib->cur_routes;
 	return new_node;
 }
 
+RTE_EXPORT_SYMBOL(rte_rib_insert)
+struct rte_rib_node *
+rte_rib_insert(struct rte_rib *rib, uint32_t ip, uint8_t depth)
+{
+	struct rte_rib_node *node;
+
+	if (unlikely(rib == NULL || depth > RIB_MAXDEPTH)) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	ip &= rte_rib_depth_to_mask(depth);
+	node = rib_insert(rib, &rib->tree, ip, depth, 0);
+	if (node != NULL)
+		++rib->cur_routes;
+	return node;
+}
+
+/*
+ * Free an off-line subtree, return the number of routes it held
+ */
+static uint32_t
+rib_free_subtree(struct rte_rib *rib, struct rte_rib_node *node)
+{
+	uint32_t nb_routes;
+
+	if (node == NULL)
+		return 0;
+	nb_routes = is_valid_node(node);
+	nb_routes += rib_free_subtree(rib, node->left);
+	nb_routes += rib_free_subtree(rib, node->right);
+	node_free(rib, node);
+	return nb_routes;
+}
+
+/*
+ * Number of intermediate nodes rib_merge() has to allocate
+ * to merge the off-line subtree sub into the tree hanging from cur
+ */
+static uint32_t
+rib_merge_nodes(struct rte_rib_node *cur, struct rte_rib_node *sub)
+{
+	uint32_t nb_nodes = 0;
+
+	while ((sub != NULL) && (cur != NULL)) {
+		if ((cur->ip == sub->ip) && (cur->depth == sub->depth)) {
+			nb_nodes += rib_merge_nodes(cur->left, sub->left);
+			cur = cur->right;
+			sub = sub->right;
+		} else if ((cur->depth < sub->depth) &&
+				is_covered(sub->ip, cur->ip, cur->depth))
+			cur = *get_nxt_link(cur, sub->ip);
+		else if ((sub->depth < cur->depth) &&
+				is_covered(cur->ip, sub->ip, sub->depth))
+			sub = *get_nxt_link(sub, cur->ip);
+		else
+			return nb_nodes + 1;
+	}
+	return nb_nodes;
+}
+
+/*
+ * Merge the off-line subtree sub into the tree hanging from link.
+ * Whenever a whole off-line subtree fits into the tree it is
+ * published with a single store, existing nodes are never copied.
+ * If an intermediate node can not be allocated, the parts of sub
+ * which could not be merged are freed, their routes being counted
+ * in nb_dropped, and -ENOMEM is returned.
+ */
+static int
+rib_merge(struct rte_rib *rib, RTE_ATOMIC(struct rte_rib_node *) *link,
+	struct rte_rib_node *parent, struct rte_rib_node *sub,
+	uint32_t *nb_dropped)
+{
+	RTE_ATOMIC(struct rte_rib_node *) *sub_link;
+	struct rte_rib_node *cur, *tmp, *common_node;
+	uint32_t common_prefix;
+	uint8_t common_depth, depth;
+	int d, ret = 0;
+
+	while (sub != NULL) {
+		cur = *link;
+		if (cur == NULL) {
+			sub->parent = parent;
+			set_link(link, sub);
+			return ret;
+		}
+		if ((cur->ip == sub->ip) && (cur->depth == sub->depth)) {
+			/* same prefix, keep the node readers already see */
+			if (is_valid_node(sub)) {
+				cur->nh = sub->nh;
+				set_flag(cur, RTE_RIB_VALID_NODE);
+			}
+			if (rib_merge(rib, &cur->left, cur, sub->left,
+					nb_dropped) < 0)
+				ret = -ENOMEM;
+			tmp = sub->right;
+			node_free(rib, sub);
+			parent = cur;
+			link = &cur->right;
+			sub = tmp;
+			continue;
+		}
+		if ((cur->depth < sub->depth) &&
+				is_covered(sub->ip, cur->ip, cur->depth)) {
+			parent = cur;
+			link = get_nxt_link(cur, sub->ip);
+			continue;
+		}
+		if ((sub->depth < cur->depth) &&
+				is_covered(cur->ip, sub->ip, sub->depth)) {
+			/*
+			 * sub goes between parent and cur,
+			 * the part of sub on the cur side is merged next
+			 */
+			sub_link = get_nxt_link(sub, cur->ip);
+			tmp = *sub_link;
+			*sub_link = cur;
+			sub->parent = parent;
+			set_link(&cur->parent, sub);
+			set_link(link, sub);
+			parent = sub;
+			link = sub_link;
+			sub = tmp;
+			continue;
+		}
+		/* prefixes diverge, join them with an intermediate node */
+		common_prefix = cur->ip ^ sub->ip;
+		d = (common_prefix == 0) ? 32 : rte_clz32(common_prefix);
+		depth = RTE_MIN(cur->depth, sub->depth);
+		common_depth = RTE_MIN(d, depth);
+		common_node = node_alloc(rib);
+		if (common_node == NULL) {
+			*nb_dropped += rib_free_subtree(rib, sub);
+			return -ENOMEM;
+		}
+		common_node->ip = sub->ip & rte_rib_depth_to_mask(common_depth);
+		common_node->depth = common_depth;
+		common_node->flag = 0;
+		common_node->parent = parent;
+		if ((sub->ip & (1 << (31 - common_depth))) == 0) {
+			common_node->left = sub;
+			common_node->right = cur;
+		} else {
+			common_node->left = cur;
+			common_node->right = sub;
+		}
+		sub->parent = common_node;
+		set_link(&cur->parent, common_node);
+		set_link(link, common_node);
+		return ret;
+	}
+	return ret;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_rib_insert_bulk, 26.03)
+int
+rte_rib_insert_bulk(struct rte_rib *rib, const uint32_t *ips,
+	const uint8_t *depths, const uint64_t *next_hops, unsigned int n)
+{
+	RTE_ATOMIC(struct rte_rib_node *) sub = NULL;
+	struct rte_rib_node *node;
+	uint32_t ip, nb_nodes, nb_dropped = 0;
+	unsigned int i;
+
+	if (unlikely(rib == NULL || ips == NULL || depths == NULL ||
+			next_hops == NULL)) {
+		rte_errno = EINVAL;
+		return -1;
+	}
+
+	/* build a subtree of the new routes, unreachable for readers */
+	for (i = 0; i < n; i++) {
+		if (unlikely(depths[i] > RIB_MAXDEPTH)) {
+			rte_errno = EINVAL;
+			goto free_sub;
+		}
+		ip = ips[i] & rte_rib_depth_to_mask(depths[i]);
+		if (__rib_lookup_exact(&rib->tree, ip, depths[i]) != NULL) {
+			rte_errno = EEXIST;
+			goto free_sub;
+		}
+		node = rib_insert(rib, &sub, ip, depths[i], next_hops[i]);
+		if (node == NULL)
+			goto free_sub;
+	}
+
+	/* make sure the merge can not fail half way */
+	nb_nodes = rib_merge_nodes(rib->tree, sub);
+	if (rte_mempool_avail_count(rib->node_pool) < nb_nodes &&
+			rib->dq != NULL)
+		rte_rcu_qsbr_dq_reclaim(rib->dq, ~0, NULL, NULL, NULL);
+	if (rte_mempool_avail_count(rib->node_pool) < nb_nodes) {
+		rte_errno = ENOMEM;
+		goto free_sub;
+	}
+
+	if (rib_merge(rib, &rib->tree, NULL, sub, &nb_dropped) < 0) {
+		/* the node pool was drained meanwhile */
+		rib->cur_routes += n - nb_dropped;
+		rte_errno = ENOMEM;
+		return -1;
+	}
+	rib->cur_routes += n;
+	return 0;
+
+free_sub:
+	rib_free_subtree(rib, sub);
+	return -1;
+}
+
 RTE_EXPORT_SYMBOL(rte_rib_get_ip)
 int
 rte_rib_get_ip(const struct rte_rib_node *node, uint32_t *ip)
@@ -541,6 +863,11 @@ rte_rib_free(struct rte_rib *rib)
 
 	rte_mcfg_tailq_write_unlock();
 
+	/* there must be no readers left, free nodes right away */
+	rte_rcu_qsbr_dq_delete(rib->dq);
+	rib->dq = NULL;
+	rib->v = NULL;
+
 	while ((tmp = rte_rib_get_nxt(rib, 0, 0, tmp,
 			RTE_RIB_GET_NXT_ALL)) != NULL)
 		rte_rib_remove(rib, tmp->ip, tmp->depth);
@@ -549,3 +876,60 @@ rte_rib_free(struct rte_rib *rib)
 	rte_free(rib);
 	rte_free(te);
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_rib_rcu_qsbr_add, 26.03)
+int
+rte_rib_rcu_qsbr_add(struct rte_rib *rib, struct rte_rib_rcu_config *cfg)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+
+	if (unlikely(rib == NULL || cfg == NULL || cfg->v == NULL)) {
+		rte_errno = EINVAL;
+		return -1;
+	}
+
+	if (rib->v != NULL) {
+		rte_errno = EEXIST;
+		return -1;
+	}
+
+	switch (cfg->mode) {
+	case RTE_RIB_QSBR_MODE_DQ:
+		/* Init QSBR defer queue. */
+		if (snprintf(rcu_dq_name, sizeof(rcu_dq_name),
+				"RIB_RCU_%s", rib->name) >=
+				(int)sizeof(rcu_dq_name))
+			RIB_LOG(NOTICE,
+				"RIB defer queue name truncated to: %s",
+				rcu_dq_name);
+		params.name = rcu_dq_name;
+		params.size = cfg->dq_size;
+		if (params.size == 0)
+			params.size = rib->max_nodes;
+		params.trigger_reclaim_limit = cfg->reclaim_thd;
+		params.max_reclaim_size = cfg->reclaim_max;
+		if (params.max_reclaim_size == 0)
+			params.max_reclaim_size = RTE_RIB_RCU_DQ_RECLAIM_MAX;
+		params.esize = sizeof(struct rte_rib_node *);
+		params.free_fn = __rcu_qsbr_free_resource;
+		params.p = rib;
+		params.v = cfg->v;
+		rib->dq = rte_rcu_qsbr_dq_create(&params);
+		if (rib->dq == NULL) {
+			RIB_LOG(ERR, "RIB defer queue creation failed");
+			return -1;
+		}
+		break;
+	case RTE_RIB_QSBR_MODE_SYNC:
+		/* No other things to do. */
+		break;
+	default:
+		rte_errno = EINVAL;
+		return -1;
+	}
+	rib->rcu_mode = cfg->mode;
+	rib->v = cfg->v;
+
+	return 0;
+}
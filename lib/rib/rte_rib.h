@@ -18,6 +18,7 @@
 #include <stdint.h>
 
 #include <rte_common.h>
+#include <rte_rcu_qsbr.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +49,37 @@ struct rte_rib_conf {
 	int	max_nodes;
 };
 
+/** @internal Default RCU defer queue entries to reclaim in one go. */
+#define RTE_RIB_RCU_DQ_RECLAIM_MAX	16
+
+/** RCU reclamation modes */
+enum rte_rib_qsbr_mode {
+	/** Create defer queue for reclaim. */
+	RTE_RIB_QSBR_MODE_DQ = 0,
+	/** Use blocking mode reclaim. No defer queue created. */
+	RTE_RIB_QSBR_MODE_SYNC
+};
+
+/** RIB RCU QSBR configuration structure. */
+struct rte_rib_rcu_config {
+	/** RCU QSBR variable. */
+	struct rte_rcu_qsbr *v;
+	/** Mode of RCU QSBR. See RTE_RIB_QSBR_MODE_*.
+	 * Default: RTE_RIB_QSBR_MODE_DQ, create defer queue for reclaim.
+	 */
+	enum rte_rib_qsbr_mode mode;
+	/** RCU defer queue size.
+	 * Default: max_nodes of the RIB, the queue never overflows.
+	 */
+	uint32_t dq_size;
+	/** Threshold to trigger auto reclaim. */
+	uint32_t reclaim_thd;
+	/** Max entries to reclaim in one go.
+	 * Default: RTE_RIB_RCU_DQ_RECLAIM_MAX.
+	 */
+	uint32_t reclaim_max;
+};
+
 /**
  * Get an IPv4 mask from prefix length
  * It is caller responsibility to make sure depth is not bigger than 32
@@ -149,6 +181,10 @@ rte_rib_remove(struct rte_rib *rib, uint32_t ip, uint8_t depth);
 /**
  * Insert prefix into the RIB
  *
+ * The prefix is inserted with a zero nexthop. When the RIB is protected
+ * by RCU, readers may see it before rte_rib_set_nh() is called;
+ * rte_rib_insert_bulk() publishes prefixes with their nexthops.
+ *
  * @param rib
  *  RIB object handle
  * @param ip
@@ -162,6 +198,41 @@ rte_rib_remove(struct rte_rib *rib, uint32_t ip, uint8_t depth);
 struct rte_rib_node *
 rte_rib_insert(struct rte_rib *rib, uint32_t ip, uint8_t depth);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Insert a set of prefixes into the RIB
+ *
+ * The new prefixes are first assembled into a subtree which is
+ * not reachable from the RIB, then merged into the RIB attaching
+ * every part of the subtree with a single pointer update.
+ * Concurrent readers see each prefix either fully set up,
+ * including its nexthop, or not at all.
+ * Either all the prefixes are inserted or none of them.
+ *
+ * @param rib
+ *  RIB object handle
+ * @param ips
+ *  nets to be inserted to the RIB
+ * @param depths
+ *  prefix lengths
+ * @param next_hops
+ *  nexthops to set to the inserted prefixes
+ * @param n
+ *  number of prefixes to insert
+ * @return
+ *  0 on success.
+ *  -1 on failure with rte_errno indicating reason for failure:
+ *  - EINVAL - invalid parameter
+ *  - EEXIST - a prefix is already in the RIB or appears twice
+ *  - ENOMEM - not enough free nodes
+ */
+__rte_experimental
+int
+rte_rib_insert_bulk(struct rte_rib *rib, const uint32_t *ips,
+	const uint8_t *depths, const uint64_t *next_hops, unsigned int n);
+
 /**
  * Get an ip from rte_rib_node
  *
@@ -271,6 +342,36 @@ rte_rib_create(const char *name, int socket_id,
 struct rte_rib *
 rte_rib_find_existing(const char *name);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Associate RCU QSBR variable with a RIB object.
+ *
+ * Once it is done, rte_rib_lookup(), rte_rib_lookup_exact(),
+ * rte_rib_lookup_parent() and rte_rib_get_nxt() may run on reader
+ * threads concurrently with a single writer, without locks.
+ * Nodes removed from the RIB are returned to the pool only when
+ * all the readers have reported a quiescent state, so a reader
+ * must not report one in the middle of a rte_rib_get_nxt() walk.
+ * A walk running concurrently with the writer may or may not
+ * return the prefixes inserted or removed meanwhile.
+ *
+ * @param rib
+ *   RIB object handle
+ * @param cfg
+ *   RCU QSBR configuration
+ * @return
+ *  0 on success.
+ *  -1 on failure with rte_errno indicating reason for failure:
+ *  - EINVAL - invalid pointer
+ *  - EEXIST - already added QSBR
+ *  - ENOMEM - memory allocation failure
+ */
+__rte_experimental
+int
+rte_rib_rcu_qsbr_add(struct rte_rib *rib, struct rte_rib_rcu_config *cfg);
+
 #ifdef __cplusplus
 }
 #endif
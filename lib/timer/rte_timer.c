@@ -14,6 +14,7 @@
 #include <rte_eal_memconfig.h>
 #include <rte_memory.h>
 #include <rte_lcore.h>
+#include <rte_malloc.h>
 #include <rte_branch_prediction.h>
 #include <rte_spinlock.h>
 #include <rte_random.h>
@@ -22,6 +23,40 @@
 
 #include "rte_timer.h"
 
+/* The timing wheels have WHEEL_LEVELS levels of WHEEL_SLOTS slots */
+#define WHEEL_BITS 8
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS 4
+/* maximum number of ticks between the current tick and a timer slot */
+#define WHEEL_MAX_DELTA ((UINT64_C(1) << (WHEEL_LEVELS * WHEEL_BITS)) - 1)
+/* default tick duration, in microseconds */
+#define WHEEL_DEFAULT_TICK_US 10
+
+/**
+ * Hierarchical timing wheel of an lcore.
+ *
+ * A timer expiring in delta ticks is stored in the level L for which
+ * delta < WHEEL_SLOTS^(L+1), in the slot given by the L-th digit (in base
+ * WHEEL_SLOTS) of its expiry tick. When the lower digits of the current tick
+ * wrap to zero, the slot of the next level is cascaded, i.e. its timers are
+ * added again into the lower levels.
+ *
+ * In a slot, timers are linked by sl_next[0], and sl_next[1] points to the
+ * link pointing to the timer, i.e. the sl_next[0] of the previous timer or
+ * the slot head, so that a timer is removed in O(1). sl_next[1] is NULL when
+ * the timer is not in the wheel anymore, i.e. when it is in a run list.
+ */
+struct __rte_cache_aligned timer_wheel {
+	uint64_t cur_tick;     /**< next tick to process */
+	uint32_t tick_shift;   /**< log2 of the tick duration in timer cycles */
+	uint32_t nb_timers;    /**< number of timers in the wheel */
+	/** bitmap of the slots which are not empty */
+	uint64_t slot_bmap[WHEEL_LEVELS * WHEEL_SLOTS / 64];
+	/** heads of the slot lists, level by level */
+	struct rte_timer *slots[WHEEL_LEVELS * WHEEL_SLOTS];
+};
+
 /**
  * Per-lcore info for timers.
  */
@@ -40,6 +75,14 @@ struct __rte_cache_aligned priv_timer {
 
 	/** running timer on this lcore now */
 	struct rte_timer *running_tim;
+	/** running timers on this lcore now, when run in bulk */
+	struct rte_timer **running_tims;
+	unsigned int nb_running_tims;
+	/** bitmap of the running_tims entries reconfigured by the callback */
+	uint64_t running_tims_updated;
+
+	/** timing wheel used as pending list, or NULL for the skiplist */
+	struct timer_wheel *wheel;
 
 #ifdef RTE_LIBRTE_TIMER_DEBUG
 	/** per-lcore statistics */
@@ -51,6 +94,7 @@ struct __rte_cache_aligned priv_timer {
 struct rte_timer_data {
 	struct priv_timer priv_timer[RTE_MAX_LCORE];
 	uint8_t internal_flags;
+	struct timer_wheel *wheels; /**< timing wheels of all lcores, or NULL */
 };
 
 #define RTE_MAX_DATA_ELS 64
@@ -85,11 +129,75 @@ timer_data_valid(uint32_t id)
 	timer_data = &rte_timer_data_arr[id];				\
 } while (0)
 
+/* Set up the pending lists of a timer data instance. */
+static int
+timer_data_init_lists(struct rte_timer_data *data,
+		      const struct rte_timer_data_conf *conf)
+{
+	struct timer_wheel *wheels;
+	unsigned int lcore_id;
+	uint64_t tick, cur_tick;
+	uint32_t shift;
+
+	if (conf == NULL || conf->list_type == RTE_TIMER_LIST_SKIPLIST) {
+		for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+			data->priv_timer[lcore_id].wheel = NULL;
+		data->wheels = NULL;
+		return 0;
+	}
+
+	if (conf->list_type != RTE_TIMER_LIST_WHEEL)
+		return -EINVAL;
+
+	tick = conf->wheel_tick;
+	if (tick == 0)
+		tick = rte_get_timer_hz() / (US_PER_S / WHEEL_DEFAULT_TICK_US);
+	shift = rte_log2_u64(tick);
+	if (shift >= 64)
+		return -EINVAL;
+
+	wheels = rte_zmalloc("rte_timer_wheels",
+			     RTE_MAX_LCORE * sizeof(*wheels),
+			     RTE_CACHE_LINE_SIZE);
+	if (wheels == NULL)
+		return -ENOMEM;
+
+	cur_tick = rte_get_timer_cycles() >> shift;
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		wheels[lcore_id].tick_shift = shift;
+		wheels[lcore_id].cur_tick = cur_tick;
+		data->priv_timer[lcore_id].wheel = &wheels[lcore_id];
+	}
+	data->wheels = wheels;
+
+	return 0;
+}
+
+/* Free the pending lists of a timer data instance. */
+static void
+timer_data_free_lists(struct rte_timer_data *data)
+{
+	unsigned int lcore_id;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+		data->priv_timer[lcore_id].wheel = NULL;
+	rte_free(data->wheels);
+	data->wheels = NULL;
+}
+
 RTE_EXPORT_SYMBOL(rte_timer_data_alloc)
 int
 rte_timer_data_alloc(uint32_t *id_ptr)
 {
-	int i;
+	return rte_timer_data_alloc_conf(id_ptr, NULL);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_data_alloc_conf, 26.03)
+int
+rte_timer_data_alloc_conf(uint32_t *id_ptr,
+			  const struct rte_timer_data_conf *conf)
+{
+	int i, ret;
 	struct rte_timer_data *data;
 
 	if (!rte_timer_subsystem_initialized)
@@ -98,6 +206,10 @@ rte_timer_data_alloc(uint32_t *id_ptr)
 	for (i = 0; i < RTE_MAX_DATA_ELS; i++) {
 		data = &rte_timer_data_arr[i];
 		if (!(data->internal_flags & FL_ALLOCATED)) {
+			ret = timer_data_init_lists(data, conf);
+			if (ret < 0)
+				return ret;
+
 			data->internal_flags |= FL_ALLOCATED;
 
 			if (id_ptr)
@@ -118,6 +230,7 @@ rte_timer_data_dealloc(uint32_t id)
 	TIMER_DATA_VALID_GET_OR_ERR_RET(id, timer_data, -EINVAL);
 
 	timer_data->internal_flags &= ~(FL_ALLOCATED);
+	timer_data_free_lists(timer_data);
 
 	return 0;
 }
@@ -128,9 +241,8 @@ rte_timer_data_dealloc(uint32_t id)
  * secondary processes should be empty, the zeroth entry can be shared by
  * multiple processes.
  */
-RTE_EXPORT_SYMBOL(rte_timer_subsystem_init)
-int
-rte_timer_subsystem_init(void)
+static int
+timer_subsystem_init(const struct rte_timer_data_conf *conf)
 {
 	const struct rte_memzone *mz;
 	struct rte_timer_data *data;
@@ -140,6 +252,7 @@ rte_timer_subsystem_init(void)
 			RTE_MAX_DATA_ELS * sizeof(*rte_timer_data_arr);
 	const size_t mem_size = data_arr_size + sizeof(*rte_timer_mz_refcnt);
 	bool do_full_init = true;
+	int ret;
 
 	rte_mcfg_timer_lock();
 
@@ -174,7 +287,17 @@ rte_timer_subsystem_init(void)
 					&data->priv_timer[lcore_id].list_lock);
 				data->priv_timer[lcore_id].prev_lcore =
 					lcore_id;
+				data->priv_timer[lcore_id].wheel = NULL;
 			}
+			data->wheels = NULL;
+		}
+
+		ret = timer_data_init_lists(
+			&rte_timer_data_arr[default_data_id], conf);
+		if (ret < 0) {
+			rte_memzone_free(mz);
+			rte_mcfg_timer_unlock();
+			return ret;
 		}
 	}
 
@@ -188,10 +311,26 @@ rte_timer_subsystem_init(void)
 	return 0;
 }
 
+RTE_EXPORT_SYMBOL(rte_timer_subsystem_init)
+int
+rte_timer_subsystem_init(void)
+{
+	return timer_subsystem_init(NULL);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_subsystem_init_conf, 26.03)
+int
+rte_timer_subsystem_init_conf(const struct rte_timer_data_conf *conf)
+{
+	return timer_subsystem_init(conf);
+}
+
 RTE_EXPORT_SYMBOL(rte_timer_subsystem_finalize)
 void
 rte_timer_subsystem_finalize(void)
 {
+	int i;
+
 	rte_mcfg_timer_lock();
 
 	if (!rte_timer_subsystem_initialized) {
@@ -199,8 +338,11 @@ rte_timer_subsystem_finalize(void)
 		return;
 	}
 
-	if (--(*rte_timer_mz_refcnt) == 0)
+	if (--(*rte_timer_mz_refcnt) == 0) {
+		for (i = 0; i < RTE_MAX_DATA_ELS; i++)
+			timer_data_free_lists(&rte_timer_data_arr[i]);
 		rte_memzone_free(rte_timer_data_mz);
+	}
 
 	rte_timer_subsystem_initialized = 0;
 
@@ -219,6 +361,33 @@ rte_timer_init(struct rte_timer *tim)
 	rte_atomic_store_explicit(&tim->status.u32, status.u32, rte_memory_order_relaxed);
 }
 
+/* check whether the callback of a timer is being run by an lcore */
+static inline bool
+timer_is_running(const struct rte_timer *tim, const struct priv_timer *privp)
+{
+	unsigned int i;
+
+	if (tim == privp->running_tim)
+		return true;
+
+	for (i = 0; i < privp->nb_running_tims; i++)
+		if (tim == privp->running_tims[i])
+			return true;
+
+	return false;
+}
+
+/* flag the bulk entry of a running timer as reconfigured by its callback */
+static inline void
+timer_running_updated(const struct rte_timer *tim, struct priv_timer *privp)
+{
+	unsigned int i;
+
+	for (i = 0; i < privp->nb_running_tims; i++)
+		if (tim == privp->running_tims[i])
+			privp->running_tims_updated |= UINT64_C(1) << i;
+}
+
 /*
  * if timer is pending or stopped (or running on the same core than
  * us), mark timer as configuring, and on success return the previous
@@ -245,7 +414,7 @@ timer_set_config_state(struct rte_timer *tim,
 		 */
 		if (prev_status.state == RTE_TIMER_RUNNING &&
 		    (prev_status.owner != (uint16_t)lcore_id ||
-		     tim != priv_timer[lcore_id].running_tim))
+		     !timer_is_running(tim, &priv_timer[lcore_id])))
 			return -1;
 
 		/* timer is being configured on another core */
@@ -267,6 +436,12 @@ timer_set_config_state(struct rte_timer *tim,
 					      rte_memory_order_relaxed);
 	}
 
+	/* the timer may be freed by the callback once it is reconfigured,
+	 * so the bulk runner must not look at it again
+	 */
+	if (prev_status.state == RTE_TIMER_RUNNING)
+		timer_running_updated(tim, &priv_timer[lcore_id]);
+
 	ret_prev_status->u32 = prev_status.u32;
 	return 0;
 }
@@ -388,6 +563,208 @@ timer_get_prev_entries_for_node(struct rte_timer *tim, unsigned tim_lcore,
 	}
 }
 
+/* get the link pointing to a timer of a timing wheel */
+static inline struct rte_timer **
+timer_wheel_get_pprev(const struct rte_timer *tim)
+{
+	return (struct rte_timer **)(void *)tim->sl_next[1];
+}
+
+static inline void
+timer_wheel_set_pprev(struct rte_timer *tim, struct rte_timer **pprev)
+{
+	tim->sl_next[1] = (struct rte_timer *)(void *)pprev;
+}
+
+/* get the expiry tick of a timer, rounded up so that it never runs early */
+static inline uint64_t
+timer_wheel_expire_tick(const struct timer_wheel *wheel,
+			const struct rte_timer *tim)
+{
+	uint64_t tick_mask = (UINT64_C(1) << wheel->tick_shift) - 1;
+
+	return (tim->expire >> wheel->tick_shift) +
+		((tim->expire & tick_mask) != 0);
+}
+
+/* link a timer into the slot matching its expiry tick */
+static void
+timer_wheel_insert(struct timer_wheel *wheel, struct rte_timer *tim)
+{
+	struct rte_timer **head;
+	uint64_t tick, delta;
+	unsigned int lvl, slot;
+
+	tick = timer_wheel_expire_tick(wheel, tim);
+	if (tick < wheel->cur_tick)
+		tick = wheel->cur_tick;
+
+	/* timers beyond the last level are put back later, when the
+	 * slot covering the end of the wheel is cascaded
+	 */
+	delta = RTE_MIN(tick - wheel->cur_tick, WHEEL_MAX_DELTA);
+	tick = wheel->cur_tick + delta;
+	lvl = delta == 0 ? 0 : (rte_fls_u64(delta) - 1) / WHEEL_BITS;
+	slot = lvl * WHEEL_SLOTS +
+		((tick >> (lvl * WHEEL_BITS)) & WHEEL_MASK);
+
+	head = &wheel->slots[slot];
+	tim->sl_next[0] = *head;
+	if (*head != NULL)
+		timer_wheel_set_pprev(*head, &tim->sl_next[0]);
+	*head = tim;
+	timer_wheel_set_pprev(tim, head);
+	wheel->slot_bmap[slot / 64] |= UINT64_C(1) << (slot % 64);
+}
+
+/* remove the list of timers of a slot, and return it */
+static struct rte_timer *
+timer_wheel_take_slot(struct timer_wheel *wheel, unsigned int slot)
+{
+	struct rte_timer *tim = wheel->slots[slot];
+
+	wheel->slots[slot] = NULL;
+	wheel->slot_bmap[slot / 64] &= ~(UINT64_C(1) << (slot % 64));
+
+	return tim;
+}
+
+/*
+ * Get the first slot of level 0, from idx, which is not empty, or
+ * WHEEL_SLOTS if there is none.
+ */
+static unsigned int
+timer_wheel_next_slot(const struct timer_wheel *wheel, unsigned int idx)
+{
+	unsigned int w;
+	uint64_t bits;
+
+	for (w = idx / 64; w < WHEEL_SLOTS / 64; w++) {
+		bits = wheel->slot_bmap[w];
+		if (w == idx / 64)
+			bits &= UINT64_MAX << (idx % 64);
+		if (bits != 0)
+			return w * 64 + rte_ctz64(bits);
+	}
+
+	return WHEEL_SLOTS;
+}
+
+/* add a timer into a timing wheel */
+static void
+timer_wheel_add(struct timer_wheel *wheel, struct rte_timer *tim)
+{
+	/* the current tick is not updated while the wheel is empty */
+	if (wheel->nb_timers == 0)
+		wheel->cur_tick = rte_get_timer_cycles() >> wheel->tick_shift;
+
+	wheel->nb_timers++;
+	timer_wheel_insert(wheel, tim);
+}
+
+/* remove a timer from a timing wheel, if it is still in it */
+static void
+timer_wheel_del(struct timer_wheel *wheel, struct rte_timer *tim)
+{
+	struct rte_timer **pprev = timer_wheel_get_pprev(tim);
+	struct rte_timer *next = tim->sl_next[0];
+	unsigned int slot;
+
+	/* the timer was moved into a run list */
+	if (pprev == NULL)
+		return;
+
+	*pprev = next;
+	if (next != NULL) {
+		timer_wheel_set_pprev(next, pprev);
+	} else if (pprev >= &wheel->slots[0] &&
+		   pprev < &wheel->slots[RTE_DIM(wheel->slots)] &&
+		   *pprev == NULL) {
+		/* the slot is empty now */
+		slot = pprev - &wheel->slots[0];
+		wheel->slot_bmap[slot / 64] &= ~(UINT64_C(1) << (slot % 64));
+	}
+	timer_wheel_set_pprev(tim, NULL);
+	wheel->nb_timers--;
+}
+
+/*
+ * Move an expired timer from a timing wheel to the tail of a run list, and
+ * mark it as running. Return the new tail of the run list.
+ */
+static inline struct rte_timer **
+timer_wheel_run(struct timer_wheel *wheel, struct rte_timer *tim,
+		struct rte_timer **run_last)
+{
+	timer_wheel_set_pprev(tim, NULL);
+	wheel->nb_timers--;
+
+	/* another core is trying to re-config this one,
+	 * do not add it to local expired list
+	 */
+	if (unlikely(timer_set_running_state(tim) != 0))
+		return run_last;
+
+	*run_last = tim;
+	return &tim->sl_next[0];
+}
+
+/*
+ * Process the ticks of a timing wheel up to cur_time, and return the run
+ * list of the expired timers, linked by sl_next[0] and marked as running.
+ */
+static struct rte_timer *
+timer_wheel_get_expired(struct timer_wheel *wheel, uint64_t cur_time)
+{
+	uint64_t now_tick = cur_time >> wheel->tick_shift;
+	struct rte_timer *run_first_tim = NULL;
+	struct rte_timer **run_last = &run_first_tim;
+	struct rte_timer *tim, *next_tim;
+	unsigned int lvl, idx, lvl_idx;
+
+	while (wheel->cur_tick <= now_tick) {
+		if (wheel->nb_timers == 0) {
+			wheel->cur_tick = now_tick + 1;
+			break;
+		}
+
+		/* when the lower digits wrap, cascade the upper levels */
+		idx = wheel->cur_tick & WHEEL_MASK;
+		for (lvl = 1, lvl_idx = idx;
+		     lvl < WHEEL_LEVELS && lvl_idx == 0; lvl++) {
+			lvl_idx = (wheel->cur_tick >> (lvl * WHEEL_BITS)) &
+				WHEEL_MASK;
+			tim = timer_wheel_take_slot(wheel,
+					lvl * WHEEL_SLOTS + lvl_idx);
+			/*
+			 * Even when late, the expired timers are added again
+			 * into the lower levels, so that they run in the order
+			 * of their expiry ticks.
+			 */
+			for ( ; tim != NULL; tim = next_tim) {
+				next_tim = tim->sl_next[0];
+				timer_wheel_insert(wheel, tim);
+			}
+		}
+
+		/* move the timers of the current slot into the run list */
+		tim = timer_wheel_take_slot(wheel, idx);
+		for ( ; tim != NULL; tim = next_tim) {
+			next_tim = tim->sl_next[0];
+			run_last = timer_wheel_run(wheel, tim, run_last);
+		}
+
+		/* skip the empty slots, up to the next cascade */
+		idx = timer_wheel_next_slot(wheel, idx + 1);
+		wheel->cur_tick = RTE_MIN(
+			(wheel->cur_tick & ~(uint64_t)WHEEL_MASK) + idx,
+			now_tick + 1);
+	}
+	*run_last = NULL;
+
+	return run_first_tim;
+}
+
 /* call with lock held as necessary
  * add in list
  * timer must be in config state
@@ -400,6 +777,11 @@ timer_add(struct rte_timer *tim, unsigned int tim_lcore,
 	unsigned lvl;
 	struct rte_timer *prev[MAX_SKIPLIST_DEPTH+1];
 
+	if (priv_timer[tim_lcore].wheel != NULL) {
+		timer_wheel_add(priv_timer[tim_lcore].wheel, tim);
+		return;
+	}
+
 	/* find where exactly this element goes in the list of elements
 	 * for each depth. */
 	timer_get_prev_entries(tim->expire, tim_lcore, prev, priv_timer);
@@ -425,62 +807,129 @@ timer_add(struct rte_timer *tim, unsigned int tim_lcore,
 			pending_head.sl_next[0]->expire;
 }
 
+/* call with lock held
+ * add in list a set of timers expiring at the same time
+ * timers must be in config state
+ * timers must not be in a list
+ */
+static void
+timer_add_bulk(struct rte_timer **tims, unsigned int nb_timers,
+	       unsigned int tim_lcore, struct priv_timer *priv_timer)
+{
+	struct priv_timer *privp = &priv_timer[tim_lcore];
+	struct rte_timer *prev[MAX_SKIPLIST_DEPTH+1];
+	struct rte_timer *tim;
+	unsigned int i, lvl, tim_level;
+
+	if (privp->wheel != NULL) {
+		for (i = 0; i < nb_timers; i++)
+			timer_wheel_add(privp->wheel, tims[i]);
+		return;
+	}
+
+	if (nb_timers == 0)
+		return;
+
+	/* find where the first timer goes in the list for each depth; as
+	 * the timers expire at the same time, each next timer goes right
+	 * after the previous one at the levels of the previous one */
+	timer_get_prev_entries(tims[0]->expire, tim_lcore, prev, priv_timer);
+
+	for (i = 0; i < nb_timers; i++) {
+		tim = tims[i];
+		tim_level = timer_get_skiplist_level(privp->curr_skiplist_depth);
+		if (tim_level == privp->curr_skiplist_depth) {
+			privp->curr_skiplist_depth++;
+			prev[privp->curr_skiplist_depth] = &privp->pending_head;
+		}
+
+		for (lvl = 0; lvl <= tim_level; lvl++) {
+			tim->sl_next[lvl] = prev[lvl]->sl_next[lvl];
+			prev[lvl]->sl_next[lvl] = tim;
+			prev[lvl] = tim;
+		}
+	}
+
+	/* save the lowest list entry into the expire field of the dummy hdr
+	 * NOTE: this is not atomic on 32-bit*/
+	privp->pending_head.expire = privp->pending_head.sl_next[0]->expire;
+}
+
 /*
- * del from list, lock if needed
- * timer must be in config state
- * timer must be in a list
+ * del from skiplist
+ * call with lock held
  */
 static void
-timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
-	  int local_is_locked, struct priv_timer *priv_timer)
+timer_skiplist_del(struct rte_timer *tim, unsigned int tim_lcore,
+		   struct priv_timer *priv_timer)
 {
-	unsigned lcore_id = rte_lcore_id();
-	unsigned prev_owner = prev_status.owner;
 	int i;
 	struct rte_timer *prev[MAX_SKIPLIST_DEPTH+1];
 
-	/* if timer needs is pending another core, we need to lock the
-	 * list; if it is on local core, we need to lock if we are not
-	 * called from rte_timer_manage() */
-	if (prev_owner != lcore_id || !local_is_locked)
-		rte_spinlock_lock(&priv_timer[prev_owner].list_lock);
-
 	/* save the lowest list entry into the expire field of the dummy hdr.
 	 * NOTE: this is not atomic on 32-bit */
-	if (tim == priv_timer[prev_owner].pending_head.sl_next[0])
-		priv_timer[prev_owner].pending_head.expire =
+	if (tim == priv_timer[tim_lcore].pending_head.sl_next[0])
+		priv_timer[tim_lcore].pending_head.expire =
 				((tim->sl_next[0] == NULL) ? 0 : tim->sl_next[0]->expire);
 
 	/* adjust pointers from previous entries to point past this */
-	timer_get_prev_entries_for_node(tim, prev_owner, prev, priv_timer);
-	for (i = priv_timer[prev_owner].curr_skiplist_depth - 1; i >= 0; i--) {
+	timer_get_prev_entries_for_node(tim, tim_lcore, prev, priv_timer);
+	for (i = priv_timer[tim_lcore].curr_skiplist_depth - 1; i >= 0; i--) {
 		if (prev[i]->sl_next[i] == tim)
 			prev[i]->sl_next[i] = tim->sl_next[i];
 	}
 
 	/* in case we deleted last entry at a level, adjust down max level */
-	for (i = priv_timer[prev_owner].curr_skiplist_depth - 1; i >= 0; i--)
-		if (priv_timer[prev_owner].pending_head.sl_next[i] == NULL)
-			priv_timer[prev_owner].curr_skiplist_depth --;
+	for (i = priv_timer[tim_lcore].curr_skiplist_depth - 1; i >= 0; i--)
+		if (priv_timer[tim_lcore].pending_head.sl_next[i] == NULL)
+			priv_timer[tim_lcore].curr_skiplist_depth --;
 		else
 			break;
+}
+
+/*
+ * del from list
+ * call with lock held
+ */
+static inline void
+timer_list_del(struct rte_timer *tim, unsigned int tim_lcore,
+	       struct priv_timer *priv_timer)
+{
+	if (priv_timer[tim_lcore].wheel != NULL)
+		timer_wheel_del(priv_timer[tim_lcore].wheel, tim);
+	else
+		timer_skiplist_del(tim, tim_lcore, priv_timer);
+}
+
+/*
+ * del from list, lock if needed
+ * timer must be in config state
+ * timer must be in a list
+ */
+static void
+timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
+	  int local_is_locked, struct priv_timer *priv_timer)
+{
+	unsigned lcore_id = rte_lcore_id();
+	unsigned prev_owner = prev_status.owner;
+
+	/* if timer needs is pending another core, we need to lock the
+	 * list; if it is on local core, we need to lock if we are not
+	 * called from rte_timer_manage() */
+	if (prev_owner != lcore_id || !local_is_locked)
+		rte_spinlock_lock(&priv_timer[prev_owner].list_lock);
+
+	timer_list_del(tim, prev_owner, priv_timer);
 
 	if (prev_owner != lcore_id || !local_is_locked)
 		rte_spinlock_unlock(&priv_timer[prev_owner].list_lock);
 }
 
-/* Reset and start the timer associated with the timer handle (private func) */
-static int
-__rte_timer_reset(struct rte_timer *tim, uint64_t expire,
-		  uint64_t period, unsigned tim_lcore,
-		  rte_timer_cb_t fct, void *arg,
-		  int local_is_locked,
-		  struct rte_timer_data *timer_data)
+/* get the lcore of a timer to reset, i.e. the next one if LCORE_ID_ANY */
+static unsigned int
+timer_get_lcore(unsigned int tim_lcore, struct priv_timer *priv_timer)
 {
-	union rte_timer_status prev_status, status;
-	int ret;
-	unsigned lcore_id = rte_lcore_id();
-	struct priv_timer *priv_timer = timer_data->priv_timer;
+	unsigned int lcore_id = rte_lcore_id();
 
 	/* round robin for tim_lcore */
 	if (tim_lcore == (unsigned)LCORE_ID_ANY) {
@@ -496,6 +945,25 @@ __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 			tim_lcore = rte_get_next_lcore(LCORE_ID_ANY, 0, 1);
 	}
 
+	return tim_lcore;
+}
+
+/* Reset and start the timer associated with the timer handle (private func) */
+static int
+__rte_timer_reset(struct rte_timer *tim, uint64_t expire,
+		  uint64_t period, unsigned tim_lcore,
+		  rte_timer_cb_t fct, void *arg,
+		  int local_is_locked,
+		  struct rte_timer_data *timer_data)
+{
+	union rte_timer_status prev_status, status;
+	int ret;
+	unsigned lcore_id = rte_lcore_id();
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+
+	/* round robin for tim_lcore */
+	tim_lcore = timer_get_lcore(tim_lcore, priv_timer);
+
 	/* wait that the timer is in correct status before update,
 	 * and mark it as being configured */
 	ret = timer_set_config_state(tim, &prev_status, priv_timer);
@@ -654,71 +1122,308 @@ rte_timer_stop_sync(struct rte_timer *tim)
 		rte_pause();
 }
 
-/* Test the PENDING status of the timer handle tim */
-RTE_EXPORT_SYMBOL(rte_timer_pending)
-int
-rte_timer_pending(struct rte_timer *tim)
+/* maximum number of timers configured together by the bulk functions */
+#define TIMER_BULK_CHUNK 32
+
+/*
+ * Mark the timers of tims[*next..nb_timers) as being configured, until
+ * TIMER_BULK_CHUNK of them are. The marked timers are swapped to
+ * tims[first..first + n), n being the returned value, with their previous
+ * status in prev_status and their original index in tims in idx.
+ */
+static unsigned int
+timer_bulk_set_config_state(struct rte_timer **tims, unsigned int nb_timers,
+			    unsigned int first, unsigned int *next,
+			    union rte_timer_status *prev_status,
+			    unsigned int *idx, struct priv_timer *priv_timer)
 {
-	return rte_atomic_load_explicit(&tim->status.state,
-				rte_memory_order_relaxed) == RTE_TIMER_PENDING;
+	unsigned int lcore_id = rte_lcore_id();
+	struct rte_timer *tim;
+	unsigned int i, n = 0;
+
+	for (i = *next; i < nb_timers && n < TIMER_BULK_CHUNK; i++) {
+		tim = tims[i];
+		if (timer_set_config_state(tim, &prev_status[n],
+					   priv_timer) < 0)
+			continue;
+
+		if (prev_status[n].state == RTE_TIMER_RUNNING &&
+		    lcore_id < RTE_MAX_LCORE)
+			priv_timer[lcore_id].updated = 1;
+
+		tims[i] = tims[first + n];
+		tims[first + n] = tim;
+		idx[n++] = i;
+	}
+	*next = i;
+
+	return n;
 }
 
-/* must be called periodically, run all timer that expired */
+/*
+ * Remove from the lists the pending timers of a set of timers in config
+ * state. The list lock of an lcore is taken once for consecutive timers
+ * pending on that lcore.
+ */
 static void
-__rte_timer_manage(struct rte_timer_data *timer_data)
+timer_del_bulk(struct rte_timer **tims,
+	       const union rte_timer_status *prev_status,
+	       unsigned int nb_timers, struct priv_timer *priv_timer)
 {
-	union rte_timer_status status;
-	struct rte_timer *tim, *next_tim;
-	struct rte_timer *run_first_tim, **pprev;
-	unsigned lcore_id = rte_lcore_id();
-	struct rte_timer *prev[MAX_SKIPLIST_DEPTH + 1];
-	uint64_t cur_time;
-	int i, ret;
-	struct priv_timer *priv_timer = timer_data->priv_timer;
+	unsigned int locked_lcore = RTE_MAX_LCORE;
+	unsigned int i, prev_owner;
 
-	/* timer manager only runs on EAL thread with valid lcore_id */
-	assert(lcore_id < RTE_MAX_LCORE);
+	for (i = 0; i < nb_timers; i++) {
+		if (prev_status[i].state != RTE_TIMER_PENDING)
+			continue;
 
-	__TIMER_STAT_ADD(priv_timer, manage, 1);
-	/* optimize for the case where per-cpu list is empty */
-	if (priv_timer[lcore_id].pending_head.sl_next[0] == NULL)
-		return;
-	cur_time = rte_get_timer_cycles();
+		prev_owner = prev_status[i].owner;
+		if (prev_owner != locked_lcore) {
+			if (locked_lcore != RTE_MAX_LCORE)
+				rte_spinlock_unlock(
+					&priv_timer[locked_lcore].list_lock);
+			rte_spinlock_lock(&priv_timer[prev_owner].list_lock);
+			locked_lcore = prev_owner;
+		}
 
-#ifdef RTE_ARCH_64
-	/* on 64-bit the value cached in the pending_head.expired will be
-	 * updated atomically, so we can consult that for a quick check here
-	 * outside the lock */
-	if (likely(priv_timer[lcore_id].pending_head.expire > cur_time))
-		return;
-#endif
+		timer_list_del(tims[i], prev_owner, priv_timer);
+		__TIMER_STAT_ADD(priv_timer, pending, -1);
+	}
 
-	/* browse ordered list, add expired timers in 'expired' list */
-	rte_spinlock_lock(&priv_timer[lcore_id].list_lock);
+	if (locked_lcore != RTE_MAX_LCORE)
+		rte_spinlock_unlock(&priv_timer[locked_lcore].list_lock);
+}
 
-	/* if nothing to do just unlock and return */
-	if (priv_timer[lcore_id].pending_head.sl_next[0] == NULL ||
-	    priv_timer[lcore_id].pending_head.sl_next[0]->expire > cur_time) {
-		rte_spinlock_unlock(&priv_timer[lcore_id].list_lock);
-		return;
+/* Reset and start a set of timers (private func) */
+static int
+__rte_timer_reset_bulk(struct rte_timer **tims, unsigned int nb_timers,
+		       uint64_t expire, uint64_t period,
+		       unsigned int tim_lcore, rte_timer_cb_t fct,
+		       void *const *args, struct rte_timer_data *timer_data)
+{
+	union rte_timer_status prev_status[TIMER_BULK_CHUNK], status;
+	unsigned int idx[TIMER_BULK_CHUNK];
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+	unsigned int i, n, next = 0, nb_done = 0;
+	struct rte_timer *tim;
+
+	tim_lcore = timer_get_lcore(tim_lcore, priv_timer);
+
+	status.state = RTE_TIMER_PENDING;
+	status.owner = (int16_t)tim_lcore;
+
+	while (next < nb_timers) {
+		/* wait that the timers are in correct status before update,
+		 * and mark them as being configured */
+		n = timer_bulk_set_config_state(tims, nb_timers, nb_done,
+				&next, prev_status, idx, priv_timer);
+		if (n == 0)
+			break;
+
+		__TIMER_STAT_ADD(priv_timer, reset, n);
+
+		/* remove them from lists */
+		timer_del_bulk(&tims[nb_done], prev_status, n, priv_timer);
+
+		for (i = 0; i < n; i++) {
+			tim = tims[nb_done + i];
+			tim->period = period;
+			tim->expire = expire;
+			tim->f = fct;
+			tim->arg = args == NULL ? NULL : args[idx[i]];
+		}
+
+		rte_spinlock_lock(&priv_timer[tim_lcore].list_lock);
+
+		__TIMER_STAT_ADD(priv_timer, pending, n);
+		timer_add_bulk(&tims[nb_done], n, tim_lcore, priv_timer);
+
+		/* update state: as we are in CONFIG state, only us can modify
+		 * the state so we don't need to use cmpset() here */
+		for (i = 0; i < n; i++)
+			rte_atomic_store_explicit(&tims[nb_done + i]->status.u32,
+				status.u32, rte_memory_order_release);
+
+		rte_spinlock_unlock(&priv_timer[tim_lcore].list_lock);
+
+		nb_done += n;
 	}
 
+	return nb_done;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_reset_bulk, 26.03)
+int
+rte_timer_reset_bulk(struct rte_timer **tims, unsigned int nb_timers,
+		     uint64_t ticks, enum rte_timer_type type,
+		     unsigned int tim_lcore, rte_timer_cb_t fct,
+		     void *const *args)
+{
+	return rte_timer_alt_reset_bulk(default_data_id, tims, nb_timers,
+					ticks, type, tim_lcore, fct, args);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_alt_reset_bulk, 26.03)
+int
+rte_timer_alt_reset_bulk(uint32_t timer_data_id, struct rte_timer **tims,
+			 unsigned int nb_timers, uint64_t ticks,
+			 enum rte_timer_type type, unsigned int tim_lcore,
+			 rte_timer_cb_t fct, void *const *args)
+{
+	uint64_t cur_time = rte_get_timer_cycles();
+	uint64_t period;
+	struct rte_timer_data *timer_data;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+
+	if (type == PERIODICAL)
+		period = ticks;
+	else
+		period = 0;
+
+	return __rte_timer_reset_bulk(tims, nb_timers, cur_time + ticks,
+				      period, tim_lcore, fct, args,
+				      timer_data);
+}
+
+/* Stop a set of timers (private func) */
+static int
+__rte_timer_stop_bulk(struct rte_timer **tims, unsigned int nb_timers,
+		      struct rte_timer_data *timer_data)
+{
+	union rte_timer_status prev_status[TIMER_BULK_CHUNK], status;
+	unsigned int idx[TIMER_BULK_CHUNK];
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+	unsigned int i, n, next = 0, nb_done = 0;
+
+	status.state = RTE_TIMER_STOP;
+	status.owner = RTE_TIMER_NO_OWNER;
+
+	while (next < nb_timers) {
+		/* wait that the timers are in correct status before update,
+		 * and mark them as being configured */
+		n = timer_bulk_set_config_state(tims, nb_timers, nb_done,
+				&next, prev_status, idx, priv_timer);
+		if (n == 0)
+			break;
+
+		__TIMER_STAT_ADD(priv_timer, stop, n);
+
+		/* remove them from lists */
+		timer_del_bulk(&tims[nb_done], prev_status, n, priv_timer);
+
+		/* mark timers as stopped */
+		for (i = 0; i < n; i++)
+			rte_atomic_store_explicit(&tims[nb_done + i]->status.u32,
+				status.u32, rte_memory_order_release);
+
+		nb_done += n;
+	}
+
+	return nb_done;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_stop_bulk, 26.03)
+int
+rte_timer_stop_bulk(struct rte_timer **tims, unsigned int nb_timers)
+{
+	return rte_timer_alt_stop_bulk(default_data_id, tims, nb_timers);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_alt_stop_bulk, 26.03)
+int
+rte_timer_alt_stop_bulk(uint32_t timer_data_id, struct rte_timer **tims,
+			unsigned int nb_timers)
+{
+	struct rte_timer_data *timer_data;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+
+	return __rte_timer_stop_bulk(tims, nb_timers, timer_data);
+}
+
+/* Test the PENDING status of the timer handle tim */
+RTE_EXPORT_SYMBOL(rte_timer_pending)
+int
+rte_timer_pending(struct rte_timer *tim)
+{
+	return rte_atomic_load_explicit(&tim->status.state,
+				rte_memory_order_relaxed) == RTE_TIMER_PENDING;
+}
+
+/* check whether the pending list of an lcore is empty */
+static inline bool
+timer_pending_empty(const struct priv_timer *privp)
+{
+	if (privp->wheel != NULL)
+		return privp->wheel->nb_timers == 0;
+
+	return privp->pending_head.sl_next[0] == NULL;
+}
+
+/*
+ * Get the time before which no timer of the pending list of an lcore
+ * expires, without the list lock. It is consistent on 64-bit only.
+ */
+static inline uint64_t
+timer_pending_next_expire(const struct priv_timer *privp)
+{
+	if (privp->wheel != NULL)
+		return privp->wheel->cur_tick << privp->wheel->tick_shift;
+
+	return privp->pending_head.expire;
+}
+
+/*
+ * Remove the timers of the skiplist of an lcore which expired at cur_time,
+ * and return them in a list linked by sl_next[0].
+ */
+static struct rte_timer *
+timer_skiplist_get_expired(struct priv_timer *priv_timer,
+			   unsigned int lcore_id, uint64_t cur_time)
+{
+	struct priv_timer *privp = &priv_timer[lcore_id];
+	struct rte_timer *prev[MAX_SKIPLIST_DEPTH + 1];
+	struct rte_timer *tim;
+	int i;
+
+	/* if nothing to do just return */
+	if (privp->pending_head.sl_next[0] == NULL ||
+	    privp->pending_head.sl_next[0]->expire > cur_time)
+		return NULL;
+
 	/* save start of list of expired timers */
-	tim = priv_timer[lcore_id].pending_head.sl_next[0];
+	tim = privp->pending_head.sl_next[0];
 
 	/* break the existing list at current time point */
 	timer_get_prev_entries(cur_time, lcore_id, prev, priv_timer);
-	for (i = priv_timer[lcore_id].curr_skiplist_depth -1; i >= 0; i--) {
-		if (prev[i] == &priv_timer[lcore_id].pending_head)
+	for (i = privp->curr_skiplist_depth - 1; i >= 0; i--) {
+		if (prev[i] == &privp->pending_head)
 			continue;
-		priv_timer[lcore_id].pending_head.sl_next[i] =
-		    prev[i]->sl_next[i];
+		privp->pending_head.sl_next[i] = prev[i]->sl_next[i];
 		if (prev[i]->sl_next[i] == NULL)
-			priv_timer[lcore_id].curr_skiplist_depth--;
-		prev[i] ->sl_next[i] = NULL;
+			privp->curr_skiplist_depth--;
+		prev[i]->sl_next[i] = NULL;
 	}
 
-	/* transition run-list from PENDING to RUNNING */
+	/* update the next to expire timer value */
+	privp->pending_head.expire =
+	    (privp->pending_head.sl_next[0] == NULL) ? 0 :
+		privp->pending_head.sl_next[0]->expire;
+
+	return tim;
+}
+
+/*
+ * Transition a run list from PENDING to RUNNING, and return it without
+ * the timers which another core is re-configuring.
+ */
+static struct rte_timer *
+timer_set_running_list(struct rte_timer *tim)
+{
+	struct rte_timer *run_first_tim, *next_tim, **pprev;
+	int ret;
+
 	run_first_tim = tim;
 	pprev = &run_first_tim;
 
@@ -736,13 +1441,64 @@ __rte_timer_manage(struct rte_timer_data *timer_data)
 		}
 	}
 
-	/* update the next to expire timer value */
-	priv_timer[lcore_id].pending_head.expire =
-	    (priv_timer[lcore_id].pending_head.sl_next[0] == NULL) ? 0 :
-		priv_timer[lcore_id].pending_head.sl_next[0]->expire;
+	return run_first_tim;
+}
+
+/*
+ * Get the run list of the timers of an lcore which expired at cur_time.
+ * Call with the list lock held.
+ */
+static struct rte_timer *
+timer_get_expired(struct priv_timer *priv_timer, unsigned int lcore_id,
+		  uint64_t cur_time)
+{
+	struct rte_timer *tim;
+
+	if (priv_timer[lcore_id].wheel != NULL)
+		return timer_wheel_get_expired(priv_timer[lcore_id].wheel,
+					       cur_time);
+
+	tim = timer_skiplist_get_expired(priv_timer, lcore_id, cur_time);
+	return timer_set_running_list(tim);
+}
 
+/* must be called periodically, run all timer that expired */
+static void
+__rte_timer_manage(struct rte_timer_data *timer_data)
+{
+	union rte_timer_status status;
+	struct rte_timer *tim, *next_tim;
+	struct rte_timer *run_first_tim;
+	unsigned lcore_id = rte_lcore_id();
+	uint64_t cur_time;
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+
+	/* timer manager only runs on EAL thread with valid lcore_id */
+	assert(lcore_id < RTE_MAX_LCORE);
+
+	__TIMER_STAT_ADD(priv_timer, manage, 1);
+	/* optimize for the case where per-cpu list is empty */
+	if (timer_pending_empty(&priv_timer[lcore_id]))
+		return;
+	cur_time = rte_get_timer_cycles();
+
+#ifdef RTE_ARCH_64
+	/* on 64-bit the value cached in the pending_head.expired or in the
+	 * timing wheel will be updated atomically, so we can consult that
+	 * for a quick check here outside the lock */
+	if (likely(timer_pending_next_expire(&priv_timer[lcore_id]) > cur_time))
+		return;
+#endif
+
+	/* browse pending list, add expired timers in 'expired' list */
+	rte_spinlock_lock(&priv_timer[lcore_id].list_lock);
+	run_first_tim = timer_get_expired(priv_timer, lcore_id, cur_time);
 	rte_spinlock_unlock(&priv_timer[lcore_id].list_lock);
 
+	/* if nothing to do just return */
+	if (run_first_tim == NULL)
+		return;
+
 	/* now scan expired list and call callbacks */
 	for (tim = run_first_tim; tim != NULL; tim = next_tim) {
 		next_tim = tim->sl_next[0];
@@ -803,31 +1559,22 @@ rte_timer_manage(void)
 	return 0;
 }
 
-RTE_EXPORT_SYMBOL(rte_timer_alt_manage)
-int
-rte_timer_alt_manage(uint32_t timer_data_id,
-		     unsigned int *poll_lcores,
-		     int nb_poll_lcores,
-		     rte_timer_alt_manage_cb_t f)
+/*
+ * Get the run lists of the expired timers of a set of lcores, and return the
+ * number of run lists.
+ */
+static int
+timer_get_runlists(struct rte_timer_data *data, unsigned int *poll_lcores,
+		   int nb_poll_lcores, struct rte_timer **run_first_tims)
 {
 	unsigned int default_poll_lcores[] = {rte_lcore_id()};
-	union rte_timer_status status;
-	struct rte_timer *tim, *next_tim, **pprev;
-	struct rte_timer *run_first_tims[RTE_MAX_LCORE];
-	unsigned int this_lcore = rte_lcore_id();
-	struct rte_timer *prev[MAX_SKIPLIST_DEPTH + 1];
+	struct rte_timer *tim;
 	uint64_t cur_time;
-	int i, j, ret;
+	int i;
 	int nb_runlists = 0;
-	struct rte_timer_data *data;
 	struct priv_timer *privp;
 	uint32_t poll_lcore;
 
-	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, data, -EINVAL);
-
-	/* timer manager only runs on EAL thread with valid lcore_id */
-	assert(this_lcore < RTE_MAX_LCORE);
-
 	__TIMER_STAT_ADD(data->priv_timer, manage, 1);
 
 	if (poll_lcores == NULL) {
@@ -840,100 +1587,83 @@ rte_timer_alt_manage(uint32_t timer_data_id,
 		privp = &data->priv_timer[poll_lcore];
 
 		/* optimize for the case where per-cpu list is empty */
-		if (privp->pending_head.sl_next[0] == NULL)
+		if (timer_pending_empty(privp))
 			continue;
 		cur_time = rte_get_timer_cycles();
 
 #ifdef RTE_ARCH_64
-		/* on 64-bit the value cached in the pending_head.expired will
-		 * be updated atomically, so we can consult that for a quick
-		 * check here outside the lock
+		/* on 64-bit the value cached in the pending_head.expired or in
+		 * the timing wheel will be updated atomically, so we can
+		 * consult that for a quick check here outside the lock
 		 */
-		if (likely(privp->pending_head.expire > cur_time))
+		if (likely(timer_pending_next_expire(privp) > cur_time))
 			continue;
 #endif
 
-		/* browse ordered list, add expired timers in 'expired' list */
+		/* browse pending list, add expired timers in 'expired' list */
 		rte_spinlock_lock(&privp->list_lock);
+		tim = timer_get_expired(data->priv_timer, poll_lcore, cur_time);
+		rte_spinlock_unlock(&privp->list_lock);
 
-		/* if nothing to do just unlock and return */
-		if (privp->pending_head.sl_next[0] == NULL ||
-		    privp->pending_head.sl_next[0]->expire > cur_time) {
-			rte_spinlock_unlock(&privp->list_lock);
-			continue;
-		}
-
-		/* save start of list of expired timers */
-		tim = privp->pending_head.sl_next[0];
-
-		/* break the existing list at current time point */
-		timer_get_prev_entries(cur_time, poll_lcore, prev,
-				       data->priv_timer);
-		for (j = privp->curr_skiplist_depth - 1; j >= 0; j--) {
-			if (prev[j] == &privp->pending_head)
-				continue;
-			privp->pending_head.sl_next[j] =
-				prev[j]->sl_next[j];
-			if (prev[j]->sl_next[j] == NULL)
-				privp->curr_skiplist_depth--;
+		if (tim != NULL)
+			run_first_tims[nb_runlists++] = tim;
+	}
 
-			prev[j]->sl_next[j] = NULL;
-		}
+	return nb_runlists;
+}
 
-		/* transition run-list from PENDING to RUNNING */
-		run_first_tims[nb_runlists] = tim;
-		pprev = &run_first_tims[nb_runlists];
-		nb_runlists++;
+/* Take the next oldest timer to process from run lists, if any */
+static struct rte_timer *
+timer_runlists_next(struct rte_timer **run_first_tims, int nb_runlists)
+{
+	uint64_t min_expire = UINT64_MAX;
+	struct rte_timer *tim;
+	int i, min_idx = -1;
 
-		for ( ; tim != NULL; tim = next_tim) {
-			next_tim = tim->sl_next[0];
+	for (i = 0; i < nb_runlists; i++) {
+		tim = run_first_tims[i];
 
-			ret = timer_set_running_state(tim);
-			if (likely(ret == 0)) {
-				pprev = &tim->sl_next[0];
-			} else {
-				/* another core is trying to re-config this one,
-				 * remove it from local expired list
-				 */
-				*pprev = next_tim;
-			}
+		if (tim != NULL && tim->expire < min_expire) {
+			min_expire = tim->expire;
+			min_idx = i;
 		}
-
-		/* update the next to expire timer value */
-		privp->pending_head.expire =
-		    (privp->pending_head.sl_next[0] == NULL) ? 0 :
-			privp->pending_head.sl_next[0]->expire;
-
-		rte_spinlock_unlock(&privp->list_lock);
 	}
 
-	/* Now process the run lists */
-	while (1) {
-		bool done = true;
-		uint64_t min_expire = UINT64_MAX;
-		int min_idx = 0;
+	if (min_idx < 0)
+		return NULL;
 
-		/* Find the next oldest timer to process */
-		for (i = 0; i < nb_runlists; i++) {
-			tim = run_first_tims[i];
+	/* Move down the runlist from which we picked a timer */
+	tim = run_first_tims[min_idx];
+	run_first_tims[min_idx] = tim->sl_next[0];
 
-			if (tim != NULL && tim->expire < min_expire) {
-				min_expire = tim->expire;
-				min_idx = i;
-				done = false;
-			}
-		}
+	return tim;
+}
 
-		if (done)
-			break;
+RTE_EXPORT_SYMBOL(rte_timer_alt_manage)
+int
+rte_timer_alt_manage(uint32_t timer_data_id,
+		     unsigned int *poll_lcores,
+		     int nb_poll_lcores,
+		     rte_timer_alt_manage_cb_t f)
+{
+	union rte_timer_status status;
+	struct rte_timer *tim;
+	struct rte_timer *run_first_tims[RTE_MAX_LCORE];
+	unsigned int this_lcore = rte_lcore_id();
+	int nb_runlists;
+	struct rte_timer_data *data;
 
-		tim = run_first_tims[min_idx];
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, data, -EINVAL);
 
-		/* Move down the runlist from which we picked a timer to
-		 * execute
-		 */
-		run_first_tims[min_idx] = run_first_tims[min_idx]->sl_next[0];
+	/* timer manager only runs on EAL thread with valid lcore_id */
+	assert(this_lcore < RTE_MAX_LCORE);
 
+	nb_runlists = timer_get_runlists(data, poll_lcores, nb_poll_lcores,
+					 run_first_tims);
+
+	/* Now process the run lists, oldest timers first */
+	while ((tim = timer_runlists_next(run_first_tims,
+					  nb_runlists)) != NULL) {
 		data->priv_timer[this_lcore].updated = 0;
 		data->priv_timer[this_lcore].running_tim = tim;
 
@@ -984,6 +1714,119 @@ rte_timer_alt_manage(uint32_t timer_data_id,
 	return 0;
 }
 
+/* Run the timers of run lists by arrays with the callback function f */
+static void
+timer_run_bulk(struct rte_timer_data *data, struct rte_timer **run_first_tims,
+	       int nb_runlists, rte_timer_manage_bulk_cb_t f, void *arg)
+{
+	struct rte_timer *tims[RTE_TIMER_MANAGE_BULK_SIZE];
+	unsigned int this_lcore = rte_lcore_id();
+	struct priv_timer *privp = &data->priv_timer[this_lcore];
+	union rte_timer_status stopped, pending;
+	unsigned int i, n, nb_periodic;
+	struct rte_timer *tim;
+	uint64_t updated;
+
+	RTE_BUILD_BUG_ON(RTE_TIMER_MANAGE_BULK_SIZE > 64);
+
+	stopped.state = RTE_TIMER_STOP;
+	stopped.owner = RTE_TIMER_NO_OWNER;
+	pending.state = RTE_TIMER_PENDING;
+	pending.owner = (int16_t)this_lcore;
+
+	for (;;) {
+		for (n = 0; n < RTE_DIM(tims); n++) {
+			tims[n] = timer_runlists_next(run_first_tims,
+						      nb_runlists);
+			if (tims[n] == NULL)
+				break;
+		}
+		if (n == 0)
+			break;
+
+		/* the callback function may reconfigure any of these */
+		privp->running_tims = tims;
+		privp->nb_running_tims = n;
+		privp->running_tims_updated = 0;
+
+		f(tims, n, arg);
+
+		updated = privp->running_tims_updated;
+		privp->nb_running_tims = 0;
+		privp->running_tims = NULL;
+
+		__TIMER_STAT_ADD(data->priv_timer, pending, -(int)n);
+
+		nb_periodic = 0;
+		for (i = 0; i < n; i++) {
+			/* the timer was stopped or reloaded by the callback
+			 * function, and may even be freed: do not touch it
+			 */
+			if (updated & (UINT64_C(1) << i))
+				continue;
+
+			tim = tims[i];
+
+			if (tim->period == 0)
+				/* mark timer as stopped */
+				rte_atomic_store_explicit(&tim->status.u32,
+					stopped.u32, rte_memory_order_release);
+			else
+				tims[nb_periodic++] = tim;
+		}
+
+		if (nb_periodic == 0)
+			continue;
+
+		/* add the periodic timers in list and mark them as pending */
+		rte_spinlock_lock(&privp->list_lock);
+		for (i = 0; i < nb_periodic; i++) {
+			tim = tims[i];
+			tim->expire += tim->period;
+			timer_add(tim, this_lcore, data->priv_timer);
+			/* The "RELEASE" ordering guarantees the memory
+			 * operations above the status update are observed
+			 * before the update by all threads
+			 */
+			rte_atomic_store_explicit(&tim->status.u32,
+				pending.u32, rte_memory_order_release);
+		}
+		__TIMER_STAT_ADD(data->priv_timer, pending, nb_periodic);
+		rte_spinlock_unlock(&privp->list_lock);
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_manage_bulk, 26.03)
+int
+rte_timer_manage_bulk(rte_timer_manage_bulk_cb_t f, void *arg)
+{
+	return rte_timer_alt_manage_bulk(default_data_id, NULL, 0, f, arg);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_alt_manage_bulk, 26.03)
+int
+rte_timer_alt_manage_bulk(uint32_t timer_data_id, unsigned int *poll_lcores,
+			  int nb_poll_lcores, rte_timer_manage_bulk_cb_t f,
+			  void *arg)
+{
+	struct rte_timer *run_first_tims[RTE_MAX_LCORE];
+	unsigned int this_lcore = rte_lcore_id();
+	struct rte_timer_data *data;
+	int nb_runlists;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, data, -EINVAL);
+
+	/* timer manager only runs on EAL thread with valid lcore_id */
+	assert(this_lcore < RTE_MAX_LCORE);
+
+	nb_runlists = timer_get_runlists(data, poll_lcores, nb_poll_lcores,
+					 run_first_tims);
+	if (nb_runlists != 0)
+		timer_run_bulk(data, run_first_tims, nb_runlists, f, arg);
+
+	return 0;
+}
+
 /* Walk pending lists, stopping timers and calling user-specified function */
 RTE_EXPORT_SYMBOL(rte_timer_stop_all)
 int
@@ -996,6 +1839,7 @@ rte_timer_stop_all(uint32_t timer_data_id, unsigned int *walk_lcores,
 	uint32_t walk_lcore;
 	struct rte_timer *tim, *next_tim;
 	struct rte_timer_data *timer_data;
+	unsigned int slot;
 
 	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
 
@@ -1003,6 +1847,23 @@ rte_timer_stop_all(uint32_t timer_data_id, unsigned int *walk_lcores,
 		walk_lcore = walk_lcores[i];
 		priv_timer = &timer_data->priv_timer[walk_lcore];
 
+		if (priv_timer->wheel != NULL) {
+			for (slot = 0; slot < RTE_DIM(priv_timer->wheel->slots);
+			     slot++) {
+				for (tim = priv_timer->wheel->slots[slot];
+				     tim != NULL;
+				     tim = next_tim) {
+					next_tim = tim->sl_next[0];
+
+					__rte_timer_stop(tim, timer_data);
+
+					if (f)
+						f(tim, f_arg);
+				}
+			}
+			continue;
+		}
+
 		for (tim = priv_timer->pending_head.sl_next[0];
 		     tim != NULL;
 		     tim = next_tim) {
@@ -1026,7 +1887,9 @@ rte_timer_next_ticks(void)
 	struct rte_timer_data *timer_data;
 	struct priv_timer *priv_timer;
 	const struct rte_timer *tm;
-	uint64_t cur_time;
+	const struct timer_wheel *wheel;
+	uint64_t cur_time, next_tick;
+	unsigned int idx;
 	int64_t left = -ENOENT;
 
 	TIMER_DATA_VALID_GET_OR_ERR_RET(default_data_id, timer_data, -EINVAL);
@@ -1035,7 +1898,20 @@ rte_timer_next_ticks(void)
 	cur_time = rte_get_timer_cycles();
 
 	rte_spinlock_lock(&priv_timer[lcore_id].list_lock);
-	tm = priv_timer[lcore_id].pending_head.sl_next[0];
+	wheel = priv_timer[lcore_id].wheel;
+	if (wheel != NULL && wheel->nb_timers != 0) {
+		/* lower bound: the next slot of level 0 which is not empty,
+		 * or the next cascade
+		 */
+		idx = wheel->cur_tick & WHEEL_MASK;
+		next_tick = (wheel->cur_tick & ~(uint64_t)WHEEL_MASK) +
+			timer_wheel_next_slot(wheel, idx);
+		left = (next_tick << wheel->tick_shift) - cur_time;
+		if (left < 0)
+			left = 0;
+	}
+	tm = wheel == NULL ? priv_timer[lcore_id].pending_head.sl_next[0] :
+		NULL;
 	if (tm) {
 		left = tm->expire - cur_time;
 		if (left < 0)
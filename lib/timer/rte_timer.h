@@ -98,6 +98,7 @@ typedef void (*rte_timer_cb_t)(struct rte_timer *, void *);
 struct rte_timer
 {
 	uint64_t expire;       /**< Time when timer expire. */
+	/** Links in the pending list, i.e. skiplist or timer wheel. */
 	struct rte_timer *sl_next[MAX_SKIPLIST_DEPTH];
 	volatile union rte_timer_status status; /**< Status of timer. */
 	uint64_t period;       /**< Period of timer (0 if not periodic). */
@@ -130,6 +131,38 @@ struct rte_timer
 	}
 #endif
 
+/**
+ * Types of the pending timer lists of a timer data instance.
+ */
+enum rte_timer_list_type {
+	/**
+	 * Skiplist sorted by expiry time: timers expire in order and
+	 * without delay, but resetting or stopping a timer is O(log n).
+	 */
+	RTE_TIMER_LIST_SKIPLIST = 0,
+	/**
+	 * Hierarchical timing wheel: resetting or stopping a timer is O(1),
+	 * but timers expire up to one wheel tick late, and timers expiring
+	 * in the same tick are run in no particular order.
+	 * rte_timer_next_ticks() returns a lower bound of the time left.
+	 */
+	RTE_TIMER_LIST_WHEEL,
+};
+
+/**
+ * Configuration of a timer data instance.
+ */
+struct rte_timer_data_conf {
+	enum rte_timer_list_type list_type; /**< Type of the pending lists. */
+	/**
+	 * Duration of a tick of the timing wheels in timer cycles, which is
+	 * rounded up to a power of 2. 0 selects about 10 microseconds.
+	 * Timing wheels cover 2^32 ticks, and timers expiring later are
+	 * rescheduled as time goes by.
+	 */
+	uint64_t wheel_tick;
+};
+
 /**
  * Allocate a timer data instance in shared memory to track a set of pending
  * timer lists.
@@ -156,6 +189,30 @@ int rte_timer_data_alloc(uint32_t *id_ptr);
  */
 int rte_timer_data_dealloc(uint32_t id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Allocate a timer data instance in shared memory to track a set of pending
+ * timer lists, with the given type of pending lists.
+ *
+ * @param id_ptr
+ *   Pointer to variable into which to write the identifier of the allocated
+ *   timer data instance.
+ * @param conf
+ *   Configuration of the timer data instance. NULL selects the default
+ *   configuration, i.e. a skiplist per lcore.
+ *
+ * @return
+ *   - 0: Success
+ *   - -EINVAL: invalid configuration
+ *   - -ENOMEM: Unable to allocate memory for the pending lists
+ *   - -ENOSPC: maximum number of timer data instances already allocated
+ */
+__rte_experimental
+int rte_timer_data_alloc_conf(uint32_t *id_ptr,
+		const struct rte_timer_data_conf *conf);
+
 /**
  * Initialize the timer library.
  *
@@ -173,6 +230,31 @@ int rte_timer_data_dealloc(uint32_t id);
  */
 int rte_timer_subsystem_init(void);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Initialize the timer library, with the given type of pending lists for
+ * the default timer data instance, which is used by rte_timer_reset(),
+ * rte_timer_stop() and rte_timer_manage().
+ *
+ * The configuration is only applied by the process which initializes the
+ * shared timer data. Other processes use that configuration.
+ *
+ * @param conf
+ *   Configuration of the default timer data instance. NULL selects the
+ *   default configuration, as rte_timer_subsystem_init() does.
+ *
+ * @return
+ *   - 0: Success
+ *   - -EINVAL: invalid configuration
+ *   - -ENOMEM: Unable to allocate memory needed to initialize timer
+ *      subsystem
+ *   - -EALREADY: timer subsystem was already initialized. Not an error.
+ */
+__rte_experimental
+int rte_timer_subsystem_init_conf(const struct rte_timer_data_conf *conf);
+
 /**
  * Free timer subsystem resources.
  */
@@ -493,6 +575,220 @@ int
 rte_timer_stop_all(uint32_t timer_data_id, unsigned int *walk_lcores,
 		   int nb_walk_lcores, rte_timer_stop_all_cb_t f, void *f_arg);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reset and start a set of timers, with the same parameters except the
+ * callback argument.
+ *
+ * This function is equivalent to calling rte_timer_reset() for each timer,
+ * but the list locks are taken once for the whole set, and the timers,
+ * which expire at the same time, are inserted together in the pending list.
+ *
+ * The timers which are in the RUNNING or CONFIG state are not reset. The
+ * timers of the array are reordered, so that the ones which were reset come
+ * first.
+ *
+ * @param tims
+ *   The array of timer handles.
+ * @param nb_timers
+ *   The number of timers in the array.
+ * @param ticks
+ *   The number of cycles (see rte_get_hpet_hz()) before the callback
+ *   function is called.
+ * @param type
+ *   The type of the timers, PERIODICAL or SINGLE (see rte_timer_reset()).
+ * @param tim_lcore
+ *   The ID of the lcore where the timer callback functions have to be
+ *   executed. If tim_lcore is LCORE_ID_ANY, all the timers are launched on
+ *   the next lcore of the round-robin.
+ * @param fct
+ *   The callback function of the timers. This parameter can be NULL if (and
+ *   only if) rte_timer_manage_bulk() will be used to manage these timers.
+ * @param args
+ *   The array of the nb_timers user arguments of the callback function, in
+ *   the order of the timers. If NULL, the argument of all the timers is NULL.
+ * @return
+ *   - The number of timers which were reset, i.e. which are the first ones
+ *     of the array on return.
+ */
+__rte_experimental
+int
+rte_timer_reset_bulk(struct rte_timer **tims, unsigned int nb_timers,
+		     uint64_t ticks, enum rte_timer_type type,
+		     unsigned int tim_lcore, rte_timer_cb_t fct,
+		     void *const *args);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * This function is the same as rte_timer_reset_bulk(), except that it allows
+ * a caller to specify the rte_timer_data instance containing the list to which
+ * the timers should be added.
+ *
+ * @see rte_timer_reset_bulk()
+ *
+ * @param timer_data_id
+ *   An identifier indicating which instance of timer data should be used for
+ *   this operation.
+ * @param tims
+ *   The array of timer handles.
+ * @param nb_timers
+ *   The number of timers in the array.
+ * @param ticks
+ *   The number of cycles (see rte_get_hpet_hz()) before the callback
+ *   function is called.
+ * @param type
+ *   The type of the timers, PERIODICAL or SINGLE (see rte_timer_reset()).
+ * @param tim_lcore
+ *   The ID of the lcore where the timer callback functions have to be
+ *   executed, or LCORE_ID_ANY.
+ * @param fct
+ *   The callback function of the timers. This parameter can be NULL if (and
+ *   only if) rte_timer_alt_manage(), rte_timer_manage_bulk() or
+ *   rte_timer_alt_manage_bulk() will be used to manage these timers.
+ * @param args
+ *   The array of the nb_timers user arguments of the callback function, or
+ *   NULL.
+ * @return
+ *   - The number of timers which were reset, i.e. which are the first ones
+ *     of the array on return.
+ *   - -EINVAL: invalid timer_data_id
+ */
+__rte_experimental
+int
+rte_timer_alt_reset_bulk(uint32_t timer_data_id, struct rte_timer **tims,
+			 unsigned int nb_timers, uint64_t ticks,
+			 enum rte_timer_type type, unsigned int tim_lcore,
+			 rte_timer_cb_t fct, void *const *args);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Stop a set of timers.
+ *
+ * This function is equivalent to calling rte_timer_stop() for each timer,
+ * but the list lock of an lcore is taken once for consecutive timers
+ * pending on that lcore.
+ *
+ * The timers which are in the RUNNING or CONFIG state are not stopped. The
+ * timers of the array are reordered, so that the ones which were stopped
+ * come first.
+ *
+ * @param tims
+ *   The array of timer handles.
+ * @param nb_timers
+ *   The number of timers in the array.
+ * @return
+ *   - The number of timers which were stopped, i.e. which are the first ones
+ *     of the array on return.
+ */
+__rte_experimental
+int
+rte_timer_stop_bulk(struct rte_timer **tims, unsigned int nb_timers);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * This function is the same as rte_timer_stop_bulk(), except that it allows a
+ * caller to specify the rte_timer_data instance containing the lists from
+ * which the timers should be removed.
+ *
+ * @see rte_timer_stop_bulk()
+ *
+ * @param timer_data_id
+ *   An identifier indicating which instance of timer data should be used for
+ *   this operation.
+ * @param tims
+ *   The array of timer handles.
+ * @param nb_timers
+ *   The number of timers in the array.
+ * @return
+ *   - The number of timers which were stopped, i.e. which are the first ones
+ *     of the array on return.
+ *   - -EINVAL: invalid timer_data_id
+ */
+__rte_experimental
+int
+rte_timer_alt_stop_bulk(uint32_t timer_data_id, struct rte_timer **tims,
+			unsigned int nb_timers);
+
+/** Maximum number of timers passed to a rte_timer_manage_bulk_cb_t call. */
+#define RTE_TIMER_MANAGE_BULK_SIZE 64
+
+/**
+ * Callback function type for rte_timer_manage_bulk() and
+ * rte_timer_alt_manage_bulk(), called with an array of expired timers.
+ *
+ * The callback function may reset or stop the timers of the array. The
+ * timers which are not reset or stopped by the callback function are stopped
+ * (SINGLE timers) or reloaded (PERIODICAL timers) when it returns.
+ */
+typedef void (*rte_timer_manage_bulk_cb_t)(struct rte_timer **tims,
+		unsigned int nb_timers, void *arg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Manage the timer list of the calling lcore, and pass the expired timers to
+ * the specified callback function, by arrays of up to
+ * RTE_TIMER_MANAGE_BULK_SIZE timers. This function is similar to
+ * rte_timer_manage(), except that the callback functions of individual
+ * timers are ignored.
+ *
+ * @see rte_timer_manage()
+ *
+ * @param f
+ *   The callback function which should be called for the expired timers.
+ * @param arg
+ *   An arbitrary argument that will be passed to f.
+ * @return
+ *   - 0: Success
+ *   - -EINVAL: timer subsystem not yet initialized
+ */
+__rte_experimental
+int
+rte_timer_manage_bulk(rte_timer_manage_bulk_cb_t f, void *arg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * This function is the same as rte_timer_alt_manage(), except that the
+ * expired timers are passed to the callback function by arrays of up to
+ * RTE_TIMER_MANAGE_BULK_SIZE timers.
+ *
+ * @see rte_timer_alt_manage()
+ *
+ * @param timer_data_id
+ *   An identifier indicating which instance of timer data should be used for
+ *   this operation.
+ * @param poll_lcores
+ *   An array of lcore ids identifying the timer lists that should be processed.
+ *   NULL is allowed - if NULL, the timer list corresponding to the lcore
+ *   calling this routine is processed (same as rte_timer_manage_bulk()).
+ * @param n_poll_lcores
+ *   The size of the poll_lcores array. If 'poll_lcores' is NULL, this parameter
+ *   is ignored.
+ * @param f
+ *   The callback function which should be called for the expired timers.
+ * @param arg
+ *   An arbitrary argument that will be passed to f.
+ * @return
+ *   - 0: success
+ *   - -EINVAL: invalid timer_data_id
+ */
+__rte_experimental
+int
+rte_timer_alt_manage_bulk(uint32_t timer_data_id, unsigned int *poll_lcores,
+			  int n_poll_lcores, rte_timer_manage_bulk_cb_t f,
+			  void *arg);
+
 /**
  * This function is the same as rte_timer_dump_stats(), except that it allows
  * the caller to specify the rte_timer_data instance that should be used.